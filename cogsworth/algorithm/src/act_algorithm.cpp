@@ -5,7 +5,7 @@
 #define SLEEP_MS(ms) Sleep(ms)
 #else
 #include <unistd.h>  // for sleep
-#define SLEEP_MS(ms) sleep(ms / 1000)
+#define SLEEP_MS(ms) usleep((ms) * 1000)
 #endif
 
 // #include "act_algorithm_flow.h"
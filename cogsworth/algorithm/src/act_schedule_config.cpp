@@ -81,6 +81,7 @@ bool ActScheduleConfigVLAN::IsAvailableVLAN(quint16 &vlan_id, QString &destinati
 ACT_STATUS ActScheduleConfig::PrepareScheduleConfigDevice(ActProject &act_project) {
   ACT_STATUS_INIT();
 
+  const ActProjectGraph graph = act_project.GetGraph();
   for (ActDevice device : act_project.GetDevices()) {
     ActScheduleConfigDevice schedule_config_device;
     schedule_config_device.SetDeviceId(device.GetId());
@@ -113,11 +114,11 @@ ACT_STATUS ActScheduleConfig::PrepareScheduleConfigDevice(ActProject &act_projec
       schedule_config_interface.SetInterfaceId(interface.GetInterfaceId());
       schedule_config_interface.SetInterfaceName(interface.GetInterfaceName());
 
-      ActLink link;
-      act_status = act_project.GetLinkByInterfaceId(link, device.GetId(), interface.GetInterfaceId());
-      if (!IsActStatusSuccess(act_status)) {
+      const ActLink *link_ptr = graph.GetLinkByInterfaceId(device.GetId(), interface.GetInterfaceId());
+      if (link_ptr == nullptr) {
         continue;
       }
+      const ActLink &link = *link_ptr;
       schedule_config_interface.SetLinkId(link.GetId());
 
       schedule_config_interface.SetConnectDeviceId(
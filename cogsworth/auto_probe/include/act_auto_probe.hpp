@@ -11,7 +11,7 @@ See the file MOXA-SOFTWARE-NOTICE for details.
 #define SLEEP_MS(ms) Sleep(ms)
 #else
 #include <unistd.h>  // for sleep
-#define SLEEP_MS(ms) sleep(ms / 1000)
+#define SLEEP_MS(ms) usleep((ms) * 1000)
 #endif
 
 #include <QMutex>
@@ -23,6 +23,7 @@ See the file MOXA-SOFTWARE-NOTICE for details.
 #include "act_device.hpp"
 #include "act_feature_profile.hpp"
 #include "act_json.hpp"
+#include "act_probe_cache.hpp"
 #include "act_scan_ip_range.hpp"
 #include "act_southbound.hpp"
 #include "act_status.hpp"
@@ -66,6 +67,9 @@ class ActAutoProbe {
   ACT_STATUS auto_probe_act_status_;                 ///< AutoProbe thread status
   ACT_JSON_OBJECT(ActProfiles, profiles, Profiles);  ///< Profiles item
 
+  // for probe cache
+  ACT_JSON_FIELD(bool, validate_probe_cache, ValidateProbeCache);  ///< Check the cached result by CheckConnection
+
   // member
  private:
   ActSouthbound southbound_;
@@ -138,18 +142,6 @@ class ActAutoProbe {
    */
   ACT_STATUS NotFoundMethodErrorHandler(QString called_func, ActActionMethod method);
 
-  /**
-   * @brief Probe Features object
-   *
-   * @param device
-   * @param device_profile
-   * @param result_probe_warning
-
-   * @return ACT_STATUS
-   */
-  ACT_STATUS ProbeFeatures(const ActDevice &device, ActDeviceProfile &device_profile,
-                           ActAutoProbeWarning &result_probe_warning);
-
   /**
    * @brief Get the DeviceProfile infos object
    *
@@ -242,6 +234,7 @@ class ActAutoProbe {
         progress_(0),
         stop_flag_(false),
         reidentify_(false),
+        validate_probe_cache_(true),
         auto_probe_act_status_(std::make_shared<ActStatusBase>(ActStatusType::kStop, ActSeverity::kDebug)),
         auto_probe_thread_(nullptr) {
     southbound_.SetProfiles(profiles);
@@ -289,6 +282,22 @@ class ActAutoProbe {
   ACT_STATUS AutoProbe(ActDevice &device, ActAutoProbeWarning &result_probe_warning,
                        ActDeviceProfile &result_dev_profile);
 
+  /**
+   * @brief Probe Features object
+   *
+   * The devices of the same model & firmware & modules reuse the result of g_act_probe_cache. Otherwise the features
+   * are probed concurrently (Base, AutoScan, Operation, Configuration) and the result without warning is cached.
+   *
+   * @param device
+   * @param firmware_version
+   * @param device_profile
+   * @param result_probe_warning
+
+   * @return ACT_STATUS
+   */
+  ACT_STATUS ProbeFeatures(const ActDevice &device, const QString &firmware_version, ActDeviceProfile &device_profile,
+                           ActAutoProbeWarning &result_probe_warning);
+
   /**
    * @brief Start AutoProbe by scan ip ranges object
    *
@@ -0,0 +1,95 @@
+/* Copyright (C) MOXA Inc. All rights reserved.
+This software is distributed under the terms of the MOXA SOFTWARE NOTICE.
+See the file MOXA-SOFTWARE-NOTICE for details.
+*/
+
+#ifndef ACT_PROBE_CACHE_HPP
+#define ACT_PROBE_CACHE_HPP
+
+#include <QList>
+#include <QMap>
+#include <QMutex>
+#include <QString>
+
+#include "act_auto_probe_warning.hpp"
+#include "act_device_module.hpp"
+#include "act_feature_profile.hpp"
+
+namespace act {
+namespace auto_probe {
+
+/**
+ * @brief The probed features of a model without warning, in the probe order (Base, AutoScan, Operation, Configuration)
+ *
+ */
+struct ActProbeCacheEntry {
+  QList<ActFeatureProfile> feature_profiles;
+};
+
+/**
+ * @brief The probe result cache keyed by (ModelName, FirmwareVersion, modules)
+ *
+ * The devices of the same model, firmware and modules support the same features, so only the first of them is fully
+ * probed. Only the result without warning is cached, the device with a warning is probed again. The cache lives as
+ * long as the process and is shared by all the AutoProbe instances, it is cleared when the FeatureProfiles are loaded.
+ * All the methods are thread-safe.
+ *
+ */
+class ActProbeCache {
+ public:
+  ActProbeCache() {}
+
+  /**
+   * @brief Make the cache key
+   *
+   * @param model_name
+   * @param firmware_version
+   * @param modular_configuration
+   * @return QString empty if the device can't be cached (unknown ModelName or FirmwareVersion)
+   */
+  static QString MakeKey(const QString &model_name, const QString &firmware_version,
+                         const ActDeviceModularConfiguration &modular_configuration);
+
+  /**
+   * @brief Find the entry
+   *
+   * @param key
+   * @param result_entry
+   * @return true if found
+   */
+  bool Find(const QString &key, ActProbeCacheEntry &result_entry);
+
+  /**
+   * @brief Insert (or replace) the entry
+   *
+   * @param key
+   * @param entry
+   */
+  void Insert(const QString &key, const ActProbeCacheEntry &entry);
+
+  /**
+   * @brief Remove the entry (e.g. the cached entry doesn't match the device)
+   *
+   * @param key
+   */
+  void Remove(const QString &key);
+
+  /**
+   * @brief Clear the cache (e.g. the FeatureProfiles are loaded)
+   *
+   */
+  void Clear();
+
+  qint32 Size();
+
+ private:
+  QMutex mutex_;
+  QMap<QString, ActProbeCacheEntry> entries_;  ///< <key, entry>
+};
+
+extern ActProbeCache g_act_probe_cache;  ///< The probe result cache shared by the AutoProbe instances
+
+}  // namespace auto_probe
+}  // namespace act
+
+#endif /* ACT_PROBE_CACHE_HPP */
@@ -277,8 +277,9 @@ ACT_STATUS act::auto_probe::ActAutoProbe::AutoProbe(ActDevice &device, ActAutoPr
   // [feat:2396] Refactor - AutoScan performance enhance
   ActDeviceProfile dev_profile;
   ActFirmwareFeatureProfile fw_feature_profile;
-  auto identify_act_status = southbound_.FeatureIdentifyDeviceAndGetProfilesByProbe(!reidentify_, device, profiles_,
-                                                                                    dev_profile, fw_feature_profile);
+  QString firmware_version;
+  auto identify_act_status = southbound_.FeatureIdentifyDeviceAndGetProfilesByProbe(
+      !reidentify_, device, profiles_, dev_profile, fw_feature_profile, firmware_version);
 
   if (reidentify_) {
     if ((device.GetDeviceProperty().GetModelName() != dev_profile.GetModelName()) ||
@@ -325,7 +326,7 @@ ACT_STATUS act::auto_probe::ActAutoProbe::AutoProbe(ActDevice &device, ActAutoPr
 
   // Add FeatureCapability to DeviceProfile(ProbeFeatures)
   qDebug() << "Start append the DeviceProfile's FeatureCapability(Probe features)";
-  act_status = ProbeFeatures(device, dev_profile, result_probe_warning);
+  act_status = ProbeFeatures(device, firmware_version, dev_profile, result_probe_warning);
   if (IsActStatusStop(act_status)) {  // stop handle
     return act_status;
   }
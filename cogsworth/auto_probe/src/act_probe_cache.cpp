@@ -0,0 +1,55 @@
+#include "act_probe_cache.hpp"
+
+#include <QMutexLocker>
+#include <QStringList>
+
+act::auto_probe::ActProbeCache act::auto_probe::g_act_probe_cache;
+
+QString act::auto_probe::ActProbeCache::MakeKey(const QString &model_name, const QString &firmware_version,
+                                                const ActDeviceModularConfiguration &modular_configuration) {
+  if (model_name.isEmpty() || firmware_version.isEmpty()) {
+    return QString();
+  }
+
+  // Modules: "E<slot>:<module id>" & "P<slot>:<module id>" in the slot order
+  QStringList modules;
+  for (auto it = modular_configuration.GetEthernet().cbegin(); it != modular_configuration.GetEthernet().cend(); it++) {
+    modules.append(QString("E%1:%2").arg(it.key()).arg(it.value()));
+  }
+  for (auto it = modular_configuration.GetPower().cbegin(); it != modular_configuration.GetPower().cend(); it++) {
+    modules.append(QString("P%1:%2").arg(it.key()).arg(it.value()));
+  }
+
+  return QString("%1|%2|%3").arg(model_name).arg(firmware_version).arg(modules.join(","));
+}
+
+bool act::auto_probe::ActProbeCache::Find(const QString &key, ActProbeCacheEntry &result_entry) {
+  QMutexLocker lock(&mutex_);
+  auto it = entries_.constFind(key);
+  if (it == entries_.constEnd()) {
+    return false;
+  }
+
+  result_entry = it.value();
+  return true;
+}
+
+void act::auto_probe::ActProbeCache::Insert(const QString &key, const ActProbeCacheEntry &entry) {
+  QMutexLocker lock(&mutex_);
+  entries_.insert(key, entry);
+}
+
+void act::auto_probe::ActProbeCache::Remove(const QString &key) {
+  QMutexLocker lock(&mutex_);
+  entries_.remove(key);
+}
+
+void act::auto_probe::ActProbeCache::Clear() {
+  QMutexLocker lock(&mutex_);
+  entries_.clear();
+}
+
+qint32 act::auto_probe::ActProbeCache::Size() {
+  QMutexLocker lock(&mutex_);
+  return entries_.size();
+}
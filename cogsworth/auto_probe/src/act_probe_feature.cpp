@@ -1,5 +1,10 @@
 #include "act_auto_probe.hpp"
 
+#include <QPair>
+#include <QVector>
+
+#include "act_concurrent_runner.hpp"
+
 ACT_STATUS act::auto_probe::ActAutoProbe::DisconnectReturnHandler(const ActDevice &device,
                                                                   const ActFeatureEnum &feature,
                                                                   QList<ActFeatureWarning> &features_warning,
@@ -14,7 +19,8 @@ ACT_STATUS act::auto_probe::ActAutoProbe::DisconnectReturnHandler(const ActDevic
   return std::make_shared<ActStatusBase>(ActStatusType::kFailed, ActSeverity::kDebug);
 }
 
-ACT_STATUS act::auto_probe::ActAutoProbe::ProbeFeatures(const ActDevice &device, ActDeviceProfile &device_profile,
+ACT_STATUS act::auto_probe::ActAutoProbe::ProbeFeatures(const ActDevice &device, const QString &firmware_version,
+                                                        ActDeviceProfile &device_profile,
                                                         ActAutoProbeWarning &result_probe_warning) {
   ACT_STATUS_INIT();
 
@@ -26,78 +32,93 @@ ACT_STATUS act::auto_probe::ActAutoProbe::ProbeFeatures(const ActDevice &device,
 
   auto feature_capability_set = device_profile.GetFeatureCapability();
   QList<ActFeatureWarning> features_warning;
-  ACT_STATUS act_status_find = std::make_shared<ActStatusBase>();
 
   if (stop_flag_) {
     return ACT_STATUS_STOP;
   }
 
-  // Base feature
-  ActFeatureProfile base_probe_feat_profile;
-  ActFeatureWarning base_probe_feat_warning;
-  BaseDetect(device, base_probe_feat_profile, base_probe_feat_warning);
-  feature_capability_set.insert(base_probe_feat_profile);
-  if (!base_probe_feat_warning.GetItems().isEmpty()) {  // has warning
-    // Check connect
-    act_status = southbound_.PingIpAddress(device.GetIpv4().GetIpAddress(), ACT_PING_REPEAT_TIMES);
-    if (!IsActStatusSuccess(act_status)) {
-      return DisconnectReturnHandler(device, ActFeatureEnum::kBase, features_warning, result_probe_warning);
+  // The detect functions in the probe order
+  using DetectFunction = ACT_STATUS (ActAutoProbe::*)(const ActDevice &, ActFeatureProfile &, ActFeatureWarning &);
+  const QList<QPair<ActFeatureEnum, DetectFunction>> detects = {
+      {ActFeatureEnum::kBase, &ActAutoProbe::BaseDetect},
+      {ActFeatureEnum::kAutoScan, &ActAutoProbe::AutoScanDetect},
+      {ActFeatureEnum::kOperation, &ActAutoProbe::OperationDetect},
+      {ActFeatureEnum::kConfiguration, &ActAutoProbe::ConfigurationDetect}};
+
+  QVector<ActFeatureProfile> probe_feat_profiles(detects.size());
+  QVector<ActFeatureWarning> probe_feat_warnings(detects.size());
+  QVector<bool> detected(detects.size(), false);
+
+  // Find the probe cache
+  const QString cache_key =
+      ActProbeCache::MakeKey(device_profile.GetModelName(), firmware_version, device.GetModularConfiguration());
+  ActProbeCacheEntry cache_entry;
+  bool cache_hit = !cache_key.isEmpty() && g_act_probe_cache.Find(cache_key, cache_entry) &&
+                   (cache_entry.feature_profiles.size() == detects.size());
+  if (cache_hit && validate_probe_cache_) {
+    // Fingerprint: the device's connections (Base) should be the same as the cached one (without warning)
+    BaseDetect(device, probe_feat_profiles[0], probe_feat_warnings[0]);
+    detected[0] = true;
+    if ((probe_feat_profiles[0].ToString() != cache_entry.feature_profiles[0].ToString()) ||
+        !probe_feat_warnings[0].GetItems().isEmpty()) {
+      qDebug() << __func__
+               << QString("The probe cache(%1) doesn't match the device(%2)")
+                      .arg(cache_key)
+                      .arg(device.GetIpv4().GetIpAddress())
+                      .toStdString()
+                      .c_str();
+      g_act_probe_cache.Remove(cache_key);
+      cache_hit = false;
     }
-    features_warning.append(base_probe_feat_warning);
   }
 
-  if (stop_flag_) {
-    return ACT_STATUS_STOP;
-  }
-
-  // AutoScan feature
-  ActFeatureProfile auto_scan_probe_feat_profile;
-  ActFeatureWarning auto_scan_probe_feat_warning;
-  AutoScanDetect(device, auto_scan_probe_feat_profile, auto_scan_probe_feat_warning);
-  feature_capability_set.insert(auto_scan_probe_feat_profile);
-  if (!auto_scan_probe_feat_warning.GetItems().isEmpty()) {  // has warning
-    // Check connect
-    act_status = southbound_.PingIpAddress(device.GetIpv4().GetIpAddress(), ACT_PING_REPEAT_TIMES);
-    if (!IsActStatusSuccess(act_status)) {
-      return DisconnectReturnHandler(device, ActFeatureEnum::kAutoScan, features_warning, result_probe_warning);
+  if (cache_hit) {
+    qDebug() << __func__
+             << QString("Use the probe cache(%1). Device: %2")
+                    .arg(cache_key)
+                    .arg(device.GetIpv4().GetIpAddress())
+                    .toStdString()
+                    .c_str();
+    for (const auto &feature_profile : cache_entry.feature_profiles) {
+      feature_capability_set.insert(feature_profile);
     }
-    features_warning.append(auto_scan_probe_feat_warning);
-  }
-
-  if (stop_flag_) {
-    return ACT_STATUS_STOP;
-  }
-
-  // Operation feature
-  ActFeatureProfile operation_probe_feat_profile;
-  ActFeatureWarning operation_probe_feat_warning;
-  OperationDetect(device, operation_probe_feat_profile, operation_probe_feat_warning);
-  feature_capability_set.insert(operation_probe_feat_profile);
-  if (!operation_probe_feat_warning.GetItems().isEmpty()) {  // has warning
-    // Check connect
-    act_status = southbound_.PingIpAddress(device.GetIpv4().GetIpAddress(), ACT_PING_REPEAT_TIMES);
-    if (!IsActStatusSuccess(act_status)) {
-      return DisconnectReturnHandler(device, ActFeatureEnum::kOperation, features_warning, result_probe_warning);
+  } else {
+    // The features are independent, probe them at once
+    QList<qint64> detect_indexes;
+    for (qint32 i = 0; i < detects.size(); i++) {
+      if (!detected[i]) {
+        detect_indexes.append(i);
+      }
+    }
+    ActConcurrentRunner runner(detects.size(), 0);
+    runner.Run(
+        detect_indexes,
+        [this, &device, &detects, &probe_feat_profiles, &probe_feat_warnings](const qint64 &index) {
+          return (this->*detects[index].second)(device, probe_feat_profiles[index], probe_feat_warnings[index]);
+        },
+        [](const qint64 &, ACT_STATUS) {}, &stop_flag_);
+
+    if (stop_flag_) {
+      return ACT_STATUS_STOP;
     }
-    features_warning.append(operation_probe_feat_warning);
-  }
 
-  if (stop_flag_) {
-    return ACT_STATUS_STOP;
-  }
+    for (qint32 i = 0; i < detects.size(); i++) {
+      feature_capability_set.insert(probe_feat_profiles[i]);
+      if (!probe_feat_warnings[i].GetItems().isEmpty()) {  // has warning
+        // Check connect
+        act_status = southbound_.PingIpAddress(device.GetIpv4().GetIpAddress(), ACT_PING_REPEAT_TIMES);
+        if (!IsActStatusSuccess(act_status)) {
+          return DisconnectReturnHandler(device, detects[i].first, features_warning, result_probe_warning);
+        }
+        features_warning.append(probe_feat_warnings[i]);
+      }
+    }
 
-  // Configuration feature
-  ActFeatureProfile configuration_probe_feat_profile;
-  ActFeatureWarning configuration_probe_feat_warning;
-  ConfigurationDetect(device, configuration_probe_feat_profile, configuration_probe_feat_warning);
-  feature_capability_set.insert(configuration_probe_feat_profile);
-  if (!configuration_probe_feat_warning.GetItems().isEmpty()) {  // has warning
-    // Check connect
-    act_status = southbound_.PingIpAddress(device.GetIpv4().GetIpAddress(), ACT_PING_REPEAT_TIMES);
-    if (!IsActStatusSuccess(act_status)) {
-      return DisconnectReturnHandler(device, ActFeatureEnum::kConfiguration, features_warning, result_probe_warning);
+    // Cache the result for the same devices, a warning may be transient (e.g. a timeout) so it is probed again
+    if (!cache_key.isEmpty() && features_warning.isEmpty()) {
+      cache_entry.feature_profiles = probe_feat_profiles.toList();
+      g_act_probe_cache.Insert(cache_key, cache_entry);
     }
-    features_warning.append(configuration_probe_feat_warning);
   }
 
   if (stop_flag_) {
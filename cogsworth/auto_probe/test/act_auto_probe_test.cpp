@@ -105,5 +105,71 @@ TEST_F(ActAutoProbeTest, AutoProbe) {
   EXPECT_EQ(act_status->GetStatus(), ActStatusType::kFinished) << "AutoProbe failed";
 }
 
+TEST_F(ActAutoProbeTest, ProbeCache) {
+  ActDeviceModularConfiguration no_module;
+  ActDeviceModularConfiguration modules;
+  modules.GetEthernet()[1] = 10;
+  modules.GetPower()[1] = 20;
+
+  // Unknown ModelName or FirmwareVersion can't be cached
+  EXPECT_TRUE(ActProbeCache::MakeKey("", "v1.0", no_module).isEmpty());
+  EXPECT_TRUE(ActProbeCache::MakeKey("TSN-G5008", "", no_module).isEmpty());
+
+  // The key is (ModelName, FirmwareVersion, modules)
+  const QString key = ActProbeCache::MakeKey("TSN-G5008", "v1.0", no_module);
+  EXPECT_EQ(key, ActProbeCache::MakeKey("TSN-G5008", "v1.0", no_module));
+  EXPECT_NE(key, ActProbeCache::MakeKey("TSN-G5008", "v2.0", no_module));
+  EXPECT_NE(key, ActProbeCache::MakeKey("TSN-G5008", "v1.0", modules));
+  EXPECT_NE(key, ActProbeCache::MakeKey("TSN-G5004", "v1.0", no_module));
+
+  ActProbeCache cache;
+  ActProbeCacheEntry entry;
+  entry.feature_profiles.append(ActFeatureProfile(ActFeatureEnum::kBase));
+
+  ActProbeCacheEntry found_entry;
+  EXPECT_FALSE(cache.Find(key, found_entry));
+  cache.Insert(key, entry);
+  ASSERT_TRUE(cache.Find(key, found_entry));
+  EXPECT_EQ(found_entry.feature_profiles.size(), 1);
+  EXPECT_FALSE(cache.Find(ActProbeCache::MakeKey("TSN-G5008", "v2.0", no_module), found_entry));
+
+  cache.Remove(key);
+  EXPECT_FALSE(cache.Find(key, found_entry));
+
+  cache.Insert(key, entry);
+  cache.Clear();
+  EXPECT_EQ(cache.Size(), 0);
+}
+
+TEST_F(ActAutoProbeTest, ProbeFeaturesCacheHit) {
+  ActDevice dev("192.168.127.253");
+  const QString key = ActProbeCache::MakeKey("TSN-G5008", "v1.0", dev.GetModularConfiguration());
+
+  // The cached features, the Operation has an item to tell it from a probed one
+  ActProbeCacheEntry entry;
+  for (auto feature : {ActFeatureEnum::kBase, ActFeatureEnum::kAutoScan, ActFeatureEnum::kOperation,
+                       ActFeatureEnum::kConfiguration}) {
+    entry.feature_profiles.append(ActFeatureProfile(feature));
+  }
+  entry.feature_profiles[2].GetItems()["Reboot"] = ActFeatureItem();
+  g_act_probe_cache.Insert(key, entry);
+
+  // Without the validation the device is never connected
+  ActAutoProbe auto_probe((ActProfiles()));
+  auto_probe.SetValidateProbeCache(false);
+  ActDeviceProfile dev_profile;
+  dev_profile.SetModelName("TSN-G5008");
+  ActAutoProbeWarning probe_warning;
+  act_status = auto_probe.ProbeFeatures(dev, "v1.0", dev_profile, probe_warning);
+  g_act_probe_cache.Remove(key);
+  ASSERT_TRUE(IsActStatusSuccess(act_status));
+
+  EXPECT_EQ(4, dev_profile.GetFeatureCapability().size());
+  auto it = dev_profile.GetFeatureCapability().find(ActFeatureProfile(ActFeatureEnum::kOperation));
+  ASSERT_NE(dev_profile.GetFeatureCapability().end(), it);
+  EXPECT_TRUE(it->GetItems().contains("Reboot"));
+  EXPECT_TRUE(probe_warning.GetWarningReason().isEmpty());
+}
+
 }  // namespace auto_probe
 }  // namespace act
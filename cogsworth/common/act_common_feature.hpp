@@ -10,7 +10,7 @@ See the file MOXA-SOFTWARE-NOTICE for details.
 #define SLEEP_MS(ms) Sleep(ms)
 #else
 #include <unistd.h>  // for sleep
-#define SLEEP_MS(ms) sleep(ms / 1000)
+#define SLEEP_MS(ms) usleep((ms) * 1000)
 #endif
 
 #include <QDebug>
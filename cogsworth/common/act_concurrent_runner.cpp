@@ -0,0 +1,105 @@
+/* Copyright (C) MOXA Inc. All rights reserved.
+This software is distributed under the terms of the MOXA SOFTWARE NOTICE.
+See the file MOXA-SOFTWARE-NOTICE for details.
+*/
+
+#include "act_concurrent_runner.hpp"
+
+#include <QDateTime>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#define ACT_CONCURRENT_RUNNER_STOP_CHECK (100)  ///< The interval(ms) to check the stop flag
+
+ACT_STATUS ActConcurrentRunner::Run(const QList<qint64> &id_list, const ActionFunction &action,
+                                    const ResultFunction &result, const bool *stop_flag) {
+  auto stopped = [stop_flag]() { return (stop_flag != nullptr) && (*stop_flag); };
+
+  struct Task {
+    qint64 id;
+    qint64 deadline;
+    bool done;      ///< The action returned
+    bool reported;  ///< The result (or the timeout) is reported
+    ACT_STATUS act_status;
+  };
+
+  std::mutex mutex;
+  std::condition_variable condition;
+  std::vector<Task> tasks(id_list.size());
+  std::vector<std::thread> threads;
+  qint32 next = 0;
+  qint32 active = 0;  ///< The running tasks not reported yet
+
+  std::unique_lock<std::mutex> lock(mutex);
+  while (true) {
+    // Start the devices while there is a free slot
+    while (!stopped() && next < id_list.size() && active < width_) {
+      Task &task = tasks[next];
+      task.id = id_list[next];
+      task.deadline = (timeout_ > 0) ? QDateTime::currentMSecsSinceEpoch() + timeout_ : 0;
+      task.done = false;
+      task.reported = false;
+      active++;
+      threads.emplace_back([&, index = next]() {
+        ACT_STATUS act_status = action(tasks[index].id);
+        std::lock_guard<std::mutex> task_lock(mutex);
+        tasks[index].act_status = act_status;
+        tasks[index].done = true;
+        condition.notify_all();
+      });
+      next++;
+    }
+
+    if (active == 0 && (stopped() || next >= id_list.size())) {
+      break;
+    }
+
+    // Wait for a device to complete, its deadline or the stop check
+    qint64 wait = ACT_CONCURRENT_RUNNER_STOP_CHECK;
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    for (qint32 i = 0; i < next; i++) {
+      if (!tasks[i].reported && tasks[i].deadline > 0) {
+        wait = qMin(wait, qMax<qint64>(tasks[i].deadline - now, 0));
+      }
+    }
+    condition.wait_for(lock, std::chrono::milliseconds(wait));
+
+    // Report the completed and the timed-out devices
+    QList<QPair<qint64, ACT_STATUS>> reports;
+    const qint64 checked = QDateTime::currentMSecsSinceEpoch();
+    for (qint32 i = 0; i < next; i++) {
+      Task &task = tasks[i];
+      if (task.reported) {
+        continue;
+      }
+      if (task.done) {
+        reports.append(qMakePair(task.id, task.act_status));
+      } else if (task.deadline > 0 && checked >= task.deadline) {
+        auto act_status = std::make_shared<ActStatusBase>(ActStatusType::kFailed, ActSeverity::kWarning);
+        act_status->SetErrorMessage(QString("The device does not respond in %1 ms").arg(timeout_));
+        reports.append(qMakePair(task.id, ACT_STATUS(act_status)));
+      } else {
+        continue;
+      }
+      task.reported = true;
+      active--;
+    }
+
+    // Report without the lock, the result function may take a while
+    lock.unlock();
+    for (const auto &report : reports) {
+      result(report.first, report.second);
+    }
+    lock.lock();
+  }
+  lock.unlock();
+
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  return stopped() ? ACT_STATUS_STOP : ACT_STATUS_SUCCESS;
+}
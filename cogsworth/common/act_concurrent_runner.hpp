@@ -0,0 +1,52 @@
+/* Copyright (C) MOXA Inc. All rights reserved.
+This software is distributed under the terms of the MOXA SOFTWARE NOTICE.
+See the file MOXA-SOFTWARE-NOTICE for details.
+*/
+
+#pragma once
+
+#include <QList>
+#include <functional>
+
+#include "act_status.hpp"
+
+/**
+ * @brief Run an action on the devices concurrently with a bounded width and a per-device timeout
+ *
+ * The results are reported in the caller's thread as soon as each device completes, so a slow device does not hold
+ * back the others. A device over its timeout is reported failed and its slot is given to the next device; its thread
+ * is still joined before Run() returns (the southbound has its own protocol timeouts) and its late result is dropped.
+ *
+ * It is the fan-out of the device-level work inside a job (e.g. export/import, the firmware waves, the deploy waves and
+ * the probe features), while the jobs themselves are scheduled by ActJobEngine.
+ *
+ */
+class ActConcurrentRunner {
+ public:
+  using ActionFunction = std::function<ACT_STATUS(const qint64 &id)>;
+  using ResultFunction = std::function<void(const qint64 &id, ACT_STATUS act_status)>;
+
+  /**
+   * @brief Construct a new Act Concurrent Runner object
+   *
+   * @param width the maximum devices run at once
+   * @param timeout the timeout(ms) of each device, 0 for none
+   */
+  ActConcurrentRunner(const qint32 &width, const qint64 &timeout) : width_(qMax(width, 1)), timeout_(timeout) {}
+
+  /**
+   * @brief Run the action on the devices in order
+   *
+   * @param id_list
+   * @param action called in the worker threads
+   * @param result called in the caller's thread
+   * @param stop_flag no more device is started once it is set (optional)
+   * @return ACT_STATUS success, or stop if stopped
+   */
+  ACT_STATUS Run(const QList<qint64> &id_list, const ActionFunction &action, const ResultFunction &result,
+                 const bool *stop_flag = nullptr);
+
+ private:
+  qint32 width_;
+  qint64 timeout_;
+};
@@ -0,0 +1,116 @@
+/* Copyright (C) MOXA Inc. All rights reserved.
+This software is distributed under the terms of the MOXA SOFTWARE NOTICE.
+See the file MOXA-SOFTWARE-NOTICE for details.
+*/
+
+#include "act_firmware_rollout.hpp"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QMutexLocker>
+#include <chrono>
+#include <thread>
+
+#include "act_concurrent_runner.hpp"
+
+#define ACT_FIRMWARE_ROLLOUT_SLEEP_SLICE (100)  ///< The sleep slice(ms) to check the stop flag
+
+qint64 ActBandwidthPacer::Reserve(const quint64 &bytes, const qint64 &now) {
+  if (bytes_per_second_ == 0) {
+    return 0;
+  }
+
+  QMutexLocker lock(&mutex_);
+  const qint64 start = qMax(now, next_free_);
+  next_free_ = start + static_cast<qint64>((bytes * 1000) / bytes_per_second_);
+  return start - now;
+}
+
+QList<QList<qint64>> ActFirmwareRollout::PlanWaves(const QList<qint64> &dev_id_list,
+                                                   const QMap<qint64, qint64> &dev_distance_map,
+                                                   const quint16 &wave_width) {
+  // Unknown topology, keep upgrading one by one in the sorted order
+  const qint32 width =
+      dev_distance_map.isEmpty() ? 1 : qBound<qint32>(1, wave_width, ACT_FIRMWARE_ROLLOUT_WAVE_WIDTH_MAX);
+
+  QList<QList<qint64>> waves;
+  qint64 wave_distance = -1;
+  for (const auto &dev_id : dev_id_list) {
+    // The device without the distance has its own wave
+    const qint64 distance = dev_distance_map.value(dev_id, -1);
+    if (waves.isEmpty() || waves.last().size() >= width || distance == -1 || distance != wave_distance) {
+      waves.append(QList<qint64>());
+    }
+    waves.last().append(dev_id);
+    wave_distance = distance;
+  }
+
+  return waves;
+}
+
+ACT_STATUS ActFirmwareRollout::Run(const QList<QList<qint64>> &waves, const quint64 &file_size,
+                                   const UpgradeFunction &upgrade, const HealthFunction &health,
+                                   const ResultFunction &result, const bool *stop_flag) {
+  auto stopped = [stop_flag]() { return (stop_flag != nullptr) && (*stop_flag); };
+
+  ActBandwidthPacer pacer(static_cast<quint64>(setting_.GetBandwidthLimit()) * 1024);
+  QString halt_reason;
+
+  for (const auto &wave : waves) {
+    if (stopped()) {
+      return ACT_STATUS_STOP;
+    }
+
+    if (!halt_reason.isEmpty()) {
+      for (const auto &dev_id : wave) {
+        auto act_status = std::make_shared<ActStatusBase>(ActStatusType::kFailed, ActSeverity::kWarning);
+        act_status->SetErrorMessage(halt_reason);
+        result(dev_id, act_status);
+      }
+      continue;
+    }
+
+    // Upgrade the devices of the wave at once, each upload waits for its bandwidth
+    QMap<qint64, ACT_STATUS> wave_status;
+    ActConcurrentRunner runner(wave.size(), 0);
+    runner.Run(
+        wave,
+        [&](const qint64 &dev_id) -> ACT_STATUS {
+          const qint64 delay = pacer.Reserve(file_size, QDateTime::currentMSecsSinceEpoch());
+          const qint64 start = QDateTime::currentMSecsSinceEpoch() + delay;
+          while (!stopped() && QDateTime::currentMSecsSinceEpoch() < start) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(
+                qMin<qint64>(ACT_FIRMWARE_ROLLOUT_SLEEP_SLICE, start - QDateTime::currentMSecsSinceEpoch())));
+          }
+          return stopped() ? ACT_STATUS_STOP : upgrade(dev_id);
+        },
+        [&](const qint64 &dev_id, ACT_STATUS act_status) { wave_status.insert(dev_id, act_status); }, stop_flag);
+    if (stopped()) {
+      return ACT_STATUS_STOP;
+    }
+
+    // Health gate
+    QList<qint64> upgraded;
+    for (const auto &dev_id : wave) {
+      if (IsActStatusSuccess(wave_status[dev_id])) {
+        upgraded.append(dev_id);
+      }
+    }
+    const QSet<qint64> alive = upgraded.isEmpty() ? QSet<qint64>() : health(upgraded);
+
+    for (const auto &dev_id : wave) {
+      ACT_STATUS act_status = wave_status[dev_id];
+      if (IsActStatusSuccess(act_status) && !alive.contains(dev_id)) {
+        act_status = std::make_shared<ActStatusBase>(ActStatusType::kFailed, ActSeverity::kWarning);
+        act_status->SetErrorMessage("The device is not alive after the firmware upgrade");
+        halt_reason = "The firmware rollout halted, a device of the previous wave is not alive after the upgrade";
+      }
+      result(dev_id, act_status);
+    }
+    if (!halt_reason.isEmpty()) {
+      qWarning() << __func__ << halt_reason.toStdString().c_str();
+    }
+  }
+
+  return stopped() ? ACT_STATUS_STOP : ACT_STATUS_SUCCESS;
+}
@@ -0,0 +1,119 @@
+/* Copyright (C) MOXA Inc. All rights reserved.
+This software is distributed under the terms of the MOXA SOFTWARE NOTICE.
+See the file MOXA-SOFTWARE-NOTICE for details.
+*/
+
+#pragma once
+
+#include <QList>
+#include <QMap>
+#include <QMutex>
+#include <QSet>
+#include <functional>
+
+#include "act_json.hpp"
+#include "act_status.hpp"
+
+#define ACT_FIRMWARE_ROLLOUT_WAVE_WIDTH (4)        ///< The default devices upgraded at once
+#define ACT_FIRMWARE_ROLLOUT_WAVE_WIDTH_MAX (32)   ///< The maximum devices upgraded at once
+#define ACT_FIRMWARE_ROLLOUT_HEALTH_TIMEOUT (300)  ///< The default time(s) for the upgraded devices to be alive again
+#define ACT_FIRMWARE_ROLLOUT_REBOOT_DELAY (30)     ///< The default time(s) an upgraded device takes to start rebooting
+
+/**
+ * @brief The firmware rollout setting
+ *
+ */
+class ActFirmwareRolloutSetting : public QSerializer {
+  Q_GADGET
+  QS_SERIALIZABLE
+
+  ACT_JSON_FIELD(quint16, wave_width, WaveWidth);            ///< The devices upgraded at once
+  ACT_JSON_FIELD(quint32, bandwidth_limit, BandwidthLimit);  ///< The aggregate upload bandwidth(KB/s), 0 for unlimited
+  ACT_JSON_FIELD(quint32, health_timeout, HealthTimeout);    ///< The time(s) for the wave to be alive again
+  ACT_JSON_FIELD(quint32, reboot_delay, RebootDelay);        ///< The time(s) to wait for the reboot if never seen down
+
+ public:
+  ActFirmwareRolloutSetting() {
+    this->wave_width_ = ACT_FIRMWARE_ROLLOUT_WAVE_WIDTH;
+    this->bandwidth_limit_ = 0;
+    this->health_timeout_ = ACT_FIRMWARE_ROLLOUT_HEALTH_TIMEOUT;
+    this->reboot_delay_ = ACT_FIRMWARE_ROLLOUT_REBOOT_DELAY;
+  }
+};
+
+/**
+ * @brief The pacer of the aggregate upload bandwidth
+ *
+ * Each upload reserves its bytes on a virtual clock advancing at the bandwidth limit, and waits until its slot starts.
+ * So the uploads started in any period never exceed the limit on average, however many devices run at once.
+ *
+ */
+class ActBandwidthPacer {
+ public:
+  /**
+   * @brief Construct a new Act Bandwidth Pacer object
+   *
+   * @param bytes_per_second 0 for unlimited
+   */
+  ActBandwidthPacer(const quint64 &bytes_per_second) : bytes_per_second_(bytes_per_second), next_free_(0) {}
+
+  /**
+   * @brief Reserve the upload
+   *
+   * @param bytes
+   * @param now (ms)
+   * @return qint64 the delay(ms) before the upload starts
+   */
+  qint64 Reserve(const quint64 &bytes, const qint64 &now);
+
+ private:
+  QMutex mutex_;
+  quint64 bytes_per_second_;
+  qint64 next_free_;  ///< The time(ms) the reserved uploads end
+};
+
+/**
+ * @brief The firmware rollout in waves
+ *
+ * The devices are upgraded in waves of at most WaveWidth devices. A wave only holds the devices at the same distance
+ * from the host, so a device is upgraded before its uplinks (the leaves first) and never with them. After each wave,
+ * the upgraded devices must be alive again before the next wave starts; otherwise the rollout halts and the rest of
+ * the devices are reported failed.
+ *
+ */
+class ActFirmwareRollout {
+ public:
+  using UpgradeFunction = std::function<ACT_STATUS(const qint64 &device_id)>;
+  using HealthFunction = std::function<QSet<qint64>(const QList<qint64> &device_ids)>;  ///< Return the alive devices
+  using ResultFunction = std::function<void(const qint64 &device_id, ACT_STATUS act_status)>;
+
+  ActFirmwareRollout(const ActFirmwareRolloutSetting &setting) : setting_(setting) {}
+
+  /**
+   * @brief Plan the waves
+   *
+   * @param dev_id_list the devices sorted from far to near
+   * @param dev_distance_map <device id, distance from the host>, empty if the topology is unknown (one device a wave)
+   * @param wave_width
+   * @return QList<QList<qint64>>
+   */
+  static QList<QList<qint64>> PlanWaves(const QList<qint64> &dev_id_list, const QMap<qint64, qint64> &dev_distance_map,
+                                        const quint16 &wave_width);
+
+  /**
+   * @brief Run the waves, the results are reported in the caller's thread after the health check of each wave
+   *
+   * @param waves
+   * @param file_size the bytes uploaded to each device
+   * @param upgrade upgrade the device (called in the wave's threads)
+   * @param health get the alive devices of the wave
+   * @param result report the result of the device
+   * @param stop_flag
+   * @return ACT_STATUS success, or stop if stopped
+   */
+  ACT_STATUS Run(const QList<QList<qint64>> &waves, const quint64 &file_size, const UpgradeFunction &upgrade,
+                 const HealthFunction &health, const ResultFunction &result, const bool *stop_flag = nullptr);
+
+ private:
+  ActFirmwareRolloutSetting setting_;
+};
@@ -0,0 +1,369 @@
+/* Copyright (C) MOXA Inc. All rights reserved.
+This software is distributed under the terms of the MOXA SOFTWARE NOTICE.
+See the file MOXA-SOFTWARE-NOTICE for details.
+*/
+
+#include "act_job_engine.hpp"
+
+#include <QDateTime>
+#include <QMutexLocker>
+#include <chrono>
+
+void ActJobCancelToken::Cancel() {
+  QList<std::function<void()>> callbacks;
+  {
+    QMutexLocker lock(&mutex_);
+    if (cancelled_.exchange(true)) {
+      return;
+    }
+    callbacks.swap(callbacks_);
+  }
+
+  // Call without the lock, the callback may cancel the other tokens
+  for (const auto &callback : callbacks) {
+    callback();
+  }
+}
+
+void ActJobCancelToken::OnCancel(const std::function<void()> &callback) {
+  {
+    QMutexLocker lock(&mutex_);
+    if (!cancelled_) {
+      callbacks_.append(callback);
+      return;
+    }
+  }
+  callback();
+}
+
+std::shared_ptr<ActJobCancelToken> ActJobCancelToken::CreateChild() {
+  auto child = std::make_shared<ActJobCancelToken>();
+  std::weak_ptr<ActJobCancelToken> weak_child = child;
+  OnCancel([weak_child]() {
+    if (auto token = weak_child.lock()) {
+      token->Cancel();
+    }
+  });
+  return child;
+}
+
+void ActJobProgress::SetTotal(const qint64 &total) {
+  QMutexLocker lock(&mutex_);
+  total_ = qMax<qint64>(total, 0);
+  done_ = qMin(done_, total_);
+}
+
+void ActJobProgress::Advance(const qint64 &units) {
+  QMutexLocker lock(&mutex_);
+  done_ = qBound<qint64>(0, done_ + units, total_);
+}
+
+void ActJobProgress::SetPercent(const quint8 &percent) {
+  QMutexLocker lock(&mutex_);
+  total_ = 100;
+  done_ = qMin<qint64>(percent, 100);
+}
+
+std::shared_ptr<ActJobProgress> ActJobProgress::AddChild(const qint64 &weight) {
+  auto child = std::make_shared<ActJobProgress>();
+  QMutexLocker lock(&mutex_);
+  children_.append(qMakePair(qMax<qint64>(weight, 0), child));
+  return child;
+}
+
+double ActJobProgress::GetFraction() {
+  QMutexLocker lock(&mutex_);
+  double done = done_;
+  double total = total_;
+  for (const auto &child : children_) {
+    done += child.first * child.second->GetFraction();
+    total += child.first;
+  }
+  return (total > 0) ? qBound(0.0, done / total, 1.0) : 0.0;
+}
+
+ActJobEngine g_act_job_engine;
+
+ActJobEngine::ActJobEngine(const qint32 &max_threads)
+    : max_threads_(qMax(max_threads, 1)), stopping_(false), last_job_id_(0) {}
+
+ActJobEngine::~ActJobEngine() {
+  QList<std::shared_ptr<ActJobCancelToken>> cancel_tokens;
+  QList<std::function<void()>> skipped_callbacks;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+    for (const auto &job_id : queue_) {
+      JobEntry &entry = jobs_[job_id];
+      entry.info.SetState(ActJobStateEnum::kCancelled);
+      entry.info.SetFinishedTime(QDateTime::currentMSecsSinceEpoch());
+      entry.function = nullptr;
+      if (entry.on_skipped) {
+        skipped_callbacks.append(entry.on_skipped);
+      }
+      cancel_tokens.append(entry.cancel_token);
+    }
+    queue_.clear();
+    for (auto &entry : jobs_) {
+      if (entry.info.GetState() == ActJobStateEnum::kRunning) {
+        cancel_tokens.append(entry.cancel_token);
+      }
+    }
+  }
+  for (const auto &token : cancel_tokens) {
+    token->Cancel();
+  }
+  for (const auto &callback : skipped_callbacks) {
+    callback();
+  }
+  condition_.notify_all();
+
+  for (auto &worker : workers_) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+}
+
+void ActJobEngine::SetTypeLimit(const QString &type, const qint32 &max_running) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (max_running > 0) {
+      type_limits_.insert(type, max_running);
+    } else {
+      type_limits_.remove(type);
+    }
+  }
+  condition_.notify_all();
+}
+
+qint64 ActJobEngine::Submit(const qint64 &project_id, const QString &type, const ActJobFunction &function,
+                            std::shared_ptr<ActJobCancelToken> cancel_token, const std::function<void()> &on_skipped) {
+  qint64 job_id = -1;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (workers_.empty()) {
+      for (qint32 i = 0; i < max_threads_; i++) {
+        workers_.emplace_back(&ActJobEngine::WorkerThread, this);
+      }
+    }
+    job_id = ++last_job_id_;
+
+    JobEntry entry;
+    entry.info.SetId(job_id);
+    entry.info.SetProjectId(project_id);
+    entry.info.SetType(type);
+    entry.info.SetCreatedTime(QDateTime::currentMSecsSinceEpoch());
+    entry.function = function;
+    entry.on_skipped = on_skipped;
+    entry.cancel_token = (cancel_token != nullptr) ? cancel_token : std::make_shared<ActJobCancelToken>();
+    entry.progress = std::make_shared<ActJobProgress>();
+    jobs_.insert(job_id, entry);
+    queue_.append(job_id);
+    TrimHistory();
+  }
+  condition_.notify_all();
+  return job_id;
+}
+
+ACT_STATUS ActJobEngine::Cancel(const qint64 &job_id) {
+  ACT_STATUS_INIT();
+
+  std::shared_ptr<ActJobCancelToken> cancel_token;
+  std::function<void()> on_skipped;
+  bool skipped = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto job_it = jobs_.find(job_id);
+    if (job_it == jobs_.end()) {
+      return std::make_shared<ActStatusNotFound>(QString("Job(%1)").arg(job_id));
+    }
+
+    JobEntry &entry = job_it.value();
+    switch (entry.info.GetState()) {
+      case ActJobStateEnum::kQueued:
+        // Still shown as queued (out of the queue) until its skipped callback returns
+        skipped = queue_.removeOne(job_id);
+        if (skipped) {
+          entry.function = nullptr;
+          on_skipped.swap(entry.on_skipped);
+          cancel_token = entry.cancel_token;
+        }
+        break;
+      case ActJobStateEnum::kRunning:
+        cancel_token = entry.cancel_token;
+        break;
+      default:  // already ended
+        break;
+    }
+  }
+
+  if (cancel_token != nullptr) {
+    cancel_token->Cancel();
+  }
+  if (!skipped) {
+    return act_status;
+  }
+
+  if (on_skipped) {
+    on_skipped();
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto job_it = jobs_.find(job_id);
+    if (job_it != jobs_.end()) {
+      job_it->info.SetState(ActJobStateEnum::kCancelled);
+      job_it->info.SetFinishedTime(QDateTime::currentMSecsSinceEpoch());
+    }
+  }
+  condition_.notify_all();
+  return act_status;
+}
+
+bool ActJobEngine::Wait(const qint64 &job_id, const qint64 &timeout) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto ended = [this, job_id]() {
+    auto job_it = jobs_.constFind(job_id);
+    return (job_it == jobs_.constEnd()) || (job_it->info.GetState() != ActJobStateEnum::kQueued &&
+                                            job_it->info.GetState() != ActJobStateEnum::kRunning);
+  };
+  if (timeout < 0) {
+    condition_.wait(lock, ended);
+    return true;
+  }
+  return condition_.wait_for(lock, std::chrono::milliseconds(timeout), ended);
+}
+
+ACT_STATUS ActJobEngine::GetJob(const qint64 &job_id, ActJobInfo &job_info) {
+  ACT_STATUS_INIT();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto job_it = jobs_.find(job_id);
+  if (job_it == jobs_.end()) {
+    return std::make_shared<ActStatusNotFound>(QString("Job(%1)").arg(job_id));
+  }
+  UpdateInfo(job_it.value());
+  job_info = job_it->info;
+  return act_status;
+}
+
+void ActJobEngine::GetJobs(const qint64 &project_id, ActJobList &job_list) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  job_list.GetJobs().clear();
+  for (auto &entry : jobs_) {
+    if (project_id == -1 || entry.info.GetProjectId() == project_id) {
+      UpdateInfo(entry);
+      job_list.GetJobs().append(entry.info);
+    }
+  }
+}
+
+void ActJobEngine::UpdateInfo(JobEntry &entry) {
+  if (entry.info.GetState() == ActJobStateEnum::kRunning) {
+    entry.info.SetProgress(entry.progress->GetPercent());
+  }
+}
+
+void ActJobEngine::TrimHistory() {
+  qint32 ended = 0;
+  for (const auto &entry : jobs_) {
+    if (entry.info.GetState() != ActJobStateEnum::kQueued && entry.info.GetState() != ActJobStateEnum::kRunning) {
+      ended++;
+    }
+  }
+
+  // Drop the oldest ended jobs
+  for (auto it = jobs_.begin(); it != jobs_.end() && ended > ACT_JOB_ENGINE_HISTORY;) {
+    if (it->info.GetState() != ActJobStateEnum::kQueued && it->info.GetState() != ActJobStateEnum::kRunning) {
+      it = jobs_.erase(it);
+      ended--;
+    } else {
+      ++it;
+    }
+  }
+}
+
+qint64 ActJobEngine::TakeRunnable() {
+  for (auto it = queue_.begin(); it != queue_.end(); ++it) {
+    const QString type = jobs_[*it].info.GetType();
+    const qint32 limit = type_limits_.value(type, 0);
+    if (limit > 0 && type_running_.value(type, 0) >= limit) {
+      continue;
+    }
+    const qint64 job_id = *it;
+    queue_.erase(it);
+    type_running_[type]++;
+    return job_id;
+  }
+  return -1;
+}
+
+void ActJobEngine::WorkerThread() {
+  while (true) {
+    ActJobContext context;
+    ActJobFunction function;
+    std::function<void()> on_skipped;
+    QString type;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      qint64 job_id = -1;
+      condition_.wait(lock, [this, &job_id]() {
+        if (stopping_) {
+          return true;
+        }
+        job_id = TakeRunnable();
+        return job_id != -1;
+      });
+      if (stopping_) {
+        return;
+      }
+
+      JobEntry &entry = jobs_[job_id];
+      entry.info.SetState(ActJobStateEnum::kRunning);
+      entry.info.SetStartedTime(QDateTime::currentMSecsSinceEpoch());
+      context.job_id = job_id;
+      context.project_id = entry.info.GetProjectId();
+      context.cancel_token = entry.cancel_token;
+      context.progress = entry.progress;
+      function.swap(entry.function);
+      on_skipped.swap(entry.on_skipped);
+      type = entry.info.GetType();
+    }
+
+    ACT_STATUS act_status = ACT_STATUS_SUCCESS;
+    if (context.cancel_token->IsCancelled()) {  // e.g. the parent token is cancelled
+      act_status = ACT_STATUS_STOP;
+      if (on_skipped) {
+        on_skipped();
+      }
+    } else if (function) {
+      try {
+        act_status = function(context);
+      } catch (std::exception &e) {
+        act_status = std::make_shared<ActStatusInternalError>("JobEngine");
+        act_status->SetErrorMessage(e.what());
+      }
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      type_running_[type]--;
+      JobEntry &entry = jobs_[context.job_id];
+      entry.info.SetFinishedTime(QDateTime::currentMSecsSinceEpoch());
+      if (context.cancel_token->IsCancelled() || act_status->GetStatus() == ActStatusType::kStop) {
+        entry.info.SetState(ActJobStateEnum::kCancelled);
+        entry.info.SetProgress(entry.progress->GetPercent());
+      } else if (IsActStatusSuccess(act_status)) {
+        entry.info.SetState(ActJobStateEnum::kFinished);
+        entry.info.SetProgress(100);
+      } else {
+        entry.info.SetState(ActJobStateEnum::kFailed);
+        entry.info.SetProgress(entry.progress->GetPercent());
+        entry.info.SetErrorMessage(act_status->GetErrorMessage());
+      }
+      TrimHistory();
+    }
+    // Wake up the waiters and the workers blocked by the type limit
+    condition_.notify_all();
+  }
+}
@@ -0,0 +1,302 @@
+/* Copyright (C) MOXA Inc. All rights reserved.
+This software is distributed under the terms of the MOXA SOFTWARE NOTICE.
+See the file MOXA-SOFTWARE-NOTICE for details.
+*/
+
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QMutex>
+#include <QPair>
+#include <QString>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "act_json.hpp"
+#include "act_status.hpp"
+
+#define ACT_JOB_ENGINE_MAX_THREADS (8)      ///< The worker threads of the job engine
+#define ACT_JOB_ENGINE_HISTORY (100)        ///< The maximum finished jobs kept in the job list
+#define ACT_JOB_FIRMWARE_UPGRADE_LIMIT (2)  ///< The concurrent firmware upgrade jobs (the firmware images are large)
+
+/**
+ * @brief The job state enum class
+ *
+ */
+enum class ActJobStateEnum { kQueued = 1, kRunning = 2, kFinished = 3, kFailed = 4, kCancelled = 5 };
+
+/**
+ * @brief The QMap for job state enum mapping
+ *
+ */
+static const QMap<QString, ActJobStateEnum> kActJobStateEnumMap = {{"Queued", ActJobStateEnum::kQueued},
+                                                                   {"Running", ActJobStateEnum::kRunning},
+                                                                   {"Finished", ActJobStateEnum::kFinished},
+                                                                   {"Failed", ActJobStateEnum::kFailed},
+                                                                   {"Cancelled", ActJobStateEnum::kCancelled}};
+
+/**
+ * @brief The job information of the job list
+ *
+ */
+class ActJobInfo : public QSerializer {
+  Q_GADGET
+  QS_SERIALIZABLE
+
+  ACT_JSON_FIELD(qint64, id, Id);
+  ACT_JSON_FIELD(qint64, project_id, ProjectId);
+  ACT_JSON_FIELD(QString, type, Type);  ///< The job type (e.g. "Reboot", "FirmwareUpgrade")
+  ACT_JSON_ENUM(ActJobStateEnum, state, State);
+  ACT_JSON_FIELD(quint8, progress, Progress);  ///< The progress(%) weighted by the work units
+  ACT_JSON_FIELD(qint64, created_time, CreatedTime);    ///< ms since epoch
+  ACT_JSON_FIELD(qint64, started_time, StartedTime);    ///< ms since epoch, 0 if not started
+  ACT_JSON_FIELD(qint64, finished_time, FinishedTime);  ///< ms since epoch, 0 if not finished
+  ACT_JSON_FIELD(QString, error_message, ErrorMessage);
+
+ public:
+  ActJobInfo() {
+    this->id_ = -1;
+    this->project_id_ = -1;
+    this->state_ = ActJobStateEnum::kQueued;
+    this->progress_ = 0;
+    this->created_time_ = 0;
+    this->started_time_ = 0;
+    this->finished_time_ = 0;
+  }
+};
+
+/**
+ * @brief The job list
+ *
+ */
+class ActJobList : public QSerializer {
+  Q_GADGET
+  QS_SERIALIZABLE
+
+  ACT_JSON_COLLECTION_OBJECTS(QList, ActJobInfo, jobs, Jobs);
+};
+
+/**
+ * @brief The cooperative cancellation token of the job
+ *
+ * The job polls IsCancelled() between its work units, or registers a callback to stop its blocking work (e.g. set
+ * the stop flag of the southbound). The child token is cancelled with its parent.
+ *
+ */
+class ActJobCancelToken {
+ public:
+  ActJobCancelToken() : cancelled_(false) {}
+
+  bool IsCancelled() const { return cancelled_; }
+
+  /**
+   * @brief Cancel the token, its callbacks and children are called once
+   *
+   */
+  void Cancel();
+
+  /**
+   * @brief Register the callback of the cancellation, it is called at once if already cancelled
+   *
+   * @param callback
+   */
+  void OnCancel(const std::function<void()> &callback);
+
+  /**
+   * @brief Create the child token (e.g. for the sub-job)
+   *
+   * @return std::shared_ptr<ActJobCancelToken>
+   */
+  std::shared_ptr<ActJobCancelToken> CreateChild();
+
+ private:
+  std::atomic<bool> cancelled_;
+  QMutex mutex_;
+  QList<std::function<void()>> callbacks_;
+};
+
+/**
+ * @brief The hierarchical progress of the job
+ *
+ * Each node has its own work units (SetTotal/Advance) and the weighted children. The fraction of a node is
+ * (done units + sum(child weight * child fraction)) / (total units + sum(child weights)), so the progress follows the
+ * real work instead of the hand-set steps.
+ *
+ */
+class ActJobProgress {
+ public:
+  ActJobProgress() : total_(0), done_(0) {}
+
+  /**
+   * @brief Set the total work units of the node
+   *
+   * @param total
+   */
+  void SetTotal(const qint64 &total);
+
+  /**
+   * @brief Advance the done work units of the node
+   *
+   * @param units
+   */
+  void Advance(const qint64 &units = 1);
+
+  /**
+   * @brief Set the progress(%) of the node directly (the legacy hand-set progress)
+   *
+   * @param percent
+   */
+  void SetPercent(const quint8 &percent);
+
+  /**
+   * @brief Add the child node
+   *
+   * @param weight the weight of the child, in the work units of this node
+   * @return std::shared_ptr<ActJobProgress>
+   */
+  std::shared_ptr<ActJobProgress> AddChild(const qint64 &weight);
+
+  double GetFraction();
+
+  quint8 GetPercent() { return static_cast<quint8>(GetFraction() * 100); }
+
+ private:
+  QMutex mutex_;
+  qint64 total_;
+  qint64 done_;
+  QList<QPair<qint64, std::shared_ptr<ActJobProgress>>> children_;  ///< <weight, child>
+};
+
+/**
+ * @brief The context passed to the running job
+ *
+ */
+struct ActJobContext {
+  qint64 job_id;
+  qint64 project_id;
+  std::shared_ptr<ActJobCancelToken> cancel_token;
+  std::shared_ptr<ActJobProgress> progress;
+};
+
+using ActJobFunction = std::function<ACT_STATUS(ActJobContext &context)>;
+
+/**
+ * @brief The shared background job engine
+ *
+ * The jobs run on a bounded pool of worker threads in the submitted order. A job type can be limited to run at most N
+ * jobs at once (e.g. the firmware upgrade of all the projects); the job over its limit waits in the queue while the
+ * later jobs of the other types run. The jobs of the different projects run concurrently. The job cancelled before it
+ * runs never calls its function, its skipped callback is called instead (e.g. to settle the status of its owner).
+ * The devices of a job are fanned out by ActConcurrentRunner in the job's worker.
+ *
+ * All the methods are thread-safe. The workers are started on the first submitted job.
+ *
+ */
+class ActJobEngine {
+ public:
+  /**
+   * @brief Construct a new Act Job Engine object
+   *
+   * @param max_threads the worker threads
+   */
+  ActJobEngine(const qint32 &max_threads = ACT_JOB_ENGINE_MAX_THREADS);
+
+  /**
+   * @brief Cancel all the jobs and wait for the workers
+   *
+   */
+  ~ActJobEngine();
+
+  /**
+   * @brief Limit the running jobs of the type
+   *
+   * @param type
+   * @param max_running 0 for unlimited
+   */
+  void SetTypeLimit(const QString &type, const qint32 &max_running);
+
+  /**
+   * @brief Submit the job
+   *
+   * @param project_id
+   * @param type
+   * @param function
+   * @param cancel_token the token of the job, a new one is created if nullptr
+   * @param on_skipped called instead of the function if the job is cancelled before it runs
+   * @return qint64 the job id
+   */
+  qint64 Submit(const qint64 &project_id, const QString &type, const ActJobFunction &function,
+                std::shared_ptr<ActJobCancelToken> cancel_token = nullptr,
+                const std::function<void()> &on_skipped = nullptr);
+
+  /**
+   * @brief Cancel the job, the queued job is cancelled at once and the running one is cancelled cooperatively
+   *
+   * The token of the queued job is cancelled and its skipped callback is called before it ends.
+   *
+   * @param job_id
+   * @return ACT_STATUS
+   */
+  ACT_STATUS Cancel(const qint64 &job_id);
+
+  /**
+   * @brief Wait for the job to end
+   *
+   * @param job_id
+   * @param timeout (ms), -1 for infinite
+   * @return true if the job ended (or not found)
+   */
+  bool Wait(const qint64 &job_id, const qint64 &timeout = -1);
+
+  ACT_STATUS GetJob(const qint64 &job_id, ActJobInfo &job_info);
+
+  /**
+   * @brief Get the jobs
+   *
+   * @param project_id -1 for all the projects
+   * @param job_list
+   */
+  void GetJobs(const qint64 &project_id, ActJobList &job_list);
+
+ private:
+  struct JobEntry {
+    ActJobInfo info;
+    ActJobFunction function;
+    std::function<void()> on_skipped;
+    std::shared_ptr<ActJobCancelToken> cancel_token;
+    std::shared_ptr<ActJobProgress> progress;
+  };
+
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::vector<std::thread> workers_;
+  qint32 max_threads_;
+  bool stopping_;
+  qint64 last_job_id_;
+  QMap<qint64, JobEntry> jobs_;          ///< <job id, job> in the submitted order
+  QList<qint64> queue_;                  ///< The queued job ids
+  QHash<QString, qint32> type_limits_;   ///< <type, max running>
+  QHash<QString, qint32> type_running_;  ///< <type, running>
+
+  void WorkerThread();
+
+  /**
+   * @brief Take the first queued job under its type limit (called with the lock)
+   *
+   * @return qint64 the job id, -1 if none
+   */
+  qint64 TakeRunnable();
+
+  void UpdateInfo(JobEntry &entry);
+
+  void TrimHistory();
+};
+
+extern ActJobEngine g_act_job_engine;  ///< The shared job engine of the long operations
@@ -0,0 +1,267 @@
+/* Copyright (C) MOXA Inc. All rights reserved.
+This software is distributed under the terms of the MOXA SOFTWARE NOTICE.
+See the file MOXA-SOFTWARE-NOTICE for details.
+*/
+
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QPair>
+#include <QSet>
+#include <QString>
+#include <QVector>
+#include <algorithm>
+#include <random>
+
+#define ACT_MONITOR_POLL_TICK (1000)               ///< The tick(ms) of the poll scheduler
+#define ACT_MONITOR_POLL_WHEEL_SLOTS (512)         ///< The slots of the timer wheel (one tick per slot)
+#define ACT_MONITOR_POLL_JITTER_PERCENT (10)       ///< The jitter(%) of the poll interval
+#define ACT_MONITOR_POLL_MAX_BACKOFF (8)           ///< The maximum multiple of the interval for the unreachable target
+#define ACT_MONITOR_POLL_FAST_COUNT (3)            ///< The fast polls after the state of the target changes
+#define ACT_MONITOR_POLL_FAST_DIVISOR (4)          ///< The fast poll interval is the interval divided by it
+#define ACT_MONITOR_POLL_BUDGET (100)              ///< The maximum polls dispatched per tick
+#define ACT_MONITOR_POLL_REFRESH_INTERVAL (10000)  ///< The interval(ms) to refresh the poll targets of the monitor
+
+/**
+ * @brief The poll state of the target
+ *
+ */
+struct ActMonitorPollEntry {
+  qint64 due = 0;             ///< The next due time(ms)
+  qint32 failures = 0;        ///< The consecutive unreachable polls
+  qint32 fast_remaining = 0;  ///< The remaining fast polls after the state change
+  bool known = false;         ///< The reachable state has been reported
+  bool reachable = false;
+};
+
+/**
+ * @brief The per-target poll scheduler of the monitor (one instance per polled feature, e.g. ping or heartbeat)
+ *
+ * Each target (e.g. the device IP) keeps its own next-due time in a hashed timer wheel, so a tick only visits the
+ * targets due in its slot instead of the whole fleet. The due times are spread by the jitter to avoid synchronized
+ * bursts. The reported result adjusts the next poll: an unreachable target backs off exponentially up to
+ * ACT_MONITOR_POLL_MAX_BACKOFF times the interval, and a target whose state just changed is polled faster for
+ * ACT_MONITOR_POLL_FAST_COUNT times. At most the budget of the targets are returned per tick; the rest are carried
+ * over to the next tick in due order.
+ *
+ * All the methods are thread-safe.
+ *
+ */
+class ActMonitorPollScheduler {
+ public:
+  /**
+   * @brief Construct a new Act Monitor Poll Scheduler object
+   *
+   * @param interval the poll interval(ms)
+   * @param budget the maximum polls per tick
+   * @param seed the seed of the jitter
+   */
+  ActMonitorPollScheduler(const qint64 &interval, const qint32 &budget = ACT_MONITOR_POLL_BUDGET,
+                          const quint32 &seed = std::random_device()())
+      : interval_(std::max<qint64>(interval, ACT_MONITOR_POLL_TICK)),
+        budget_(std::max<qint32>(budget, 1)),
+        current_tick_(-1),
+        slots_(ACT_MONITOR_POLL_WHEEL_SLOTS),
+        random_(seed) {}
+
+  /**
+   * @brief Set the poll interval(ms), the targets adopt it from their next poll
+   *
+   * @param interval
+   */
+  void SetInterval(const qint64 &interval) {
+    QMutexLocker lock(&mutex_);
+    interval_ = std::max<qint64>(interval, ACT_MONITOR_POLL_TICK);
+  }
+
+  void SetBudget(const qint32 &budget) {
+    QMutexLocker lock(&mutex_);
+    budget_ = std::max<qint32>(budget, 1);
+  }
+
+  /**
+   * @brief Sync the targets, the new ones are spread over the first interval and the missing ones are removed
+   *
+   * @param keys
+   * @param now (ms since epoch)
+   */
+  void Sync(const QSet<QString> &keys, const qint64 &now) {
+    QMutexLocker lock(&mutex_);
+    Start(now);
+    for (auto it = entries_.begin(); it != entries_.end();) {
+      if (keys.contains(it.key())) {
+        ++it;
+      } else {
+        it = entries_.erase(it);  // the slot items become stale
+      }
+    }
+    for (const QString &key : keys) {
+      if (!entries_.contains(key)) {
+        entries_.insert(key, ActMonitorPollEntry());
+        Schedule(key, now + std::uniform_int_distribution<qint64>(0, interval_ - 1)(random_));
+      }
+    }
+  }
+
+  /**
+   * @brief Get the targets due at the time, at most the budget
+   *
+   * The returned targets are rescheduled after one interval, so a target is not lost if its result is never
+   * reported. Report() or Defer() overrides it.
+   *
+   * @param now (ms since epoch)
+   * @return QList<QString> in due order
+   */
+  QList<QString> Due(const qint64 &now) {
+    QMutexLocker lock(&mutex_);
+    Start(now);
+    const qint64 target_tick = now / ACT_MONITOR_POLL_TICK;
+
+    // Visit each slot once at most, the items of the later rounds stay in the slot
+    const qint64 first_tick = std::max(current_tick_ + 1, target_tick - ACT_MONITOR_POLL_WHEEL_SLOTS + 1);
+    for (qint64 tick = first_tick; tick <= target_tick; tick++) {
+      QList<QPair<QString, qint64>> &slot = slots_[tick % ACT_MONITOR_POLL_WHEEL_SLOTS];
+      for (auto it = slot.begin(); it != slot.end();) {
+        if (!IsCurrent(it->first, it->second)) {
+          it = slot.erase(it);
+        } else if (it->second / ACT_MONITOR_POLL_TICK <= target_tick) {
+          ready_.append(*it);
+          it = slot.erase(it);
+        } else {
+          ++it;
+        }
+      }
+    }
+    current_tick_ = std::max(current_tick_, target_tick);
+    std::stable_sort(ready_.begin(), ready_.end(),
+                     [](const auto &a, const auto &b) { return a.second < b.second; });
+
+    QList<QString> due_keys;
+    while (!ready_.isEmpty() && due_keys.size() < budget_) {
+      const QPair<QString, qint64> item = ready_.takeFirst();
+      if (!IsCurrent(item.first, item.second)) {
+        continue;
+      }
+      due_keys.append(item.first);
+      Schedule(item.first, now + Jitter(interval_));
+    }
+    return due_keys;
+  }
+
+  /**
+   * @brief Retry the target at the next tick (e.g. it is still busy)
+   *
+   * @param key
+   * @param now (ms since epoch)
+   */
+  void Defer(const QString &key, const qint64 &now) {
+    QMutexLocker lock(&mutex_);
+    if (entries_.contains(key)) {
+      Schedule(key, now + ACT_MONITOR_POLL_TICK);
+    }
+  }
+
+  /**
+   * @brief Report the poll result of the target and reschedule it
+   *
+   * @param key
+   * @param reachable
+   * @param now (ms since epoch)
+   */
+  void Report(const QString &key, const bool &reachable, const qint64 &now) {
+    QMutexLocker lock(&mutex_);
+    auto entry_it = entries_.find(key);
+    if (entry_it == entries_.end()) {
+      return;
+    }
+
+    ActMonitorPollEntry &entry = entry_it.value();
+    if (entry.known && entry.reachable != reachable) {
+      entry.fast_remaining = ACT_MONITOR_POLL_FAST_COUNT;
+    }
+    entry.known = true;
+    entry.reachable = reachable;
+    entry.failures = reachable ? 0 : entry.failures + 1;
+
+    qint64 interval = interval_;
+    if (entry.fast_remaining > 0) {
+      entry.fast_remaining--;
+      interval = std::max<qint64>(interval_ / ACT_MONITOR_POLL_FAST_DIVISOR, ACT_MONITOR_POLL_TICK);
+    } else if (!reachable) {
+      const qint64 backoff = qint64(1) << std::min(entry.failures - 1, 30);
+      interval = interval_ * std::min<qint64>(backoff, ACT_MONITOR_POLL_MAX_BACKOFF);
+    }
+    Schedule(key, now + Jitter(interval));
+  }
+
+  /**
+   * @brief Poll the target at once and faster for a while (e.g. its state is changed by the event)
+   *
+   * @param key
+   * @param now (ms since epoch)
+   */
+  void Expedite(const QString &key, const qint64 &now) {
+    QMutexLocker lock(&mutex_);
+    auto entry_it = entries_.find(key);
+    if (entry_it == entries_.end()) {
+      return;
+    }
+    entry_it->fast_remaining = ACT_MONITOR_POLL_FAST_COUNT;
+    entry_it->failures = 0;
+    Schedule(key, now);
+  }
+
+  /**
+   * @brief Get the next due time(ms) of the target
+   *
+   * @param key
+   * @return qint64 -1 if not found
+   */
+  qint64 GetDue(const QString &key) {
+    QMutexLocker lock(&mutex_);
+    auto entry_it = entries_.find(key);
+    return (entry_it == entries_.end()) ? -1 : entry_it->due;
+  }
+
+  qint32 Size() {
+    QMutexLocker lock(&mutex_);
+    return entries_.size();
+  }
+
+ private:
+  QMutex mutex_;
+  qint64 interval_;
+  qint32 budget_;
+  qint64 current_tick_;                           ///< The last visited tick
+  QVector<QList<QPair<QString, qint64>>> slots_;  ///< <key, due>, the item is stale if the due is changed
+  QList<QPair<QString, qint64>> ready_;           ///< The due items over the budget of the previous ticks
+  QHash<QString, ActMonitorPollEntry> entries_;
+  std::mt19937 random_;
+
+  void Start(const qint64 &now) {
+    if (current_tick_ < 0) {
+      current_tick_ = now / ACT_MONITOR_POLL_TICK - 1;
+    }
+  }
+
+  bool IsCurrent(const QString &key, const qint64 &due) const {
+    auto entry_it = entries_.find(key);
+    return entry_it != entries_.end() && entry_it->due == due;
+  }
+
+  qint64 Jitter(const qint64 &interval) {
+    const qint64 jitter = interval * ACT_MONITOR_POLL_JITTER_PERCENT / 100;
+    return interval + std::uniform_int_distribution<qint64>(-jitter, jitter)(random_);
+  }
+
+  void Schedule(const QString &key, const qint64 &due) {
+    entries_[key].due = due;
+    if (due / ACT_MONITOR_POLL_TICK <= current_tick_) {
+      ready_.append(qMakePair(key, due));
+    } else {
+      slots_[(due / ACT_MONITOR_POLL_TICK) % ACT_MONITOR_POLL_WHEEL_SLOTS].append(qMakePair(key, due));
+    }
+  }
+};
@@ -0,0 +1,199 @@
+/* Copyright (C) MOXA Inc. All rights reserved.
+This software is distributed under the terms of the MOXA SOFTWARE NOTICE.
+See the file MOXA-SOFTWARE-NOTICE for details.
+*/
+
+#pragma once
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMap>
+
+#include "act_notification_msg.hpp"
+
+// PatchUpdateBatch
+// {
+//   "OpCode": 4099,  // PatchUpdateBatch
+//   "ProjectId": 1001,
+//   "Sequence": 42,
+//   "Create": [ { "Path": "Projects/1001/Devices/1001", "Data": { ...whole object... } } ],
+//   "Update": [ { "Path": "Projects/1001/Links/1002", "Data": { "Id": 1002, ...changed fields only... } } ],
+//   "Delete": [ { "Path": "Projects/1001/Streams/1003" } ]
+// }
+
+/**
+ * @brief The pending patch update batch of one project
+ *
+ * Coalesces the device, link and stream patch updates by path. The later action wins, except:
+ *   Create + Update => Create (latest data)
+ *   Create + Delete => dropped
+ *   Delete + Create => Update (whole data)
+ *
+ */
+class ActPatchUpdateBatch {
+ public:
+  /**
+   * @brief Insert the patch update message to the batch
+   *
+   * @tparam T the patch update message type (ActDevicePatchUpdateMsg, ActLinkPatchUpdateMsg...)
+   * @param msg
+   */
+  template <class T>
+  void Insert(const T &msg) {
+    if (!msg.GetSyncToWebsocket()) {
+      return;
+    }
+
+    QJsonObject data;
+    if (msg.GetAction() != ActPatchUpdateActionEnum::kDelete) {
+      data = QJsonDocument::fromJson(msg.GetData().ToString().toUtf8()).object();
+    }
+    this->Insert(msg.GetPath(), msg.GetAction(), data);
+  }
+
+  /**
+   * @brief Insert the patch update entry to the batch
+   *
+   * @param path
+   * @param action
+   * @param data
+   */
+  void Insert(const QString &path, const ActPatchUpdateActionEnum &action, const QJsonObject &data) {
+    auto entry_it = entries_.find(path);
+    if (entry_it == entries_.end()) {
+      entries_.insert(path, Entry{action, data});
+      return;
+    }
+
+    Entry &entry = entry_it.value();
+    switch (action) {
+      case ActPatchUpdateActionEnum::kCreate:
+        entry.action = (entry.action == ActPatchUpdateActionEnum::kDelete) ? ActPatchUpdateActionEnum::kUpdate
+                                                                            : ActPatchUpdateActionEnum::kCreate;
+        entry.data = data;
+        break;
+
+      case ActPatchUpdateActionEnum::kUpdate:
+        if (entry.action == ActPatchUpdateActionEnum::kDelete) {
+          // The entity was deleted, ignore the stale update
+          break;
+        }
+        entry.data = data;
+        break;
+
+      case ActPatchUpdateActionEnum::kDelete:
+        if (entry.action == ActPatchUpdateActionEnum::kCreate) {
+          entries_.erase(entry_it);
+          break;
+        }
+        entry.action = ActPatchUpdateActionEnum::kDelete;
+        entry.data = QJsonObject();
+        break;
+    }
+  }
+
+  bool IsEmpty() const { return entries_.isEmpty(); }
+
+  qint64 Size() const { return entries_.size(); }
+
+  void Clear() { entries_.clear(); }
+
+  /**
+   * @brief Generate the batch message and update the snapshots of the entities known by the clients
+   *
+   * The update entry only carries the fields that differ from the snapshot (the "Id" is always kept). The update
+   * entry without any changed field would be skipped.
+   *
+   * @param project_id
+   * @param sequence
+   * @param snapshots <Path, last sent data>
+   * @param message the batch message
+   * @return true if the batch message contains any entry, false if there is nothing to send
+   */
+  bool Flush(const qint64 &project_id, const quint64 &sequence, QMap<QString, QJsonObject> &snapshots,
+             QJsonObject &message) {
+    QJsonArray create_array;
+    QJsonArray update_array;
+    QJsonArray delete_array;
+
+    for (auto entry_it = entries_.cbegin(); entry_it != entries_.cend(); entry_it++) {
+      const QString &path = entry_it.key();
+      const Entry &entry = entry_it.value();
+
+      QJsonObject item;
+      item.insert("Path", path);
+
+      switch (entry.action) {
+        case ActPatchUpdateActionEnum::kCreate:
+          item.insert("Data", entry.data);
+          create_array.append(item);
+          snapshots.insert(path, entry.data);
+          break;
+
+        case ActPatchUpdateActionEnum::kUpdate: {
+          auto snapshot_it = snapshots.find(path);
+          if (snapshot_it == snapshots.end()) {
+            item.insert("Data", entry.data);
+            update_array.append(item);
+            snapshots.insert(path, entry.data);
+            break;
+          }
+
+          QJsonObject changed = DiffFields(snapshot_it.value(), entry.data);
+          if (changed.isEmpty()) {
+            break;
+          }
+          if (entry.data.contains("Id")) {
+            changed.insert("Id", entry.data.value("Id"));
+          }
+          item.insert("Data", changed);
+          update_array.append(item);
+          snapshot_it.value() = entry.data;
+        } break;
+
+        case ActPatchUpdateActionEnum::kDelete:
+          delete_array.append(item);
+          snapshots.remove(path);
+          break;
+      }
+    }
+    entries_.clear();
+
+    message = QJsonObject();
+    message.insert("OpCode", static_cast<qint64>(ActWSCommandEnum::kPatchUpdateBatch));
+    message.insert("ProjectId", project_id);
+    message.insert("Sequence", static_cast<qint64>(sequence));
+    message.insert("Create", create_array);
+    message.insert("Update", update_array);
+    message.insert("Delete", delete_array);
+
+    return !(create_array.isEmpty() && update_array.isEmpty() && delete_array.isEmpty());
+  }
+
+  /**
+   * @brief Get the top-level fields of the new object which differ from the old object
+   *
+   * @param old_obj
+   * @param new_obj
+   * @return QJsonObject
+   */
+  static QJsonObject DiffFields(const QJsonObject &old_obj, const QJsonObject &new_obj) {
+    QJsonObject changed;
+    for (auto it = new_obj.constBegin(); it != new_obj.constEnd(); it++) {
+      auto old_it = old_obj.constFind(it.key());
+      if ((old_it == old_obj.constEnd()) || (old_it.value() != it.value())) {
+        changed.insert(it.key(), it.value());
+      }
+    }
+    return changed;
+  }
+
+ private:
+  struct Entry {
+    ActPatchUpdateActionEnum action;
+    QJsonObject data;
+  };
+
+  QMap<QString, Entry> entries_;  ///< <Path, Entry>
+};
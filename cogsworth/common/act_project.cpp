@@ -323,9 +323,7 @@ ACT_STATUS ActProject::GetLinkByInterfaceId(ActLink &act_link, const qint64 &dev
                                             const qint64 &interface_id) const {
   ACT_STATUS_INIT();
 
-  QSet<ActLink> link_set = this->GetLinks();
-
-  for (const ActLink &link : link_set) {
+  for (const ActLink &link : this->GetLinks()) {
     if (link.GetSourceDeviceId() == device_id && link.GetSourceInterfaceId() == interface_id) {
       act_link = link;
       return act_status;
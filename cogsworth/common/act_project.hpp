@@ -31,6 +31,7 @@ See the file MOXA-SOFTWARE-NOTICE for details.
 #include "stream/act_traffic.hpp"
 #include "topology/act_device.hpp"
 #include "topology/act_link.hpp"
+#include "topology/act_project_graph.hpp"
 #include "topology/act_topology_mapping_result.hpp"
 
 enum class ActProjectModeEnum { kDesign = 0, kOperation = 1, kManufacture = 2 };
@@ -1419,6 +1420,15 @@ class ActProject : public QSerializer {
    */
   ACT_STATUS GetLinkByInterfaceId(ActLink &act_link, const qint64 &device_id, const qint64 &interface_id) const;
 
+  /**
+   * @brief Get the adjacency index of the devices & links (for the graph walks)
+   *
+   * The graph is a snapshot, the later changes of the devices & links are not reflected.
+   *
+   * @return ActProjectGraph
+   */
+  ActProjectGraph GetGraph() const { return ActProjectGraph(this->GetDevices(), this->GetLinks()); }
+
   /**
    * @brief Get the Available Priority Code Points For a Traffic Type (Stream)
    *
@@ -0,0 +1,105 @@
+/* Copyright (C) MOXA Inc. All rights reserved.
+This software is distributed under the terms of the MOXA SOFTWARE NOTICE.
+See the file MOXA-SOFTWARE-NOTICE for details.
+*/
+
+#include "act_project_change_tracker.hpp"
+
+#include <QCryptographicHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+QByteArray ActProjectChangeTracker::Fingerprint(const QJsonValue &value) {
+  QJsonArray wrapper({value});
+  return QCryptographicHash::hash(QJsonDocument(wrapper).toJson(QJsonDocument::Compact), QCryptographicHash::Sha1);
+}
+
+ActProjectChangeSet ActProjectChangeTracker::Update(const ActProject &project) {
+  ActProjectChangeSet changes;
+  changes.created = !states_.contains(project.GetId());
+  const ProjectState previous = states_.value(project.GetId());
+  ProjectState current;
+
+  // Project setting
+  current.setting = Fingerprint(QJsonArray({project.GetProjectName(), project.GetProjectSetting().toJson()}));
+  changes.setting_changed = changes.created || (current.setting != previous.setting);
+
+  // Split the device config tables by device: <table name, <device id, table>>
+  QHash<qint64, QJsonObject> device_configs;
+  const QJsonObject device_config = project.GetDeviceConfig().toJson();
+  for (auto table_it = device_config.constBegin(); table_it != device_config.constEnd(); ++table_it) {
+    if (!table_it.value().isObject()) {
+      continue;
+    }
+    const QJsonObject tables = table_it.value().toObject();
+    for (auto it = tables.constBegin(); it != tables.constEnd(); ++it) {
+      bool ok = false;
+      const qint64 device_id = it.key().toLongLong(&ok);
+      if (ok) {
+        device_configs[device_id].insert(table_it.key(), it.value());
+      }
+    }
+  }
+
+  // Devices
+  QSet<qint64> endpoint_changed;
+  for (const auto &device : project.GetDevices()) {
+    const qint64 device_id = device.GetId();
+
+    QJsonArray interfaces;
+    for (const auto &intf : device.GetInterfaces()) {
+      interfaces.append(QString("%1:%2").arg(intf.GetInterfaceId()).arg(intf.GetInterfaceName()));
+    }
+    const QByteArray endpoint = Fingerprint(QJsonArray(
+        {device.GetIpv4().GetIpAddress(), device.GetDeviceProperty().GetModelName(), interfaces}));
+    const QByteArray fingerprint = Fingerprint(QJsonArray({device.toJson(), device_configs.value(device_id)}));
+    current.endpoints.insert(device_id, endpoint);
+    current.devices.insert(device_id, fingerprint);
+
+    auto previous_it = previous.devices.constFind(device_id);
+    if (previous_it == previous.devices.constEnd()) {
+      changes.added_devices.insert(device_id);
+      continue;
+    }
+    if (previous_it.value() != fingerprint) {
+      changes.updated_devices.insert(device_id);
+    }
+    if (previous.endpoints.value(device_id) != endpoint) {
+      endpoint_changed.insert(device_id);
+    }
+  }
+  for (auto it = previous.devices.constBegin(); it != previous.devices.constEnd(); ++it) {
+    if (!current.devices.contains(it.key())) {
+      changes.removed_devices.insert(it.key());
+    }
+  }
+
+  // Links
+  for (const auto &link : project.GetLinks()) {
+    const qint64 link_id = link.GetId();
+    const QByteArray fingerprint = Fingerprint(link.toJson());
+    current.links.insert(link_id, fingerprint);
+
+    auto previous_it = previous.links.constFind(link_id);
+    if (previous_it == previous.links.constEnd()) {
+      changes.added_links.insert(link_id);
+    } else if ((previous_it.value() != fingerprint) || endpoint_changed.contains(link.GetSourceDeviceId()) ||
+               endpoint_changed.contains(link.GetDestinationDeviceId())) {
+      changes.updated_links.insert(link_id);
+    }
+  }
+  for (auto it = previous.links.constBegin(); it != previous.links.constEnd(); ++it) {
+    if (!current.links.contains(it.key())) {
+      changes.removed_links.insert(it.key());
+    }
+  }
+
+  // Traffic design, its nodes refer to the IP and the interfaces of the devices
+  current.traffic_design = Fingerprint(project.GetTrafficDesign().toJson());
+  changes.traffic_design_changed = changes.created || (current.traffic_design != previous.traffic_design) ||
+                                   !endpoint_changed.isEmpty() || !changes.removed_devices.isEmpty();
+
+  states_.insert(project.GetId(), current);
+  return changes;
+}
@@ -0,0 +1,75 @@
+/* Copyright (C) MOXA Inc. All rights reserved.
+This software is distributed under the terms of the MOXA SOFTWARE NOTICE.
+See the file MOXA-SOFTWARE-NOTICE for details.
+*/
+
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QJsonValue>
+#include <QSet>
+
+#include "act_project.hpp"
+
+/**
+ * @brief The changes of a project since its last tracked update
+ *
+ */
+struct ActProjectChangeSet {
+  bool created = false;                 ///< The project is new to the tracker, all its parts are reported as added
+  bool setting_changed = false;         ///< The project name or the project setting changed
+  bool traffic_design_changed = false;  ///< The traffic design (or the devices it refers to) changed
+  QSet<qint64> added_devices;
+  QSet<qint64> updated_devices;  ///< The device, its interfaces or its device config tables changed
+  QSet<qint64> removed_devices;
+  QSet<qint64> added_links;
+  QSet<qint64> updated_links;  ///< The link or the IP/interfaces/profile of its end devices changed
+  QSet<qint64> removed_links;
+
+  bool IsEmpty() const {
+    return !setting_changed && !traffic_design_changed && added_devices.isEmpty() && updated_devices.isEmpty() &&
+           removed_devices.isEmpty() && added_links.isEmpty() && updated_links.isEmpty() && removed_links.isEmpty();
+  }
+};
+
+/**
+ * @brief Track the projects by the fingerprints of their parts to derive the fine-grained changes
+ *
+ * The listeners of the whole-project updates (e.g. the OPC UA address space) use it to only touch the parts that
+ * changed. A device is fingerprinted with its device config tables, and its "endpoint" (IP, model and interfaces) is
+ * fingerprinted separately, since the link and the traffic design nodes refer to it.
+ *
+ */
+class ActProjectChangeTracker {
+ public:
+  /**
+   * @brief Compare the project with its last update and record it
+   *
+   * @param project
+   * @return ActProjectChangeSet
+   */
+  ActProjectChangeSet Update(const ActProject &project);
+
+  /**
+   * @brief Forget the project (e.g. deleted, or its listener is out of sync), the next update reports it as created
+   *
+   * @param project_id
+   */
+  void Remove(const qint64 &project_id) { states_.remove(project_id); }
+
+  bool Contains(const qint64 &project_id) const { return states_.contains(project_id); }
+
+ private:
+  struct ProjectState {
+    QByteArray setting;
+    QByteArray traffic_design;
+    QHash<qint64, QByteArray> devices;    ///< <device id, fingerprint>
+    QHash<qint64, QByteArray> endpoints;  ///< <device id, fingerprint of IP, model and interfaces>
+    QHash<qint64, QByteArray> links;      ///< <link id, fingerprint>
+  };
+
+  QHash<qint64, ProjectState> states_;  ///< <project id, state>
+
+  static QByteArray Fingerprint(const QJsonValue &value);
+};
@@ -0,0 +1,150 @@
+/* Copyright (C) MOXA Inc. All rights reserved.
+This software is distributed under the terms of the MOXA SOFTWARE NOTICE.
+See the file MOXA-SOFTWARE-NOTICE for details.
+*/
+
+#pragma once
+
+#include <QDateTime>
+#include <QDebug>
+#include <QString>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <thread>
+
+#include "act_status.hpp"
+
+#define ACT_READINESS_PROBE_INITIAL_INTERVAL (100)  ///< The first poll interval(ms) of the readiness probe
+#define ACT_READINESS_PROBE_MAX_INTERVAL (1000)     ///< The maximum poll interval(ms) of the readiness probe
+
+/**
+ * @brief The readiness probe which replaces the fixed sleeps
+ *
+ * Polls the predicate until it holds or the deadline passes. The interval starts from initial_interval and doubles
+ * after each failed poll up to max_interval, so a fast device is detected in a few hundred milliseconds and a slow
+ * device is still given the whole timeout. The result (attempts and elapsed time) is logged and kept for the caller.
+ *
+ */
+class ActReadinessProbe {
+ public:
+  /**
+   * @brief Construct a new Act Readiness Probe object
+   *
+   * @param name the name in the log
+   * @param timeout the deadline(ms) from the start of Wait()
+   * @param initial_interval the first poll interval(ms)
+   * @param max_interval the maximum poll interval(ms)
+   */
+  ActReadinessProbe(const QString &name, const quint32 &timeout,
+                    const quint32 &initial_interval = ACT_READINESS_PROBE_INITIAL_INTERVAL,
+                    const quint32 &max_interval = ACT_READINESS_PROBE_MAX_INTERVAL)
+      : name_(name),
+        timeout_(timeout),
+        initial_delay_(0),
+        initial_interval_(std::max<quint32>(initial_interval, 1)),
+        max_interval_(std::max<quint32>(max_interval, initial_interval)),
+        attempts_(0),
+        elapsed_(0) {}
+
+  /**
+   * @brief Set the delay(ms) before the first poll (the state would not change immediately after the request)
+   *
+   * @param initial_delay
+   */
+  void SetInitialDelay(const quint32 &initial_delay) { initial_delay_ = initial_delay; }
+
+  /**
+   * @brief Wait until the predicate holds
+   *
+   * @param predicate
+   * @param stop_flag stop waiting when it is set (optional)
+   * @return ACT_STATUS success if ready, stop if stopped, failed if the deadline passed
+   */
+  ACT_STATUS Wait(const std::function<bool()> &predicate, const bool *stop_flag = nullptr) {
+    const qint64 start = QDateTime::currentMSecsSinceEpoch();
+    const qint64 deadline = start + timeout_;
+    quint32 interval = initial_interval_;
+    attempts_ = 0;
+    elapsed_ = 0;
+
+    if (!SleepUntil(std::min<qint64>(start + initial_delay_, deadline), stop_flag)) {
+      return Finish(start, ACT_STATUS_STOP);
+    }
+
+    while (true) {
+      attempts_++;
+      if (predicate()) {
+        return Finish(start, ACT_STATUS_SUCCESS);
+      }
+
+      const qint64 now = QDateTime::currentMSecsSinceEpoch();
+      if (now >= deadline) {
+        auto status = std::make_shared<ActStatusBase>(ActStatusType::kFailed, ActSeverity::kWarning);
+        status->SetErrorMessage(QString("%1 is not ready in %2 ms").arg(name_).arg(timeout_));
+        return Finish(start, status);
+      }
+
+      if (!SleepUntil(std::min<qint64>(now + interval, deadline), stop_flag)) {
+        return Finish(start, ACT_STATUS_STOP);
+      }
+      interval = std::min<quint32>(interval * 2, max_interval_);
+    }
+  }
+
+  /**
+   * @brief Get the number of the polls of the last Wait()
+   *
+   * @return quint32
+   */
+  quint32 GetAttempts() const { return attempts_; }
+
+  /**
+   * @brief Get the elapsed time(ms) of the last Wait()
+   *
+   * @return qint64
+   */
+  qint64 GetElapsed() const { return elapsed_; }
+
+ private:
+  QString name_;
+  quint32 timeout_;
+  quint32 initial_delay_;
+  quint32 initial_interval_;
+  quint32 max_interval_;
+  quint32 attempts_;
+  qint64 elapsed_;
+
+  /**
+   * @brief Sleep until the time(ms since epoch), wake up every initial interval to check the stop flag
+   *
+   * @param until
+   * @param stop_flag
+   * @return false if stopped
+   */
+  bool SleepUntil(const qint64 &until, const bool *stop_flag) const {
+    while (true) {
+      if ((stop_flag != nullptr) && *stop_flag) {
+        return false;
+      }
+      const qint64 remaining = until - QDateTime::currentMSecsSinceEpoch();
+      if (remaining <= 0) {
+        return true;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(std::min<qint64>(remaining, initial_interval_)));
+    }
+  }
+
+  ACT_STATUS Finish(const qint64 &start, ACT_STATUS status) {
+    elapsed_ = QDateTime::currentMSecsSinceEpoch() - start;
+    qDebug() << "ReadinessProbe"
+             << QString("%1: %2 after %3 attempts in %4 ms")
+                    .arg(name_)
+                    .arg(IsActStatusSuccess(status) ? "ready" : status->GetErrorMessage())
+                    .arg(attempts_)
+                    .arg(elapsed_)
+                    .toStdString()
+                    .c_str();
+    return status;
+  }
+};
@@ -0,0 +1,120 @@
+/* Copyright (C) MOXA Inc. All rights reserved.
+This software is distributed under the terms of the MOXA SOFTWARE NOTICE.
+See the file MOXA-SOFTWARE-NOTICE for details.
+*/
+
+#include "act_session_store.hpp"
+
+#include <QReadLocker>
+#include <QWriteLocker>
+
+void ActSessionStore::EraseExpiry(Shard &shard, const qint64 &expiry, const QString &token) {
+  auto range = shard.expiries.equal_range(expiry);
+  for (auto it = range.first; it != range.second; it++) {
+    if (it->second == token) {
+      shard.expiries.erase(it);
+      return;
+    }
+  }
+}
+
+void ActSessionStore::Insert(const QString &token, const ActSession &session) {
+  Shard &shard = GetShard(token);
+  QWriteLocker lock(&shard.lock);
+
+  auto it = shard.sessions.find(token);
+  if (it != shard.sessions.end()) {
+    EraseExpiry(shard, it.value().expiry, token);
+  }
+  shard.sessions.insert(token, session);
+  shard.expiries.emplace(session.expiry, token);
+}
+
+bool ActSessionStore::Find(const QString &token, const qint64 &now, ActSession &result_session) {
+  Shard &shard = GetShard(token);
+  QReadLocker lock(&shard.lock);
+
+  auto it = shard.sessions.constFind(token);
+  // The expired session is left to the sweep
+  if (it == shard.sessions.constEnd() || it.value().expiry <= now) {
+    return false;
+  }
+
+  result_session = it.value();
+  return true;
+}
+
+bool ActSessionStore::Remove(const QString &token) {
+  Shard &shard = GetShard(token);
+  QWriteLocker lock(&shard.lock);
+
+  auto it = shard.sessions.find(token);
+  if (it == shard.sessions.end()) {
+    return false;
+  }
+
+  EraseExpiry(shard, it.value().expiry, token);
+  shard.sessions.erase(it);
+  return true;
+}
+
+qint32 ActSessionStore::RemoveUser(const qint64 &user_id) {
+  qint32 removed = 0;
+  for (Shard &shard : shards_) {
+    QWriteLocker lock(&shard.lock);
+    for (auto it = shard.sessions.begin(); it != shard.sessions.end();) {
+      if (it.value().user_id == user_id) {
+        EraseExpiry(shard, it.value().expiry, it.key());
+        it = shard.sessions.erase(it);
+        removed++;
+      } else {
+        it++;
+      }
+    }
+  }
+
+  return removed;
+}
+
+void ActSessionStore::UpdateUserRole(const qint64 &user_id, const ActRoleEnum &role) {
+  for (Shard &shard : shards_) {
+    QWriteLocker lock(&shard.lock);
+    for (auto it = shard.sessions.begin(); it != shard.sessions.end(); it++) {
+      if (it.value().user_id == user_id) {
+        it.value().role = role;
+      }
+    }
+  }
+}
+
+qint32 ActSessionStore::RemoveExpired(const qint64 &now) {
+  qint32 removed = 0;
+  for (Shard &shard : shards_) {
+    // Only take the write lock if the earliest session is expired
+    {
+      QReadLocker lock(&shard.lock);
+      if (shard.expiries.empty() || shard.expiries.begin()->first > now) {
+        continue;
+      }
+    }
+
+    QWriteLocker lock(&shard.lock);
+    while (!shard.expiries.empty() && shard.expiries.begin()->first <= now) {
+      shard.sessions.remove(shard.expiries.begin()->second);
+      shard.expiries.erase(shard.expiries.begin());
+      removed++;
+    }
+  }
+
+  return removed;
+}
+
+qint32 ActSessionStore::Size() {
+  qint32 size = 0;
+  for (Shard &shard : shards_) {
+    QReadLocker lock(&shard.lock);
+    size += shard.sessions.size();
+  }
+
+  return size;
+}
@@ -0,0 +1,104 @@
+/* Copyright (C) MOXA Inc. All rights reserved.
+This software is distributed under the terms of the MOXA SOFTWARE NOTICE.
+See the file MOXA-SOFTWARE-NOTICE for details.
+*/
+
+#pragma once
+
+#include <QHash>
+#include <QReadWriteLock>
+#include <QString>
+#include <map>
+
+#include "act_user.hpp"
+
+#define ACT_SESSION_STORE_SHARDS (16)  ///< The shards of the session store (a power of 2)
+
+/**
+ * @brief The login session of a token
+ *
+ */
+struct ActSession {
+  qint64 user_id;
+  ActRoleEnum role;
+  qint64 expiry;  ///< The hard timeout(ms since epoch)
+};
+
+/**
+ * @brief The login sessions keyed by the token
+ *
+ * The sessions are spread over the shards by the token hash, each guarded by its own read-write lock, so the
+ * verifications of the REST calls only share a read lock of one shard and never wait for the core. Each shard keeps its
+ * sessions ordered by the expiry as well, so the hard-timeout sweep only visits the expired sessions. All the methods
+ * are thread-safe.
+ *
+ */
+class ActSessionStore {
+ public:
+  ActSessionStore() {}
+
+  /**
+   * @brief Insert (or replace) the session
+   *
+   * @param token
+   * @param session
+   */
+  void Insert(const QString &token, const ActSession &session);
+
+  /**
+   * @brief Find the session not expired yet
+   *
+   * @param token
+   * @param now (ms since epoch)
+   * @param result_session
+   * @return true if found
+   */
+  bool Find(const QString &token, const qint64 &now, ActSession &result_session);
+
+  /**
+   * @brief Remove the session (e.g. logout)
+   *
+   * @param token
+   * @return true if removed
+   */
+  bool Remove(const QString &token);
+
+  /**
+   * @brief Remove the sessions of the user (e.g. the password is changed or the user is deleted)
+   *
+   * @param user_id
+   * @return qint32 the removed sessions
+   */
+  qint32 RemoveUser(const qint64 &user_id);
+
+  /**
+   * @brief Update the role of the user's sessions
+   *
+   * @param user_id
+   * @param role
+   */
+  void UpdateUserRole(const qint64 &user_id, const ActRoleEnum &role);
+
+  /**
+   * @brief Remove the expired sessions
+   *
+   * @param now (ms since epoch)
+   * @return qint32 the removed sessions
+   */
+  qint32 RemoveExpired(const qint64 &now);
+
+  qint32 Size();
+
+ private:
+  struct Shard {
+    QReadWriteLock lock;
+    QHash<QString, ActSession> sessions;      ///< <token, session>
+    std::multimap<qint64, QString> expiries;  ///< <expiry, token>
+  };
+
+  Shard &GetShard(const QString &token) { return shards_[qHash(token) & (ACT_SESSION_STORE_SHARDS - 1)]; }
+
+  static void EraseExpiry(Shard &shard, const qint64 &expiry, const QString &token);
+
+  Shard shards_[ACT_SESSION_STORE_SHARDS];
+};
@@ -20,6 +20,12 @@ See the file MOXA-SOFTWARE-NOTICE for details.
 #define ACT_LOG_FOLDER "logs"      ///< The folder of log files
 #define ACT_LOG_MIN_FREE_GB (5)    // Default minimum free GB for logs
 #define ACT_LOG_KEEP_DAYS (30)     // Default log retention days
+#define ACT_LOG_BUFFER_SIZE (8192)          ///< The number of the log entries buffered for the log writer
+#define ACT_LOG_WRITER_INTERVAL (100)       ///< The maximum interval(ms) before the buffered logs are written
+#define ACT_LOG_FILE_CHECK_INTERVAL (1000)  ///< The interval(ms) to check whether the log file is removed
+#define ACT_LOG_FLUSH_TIMEOUT (3000)        ///< The timeout(ms) to wait for the buffered logs being written
+
+#define ACT_TIME_SERIES_KEEP_DAYS (30)  ///< Default retention days of the monitored time-series
 
 #define ACT_DATABASE_FOLDER_TMP "db"
 
@@ -132,6 +138,17 @@ See the file MOXA-SOFTWARE-NOTICE for details.
 #define ACT_HARD_TIMEOUT (60)
 #define ACT_TOKEN_MAX_SIZE (10)
 #define ACT_WS_SOCKET_MAX_SIZE (ACT_TOKEN_MAX_SIZE * 3)
+#define ACT_NOTIFICATION_BATCH_WINDOW (0)    ///< The default coalescing window(ms) of the patch updates, 0 is disabled
+#define ACT_NOTIFICATION_BATCH_WINDOW_MAX (5000)
+#define ACT_NOTIFICATION_BATCH_CHECK (200)  ///< The interval(ms) to check the window while the batching is disabled
+
+// HTTP server
+#define ACT_HTTP_WORKER_THREAD_SIZE (64)          ///< The number of the REST worker threads
+#define ACT_HTTP_PENDING_CONNECTION_SIZE (1024)   ///< The maximum number of the queued REST connections
+#define ACT_HTTP_ASYNC_WORKER_THREAD_SIZE (2)     ///< The number of the websocket executor data-processing threads
+#define ACT_HTTP_KEEP_ALIVE_TIMEOUT (5000)        ///< The time(ms) an idle keep-alive connection holds its REST worker
+#define ACT_HTTP_KEEP_ALIVE_GRACE (100)           ///< The idle time(ms) to close while other connections are queued
+#define ACT_HTTP_KEEP_ALIVE_CHECK (100)           ///< The interval(ms) to check the idle keep-alive connections
 
 // Account
 #define ACT_DEFAULT_DEVICE_ACCOUNT_USERNAME "admin"
@@ -180,6 +197,9 @@ See the file MOXA-SOFTWARE-NOTICE for details.
 #define ACT_NEW_MOXA_COMMAND_FIRMWARE_UPGRADE_TIMEOUT (240)
 
 #define ACT_DEPLOY_TSN_SWITCH_RETRY_TIMES (3)
+#define ACT_DEPLOY_PARALLELISM (8)      ///< The default maximum number of the devices deployed concurrently
+#define ACT_DEPLOY_PARALLELISM_MAX (32)
+#define ACT_DEPLOY_IP_READY_TIMEOUT (10000)
 
 // #define ACT_DEFAULT_DEVICE_PROFILE_ID (0)
 #define ACT_SWITCH_PROFILE_ID (1)
@@ -336,6 +356,10 @@ class ActSystem : public QSerializer {
                  IntelligentLocalEndpoint);                ///< The local endpoint of the AI server
   ACT_JSON_FIELD(quint32, log_min_free_gb, LogMinFreeGb);  // Minimum free GB for logs
   ACT_JSON_FIELD(quint32, log_keep_days, LogKeepDays);     // Log retention days
+  ACT_JSON_FIELD(quint32, notification_batch_window,
+                 NotificationBatchWindow);  ///< The coalescing window(ms) of the patch updates, 0 is disabled
+  ACT_JSON_FIELD(quint32, time_series_keep_days, TimeSeriesKeepDays);  ///< The retention days of the monitor history
+  ACT_JSON_FIELD(quint32, deploy_parallelism, DeployParallelism);       ///< The devices deployed concurrently in a wave
 
  public:
   QList<QString> key_order_;
@@ -354,10 +378,15 @@ class ActSystem : public QSerializer {
     this->intelligent_local_endpoint_ = "";
     this->log_min_free_gb_ = ACT_LOG_MIN_FREE_GB;  // Default minimum free GB for logs
     this->log_keep_days_ = ACT_LOG_KEEP_DAYS;      // Default log retention days
+    this->notification_batch_window_ = ACT_NOTIFICATION_BATCH_WINDOW;
+    this->time_series_keep_days_ = ACT_TIME_SERIES_KEEP_DAYS;
+    this->deploy_parallelism_ = ACT_DEPLOY_PARALLELISM;
     this->key_order_.append(
         QList<QString>({QString("ActVersion"), QString("DataVersion"), QString("AutoSave"), QString("IdleTimeout"),
                         QString("HardTimeout"), QString("MaxTokenSize"), QString("SerialNumber")}));
     this->key_order_.append(QList<QString>({QString("LogMinFreeGb"), QString("LogKeepDays")}));
+    this->key_order_.append(QList<QString>({QString("NotificationBatchWindow"), QString("TimeSeriesKeepDays")}));
+    this->key_order_.append(QList<QString>({QString("DeployParallelism")}));
   }
 
   /**
@@ -0,0 +1,428 @@
+/* Copyright (C) MOXA Inc. All rights reserved.
+This software is distributed under the terms of the MOXA SOFTWARE NOTICE.
+See the file MOXA-SOFTWARE-NOTICE for details.
+*/
+
+#include "act_time_series_store.hpp"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <algorithm>
+
+#define ACT_TIME_SERIES_SEGMENT_MAGIC (0x41435453)  ///< "ACTS"
+#define ACT_TIME_SERIES_SEGMENT_VERSION (2)  ///< 2: the snapshot is followed by the appended samples
+
+namespace {
+
+QDataStream &operator<<(QDataStream &stream, const ActTimeSeriesSample &sample) {
+  return stream << sample.timestamp << sample.value;
+}
+
+QDataStream &operator>>(QDataStream &stream, ActTimeSeriesSample &sample) {
+  return stream >> sample.timestamp >> sample.value;
+}
+
+QDataStream &operator<<(QDataStream &stream, const ActTimeSeriesBucket &bucket) {
+  return stream << bucket.timestamp << bucket.min << bucket.max << bucket.sum << bucket.count;
+}
+
+QDataStream &operator>>(QDataStream &stream, ActTimeSeriesBucket &bucket) {
+  return stream >> bucket.timestamp >> bucket.min >> bucket.max >> bucket.sum >> bucket.count;
+}
+
+template <typename T>
+void WriteRing(QDataStream &stream, const ActTimeSeriesRing<T> &ring) {
+  stream << static_cast<quint32>(ring.Size());
+  for (qint32 i = 0; i < ring.Size(); i++) {
+    stream << ring.At(i);
+  }
+}
+
+template <typename T>
+void ReadRing(QDataStream &stream, ActTimeSeriesRing<T> &ring) {
+  quint32 size = 0;
+  stream >> size;
+  for (quint32 i = 0; (i < size) && (stream.status() == QDataStream::Ok); i++) {
+    T item;
+    stream >> item;
+    ring.Push(item);  // the oldest items are overwritten if the capacity is smaller now
+  }
+}
+
+/**
+ * @brief Close the open bucket if the sample is in the next one, then add the sample to the open bucket
+ *
+ */
+void RollUp(ActTimeSeriesRing<ActTimeSeriesBucket> &ring, ActTimeSeriesBucket &open_bucket, const qint64 &span,
+            const qint64 &timestamp, const qreal &value) {
+  const qint64 bucket_start = timestamp - (timestamp % span);
+  if ((open_bucket.count > 0) && (open_bucket.timestamp != bucket_start)) {
+    ring.Push(open_bucket);
+    open_bucket = ActTimeSeriesBucket{bucket_start, 0, 0, 0, 0};
+  }
+  if (open_bucket.count == 0) {
+    open_bucket.timestamp = bucket_start;
+  }
+  open_bucket.Add(value);
+}
+
+ActTimeSeriesPoint ToPoint(const ActTimeSeriesBucket &bucket) {
+  ActTimeSeriesPoint point;
+  point.SetTimestamp(bucket.timestamp);
+  point.SetValue(bucket.sum / bucket.count);
+  point.SetMin(bucket.min);
+  point.SetMax(bucket.max);
+  point.SetCount(bucket.count);
+  return point;
+}
+
+/**
+ * @brief Append the buckets which overlap [from, to] (including the open bucket)
+ *
+ */
+void AppendBuckets(const ActTimeSeriesRing<ActTimeSeriesBucket> &ring, const ActTimeSeriesBucket &open_bucket,
+                   const qint64 &span, const qint64 &from, const qint64 &to, QList<ActTimeSeriesPoint> &points) {
+  const qint64 first_bucket = from - (from % span);
+  for (qint32 i = ring.LowerBound(first_bucket); (i < ring.Size()) && (ring.At(i).timestamp <= to); i++) {
+    points.append(ToPoint(ring.At(i)));
+  }
+  if ((open_bucket.count > 0) && (open_bucket.timestamp >= first_bucket) && (open_bucket.timestamp <= to)) {
+    points.append(ToPoint(open_bucket));
+  }
+}
+
+}  // namespace
+
+ActTimeSeriesStore::ActTimeSeriesStore(const quint32 &keep_days, const qint32 &raw_capacity,
+                                       const qint32 &minute_capacity)
+    : keep_days_(qMax<quint32>(keep_days, 1)),
+      raw_capacity_(raw_capacity),
+      minute_capacity_(minute_capacity),
+      dropped_count_(0) {}
+
+ACT_STATUS ActTimeSeriesStore::Open(const QString &folder) {
+  ACT_STATUS_INIT();
+
+  QMutexLocker flush_locker(&flush_mutex_);
+  QMutexLocker locker(&mutex_);
+
+  if (!QDir().mkpath(folder)) {
+    qCritical() << __func__ << "Create the time-series folder failed:" << folder;
+    return std::make_shared<ActStatusInternalError>("TimeSeries");
+  }
+
+  folder_ = folder;
+  series_.clear();
+  removed_metrics_.clear();
+
+  const QStringList segment_files =
+      QDir(folder_).entryList(QStringList() << QString("*.%1").arg(ACT_TIME_SERIES_FILE_SUFFIX), QDir::Files);
+  for (const QString &segment_file : segment_files) {
+    QString metric;
+    ActTimeSeriesData data;
+    InitSeries(data);
+    if (!ReadSegment(QDir(folder_).filePath(segment_file), metric, data)) {
+      qWarning() << __func__ << "Skip the broken time-series segment:" << segment_file;
+      continue;
+    }
+    Evict(data, data.last_timestamp);
+    series_.insert(metric, data);
+  }
+
+  qDebug() << __func__ << "Load" << series_.size() << "time-series metrics from" << folder_;
+  return act_status;
+}
+
+ACT_STATUS ActTimeSeriesStore::Flush() {
+  ACT_STATUS_INIT();
+
+  QMutexLocker flush_locker(&flush_mutex_);
+
+  // Copy the snapshots (the rings are implicitly shared) & the new samples and write them without blocking the ingest
+  QHash<QString, ActTimeSeriesData> snapshots;
+  QHash<QString, QVector<ActTimeSeriesSample>> appended_samples;
+  QSet<QString> removed_metrics;
+  {
+    QMutexLocker locker(&mutex_);
+    if (folder_.isEmpty()) {
+      return act_status;
+    }
+    const qint64 oldest = QDateTime::currentMSecsSinceEpoch() - RetentionMs();
+    for (auto series_it = series_.begin(); series_it != series_.end();) {
+      if (series_it->last_timestamp < oldest) {
+        removed_metrics_.insert(series_it.key());
+        series_it = series_.erase(series_it);
+        continue;
+      }
+
+      ActTimeSeriesData &data = series_it.value();
+      // The snapshot is rewritten once the appended samples reach the raw capacity (or some are already overwritten)
+      if (data.compact || (data.logged + data.pending > raw_capacity_) || (data.pending > data.raw.Size())) {
+        snapshots.insert(series_it.key(), data);
+        data.logged = 0;
+        data.compact = false;
+      } else if (data.pending > 0) {
+        QVector<ActTimeSeriesSample> &samples = appended_samples[series_it.key()];
+        samples.reserve(data.pending);
+        for (qint32 i = data.raw.Size() - data.pending; i < data.raw.Size(); i++) {
+          samples.append(data.raw.At(i));
+        }
+        data.logged += data.pending;
+      }
+      data.pending = 0;
+      series_it++;
+    }
+    removed_metrics.swap(removed_metrics_);
+  }
+
+  for (const QString &metric : removed_metrics) {
+    QFile::remove(SegmentPath(metric));
+  }
+
+  QStringList failed_metrics;
+  for (auto series_it = snapshots.constBegin(); series_it != snapshots.constEnd(); series_it++) {
+    if (!WriteSegment(series_it.key(), series_it.value())) {
+      failed_metrics.append(series_it.key());
+    }
+  }
+  for (auto samples_it = appended_samples.constBegin(); samples_it != appended_samples.constEnd(); samples_it++) {
+    if (!AppendSegment(samples_it.key(), samples_it.value())) {
+      failed_metrics.append(samples_it.key());
+    }
+  }
+
+  if (!failed_metrics.isEmpty()) {
+    // Rewrite the whole segment on the next flush, a failed append may leave a partial sample behind
+    QMutexLocker locker(&mutex_);
+    for (const QString &metric : failed_metrics) {
+      auto series_it = series_.find(metric);
+      if (series_it != series_.end()) {
+        series_it->compact = true;
+      }
+    }
+    qCritical() << __func__ << "Write the time-series segments failed:" << failed_metrics.size();
+    return std::make_shared<ActStatusInternalError>("TimeSeries");
+  }
+
+  return act_status;
+}
+
+void ActTimeSeriesStore::SetKeepDays(const quint32 &keep_days) {
+  QMutexLocker locker(&mutex_);
+
+  if (qMax<quint32>(keep_days, 1) == keep_days_) {
+    return;
+  }
+
+  keep_days_ = qMax<quint32>(keep_days, 1);
+  for (ActTimeSeriesData &data : series_) {
+    data.minutes.SetCapacity(qMin(minute_capacity_, static_cast<qint32>(keep_days_) * 24 * 60));
+    data.hours.SetCapacity(HourCapacity());
+    Evict(data, data.last_timestamp);
+    data.compact = true;
+  }
+}
+
+bool ActTimeSeriesStore::Append(const QString &metric, const qint64 &timestamp, const qreal &value) {
+  QMutexLocker locker(&mutex_);
+
+  auto series_it = series_.find(metric);
+  if (series_it == series_.end()) {
+    series_it = series_.insert(metric, ActTimeSeriesData());
+    InitSeries(series_it.value());
+    removed_metrics_.remove(metric);
+  }
+
+  ActTimeSeriesData &data = series_it.value();
+  if ((timestamp < 0) || (timestamp < data.last_timestamp)) {
+    dropped_count_++;
+    return false;
+  }
+
+  Ingest(data, timestamp, value);
+  data.pending++;
+  return true;
+}
+
+ACT_STATUS ActTimeSeriesStore::Query(const QString &metric, const qint64 &from, const qint64 &to,
+                                     const ActTimeSeriesResolutionEnum &resolution, ActTimeSeries &time_series) {
+  ACT_STATUS_INIT();
+
+  if ((from < 0) || (from > to)) {
+    return std::make_shared<ActBadRequest>(QString("The time range [%1, %2] is invalid").arg(from).arg(to));
+  }
+
+  QMutexLocker locker(&mutex_);
+
+  auto series_it = series_.constFind(metric);
+  if (series_it == series_.constEnd()) {
+    return std::make_shared<ActStatusNotFound>(QString("Metric(%1)").arg(metric));
+  }
+  const ActTimeSeriesData &data = series_it.value();
+
+  // The finest resolution which still covers the start of the range
+  ActTimeSeriesResolutionEnum query_resolution = resolution;
+  if (query_resolution == ActTimeSeriesResolutionEnum::kAuto) {
+    const qint64 first_minute =
+        data.minutes.IsEmpty() ? data.open_minute.timestamp : data.minutes.Front().timestamp;
+    if (!data.raw.IsEmpty() && (data.raw.Front().timestamp <= from)) {
+      query_resolution = ActTimeSeriesResolutionEnum::kRaw;
+    } else if ((data.open_minute.count > 0) && (first_minute <= from)) {
+      query_resolution = ActTimeSeriesResolutionEnum::kMinute;
+    } else {
+      query_resolution = ActTimeSeriesResolutionEnum::kHour;
+    }
+  }
+
+  QList<ActTimeSeriesPoint> points;
+  switch (query_resolution) {
+    case ActTimeSeriesResolutionEnum::kRaw:
+      for (qint32 i = data.raw.LowerBound(from); (i < data.raw.Size()) && (data.raw.At(i).timestamp <= to); i++) {
+        const ActTimeSeriesSample &sample = data.raw.At(i);
+        ActTimeSeriesPoint point;
+        point.SetTimestamp(sample.timestamp);
+        point.SetValue(sample.value);
+        point.SetMin(sample.value);
+        point.SetMax(sample.value);
+        point.SetCount(1);
+        points.append(point);
+      }
+      break;
+    case ActTimeSeriesResolutionEnum::kMinute:
+      AppendBuckets(data.minutes, data.open_minute, ACT_TIME_SERIES_MINUTE_MS, from, to, points);
+      break;
+    default:
+      AppendBuckets(data.hours, data.open_hour, ACT_TIME_SERIES_HOUR_MS, from, to, points);
+      break;
+  }
+
+  time_series.SetMetric(metric);
+  time_series.SetResolution(query_resolution);
+  time_series.SetFrom(from);
+  time_series.SetTo(to);
+  time_series.SetPoints(points);
+  return act_status;
+}
+
+QList<QString> ActTimeSeriesStore::GetMetrics() {
+  QMutexLocker locker(&mutex_);
+
+  QList<QString> metrics = series_.keys();
+  std::sort(metrics.begin(), metrics.end());
+  return metrics;
+}
+
+qint64 ActTimeSeriesStore::GetDroppedCount() {
+  QMutexLocker locker(&mutex_);
+  return dropped_count_;
+}
+
+void ActTimeSeriesStore::InitSeries(ActTimeSeriesData &data) const {
+  data.raw.SetCapacity(raw_capacity_);
+  data.minutes.SetCapacity(qMin(minute_capacity_, static_cast<qint32>(keep_days_) * 24 * 60));
+  data.hours.SetCapacity(HourCapacity());
+}
+
+void ActTimeSeriesStore::Ingest(ActTimeSeriesData &data, const qint64 &timestamp, const qreal &value) const {
+  data.raw.Push(ActTimeSeriesSample{timestamp, value});
+  RollUp(data.minutes, data.open_minute, ACT_TIME_SERIES_MINUTE_MS, timestamp, value);
+  RollUp(data.hours, data.open_hour, ACT_TIME_SERIES_HOUR_MS, timestamp, value);
+  data.last_timestamp = timestamp;
+
+  Evict(data, timestamp);
+}
+
+void ActTimeSeriesStore::Evict(ActTimeSeriesData &data, const qint64 &now) const {
+  const qint64 oldest = now - RetentionMs();
+  while (!data.raw.IsEmpty() && (data.raw.Front().timestamp < oldest)) {
+    data.raw.PopFront();
+  }
+  while (!data.minutes.IsEmpty() && (data.minutes.Front().timestamp < oldest)) {
+    data.minutes.PopFront();
+  }
+  while (!data.hours.IsEmpty() && (data.hours.Front().timestamp < oldest)) {
+    data.hours.PopFront();
+  }
+}
+
+QString ActTimeSeriesStore::SegmentPath(const QString &metric) const {
+  return QDir(folder_).filePath(
+      QString("%1.%2").arg(QString::fromLatin1(metric.toUtf8().toHex())).arg(ACT_TIME_SERIES_FILE_SUFFIX));
+}
+
+bool ActTimeSeriesStore::WriteSegment(const QString &metric, const ActTimeSeriesData &data) const {
+  QSaveFile file(SegmentPath(metric));
+  if (!file.open(QIODevice::WriteOnly)) {
+    return false;
+  }
+
+  QDataStream stream(&file);
+  stream.setVersion(QDataStream::Qt_5_12);
+  stream << static_cast<quint32>(ACT_TIME_SERIES_SEGMENT_MAGIC)
+         << static_cast<quint32>(ACT_TIME_SERIES_SEGMENT_VERSION);
+  stream << metric << data.last_timestamp << data.open_minute << data.open_hour;
+  WriteRing(stream, data.raw);
+  WriteRing(stream, data.minutes);
+  WriteRing(stream, data.hours);
+
+  return (stream.status() == QDataStream::Ok) && file.commit();
+}
+
+bool ActTimeSeriesStore::AppendSegment(const QString &metric, const QVector<ActTimeSeriesSample> &samples) const {
+  // The samples are only appended behind a snapshot
+  QFile file(SegmentPath(metric));
+  if (!file.exists() || !file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+    return false;
+  }
+
+  QDataStream stream(&file);
+  stream.setVersion(QDataStream::Qt_5_12);
+  for (const ActTimeSeriesSample &sample : samples) {
+    stream << sample;
+  }
+
+  return (stream.status() == QDataStream::Ok) && file.flush();
+}
+
+bool ActTimeSeriesStore::ReadSegment(const QString &path, QString &metric, ActTimeSeriesData &data) const {
+  QFile file(path);
+  if (!file.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+
+  QDataStream stream(&file);
+  stream.setVersion(QDataStream::Qt_5_12);
+  quint32 magic = 0;
+  quint32 version = 0;
+  stream >> magic >> version;
+  if ((magic != ACT_TIME_SERIES_SEGMENT_MAGIC) || (version < 1) || (version > ACT_TIME_SERIES_SEGMENT_VERSION)) {
+    return false;
+  }
+
+  stream >> metric >> data.last_timestamp >> data.open_minute >> data.open_hour;
+  ReadRing(stream, data.raw);
+  ReadRing(stream, data.minutes);
+  ReadRing(stream, data.hours);
+  if ((stream.status() != QDataStream::Ok) || metric.isEmpty()) {
+    return false;
+  }
+
+  // Replay the appended samples, a partial one (e.g. the power is lost while appending) ends the segment
+  while (!stream.atEnd()) {
+    ActTimeSeriesSample sample;
+    stream >> sample;
+    if (stream.status() != QDataStream::Ok) {
+      break;
+    }
+    Ingest(data, sample.timestamp, sample.value);
+    data.logged++;
+  }
+
+  // The version 1 segment & the partial sample are rewritten on the next flush
+  data.compact = (version != ACT_TIME_SERIES_SEGMENT_VERSION) || (stream.status() != QDataStream::Ok);
+  return true;
+}
@@ -0,0 +1,336 @@
+/* Copyright (C) MOXA Inc. All rights reserved.
+This software is distributed under the terms of the MOXA SOFTWARE NOTICE.
+See the file MOXA-SOFTWARE-NOTICE for details.
+*/
+
+#pragma once
+
+#include <QHash>
+#include <QMap>
+#include <QMutex>
+#include <QSet>
+#include <QString>
+#include <QVector>
+
+#include "act_json.hpp"
+#include "act_status.hpp"
+
+#define ACT_TIME_SERIES_FOLDER "time_series"      ///< The folder of the time-series segments in the database folder
+#define ACT_TIME_SERIES_FILE_SUFFIX "ts"          ///< The file suffix of the time-series segments
+#define ACT_TIME_SERIES_RAW_CAPACITY (2048)       ///< The raw samples kept per metric
+#define ACT_TIME_SERIES_MINUTE_CAPACITY (1440)    ///< The 1 minute roll-ups kept per metric (1 day)
+#define ACT_TIME_SERIES_FLUSH_INTERVAL (60)       ///< The interval(s) to flush the changed segments to the disk
+#define ACT_TIME_SERIES_MINUTE_MS (60 * 1000)     ///< The span(ms) of the minute roll-up
+#define ACT_TIME_SERIES_HOUR_MS (60 * 60 * 1000)  ///< The span(ms) of the hour roll-up
+
+enum class ActTimeSeriesResolutionEnum { kAuto, kRaw, kMinute, kHour };
+static const QMap<QString, ActTimeSeriesResolutionEnum> kActTimeSeriesResolutionEnumMap = {
+    {"Auto", ActTimeSeriesResolutionEnum::kAuto},
+    {"Raw", ActTimeSeriesResolutionEnum::kRaw},
+    {"Minute", ActTimeSeriesResolutionEnum::kMinute},
+    {"Hour", ActTimeSeriesResolutionEnum::kHour}};
+
+/**
+ * @brief The point of the time-series query (a raw sample or a roll-up)
+ *
+ */
+class ActTimeSeriesPoint : public QSerializer {
+  Q_GADGET
+  QS_SERIALIZABLE
+
+  ACT_JSON_FIELD(qint64, timestamp, Timestamp);  ///< The sample time or the start of the roll-up (ms since epoch)
+  ACT_JSON_FIELD(qreal, value, Value);           ///< The sample value or the average of the roll-up
+  ACT_JSON_FIELD(qreal, min, Min);
+  ACT_JSON_FIELD(qreal, max, Max);
+  ACT_JSON_FIELD(qint64, count, Count);  ///< The number of the samples in the point
+
+ public:
+  ActTimeSeriesPoint() {
+    this->timestamp_ = 0;
+    this->value_ = 0;
+    this->min_ = 0;
+    this->max_ = 0;
+    this->count_ = 0;
+  }
+};
+
+/**
+ * @brief The result of the time-series range query
+ *
+ */
+class ActTimeSeries : public QSerializer {
+  Q_GADGET
+  QS_SERIALIZABLE
+
+  ACT_JSON_FIELD(QString, metric, Metric);
+  ACT_JSON_ENUM(ActTimeSeriesResolutionEnum, resolution, Resolution);  ///< The resolution of the points
+  ACT_JSON_FIELD(qint64, from, From);
+  ACT_JSON_FIELD(qint64, to, To);
+  ACT_JSON_COLLECTION_OBJECTS(QList, ActTimeSeriesPoint, points, Points);
+
+ public:
+  ActTimeSeries() {
+    this->resolution_ = ActTimeSeriesResolutionEnum::kRaw;
+    this->from_ = 0;
+    this->to_ = 0;
+  }
+};
+
+/**
+ * @brief The list of the metrics in the time-series store
+ *
+ */
+class ActTimeSeriesMetrics : public QSerializer {
+  Q_GADGET
+  QS_SERIALIZABLE
+
+  ACT_JSON_COLLECTION(QList, QString, metrics, Metrics);
+};
+
+/**
+ * @brief The ring of the fixed capacity, the oldest item is overwritten when it is full
+ *
+ * @tparam T
+ */
+template <typename T>
+class ActTimeSeriesRing {
+ public:
+  ActTimeSeriesRing() : start_(0), size_(0), capacity_(0) {}
+
+  /**
+   * @brief Set the capacity, the newest items are kept
+   *
+   * @param capacity
+   */
+  void SetCapacity(const qint32 &capacity) {
+    QVector<T> items;
+    const qint32 keep = qMin(size_, capacity);
+    items.reserve(keep);
+    for (qint32 i = size_ - keep; i < size_; i++) {
+      items.append(At(i));
+    }
+    items_ = items;
+    start_ = 0;
+    size_ = keep;
+    capacity_ = capacity;
+  }
+
+  void Push(const T &item) {
+    if (capacity_ <= 0) {
+      return;
+    }
+    if (items_.size() < capacity_) {  // grow until the capacity
+      items_.append(item);
+      size_++;
+      return;
+    }
+    items_[(start_ + size_) % capacity_] = item;
+    if (size_ < capacity_) {
+      size_++;
+    } else {
+      start_ = (start_ + 1) % capacity_;
+    }
+  }
+
+  void PopFront() {
+    if (size_ > 0) {
+      start_ = (start_ + 1) % capacity_;
+      size_--;
+    }
+  }
+
+  /**
+   * @brief Get the item in chronological order
+   *
+   * @param index 0 is the oldest
+   * @return const T&
+   */
+  const T &At(const qint32 &index) const { return items_.at((start_ + index) % items_.size()); }
+
+  const T &Front() const { return At(0); }
+  const T &Back() const { return At(size_ - 1); }
+  qint32 Size() const { return size_; }
+  qint32 Capacity() const { return capacity_; }
+  bool IsEmpty() const { return size_ == 0; }
+
+  /**
+   * @brief The index of the first item whose timestamp is not earlier than the timestamp
+   *
+   * @param timestamp
+   * @return qint32 Size() if none
+   */
+  qint32 LowerBound(const qint64 &timestamp) const {
+    qint32 low = 0;
+    qint32 high = size_;
+    while (low < high) {
+      const qint32 middle = low + (high - low) / 2;
+      if (At(middle).timestamp < timestamp) {
+        low = middle + 1;
+      } else {
+        high = middle;
+      }
+    }
+    return low;
+  }
+
+ private:
+  QVector<T> items_;
+  qint32 start_;
+  qint32 size_;
+  qint32 capacity_;
+};
+
+/**
+ * @brief The raw sample of the metric
+ *
+ */
+struct ActTimeSeriesSample {
+  qint64 timestamp;
+  qreal value;
+};
+
+/**
+ * @brief The roll-up of the samples in a bucket (1 minute or 1 hour)
+ *
+ */
+struct ActTimeSeriesBucket {
+  qint64 timestamp;  ///< The start of the bucket
+  qreal min;
+  qreal max;
+  qreal sum;
+  qint64 count;
+
+  void Add(const qreal &value) {
+    min = (count == 0) ? value : qMin(min, value);
+    max = (count == 0) ? value : qMax(max, value);
+    sum += value;
+    count++;
+  }
+};
+
+/**
+ * @brief The series of the metric: the raw ring, the 1 minute & 1 hour roll-up rings and the open buckets
+ *
+ */
+struct ActTimeSeriesData {
+  ActTimeSeriesRing<ActTimeSeriesSample> raw;
+  ActTimeSeriesRing<ActTimeSeriesBucket> minutes;
+  ActTimeSeriesRing<ActTimeSeriesBucket> hours;
+  ActTimeSeriesBucket open_minute{0, 0, 0, 0, 0};
+  ActTimeSeriesBucket open_hour{0, 0, 0, 0, 0};
+  qint64 last_timestamp = 0;  ///< The time of the last sample
+  qint32 pending = 0;         ///< The samples appended after the last flush
+  qint32 logged = 0;          ///< The samples appended to the segment after its snapshot
+  bool compact = true;        ///< Rewrite the snapshot of the segment on the next flush
+};
+
+/**
+ * @brief The embedded time-series store of the monitored values
+ *
+ * Each metric (e.g. "device/1/port/2/utilization") keeps its raw samples and the 1 minute & 1 hour roll-ups in the
+ * fixed size rings, so the memory and the disk usage of a metric are bounded. The samples older than the retention
+ * are evicted on ingest, and a metric without any sample in the retention is removed on flush. The ingest only
+ * touches the memory; Flush() appends the samples since the last flush to the segment file of each changed metric
+ * (<folder>/<hex of the metric>.ts). The segment is a snapshot of the rings followed by the appended samples, it is
+ * only rewritten (atomically) once its samples reach the raw capacity, the rings are resized or an append failed, so
+ * a flush writes the new samples rather than the whole rings. Open() loads the snapshots and replays the samples.
+ *
+ * All the methods are thread-safe.
+ *
+ */
+class ActTimeSeriesStore {
+ public:
+  /**
+   * @brief Construct a new Act Time Series Store object
+   *
+   * @param keep_days the retention days
+   * @param raw_capacity the raw samples kept per metric
+   * @param minute_capacity the 1 minute roll-ups kept per metric
+   */
+  ActTimeSeriesStore(const quint32 &keep_days, const qint32 &raw_capacity = ACT_TIME_SERIES_RAW_CAPACITY,
+                     const qint32 &minute_capacity = ACT_TIME_SERIES_MINUTE_CAPACITY);
+
+  /**
+   * @brief Open the folder and load the segments in it
+   *
+   * @param folder
+   * @return ACT_STATUS
+   */
+  ACT_STATUS Open(const QString &folder);
+
+  /**
+   * @brief Append the new samples of the changed metrics to their segments in the folder
+   *
+   * The metrics without any sample in the retention (e.g. of the deleted devices) are removed.
+   *
+   * @return ACT_STATUS
+   */
+  ACT_STATUS Flush();
+
+  /**
+   * @brief Set the retention days (the rings are resized, the newest samples are kept)
+   *
+   * @param keep_days
+   */
+  void SetKeepDays(const quint32 &keep_days);
+
+  /**
+   * @brief Append the sample of the metric, the sample earlier than the last one of the metric is dropped
+   *
+   * @param metric
+   * @param timestamp the sample time (ms since epoch)
+   * @param value
+   * @return true if appended
+   */
+  bool Append(const QString &metric, const qint64 &timestamp, const qreal &value);
+
+  /**
+   * @brief Query the points of the metric in [from, to]
+   *
+   * The kAuto resolution picks the finest one which still covers the start of the range.
+   *
+   * @param metric
+   * @param from (ms since epoch)
+   * @param to (ms since epoch)
+   * @param resolution
+   * @param time_series
+   * @return ACT_STATUS not found if the metric does not exist
+   */
+  ACT_STATUS Query(const QString &metric, const qint64 &from, const qint64 &to,
+                   const ActTimeSeriesResolutionEnum &resolution, ActTimeSeries &time_series);
+
+  /**
+   * @brief Get the metrics in ascending order
+   *
+   * @return QList<QString>
+   */
+  QList<QString> GetMetrics();
+
+  /**
+   * @brief Get the number of the dropped out-of-order samples
+   *
+   * @return qint64
+   */
+  qint64 GetDroppedCount();
+
+ private:
+  QMutex mutex_;
+  QMutex flush_mutex_;  ///< Serialize the flushes, the segments are written out of mutex_
+  QString folder_;
+  quint32 keep_days_;
+  qint32 raw_capacity_;
+  qint32 minute_capacity_;
+  qint64 dropped_count_;
+  QHash<QString, ActTimeSeriesData> series_;
+  QSet<QString> removed_metrics_;  ///< The metrics whose segment should be deleted on flush
+
+  qint64 RetentionMs() const { return static_cast<qint64>(keep_days_) * 24 * ACT_TIME_SERIES_HOUR_MS; }
+  qint32 HourCapacity() const { return static_cast<qint32>(keep_days_) * 24; }
+  void InitSeries(ActTimeSeriesData &data) const;
+  void Ingest(ActTimeSeriesData &data, const qint64 &timestamp, const qreal &value) const;
+  void Evict(ActTimeSeriesData &data, const qint64 &now) const;
+  QString SegmentPath(const QString &metric) const;
+  bool WriteSegment(const QString &metric, const ActTimeSeriesData &data) const;
+  bool AppendSegment(const QString &metric, const QVector<ActTimeSeriesSample> &samples) const;
+  bool ReadSegment(const QString &path, QString &metric, ActTimeSeriesData &data) const;
+};
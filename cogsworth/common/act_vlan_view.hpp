@@ -55,11 +55,7 @@ class ActVlanViewDevice : public QSerializer {
    * @param obj
    * @return uint
    */
-  friend uint qHash(const ActVlanViewDevice &obj) {
-    // no effect on the program's behavior
-    static_cast<void>(obj);
-    return 0;
-  }
+  friend uint qHash(const ActVlanViewDevice &obj) { return qHash(obj.device_id_, 0); }
 
   /**
    * @brief The equal operator
@@ -122,11 +118,7 @@ class ActVlanView : public QSerializer {
    * @param obj
    * @return uint
    */
-  friend uint qHash(const ActVlanView &obj) {
-    // no effect on the program's behavior
-    static_cast<void>(obj);
-    return 0;
-  }
+  friend uint qHash(const ActVlanView &obj) { return qHash(obj.vlan_id_, 0); }
 
   /**
    * @brief The equal operator
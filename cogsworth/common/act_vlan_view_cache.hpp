@@ -0,0 +1,199 @@
+/* Copyright (C) MOXA Inc. All rights reserved.
+This software is distributed under the terms of the MOXA SOFTWARE NOTICE.
+See the file MOXA-SOFTWARE-NOTICE for details.
+*/
+
+#pragma once
+
+#include <QMap>
+#include <QSet>
+#include <QString>
+
+#include "act_vlan_view.hpp"
+#include "deploy_entry/act_deploy_table.hpp"
+
+/**
+ * @brief The materialized VLAN views of a project
+ *
+ * The views are maintained per device: Update() compares each device's VLAN table with the one of the last update and
+ * only re-materializes the devices whose table changed, was added or was removed. The VLAN view table is rebuilt from
+ * the per-VLAN views only after a change, so the repeated requests are served from the cache. With a revision, the
+ * tables aren't even compared until the owner bumps the revision of the project's VLAN tables.
+ *
+ */
+class ActVlanViewCache {
+ public:
+  ActVlanViewCache() : revision_(-1), table_dirty_(false) {}
+
+  /**
+   * @brief Apply the VLAN tables of the project to the views if their revision changed since the last update
+   *
+   * @param vlan_tables the VLAN tables <device id, table>
+   * @param revision the revision of the VLAN tables
+   * @return qint32 the number of the changed devices
+   */
+  qint32 Update(const QMap<qint64, ActVlanTable> &vlan_tables, const qint64 &revision) {
+    if (revision == revision_) {
+      return 0;
+    }
+
+    revision_ = revision;
+    return Update(vlan_tables);
+  }
+
+  /**
+   * @brief Apply the VLAN tables of the project to the views
+   *
+   * @param vlan_tables the VLAN tables <device id, table>
+   * @return qint32 the number of the changed devices
+   */
+  qint32 Update(const QMap<qint64, ActVlanTable> &vlan_tables) {
+    qint32 changed = 0;
+
+    // Removed devices
+    for (const auto &device_id : fingerprints_.keys()) {
+      if (!vlan_tables.contains(device_id)) {
+        RemoveDevice(device_id);
+        changed++;
+      }
+    }
+
+    // Added & updated devices
+    for (auto vlan_table : vlan_tables) {
+      const QString fingerprint = vlan_table.ToString();
+      auto fingerprint_it = fingerprints_.constFind(vlan_table.GetDeviceId());
+      if ((fingerprint_it != fingerprints_.constEnd()) && (fingerprint_it.value() == fingerprint)) {
+        continue;
+      }
+
+      RemoveDevice(vlan_table.GetDeviceId());
+      AddDevice(vlan_table);
+      fingerprints_.insert(vlan_table.GetDeviceId(), fingerprint);
+      changed++;
+    }
+
+    return changed;
+  }
+
+  /**
+   * @brief Remove the device from the views
+   *
+   * @param device_id
+   */
+  void RemoveDevice(const qint64 &device_id) {
+    fingerprints_.remove(device_id);
+
+    auto vlan_ids_it = device_vlan_ids_.find(device_id);
+    if (vlan_ids_it == device_vlan_ids_.end()) {
+      return;
+    }
+
+    for (const auto &vlan_id : vlan_ids_it.value()) {
+      auto view_it = views_.find(vlan_id);
+      if (view_it == views_.end()) {
+        continue;
+      }
+      view_it->GetDevices().remove(ActVlanViewDevice(device_id));
+      if (view_it->GetDevices().isEmpty()) {
+        views_.erase(view_it);
+      }
+    }
+    device_vlan_ids_.erase(vlan_ids_it);
+    table_dirty_ = true;
+  }
+
+  /**
+   * @brief Get the VLAN view table (rebuilt only after a change)
+   *
+   * @return const ActVlanViewTable&
+   */
+  const ActVlanViewTable &GetVlanViewTable() {
+    if (table_dirty_) {
+      QSet<ActVlanView> vlan_view_set;
+      vlan_view_set.reserve(views_.size());
+      for (const auto &vlan_view : views_) {
+        vlan_view_set.insert(vlan_view);
+      }
+      vlan_view_table_.SetVlanViews(vlan_view_set);
+      table_dirty_ = false;
+    }
+    return vlan_view_table_;
+  }
+
+  /**
+   * @brief Get the VLAN view of the VLAN
+   *
+   * @param vlan_id
+   * @param vlan_view
+   * @return true if found
+   */
+  bool GetVlanView(const qint32 &vlan_id, ActVlanView &vlan_view) const {
+    auto view_it = views_.constFind(vlan_id);
+    if (view_it == views_.constEnd()) {
+      return false;
+    }
+    vlan_view = view_it.value();
+    return true;
+  }
+
+  /**
+   * @brief Get the VLAN ids in ascending order
+   *
+   * @return QList<qint32>
+   */
+  QList<qint32> GetVlanIds() const { return views_.keys(); }
+
+ private:
+  QMap<qint64, QString> fingerprints_;          ///< The serialized VLAN table of the last update <device id, table>
+  QMap<qint64, QSet<qint32>> device_vlan_ids_;  ///< The VLANs of the device <device id, VLAN ids>
+  QMap<qint32, ActVlanView> views_;             ///< The materialized views <VLAN id, view>
+  ActVlanViewTable vlan_view_table_;
+  qint64 revision_;  ///< The revision of the last applied VLAN tables
+  bool table_dirty_;
+
+  /**
+   * @brief Add the device's ports to the views by its VLAN table
+   *
+   * The egress & untagged ports are the members, their VLAN port type entries (Hybrid/NonTSN by default) are the
+   * ports of the view device.
+   *
+   * @param vlan_table
+   */
+  void AddDevice(const ActVlanTable &vlan_table) {
+    const qint64 device_id = vlan_table.GetDeviceId();
+    const auto &port_type_entries = vlan_table.GetVlanPortTypeEntries();
+    auto port_type_entry = [&port_type_entries](const qint64 &port_id) {
+      auto entry_it = port_type_entries.constFind(ActVlanPortTypeEntry(port_id));
+      if (entry_it != port_type_entries.constEnd()) {
+        return *entry_it;
+      }
+      return ActVlanPortTypeEntry(port_id, ActVlanPortTypeEnum::kHybrid, ActVlanPriorityEnum::kNonTSN);
+    };
+
+    // The ports of the device in each VLAN
+    QMap<qint32, QSet<ActVlanPortTypeEntry>> vlan_ports;
+    for (const auto &vlan_static_entry : vlan_table.GetVlanStaticEntries()) {
+      auto &ports = vlan_ports[vlan_static_entry.GetVlanId()];
+      for (const auto &egress_port : vlan_static_entry.GetEgressPorts()) {
+        ports.insert(port_type_entry(egress_port));
+      }
+      for (const auto &untag_port : vlan_static_entry.GetUntaggedPorts()) {
+        ports.insert(port_type_entry(untag_port));
+      }
+    }
+    if (vlan_ports.isEmpty()) {
+      return;
+    }
+
+    auto &vlan_ids = device_vlan_ids_[device_id];
+    for (auto it = vlan_ports.constBegin(); it != vlan_ports.constEnd(); it++) {
+      auto view_it = views_.find(it.key());
+      if (view_it == views_.end()) {
+        view_it = views_.insert(it.key(), ActVlanView(it.key()));
+      }
+      view_it->GetDevices().insert(ActVlanViewDevice(device_id, it.value()));
+      vlan_ids.insert(it.key());
+    }
+    table_dirty_ = true;
+  }
+};
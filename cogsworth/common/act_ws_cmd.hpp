@@ -10,6 +10,7 @@ See the file MOXA-SOFTWARE-NOTICE for details.
 #include "act_deploy_parameter.hpp"
 #include "act_device_config_type.hpp"
 #include "act_device_ip_config.hpp"
+#include "act_firmware_rollout.hpp"
 #include "act_json.hpp"
 #include "act_scan_ip_range.hpp"
 
@@ -76,6 +77,8 @@ enum class ActWSCommandEnum {
   kStopImportDeviceConfig = 0x0904,
   kPatchUpdate = 0x1001,
   kFeaturesAvailableStatus = 0x1002,
+  kPatchUpdateBatch = 0x1003,
+  kPatchUpdateResync = 0x1004,
   kGetProjectDataVersion = 0x8001
 };
 
@@ -139,6 +142,8 @@ static const QMap<QString, ActWSCommandEnum> kActWSCommandEnumMap = {
     {"StopImportDeviceConfig", ActWSCommandEnum::kStopImportDeviceConfig},
     {"PatchUpdate", ActWSCommandEnum::kPatchUpdate},
     {"FeaturesAvailableStatus", ActWSCommandEnum::kFeaturesAvailableStatus},
+    {"PatchUpdateBatch", ActWSCommandEnum::kPatchUpdateBatch},
+    {"PatchUpdateResync", ActWSCommandEnum::kPatchUpdateResync},
     {"GetProjectDataVersion", ActWSCommandEnum::kGetProjectDataVersion}};
 
 /**
@@ -205,6 +210,9 @@ class ActWSCommand : public QSerializer {
       case 0x1001:
         this->opcode_enum_ = ActWSCommandEnum::kPatchUpdate;
         break;
+      case 0x1004:
+        this->opcode_enum_ = ActWSCommandEnum::kPatchUpdateResync;
+        break;
       case 0x0001:
         this->opcode_enum_ = ActWSCommandEnum::kStartCompute;
         break;
@@ -584,7 +592,15 @@ class ActConfigDeviceIdListFirmwareWSCommand : public ActConfigDeviceIdListWSCom
   Q_GADGET
   QS_SERIALIZABLE
 
-  ACT_JSON_FIELD(QString, firmware_name, FirmwareName);  ///< FirmwareName item
+  ACT_JSON_FIELD(QString, firmware_name, FirmwareName);     ///< FirmwareName item
+  ACT_JSON_FIELD(quint16, wave_width, WaveWidth);            ///< The devices upgraded at once
+  ACT_JSON_FIELD(quint32, bandwidth_limit, BandwidthLimit);  ///< The aggregate upload bandwidth(KB/s), 0 for unlimited
+
+ public:
+  ActConfigDeviceIdListFirmwareWSCommand() {
+    this->wave_width_ = ACT_FIRMWARE_ROLLOUT_WAVE_WIDTH;
+    this->bandwidth_limit_ = 0;
+  }
 };
 
 /**
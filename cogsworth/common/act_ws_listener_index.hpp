@@ -0,0 +1,84 @@
+/* Copyright (C) MOXA Inc. All rights reserved.
+This software is distributed under the terms of the MOXA SOFTWARE NOTICE.
+See the file MOXA-SOFTWARE-NOTICE for details.
+*/
+
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <memory>
+
+/**
+ * @brief The Websocket listener index
+ *
+ * Keeps the listeners by listener id and by subscribed project id, so a broadcast only visits the listeners of
+ * the target project. The system listeners are stored under project id -1.
+ *
+ * @tparam T listener type
+ */
+template <class T>
+class ActWSListenerIndex {
+ public:
+  /**
+   * @brief Insert the listener
+   *
+   * @param id listener id
+   * @param project_id subscribed project id (-1 for system)
+   * @param listener
+   */
+  void Insert(const qint64 &id, const qint64 &project_id, const std::shared_ptr<T> &listener) {
+    this->Remove(id);
+    listeners_.insert(id, listener);
+    listener_project_.insert(id, project_id);
+    project_listeners_[project_id].append(listener);
+  }
+
+  /**
+   * @brief Remove the listener
+   *
+   * @param id listener id
+   * @return true if the listener existed
+   */
+  bool Remove(const qint64 &id) {
+    auto listener_it = listeners_.find(id);
+    if (listener_it == listeners_.end()) {
+      return false;
+    }
+
+    const qint64 project_id = listener_project_.take(id);
+    auto bucket_it = project_listeners_.find(project_id);
+    if (bucket_it != project_listeners_.end()) {
+      bucket_it->removeOne(listener_it.value());
+      if (bucket_it->isEmpty()) {
+        project_listeners_.erase(bucket_it);
+      }
+    }
+
+    listeners_.erase(listener_it);
+    return true;
+  }
+
+  bool Contains(const qint64 &id) const { return listeners_.contains(id); }
+
+  std::shared_ptr<T> Value(const qint64 &id) const { return listeners_.value(id); }
+
+  qint64 Size() const { return listeners_.size(); }
+
+  /**
+   * @brief Get the listeners subscribed to the project
+   *
+   * @param project_id project id (-1 for system)
+   * @return const QList<std::shared_ptr<T>>&
+   */
+  const QList<std::shared_ptr<T>> &ProjectListeners(const qint64 &project_id) const {
+    static const QList<std::shared_ptr<T>> empty_list;
+    auto bucket_it = project_listeners_.constFind(project_id);
+    return (bucket_it == project_listeners_.cend()) ? empty_list : bucket_it.value();
+  }
+
+ private:
+  QHash<qint64, std::shared_ptr<T>> listeners_;                ///< <ListenerID, Listener>
+  QHash<qint64, qint64> listener_project_;                     ///< <ListenerID, ProjectID>
+  QHash<qint64, QList<std::shared_ptr<T>>> project_listeners_;  ///< <ProjectID, Listeners>
+};
@@ -0,0 +1,117 @@
+/* Copyright (C) MOXA Inc. All rights reserved.
+This software is distributed under the terms of the MOXA SOFTWARE NOTICE.
+See the file MOXA-SOFTWARE-NOTICE for details.
+*/
+
+#pragma once
+
+#include <QtGlobal>
+#include <atomic>
+#include <memory>
+#include <utility>
+
+/**
+ * @brief The bounded lock-free ring buffer with multiple producers and single consumer
+ *
+ * Each slot carries a sequence number, a producer claims a slot by CAS on the enqueue position and publishes it by
+ * storing the sequence, so the producers never take a lock (bounded queue by D. Vyukov).
+ *
+ * @tparam T the entry type
+ */
+template <class T>
+class ActLogRingBuffer {
+ public:
+  /**
+   * @brief Construct a new Act Log Ring Buffer object
+   *
+   * @param capacity the capacity, rounded up to the power of two
+   */
+  explicit ActLogRingBuffer(quint32 capacity) : enqueue_pos_(0), dequeue_pos_(0) {
+    quint32 size = 2;
+    while (size < capacity) {
+      size <<= 1;
+    }
+    mask_ = size - 1;
+    slots_.reset(new Slot[size]);
+    for (quint32 i = 0; i < size; i++) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  ActLogRingBuffer(const ActLogRingBuffer &) = delete;
+  ActLogRingBuffer &operator=(const ActLogRingBuffer &) = delete;
+
+  quint32 Capacity() const { return mask_ + 1; }
+
+  /**
+   * @brief Push the entry to the buffer (producer side, thread safe)
+   *
+   * @param entry
+   * @return true if success, false if the buffer is full
+   */
+  bool TryPush(T &&entry) {
+    quint64 pos = enqueue_pos_.load(std::memory_order_relaxed);
+    Slot *slot;
+    while (true) {
+      slot = &slots_[pos & mask_];
+      const quint64 sequence = slot->sequence.load(std::memory_order_acquire);
+      const qint64 diff = static_cast<qint64>(sequence) - static_cast<qint64>(pos);
+      if (diff == 0) {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+
+    slot->entry = std::move(entry);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Pop the entry from the buffer (consumer side, single consumer only)
+   *
+   * @param entry
+   * @return true if success, false if the buffer is empty
+   */
+  bool TryPop(T &entry) {
+    const quint64 pos = dequeue_pos_.load(std::memory_order_relaxed);
+    Slot *slot = &slots_[pos & mask_];
+    const quint64 sequence = slot->sequence.load(std::memory_order_acquire);
+    if (static_cast<qint64>(sequence) - static_cast<qint64>(pos + 1) < 0) {
+      return false;
+    }
+
+    entry = std::move(slot->entry);
+    slot->entry = T();
+    dequeue_pos_.store(pos + 1, std::memory_order_relaxed);
+    slot->sequence.store(pos + mask_ + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Whether the buffer is empty (approximate while producers are pushing)
+   *
+   * @return true
+   * @return false
+   */
+  bool IsEmpty() const {
+    return enqueue_pos_.load(std::memory_order_acquire) == dequeue_pos_.load(std::memory_order_acquire);
+  }
+
+ private:
+  struct Slot {
+    std::atomic<quint64> sequence;
+    T entry;
+  };
+
+  std::unique_ptr<Slot[]> slots_;
+  quint64 mask_;
+
+  alignas(64) std::atomic<quint64> enqueue_pos_;
+  alignas(64) std::atomic<quint64> dequeue_pos_;
+};
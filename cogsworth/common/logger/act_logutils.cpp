@@ -5,11 +5,17 @@
 #include <QFile>
 #include <QFileInfo>
 #include <QFileInfoList>
-#include <QMutex>
 #include <QStorageInfo>
 #include <QTime>
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
 
+#include "act_log_ring_buffer.hpp"
 #include "act_system.hpp"
 
 namespace LOGUTILS {
@@ -74,30 +80,86 @@ void DeleteOldLogsByDay() {
   }
 }
 
-void ActMessageHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg) {
-  // Check if day changed, rotate log file
-  QString today = QDate::currentDate().toString("yyyy_MM_dd");
-  if (today != currentLogDay) {
+/**
+ * @brief The log entry captured by the message handler, formatted by the log writer
+ *
+ */
+struct ActLogEntry {
+  QtMsgType type = QtDebugMsg;
+  qint64 msecs = 0;
+  QString msg;
+  const char *file = nullptr;
+  int line = 0;
+};
+
+static std::unique_ptr<ActLogRingBuffer<ActLogEntry>> log_buffer;
+static std::thread log_writer_thread;
+static std::atomic<bool> log_writer_running(false);
+static std::atomic<bool> log_writer_sleeping(false);
+static std::atomic<quint32> log_pushing_count(0);  ///< The producers between the running check and the push
+static std::atomic<quint64> log_pushed_count(0);
+static std::atomic<quint64> log_written_count(0);
+
+static std::mutex log_write_mutex;  ///< Guards the log file and the rotation state below
+static std::mutex log_wake_mutex;
+static std::condition_variable log_wake_cv;
+static std::mutex log_flush_mutex;
+static std::condition_variable log_flush_cv;
+
+// The cached rotation state, only accessed under the log_write_mutex
+static QFile log_file;
+static qint64 log_file_size = 0;
+static QDate log_file_day;
+static qint64 log_file_checked_msecs = 0;
+
+static void OpenLogFile() {
+  log_file.close();
+  log_file.setFileName(logFileName);
+  log_file.open(QIODevice::WriteOnly | QIODevice::Append);
+  log_file_size = log_file.size();
+  log_file_day = QDate::currentDate();
+  log_file_checked_msecs = QDateTime::currentMSecsSinceEpoch();
+}
+
+/**
+ * @brief Rotate the log file by day, or reopen it if it was removed
+ *
+ * The existence of the log file is only checked every ACT_LOG_FILE_CHECK_INTERVAL.
+ */
+static void CheckLogFileRotation() {
+  const qint64 now_msecs = QDateTime::currentMSecsSinceEpoch();
+  if (!log_file.isOpen() || (QDate::currentDate() != log_file_day)) {
     // Rotate by day, and delete old logs by keep days
     InitLogFileName();
     DeleteOldLogsByDay();
+    OpenLogFile();
+  } else if (now_msecs - log_file_checked_msecs >= ACT_LOG_FILE_CHECK_INTERVAL) {
+    log_file_checked_msecs = now_msecs;
+    if (!QFile::exists(logFileName)) {
+      InitLogFileName();
+      DeleteOldLogsByDay();
+      OpenLogFile();
+    }
   }
+}
 
-  // Check if log file exists, if not, create it and do rotate
-  QFile outFileCheck(logFileName);
-  if (!outFileCheck.exists()) {
-    InitLogFileName();
-    DeleteOldLogsByDay();
-  } else if (outFileCheck.size() >= ACT_LOG_SIZE) {
-    // Check file size and if needed create new log!
-    InitLogFileName();
-  }
+static QString FormatLogTime(const qint64 &msecs) {
+  // The date part only changes once per second
+  static qint64 cached_second = -1;
+  static QString cached_date;
 
-  static QMutex mutex;
-  QMutexLocker lock(&mutex);
+  const qint64 second = msecs / 1000;
+  if (second != cached_second) {
+    QLocale locale(QLocale("en_US"));
+    cached_date = locale.toString(QDateTime::fromMSecsSinceEpoch(second * 1000), "yyyy-MM-dd hh:mm:ss");
+    cached_second = second;
+  }
+  return QString("%1.%2").arg(cached_date).arg(msecs % 1000, 3, 10, QChar('0'));
+}
 
+static QString FormatLogEntry(const ActLogEntry &entry) {
   QString text;
-  switch (type) {
+  switch (entry.type) {
     case QtFatalMsg:
       text = QString("FATAL");  // Changed from [Fatal]
       break;
@@ -114,44 +176,177 @@ void ActMessageHandler(QtMsgType type, const QMessageLogContext &context, const
       text = QString("DBUG");  // Changed from [Debug]
       break;
   }
-  QLocale locale(QLocale("en_US"));
-  QDateTime date = QDateTime::currentDateTime();
-  QString current_date = locale.toString(date, "yyyy-MM-dd hh:mm:ss.zzz");  // Changed format
 
   // New log format
-  QString message = QString("[%1] %2 ").arg(text).arg(current_date);
+  QString message = QString("[%1] %2 ").arg(text).arg(FormatLogTime(entry.msecs));
 
   // message body - append directly
-  message.append(QString("%1 ").arg(msg));
-
-  // New context_info formatting
-  QString filePathStr = QString(context.file);
-  QFileInfo fileInfo(filePathStr);
-  QString fileName = fileInfo.fileName();
-  QString parentDirName = fileInfo.dir().dirName();
-  QString lineNumberString;
-
-  lineNumberString = QString::number(context.line);
-
-  // if (fileName.endsWith(".cpp", Qt::CaseInsensitive) || fileName.endsWith(".hpp", Qt::CaseInsensitive) ||
-  //     fileName.endsWith(".h", Qt::CaseInsensitive)) {
-  //   // No change needed for line number justification based on new format
-  //   lineNumberString = QString::number(context.line);
-  // } else {
-  //   lineNumberString = QString::number(context.line);
-  // }
+  message.append(QString("%1 ").arg(entry.msg));
 
   // Construct the code field (debug builds only)
 #ifdef _DEBUG
+  QFileInfo fileInfo(QString(entry.file));
+  QString fileName = fileInfo.fileName();
+  QString parentDirName = fileInfo.dir().dirName();
+  QString lineNumberString = QString::number(entry.line);
   QString formatted_context_info = QString("code=./%1/%2:%3").arg(parentDirName).arg(fileName).arg(lineNumberString);
   message.append(formatted_context_info);
 #endif
 
-  std::cout << message.toStdString().c_str() << "\\n";
-  QFile outFile(logFileName);
-  outFile.open(QIODevice::WriteOnly | QIODevice::Append);
-  QTextStream ts(&outFile);
-  ts << message << Qt::endl;
+  return message;
+}
+
+/**
+ * @brief Write the log entries to the console and the log file (caller should hold the log_write_mutex)
+ *
+ * @param entries
+ */
+static void WriteLogEntries(const QList<ActLogEntry> &entries) {
+  CheckLogFileRotation();
+
+  QByteArray buffer;
+  for (const auto &entry : entries) {
+    const QByteArray line = FormatLogEntry(entry).toUtf8().append('\n');
+    std::cout << line.constData();
+
+    // Check file size and if needed create new log!
+    if (log_file_size >= ACT_LOG_SIZE) {
+      log_file.write(buffer);
+      buffer.clear();
+      InitLogFileName();
+      OpenLogFile();
+    }
+    buffer.append(line);
+    log_file_size += line.size();
+  }
+
+  log_file.write(buffer);
+  log_file.flush();
+  std::cout.flush();
+}
+
+/**
+ * @brief Write all buffered log entries (log writer thread, or after the writer is stopped)
+ *
+ * @return quint64 the number of the written entries
+ */
+static quint64 DrainLogBuffer() {
+  QList<ActLogEntry> entries;
+  ActLogEntry entry;
+  while (log_buffer->TryPop(entry)) {
+    entries.append(std::move(entry));
+  }
+  if (entries.isEmpty()) {
+    return 0;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(log_write_mutex);
+    WriteLogEntries(entries);
+  }
+
+  log_written_count.fetch_add(entries.size());
+  {
+    std::lock_guard<std::mutex> lock(log_flush_mutex);
+  }
+  log_flush_cv.notify_all();
+  return entries.size();
+}
+
+static void WakeLogWriter() {
+  {
+    std::lock_guard<std::mutex> lock(log_wake_mutex);
+  }
+  log_wake_cv.notify_one();
+}
+
+static void LogWriterLoop() {
+  while (true) {
+    if (DrainLogBuffer() > 0) {
+      continue;
+    }
+    if (!log_writer_running.load()) {
+      break;
+    }
+
+    std::unique_lock<std::mutex> lock(log_wake_mutex);
+    log_writer_sleeping.store(true);
+    log_wake_cv.wait_for(lock, std::chrono::milliseconds(ACT_LOG_WRITER_INTERVAL),
+                         [] { return !log_buffer->IsEmpty() || !log_writer_running.load(); });
+    log_writer_sleeping.store(false);
+  }
+}
+
+void FlushACTLogging() {
+  if (!log_writer_running.load() || (std::this_thread::get_id() == log_writer_thread.get_id())) {
+    return;
+  }
+
+  const quint64 target = log_pushed_count.load();
+  WakeLogWriter();
+
+  std::unique_lock<std::mutex> lock(log_flush_mutex);
+  log_flush_cv.wait_for(lock, std::chrono::milliseconds(ACT_LOG_FLUSH_TIMEOUT),
+                        [target] { return log_written_count.load() >= target; });
+}
+
+void ShutdownACTLogging() {
+  if (!log_writer_running.exchange(false)) {
+    return;
+  }
+
+  WakeLogWriter();
+  if (log_writer_thread.joinable()) {
+    log_writer_thread.join();
+  }
+
+  // Write the entries pushed while the writer was stopping, until the producers which saw the writer running are
+  // done (the later ones see it stopped and write directly)
+  do {
+    DrainLogBuffer();
+    std::this_thread::yield();
+  } while (log_pushing_count.load() > 0);
+  DrainLogBuffer();
+
+  std::lock_guard<std::mutex> lock(log_write_mutex);
+  log_file.close();
+}
+
+void ActMessageHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg) {
+  ActLogEntry entry;
+  entry.type = type;
+  entry.msecs = QDateTime::currentMSecsSinceEpoch();
+  entry.msg = msg;
+  entry.file = context.file;
+  entry.line = context.line;
+
+  // Announce the push before checking the writer, so the shutdown waits for it instead of missing the entry
+  log_pushing_count.fetch_add(1);
+  if (!log_writer_running.load()) {
+    log_pushing_count.fetch_sub(1);
+
+    // No log writer, write it directly
+    std::lock_guard<std::mutex> lock(log_write_mutex);
+    WriteLogEntries(QList<ActLogEntry>({entry}));
+    return;
+  }
+
+  while (!log_buffer->TryPush(std::move(entry))) {
+    // The buffer is full, let the writer (or the shutdown) catch up
+    WakeLogWriter();
+    std::this_thread::yield();
+  }
+  log_pushed_count.fetch_add(1);
+  log_pushing_count.fetch_sub(1);
+
+  if (log_writer_sleeping.load()) {
+    WakeLogWriter();
+  }
+
+  // The application would abort after the fatal message, make sure it is written
+  if (type == QtFatalMsg) {
+    FlushACTLogging();
+  }
 }
 
 bool InitACTLogging() {
@@ -162,13 +357,27 @@ bool InitACTLogging() {
 
   // Only initialize log file name and install message handler
   InitLogFileName();
-  QFile outFile(logFileName);
-  if (outFile.open(QIODevice::WriteOnly | QIODevice::Append)) {
-    qInstallMessageHandler(ActMessageHandler);
-    return true;
-  } else {
-    return false;
+  {
+    std::lock_guard<std::mutex> lock(log_write_mutex);
+    OpenLogFile();
+    if (!log_file.isOpen()) {
+      return false;
+    }
   }
+
+  // Start the log writer, the message handler only pushes the entries to the buffer
+  if (!log_writer_running.exchange(true)) {
+    if (!log_buffer) {
+      log_buffer.reset(new ActLogRingBuffer<ActLogEntry>(ACT_LOG_BUFFER_SIZE));
+    }
+    log_writer_thread = std::thread(LogWriterLoop);
+
+    static std::once_flag shutdown_registered;
+    std::call_once(shutdown_registered, [] { std::atexit(ShutdownACTLogging); });
+  }
+
+  qInstallMessageHandler(ActMessageHandler);
+  return true;
 }
 
 }  // namespace LOGUTILS
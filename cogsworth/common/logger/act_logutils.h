@@ -13,6 +13,16 @@ namespace LOGUTILS {
  */
 bool InitACTLogging();
 
+/**
+ * @brief Wait until the buffered logs are written to the log file
+ */
+void FlushACTLogging();
+
+/**
+ * @brief Write the buffered logs and stop the log writer, the later logs are written directly
+ */
+void ShutdownACTLogging();
+
 /**
  * @brief Set the log configuration
  * @param keep_days Number of days to keep logs
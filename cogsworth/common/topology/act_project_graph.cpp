@@ -0,0 +1,108 @@
+/* Copyright (C) MOXA Inc. All rights reserved.
+This software is distributed under the terms of the MOXA SOFTWARE NOTICE.
+See the file MOXA-SOFTWARE-NOTICE for details.
+*/
+
+#include "topology/act_project_graph.hpp"
+
+#include <QStack>
+
+ActProjectGraph::ActProjectGraph(const QSet<ActDevice> &device_set, const QSet<ActLink> &link_set)
+    : device_set_(device_set), link_set_(link_set) {
+  // Only the const access, the shared sets are never detached
+  const QSet<ActDevice> &devices = device_set_;
+  const QSet<ActLink> &links = link_set_;
+
+  device_ids_.reserve(devices.size());
+  devices_.reserve(devices.size());
+  for (const ActDevice &device : devices) {
+    device_ids_.append(device.GetId());
+    devices_.insert(device.GetId(), &device);
+  }
+
+  // The first link of the set wins, the same as the linear scan
+  interface_links_.reserve(links.size() * 2);
+  for (const ActLink &link : links) {
+    const auto source = qMakePair(link.GetSourceDeviceId(), link.GetSourceInterfaceId());
+    const auto destination = qMakePair(link.GetDestinationDeviceId(), link.GetDestinationInterfaceId());
+    if (!interface_links_.contains(source)) {
+      interface_links_.insert(source, &link);
+    }
+    if (!interface_links_.contains(destination)) {
+      interface_links_.insert(destination, &link);
+    }
+  }
+
+  adjacencies_.reserve(devices.size());
+  for (const ActDevice &device : devices) {
+    const qint64 device_id = device.GetId();
+    QList<ActGraphAdjacency> &adjacencies = adjacencies_[device_id];
+    for (const ActInterface &intf : device.GetInterfaces()) {
+      const qint64 interface_id = intf.GetInterfaceId();
+      const ActLink *link = GetLinkByInterfaceId(device_id, interface_id);
+      if (link == nullptr) {
+        continue;
+      }
+
+      const qint64 neighbor_id =
+          (link->GetSourceDeviceId() == device_id) ? link->GetDestinationDeviceId() : link->GetSourceDeviceId();
+      const qint64 neighbor_interface_id = (link->GetSourceInterfaceId() == interface_id)
+                                               ? link->GetDestinationInterfaceId()
+                                               : link->GetSourceInterfaceId();
+      adjacencies.append(ActGraphAdjacency{interface_id, neighbor_id, neighbor_interface_id, link});
+    }
+  }
+}
+
+const QList<ActGraphAdjacency> &ActProjectGraph::GetAdjacencies(const qint64 &device_id) const {
+  auto adjacencies_it = adjacencies_.constFind(device_id);
+  return (adjacencies_it == adjacencies_.constEnd()) ? empty_adjacencies_ : adjacencies_it.value();
+}
+
+bool ActProjectGraph::HasLoop() const {
+  if (device_ids_.isEmpty()) {
+    return false;
+  }
+
+  // DFS, a neighbor which is still on the stack closes a loop
+  QStack<qint64> dfs_stack;
+  QSet<qint64> on_stack;
+  QSet<qint64> visited;
+  qint32 next_root = 0;
+
+  dfs_stack.push(device_ids_.first());
+  on_stack.insert(device_ids_.first());
+  while (!dfs_stack.isEmpty()) {
+    const qint64 device_id = dfs_stack.pop();
+    on_stack.remove(device_id);
+
+    for (const ActGraphAdjacency &adjacency : GetAdjacencies(device_id)) {
+      const ActDevice *neighbor = GetDevice(adjacency.neighbor_id);
+      if ((neighbor != nullptr && neighbor->GetDeviceType() == ActDeviceTypeEnum::kEndStation) ||
+          visited.contains(adjacency.neighbor_id)) {
+        continue;
+      }
+
+      if (on_stack.contains(adjacency.neighbor_id)) {
+        return true;
+      }
+
+      dfs_stack.push(adjacency.neighbor_id);
+      on_stack.insert(adjacency.neighbor_id);
+    }
+    visited.insert(device_id);
+
+    // Continue from the next unvisited device (the disconnected part)
+    if (dfs_stack.isEmpty() && visited.count() != device_ids_.count()) {
+      while (next_root < device_ids_.size() && visited.contains(device_ids_.at(next_root))) {
+        next_root++;
+      }
+      if (next_root < device_ids_.size()) {
+        dfs_stack.push(device_ids_.at(next_root));
+        on_stack.insert(device_ids_.at(next_root));
+      }
+    }
+  }
+
+  return false;
+}
@@ -0,0 +1,94 @@
+/* Copyright (C) MOXA Inc. All rights reserved.
+This software is distributed under the terms of the MOXA SOFTWARE NOTICE.
+See the file MOXA-SOFTWARE-NOTICE for details.
+*/
+
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QPair>
+#include <QSet>
+
+#include "topology/act_device.hpp"
+#include "topology/act_link.hpp"
+
+/**
+ * @brief The adjacency of the device's interface (the link and the neighbor on the other end)
+ *
+ */
+struct ActGraphAdjacency {
+  qint64 interface_id;
+  qint64 neighbor_id;
+  qint64 neighbor_interface_id;
+  const ActLink *link;
+};
+
+/**
+ * @brief The adjacency index of the project topology (device -> interface -> link -> neighbor)
+ *
+ * Built once in O(devices + links) for the graph walks, so each lookup is O(1) instead of a scan of the link set.
+ * The graph holds implicitly shared copies of the sets and points into them, so no device or link is copied and the
+ * graph stays a valid snapshot after the project changes.
+ *
+ */
+class ActProjectGraph {
+ public:
+  /**
+   * @brief Construct a new Act Project Graph object
+   *
+   * @param device_set
+   * @param link_set
+   */
+  ActProjectGraph(const QSet<ActDevice> &device_set, const QSet<ActLink> &link_set);
+
+  /**
+   * @brief Get the device
+   *
+   * @param device_id
+   * @return const ActDevice* nullptr if not found
+   */
+  const ActDevice *GetDevice(const qint64 &device_id) const { return devices_.value(device_id, nullptr); }
+
+  /**
+   * @brief Get the link of the interface (the first link of the link set on it, as ActProject::GetLinkByInterfaceId)
+   *
+   * @param device_id
+   * @param interface_id
+   * @return const ActLink* nullptr if not found
+   */
+  const ActLink *GetLinkByInterfaceId(const qint64 &device_id, const qint64 &interface_id) const {
+    return interface_links_.value(qMakePair(device_id, interface_id), nullptr);
+  }
+
+  /**
+   * @brief Get the linked interfaces of the device (in the order of the device's interfaces)
+   *
+   * @param device_id
+   * @return const QList<ActGraphAdjacency>&
+   */
+  const QList<ActGraphAdjacency> &GetAdjacencies(const qint64 &device_id) const;
+
+  /**
+   * @brief Get the device ids (in the iteration order of the device set)
+   *
+   * @return const QList<qint64>&
+   */
+  const QList<qint64> &GetDeviceIds() const { return device_ids_; }
+
+  /**
+   * @brief Whether the topology has a loop (the end stations are not traversed)
+   *
+   * @return true if has loop
+   */
+  bool HasLoop() const;
+
+ private:
+  QSet<ActDevice> device_set_;
+  QSet<ActLink> link_set_;
+  QList<qint64> device_ids_;
+  QHash<qint64, const ActDevice *> devices_;
+  QHash<QPair<qint64, qint64>, const ActLink *> interface_links_;  ///< <(device id, interface id), link>
+  QHash<qint64, QList<ActGraphAdjacency>> adjacencies_;            ///< <device id, linked interfaces>
+  QList<ActGraphAdjacency> empty_adjacencies_;
+};
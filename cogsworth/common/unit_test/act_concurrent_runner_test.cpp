@@ -0,0 +1,101 @@
+#include "act_concurrent_runner.hpp"
+
+#include <QMutex>
+#include <QSet>
+#include <QThread>
+#include <atomic>
+
+#include "act_unit_test.hpp"
+
+class ActConcurrentRunnerTest : public ActQuickTest {
+ protected:
+  // The stand-in of the device export, sleep for the given time(ms) of each device
+  QMutex mutex;
+  std::atomic<qint32> running{0};
+  std::atomic<qint32> peak{0};
+  QList<qint64> order;
+  QMap<qint64, ACT_STATUS> results;
+
+  ActConcurrentRunner::ActionFunction StandIn(const QMap<qint64, qint64> &sleep_map, const QSet<qint64> &failed = {}) {
+    return [this, sleep_map, failed](const qint64 &id) -> ACT_STATUS {
+      const qint32 now = ++running;
+      qint32 expected = peak;
+      while (now > expected && !peak.compare_exchange_weak(expected, now)) {
+      }
+      QThread::msleep(sleep_map.value(id, 20));
+      running--;
+
+      if (failed.contains(id)) {
+        return std::make_shared<ActStatusSouthboundFailed>("Export failed");
+      }
+      return ACT_STATUS_SUCCESS;
+    };
+  }
+
+  ActConcurrentRunner::ResultFunction Collect() {
+    return [this](const qint64 &id, ACT_STATUS act_status) {
+      QMutexLocker lock(&mutex);
+      order.append(id);
+      results.insert(id, act_status);
+    };
+  }
+};
+
+TEST_F(ActConcurrentRunnerTest, TestBoundedWidth) {
+  ActConcurrentRunner runner(3, 0);
+  ACT_STATUS act_status = runner.Run({1, 2, 3, 4, 5, 6, 7, 8}, StandIn({}), Collect());
+
+  EXPECT_TRUE(IsActStatusSuccess(act_status));
+  EXPECT_EQ(8, results.size());
+  EXPECT_LE(peak, 3);
+  EXPECT_GE(peak, 2);
+}
+
+TEST_F(ActConcurrentRunnerTest, TestStreamResults) {
+  // The fast devices are reported before the slow one
+  ActConcurrentRunner runner(4, 0);
+  ACT_STATUS act_status = runner.Run({1, 2, 3}, StandIn({{1, 300}, {2, 10}, {3, 10}}), Collect());
+
+  EXPECT_TRUE(IsActStatusSuccess(act_status));
+  ASSERT_EQ(3, order.size());
+  EXPECT_EQ(1, order.last());
+}
+
+TEST_F(ActConcurrentRunnerTest, TestPartialFailure) {
+  ActConcurrentRunner runner(2, 0);
+  ACT_STATUS act_status = runner.Run({1, 2, 3, 4}, StandIn({}, {2}), Collect());
+
+  EXPECT_TRUE(IsActStatusSuccess(act_status));
+  ASSERT_EQ(4, results.size());
+  EXPECT_FALSE(IsActStatusSuccess(results[2]));
+  EXPECT_TRUE(IsActStatusSuccess(results[1]));
+  EXPECT_TRUE(IsActStatusSuccess(results[3]));
+  EXPECT_TRUE(IsActStatusSuccess(results[4]));
+}
+
+TEST_F(ActConcurrentRunnerTest, TestTimeout) {
+  // The hung device is reported failed and its slot is given to the others
+  ActConcurrentRunner runner(1, 100);
+  ACT_STATUS act_status = runner.Run({1, 2}, StandIn({{1, 400}, {2, 10}}), Collect());
+
+  EXPECT_TRUE(IsActStatusSuccess(act_status));
+  ASSERT_EQ(2, order.size());
+  EXPECT_EQ(QList<qint64>({1, 2}), order);
+  EXPECT_FALSE(IsActStatusSuccess(results[1]));
+  EXPECT_TRUE(IsActStatusSuccess(results[2]));
+}
+
+TEST_F(ActConcurrentRunnerTest, TestStop) {
+  bool stop_flag = false;
+  ActConcurrentRunner runner(1, 0);
+  ACT_STATUS act_status = runner.Run(
+      {1, 2, 3, 4}, StandIn({}),
+      [this, &stop_flag](const qint64 &id, ACT_STATUS result_status) {
+        results.insert(id, result_status);
+        stop_flag = true;
+      },
+      &stop_flag);
+
+  EXPECT_TRUE(IsActStatusStop(act_status));
+  EXPECT_EQ(1, results.size());
+}
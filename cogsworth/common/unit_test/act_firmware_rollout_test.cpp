@@ -0,0 +1,155 @@
+#include "act_firmware_rollout.hpp"
+
+#include <QDateTime>
+#include <QThread>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include "act_unit_test.hpp"
+
+class ActFirmwareRolloutTest : public ActQuickTest {
+ protected:
+  // The stand-in of the device upload, record the concurrency and the upgraded devices
+  QMutex mutex;
+  std::atomic<qint32> running{0};
+  std::atomic<qint32> peak{0};
+  QList<qint64> upgraded;
+  QMap<qint64, qint64> start_times;
+  QMap<qint64, ACT_STATUS> results;
+
+  ActFirmwareRollout::UpgradeFunction StandIn(const QSet<qint64> &failed = {}) {
+    return [this, failed](const qint64 &device_id) -> ACT_STATUS {
+      const qint32 now = ++running;
+      qint32 expected = peak;
+      while (now > expected && !peak.compare_exchange_weak(expected, now)) {
+      }
+      {
+        QMutexLocker lock(&mutex);
+        start_times.insert(device_id, QDateTime::currentMSecsSinceEpoch());
+      }
+      QThread::msleep(20);
+      running--;
+
+      QMutexLocker lock(&mutex);
+      upgraded.append(device_id);
+      if (failed.contains(device_id)) {
+        return std::make_shared<ActStatusSouthboundFailed>("Upload failed");
+      }
+      return ACT_STATUS_SUCCESS;
+    };
+  }
+
+  static ActFirmwareRollout::HealthFunction AllAlive() {
+    return [](const QList<qint64> &device_ids) { return QSet<qint64>(device_ids.begin(), device_ids.end()); };
+  }
+
+  ActFirmwareRollout::ResultFunction Collect() {
+    return [this](const qint64 &device_id, ACT_STATUS act_status) { results.insert(device_id, act_status); };
+  }
+};
+
+TEST_F(ActFirmwareRolloutTest, TestPlanWaves) {
+  // From far to near
+  QList<qint64> dev_id_list = {1, 2, 3, 4, 5, 6};
+  QMap<qint64, qint64> dev_distance_map = {{1, 3}, {2, 3}, {3, 3}, {4, 2}, {5, 2}, {6, 1}};
+
+  QList<QList<qint64>> expected = {{1, 2}, {3}, {4, 5}, {6}};
+  EXPECT_EQ(expected, ActFirmwareRollout::PlanWaves(dev_id_list, dev_distance_map, 2));
+
+  expected = {{1, 2, 3}, {4, 5}, {6}};
+  EXPECT_EQ(expected, ActFirmwareRollout::PlanWaves(dev_id_list, dev_distance_map, 8));
+
+  // Unknown topology
+  expected = {{1}, {2}, {3}, {4}, {5}, {6}};
+  EXPECT_EQ(expected, ActFirmwareRollout::PlanWaves(dev_id_list, {}, 8));
+}
+
+TEST_F(ActFirmwareRolloutTest, TestBandwidthPacer) {
+  ActBandwidthPacer pacer(1000);
+  EXPECT_EQ(0, pacer.Reserve(500, 0));
+  EXPECT_EQ(500, pacer.Reserve(500, 0));
+  EXPECT_EQ(900, pacer.Reserve(1000, 100));
+  EXPECT_EQ(0, pacer.Reserve(1000, 5000));
+
+  ActBandwidthPacer unlimited(0);
+  EXPECT_EQ(0, unlimited.Reserve(1000000, 0));
+}
+
+TEST_F(ActFirmwareRolloutTest, TestRunWaves) {
+  ActFirmwareRolloutSetting setting;
+  setting.SetWaveWidth(2);
+  ActFirmwareRollout rollout(setting);
+
+  QMap<qint64, qint64> dev_distance_map = {{1, 2}, {2, 2}, {3, 2}, {4, 2}, {5, 1}};
+  auto waves = ActFirmwareRollout::PlanWaves({1, 2, 3, 4, 5}, dev_distance_map, setting.GetWaveWidth());
+  ACT_STATUS act_status = rollout.Run(waves, 1024, StandIn({3}), AllAlive(), Collect());
+  EXPECT_TRUE(IsActStatusSuccess(act_status));
+
+  EXPECT_EQ(2, peak.load());
+  EXPECT_EQ(5, results.size());
+  for (qint64 device_id = 1; device_id <= 5; device_id++) {
+    EXPECT_EQ(device_id != 3, IsActStatusSuccess(results[device_id])) << device_id;
+  }
+
+  // The uplink is upgraded after its leaves
+  EXPECT_EQ(5, upgraded.last());
+}
+
+TEST_F(ActFirmwareRolloutTest, TestHealthGate) {
+  ActFirmwareRolloutSetting setting;
+  setting.SetWaveWidth(2);
+  ActFirmwareRollout rollout(setting);
+
+  QList<QList<qint64>> waves = {{1, 2}, {3, 4}, {5}};
+  QList<QList<qint64>> checked;
+  auto health = [&checked](const QList<qint64> &device_ids) {
+    checked.append(device_ids);
+    QSet<qint64> alive(device_ids.begin(), device_ids.end());
+    alive.remove(2);  // not back after the reboot
+    return alive;
+  };
+  ACT_STATUS act_status = rollout.Run(waves, 1024, StandIn(), health, Collect());
+  EXPECT_TRUE(IsActStatusSuccess(act_status));
+
+  // The rollout halts after the unhealthy wave
+  EXPECT_EQ(1, checked.size());
+  EXPECT_EQ(2, upgraded.size());
+  EXPECT_TRUE(IsActStatusSuccess(results[1]));
+  for (qint64 device_id = 2; device_id <= 5; device_id++) {
+    EXPECT_FALSE(IsActStatusSuccess(results[device_id])) << device_id;
+  }
+}
+
+TEST_F(ActFirmwareRolloutTest, TestBandwidthLimit) {
+  // 4 devices of 20 KB at 100 KB/s, the uploads start 200 ms apart
+  ActFirmwareRolloutSetting setting;
+  setting.SetWaveWidth(4);
+  setting.SetBandwidthLimit(100);
+  ActFirmwareRollout rollout(setting);
+
+  ACT_STATUS act_status = rollout.Run({{1, 2, 3, 4}}, 20 * 1024, StandIn(), AllAlive(), Collect());
+  EXPECT_TRUE(IsActStatusSuccess(act_status));
+
+  QList<qint64> times = start_times.values();
+  std::sort(times.begin(), times.end());
+  ASSERT_EQ(4, times.size());
+  EXPECT_GE(times.last() - times.first(), 550);
+}
+
+TEST_F(ActFirmwareRolloutTest, TestStop) {
+  ActFirmwareRolloutSetting setting;
+  setting.SetBandwidthLimit(1);
+  ActFirmwareRollout rollout(setting);
+
+  // The second upload waits for its bandwidth and is stopped
+  bool stop_flag = false;
+  std::thread stopper([&stop_flag]() {
+    QThread::msleep(200);
+    stop_flag = true;
+  });
+  ACT_STATUS act_status = rollout.Run({{1, 2}}, 10 * 1024, StandIn(), AllAlive(), Collect(), &stop_flag);
+  stopper.join();
+  EXPECT_EQ(ActStatusType::kStop, act_status->GetStatus());
+  EXPECT_EQ(1, upgraded.size());
+}
@@ -0,0 +1,208 @@
+#include "act_job_engine.hpp"
+
+#include <QThread>
+#include <atomic>
+
+#include "act_unit_test.hpp"
+
+class ActJobEngineTest : public ActQuickTest {
+ protected:
+  // Run until cancelled, record the peak of the running jobs
+  static ActJobFunction BlockingJob(std::atomic<qint32> &running, std::atomic<qint32> &peak) {
+    return [&running, &peak](ActJobContext &context) -> ACT_STATUS {
+      const qint32 now = ++running;
+      qint32 expected = peak;
+      while (now > expected && !peak.compare_exchange_weak(expected, now)) {
+      }
+      while (!context.cancel_token->IsCancelled()) {
+        QThread::msleep(1);
+      }
+      running--;
+      return ACT_STATUS_STOP;
+    };
+  }
+
+  static ActJobFunction ShortJob(std::atomic<qint32> &running, std::atomic<qint32> &peak) {
+    return [&running, &peak](ActJobContext &) -> ACT_STATUS {
+      const qint32 now = ++running;
+      qint32 expected = peak;
+      while (now > expected && !peak.compare_exchange_weak(expected, now)) {
+      }
+      QThread::msleep(20);
+      running--;
+      return ACT_STATUS_SUCCESS;
+    };
+  }
+
+  static ActJobStateEnum State(ActJobEngine &engine, const qint64 &job_id) {
+    ActJobInfo job_info;
+    engine.GetJob(job_id, job_info);
+    return job_info.GetState();
+  }
+};
+
+TEST_F(ActJobEngineTest, TestConcurrencyBound) {
+  ActJobEngine engine(3);
+  std::atomic<qint32> running(0);
+  std::atomic<qint32> peak(0);
+
+  QList<qint64> job_ids;
+  for (qint64 project_id = 1; project_id <= 12; project_id++) {
+    job_ids.append(engine.Submit(project_id, "Deploy", ShortJob(running, peak)));
+  }
+  for (const auto &job_id : job_ids) {
+    ASSERT_TRUE(engine.Wait(job_id, 5000));
+    EXPECT_EQ(ActJobStateEnum::kFinished, State(engine, job_id));
+  }
+
+  // The jobs of the different projects run concurrently, up to the workers
+  EXPECT_GT(peak.load(), 1);
+  EXPECT_LE(peak.load(), 3);
+}
+
+TEST_F(ActJobEngineTest, TestTypeLimit) {
+  ActJobEngine engine(4);
+  engine.SetTypeLimit("FirmwareUpgrade", 1);
+  std::atomic<qint32> upgrade_running(0);
+  std::atomic<qint32> upgrade_peak(0);
+  std::atomic<qint32> other_running(0);
+  std::atomic<qint32> other_peak(0);
+
+  const qint64 upgrade_1 = engine.Submit(1, "FirmwareUpgrade", BlockingJob(upgrade_running, upgrade_peak));
+  const qint64 upgrade_2 = engine.Submit(2, "FirmwareUpgrade", ShortJob(upgrade_running, upgrade_peak));
+  const qint64 reboot = engine.Submit(3, "Reboot", ShortJob(other_running, other_peak));
+
+  // The later job of the other type is not blocked by the waiting one
+  ASSERT_TRUE(engine.Wait(reboot, 5000));
+  EXPECT_EQ(ActJobStateEnum::kFinished, State(engine, reboot));
+  EXPECT_EQ(ActJobStateEnum::kQueued, State(engine, upgrade_2));
+
+  ACT_STATUS act_status = engine.Cancel(upgrade_1);
+  EXPECT_TRUE(IsActStatusSuccess(act_status));
+  ASSERT_TRUE(engine.Wait(upgrade_2, 5000));
+  EXPECT_EQ(ActJobStateEnum::kCancelled, State(engine, upgrade_1));
+  EXPECT_EQ(ActJobStateEnum::kFinished, State(engine, upgrade_2));
+  EXPECT_EQ(1, upgrade_peak.load());
+}
+
+TEST_F(ActJobEngineTest, TestCancel) {
+  ActJobEngine engine(1);
+  std::atomic<qint32> running(0);
+  std::atomic<qint32> peak(0);
+
+  std::atomic<bool> stopped(false);
+  auto cancel_token = std::make_shared<ActJobCancelToken>();
+  cancel_token->OnCancel([&stopped]() { stopped = true; });  // e.g. the stop flag of the southbound
+
+  const qint64 running_job = engine.Submit(1, "Scan", BlockingJob(running, peak), cancel_token);
+  auto queued_token = std::make_shared<ActJobCancelToken>();
+  std::atomic<bool> skipped(false);
+  const qint64 queued_job =
+      engine.Submit(2, "Scan", ShortJob(running, peak), queued_token, [&skipped]() { skipped = true; });
+  while (State(engine, running_job) != ActJobStateEnum::kRunning) {
+    QThread::msleep(1);
+  }
+
+  // The queued job never runs, its owner is told by the skipped callback
+  ACT_STATUS act_status = engine.Cancel(queued_job);
+  EXPECT_TRUE(IsActStatusSuccess(act_status));
+  EXPECT_EQ(ActJobStateEnum::kCancelled, State(engine, queued_job));
+  EXPECT_TRUE(skipped.load());
+  EXPECT_TRUE(queued_token->IsCancelled());
+
+  act_status = engine.Cancel(running_job);
+  EXPECT_TRUE(IsActStatusSuccess(act_status));
+  ASSERT_TRUE(engine.Wait(running_job, 5000));
+  EXPECT_EQ(ActJobStateEnum::kCancelled, State(engine, running_job));
+  EXPECT_TRUE(stopped.load());
+  EXPECT_EQ(1, peak.load());
+
+  act_status = engine.Cancel(100);
+  EXPECT_TRUE(IsActStatusNotFound(act_status));
+}
+
+TEST_F(ActJobEngineTest, TestSkipCancelledToken) {
+  ActJobEngine engine(1);
+  auto parent = std::make_shared<ActJobCancelToken>();
+  parent->Cancel();
+
+  // The token is cancelled before a worker takes the job
+  std::atomic<bool> called(false);
+  std::atomic<bool> skipped(false);
+  const qint64 job_id = engine.Submit(
+      1, "Scan",
+      [&called](ActJobContext &) -> ACT_STATUS {
+        called = true;
+        return ACT_STATUS_SUCCESS;
+      },
+      parent->CreateChild(), [&skipped]() { skipped = true; });
+  ASSERT_TRUE(engine.Wait(job_id, 5000));
+  EXPECT_EQ(ActJobStateEnum::kCancelled, State(engine, job_id));
+  EXPECT_FALSE(called.load());
+  EXPECT_TRUE(skipped.load());
+}
+
+TEST_F(ActJobEngineTest, TestChildToken) {
+  auto parent = std::make_shared<ActJobCancelToken>();
+  auto child = parent->CreateChild();
+  EXPECT_FALSE(child->IsCancelled());
+  parent->Cancel();
+  EXPECT_TRUE(child->IsCancelled());
+
+  // Registered after the cancellation
+  bool called = false;
+  child->OnCancel([&called]() { called = true; });
+  EXPECT_TRUE(called);
+}
+
+TEST_F(ActJobEngineTest, TestWeightedProgress) {
+  // 2 devices of 10 MB firmware and 1 device of 80 MB firmware, plus 10 units of the reboot
+  ActJobProgress progress;
+  progress.SetTotal(10);
+  auto small_1 = progress.AddChild(10);
+  auto small_2 = progress.AddChild(10);
+  auto large = progress.AddChild(80);
+  small_1->SetTotal(10);
+  small_2->SetTotal(10);
+  large->SetTotal(80);
+  EXPECT_EQ(0, progress.GetPercent());
+
+  small_1->Advance(10);
+  small_2->Advance(10);
+  EXPECT_EQ(18, progress.GetPercent());  // 20 / 110
+
+  large->Advance(40);
+  EXPECT_EQ(54, progress.GetPercent());  // 60 / 110
+
+  large->SetPercent(100);
+  progress.Advance(10);
+  EXPECT_EQ(100, progress.GetPercent());
+}
+
+TEST_F(ActJobEngineTest, TestJobList) {
+  ActJobEngine engine(2);
+  const qint64 success_job = engine.Submit(1, "Compare", [](ActJobContext &context) -> ACT_STATUS {
+    context.progress->SetTotal(2);
+    context.progress->Advance(2);
+    return ACT_STATUS_SUCCESS;
+  });
+  const qint64 failed_job = engine.Submit(2, "Compare", [](ActJobContext &) -> ACT_STATUS {
+    return std::make_shared<ActStatusInternalError>("Compare");
+  });
+  ASSERT_TRUE(engine.Wait(success_job, 5000));
+  ASSERT_TRUE(engine.Wait(failed_job, 5000));
+
+  ActJobList job_list;
+  engine.GetJobs(-1, job_list);
+  EXPECT_EQ(2, job_list.GetJobs().size());
+
+  engine.GetJobs(2, job_list);
+  ASSERT_EQ(1, job_list.GetJobs().size());
+  EXPECT_EQ(ActJobStateEnum::kFailed, job_list.GetJobs().first().GetState());
+  EXPECT_FALSE(job_list.GetJobs().first().GetErrorMessage().isEmpty());
+
+  ActJobInfo job_info;
+  ACT_STATUS act_status = engine.GetJob(success_job, job_info);
+  EXPECT_TRUE(IsActStatusSuccess(act_status));
+  EXPECT_EQ(100, job_info.GetProgress());
+}
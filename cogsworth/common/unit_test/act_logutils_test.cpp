@@ -0,0 +1,145 @@
+#include "logger/act_logutils.h"
+
+#include <QElapsedTimer>
+#include <QTemporaryDir>
+#include <QtTest/QtTest>
+#include <thread>
+
+#include "act_unit_test.hpp"
+#include "logger/act_log_ring_buffer.hpp"
+
+class ActLogRingBufferTest : public ActQuickTest {};
+
+TEST_F(ActLogRingBufferTest, TestPushPop) {
+  ActLogRingBuffer<QString> buffer(3);
+  EXPECT_EQ(4, buffer.Capacity());
+  EXPECT_TRUE(buffer.IsEmpty());
+
+  for (qint32 i = 0; i < 4; i++) {
+    EXPECT_TRUE(buffer.TryPush(QString::number(i)));
+  }
+  QString full("full");
+  EXPECT_FALSE(buffer.TryPush(std::move(full)));
+  EXPECT_EQ("full", full);
+
+  QString entry;
+  for (qint32 i = 0; i < 4; i++) {
+    ASSERT_TRUE(buffer.TryPop(entry));
+    EXPECT_EQ(QString::number(i), entry);
+  }
+  EXPECT_FALSE(buffer.TryPop(entry));
+  EXPECT_TRUE(buffer.IsEmpty());
+}
+
+TEST_F(ActLogRingBufferTest, TestMultipleProducers) {
+  const qint32 kProducerCount = 4;
+  const qint32 kEntryCount = 20000;
+  ActLogRingBuffer<qint64> buffer(256);
+
+  QList<std::thread *> producers;
+  for (qint32 p = 0; p < kProducerCount; p++) {
+    producers.append(new std::thread([&buffer, p] {
+      for (qint64 i = 0; i < kEntryCount; i++) {
+        qint64 value = p * kEntryCount + i;
+        while (!buffer.TryPush(std::move(value))) {
+          std::this_thread::yield();
+        }
+      }
+    }));
+  }
+
+  qint64 count = 0;
+  qint64 sum = 0;
+  qint64 value = 0;
+  while (count < kProducerCount * kEntryCount) {
+    if (buffer.TryPop(value)) {
+      sum += value;
+      count++;
+    }
+  }
+  for (auto producer : producers) {
+    producer->join();
+    delete producer;
+  }
+
+  const qint64 total = kProducerCount * kEntryCount;
+  EXPECT_EQ(total * (total - 1) / 2, sum);
+  EXPECT_TRUE(buffer.IsEmpty());
+}
+
+TEST_F(ActLogRingBufferTest, BenchmarkLogCallsPerSecond) {
+  QTemporaryDir log_dir;
+  ASSERT_TRUE(log_dir.isValid());
+  qputenv("CHAMBERLAIN_COGSWORTH_LOG_FOLDER", log_dir.path().toUtf8());
+  ASSERT_TRUE(LOGUTILS::InitACTLogging());
+
+  const qint64 kLogCount = 20000;
+  QList<qint64> results;
+  for (qint32 thread_count : {1, 4, 8}) {
+    QList<std::thread *> threads;
+    QElapsedTimer timer;
+    timer.start();
+    for (qint32 t = 0; t < thread_count; t++) {
+      threads.append(new std::thread([t] {
+        for (qint64 i = 0; i < kLogCount; i++) {
+          qDebug() << "Benchmark thread" << t << "log" << i;
+        }
+      }));
+    }
+    for (auto thread : threads) {
+      thread->join();
+      delete thread;
+    }
+    const qint64 elapsed_ms = qMax<qint64>(timer.elapsed(), 1);
+    results.append(thread_count * kLogCount * 1000 / elapsed_ms);
+  }
+  LOGUTILS::ShutdownACTLogging();
+  qInstallMessageHandler(nullptr);
+  qunsetenv("CHAMBERLAIN_COGSWORTH_LOG_FOLDER");
+
+  // The buffered logs should all be written
+  QDir dir(log_dir.path());
+  EXPECT_FALSE(dir.entryList(QDir::Files).isEmpty());
+
+  qint32 index = 0;
+  for (qint32 thread_count : {1, 4, 8}) {
+    qDebug() << QString("Threads: %1, log calls/s: %2").arg(thread_count).arg(results.at(index++)).toStdString().c_str();
+  }
+}
+
+TEST_F(ActLogRingBufferTest, TestShutdownWhileLogging) {
+  QTemporaryDir log_dir;
+  ASSERT_TRUE(log_dir.isValid());
+  qputenv("CHAMBERLAIN_COGSWORTH_LOG_FOLDER", log_dir.path().toUtf8());
+  ASSERT_TRUE(LOGUTILS::InitACTLogging());
+
+  const qint32 kThreadCount = 4;
+  const qint64 kLogCount = 5000;
+  QList<std::thread *> threads;
+  for (qint32 t = 0; t < kThreadCount; t++) {
+    threads.append(new std::thread([t] {
+      for (qint64 i = 0; i < kLogCount; i++) {
+        qDebug() << "Shutdown thread" << t << "log" << i;
+      }
+    }));
+  }
+
+  // Stop the writer while the threads are logging, no entry should be lost
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  LOGUTILS::ShutdownACTLogging();
+  for (auto thread : threads) {
+    thread->join();
+    delete thread;
+  }
+  qInstallMessageHandler(nullptr);
+  qunsetenv("CHAMBERLAIN_COGSWORTH_LOG_FOLDER");
+
+  qint64 written = 0;
+  QDir dir(log_dir.path());
+  for (const QString &file_name : dir.entryList(QDir::Files)) {
+    QFile file(dir.filePath(file_name));
+    ASSERT_TRUE(file.open(QIODevice::ReadOnly));
+    written += file.readAll().count("Shutdown thread");
+  }
+  EXPECT_EQ(kThreadCount * kLogCount, written);
+}
@@ -0,0 +1,139 @@
+#include "act_monitor_poll_scheduler.hpp"
+
+#include "act_unit_test.hpp"
+
+class ActMonitorPollSchedulerTest : public ActQuickTest {
+ protected:
+  const qint64 base = 1700000000000;  // ms since epoch, on the tick boundary
+  const qint64 interval = 10 * ACT_MONITOR_POLL_TICK;
+
+  static QSet<QString> Keys(const qint32 &count) {
+    QSet<QString> keys;
+    for (qint32 i = 0; i < count; i++) {
+      keys.insert(QString("192.168.%1.%2").arg(i / 250).arg(i % 250 + 1));
+    }
+    return keys;
+  }
+
+  // Run the ticks in [from, to] and count the polls of each target
+  static QMap<QString, qint32> Run(ActMonitorPollScheduler &scheduler, const qint64 &from, const qint64 &to,
+                                   QList<qint32> *per_tick = nullptr) {
+    QMap<QString, qint32> polls;
+    for (qint64 now = from; now <= to; now += ACT_MONITOR_POLL_TICK) {
+      const QList<QString> keys = scheduler.Due(now);
+      for (const QString &key : keys) {
+        polls[key]++;
+      }
+      if (per_tick != nullptr) {
+        per_tick->append(keys.size());
+      }
+    }
+    return polls;
+  }
+};
+
+TEST_F(ActMonitorPollSchedulerTest, TestSpreadWithoutBurst) {
+  ActMonitorPollScheduler scheduler(interval, 1000, 1);
+  scheduler.Sync(Keys(500), base);
+
+  QList<qint32> per_tick;
+  const QMap<QString, qint32> polls = Run(scheduler, base, base + 10 * interval, &per_tick);
+
+  // Every target is polled once per interval (+-jitter), and the polls are spread over the ticks
+  EXPECT_EQ(500, polls.size());
+  for (const qint32 &count : polls) {
+    EXPECT_GE(count, 8);
+    EXPECT_LE(count, 12);
+  }
+  EXPECT_LT(*std::max_element(per_tick.begin(), per_tick.end()), 500 / 10 * 2);
+}
+
+TEST_F(ActMonitorPollSchedulerTest, TestBudgetCarriesOver) {
+  ActMonitorPollScheduler scheduler(interval, 20, 1);
+  scheduler.Sync(Keys(100), base);
+
+  QList<qint32> per_tick;
+  const QMap<QString, qint32> polls = Run(scheduler, base, base + 2 * interval, &per_tick);
+  EXPECT_LE(*std::max_element(per_tick.begin(), per_tick.end()), 20);
+  EXPECT_EQ(100, polls.size());  // nothing is lost
+}
+
+TEST_F(ActMonitorPollSchedulerTest, TestBackOffAndSpeedUp) {
+  ActMonitorPollScheduler scheduler(interval, ACT_MONITOR_POLL_BUDGET, 1);
+  const QString key = "192.168.127.1";
+  scheduler.Sync({key}, base);
+
+  // The unreachable target backs off up to the maximum
+  qint64 now = base;
+  qint64 last_gap = 0;
+  for (qint32 failures = 1; failures <= 6; failures++) {
+    scheduler.Report(key, false, now);
+    const qint64 gap = scheduler.GetDue(key) - now;
+    const qint64 expected = interval * std::min<qint64>(qint64(1) << (failures - 1), ACT_MONITOR_POLL_MAX_BACKOFF);
+    EXPECT_NEAR(expected, gap, expected * ACT_MONITOR_POLL_JITTER_PERCENT / 100);
+    last_gap = gap;
+    now += gap;
+  }
+  EXPECT_GE(last_gap, interval * ACT_MONITOR_POLL_MAX_BACKOFF * (100 - ACT_MONITOR_POLL_JITTER_PERCENT) / 100);
+
+  // Back to reachable: the fast polls, then the normal interval
+  const qint64 fast = interval / ACT_MONITOR_POLL_FAST_DIVISOR;
+  for (qint32 i = 0; i < ACT_MONITOR_POLL_FAST_COUNT; i++) {
+    scheduler.Report(key, true, now);
+    EXPECT_NEAR(fast, scheduler.GetDue(key) - now, fast * ACT_MONITOR_POLL_JITTER_PERCENT / 100);
+  }
+  scheduler.Report(key, true, now);
+  EXPECT_NEAR(interval, scheduler.GetDue(key) - now, interval * ACT_MONITOR_POLL_JITTER_PERCENT / 100);
+
+  // The event polls the target at the next tick
+  scheduler.Expedite(key, now);
+  EXPECT_EQ(QList<QString>({key}), scheduler.Due(now + ACT_MONITOR_POLL_TICK));
+}
+
+TEST_F(ActMonitorPollSchedulerTest, TestDeferAndSync) {
+  ActMonitorPollScheduler scheduler(interval, ACT_MONITOR_POLL_BUDGET, 1);
+  scheduler.Sync({"10.0.0.1", "10.0.0.2"}, base);
+  const qint64 due = std::max(scheduler.GetDue("10.0.0.1"), scheduler.GetDue("10.0.0.2"));
+
+  QList<QString> keys = scheduler.Due(due);
+  std::sort(keys.begin(), keys.end());
+  EXPECT_EQ(QList<QString>({"10.0.0.1", "10.0.0.2"}), keys);
+
+  // The busy target is retried at the next tick
+  scheduler.Defer("10.0.0.1", due);
+  EXPECT_EQ(QList<QString>({"10.0.0.1"}), scheduler.Due(due + ACT_MONITOR_POLL_TICK));
+
+  // The removed target is never returned again
+  scheduler.Sync({"10.0.0.1"}, due);
+  EXPECT_EQ(1, scheduler.Size());
+  EXPECT_EQ(-1, scheduler.GetDue("10.0.0.2"));
+  EXPECT_FALSE(Run(scheduler, due, due + 3 * interval).contains("10.0.0.2"));
+}
+
+TEST_F(ActMonitorPollSchedulerTest, TestLongGapAndLongInterval) {
+  // The interval longer than the wheel is kept in the slot for the later rounds
+  const qint64 long_interval = 3 * ACT_MONITOR_POLL_WHEEL_SLOTS * ACT_MONITOR_POLL_TICK;
+  ActMonitorPollScheduler scheduler(long_interval, ACT_MONITOR_POLL_BUDGET, 1);
+  const QSet<QString> keys = Keys(50);
+  scheduler.Sync(keys, base);
+  QMap<QString, qint64> dues;
+  for (const QString &key : keys) {
+    dues.insert(key, scheduler.GetDue(key));
+  }
+
+  // Each target is returned at the tick of its due
+  for (qint64 now = base + ACT_MONITOR_POLL_TICK; now <= base + long_interval; now += ACT_MONITOR_POLL_TICK) {
+    for (const QString &key : scheduler.Due(now)) {
+      if (dues.contains(key)) {
+        const qint64 due_tick = dues.take(key) / ACT_MONITOR_POLL_TICK * ACT_MONITOR_POLL_TICK;
+        EXPECT_EQ(std::max(due_tick, base + ACT_MONITOR_POLL_TICK), now);
+      }
+    }
+  }
+  EXPECT_TRUE(dues.isEmpty());
+
+  // The ticks skipped by a stalled loop are caught up at once
+  ActMonitorPollScheduler stalled(interval, 1000, 1);
+  stalled.Sync(Keys(50), base);
+  EXPECT_EQ(50, stalled.Due(base + 2 * ACT_MONITOR_POLL_WHEEL_SLOTS * ACT_MONITOR_POLL_TICK).size());
+}
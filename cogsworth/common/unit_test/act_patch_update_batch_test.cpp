@@ -0,0 +1,73 @@
+#include "act_patch_update_batch.hpp"
+
+#include <QtTest/QtTest>
+
+#include "act_unit_test.hpp"
+
+class ActPatchUpdateBatchTest : public ActQuickTest {
+ protected:
+  ActPatchUpdateBatch batch;
+  QMap<QString, QJsonObject> snapshots;
+
+  static QJsonObject Device(qint64 id, const QString &name, const QString &ip) {
+    QJsonObject obj;
+    obj.insert("Id", id);
+    obj.insert("DeviceName", name);
+    obj.insert("Ip", ip);
+    return obj;
+  }
+};
+
+TEST_F(ActPatchUpdateBatchTest, TestCoalesce) {
+  batch.Insert("Projects/1/Devices/1", ActPatchUpdateActionEnum::kCreate, Device(1, "A", "10.0.0.1"));
+  batch.Insert("Projects/1/Devices/1", ActPatchUpdateActionEnum::kUpdate, Device(1, "B", "10.0.0.1"));
+  batch.Insert("Projects/1/Devices/2", ActPatchUpdateActionEnum::kCreate, Device(2, "C", "10.0.0.2"));
+  batch.Insert("Projects/1/Devices/2", ActPatchUpdateActionEnum::kDelete, QJsonObject());
+  EXPECT_EQ(1, batch.Size());
+
+  QJsonObject message;
+  EXPECT_TRUE(batch.Flush(1, 1, snapshots, message));
+  EXPECT_TRUE(batch.IsEmpty());
+  EXPECT_EQ(static_cast<qint64>(ActWSCommandEnum::kPatchUpdateBatch), message.value("OpCode").toInt());
+  EXPECT_EQ(1, message.value("Sequence").toInt());
+
+  const QJsonArray create_array = message.value("Create").toArray();
+  ASSERT_EQ(1, create_array.size());
+  EXPECT_EQ("B", create_array.at(0).toObject().value("Data").toObject().value("DeviceName").toString());
+  EXPECT_TRUE(message.value("Update").toArray().isEmpty());
+  EXPECT_TRUE(message.value("Delete").toArray().isEmpty());
+}
+
+TEST_F(ActPatchUpdateBatchTest, TestUpdateOnlyChangedFields) {
+  QJsonObject message;
+  batch.Insert("Projects/1/Devices/1", ActPatchUpdateActionEnum::kCreate, Device(1, "A", "10.0.0.1"));
+  batch.Flush(1, 1, snapshots, message);
+
+  batch.Insert("Projects/1/Devices/1", ActPatchUpdateActionEnum::kUpdate, Device(1, "A", "10.0.0.9"));
+  EXPECT_TRUE(batch.Flush(1, 2, snapshots, message));
+
+  const QJsonArray update_array = message.value("Update").toArray();
+  ASSERT_EQ(1, update_array.size());
+  const QJsonObject data = update_array.at(0).toObject().value("Data").toObject();
+  EXPECT_EQ(2, data.size());
+  EXPECT_EQ(1, data.value("Id").toInt());
+  EXPECT_EQ("10.0.0.9", data.value("Ip").toString());
+
+  // Nothing changed, nothing to send
+  batch.Insert("Projects/1/Devices/1", ActPatchUpdateActionEnum::kUpdate, Device(1, "A", "10.0.0.9"));
+  EXPECT_FALSE(batch.Flush(1, 3, snapshots, message));
+}
+
+TEST_F(ActPatchUpdateBatchTest, TestDelete) {
+  QJsonObject message;
+  batch.Insert("Projects/1/Links/5", ActPatchUpdateActionEnum::kCreate, Device(5, "L", ""));
+  batch.Flush(1, 1, snapshots, message);
+
+  batch.Insert("Projects/1/Links/5", ActPatchUpdateActionEnum::kUpdate, Device(5, "M", ""));
+  batch.Insert("Projects/1/Links/5", ActPatchUpdateActionEnum::kDelete, QJsonObject());
+  EXPECT_TRUE(batch.Flush(1, 2, snapshots, message));
+
+  EXPECT_EQ(1, message.value("Delete").toArray().size());
+  EXPECT_TRUE(message.value("Update").toArray().isEmpty());
+  EXPECT_FALSE(snapshots.contains("Projects/1/Links/5"));
+}
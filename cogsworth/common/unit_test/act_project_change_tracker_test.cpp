@@ -0,0 +1,239 @@
+#include "act_project_change_tracker.hpp"
+
+#include <random>
+
+#include "act_unit_test.hpp"
+
+class ActProjectChangeTrackerTest : public ActQuickTest {
+ protected:
+  using ActNodeSnapshot = QMap<QString, QString>;  ///< <node key, content> of the listener (e.g. the OPC UA nodes)
+
+  ActProject project;
+  std::mt19937 random{20240701};
+
+  qint32 Random(const qint32 &max) { return std::uniform_int_distribution<qint32>(0, max)(random); }
+
+  static QString Endpoint(const ActProject &project, const qint64 &device_id, const qint64 &interface_id) {
+    ActDevice device;
+    project.GetDeviceById(device, device_id);
+    QString interface_name;
+    for (const auto &intf : device.GetInterfaces()) {
+      if (intf.GetInterfaceId() == interface_id) {
+        interface_name = intf.GetInterfaceName();
+      }
+    }
+    return QString("%1_%2_%3")
+        .arg(device.GetIpv4().GetIpAddress())
+        .arg(interface_name)
+        .arg(device.GetDeviceProperty().GetModelName());
+  }
+
+  static QString DeviceNode(const ActProject &project, const qint64 &device_id) {
+    ActDevice device;
+    project.GetDeviceById(device, device_id);
+    ActVlanTable vlan_table = project.GetDeviceConfig().GetVlanTables().value(device_id);
+    return device.ToString() + vlan_table.ToString();
+  }
+
+  static QString LinkNode(const ActProject &project, ActLink link) {
+    return link.ToString() + Endpoint(project, link.GetSourceDeviceId(), link.GetSourceInterfaceId()) +
+           Endpoint(project, link.GetDestinationDeviceId(), link.GetDestinationInterfaceId());
+  }
+
+  static QString SettingNode(const ActProject &project) {
+    ActProjectSetting project_setting = project.GetProjectSetting();
+    return project.GetProjectName() + project_setting.ToString();
+  }
+
+  static QString TrafficDesignNode(const ActProject &project) {
+    ActTrafficDesign traffic_design = project.GetTrafficDesign();
+    return traffic_design.ToString();
+  }
+
+  // The full rebuild
+  static ActNodeSnapshot Snapshot(const ActProject &project) {
+    ActNodeSnapshot snapshot;
+    snapshot.insert("setting", SettingNode(project));
+    snapshot.insert("traffic_design", TrafficDesignNode(project));
+    for (const auto &device : project.GetDevices()) {
+      snapshot.insert(QString("device/%1").arg(device.GetId()), DeviceNode(project, device.GetId()));
+    }
+    for (const auto &link : project.GetLinks()) {
+      snapshot.insert(QString("link/%1").arg(link.GetId()), LinkNode(project, link));
+    }
+    return snapshot;
+  }
+
+  // The incremental update, only the changed nodes are rendered
+  static void Apply(const ActProject &project, const ActProjectChangeSet &changes, ActNodeSnapshot &snapshot) {
+    if (changes.created) {
+      snapshot = Snapshot(project);
+      return;
+    }
+    if (changes.setting_changed) {
+      snapshot.insert("setting", SettingNode(project));
+    }
+    if (changes.traffic_design_changed) {
+      snapshot.insert("traffic_design", TrafficDesignNode(project));
+    }
+    for (const auto &device_id : changes.removed_devices) {
+      snapshot.remove(QString("device/%1").arg(device_id));
+    }
+    for (const auto &device_id : changes.added_devices + changes.updated_devices) {
+      snapshot.insert(QString("device/%1").arg(device_id), DeviceNode(project, device_id));
+    }
+    for (const auto &link_id : changes.removed_links) {
+      snapshot.remove(QString("link/%1").arg(link_id));
+    }
+    for (const auto &link_id : changes.added_links + changes.updated_links) {
+      ActLink link;
+      project.GetLinkById(link, link_id);
+      snapshot.insert(QString("link/%1").arg(link_id), LinkNode(project, link));
+    }
+  }
+
+  void ReplaceDevice(const ActDevice &device) {
+    project.GetDevices().remove(device);
+    project.GetDevices().insert(device);
+  }
+
+  void RandomEdit() {
+    const qint64 device_id = Random(7) + 1;
+    ActDevice device;
+    ACT_STATUS act_status = project.GetDeviceById(device, device_id);
+    const bool device_found = IsActStatusSuccess(act_status);
+
+    switch (Random(9)) {
+      case 0: {  // add the device
+        if (device_found) {
+          break;
+        }
+        device = ActDevice(device_id);
+        device.GetIpv4().SetIpAddress(QString("192.168.127.%1").arg(device_id));
+        for (qint64 interface_id = 1; interface_id <= 4; interface_id++) {
+          ActInterface intf;
+          intf.SetInterfaceId(interface_id);
+          intf.SetInterfaceName(QString("%1").arg(interface_id));
+          device.GetInterfaces().append(intf);
+        }
+        project.GetDevices().insert(device);
+      } break;
+      case 1: {  // remove the device and its links
+        project.GetDevices().remove(ActDevice(device_id));
+        for (const auto &link : project.GetLinks().values()) {
+          if (link.GetSourceDeviceId() == device_id || link.GetDestinationDeviceId() == device_id) {
+            project.GetLinks().remove(link);
+          }
+        }
+        project.GetDeviceConfig().GetVlanTables().remove(device_id);
+      } break;
+      case 2: {  // the device property without the endpoint
+        if (device_found) {
+          device.SetDeviceAlias(QString("alias-%1").arg(Random(3)));
+          ReplaceDevice(device);
+        }
+      } break;
+      case 3: {  // the endpoint of the device
+        if (device_found) {
+          if (Random(1) == 0) {
+            device.GetIpv4().SetIpAddress(QString("10.0.%1.%2").arg(device_id).arg(Random(20) + 1));  // unique
+          } else {
+            device.GetInterfaces()[Random(3)].SetInterfaceName(QString("port-%1").arg(Random(3)));
+          }
+          ReplaceDevice(device);
+        }
+      } break;
+      case 4: {  // add the link
+        const qint64 destination_id = Random(7) + 1;
+        if (device_found && project.GetDevices().contains(ActDevice(destination_id))) {
+          project.GetLinks().insert(ActLink(Random(9) + 1, device_id, destination_id, Random(3) + 1, Random(3) + 1));
+        }
+      } break;
+      case 5: {  // remove the link
+        project.GetLinks().remove(ActLink(Random(9) + 1));
+      } break;
+      case 6: {  // update the link
+        ActLink link;
+        act_status = project.GetLinkById(link, Random(9) + 1);
+        if (IsActStatusSuccess(act_status)) {
+          link.SetSpeed(Random(1) ? 100 : 1000);
+          project.GetLinks().remove(link);
+          project.GetLinks().insert(link);
+        }
+      } break;
+      case 7: {  // the device config table of the device
+        if (device_found) {
+          ActVlanStaticEntry entry;
+          entry.SetVlanId(Random(5) + 1);
+          auto &vlan_table = project.GetDeviceConfig().GetVlanTables()[device_id];
+          vlan_table.SetDeviceId(device_id);
+          vlan_table.GetVlanStaticEntries().insert(entry);
+        }
+      } break;
+      case 8: {  // the project setting
+        project.SetProjectName(QString("project-%1").arg(Random(3)));
+      } break;
+      default: {  // the traffic design
+        ActTrafficTypeConfiguration traffic_type_configuration;
+        traffic_type_configuration.SetTrafficClass(Random(7));
+        project.GetTrafficDesign().GetTrafficTypeConfigurationSetting().append(traffic_type_configuration);
+      } break;
+    }
+  }
+};
+
+TEST_F(ActProjectChangeTrackerTest, TestIncrementalMatchesRebuild) {
+  ActProjectChangeTracker tracker;
+  project.SetId(1);
+  ActNodeSnapshot snapshot;
+
+  for (qint32 step = 0; step < 500; step++) {
+    const qint32 edits = Random(2) + 1;
+    for (qint32 i = 0; i < edits; i++) {
+      RandomEdit();
+    }
+    const ActProjectChangeSet changes = tracker.Update(project);
+    EXPECT_EQ(step == 0, changes.created);
+    Apply(project, changes, snapshot);
+    ASSERT_EQ(Snapshot(project), snapshot) << "step " << step;
+  }
+
+  // Nothing changed
+  EXPECT_TRUE(tracker.Update(project).IsEmpty());
+}
+
+TEST_F(ActProjectChangeTrackerTest, TestEndpointChange) {
+  ActProjectChangeTracker tracker;
+  project.SetId(1);
+  for (qint64 device_id = 1; device_id <= 2; device_id++) {
+    ActDevice device(device_id);
+    device.GetIpv4().SetIpAddress(QString("192.168.127.%1").arg(device_id));
+    project.GetDevices().insert(device);
+  }
+  project.GetLinks().insert(ActLink(1, 1, 2, 1, 1));
+  tracker.Update(project);
+
+  // The alias is not referred to by the link
+  ActDevice device;
+  project.GetDeviceById(device, 1);
+  device.SetDeviceAlias("Switch");
+  ReplaceDevice(device);
+  ActProjectChangeSet changes = tracker.Update(project);
+  EXPECT_EQ(QSet<qint64>({1}), changes.updated_devices);
+  EXPECT_TRUE(changes.updated_links.isEmpty());
+  EXPECT_FALSE(changes.traffic_design_changed);
+
+  // The IP is referred to by the link and the traffic design
+  device.GetIpv4().SetIpAddress("192.168.127.100");
+  ReplaceDevice(device);
+  changes = tracker.Update(project);
+  EXPECT_EQ(QSet<qint64>({1}), changes.updated_devices);
+  EXPECT_EQ(QSet<qint64>({1}), changes.updated_links);
+  EXPECT_TRUE(changes.traffic_design_changed);
+
+  // The forgotten project is rebuilt
+  tracker.Remove(1);
+  changes = tracker.Update(project);
+  EXPECT_TRUE(changes.created);
+  EXPECT_EQ(QSet<qint64>({1, 2}), changes.added_devices);
+}
@@ -0,0 +1,151 @@
+#include "topology/act_project_graph.hpp"
+
+#include <QStack>
+#include <random>
+
+#include "act_project.hpp"
+#include "act_unit_test.hpp"
+
+class ActProjectGraphTest : public ActQuickTest {
+ protected:
+  std::mt19937 random{20240617};
+
+  qint32 Random(const qint32 &max) { return std::uniform_int_distribution<qint32>(0, max)(random); }
+
+  // Random topology, a few links may point to the missing device or share an interface
+  ActProject RandomProject(const qint32 &device_count, const qint32 &link_count) {
+    ActProject project;
+    for (qint64 id = 1; id <= device_count; id++) {
+      ActDevice device(id);
+      device.SetDeviceType(Random(4) == 0 ? ActDeviceTypeEnum::kEndStation : ActDeviceTypeEnum::kTSNSwitch);
+      for (qint64 interface_id = 1; interface_id <= 4; interface_id++) {
+        ActInterface intf;
+        intf.SetInterfaceId(interface_id);
+        device.GetInterfaces().append(intf);
+      }
+      project.GetDevices().insert(device);
+    }
+    for (qint64 id = 1; id <= link_count; id++) {
+      project.GetLinks().insert(ActLink(id, Random(device_count) + 1, Random(device_count) + 1, Random(3) + 1,
+                                        Random(3) + 1));
+    }
+    return project;
+  }
+
+  // The DFS of ActCore::CheckTopologyLoop before the graph index
+  static bool HasLoopByScan(const ActProject &project) {
+    if (project.GetDevices().isEmpty()) {
+      return false;
+    }
+    QStack<qint64> dfs_stack;
+    dfs_stack.push(project.GetDevices().begin()->GetId());
+
+    QSet<qint64> visited;
+    while (!dfs_stack.isEmpty()) {
+      qint64 device_id = dfs_stack.pop();
+      ActDevice device;
+      project.GetDeviceById(device, device_id);
+
+      for (ActInterface intf : device.GetInterfaces()) {
+        ActLink link;
+        ACT_STATUS act_status = project.GetLinkByInterfaceId(link, device_id, intf.GetInterfaceId());
+        if (IsActStatusNotFound(act_status)) {
+          continue;
+        }
+
+        ActDevice neighbor;
+        qint64 neighbor_id =
+            (link.GetSourceDeviceId() == device_id) ? link.GetDestinationDeviceId() : link.GetSourceDeviceId();
+        project.GetDeviceById(neighbor, neighbor_id);
+        if (neighbor.GetDeviceType() == ActDeviceTypeEnum::kEndStation || visited.contains(neighbor_id)) {
+          continue;
+        }
+        if (dfs_stack.contains(neighbor_id)) {
+          return true;
+        }
+        dfs_stack.push(neighbor_id);
+      }
+      visited.insert(device_id);
+
+      if (dfs_stack.isEmpty() && visited.count() != project.GetDevices().count()) {
+        for (const ActDevice &device : project.GetDevices()) {
+          if (!visited.contains(device.GetId())) {
+            dfs_stack.push(device.GetId());
+            break;
+          }
+        }
+      }
+    }
+    return false;
+  }
+};
+
+TEST_F(ActProjectGraphTest, TestLinkByInterfaceMatchesScan) {
+  for (qint32 round = 0; round < 20; round++) {
+    const ActProject project = RandomProject(12, Random(20));
+    const ActProjectGraph graph = project.GetGraph();
+
+    for (qint64 device_id = 0; device_id <= 13; device_id++) {
+      for (qint64 interface_id = 0; interface_id <= 5; interface_id++) {
+        ActLink link;
+        ACT_STATUS act_status = project.GetLinkByInterfaceId(link, device_id, interface_id);
+        const ActLink *graph_link = graph.GetLinkByInterfaceId(device_id, interface_id);
+        if (IsActStatusNotFound(act_status)) {
+          EXPECT_EQ(nullptr, graph_link);
+        } else {
+          ASSERT_NE(nullptr, graph_link);
+          EXPECT_EQ(link.GetId(), graph_link->GetId());
+        }
+      }
+    }
+  }
+}
+
+TEST_F(ActProjectGraphTest, TestAdjacencies) {
+  const ActProject project = RandomProject(8, 10);
+  const ActProjectGraph graph = project.GetGraph();
+
+  for (const ActDevice &device : project.GetDevices()) {
+    QList<qint64> expected_interfaces;
+    for (const ActInterface &intf : device.GetInterfaces()) {
+      ActLink link;
+      ACT_STATUS act_status = project.GetLinkByInterfaceId(link, device.GetId(), intf.GetInterfaceId());
+      if (IsActStatusSuccess(act_status)) {
+        expected_interfaces.append(intf.GetInterfaceId());
+      }
+    }
+
+    QList<qint64> interfaces;
+    for (const ActGraphAdjacency &adjacency : graph.GetAdjacencies(device.GetId())) {
+      interfaces.append(adjacency.interface_id);
+      const qint64 expected_neighbor = (adjacency.link->GetSourceDeviceId() == device.GetId())
+                                           ? adjacency.link->GetDestinationDeviceId()
+                                           : adjacency.link->GetSourceDeviceId();
+      EXPECT_EQ(expected_neighbor, adjacency.neighbor_id);
+    }
+    EXPECT_EQ(expected_interfaces, interfaces);
+  }
+  EXPECT_TRUE(graph.GetAdjacencies(100).isEmpty());
+  EXPECT_EQ(nullptr, graph.GetDevice(100));
+}
+
+TEST_F(ActProjectGraphTest, TestLoopMatchesScan) {
+  for (qint32 round = 0; round < 200; round++) {
+    const ActProject project = RandomProject(Random(10) + 1, Random(12));
+    EXPECT_EQ(HasLoopByScan(project), project.GetGraph().HasLoop()) << "round " << round;
+  }
+}
+
+TEST_F(ActProjectGraphTest, TestSnapshot) {
+  ActProject project = RandomProject(4, 0);
+  project.GetLinks().insert(ActLink(1, 1, 2, 1, 1));
+  const ActProjectGraph graph = project.GetGraph();
+
+  // The later changes are not reflected
+  project.GetLinks().clear();
+  project.GetDevices().clear();
+  ASSERT_NE(nullptr, graph.GetLinkByInterfaceId(2, 1));
+  EXPECT_EQ(1, graph.GetLinkByInterfaceId(2, 1)->GetId());
+  ASSERT_NE(nullptr, graph.GetDevice(1));
+  EXPECT_EQ(1, graph.GetDevice(1)->GetId());
+}
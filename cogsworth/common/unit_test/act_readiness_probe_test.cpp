@@ -0,0 +1,39 @@
+#include "act_readiness_probe.hpp"
+
+#include "act_unit_test.hpp"
+
+class ActReadinessProbeTest : public ActQuickTest {};
+
+TEST_F(ActReadinessProbeTest, TestReadyAfterAttempts) {
+  ActReadinessProbe probe("Test", 5000, 10, 40);
+  quint32 count = 0;
+  ACT_STATUS act_status = probe.Wait([&count]() { return ++count >= 3; });
+
+  EXPECT_TRUE(IsActStatusSuccess(act_status));
+  EXPECT_EQ(3u, probe.GetAttempts());
+  EXPECT_LT(probe.GetElapsed(), 1000);
+}
+
+TEST_F(ActReadinessProbeTest, TestTimeout) {
+  ActReadinessProbe probe("Test", 200, 10, 40);
+  ACT_STATUS act_status = probe.Wait([]() { return false; });
+
+  EXPECT_TRUE(IsActStatusFailed(act_status));
+  EXPECT_GE(probe.GetElapsed(), 200);
+  EXPECT_GT(probe.GetAttempts(), 1u);
+}
+
+TEST_F(ActReadinessProbeTest, TestStopFlag) {
+  ActReadinessProbe probe("Test", 5000, 10, 40);
+  bool stop_flag = false;
+  quint32 count = 0;
+  ACT_STATUS act_status = probe.Wait(
+      [&count, &stop_flag]() {
+        stop_flag = (++count >= 2);
+        return false;
+      },
+      &stop_flag);
+
+  EXPECT_TRUE(IsActStatusStop(act_status));
+  EXPECT_EQ(2u, probe.GetAttempts());
+}
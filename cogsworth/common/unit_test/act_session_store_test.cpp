@@ -0,0 +1,143 @@
+#include "act_session_store.hpp"
+
+#include <QElapsedTimer>
+#include <QMap>
+#include <QMutex>
+#include <QStringList>
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "act_unit_test.hpp"
+
+class ActSessionStoreTest : public ActQuickTest {
+ protected:
+  const qint64 now = 1000000;
+
+  static QString Token(const qint32 &index) { return QString("token-%1").arg(index); }
+};
+
+TEST_F(ActSessionStoreTest, TestVerify) {
+  ActSessionStore store;
+  store.Insert(Token(1), ActSession{1, ActRoleEnum::kAdmin, now + 1000});
+  store.Insert(Token(2), ActSession{2, ActRoleEnum::kUser, now + 1000});
+
+  ActSession session;
+  ASSERT_TRUE(store.Find(Token(1), now, session));
+  EXPECT_EQ(1, session.user_id);
+  EXPECT_EQ(ActRoleEnum::kAdmin, session.role);
+  EXPECT_FALSE(store.Find(Token(3), now, session));
+
+  // Expired but not swept yet
+  EXPECT_FALSE(store.Find(Token(1), now + 1000, session));
+
+  EXPECT_TRUE(store.Remove(Token(2)));
+  EXPECT_FALSE(store.Remove(Token(2)));
+  EXPECT_FALSE(store.Find(Token(2), now, session));
+  EXPECT_EQ(1, store.Size());
+}
+
+TEST_F(ActSessionStoreTest, TestRemoveExpired) {
+  ActSessionStore store;
+  for (qint32 i = 0; i < 100; i++) {
+    store.Insert(Token(i), ActSession{i % 5, ActRoleEnum::kUser, now + i * 10});
+  }
+
+  // Renew the token 0, the old expiry must not remove it
+  store.Insert(Token(0), ActSession{0, ActRoleEnum::kUser, now + 5000});
+
+  EXPECT_EQ(0, store.RemoveExpired(now - 1));
+  EXPECT_EQ(49, store.RemoveExpired(now + 499));
+  EXPECT_EQ(51, store.Size());
+  EXPECT_EQ(50, store.RemoveExpired(now + 4999));
+
+  ActSession session;
+  EXPECT_TRUE(store.Find(Token(0), now + 4999, session));
+  EXPECT_EQ(1, store.RemoveExpired(now + 5000));
+  EXPECT_EQ(0, store.Size());
+}
+
+TEST_F(ActSessionStoreTest, TestUserChanges) {
+  ActSessionStore store;
+  for (qint32 i = 0; i < 40; i++) {
+    store.Insert(Token(i), ActSession{i % 4, ActRoleEnum::kUser, now + 1000});
+  }
+
+  store.UpdateUserRole(1, ActRoleEnum::kSupervisor);
+  ActSession session;
+  ASSERT_TRUE(store.Find(Token(5), now, session));
+  EXPECT_EQ(ActRoleEnum::kSupervisor, session.role);
+  ASSERT_TRUE(store.Find(Token(6), now, session));
+  EXPECT_EQ(ActRoleEnum::kUser, session.role);
+
+  // The password is changed
+  EXPECT_EQ(10, store.RemoveUser(2));
+  EXPECT_FALSE(store.Find(Token(6), now, session));
+  EXPECT_EQ(30, store.Size());
+
+  // The expiries of the removed sessions are gone too
+  EXPECT_EQ(30, store.RemoveExpired(now + 1000));
+  EXPECT_EQ(0, store.Size());
+}
+
+TEST_F(ActSessionStoreTest, BenchmarkConcurrentVerify) {
+  const qint32 kSessionCount = 200;
+  const qint32 kThreadCount = 8;
+  const qint32 kVerifyCount = 100000;  ///< per thread
+
+  QStringList tokens;
+  for (qint32 i = 0; i < kSessionCount; i++) {
+    tokens.append(Token(i));
+  }
+
+  // The reference: the token map behind a single mutex, as the core did
+  QMutex mutex;
+  QMap<QString, qint64> token_map;
+  ActSessionStore store;
+  for (qint32 i = 0; i < kSessionCount; i++) {
+    token_map.insert(tokens[i], i);
+    store.Insert(tokens[i], ActSession{i, ActRoleEnum::kUser, now + 1000});
+  }
+
+  auto run = [&](const std::function<bool(const QString &)> &verify) {
+    std::atomic<qint64> verified{0};
+    std::vector<std::thread> threads;
+    QElapsedTimer timer;
+    timer.start();
+    for (qint32 t = 0; t < kThreadCount; t++) {
+      threads.emplace_back([&, t]() {
+        qint64 count = 0;
+        for (qint32 i = 0; i < kVerifyCount; i++) {
+          count += verify(tokens[(i + t) % kSessionCount]) ? 1 : 0;
+        }
+        verified += count;
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    EXPECT_EQ(static_cast<qint64>(kThreadCount) * kVerifyCount, verified.load());
+    return qMax<qint64>(timer.elapsed(), 1);
+  };
+
+  const qint64 mutex_ms = run([&](const QString &token) {
+    QMutexLocker lock(&mutex);
+    return token_map.contains(token);
+  });
+  const qint64 store_ms = run([&](const QString &token) {
+    ActSession session;
+    return store.Find(token, now, session);
+  });
+
+  const qint64 verifications = static_cast<qint64>(kThreadCount) * kVerifyCount;
+  qDebug() << QString("Threads: %1, verifications: %2, mutex: %3 ms (%4/s), session store: %5 ms (%6/s)")
+                  .arg(kThreadCount)
+                  .arg(verifications)
+                  .arg(mutex_ms)
+                  .arg(verifications * 1000 / mutex_ms)
+                  .arg(store_ms)
+                  .arg(verifications * 1000 / store_ms)
+                  .toStdString()
+                  .c_str();
+}
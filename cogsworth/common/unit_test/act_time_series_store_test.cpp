@@ -0,0 +1,307 @@
+#include "act_time_series_store.hpp"
+
+#include <QDateTime>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QTemporaryDir>
+
+#include "act_unit_test.hpp"
+
+class ActTimeSeriesStoreTest : public ActQuickTest {
+ protected:
+  // Two hours ago at the start of an hour, so the samples are within the retention
+  const qint64 base = QDateTime::currentMSecsSinceEpoch() / ACT_TIME_SERIES_HOUR_MS * ACT_TIME_SERIES_HOUR_MS -
+                      2 * ACT_TIME_SERIES_HOUR_MS;
+
+  static QList<ActTimeSeriesPoint> Query(ActTimeSeriesStore &store, const QString &metric, const qint64 &from,
+                                         const qint64 &to, const ActTimeSeriesResolutionEnum &resolution) {
+    ActTimeSeries time_series;
+    ACT_STATUS act_status = store.Query(metric, from, to, resolution, time_series);
+    EXPECT_TRUE(IsActStatusSuccess(act_status));
+    return time_series.GetPoints();
+  }
+
+  // The reference roll-up of the samples <bucket start, (min, max, sum, count)>
+  static QMap<qint64, ActTimeSeriesBucket> RollUp(const QList<QPair<qint64, qreal>> &samples, const qint64 &span) {
+    QMap<qint64, ActTimeSeriesBucket> buckets;
+    for (const auto &sample : samples) {
+      const qint64 start = sample.first - (sample.first % span);
+      if (!buckets.contains(start)) {
+        buckets.insert(start, ActTimeSeriesBucket{start, 0, 0, 0, 0});
+      }
+      buckets[start].Add(sample.second);
+    }
+    return buckets;
+  }
+};
+
+TEST_F(ActTimeSeriesStoreTest, TestRollUps) {
+  ActTimeSeriesStore store(30);
+
+  // A sample per 10 seconds for 90 minutes
+  QList<QPair<qint64, qreal>> samples;
+  for (qint64 i = 0; i < 540; i++) {
+    samples.append(qMakePair(base + i * 10000, static_cast<qreal>((i * 7) % 13)));
+    ASSERT_TRUE(store.Append("device/1/cpu-usage", samples.last().first, samples.last().second));
+  }
+  const qint64 last = samples.last().first;
+
+  EXPECT_EQ(540, Query(store, "device/1/cpu-usage", base, last, ActTimeSeriesResolutionEnum::kRaw).size());
+
+  for (const auto &resolution : {ActTimeSeriesResolutionEnum::kMinute, ActTimeSeriesResolutionEnum::kHour}) {
+    const qint64 span =
+        (resolution == ActTimeSeriesResolutionEnum::kMinute) ? ACT_TIME_SERIES_MINUTE_MS : ACT_TIME_SERIES_HOUR_MS;
+    const QMap<qint64, ActTimeSeriesBucket> expected = RollUp(samples, span);
+    const QList<ActTimeSeriesPoint> points = Query(store, "device/1/cpu-usage", base, last, resolution);
+
+    ASSERT_EQ(expected.size(), points.size());
+    for (const auto &point : points) {
+      ASSERT_TRUE(expected.contains(point.GetTimestamp()));
+      const ActTimeSeriesBucket &bucket = expected[point.GetTimestamp()];
+      EXPECT_EQ(bucket.count, point.GetCount());
+      EXPECT_DOUBLE_EQ(bucket.min, point.GetMin());
+      EXPECT_DOUBLE_EQ(bucket.max, point.GetMax());
+      EXPECT_DOUBLE_EQ(bucket.sum / bucket.count, point.GetValue());
+    }
+  }
+
+  // The range in the middle
+  const qint64 from = base + 10 * ACT_TIME_SERIES_MINUTE_MS + 30000;
+  const qint64 to = base + 20 * ACT_TIME_SERIES_MINUTE_MS;
+  EXPECT_EQ(58, Query(store, "device/1/cpu-usage", from, to, ActTimeSeriesResolutionEnum::kRaw).size());
+  EXPECT_EQ(11, Query(store, "device/1/cpu-usage", from, to, ActTimeSeriesResolutionEnum::kMinute).size());
+}
+
+TEST_F(ActTimeSeriesStoreTest, TestRingCapacity) {
+  ActTimeSeriesStore store(30, 16, 8);
+  for (qint64 i = 0; i < 20 * 60; i++) {
+    store.Append("link/1/status", base + i * 1000, i % 2);
+  }
+
+  // Only the newest samples & roll-ups are kept
+  const QList<ActTimeSeriesPoint> raw =
+      Query(store, "link/1/status", base, base + ACT_TIME_SERIES_HOUR_MS, ActTimeSeriesResolutionEnum::kRaw);
+  ASSERT_EQ(16, raw.size());
+  EXPECT_EQ(base + (20 * 60 - 16) * 1000, raw.first().GetTimestamp());
+
+  // 8 closed minutes and the open one
+  const QList<ActTimeSeriesPoint> minutes =
+      Query(store, "link/1/status", base, base + ACT_TIME_SERIES_HOUR_MS, ActTimeSeriesResolutionEnum::kMinute);
+  ASSERT_EQ(9, minutes.size());
+  EXPECT_EQ(base + 11 * ACT_TIME_SERIES_MINUTE_MS, minutes.first().GetTimestamp());
+}
+
+TEST_F(ActTimeSeriesStoreTest, TestRetentionAndOrder) {
+  ActTimeSeriesStore store(1);
+  const qint64 old = base - 2 * 24 * ACT_TIME_SERIES_HOUR_MS;
+  ASSERT_TRUE(store.Append("device/1/memory-usage", old, 10));
+  ASSERT_TRUE(store.Append("device/1/memory-usage", base, 20));
+
+  // The sample out of the retention is evicted from all the resolutions
+  for (const auto &resolution : {ActTimeSeriesResolutionEnum::kRaw, ActTimeSeriesResolutionEnum::kMinute,
+                                 ActTimeSeriesResolutionEnum::kHour}) {
+    const QList<ActTimeSeriesPoint> points = Query(store, "device/1/memory-usage", old, base, resolution);
+    ASSERT_EQ(1, points.size());
+    EXPECT_DOUBLE_EQ(20, points.first().GetValue());
+  }
+
+  // The sample earlier than the last one is dropped
+  EXPECT_FALSE(store.Append("device/1/memory-usage", base - 1, 30));
+  EXPECT_EQ(1, store.GetDroppedCount());
+
+  ActTimeSeries time_series;
+  ACT_STATUS act_status =
+      store.Query("device/2/memory-usage", 0, base, ActTimeSeriesResolutionEnum::kRaw, time_series);
+  EXPECT_TRUE(IsActStatusNotFound(act_status));
+  act_status = store.Query("device/1/memory-usage", base, 0, ActTimeSeriesResolutionEnum::kRaw, time_series);
+  EXPECT_FALSE(IsActStatusSuccess(act_status));
+}
+
+TEST_F(ActTimeSeriesStoreTest, TestAutoResolution) {
+  ActTimeSeriesStore store(30, 16);
+  for (qint64 i = 0; i < 90; i++) {
+    store.Append("device/1/port/1/utilization", base + i * ACT_TIME_SERIES_MINUTE_MS, i);
+  }
+  const qint64 last = base + 89 * ACT_TIME_SERIES_MINUTE_MS;
+
+  ActTimeSeries time_series;
+  ACT_STATUS act_status = store.Query("device/1/port/1/utilization", last - 10 * ACT_TIME_SERIES_MINUTE_MS, last,
+                                      ActTimeSeriesResolutionEnum::kAuto, time_series);
+  ASSERT_TRUE(IsActStatusSuccess(act_status));
+  EXPECT_EQ(ActTimeSeriesResolutionEnum::kRaw, time_series.GetResolution());
+  EXPECT_EQ(11, time_series.GetPoints().size());
+
+  act_status =
+      store.Query("device/1/port/1/utilization", base, last, ActTimeSeriesResolutionEnum::kAuto, time_series);
+  ASSERT_TRUE(IsActStatusSuccess(act_status));
+  EXPECT_EQ(ActTimeSeriesResolutionEnum::kMinute, time_series.GetResolution());
+  EXPECT_EQ(90, time_series.GetPoints().size());
+
+  act_status = store.Query("device/1/port/1/utilization", base - 24 * ACT_TIME_SERIES_HOUR_MS, last,
+                           ActTimeSeriesResolutionEnum::kAuto, time_series);
+  ASSERT_TRUE(IsActStatusSuccess(act_status));
+  EXPECT_EQ(ActTimeSeriesResolutionEnum::kHour, time_series.GetResolution());
+  EXPECT_EQ(2, time_series.GetPoints().size());
+}
+
+TEST_F(ActTimeSeriesStoreTest, TestFlushAndOpen) {
+  QTemporaryDir folder;
+  ASSERT_TRUE(folder.isValid());
+
+  const QStringList metrics = {"device/1/cpu-usage", "device/1/port/2/utilization", "link/3/status"};
+  {
+    ActTimeSeriesStore store(30);
+    ACT_STATUS act_status = store.Open(folder.path());
+    ASSERT_TRUE(IsActStatusSuccess(act_status));
+    for (qint64 i = 0; i < 300; i++) {
+      store.Append(metrics.at(i % metrics.size()), base + i * 10000, i);
+    }
+    act_status = store.Flush();
+    ASSERT_TRUE(IsActStatusSuccess(act_status));
+    EXPECT_EQ(metrics.size(), QDir(folder.path()).entryList(QDir::Files).size());
+
+    // The later samples are kept by the next flush
+    store.Append(metrics.first(), base + ACT_TIME_SERIES_HOUR_MS + 1, 1000);
+    act_status = store.Flush();
+    ASSERT_TRUE(IsActStatusSuccess(act_status));
+  }
+
+  ActTimeSeriesStore reference(30);
+  for (qint64 i = 0; i < 300; i++) {
+    reference.Append(metrics.at(i % metrics.size()), base + i * 10000, i);
+  }
+  reference.Append(metrics.first(), base + ACT_TIME_SERIES_HOUR_MS + 1, 1000);
+
+  ActTimeSeriesStore store(30);
+  ACT_STATUS act_status = store.Open(folder.path());
+  ASSERT_TRUE(IsActStatusSuccess(act_status));
+  EXPECT_EQ(metrics, store.GetMetrics());
+  for (const QString &metric : metrics) {
+    for (const auto &resolution : {ActTimeSeriesResolutionEnum::kRaw, ActTimeSeriesResolutionEnum::kMinute,
+                                   ActTimeSeriesResolutionEnum::kHour}) {
+      ActTimeSeries expected;
+      ActTimeSeries loaded;
+      act_status = reference.Query(metric, base, base + 2 * ACT_TIME_SERIES_HOUR_MS, resolution, expected);
+      ASSERT_TRUE(IsActStatusSuccess(act_status));
+      act_status = store.Query(metric, base, base + 2 * ACT_TIME_SERIES_HOUR_MS, resolution, loaded);
+      ASSERT_TRUE(IsActStatusSuccess(act_status));
+      EXPECT_EQ(expected.ToString(), loaded.ToString()) << metric.toStdString();
+    }
+  }
+
+  // The roll-ups continue from the loaded open buckets
+  store.Append(metrics.first(), base + ACT_TIME_SERIES_HOUR_MS + 2, 2000);
+  reference.Append(metrics.first(), base + ACT_TIME_SERIES_HOUR_MS + 2, 2000);
+  ActTimeSeries expected;
+  ActTimeSeries loaded;
+  reference.Query(metrics.first(), base, base + 2 * ACT_TIME_SERIES_HOUR_MS, ActTimeSeriesResolutionEnum::kHour,
+                  expected);
+  store.Query(metrics.first(), base, base + 2 * ACT_TIME_SERIES_HOUR_MS, ActTimeSeriesResolutionEnum::kHour, loaded);
+  EXPECT_EQ(expected.ToString(), loaded.ToString());
+}
+
+TEST_F(ActTimeSeriesStoreTest, TestFlushRemovesExpiredMetrics) {
+  QTemporaryDir folder;
+  ASSERT_TRUE(folder.isValid());
+
+  ActTimeSeriesStore store(1);
+  ACT_STATUS act_status = store.Open(folder.path());
+  ASSERT_TRUE(IsActStatusSuccess(act_status));
+  store.Append("device/1/cpu-usage", base, 1);
+  store.Append("device/9/cpu-usage", base - 2 * 24 * ACT_TIME_SERIES_HOUR_MS, 1);  // e.g. the deleted device
+  act_status = store.Flush();
+  ASSERT_TRUE(IsActStatusSuccess(act_status));
+
+  EXPECT_EQ(QList<QString>({"device/1/cpu-usage"}), store.GetMetrics());
+  EXPECT_EQ(1, QDir(folder.path()).entryList(QDir::Files).size());
+}
+
+TEST_F(ActTimeSeriesStoreTest, TestFlushAppendsSamples) {
+  QTemporaryDir folder;
+  ASSERT_TRUE(folder.isValid());
+  const qint32 kRawCapacity = 16;
+  const qint64 kSampleSize = sizeof(qint64) + sizeof(qreal);
+
+  ActTimeSeriesStore store(30, kRawCapacity, 8);
+  ACT_STATUS act_status = store.Open(folder.path());
+  ASSERT_TRUE(IsActStatusSuccess(act_status));
+  for (qint64 i = 0; i < kRawCapacity; i++) {
+    store.Append("device/1/cpu-usage", base + i * 1000, i);
+  }
+  ASSERT_TRUE(IsActStatusSuccess(store.Flush()));
+  const QString path = QDir(folder.path()).filePath(QDir(folder.path()).entryList(QDir::Files).first());
+  const qint64 snapshot_size = QFileInfo(path).size();
+
+  // The later flushes only append the new samples, until they reach the raw capacity
+  qint64 timestamp = base + kRawCapacity * 1000;
+  for (qint32 i = 0; i < kRawCapacity; i++) {
+    store.Append("device/1/cpu-usage", timestamp, i);
+    timestamp += 1000;
+    ASSERT_TRUE(IsActStatusSuccess(store.Flush()));
+    EXPECT_EQ(snapshot_size + (i + 1) * kSampleSize, QFileInfo(path).size());
+  }
+  ASSERT_TRUE(IsActStatusSuccess(store.Flush()));  // nothing changed
+  EXPECT_EQ(snapshot_size + kRawCapacity * kSampleSize, QFileInfo(path).size());
+
+  // Then the snapshot is rewritten
+  store.Append("device/1/cpu-usage", timestamp, 100);
+  ASSERT_TRUE(IsActStatusSuccess(store.Flush()));
+  EXPECT_GE(snapshot_size + kSampleSize, QFileInfo(path).size());
+
+  // The replayed samples continue the roll-ups, a partial sample is ignored
+  store.Append("device/1/cpu-usage", timestamp + 1000, 200);
+  ASSERT_TRUE(IsActStatusSuccess(store.Flush()));
+  {
+    QFile file(path);
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly | QIODevice::Append));
+    ASSERT_EQ(4, file.write("torn", 4));
+  }
+
+  ActTimeSeriesStore loaded(30, kRawCapacity, 8);
+  ASSERT_TRUE(IsActStatusSuccess(loaded.Open(folder.path())));
+  for (const auto &resolution : {ActTimeSeriesResolutionEnum::kRaw, ActTimeSeriesResolutionEnum::kMinute,
+                                 ActTimeSeriesResolutionEnum::kHour}) {
+    EXPECT_EQ(Query(store, "device/1/cpu-usage", base, timestamp + 1000, resolution).size(),
+              Query(loaded, "device/1/cpu-usage", base, timestamp + 1000, resolution).size());
+  }
+  const QList<ActTimeSeriesPoint> raw =
+      Query(loaded, "device/1/cpu-usage", base, timestamp + 1000, ActTimeSeriesResolutionEnum::kRaw);
+  ASSERT_FALSE(raw.isEmpty());
+  EXPECT_DOUBLE_EQ(200, raw.last().GetValue());
+
+  // The partial sample is dropped by the rewrite
+  loaded.Append("device/1/cpu-usage", timestamp + 2000, 300);
+  ASSERT_TRUE(IsActStatusSuccess(loaded.Flush()));
+  EXPECT_EQ(0, (QFileInfo(path).size() - snapshot_size) % kSampleSize);
+}
+
+TEST_F(ActTimeSeriesStoreTest, BenchmarkIngestPointsPerSecond) {
+  const qint32 kMetricCount = 1000;
+  const qint32 kSampleCount = 200;
+
+  QStringList metrics;
+  for (qint32 i = 0; i < kMetricCount; i++) {
+    metrics.append(QString("device/%1/port/%2/utilization").arg(i / 10).arg(i % 10));
+  }
+
+  ActTimeSeriesStore store(30);
+  QElapsedTimer timer;
+  timer.start();
+  for (qint32 sample = 0; sample < kSampleCount; sample++) {
+    const qint64 timestamp = base + sample * 10000;
+    for (const QString &metric : metrics) {
+      store.Append(metric, timestamp, sample % 100);
+    }
+  }
+  const qint64 elapsed_ms = qMax<qint64>(timer.elapsed(), 1);
+  const qint64 points = static_cast<qint64>(kMetricCount) * kSampleCount;
+
+  EXPECT_EQ(0, store.GetDroppedCount());
+  qDebug() << QString("Metrics: %1, points: %2, points/s: %3")
+                  .arg(kMetricCount)
+                  .arg(points)
+                  .arg(points * 1000 / elapsed_ms)
+                  .toStdString()
+                  .c_str();
+}
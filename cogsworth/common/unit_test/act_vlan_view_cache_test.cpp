@@ -0,0 +1,161 @@
+#include "act_vlan_view_cache.hpp"
+
+#include <random>
+
+#include "act_unit_test.hpp"
+
+class ActVlanViewCacheTest : public ActQuickTest {
+ protected:
+  using ActVlanViewSnapshot = QMap<qint32, QMap<qint64, QStringList>>;  ///< <VLAN id, <device id, ports>>
+
+  QMap<qint64, ActVlanTable> vlan_tables;
+  std::mt19937 random{20240601};
+
+  qint32 Random(const qint32 &max) { return std::uniform_int_distribution<qint32>(0, max)(random); }
+
+  static QStringList PortsToStrings(const QSet<ActVlanPortTypeEntry> &ports) {
+    QStringList result;
+    for (auto port : ports) {
+      result.append(port.ToString());
+    }
+    result.sort();
+    return result;
+  }
+
+  static ActVlanViewSnapshot Snapshot(const ActVlanViewTable &vlan_view_table) {
+    ActVlanViewSnapshot snapshot;
+    for (const auto &vlan_view : vlan_view_table.GetVlanViews()) {
+      auto &devices = snapshot[vlan_view.GetVlanId()];
+      for (const auto &device : vlan_view.GetDevices()) {
+        devices.insert(device.GetDeviceId(), PortsToStrings(device.GetPorts()));
+      }
+    }
+    return snapshot;
+  }
+
+  // The full recompute
+  static ActVlanViewSnapshot Recompute(const QMap<qint64, ActVlanTable> &tables) {
+    ActVlanViewSnapshot snapshot;
+    for (const auto &vlan_table : tables) {
+      for (const auto &vlan_static_entry : vlan_table.GetVlanStaticEntries()) {
+        QSet<qint64> port_ids = vlan_static_entry.GetEgressPorts();
+        port_ids.unite(vlan_static_entry.GetUntaggedPorts());
+
+        QSet<ActVlanPortTypeEntry> ports;
+        for (const auto &port_id : port_ids) {
+          ActVlanPortTypeEntry entry(port_id, ActVlanPortTypeEnum::kHybrid, ActVlanPriorityEnum::kNonTSN);
+          auto entry_it = vlan_table.GetVlanPortTypeEntries().constFind(entry);
+          ports.insert(entry_it != vlan_table.GetVlanPortTypeEntries().constEnd() ? *entry_it : entry);
+        }
+        snapshot[vlan_static_entry.GetVlanId()].insert(vlan_table.GetDeviceId(), PortsToStrings(ports));
+      }
+    }
+    return snapshot;
+  }
+
+  void RandomEdit() {
+    const qint64 device_id = Random(7) + 1;
+    switch (Random(4)) {
+      case 0:  // remove the device
+        vlan_tables.remove(device_id);
+        break;
+      case 1: {  // add/replace a VLAN
+        ActVlanStaticEntry entry;
+        entry.SetVlanId(Random(5) + 1);
+        for (qint64 port = 1; port <= 4; port++) {
+          if (Random(1) == 0) {
+            entry.GetEgressPorts().insert(port);
+          } else if (Random(2) == 0) {
+            entry.GetUntaggedPorts().insert(port);
+          }
+        }
+        auto &vlan_table = vlan_tables[device_id];
+        vlan_table.SetDeviceId(device_id);
+        vlan_table.GetVlanStaticEntries().remove(entry);
+        vlan_table.GetVlanStaticEntries().insert(entry);
+      } break;
+      case 2: {  // remove a VLAN
+        if (vlan_tables.contains(device_id)) {
+          vlan_tables[device_id].GetVlanStaticEntries().remove(ActVlanStaticEntry(Random(5) + 1));
+        }
+      } break;
+      default: {  // change a port type
+        if (vlan_tables.contains(device_id)) {
+          const ActVlanPortTypeEntry entry(Random(3) + 1,
+                                           Random(1) ? ActVlanPortTypeEnum::kTrunk : ActVlanPortTypeEnum::kAccess,
+                                           Random(1) ? ActVlanPriorityEnum::kTSNUser : ActVlanPriorityEnum::kNonTSN);
+          auto &entries = vlan_tables[device_id].GetVlanPortTypeEntries();
+          entries.remove(entry);
+          entries.insert(entry);
+        }
+      } break;
+    }
+  }
+};
+
+TEST_F(ActVlanViewCacheTest, TestIncrementalMatchesRecompute) {
+  ActVlanViewCache vlan_view_cache;
+  for (qint32 step = 0; step < 500; step++) {
+    const qint32 edits = Random(2) + 1;
+    for (qint32 i = 0; i < edits; i++) {
+      RandomEdit();
+    }
+    vlan_view_cache.Update(vlan_tables);
+
+    const ActVlanViewSnapshot expected = Recompute(vlan_tables);
+    ASSERT_EQ(expected, Snapshot(vlan_view_cache.GetVlanViewTable())) << "step " << step;
+    ASSERT_EQ(expected.keys(), vlan_view_cache.GetVlanIds()) << "step " << step;
+  }
+}
+
+TEST_F(ActVlanViewCacheTest, TestUnchangedTablesAreSkipped) {
+  for (qint32 i = 0; i < 20; i++) {
+    RandomEdit();
+  }
+  ASSERT_FALSE(vlan_tables.isEmpty());
+
+  ActVlanViewCache vlan_view_cache;
+  EXPECT_EQ(vlan_tables.size(), vlan_view_cache.Update(vlan_tables));
+  EXPECT_EQ(0, vlan_view_cache.Update(vlan_tables));
+
+  // Only the edited device is re-materialized
+  ActVlanStaticEntry entry(100);
+  entry.GetEgressPorts().insert(1);
+  const qint64 device_id = vlan_tables.firstKey();
+  vlan_tables[device_id].GetVlanStaticEntries().insert(entry);
+  EXPECT_EQ(1, vlan_view_cache.Update(vlan_tables));
+
+  ActVlanView vlan_view;
+  ASSERT_TRUE(vlan_view_cache.GetVlanView(100, vlan_view));
+  EXPECT_EQ(1, vlan_view.GetDevices().size());
+  EXPECT_TRUE(vlan_view.GetDevices().contains(ActVlanViewDevice(device_id)));
+
+  // The removed device leaves the views
+  vlan_tables.remove(device_id);
+  EXPECT_EQ(1, vlan_view_cache.Update(vlan_tables));
+  EXPECT_FALSE(vlan_view_cache.GetVlanView(100, vlan_view));
+}
+
+TEST_F(ActVlanViewCacheTest, TestTablesAreOnlyComparedAfterRevision) {
+  for (qint32 i = 0; i < 20; i++) {
+    RandomEdit();
+  }
+  ASSERT_FALSE(vlan_tables.isEmpty());
+
+  ActVlanViewCache vlan_view_cache;
+  EXPECT_EQ(vlan_tables.size(), vlan_view_cache.Update(vlan_tables, 0));
+  const ActVlanViewSnapshot expected = Snapshot(vlan_view_cache.GetVlanViewTable());
+
+  // The same revision skips the tables, even though they changed
+  const qint64 device_id = vlan_tables.firstKey();
+  vlan_tables.remove(device_id);
+  EXPECT_EQ(0, vlan_view_cache.Update(vlan_tables, 0));
+  EXPECT_EQ(expected, Snapshot(vlan_view_cache.GetVlanViewTable()));
+
+  // The bumped revision applies them, only the changed device is re-materialized
+  EXPECT_EQ(1, vlan_view_cache.Update(vlan_tables, 1));
+  EXPECT_EQ(0, vlan_view_cache.Update(vlan_tables, 2));
+  for (const auto &vlan_view : vlan_view_cache.GetVlanViewTable().GetVlanViews()) {
+    EXPECT_FALSE(vlan_view.GetDevices().contains(ActVlanViewDevice(device_id))) << "VLAN " << vlan_view.GetVlanId();
+  }
+}
@@ -0,0 +1,109 @@
+#include "act_ws_listener_index.hpp"
+
+#include <QElapsedTimer>
+#include <QtTest/QtTest>
+
+#include "act_unit_test.hpp"
+
+namespace {
+
+/**
+ * @brief The fake listener only keeps the received payload buffers
+ *
+ */
+class FakeWSListener {
+ public:
+  void sendMessage(const std::shared_ptr<const std::string> &payload) { received_.append(payload); }
+
+  QList<std::shared_ptr<const std::string>> received_;
+};
+
+}  // namespace
+
+class ActWSListenerIndexTest : public ActQuickTest {
+ protected:
+  ActWSListenerIndex<FakeWSListener> index;
+};
+
+TEST_F(ActWSListenerIndexTest, TestProjectListeners) {
+  auto system_listener = std::make_shared<FakeWSListener>();
+  auto project_listener_1 = std::make_shared<FakeWSListener>();
+  auto project_listener_2 = std::make_shared<FakeWSListener>();
+  index.Insert(1, -1, system_listener);
+  index.Insert(2, 10, project_listener_1);
+  index.Insert(3, 20, project_listener_2);
+
+  EXPECT_EQ(3, index.Size());
+  EXPECT_EQ(1, index.ProjectListeners(-1).size());
+  EXPECT_EQ(1, index.ProjectListeners(10).size());
+  EXPECT_EQ(1, index.ProjectListeners(20).size());
+  EXPECT_TRUE(index.ProjectListeners(30).isEmpty());
+
+  EXPECT_TRUE(index.Remove(2));
+  EXPECT_FALSE(index.Remove(2));
+  EXPECT_FALSE(index.Contains(2));
+  EXPECT_TRUE(index.ProjectListeners(10).isEmpty());
+  EXPECT_EQ(2, index.Size());
+}
+
+TEST_F(ActWSListenerIndexTest, TestReinsertMovesProject) {
+  auto listener = std::make_shared<FakeWSListener>();
+  index.Insert(1, 10, listener);
+  index.Insert(1, 20, listener);
+
+  EXPECT_EQ(1, index.Size());
+  EXPECT_TRUE(index.ProjectListeners(10).isEmpty());
+  EXPECT_EQ(1, index.ProjectListeners(20).size());
+}
+
+TEST_F(ActWSListenerIndexTest, TestSharedPayload) {
+  for (qint64 id = 0; id < 8; id++) {
+    index.Insert(id, id % 2, std::make_shared<FakeWSListener>());
+  }
+
+  auto payload = std::make_shared<const std::string>("{\"OpCode\":1}");
+  for (const auto &listener : index.ProjectListeners(1)) {
+    listener->sendMessage(payload);
+  }
+
+  for (const auto &listener : index.ProjectListeners(1)) {
+    ASSERT_EQ(1, listener->received_.size());
+    EXPECT_EQ(payload.get(), listener->received_.first().get());
+  }
+  for (const auto &listener : index.ProjectListeners(0)) {
+    EXPECT_TRUE(listener->received_.isEmpty());
+  }
+}
+
+TEST_F(ActWSListenerIndexTest, BenchmarkFanOutThroughput) {
+  const qint64 kProjectCount = 4;
+  const qint64 kMessageCount = 20000;
+  const QString message(2048, QChar('x'));
+
+  for (qint64 listener_count : {1, 10, 50, 200}) {
+    ActWSListenerIndex<FakeWSListener> bench_index;
+    for (qint64 id = 0; id < listener_count * kProjectCount; id++) {
+      bench_index.Insert(id, id % kProjectCount, std::make_shared<FakeWSListener>());
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    for (qint64 i = 0; i < kMessageCount; i++) {
+      const QByteArray utf8 = message.toUtf8();
+      auto payload = std::make_shared<const std::string>(utf8.constData(), utf8.size());
+      for (const auto &listener : bench_index.ProjectListeners(i % kProjectCount)) {
+        listener->sendMessage(payload);
+        listener->received_.clear();
+      }
+    }
+    const qint64 elapsed_ms = qMax<qint64>(timer.elapsed(), 1);
+
+    qDebug() << QString("Listeners/project: %1, messages: %2, elapsed: %3 ms, throughput: %4 msg/s")
+                    .arg(listener_count)
+                    .arg(kMessageCount)
+                    .arg(elapsed_ms)
+                    .arg(kMessageCount * 1000 / elapsed_ms)
+                    .toStdString()
+                    .c_str();
+  }
+}
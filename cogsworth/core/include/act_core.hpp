@@ -24,31 +24,40 @@ See the file MOXA-SOFTWARE-NOTICE for details.
 #include "act_feature_profile.hpp"
 #include "act_firmware.hpp"
 #include "act_firmware_feature_profile.hpp"
+#include "act_firmware_rollout.hpp"
 #include "act_host_adapter.hpp"
 #include "act_import_export_project.hpp"
 #include "act_intelligent_request.hpp"
 #include "act_job.hpp"
+#include "act_job_engine.hpp"
 #include "act_json.hpp"
 #include "act_license.hpp"
+#include "act_monitor_poll_scheduler.hpp"
 #include "act_mqtt_client.hpp"
+#include "act_mqtt_event_queue.hpp"
 #include "act_network_baseline.hpp"
 #include "act_notification_msg.hpp"
+#include "act_patch_update_batch.hpp"
 #include "act_power_device_profile.hpp"
 #include "act_power_module.hpp"
 #include "act_project.hpp"
 #include "act_scan_ip_range.hpp"
 #include "act_service_platform_request.hpp"
 #include "act_service_profile.hpp"
+#include "act_session_store.hpp"
 #include "act_sfp_module.hpp"
 #include "act_software_license_profile.hpp"
 #include "act_status.hpp"
 #include "act_system.hpp"
+#include "act_time_series_store.hpp"
 #include "act_topology.hpp"
 #include "act_traffic.hpp"
 #include "act_user.hpp"
 #include "act_utilities.hpp"
 #include "act_vlan_config.hpp"
 #include "act_vlan_view.hpp"
+#include "act_vlan_view_cache.hpp"
+#include "act_ws_listener_index.hpp"
 #include "oatpp-websocket/AsyncWebSocket.hpp"
 #include "oatpp-websocket/WebSocket.hpp"
 #include "opcua_class_based_server.h"
@@ -59,6 +68,7 @@ See the file MOXA-SOFTWARE-NOTICE for details.
 #endif
 
 #define HISTORY_LIMIT (16)
+#define ACT_ZIP_DEFLATE_THREADS (4)  ///< The zip entries deflated at once
 class WSListener;  // FWD
 
 namespace act {
@@ -153,11 +163,14 @@ class ActCore : public QSerializer {
   qint64 last_assigned_firmware_feature_profile_id_;
   qint64 last_assigned_topology_id_;
   qint64 last_assigned_design_baseline_id_;
-  QMap<qint64, std::shared_ptr<WSListener>> ws_listeners_;
+  ActWSListenerIndex<WSListener> ws_listeners_;  ///< Indexed by listener id and subscribed project id
   ActNotificationMsgTmp notification_tmp_;
 
-  // [feat:1248] The login user should be logout after password change
-  QMap<qint64, bool> user_password_changed_;
+  // Patch update batch, guarded by mutex_
+  QMap<qint64, ActPatchUpdateBatch> patch_update_batches_;            ///< <ProjectID, pending batch>
+  QMap<qint64, quint64> patch_update_sequences_;                      ///< <ProjectID, last sent sequence>
+  QMap<qint64, QMap<QString, QJsonObject>> patch_update_snapshots_;  ///< <ProjectID, <Path, data sent>>
+  std::shared_ptr<std::thread> notification_batch_thread_;
 
   QMap<QString, QString> mac_host_map_;
   QMap<qint64, QString> restful_token_map_;           // <DeviceID, TokenString>
@@ -166,7 +179,7 @@ class ActCore : public QSerializer {
   QMap<qint64, QMap<qint64, ActDeviceIpConnectConfig>> project_dev_ip_conn_cfg_map_;
 
   QString cli_token;
-  QMap<QString, qint64> tokens_;
+  ActSessionStore sessions_;  ///< The login sessions, never guarded by the core mutex
 
   // [feat:955] Undo/Redo
   QMap<qint64, QList<ActProject>> transaction_list;  // Accumulated operations in a transaction
@@ -179,6 +192,56 @@ class ActCore : public QSerializer {
   // Deploy available
   QMap<qint64, bool> deploy_available;  // Deploy available<project_id, bool>
 
+  // Diff-based deploy
+  QMutex deployed_device_config_mutex_;
+  QMap<qint64, ActDeviceConfig> deployed_device_config_map_;  // Last deployed DeviceConfig<project_id, DeviceConfig>
+
+  // Materialized VLAN views
+  QMutex vlan_view_cache_mutex_;
+  QMap<qint64, ActVlanViewCache> vlan_view_cache_map_;            // VLAN views<project_id, cache>
+  QMap<qint64, ActVlanViewCache> operation_vlan_view_cache_map_;  // Monitor project's VLAN views<project_id, cache>
+  QMap<qint64, qint64> vlan_view_revision_map_;                   // Revision of the VLAN tables<project_id, revision>
+
+  /**
+   * @brief Apply the project's VLAN tables to its VLAN view cache
+   *
+   * The tables are only compared after the revision of the project is bumped. The revision should be read by
+   * GetVlanViewRevision() before the project is got, so a bump in between is applied by the next call.
+   *
+   * @param project
+   * @param revision the revision read before the project
+   * @param is_operation Indicate whether the project is the monitor project
+   * @return ActVlanViewCache the copy of the cache
+   */
+  ActVlanViewCache UpdateVlanViewCache(const ActProject &project, const qint64 &revision, const bool &is_operation);
+
+  /**
+   * @brief Get the revision of the project's VLAN tables
+   *
+   * @param project_id
+   * @return qint64
+   */
+  qint64 GetVlanViewRevision(const qint64 &project_id);
+
+  /**
+   * @brief Bump the revision of the project's VLAN tables, called after the stored or the monitor project is changed
+   *
+   * @param project_id
+   */
+  void BumpVlanViewRevision(const qint64 &project_id);
+
+  // Monitor history
+  QMutex time_series_mutex_;
+  QMap<qint64, std::shared_ptr<ActTimeSeriesStore>> time_series_store_map_;  // Time-series<project_id, store>
+
+  /**
+   * @brief Get the project's time-series store, it is loaded from the database folder on the first use
+   *
+   * @param project_id
+   * @return std::shared_ptr<ActTimeSeriesStore> nullptr if the store cannot be opened
+   */
+  std::shared_ptr<ActTimeSeriesStore> GetTimeSeriesStore(const qint64 &project_id);
+
   ACT_STATUS DeleteStreamFromComputedResult(ActProject &project, qint64 &stream_id);
 
   ACT_STATUS DeleteDeviceFromComputedResult(ActProject &project, qint64 &device_id);
@@ -191,8 +254,20 @@ class ActCore : public QSerializer {
   ActProject baseline_project_;
   std::shared_ptr<std::thread> monitor_process_thread_;
   std::shared_ptr<std::thread> mqtt_client_thread_;
+  std::shared_ptr<ActMqttEventQueue> mqtt_event_queue_;  // The MQTT events to apply in batches
   QQueue<ActMonitorData> monitor_process_queue_;
-  std::shared_ptr<QMutex> monitor_process_queue_mutex_;  // Added vector of locks for each worker queue
+  std::shared_ptr<QMutex> monitor_process_queue_mutex_;              // Added vector of locks for each worker queue
+  std::shared_ptr<ActTimeSeriesStore> monitor_time_series_;          // The time-series store of the monitor project
+  std::shared_ptr<ActMonitorPollScheduler> monitor_ping_scheduler_;  // The ping schedule of the monitor targets
+
+  /**
+   * @brief Append the sample to the monitor project's time-series (the caller should hold monitor_mutex_)
+   *
+   * @param metric
+   * @param timestamp (ms since epoch)
+   * @param value
+   */
+  void AppendMonitorTimeSeries(const QString &metric, const qint64 &timestamp, const qreal &value);
 
  public:
   /**
@@ -589,9 +664,10 @@ class ActCore : public QSerializer {
    * @param message
    * @param sync_to_websocket
    * @param send_tmp
+   * @param notify send the link status to the user at once
    */
   void HandlePortLinkEvent(const ActMqttEventTopicEnum topic, const ActMqttMessage &message, bool sync_to_websocket,
-                           bool send_tmp);
+                           bool send_tmp, bool notify = true);
   /**
    * @brief Handle trap message
    *
@@ -602,6 +678,23 @@ class ActCore : public QSerializer {
    */
   ACT_STATUS HandleTrapMessage(ActMqttMessage &message, bool sync_to_websocket, bool send_tmp);
 
+  /**
+   * @brief Handle the batch of trap messages under one lock, the link status is notified once
+   *
+   * @param messages
+   * @param sync_to_websocket
+   * @param send_tmp
+   * @return ACT_STATUS
+   */
+  ACT_STATUS HandleTrapMessages(QList<ActMqttMessage> &messages, bool sync_to_websocket, bool send_tmp);
+
+  /**
+   * @brief The MQTT client thread of the monitor, the received events are pushed to the queue
+   *
+   * @param event_queue
+   */
+  void MqttClientThread(std::shared_ptr<ActMqttEventQueue> event_queue);
+
   /**
    * @brief Handle ping result
    *
@@ -1032,7 +1125,7 @@ class ActCore : public QSerializer {
   ACT_STATUS Logout(const QString &token);
 
   /**
-   * @brief Verify the token is valid
+   * @brief Verify the token is valid (without the core mutex)
    *
    * @param token
    * @param role
@@ -1041,7 +1134,7 @@ class ActCore : public QSerializer {
   ACT_STATUS VerifyToken(QString token, ActRoleEnum &role);
 
   /**
-   * @brief Check the hard time out in the token set
+   * @brief Remove the sessions over the hard time out
    *
    * @return ACT_STATUS
    */
@@ -1693,13 +1786,22 @@ class ActCore : public QSerializer {
   ACT_STATUS SendMessageToSystemWSListeners(const QString &message);
 
   /**
-   * @brief Send message to System Websocket listeners
+   * @brief Send message to Project Websocket listeners
    *
+   * @param project_id
    * @param message
    * @return ACT_STATUS
    */
   ACT_STATUS SendMessageToProjectWSListeners(const qint64 &project_id, const QString &message);
 
+  /**
+   * @brief Convert the message to the Websocket payload which could be shared by listeners
+   *
+   * @param message
+   * @return oatpp::String
+   */
+  static oatpp::String ToWSPayload(const QString &message);
+
   /*************************************
    *  WS Notification Temp Management  *
    * ***********************************/
@@ -1711,6 +1813,13 @@ class ActCore : public QSerializer {
    */
   ACT_STATUS InitNotificationTmp();
 
+  /**
+   * @brief Get the WS Notification Message temp
+   *
+   * @return const ActNotificationMsgTmp&
+   */
+  const ActNotificationMsgTmp &GetNotificationTmp() const { return this->notification_tmp_; }
+
   /**
    * @brief Insert Link WS msg to core's Notification Tmp
    *
@@ -1743,6 +1852,46 @@ class ActCore : public QSerializer {
    */
   ACT_STATUS SendNotificationTmpMsgs(const qint64 &project_id);
 
+  /**
+   * @brief Move the Notification temp messages to the patch update batch of the project
+   *
+   * The batch would be sent by the notification batch thread after the NotificationBatchWindow.
+   *
+   * @param project_id
+   * @return ACT_STATUS
+   */
+  ACT_STATUS QueueNotificationTmpToBatch(const qint64 &project_id);
+
+  /**
+   * @brief Send the pending patch update batch of the project
+   *
+   * @param project_id
+   * @return ACT_STATUS
+   */
+  ACT_STATUS FlushPatchUpdateBatch(const qint64 &project_id);
+
+  /**
+   * @brief Send all pending patch update batches
+   *
+   * @return ACT_STATUS
+   */
+  ACT_STATUS FlushPatchUpdateBatches();
+
+  /**
+   * @brief Send the whole devices, links and streams of the project to the listener which detects a sequence gap
+   *
+   * @param project_id
+   * @param ws_listener_id
+   * @return ACT_STATUS
+   */
+  ACT_STATUS ResyncPatchUpdate(qint64 &project_id, const qint64 &ws_listener_id);
+
+  /**
+   * @brief The callback function of the notification batch thread
+   *
+   */
+  void StartNotificationBatchThread();
+
   /**********************
    *  Service Platform  *
    **********************/
@@ -3921,11 +4070,14 @@ class ActCore : public QSerializer {
   /**
    * @brief Get all vlan-view objects in specific project
    *
+   * The project may be changed by the caller, so the views are materialized from it without the project's cache.
+   *
    * @param project
    * @param vlan_view_table
+   * @param is_operation Indicate whether the project is the monitor project
    * @return ACT_STATUS
    */
-  ACT_STATUS GetVlanViews(ActProject &project, ActVlanViewTable &vlan_view_table);
+  ACT_STATUS GetVlanViews(ActProject &project, ActVlanViewTable &vlan_view_table, bool is_operation = false);
 
   /**
    * @brief Get a vlan-view object in specific project
@@ -3944,9 +4096,10 @@ class ActCore : public QSerializer {
    * @param project
    * @param vlan_id
    * @param vlan_view
+   * @param is_operation Indicate whether the project is the monitor project
    * @return ACT_STATUS
    */
-  ACT_STATUS GetVlanView(ActProject &project, qint32 &vlan_id, ActVlanView &vlan_view);
+  ACT_STATUS GetVlanView(ActProject &project, qint32 &vlan_id, ActVlanView &vlan_view, bool is_operation = false);
 
   /*************************
    *  Topology Management  *
@@ -4693,6 +4846,8 @@ class ActCore : public QSerializer {
   /**
    * @brief compute topology setting from the project
    *
+   * Only the VLAN tables holding the TSN entries are reset, and only the devices whose role is changed are notified.
+   *
    * @param project
    * @return ACT_STATUS
    */
@@ -4769,6 +4924,44 @@ class ActCore : public QSerializer {
                          const ActDeployActionEnum &action, const bool &skip_mapping_dev,
                          ActDeployParameterBase *parameter_base);
 
+  /**
+   * @brief Get the planned changes of the deploy without touching any device (dry run)
+   *
+   * Only the tables different from the last deployed ones are listed.
+   *
+   * @param project_id
+   * @param dev_id_list the devices to deploy (empty means all deployable devices)
+   * @param action
+   * @param plan
+   * @return ACT_STATUS
+   */
+  ACT_STATUS GetDeployPlan(qint64 &project_id, const QList<qint64> &dev_id_list, const ActDeployActionEnum &action,
+                           act::deploy::ActDeployPlan &plan);
+
+  /**
+   * @brief Update the last deployed DeviceConfig of the project by the deploy result
+   *
+   * @param project
+   * @param dev_id_list
+   * @param deploy_ctrl
+   * @param failed_device_id_set
+   * @param finished false if the deploy was aborted
+   */
+  void UpdateDeployedDeviceConfig(const ActProject &project, const QList<qint64> &dev_id_list,
+                                  const act::deploy::ActDeployControl &deploy_ctrl,
+                                  const QSet<qint64> &failed_device_id_set, const bool &finished);
+
+  /**
+   * @brief Remove the last deployed DeviceConfig of the devices, the next deploy pushes all their tables again
+   *
+   * Called when the device state is changed outside the deploy (e.g. reboot, factory default, firmware upgrade,
+   * config import, ini deploy, command line, device offline) or the device is deleted.
+   *
+   * @param project_id
+   * @param dev_id_list the devices (empty means all devices of the project)
+   */
+  void RemoveDeployedDeviceConfig(const qint64 &project_id, const QList<qint64> &dev_id_list);
+
   /**
    * @brief The Opc Ua callback function of deploy ini module
 
@@ -5252,9 +5445,11 @@ class ActCore : public QSerializer {
    * @param project_id
    * @param dev_id_list
    * @param firmware_name
+   * @param rollout_setting
    */
   void StartConfigFirmwareUpgradeThread(const qint64 &ws_listener_id, std::future<void> signal_receiver,
-                                        qint64 project_id, QList<qint64> dev_id_list, QString firmware_name);
+                                        qint64 project_id, QList<qint64> dev_id_list, QString firmware_name,
+                                        ActFirmwareRolloutSetting rollout_setting);
 
   /**
    * @brief Start DeviceConfiguration's FirmwareUpgrade procedure
@@ -5263,10 +5458,11 @@ class ActCore : public QSerializer {
    * @param socket
    * @param dev_id_list
    * @param firmware_name
+   * @param rollout_setting the waves and the bandwidth of the rollout
    * @return ACT_STATUS
    */
   ACT_STATUS StartConfigFirmwareUpgrade(qint64 &project_id, const qint64 &ws_listener_id, QList<qint64> &dev_id_list,
-                                        QString &firmware_name);
+                                        QString &firmware_name, const ActFirmwareRolloutSetting &rollout_setting);
 
   /**
    * @brief The callback function of DeviceConfiguration's EnableSnmp module
@@ -5628,6 +5824,30 @@ class ActCore : public QSerializer {
    */
   ACT_STATUS GetMonitorDeviceTrafficStatus(const QString &device_ip, ActMonitorDeviceTrafficStatus &traffic_status);
 
+  /**
+   * @brief Get the history of the monitored metric in [from, to]
+   *
+   * @param project_id
+   * @param metric e.g. "device/1/port/2/utilization", "link/3/status"
+   * @param from (ms since epoch)
+   * @param to (ms since epoch)
+   * @param resolution
+   * @param time_series
+   * @return ACT_STATUS
+   */
+  ACT_STATUS GetMonitorTimeSeries(const qint64 &project_id, const QString &metric, const qint64 &from,
+                                  const qint64 &to, const ActTimeSeriesResolutionEnum &resolution,
+                                  ActTimeSeries &time_series);
+
+  /**
+   * @brief Get the monitored metrics which have the history
+   *
+   * @param project_id
+   * @param metrics
+   * @return ACT_STATUS
+   */
+  ACT_STATUS GetMonitorTimeSeriesMetrics(const qint64 &project_id, ActTimeSeriesMetrics &metrics);
+
   /*****************************************
    *  Device RESTful token Map Management  *
    * ***************************************/
@@ -5749,11 +5969,15 @@ class ActCore : public QSerializer {
   /**
    * @brief CompressFolder object
    *
+   * The files are streamed in chunks, so the memory stays bounded whatever the file sizes are. With more than one
+   * deflate thread, the entries are deflated at once into the temporary files and appended to the zip as they complete.
+   *
    * @param folderPath
    * @param zipFilePath
+   * @param deflateThreads the entries deflated at once, 1 to deflate in the caller's thread
    * @return ACT_STATUS
    */
-  ACT_STATUS CompressFolder(const QString &folderPath, const QString &zipFilePath);
+  ACT_STATUS CompressFolder(const QString &folderPath, const QString &zipFilePath, const qint32 &deflateThreads = 1);
 
   /**
    * @brief ReadFileContent object
@@ -5767,6 +5991,8 @@ class ActCore : public QSerializer {
   /**
    * @brief UnZipFile object
    *
+   * The entries are streamed to the files in chunks.
+   *
    * @param zip_file_path
    * @param destination_path
    * @return ACT_STATUS
@@ -5938,6 +6164,11 @@ class ActCore : public QSerializer {
 
     // execute all actions in notification_tmp
     if (send_tmp) {
+      // Coalesce the project updates into one patch update batch per window
+      if ((ws_type == ActWSTypeEnum::kProject) && (this->GetSystemConfig().GetNotificationBatchWindow() > 0)) {
+        return this->QueueNotificationTmpToBatch(listener_id);
+      }
+
       auto local_notification_tmp = this->notification_tmp_;
 
       // Devices
@@ -5987,7 +6218,7 @@ class ActCore : public QSerializer {
     }
 
     if ((message.GetSyncToWebsocket()) /* &&  (this->GetLicense().GetFeature().GetHttps()) */) {
-      QString message_str = message.ToString(message.key_order_).toStdString().c_str();
+      QString message_str = message.ToString(message.key_order_);
       // TODO: clear delete data (by reorder key_order_)
 
       switch (ws_type) {
@@ -6027,7 +6258,7 @@ class ActCore : public QSerializer {
                                    [[maybe_unused]] qint64 listener_id = -1) {
     ACT_STATUS_INIT();
 
-    QString message_str = message->ToString(message->key_order_).toStdString().c_str();
+    QString message_str = message->ToString(message->key_order_);
 
     if (true /* this->GetLicense().GetFeature().GetHttps()*/) {
       switch (ws_type) {
@@ -3,7 +3,7 @@
 #define SLEEP_MS(ms) Sleep(ms)
 #else
 #include <unistd.h>  // for sleep
-#define SLEEP_MS(ms) sleep(ms / 1000)
+#define SLEEP_MS(ms) usleep((ms) * 1000)
 #endif
 
 #include <QDesktopServices>
@@ -44,6 +44,9 @@ ACT_STATUS ActCore::Init() {
 
   this->SetSystemConfig(sys);
 
+  // Limit the concurrent jobs of the job engine
+  g_act_job_engine.SetTypeLimit("FirmwareUpgrade", ACT_JOB_FIRMWARE_UPGRADE_LIMIT);
+
   // Set user config
   QSet<ActUser> user_set;
   qint64 last_assigned_user_id = -1;
@@ -4,7 +4,7 @@
 #define SLEEP_MS(ms) Sleep(ms)
 #else
 #include <unistd.h>  // for sleep
-#define SLEEP_MS(ms) sleep(ms / 1000)
+#define SLEEP_MS(ms) usleep((ms) * 1000)
 #endif
 
 // #include <QRandomGenerator>
@@ -42,6 +42,8 @@ void ActCore::StartChamberlainThread() {
 ACT_STATUS ActCore::StartChamberlain() {
   ACT_STATUS_INIT();
   this->chamberlain_thread_ = std::make_shared<std::thread>(&act::core::ActCore::StartChamberlainThread, this);
+  this->notification_batch_thread_ =
+      std::make_shared<std::thread>(&act::core::ActCore::StartNotificationBatchThread, this);
 
 #ifdef _WIN32
   // Set the thread name
@@ -62,6 +64,10 @@ void ActCore::StopChamberlain() {
     this->chamberlain_thread_->join();
   }
 
+  if ((this->notification_batch_thread_ != nullptr) && (this->notification_batch_thread_->joinable())) {
+    this->notification_batch_thread_->join();
+  }
+
   qDebug() << "Chamberlain thread is finish";
 
   return;
@@ -3,9 +3,10 @@
 #define SLEEP_MS(ms) Sleep(ms)
 #else
 #include <unistd.h>  // for sleep
-#define SLEEP_MS(ms) sleep(ms / 1000)
+#define SLEEP_MS(ms) usleep((ms) * 1000)
 #endif
 
+#include <QHash>
 #include <QSet>
 #include <QStack>
 #include <thread>
@@ -64,18 +65,54 @@ ACT_STATUS ActCore::DeleteComputedResult(qint64 &project_id) {
   return act_status;
 }
 
+/**
+ * @brief Whether the VLAN table holds the TSN entries to be reset, the others are left as they are
+ *
+ * @param vlan_table
+ * @param device
+ * @return true if the table needs to be reset
+ */
+static bool NeedResetTsnVlanEntries(const ActVlanTable &vlan_table, const ActDevice &device) {
+  for (const ActVlanStaticEntry &vlan_static_entry : vlan_table.GetVlanStaticEntries()) {
+    if ((vlan_static_entry.GetVlanPriority() != ActVlanPriorityEnum::kNonTSN) &&
+        !device.GetDeviceProperty().GetReservedVlan().contains(vlan_static_entry.GetVlanId())) {
+      return true;
+    }
+  }
+
+  for (const ActPortVlanEntry &port_vlan_entry : vlan_table.GetPortVlanEntries()) {
+    if (port_vlan_entry.GetVlanPriority() != ActVlanPriorityEnum::kNonTSN) {
+      return true;
+    }
+  }
+
+  for (const ActVlanPortTypeEntry &vlan_port_type_entry : vlan_table.GetVlanPortTypeEntries()) {
+    if (vlan_port_type_entry.GetVlanPriority() != ActVlanPriorityEnum::kNonTSN) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
 ACT_STATUS ActCore::ComputeTopologySetting(ActProject &project) {
   ACT_STATUS_INIT();
 
   ActDeviceConfig &device_config = project.GetDeviceConfig();
-  for (qint64 device_id : device_config.GetVlanTables().keys()) {
+  QMap<qint64, ActVlanTable> &vlan_tables = device_config.GetVlanTables();
+  for (auto vlan_table_it = vlan_tables.begin(); vlan_table_it != vlan_tables.end(); vlan_table_it++) {
+    const qint64 device_id = vlan_table_it.key();
     ActDevice device;
     act_status = project.GetDeviceById(device, device_id);
     if (!IsActStatusSuccess(act_status)) {
       return act_status;
     }
 
-    ActVlanTable &vlan_table = device_config.GetVlanTables()[device_id];
+    // Only the tables with the TSN entries are changed, the others are already reset by the previous computes
+    ActVlanTable &vlan_table = vlan_table_it.value();
+    if (!NeedResetTsnVlanEntries(vlan_table, device)) {
+      continue;
+    }
 
     QSet<ActVlanStaticEntry> vlan_static_entries;
     for (ActVlanStaticEntry vlan_static_entry : vlan_table.GetVlanStaticEntries()) {
@@ -114,25 +151,28 @@ ACT_STATUS ActCore::ComputeTopologySetting(ActProject &project) {
   //   return act_status;
   // }
 
+  // The redundant group only changes the device roles, keep them to find the changed devices
+  QHash<qint64, ActDeviceRoleEnum> device_roles;
+  device_roles.reserve(project.GetDevices().size());
+  for (const ActDevice &device : project.GetDevices()) {
+    device_roles.insert(device.GetId(), device.GetDeviceRole());
+  }
+
   // update redundant group
   act_status = this->ComputeRedundantSwift(project);
   if (!IsActStatusSuccess(act_status)) {
     return act_status;
   }
 
-  if (!project.GetTopologySetting().GetIntelligentVlanGroup().isEmpty() ||
-      !project.GetTopologySetting().GetRedundantGroup().GetRSTP().isEmpty()) {
-    for (ActDevice device : project.GetDevices()) {
-      // Send device update msg to temp
-      InsertDeviceMsgToNotificationTmp(
-          ActDevicePatchUpdateMsg(ActPatchUpdateActionEnum::kUpdate, project.GetId(), device, true));
+  // Send device update msg to temp only for the devices whose role is changed (the links are never changed here)
+  for (const ActDevice &device : project.GetDevices()) {
+    auto role_it = device_roles.constFind(device.GetId());
+    if (role_it != device_roles.constEnd() && role_it.value() == device.GetDeviceRole()) {
+      continue;
     }
 
-    for (ActLink link : project.GetLinks()) {
-      // Send link update msg to temp
-      InsertLinkMsgToNotificationTmp(
-          ActLinkPatchUpdateMsg(ActPatchUpdateActionEnum::kUpdate, project.GetId(), link, true));
-    }
+    InsertDeviceMsgToNotificationTmp(
+        ActDevicePatchUpdateMsg(ActPatchUpdateActionEnum::kUpdate, project.GetId(), device, true));
   }
 
   return ACT_STATUS_SUCCESS;
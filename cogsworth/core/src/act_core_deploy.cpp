@@ -3,7 +3,7 @@
 #define SLEEP_MS(ms) Sleep(ms)
 #else
 #include <unistd.h>  // for sleep
-#define SLEEP_MS(ms) sleep(ms / 1000)
+#define SLEEP_MS(ms) usleep((ms) * 1000)
 #endif
 
 #include <QSet>
@@ -16,6 +16,41 @@
 namespace act {
 namespace core {
 
+void GenerateDeployControl(const ActDeployActionEnum &action, act::deploy::ActDeployControl &deploy_ctrl) {
+  if (action == ActDeployActionEnum::kReboot) {
+    deploy_ctrl.SetReboot(true);
+  } else if (action == ActDeployActionEnum::kFactoryDefault) {
+    deploy_ctrl.SetFactoryDefault(true);
+  } else if (action == ActDeployActionEnum::kFirmwareUpgrade) {
+    deploy_ctrl.SetFirmwareUpgrade(true);
+  } else if (action == ActDeployActionEnum::kNetworkSetting) {
+    deploy_ctrl.SetNetworkSetting(true);
+  } else if (action == ActDeployActionEnum::kVLAN) {
+    deploy_ctrl.SetVlan(true);
+  } else {  // all config
+
+    deploy_ctrl.SetFromBroadcastSearch(false);
+    deploy_ctrl.SetNetworkSetting(true);
+    deploy_ctrl.SetLoginPolicy(true);
+    deploy_ctrl.SetSnmpTrapSetting(true);
+    deploy_ctrl.SetSyslogSetting(true);
+    deploy_ctrl.SetTimeSetting(true);
+    deploy_ctrl.SetPortSetting(true);
+    deploy_ctrl.SetInformationSetting(true);
+    deploy_ctrl.SetManagementInterface(true);
+    deploy_ctrl.SetLoopProtection(true);
+    deploy_ctrl.SetVlan(true);
+    deploy_ctrl.SetPortDefaultPcp(true);
+    deploy_ctrl.SetUnicastStaticForward(true);
+    deploy_ctrl.SetMulticastStaticForward(true);
+    deploy_ctrl.SetStreamPriorityIngress(true);
+    deploy_ctrl.SetStreamPriorityEgress(true);
+    deploy_ctrl.SetGcl(true);
+    deploy_ctrl.SetIeee802Dot1Cb(true);
+    deploy_ctrl.SetSpanningTree(true);
+  }
+}
+
 ACT_STATUS GetDeployDevicesFromProject(ActProject &project, ActDeployDeviceList &deploy_device_list) {
   ACT_STATUS_INIT();
 
@@ -451,6 +486,9 @@ ACT_STATUS ActCore::OpcUaStartDeployIni(qint64 &project_id, const QList<qint64>
     return act_status;
   }
 
+  // The device state is changed outside the deploy, the next deploy pushes all its tables again
+  this->RemoveDeployedDeviceConfig(project_id, dev_id_list);
+
   // Create a std::promise object
   std::shared_ptr<std::promise<void>> signal_sender = std::make_shared<std::promise<void>>();
 
@@ -506,39 +544,7 @@ void ActCore::StartDeployThread(const qint64 &ws_listener_id, std::future<void>
   act::deploy::ActDeploy deployer(profiles, mac_host_map);
 
   act::deploy::ActDeployControl deploy_ctrl;
-
-  if (action == ActDeployActionEnum::kReboot) {
-    deploy_ctrl.SetReboot(true);
-  } else if (action == ActDeployActionEnum::kFactoryDefault) {
-    deploy_ctrl.SetFactoryDefault(true);
-  } else if (action == ActDeployActionEnum::kFirmwareUpgrade) {
-    deploy_ctrl.SetFirmwareUpgrade(true);
-  } else if (action == ActDeployActionEnum::kNetworkSetting) {
-    deploy_ctrl.SetNetworkSetting(true);
-  } else if (action == ActDeployActionEnum::kVLAN) {
-    deploy_ctrl.SetVlan(true);
-  } else {  // all config
-
-    deploy_ctrl.SetFromBroadcastSearch(false);
-    deploy_ctrl.SetNetworkSetting(true);
-    deploy_ctrl.SetLoginPolicy(true);
-    deploy_ctrl.SetSnmpTrapSetting(true);
-    deploy_ctrl.SetSyslogSetting(true);
-    deploy_ctrl.SetTimeSetting(true);
-    deploy_ctrl.SetPortSetting(true);
-    deploy_ctrl.SetInformationSetting(true);
-    deploy_ctrl.SetManagementInterface(true);
-    deploy_ctrl.SetLoopProtection(true);
-    deploy_ctrl.SetVlan(true);
-    deploy_ctrl.SetPortDefaultPcp(true);
-    deploy_ctrl.SetUnicastStaticForward(true);
-    deploy_ctrl.SetMulticastStaticForward(true);
-    deploy_ctrl.SetStreamPriorityIngress(true);
-    deploy_ctrl.SetStreamPriorityEgress(true);
-    deploy_ctrl.SetGcl(true);
-    deploy_ctrl.SetIeee802Dot1Cb(true);
-    deploy_ctrl.SetSpanningTree(true);
-  }
+  GenerateDeployControl(action, deploy_ctrl);
 
   // Generate the device_id_list when that is empty
   if (dev_id_list.isEmpty()) {
@@ -573,6 +579,18 @@ void ActCore::StartDeployThread(const qint64 &ws_listener_id, std::future<void>
     }
   }
 
+  // Only deploy the tables changed from the last deploy
+  {
+    QMutexLocker lock(&this->deployed_device_config_mutex_);
+    if (this->deployed_device_config_map_.contains(project_id)) {
+      deployer.SetBaselineDeviceConfig(this->deployed_device_config_map_[project_id]);
+    }
+  }
+
+  // The devices deployed concurrently in a wave (at least one)
+  deployer.SetParallelism(
+      qBound<quint32>(1, this->GetSystemConfig().GetDeployParallelism(), ACT_DEPLOY_PARALLELISM_MAX));
+
   act_status = deployer.Start(project, dev_id_list, deploy_ctrl, skip_mapping_dev, parameter_base);
   if (!IsActStatusRunning(act_status)) {
     qCritical() << project.GetProjectName() << "Start deploy failed";
@@ -591,8 +609,8 @@ void ActCore::StartDeployThread(const qint64 &ws_listener_id, std::future<void>
     act_status = deployer.GetStatus();
 
     // Dequeue
-    while (!deployer.result_queue_.isEmpty()) {
-      ActDeviceConfigureResult dev_config_result = deployer.result_queue_.dequeue();
+    ActDeviceConfigureResult dev_config_result;
+    while (deployer.DequeueResult(dev_config_result)) {
       ActDeviceConfigResultWSResponse ws_resp(ActWSCommandEnum::kStartDeploy, ActStatusType::kRunning,
                                               dev_config_result);
       // qDebug() << __func__ << ws_resp.ToString(ws_resp.key_order_).toStdString().c_str();
@@ -622,10 +640,13 @@ void ActCore::StartDeployThread(const qint64 &ws_listener_id, std::future<void>
     deployer.Stop();
     qCritical() << project.GetProjectName() << "Abort deploy";
 
+    this->UpdateDeployedDeviceConfig(project, dev_id_list, deploy_ctrl, deployer.failed_device_id_set_, false);
     this->project_status_list[project_id] = ActProjectStatusEnum::kAborted;
     return;
   }
 
+  this->UpdateDeployedDeviceConfig(project, dev_id_list, deploy_ctrl, deployer.failed_device_id_set_,
+                                   act_status->GetStatus() == ActStatusType::kFinished);
   this->project_status_list[project_id] = ActProjectStatusEnum::kFinished;
 
   // Update project's devices set, if success config NetworkSetting
@@ -748,6 +769,94 @@ ACT_STATUS ActCore::StartDeploy(qint64 &project_id, const qint64 &ws_listener_id
   return act_status;
 }
 
+ACT_STATUS ActCore::GetDeployPlan(qint64 &project_id, const QList<qint64> &dev_id_list,
+                                  const ActDeployActionEnum &action, act::deploy::ActDeployPlan &plan) {
+  ACT_STATUS_INIT();
+
+  // Get project by id
+  ActProject project;
+  act_status = this->GetProject(project_id, project);
+  if (!IsActStatusSuccess(act_status)) {
+    qCritical() << "Get project failed with project id:" << project_id;
+    return act_status;
+  }
+
+  act::deploy::ActDeployControl deploy_ctrl;
+  GenerateDeployControl(action, deploy_ctrl);
+
+  // Generate the device_id_list when that is empty
+  QList<qint64> deploy_dev_id_list = dev_id_list;
+  if (deploy_dev_id_list.isEmpty()) {
+    act_status = AutoGenerateDeployDeviceList(project, deploy_dev_id_list);
+    if (!IsActStatusSuccess(act_status)) {
+      qCritical() << project.GetProjectName() << "Generate the deploy devices list failed";
+      return act_status;
+    }
+  }
+
+  // Filter the device by device type & DeviceConfig (same as the deploy)
+  QList<qint64> plan_dev_id_list;
+  for (auto dev_id : deploy_dev_id_list) {
+    ActDevice dev;
+    act_status = project.GetDeviceById(dev, dev_id);
+    if (!IsActStatusSuccess(act_status)) {
+      qCritical() << __func__ << "Project has no device id:" << dev_id;
+      return act_status;
+    }
+    if (ActDevice::CheckDeviceCanBeDeploy(dev) && CheckDeviceInDeviceConfig(project.GetDeviceConfig(), dev_id)) {
+      plan_dev_id_list.append(dev_id);
+    }
+  }
+
+  act::deploy::ActDeployDiff deploy_diff;
+  {
+    QMutexLocker lock(&this->deployed_device_config_mutex_);
+    if (this->deployed_device_config_map_.contains(project_id)) {
+      deploy_diff = act::deploy::ActDeployDiff(this->deployed_device_config_map_[project_id]);
+    }
+  }
+
+  plan.GetChanges().clear();
+  deploy_diff.GeneratePlan(project.GetDeviceConfig(), plan_dev_id_list, deploy_ctrl, plan);
+
+  return ACT_STATUS_SUCCESS;
+}
+
+void ActCore::UpdateDeployedDeviceConfig(const ActProject &project, const QList<qint64> &dev_id_list,
+                                         const act::deploy::ActDeployControl &deploy_ctrl,
+                                         const QSet<qint64> &failed_device_id_set, const bool &finished) {
+  QMutexLocker lock(&this->deployed_device_config_mutex_);
+  ActDeviceConfig &baseline = this->deployed_device_config_map_[project.GetId()];
+
+  // The device would be reset by these actions, so the next deploy starts from scratch
+  const bool reset_device = deploy_ctrl.GetFactoryDefault() || deploy_ctrl.GetFirmwareUpgrade();
+
+  for (const auto &dev_id : dev_id_list) {
+    if (!finished || reset_device || failed_device_id_set.contains(dev_id)) {
+      act::deploy::ActDeployDiff::RemoveBaseline(baseline, dev_id);
+      continue;
+    }
+
+    act::deploy::ActDeployDiff::UpdateBaseline(baseline, project.GetDeviceConfig(), deploy_ctrl, dev_id);
+  }
+}
+
+void ActCore::RemoveDeployedDeviceConfig(const qint64 &project_id, const QList<qint64> &dev_id_list) {
+  QMutexLocker lock(&this->deployed_device_config_mutex_);
+  if (dev_id_list.isEmpty()) {
+    this->deployed_device_config_map_.remove(project_id);
+    return;
+  }
+
+  auto baseline_it = this->deployed_device_config_map_.find(project_id);
+  if (baseline_it == this->deployed_device_config_map_.end()) {
+    return;
+  }
+  for (const auto &dev_id : dev_id_list) {
+    act::deploy::ActDeployDiff::RemoveBaseline(baseline_it.value(), dev_id);
+  }
+}
+
 void ActCore::StartDeployIniThread(const qint64 &ws_listener_id, std::future<void> signal_receiver, qint64 project_id,
                                    QList<qint64> dev_id_list, bool skip_mapping_dev) {
   ACT_STATUS_INIT();
@@ -998,6 +1107,9 @@ ACT_STATUS ActCore::StartDeployIni(qint64 &project_id, const qint64 &ws_listener
     return act_status;
   }
 
+  // The device state is changed outside the deploy, the next deploy pushes all its tables again
+  this->RemoveDeployedDeviceConfig(project_id, dev_id_list);
+
   // Create a std::promise object
   std::shared_ptr<std::promise<void>> signal_sender = std::make_shared<std::promise<void>>();
 
@@ -969,6 +969,8 @@ ACT_STATUS ActCore::CreateDevice(ActProject &project, ActDevice &device, const b
 
   // Find the device profile to fill the interface property by model name
   UpdateDeviceConfigTable(project, device, this->GetDeviceProfileSet());
+  // The monitor engine changes the monitor project in place, so its VLAN tables are stale from now on
+  this->BumpVlanViewRevision(project.GetId());
 
   // Send update msg to temp
   InsertDeviceMsgToNotificationTmp(
@@ -1392,6 +1394,7 @@ ACT_STATUS ActCore::UpdateDevice(ActProject &project, ActDevice &device) {
 
   // Find the device profile to fill the interface property by model name
   UpdateDeviceConfigTable(project, device, this->GetDeviceProfileSet());
+  this->BumpVlanViewRevision(project.GetId());
 
   // Send update msg to temp
   InsertDeviceMsgToNotificationTmp(
@@ -1593,6 +1596,7 @@ ACT_STATUS ActCore::DeleteDevice(ActProject &project, qint64 &device_id) {
   }
 
   device_set.remove(device);
+  this->RemoveDeployedDeviceConfig(project.GetId(), QList<qint64>({device.GetId()}));
 
   // Send update msg to temp
   InsertDeviceMsgToNotificationTmp(
@@ -1666,6 +1670,7 @@ ACT_STATUS ActCore::DeleteDevice(ActProject &project, qint64 &device_id) {
     qCritical() << "Delete Device DeviceConfig failed. Device:" << device_id;
     return act_status;
   }
+  this->BumpVlanViewRevision(project.GetId());
 
   // Delete the connected link & update opposite device
   QSet<ActLink> link_set = project.GetLinks();
@@ -1767,6 +1772,7 @@ ACT_STATUS ActCore::DeleteDevices(ActProject &project, QList<qint64> &dev_ids, c
     }
 
     device_set.remove(device);
+    this->RemoveDeployedDeviceConfig(project.GetId(), QList<qint64>({device.GetId()}));
 
     // Send update msg to temp
     InsertDeviceMsgToNotificationTmp(
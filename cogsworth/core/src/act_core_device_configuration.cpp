@@ -3,7 +3,7 @@
 #define SLEEP_MS(ms) Sleep(ms)
 #else
 #include <unistd.h>  // for sleep
-#define SLEEP_MS(ms) sleep(ms / 1000)
+#define SLEEP_MS(ms) usleep((ms) * 1000)
 #endif
 
 #include <QSet>
@@ -249,6 +249,13 @@ ACT_STATUS ActCore::OpcUaStartIpConfiguration(qint64 &project_id, QList<ActDevic
     return act_status;
   }
 
+  // The device state is changed outside the deploy, the next deploy pushes all its tables again
+  QList<qint64> ip_config_dev_id_list;
+  for (const auto &dev_ip_config : dev_ip_config_list) {
+    ip_config_dev_id_list.append(dev_ip_config.GetId());
+  }
+  this->RemoveDeployedDeviceConfig(project_id, ip_config_dev_id_list);
+
   // Create a std::promise object
   std::shared_ptr<std::promise<void>> signal_sender = std::make_shared<std::promise<void>>();
 
@@ -535,6 +542,13 @@ ACT_STATUS ActCore::StartIpConfiguration(qint64 &project_id, const qint64 &ws_li
     return act_status;
   }
 
+  // The device state is changed outside the deploy, the next deploy pushes all its tables again
+  QList<qint64> ip_config_dev_id_list;
+  for (const auto &dev_ip_config : dev_ip_config_list) {
+    ip_config_dev_id_list.append(dev_ip_config.GetId());
+  }
+  this->RemoveDeployedDeviceConfig(project_id, ip_config_dev_id_list);
+
   // Create a std::promise object
   std::shared_ptr<std::promise<void>> signal_sender = std::make_shared<std::promise<void>>();
 
@@ -659,6 +673,9 @@ ACT_STATUS ActCore::OpcUaStartConfigReboot(qint64 &project_id, QList<qint64> &de
     return act_status;
   }
 
+  // The device state is changed outside the deploy, the next deploy pushes all its tables again
+  this->RemoveDeployedDeviceConfig(project_id, dev_id_list);
+
   // Create a std::promise object
   std::shared_ptr<std::promise<void>> signal_sender = std::make_shared<std::promise<void>>();
 
@@ -793,6 +810,9 @@ ACT_STATUS ActCore::StartConfigReboot(qint64 &project_id, const qint64 &ws_liste
     return act_status;
   }
 
+  // The device state is changed outside the deploy, the next deploy pushes all its tables again
+  this->RemoveDeployedDeviceConfig(project_id, dev_id_list);
+
   // Create a std::promise object
   std::shared_ptr<std::promise<void>> signal_sender = std::make_shared<std::promise<void>>();
 
@@ -1380,6 +1400,9 @@ ACT_STATUS ActCore::OpcUaStartConfigFactoryDefault(qint64 &project_id, QList<qin
     return act_status;
   }
 
+  // The device state is changed outside the deploy, the next deploy pushes all its tables again
+  this->RemoveDeployedDeviceConfig(project_id, dev_id_list);
+
   // Create a std::promise object
   std::shared_ptr<std::promise<void>> signal_sender = std::make_shared<std::promise<void>>();
 
@@ -1515,6 +1538,9 @@ ACT_STATUS ActCore::StartConfigFactoryDefault(qint64 &project_id, const qint64 &
     return act_status;
   }
 
+  // The device state is changed outside the deploy, the next deploy pushes all its tables again
+  this->RemoveDeployedDeviceConfig(project_id, dev_id_list);
+
   // Create a std::promise object
   std::shared_ptr<std::promise<void>> signal_sender = std::make_shared<std::promise<void>>();
 
@@ -1639,6 +1665,9 @@ ACT_STATUS ActCore::OpcUaStartConfigFirmwareUpgrade(qint64 &project_id, QList<qi
     return act_status;
   }
 
+  // The device state is changed outside the deploy, the next deploy pushes all its tables again
+  this->RemoveDeployedDeviceConfig(project_id, dev_id_list);
+
   // Create a std::promise object
   std::shared_ptr<std::promise<void>> signal_sender = std::make_shared<std::promise<void>>();
 
@@ -1665,7 +1694,8 @@ ACT_STATUS ActCore::OpcUaStartConfigFirmwareUpgrade(qint64 &project_id, QList<qi
 }
 
 void ActCore::StartConfigFirmwareUpgradeThread(const qint64 &ws_listener_id, std::future<void> signal_receiver,
-                                               qint64 project_id, QList<qint64> dev_id_list, QString firmware_name) {
+                                               qint64 project_id, QList<qint64> dev_id_list, QString firmware_name,
+                                               ActFirmwareRolloutSetting rollout_setting) {
   ACT_STATUS_INIT();
 
   // Waiting for caller thread
@@ -1700,6 +1730,7 @@ void ActCore::StartConfigFirmwareUpgradeThread(const qint64 &ws_listener_id, std
   ActProfiles profiles(this->GetFeatureProfileSet(), this->GetFirmwareFeatureProfileSet(), this->GetDeviceProfileSet(),
                        this->GetDefaultDeviceProfileSet());
   ActDeviceConfiguration device_configuration(profiles);
+  device_configuration.SetFirmwareRolloutSetting(rollout_setting);
   QString file_path = QString("%1/%2").arg(ACT_FIRMWARE_FILE_FOLDER).arg(firmware_name);
   act_status = device_configuration.StartFirmwareUpgrade(project, dev_id_list, file_path);
 
@@ -1764,7 +1795,8 @@ void ActCore::StartConfigFirmwareUpgradeThread(const qint64 &ws_listener_id, std
 }
 
 ACT_STATUS ActCore::StartConfigFirmwareUpgrade(qint64 &project_id, const qint64 &ws_listener_id,
-                                               QList<qint64> &dev_id_list, QString &firmware_name) {
+                                               QList<qint64> &dev_id_list, QString &firmware_name,
+                                               const ActFirmwareRolloutSetting &rollout_setting) {
   ACT_STATUS_INIT();
 
   this->InitNotificationTmp();
@@ -1792,6 +1824,9 @@ ACT_STATUS ActCore::StartConfigFirmwareUpgrade(qint64 &project_id, const qint64
     return act_status;
   }
 
+  // The device state is changed outside the deploy, the next deploy pushes all its tables again
+  this->RemoveDeployedDeviceConfig(project_id, dev_id_list);
+
   // Create a std::promise object
   std::shared_ptr<std::promise<void>> signal_sender = std::make_shared<std::promise<void>>();
 
@@ -1802,7 +1837,7 @@ ACT_STATUS ActCore::StartConfigFirmwareUpgrade(qint64 &project_id, const qint64
   std::shared_ptr<std::thread> thread_ptr;
   thread_ptr = std::make_shared<std::thread>(&act::core::ActCore::StartConfigFirmwareUpgradeThread, this,
                                              std::cref(ws_listener_id), std::move(signal_receiver), project_id,
-                                             dev_id_list, firmware_name);
+                                             dev_id_list, firmware_name, rollout_setting);
 
 #ifdef _WIN32
   // Set the thread name
@@ -2138,6 +2173,9 @@ ACT_STATUS ActCore::StartDeviceConfigCommission(qint64 &project_id, const qint64
     return act_status;
   }
 
+  // The device state is changed outside the deploy, the next deploy pushes all its tables again
+  this->RemoveDeployedDeviceConfig(project_id, dev_id_list);
+
   // Create a std::promise object
   std::shared_ptr<std::promise<void>> signal_sender = std::make_shared<std::promise<void>>();
 
@@ -2265,6 +2303,9 @@ ACT_STATUS ActCore::StartDeviceCommandLine(qint64 &project_id, const qint64 &ws_
     return act_status;
   }
 
+  // The device state is changed outside the deploy, the next deploy pushes all its tables again
+  this->RemoveDeployedDeviceConfig(project_id, dev_id_list);
+
   // Create a std::promise object
   std::shared_ptr<std::promise<void>> signal_sender = std::make_shared<std::promise<void>>();
 
@@ -239,16 +239,14 @@ ACT_STATUS ActCore::GenerateDeviceIniConfigFile(const ActProject &project, const
     if (IsActStatusNotFound(act_status)) {
       return act_status;
     }
+  }
 
-    QString file_id;
-    act_status = act::offline_config::GenerateOfflineConfig(project, dev_id, file_id);
-    if (!IsActStatusSuccess(act_status)) {
-      qCritical() << __func__
-                  << QString("GenerateOfflineConfig() failed. Device(%1).").arg(dev.GetIpv4().GetIpAddress());
-
-      return act_status;
-    }
-    device_offline_config_file_map.GetDeviceOfflineConfigFileMap()[dev_id] = file_id;
+  // Generate the devices at once
+  act_status = act::offline_config::GenerateOfflineConfigs(
+      project, dev_id_list, device_offline_config_file_map.GetDeviceOfflineConfigFileMap());
+  if (!IsActStatusSuccess(act_status)) {
+    qCritical() << __func__ << "GenerateOfflineConfigs() failed.";
+    return act_status;
   }
 
   return act_status;
@@ -818,7 +818,7 @@ ACT_STATUS ActCore::ExportDeviceBackupFile(qint64 &project_id, ActDeviceBackupFi
   */
   QString deviceConfigFilePath = GetDeviceConfigFilePath();
   QString zip_file_path(QString("%1/%2").arg(deviceConfigFilePath).arg(zip_file_name));
-  act_status = this->CompressFolder(deviceConfigFilePath, zip_file_path);
+  act_status = this->CompressFolder(deviceConfigFilePath, zip_file_path, ACT_ZIP_DEFLATE_THREADS);
   // kene-
   if (!IsActStatusSuccess(act_status)) {
     qCritical() << "Compress folder failed:" << act_status->GetErrorMessage().toStdString().c_str();
@@ -2,6 +2,7 @@
 
 #include "act_core.hpp"
 #include "act_db.hpp"
+#include "act_probe_cache.hpp"
 
 namespace act {
 namespace core {
@@ -41,6 +42,9 @@ ACT_STATUS ActCore::InitFeatureProfiles() {
 
   this->SetFeatureProfileSet(feature_profile_set);
   this->last_assigned_feature_profile_id_ = last_assigned_feature_profile_id;
+
+  // The cached probe results depend on the FeatureProfiles
+  act::auto_probe::g_act_probe_cache.Clear();
   return act_status;
 }
 
@@ -3,7 +3,7 @@
 #define SLEEP_MS(ms) Sleep(ms)
 #else
 #include <unistd.h>  // for sleep
-#define SLEEP_MS(ms) sleep(ms / 1000)
+#define SLEEP_MS(ms) usleep((ms) * 1000)
 #endif
 
 #include <QSet>
@@ -308,6 +308,9 @@ ACT_STATUS ActCore::StartImportDeviceConfig(qint64 &project_id, const qint64 &ws
     return act_status;
   }
 
+  // The device state is changed outside the deploy, the next deploy pushes all its tables again
+  this->RemoveDeployedDeviceConfig(project_id, dev_id_list);
+
   // Create a std::promise object
   std::shared_ptr<std::promise<void>> signal_sender = std::make_shared<std::promise<void>>();
 
@@ -554,6 +557,9 @@ ACT_STATUS ActCore::OpcUaStartImportDeviceConfig(qint64 &project_id, QList<qint6
     return act_status;
   }
 
+  // The device state is changed outside the deploy, the next deploy pushes all its tables again
+  this->RemoveDeployedDeviceConfig(project_id, dev_id_list);
+
   // Create a std::promise object
   std::shared_ptr<std::promise<void>> signal_sender = std::make_shared<std::promise<void>>();
 
@@ -1,3 +1,4 @@
+#include <QDateTime>
 #include <QSet>
 
 #include "act_core.hpp"
@@ -36,43 +37,21 @@ QString __GenerateToken(quint64 hard_timeout) {
   return new_token;
 }
 
+ActSession __MakeSession(qint64 user_id, ActRoleEnum role, quint64 hard_timeout) {
+  const qint64 expiry = QDateTime::currentMSecsSinceEpoch() + static_cast<qint64>(hard_timeout) * 60 * 1000;
+  return ActSession{user_id, role, expiry};
+}
+
 ACT_STATUS ActCore::VerifyToken(QString token, ActRoleEnum &role) {
   ACT_STATUS_INIT();
 
-  QMutexLocker lock(&this->mutex_);
-
-  // Iterator of the set
-  typename QMap<QString, qint64>::const_iterator iterator;
-  iterator = this->tokens_.find(token);
-
-  bool found = false;
-  qint64 user_id;
-  // Check find result
-  if (iterator != this->tokens_.end()) {
-    found = true;
-    user_id = iterator.value();
-
-    ActUser user;
-    act_status = this->GetUser(user_id, user);
-    if (!IsActStatusSuccess(act_status)) {
-      qCritical() << __func__ << "User not found:" << user_id;
-      return std::make_shared<ActStatusNotFound>("User");
-    }
-
-    role = user.GetRole();
-  }
-
-  if (!found) {
-    // qDebug() << "token not found:" << token;
-    // qDebug() << "tokens:";
-    // QMap<QString, qint64>::const_iterator i = this->tokens_.constBegin();
-    // while (i != this->tokens_.constEnd()) {
-    //   qDebug() << i.key() << ":" << i.value();
-    //   ++i;
-    // }
+  // The session keeps the role, the user set & the core mutex are not needed
+  ActSession session;
+  if (!this->sessions_.Find(token, QDateTime::currentMSecsSinceEpoch(), session)) {
     return std::make_shared<ActStatusNotFound>("Token");
   }
 
+  role = session.role;
   return act_status;
 }
 
@@ -106,9 +85,10 @@ ACT_STATUS ActCore::Login(ActUser &user, QString &token) {
   //   return std::make_shared<ActBadRequest>(error_msg);
   // }
 
-  token = __GenerateToken(this->GetSystemConfig().GetHardTimeout());
+  const quint64 hard_timeout = this->GetSystemConfig().GetHardTimeout();
+  token = __GenerateToken(hard_timeout);
 
-  this->tokens_[token] = user_id;
+  this->sessions_.Insert(token, __MakeSession(user_id, user.GetRole(), hard_timeout));
   // qDebug() << "Allocate token:" << token;
   return act_status;
 }
@@ -132,36 +112,21 @@ ACT_STATUS ActCore::RenewToken(const QString &orig_token, QString &new_token, Ac
   ACT_STATUS_INIT();
   QMutexLocker lock(&this->mutex_);
 
-  typename QMap<QString, qint64>::const_iterator iterator;
-  iterator = this->tokens_.find(orig_token);
-
-  bool found = false;
-  // Check find result
-  if (iterator != this->tokens_.end()) {
-    found = true;
-    qint64 user_id = iterator.value();
-
-    act_status = this->GetUser(user_id, user);
-    if (!IsActStatusSuccess(act_status)) {
-      qCritical() << __func__ << "User not found:" << user_id;
-      return std::make_shared<ActStatusNotFound>("User");
-    }
-  }
-
   // ! It should be passed because the VerifyToken() API is called before
-  if (!found) {
+  ActSession session;
+  if (!this->sessions_.Find(orig_token, QDateTime::currentMSecsSinceEpoch(), session)) {
     qDebug() << "token not found:" << orig_token;
-    qDebug() << "tokens:";
-    QMap<QString, qint64>::const_iterator i = this->tokens_.constBegin();
-    while (i != this->tokens_.constEnd()) {
-      qDebug() << i.key() << ":" << i.value();
-      ++i;
-    }
-
     return std::make_shared<ActStatusNotFound>("Token");
   }
 
-  new_token = __GenerateToken(this->GetSystemConfig().GetHardTimeout());
+  act_status = this->GetUser(session.user_id, user);
+  if (!IsActStatusSuccess(act_status)) {
+    qCritical() << __func__ << "User not found:" << session.user_id;
+    return std::make_shared<ActStatusNotFound>("User");
+  }
+
+  const quint64 hard_timeout = this->GetSystemConfig().GetHardTimeout();
+  new_token = __GenerateToken(hard_timeout);
   // const auto iss_time = std::chrono::system_clock::now();
   // const auto exp_time = iss_time + std::chrono::seconds{this->GetSystemConfig().GetHardTimeout()};
 
@@ -175,8 +140,8 @@ ACT_STATUS ActCore::RenewToken(const QString &orig_token, QString &new_token, Ac
   //                 .sign(jwt::algorithm::hs256{ACT_TOKEN_SECRET})
   //                 .c_str();
 
-  this->tokens_.remove(orig_token);
-  this->tokens_[new_token] = user.GetId();
+  this->sessions_.Remove(orig_token);
+  this->sessions_.Insert(new_token, __MakeSession(user.GetId(), user.GetRole(), hard_timeout));
   // qDebug() << "orig token:" << orig_token;
   // qDebug() << "new token:" << new_token;
   return act_status;
@@ -184,82 +149,32 @@ ACT_STATUS ActCore::RenewToken(const QString &orig_token, QString &new_token, Ac
 
 ACT_STATUS ActCore::Logout(const QString &token) {
   ACT_STATUS_INIT();
-  QMutexLocker lock(&this->mutex_);
-  this->tokens_.remove(token);
+  this->sessions_.Remove(token);
   return act_status;
 }
 
 ACT_STATUS ActCore::CheckTokenHardTimeout() {
   ACT_STATUS_INIT();
 
-  QMutexLocker lock(&this->mutex_);
-
-  QMap<QString, qint64> &token_map = this->tokens_;
-
-  const char *actAppName = GetActAppName().toStdString().c_str();
-
-  // Iterator of the set
-  for (QMap<QString, qint64>::iterator token_iterator = token_map.begin(); token_iterator != token_map.end();) {
-    QString token = token_iterator.key();
-    qint64 user_id = token_iterator.value();
-
-    auto decoded = jwt::decode(token.toStdString());
-    auto verifier = jwt::verify().allow_algorithm(jwt::algorithm::hs256{ACT_TOKEN_SECRET}).with_issuer(actAppName);
-
-    bool expired = false;
-
-    try {
-      verifier.verify(decoded);
-    } catch (const std::exception &exc) {
-      // Remove this token here
-      qDebug() << "Token expired:" << token << exc.what();
-
-      token_map.erase(token_iterator++);
-      expired = true;
-    }
-
-    // [feat:1248] The login user should be logout after password change
-    if (this->user_password_changed_.contains(user_id)) {
-      qDebug() << "User id:" << QString::number(user_id) << ": Token expired due to password change:" << token;
-      token_map.erase(token_iterator++);
-      this->user_password_changed_.remove(user_id);
-      expired = true;
-    }
-
-    if (!expired) {
-      token_iterator++;
-    }
+  // The sessions expire with their tokens, only the expired ones are visited
+  qint32 removed = this->sessions_.RemoveExpired(QDateTime::currentMSecsSinceEpoch());
+  if (removed > 0) {
+    qDebug() << "Tokens expired:" << removed;
   }
 
-  this->tokens_ = token_map;
   return act_status;
 }
 
 ACT_STATUS ActCore::GetUserIdByToken(const QString &token, qint64 &user_id) {
   ACT_STATUS_INIT();
 
-  typename QMap<QString, qint64>::const_iterator iterator;
-  iterator = this->tokens_.find(token);
-
-  bool found = false;
-  // Check find result
-  if (iterator != this->tokens_.end()) {
-    found = true;
-    user_id = iterator.value();
-  }
-
-  if (!found) {
+  ActSession session;
+  if (!this->sessions_.Find(token, QDateTime::currentMSecsSinceEpoch(), session)) {
     qDebug() << "token not found:" << token;
-    qDebug() << "tokens:";
-    QMap<QString, qint64>::const_iterator i = this->tokens_.constBegin();
-    while (i != this->tokens_.constEnd()) {
-      qDebug() << i.key() << ":" << i.value();
-      ++i;
-    }
-
     return std::make_shared<ActStatusNotFound>("Token");
   }
 
+  user_id = session.user_id;
   return act_status;
 }
 
@@ -270,12 +185,12 @@ ACT_STATUS ActCore::CheckCLITokenExist(ActUser &user, QString &token) {
     return std::make_shared<ActStatusNotFound>("Token");
   }
 
-  if (!this->tokens_.contains(this->cli_token)) {
+  ActSession session;
+  if (!this->sessions_.Find(this->cli_token, QDateTime::currentMSecsSinceEpoch(), session)) {
     return std::make_shared<ActStatusNotFound>("Token");
   }
 
-  qint64 user_id = this->tokens_[this->cli_token];
-  act_status = act::core::g_core.GetUser(user_id, user);
+  act_status = act::core::g_core.GetUser(session.user_id, user);
   if (!IsActStatusSuccess(act_status)) {
     return act_status;
   }
@@ -3,7 +3,7 @@
 #define SLEEP_MS(ms) Sleep(ms)
 #else
 #include <unistd.h>  // for sleep
-#define SLEEP_MS(ms) sleep(ms / 1000)
+#define SLEEP_MS(ms) usleep((ms) * 1000)
 #endif
 
 #include <QSet>
@@ -439,6 +439,9 @@ ACT_STATUS ActCore::StartManufactureDeployIni(qint64 &project_id, const qint64 &
     return act_status;
   }
 
+  // The device state is changed outside the deploy, the next deploy pushes all the tables again
+  this->RemoveDeployedDeviceConfig(project_id, QList<qint64>());
+
   // Create a std::promise object
   std::shared_ptr<std::promise<void>> signal_sender = std::make_shared<std::promise<void>>();
 
@@ -3,7 +3,7 @@
 #define SLEEP_MS(ms) Sleep(ms)
 #else
 #include <unistd.h>  // for sleep
-#define SLEEP_MS(ms) sleep(ms / 1000)
+#define SLEEP_MS(ms) usleep((ms) * 1000)
 #endif
 
 #include <QHostInfo>
@@ -42,17 +42,18 @@ void ActCore::StartMonitorThread(const qint64 &ws_listener_id, std::future<void>
   // Waiting for caller thread
   std::this_thread::yield();
 
-  quint64 last_time = 0;
-  quint64 polling_interval_ms;
-  quint64 last_heartbeat_time = 0;
+  qint64 last_refresh_time = 0;
   QSet<ActDevice> baseline_device_set;
-  QSet<ActDevice> monitor_device_set;
-  QList<ActScanIpRangeEntry> scan_ip_range_list;
-  bool from_scan_list;
-  bool from_offline;
-  qint64 monitor_project_id;
+  QList<QString> host_ip_list;
+  QHash<QString, ActPingJob> ping_targets;      // <ip, ping job>
+  QHash<QString, ActDevice> heartbeat_targets;  // <device id, device>
+  qint64 monitor_project_id = project_id;
   const int batch_size = 10;
 
+  // Each target keeps its own next-due time, the ping results are reported by HandlePingResult()
+  auto ping_scheduler = std::make_shared<ActMonitorPollScheduler>(ACT_MONITOR_POLL_TICK);
+  ActMonitorPollScheduler heartbeat_scheduler(30000);
+
   this->fake_monitor_mode_ = command.GetFakeMode();
 
   // Init the operation project
@@ -116,134 +117,125 @@ void ActCore::StartMonitorThread(const qint64 &ws_listener_id, std::future<void>
 
   this->project_status_list[project_id] = ActProjectStatusEnum::kMonitoring;
 
+  {
+    QMutexLocker lock(&monitor_mutex_);
+    monitor_ping_scheduler_ = ping_scheduler;
+  }
+
   // Reference: https://thispointer.com/c11-how-to-stop-or-terminate-a-thread/
   while (signal_receiver.wait_for(std::chrono::seconds(1)) == std::future_status::timeout) {
-    // Get ping interval from project setting
+    qint64 current_time = QDateTime::currentMSecsSinceEpoch();
 
-    // Fetch the host IP of this computer and skip
-    QList<QHostAddress> all_addresses = QNetworkInterface::allAddresses();
-    QList<QString> host_ip_list;
+    // Refresh the poll targets periodically instead of every tick
+    if (current_time - last_refresh_time >= ACT_MONITOR_POLL_REFRESH_INTERVAL) {
+      last_refresh_time = current_time;
 
-    for (const QHostAddress &address : all_addresses) {
-      if (address.protocol() == QAbstractSocket::IPv4Protocol && address != QHostAddress::LocalHost) {
-        host_ip_list.append(address.toString());
+      // Fetch the host IP of this computer and skip
+      host_ip_list.clear();
+      for (const QHostAddress &address : QNetworkInterface::allAddresses()) {
+        if (address.protocol() == QAbstractSocket::IPv4Protocol && address != QHostAddress::LocalHost) {
+          host_ip_list.append(address.toString());
+        }
       }
-    }
-
-    // Update the operation project setting
-    monitor_mutex_.lock();
-    monitor_project_id = monitor_project_.GetId();
-    polling_interval_ms = monitor_project_.GetProjectSetting().GetMonitorConfiguration().GetPollingInterval() * 1000;
-    scan_ip_range_list = monitor_project_.GetProjectSetting().GetScanIpRanges();
-    from_scan_list = monitor_project_.GetProjectSetting().GetMonitorConfiguration().GetFromIpScanList();
-    from_offline = monitor_project_.GetProjectSetting().GetMonitorConfiguration().GetFromOfflineProject();
-    monitor_device_set = monitor_project_.GetDevices();
 
-    qint64 current_time = QDateTime::currentMSecsSinceEpoch();
+      // Update the operation project setting
+      QMutexLocker lock(&monitor_mutex_);
+      monitor_project_id = monitor_project_.GetId();
+      const ActMonitorConfiguration &monitor_config = monitor_project_.GetProjectSetting().GetMonitorConfiguration();
+      ping_scheduler->SetInterval(monitor_config.GetPollingInterval() * 1000);
+
+      // The baseline devices, the operation devices and the scan IP ranges, the first one wins for the same IP
+      ping_targets.clear();
+      for (ActDevice device : baseline_device_set) {
+        ActPingJob ping_job(device);
+        ping_job.SetIp(device.GetIpv4().GetIpAddress());
+        ping_targets.insert(ping_job.GetIp(), ping_job);
+      }
 
-    // Add this block to execute a new task every 30 seconds
-    if (current_time - last_heartbeat_time >= 30000) {
-      last_heartbeat_time = current_time;
+      heartbeat_targets.clear();
+      for (ActDevice device : monitor_project_.GetDevices()) {
+        heartbeat_targets.insert(QString::number(device.GetId()), device);
+        if (!ping_targets.contains(device.GetIpv4().GetIpAddress())) {
+          ActPingJob ping_job(device);
+          ping_job.SetIp(device.GetIpv4().GetIpAddress());
+          ping_targets.insert(ping_job.GetIp(), ping_job);
+        }
+      }
 
-      QList<ActJob> job_list;
-      QList<ActHeartbeatJob> heartbeat_job_list;
-      for (ActDevice device : monitor_device_set) {
-        if (g_monitor_device_status.contains(device.GetId()) && !g_monitor_device_status[device.GetId()].GetAlive()) {
-          continue;
+      // Translate the scan_ip_range to ping entry and add to the ping list
+      if (monitor_config.GetFromIpScanList()) {
+        for (ActScanIpRangeEntry scan_ip_range : monitor_project_.GetProjectSetting().GetScanIpRanges()) {
+          // In the scan ip range, foreach ip address, add to the ping list
+          // From start_ip to end_ip
+          quint32 start_ip_num = 0;
+          ActIpv4::AddressStrToNumber(scan_ip_range.GetStartIp(), start_ip_num);
+          quint32 end_ip_num = 0;
+          ActIpv4::AddressStrToNumber(scan_ip_range.GetEndIp(), end_ip_num);
+
+          for (quint32 ip_num = start_ip_num; ip_num <= end_ip_num; ip_num++) {
+            QString ip_str;
+            ActIpv4::AddressNumberToStr(ip_num, ip_str);
+            if (!ping_targets.contains(ip_str)) {
+              // Copy the connection parameters from the scan ip range to the ping job
+              ActPingJob ping_job(scan_ip_range);
+              ping_job.SetIp(ip_str);
+              ping_targets.insert(ip_str, ping_job);
+            }
+          }
         }
-        ActHeartbeatJob heartbeat_job(device);
-        heartbeat_job_list.push_back(heartbeat_job);
       }
 
-      ActJob job;
-      job.AssignJob<QList<ActHeartbeatJob>>(monitor_project_id, ActJobTypeEnum::kMultipleHeartbeat, heartbeat_job_list);
-      job_list.push_back(job);
-      this->DistributeWorkerJobs(job_list);
-    }
+      for (const QString &host_ip : host_ip_list) {
+        ping_targets.remove(host_ip);
+      }
 
-    if (current_time - last_time < polling_interval_ms) {
-      SLEEP_MS(1000);
-      monitor_mutex_.unlock();
-      continue;
-    }
+      QSet<QString> ping_keys;
+      for (auto it = ping_targets.cbegin(); it != ping_targets.cend(); ++it) {
+        ping_keys.insert(it.key());
+      }
+      ping_scheduler->Sync(ping_keys, current_time);
 
-    last_time = current_time;
+      QSet<QString> heartbeat_keys;
+      for (auto it = heartbeat_targets.cbegin(); it != heartbeat_targets.cend(); ++it) {
+        heartbeat_keys.insert(it.key());
+      }
+      heartbeat_scheduler.Sync(heartbeat_keys, current_time);
+    }
 
     QList<ActJob> job_list;
-    QList<ActPingJob> ping_job_list;
 
-    // Add the baseline device to ping list
-    for (ActDevice device : baseline_device_set) {
-      if (host_ip_list.contains(device.GetIpv4().GetIpAddress())) {
-        continue;
-      }
-
-      // Skip the device if the device has already been pinged
-      QMutexLocker locker(&g_busy_device_set_mutex);
-      if (g_busy_device_set.contains(device.GetIpv4().GetIpAddress())) {
-        continue;
+    // Keep the RESTful connection of the alive devices, each device every 30 seconds
+    QList<ActHeartbeatJob> heartbeat_job_list;
+    {
+      QMutexLocker lock(&monitor_mutex_);
+      for (const QString &key : heartbeat_scheduler.Due(current_time)) {
+        const ActDevice &device = heartbeat_targets[key];
+        if (g_monitor_device_status.contains(device.GetId()) && !g_monitor_device_status[device.GetId()].GetAlive()) {
+          continue;
+        }
+        heartbeat_job_list.push_back(ActHeartbeatJob(device));
       }
-
-      ActPingJob ping_job(device);
-      ping_job.SetIp(device.GetIpv4().GetIpAddress());
-      ping_job_list.push_back(ping_job);
-      g_busy_device_set.insert(device.GetIpv4().GetIpAddress());
     }
 
-    // Add the operation device to ping list
-    for (ActDevice device : monitor_device_set) {
-      if (host_ip_list.contains(device.GetIpv4().GetIpAddress())) {
-        continue;
-      }
+    if (!heartbeat_job_list.isEmpty()) {
+      ActJob job;
+      job.AssignJob<QList<ActHeartbeatJob>>(monitor_project_id, ActJobTypeEnum::kMultipleHeartbeat, heartbeat_job_list);
+      job_list.push_back(job);
+    }
 
-      // Skip the device if the device has already been pinged
+    // Ping the due targets, the busy ones are retried at the next tick
+    QList<ActPingJob> ping_job_list;
+    for (const QString &ip : ping_scheduler->Due(current_time)) {
       QMutexLocker locker(&g_busy_device_set_mutex);
-      if (g_busy_device_set.contains(device.GetIpv4().GetIpAddress())) {
+      if (g_busy_device_set.contains(ip)) {
+        ping_scheduler->Defer(ip, current_time);
         continue;
       }
 
-      ActPingJob ping_job(device);
-      ping_job.SetIp(device.GetIpv4().GetIpAddress());
-      ping_job_list.push_back(ping_job);
-      g_busy_device_set.insert(device.GetIpv4().GetIpAddress());
+      ping_job_list.push_back(ping_targets[ip]);
+      g_busy_device_set.insert(ip);
     }
 
-    // Translate the scan_ip_range to ping entry and add to the ping list
-    if (from_scan_list) {
-      for (ActScanIpRangeEntry scan_ip_range : scan_ip_range_list) {
-        // In the scan ip range, foreach ip address, add to the ping list
-        // From start_ip to end_ip
-        quint32 start_ip_num = 0;
-        ActIpv4::AddressStrToNumber(scan_ip_range.GetStartIp(), start_ip_num);
-        quint32 end_ip_num = 0;
-        ActIpv4::AddressStrToNumber(scan_ip_range.GetEndIp(), end_ip_num);
-
-        for (quint32 ip_num = start_ip_num; ip_num <= end_ip_num; ip_num++) {
-          // Copy the connection parameters from the scan ip range to the ping job
-          ActPingJob ping_job(scan_ip_range);
-
-          QString ip_str;
-          ActIpv4::AddressNumberToStr(ip_num, ip_str);
-          ping_job.SetIp(ip_str);
-
-          if (host_ip_list.contains(ip_str)) {
-            continue;
-          }
-
-          QMutexLocker locker(&g_busy_device_set_mutex);
-          if (g_busy_device_set.contains(ip_str)) {
-            // Skip the device if the device has already been pinged
-            continue;
-          }
-
-          ping_job_list.push_back(ping_job);
-          g_busy_device_set.insert(ip_str);
-        }
-      }
-    }
-
-    monitor_mutex_.unlock();
-
     for (int i = 0; i < ping_job_list.size(); i += batch_size) {
       QList<ActPingJob> batch = ping_job_list.mid(i, batch_size);
       ActJob job;
@@ -251,7 +243,14 @@ void ActCore::StartMonitorThread(const qint64 &ws_listener_id, std::future<void>
       job_list.push_back(job);
     }
 
-    this->DistributeWorkerJobs(job_list);
+    if (!job_list.isEmpty()) {
+      this->DistributeWorkerJobs(job_list);
+    }
+  }
+
+  {
+    QMutexLocker lock(&monitor_mutex_);
+    monitor_ping_scheduler_.reset();
   }
 
   qDebug() << monitor_project_.GetProjectName() << "Thread is going to close";
@@ -341,6 +340,7 @@ ACT_STATUS ActCore::StopMonitor(qint64 project_id, const qint64 ws_listener_id,
   }
 
   monitor_project_ = ActProject();
+  this->BumpVlanViewRevision(project_id);
 
   return act_status;
 }
@@ -4,15 +4,17 @@
 #define SLEEP_MS(ms) Sleep(ms)
 #else
 #include <unistd.h>  // for sleep
-#define SLEEP_MS(ms) sleep(ms / 1000)
+#define SLEEP_MS(ms) usleep((ms) * 1000)
 #endif
 
+#include <QEventLoop>
 #include <QQueue>
 #include <algorithm>  // for std::min
 
 #include "act_core.hpp"
 #include "act_monitor.hpp"
 #include "act_mqtt_client.hpp"
+#include "act_mqtt_event_queue.hpp"
 
 namespace act {
 namespace core {  // namespace core
@@ -61,9 +63,14 @@ void ActCore::DistributeMonitorData(ActMonitorData &data) {
 }
 
 void ActCore::HandlePortLinkEvent(const ActMqttEventTopicEnum topic, const ActMqttMessage &message,
-                                  bool sync_to_websocket, bool send_tmp) {
+                                  bool sync_to_websocket, bool send_tmp, bool notify) {
   ACT_STATUS_INIT();
 
+  if (message.Getvariables().isEmpty()) {
+    qCritical() << __func__ << "No port in the message from IP:" << message.GetsourceIp();
+    return;
+  }
+
   // Get the related device & link
   ActDevice device;
   act_status = monitor_project_.GetDeviceByIp(message.GetsourceIp(), device);
@@ -74,6 +81,11 @@ void ActCore::HandlePortLinkEvent(const ActMqttEventTopicEnum topic, const ActMq
 
   const qint64 &port_id = message.Getvariables()[0].toLongLong();
 
+  // Poll the device at once to refresh its status
+  if (monitor_ping_scheduler_ != nullptr) {
+    monitor_ping_scheduler_->Expedite(device.GetIpv4().GetIpAddress(), QDateTime::currentMSecsSinceEpoch());
+  }
+
   // QMutexLocker locker(&job_queue_mutex_);
   // job_queue_.clear();
 
@@ -124,7 +136,7 @@ void ActCore::HandlePortLinkEvent(const ActMqttEventTopicEnum topic, const ActMq
   }
 
   // Notify the user that the link status immediately
-  if (!g_link_status_ws_data_set.isEmpty()) {
+  if (notify && !g_link_status_ws_data_set.isEmpty()) {
     ActMonitorLinkMsg link_msg(ActPatchUpdateActionEnum::kUpdate, monitor_project_.GetId(), g_link_status_ws_data_set,
                                sync_to_websocket);
 
@@ -149,36 +161,90 @@ void ActCore::HandlePortLinkEvent(const ActMqttEventTopicEnum topic, const ActMq
 }
 
 ACT_STATUS ActCore::HandleTrapMessage(ActMqttMessage &message, bool sync_to_websocket, bool send_tmp) {
+  QList<ActMqttMessage> messages({message});
+  return this->HandleTrapMessages(messages, sync_to_websocket, send_tmp);
+}
+
+ACT_STATUS ActCore::HandleTrapMessages(QList<ActMqttMessage> &messages, bool sync_to_websocket, bool send_tmp) {
   ACT_STATUS_INIT();
 
   QMutexLocker lock(&this->monitor_mutex_);
 
-  qDebug() << "Trap message:" << message.ToString().toStdString().c_str();
+  qDebug() << "Trap messages:" << messages.size();
 
-  // transfer code w/ qint64 format to ActMqttEventTopicEnum
-  ActMqttEventTopicEnum topic = static_cast<ActMqttEventTopicEnum>(message.Getcode());
+  for (const ActMqttMessage &message : messages) {
+    // transfer code w/ qint64 format to ActMqttEventTopicEnum
+    ActMqttEventTopicEnum topic = static_cast<ActMqttEventTopicEnum>(message.Getcode());
 
-  switch (topic) {
-    case ActMqttEventTopicEnum::kPortLinkDown: {
-      HandlePortLinkEvent(topic, message, sync_to_websocket, send_tmp);
-      break;
-    }
-    case ActMqttEventTopicEnum::kPortLinkUp: {
-      HandlePortLinkEvent(topic, message, sync_to_websocket, send_tmp);
-      break;
+    switch (topic) {
+      case ActMqttEventTopicEnum::kPortLinkDown: {
+        HandlePortLinkEvent(topic, message, sync_to_websocket, send_tmp, false);
+        break;
+      }
+      case ActMqttEventTopicEnum::kPortLinkUp: {
+        HandlePortLinkEvent(topic, message, sync_to_websocket, send_tmp, false);
+        break;
+      }
+      default:
+        break;
     }
-    default:
-      break;
+  }
+
+  // Notify the user of the link status once per batch
+  if (!g_link_status_ws_data_set.isEmpty()) {
+    ActMonitorLinkMsg link_msg(ActPatchUpdateActionEnum::kUpdate, monitor_project_.GetId(), g_link_status_ws_data_set,
+                               sync_to_websocket);
+    this->SendMessageToListener(ActWSTypeEnum::kProject, send_tmp, link_msg, monitor_project_.GetId());
+    g_link_status_ws_data_set.clear();
   }
 
   return act_status;
 }
 
+void ActCore::MqttClientThread(std::shared_ptr<ActMqttEventQueue> event_queue) {
+  // The client lives in this thread, its signals are handled by the local event loop
+  QEventLoop event_loop;
+  ActMqttClient mqtt_client;
+  mqtt_client.setEventQueue(event_queue);
+
+  bool connected = false;
+  qint64 last_connect_time = 0;
+  QObject::connect(&mqtt_client, &ActMqttClient::connectionStatusChanged, [&mqtt_client, &connected](bool status) {
+    connected = status;
+    if (connected) {
+      mqtt_client.subscribeToTopic(ActMqttEventTopicEnum::kPortLinkDown);
+      mqtt_client.subscribeToTopic(ActMqttEventTopicEnum::kPortLinkUp);
+    }
+  });
+
+  while (this->GetSystemStatus() == ActSystemStatusEnum::kMonitoring) {
+    // Reconnect to the broker per retry interval
+    qint64 current_time = QDateTime::currentMSecsSinceEpoch();
+    if (!connected && current_time - last_connect_time >= ACT_MQTT_RECONNECT_INTERVAL) {
+      last_connect_time = current_time;
+      mqtt_client.connectToBroker();
+    }
+
+    event_loop.processEvents(QEventLoop::AllEvents);
+    SLEEP_MS(10);
+  }
+
+  mqtt_client.disconnectFromBroker();
+  event_loop.processEvents(QEventLoop::AllEvents);
+  qDebug() << "mqtt client thread finish...";
+}
+
 ACT_STATUS ActCore::HandlePingResult(ActPingDevice &ping_device, bool sync_to_websocket, bool send_tmp) {
   ACT_STATUS_INIT();
 
   QMutexLocker lock(&this->monitor_mutex_);
 
+  // Back off the unreachable target or speed up after its state changes
+  if (monitor_ping_scheduler_ != nullptr) {
+    monitor_ping_scheduler_->Report(ping_device.GetIpAddress(), ping_device.GetAlive(),
+                                    QDateTime::currentMSecsSinceEpoch());
+  }
+
   if (ping_device.GetAlive()) {
     ActDevice identify_device;
     act_status = monitor_project_.GetDeviceById(identify_device, ping_device.GetId());
@@ -252,6 +318,9 @@ ACT_STATUS ActCore::HandlePingResult(ActPingDevice &ping_device, bool sync_to_we
       device_status.SetAlive(false);
       g_monitor_device_status[device.GetId()] = device_status;
 
+      // The device may be reset or replaced while it is offline, the next deploy pushes all its tables again
+      this->RemoveDeployedDeviceConfig(monitor_project_.GetId(), QList<qint64>({device.GetId()}));
+
       // Find out the related link and notify the user the link is not alive
       QSet<ActLink> link_set = monitor_project_.GetLinks();
       for (ActLink link : link_set) {
@@ -487,9 +556,30 @@ ACT_STATUS ActCore::HandleBasicStatusResult(ActMonitorBasicStatus &device_basic_
 
   g_monitor_basic_status[device.GetId()] = device_basic_status;
 
+  // Keep the history of the system utilization
+  const qint64 timestamp = QDateTime::currentMSecsSinceEpoch();
+  AppendMonitorTimeSeries(QString("device/%1/cpu-usage").arg(device.GetId()), timestamp,
+                          device_basic_status.GetSystemUtilization().GetCPUUsage());
+  AppendMonitorTimeSeries(QString("device/%1/memory-usage").arg(device.GetId()), timestamp,
+                          device_basic_status.GetSystemUtilization().GetMemoryUsage());
+
   // Save the fiber check status
   for (ActMonitorFiberCheckEntry &entry : device_basic_status.GetFiberCheck()) {
     monitor_project_.fiber_check_entries_.insert(entry);
+
+    // Keep the history of the SFP (the values are reported as text, skip the ones not reported)
+    const QMap<QString, QString> sfp_values = {{"sfp-temperature", entry.GetTemperatureC()},
+                                               {"sfp-tx-power", entry.GetTxPower()},
+                                               {"sfp-rx-power", entry.GetRxPower()}};
+    for (auto sfp_it = sfp_values.constBegin(); entry.GetExist() && (sfp_it != sfp_values.constEnd()); sfp_it++) {
+      bool ok = false;
+      const qreal value = sfp_it.value().toDouble(&ok);
+      if (ok) {
+        AppendMonitorTimeSeries(
+            QString("device/%1/port/%2/%3").arg(device.GetId()).arg(entry.GetInterfaceId()).arg(sfp_it.key()),
+            timestamp, value);
+      }
+    }
   }
 
   // [bugfix:3466] Monitor - Import/Export Device Config fields error
@@ -622,6 +712,8 @@ ACT_STATUS ActCore::HandleTrafficResult(ActDeviceMonitorTraffic &traffic, bool s
       // Update the traffic view
       traffic_entry.SetTrafficUtilization(utilization);
       traffic_view_map[port_id] = traffic_entry;
+      AppendMonitorTimeSeries(QString("device/%1/port/%2/utilization").arg(device.GetId()).arg(port_id),
+                              traffic.GetTimestamp(), utilization);
 
       for (ActLink link : link_set) {
         // Ignore the link that is not related to the device
@@ -646,11 +738,15 @@ ACT_STATUS ActCore::HandleTrafficResult(ActDeviceMonitorTraffic &traffic, bool s
 
         if (link.GetSourceDeviceId() == traffic_entry.GetDeviceId() && link.GetSourceInterfaceId() == port_id) {
           link_traffic.SetSourceTrafficUtilization(traffic_entry.GetTrafficUtilization());
+          AppendMonitorTimeSeries(QString("link/%1/source-utilization").arg(link.GetId()), traffic.GetTimestamp(),
+                                  traffic_entry.GetTrafficUtilization());
         }
 
         if (link.GetDestinationDeviceId() == traffic_entry.GetDeviceId() &&
             link.GetDestinationInterfaceId() == port_id) {
           link_traffic.SetDestinationTrafficUtilization(traffic_entry.GetTrafficUtilization());
+          AppendMonitorTimeSeries(QString("link/%1/destination-utilization").arg(link.GetId()),
+                                  traffic.GetTimestamp(), traffic_entry.GetTrafficUtilization());
         }
 
         g_monitor_link_traffic[link.GetId()] = link_traffic;
@@ -1115,6 +1211,7 @@ ACT_STATUS ActCore::HandleVLANResult(ActVlanTable &vlan_table, bool sync_to_webs
 
   ActDeviceConfig &device_config = monitor_project_.GetDeviceConfig();
   device_config.GetVlanTables()[vlan_table.GetDeviceId()] = vlan_table;
+  this->BumpVlanViewRevision(monitor_project_.GetId());
 
   return act_status;
 }
@@ -1428,9 +1525,37 @@ void ActCore::MonitorProcessThread(const qint64 monitor_project_id, const qint64
   g_monitor_basic_status.clear();
   g_monitor_rstp_status.clear();
 
+  // Keep the history of the monitored values
+  {
+    QMutexLocker lock(&this->monitor_mutex_);
+    monitor_time_series_ = this->GetTimeSeriesStore(monitor_project_id);
+  }
+  qint64 last_time_series_flush_timestamp = QDateTime::currentSecsSinceEpoch();
+  qint64 mqtt_dropped_count = 0;
+
   while (this->GetSystemStatus() == ActSystemStatusEnum::kMonitoring) {
     bool data_processed = false;
     bool device_handled = false;
+    bool mqtt_events_pending = false;
+
+    // Apply the debounced MQTT events in batches
+    if (mqtt_event_queue_ != nullptr) {
+      QList<ActMqttMessage> messages = mqtt_event_queue_->Take(QDateTime::currentMSecsSinceEpoch());
+      if (!messages.isEmpty()) {
+        data_processed = true;
+        act_status = this->HandleTrapMessages(messages, sync_to_websocket, send_tmp);
+        if (!IsActStatusSuccess(act_status)) {
+          qCritical() << __func__ << "HandleTrapMessages() failed.";
+        }
+      }
+
+      ActMqttEventQueueMetrics metrics = mqtt_event_queue_->GetMetrics();
+      mqtt_events_pending = metrics.GetPending() > 0;
+      if (metrics.GetDropped() > mqtt_dropped_count) {
+        mqtt_dropped_count = metrics.GetDropped();
+        qWarning() << __func__ << "MQTT events dropped:" << metrics.ToString().toStdString().c_str();
+      }
+    }
 
     qint64 last_report_timestamp = QDateTime::currentSecsSinceEpoch();
 
@@ -2116,6 +2241,7 @@ void ActCore::MonitorProcessThread(const qint64 monitor_project_id, const qint64
           ActSwift swift = monitor_project_.GetTopologySetting().GetRedundantGroup().GetSwift();
           QMap<qint64, qint16> tier_map = swift.GetDeviceTierMap();
           // qDebug() << "swift:" << swift.ToString().toStdString().c_str();
+          const qint64 link_status_timestamp = QDateTime::currentMSecsSinceEpoch();
 
           for (ActLink link : link_set) {
             // Fetch source device & destination device status information
@@ -2135,6 +2261,8 @@ void ActCore::MonitorProcessThread(const qint64 monitor_project_id, const qint64
             g_link_status_ws_data_set.insert(ActMonitorLinkStatusData(link));
 
             g_monitor_link_status[link.GetId()] = link.GetAlive();
+            AppendMonitorTimeSeries(QString("link/%1/status").arg(link.GetId()), link_status_timestamp,
+                                    link.GetAlive() ? 1 : 0);
 
             // Update swift link status
             // if the link is down, the lower device should be false in the swift status
@@ -2266,15 +2394,33 @@ void ActCore::MonitorProcessThread(const qint64 monitor_project_id, const qint64
         }  // if (current_time - last_sfp_update_timestamp >=
       }  // protect monitor_mutex_
 
+      // Flush the history per flush interval (the store has its own lock)
+      if ((monitor_time_series_ != nullptr) &&
+          (QDateTime::currentSecsSinceEpoch() - last_time_series_flush_timestamp >= ACT_TIME_SERIES_FLUSH_INTERVAL)) {
+        last_time_series_flush_timestamp = QDateTime::currentSecsSinceEpoch();
+        monitor_time_series_->Flush();
+      }
+
       if (data_processed) {
         sleep_time_ms = 100;  // Reset sleep time if data was processed
       } else {
         sleep_time_ms = std::min(sleep_time_ms + 100, max_sleep_time_ms);  // Increment sleep time up to max
+        if (mqtt_events_pending) {
+          sleep_time_ms = 100;  // The debounced events are due soon
+        }
         SLEEP_MS(sleep_time_ms);
       }
     }  // protect monitor_mutex_
   }
 
+  if (monitor_time_series_ != nullptr) {
+    monitor_time_series_->Flush();
+  }
+  {
+    QMutexLocker lock(&this->monitor_mutex_);
+    monitor_time_series_.reset();
+  }
+
   qDebug() << "monitor thread finish...";
 }
 
@@ -2287,6 +2433,9 @@ ACT_STATUS ActCore::StartMonitorProcessEngine(const qint64 project_id, const qin
   // Default constructor initializes the mutex
   monitor_process_queue_mutex_ = std::make_unique<QMutex>();
 
+  // The MQTT events are queued by the client thread and applied by the process thread
+  mqtt_event_queue_ = std::make_shared<ActMqttEventQueue>();
+
   // Create monitor process thread
   monitor_process_thread_ =
       std::make_unique<std::thread>(&ActCore::MonitorProcessThread, this, project_id, ws_listener_id);
@@ -2300,6 +2449,15 @@ ACT_STATUS ActCore::StartMonitorProcessEngine(const qint64 project_id, const qin
   }
 #endif
 
+  mqtt_client_thread_ = std::make_shared<std::thread>(&ActCore::MqttClientThread, this, mqtt_event_queue_);
+
+#ifdef _WIN32
+  hr = SetThreadDescription(this->mqtt_client_thread_->native_handle(), L"MqttClientThread");
+  if (FAILED(hr)) {
+    // Handle error
+  }
+#endif
+
   return act_status;
 }
 
@@ -2310,6 +2468,10 @@ void ActCore::StopMonitorProcessEngine() {
   if (monitor_process_thread_ != nullptr && monitor_process_thread_->joinable()) {
     monitor_process_thread_->join();
   }
+  if (mqtt_client_thread_ != nullptr && mqtt_client_thread_->joinable()) {
+    mqtt_client_thread_->join();
+  }
+  mqtt_event_queue_.reset();
   qDebug() << "Stop monitor process engine";
 }
 
@@ -18,9 +18,9 @@ ACT_STATUS ActCore::CheckWSConnect(qint64 &project_id) {
   }
 
   // Check WebSocket connection size
-  if (this->ws_listeners_.size() >= ACT_WS_SOCKET_MAX_SIZE) {
+  if (this->ws_listeners_.Size() >= ACT_WS_SOCKET_MAX_SIZE) {
     QString error_msg = QString("WebSocket connection count(%1) exceeds the limit(%2)")
-                            .arg(this->ws_listeners_.size())
+                            .arg(this->ws_listeners_.Size())
                             .arg(ACT_WS_SOCKET_MAX_SIZE);
     qCritical() << __func__ << error_msg;
     return std::make_shared<ActBadRequest>(error_msg);
@@ -33,8 +33,10 @@ ACT_STATUS ActCore::AddWSListener(const std::shared_ptr<WSListener> &ws_listener
   ACT_STATUS_INIT();
 
   qint64 listener_id;
+  qint64 listener_project_id;
   ws_listener->getId(listener_id);
-  this->ws_listeners_.insert(listener_id, ws_listener);
+  ws_listener->getProjectId(listener_project_id);
+  this->ws_listeners_.Insert(listener_id, listener_project_id, ws_listener);
 
   return act_status;
 }
@@ -43,7 +45,7 @@ ACT_STATUS ActCore::RemoveWSListener(const qint64 &id) {
   ACT_STATUS_INIT();
   qDebug() << __func__;
   qDebug() << __func__ << QString("Remove WS Listener(%1)").arg(id).toStdString().c_str();
-  this->ws_listeners_.remove(id);
+  this->ws_listeners_.Remove(id);
   qDebug() << __func__ << "done";
   return act_status;
 }
@@ -75,16 +77,15 @@ ACT_STATUS ActCore::SendMessageToSystemWSListeners(const QString &message) {
   ACT_STATUS_INIT();
 
   // Send message to System WSListener(ProjectId = -1)
-  for (auto key : this->ws_listeners_.keys()) {
-    auto &ws_listener = ws_listeners_.value(key);
-
-    // Get Project ID
-    qint64 listener_project_id = 0;
-    ws_listener->getProjectId(listener_project_id);
+  const auto &listeners = this->ws_listeners_.ProjectListeners(-1);
+  if (listeners.isEmpty()) {
+    return act_status;
+  }
 
-    if (listener_project_id == -1) {  // WSListener(ProjectId = -1)
-      ws_listener->sendMessage(message.toStdString().c_str());
-    }
+  // Serialize once, every listener shares the same immutable buffer
+  const oatpp::String payload = ToWSPayload(message);
+  for (const auto &ws_listener : listeners) {
+    ws_listener->sendMessage(payload);
   }
 
   return act_status;
@@ -100,16 +101,15 @@ ACT_STATUS ActCore::SendMessageToProjectWSListeners(const qint64 &project_id, co
   }
 
   // Send message to Project WSListener
-  for (auto key : this->ws_listeners_.keys()) {
-    auto &ws_listener = ws_listeners_.value(key);
-
-    // Get Project ID
-    qint64 listener_project_id = 0;
-    ws_listener->getProjectId(listener_project_id);
+  const auto &listeners = this->ws_listeners_.ProjectListeners(project_id);
+  if (listeners.isEmpty()) {
+    return act_status;
+  }
 
-    if (listener_project_id == project_id) {
-      ws_listener->sendMessage(message.toStdString().c_str());
-    }
+  // Serialize once, every listener shares the same immutable buffer
+  const oatpp::String payload = ToWSPayload(message);
+  for (const auto &ws_listener : listeners) {
+    ws_listener->sendMessage(payload);
   }
 
   return act_status;
@@ -124,22 +124,22 @@ ACT_STATUS ActCore::SendMessageToWSListener(const qint64 &id, const QString &mes
     return std::make_shared<ActBadRequest>(error_msg);
   }
 
-  if (!ws_listeners_.contains(id)) {
+  if (!ws_listeners_.Contains(id)) {
     qCritical() << __func__ << QString("Websocket Listener(%1) not found").arg(id);
     return std::make_shared<ActStatusNotFound>(QString("Websocket Listener(%1)").arg(id));
   }
 
   // Send message to specify WSListener
-  auto &ws_listener = ws_listeners_.value(id);
-
-  // Get Project ID
-  qint64 listener_project_id = 0;
-  ws_listener->getProjectId(listener_project_id);
-
-  ws_listener->sendMessage(message.toStdString().c_str());
+  auto ws_listener = ws_listeners_.Value(id);
+  ws_listener->sendMessage(ToWSPayload(message));
 
   return act_status;
 }
 
+oatpp::String ActCore::ToWSPayload(const QString &message) {
+  const QByteArray utf8 = message.toUtf8();
+  return oatpp::String(utf8.constData(), utf8.size());
+}
+
 }  // namespace core
 }  // namespace act
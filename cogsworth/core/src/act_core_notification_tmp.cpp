@@ -1,3 +1,6 @@
+#include <chrono>
+#include <thread>
+
 #include "act_core.hpp"
 
 namespace act {
@@ -67,6 +70,133 @@ ACT_STATUS ActCore::InsertStreamMsgToNotificationTmp(const ActStreamPatchUpdateM
   return act_status;
 }
 
+ACT_STATUS ActCore::QueueNotificationTmpToBatch(const qint64 &project_id) {
+  ACT_STATUS_INIT();
+
+  if (project_id == -1) {
+    QString error_msg = QString("project id unknown.");
+    qCritical() << error_msg.toStdString().c_str();
+    return std::make_shared<ActBadRequest>(error_msg);
+  }
+
+  ActPatchUpdateBatch &batch = this->patch_update_batches_[project_id];
+
+  // Devices
+  for (const auto &msg : this->notification_tmp_.GetDeviceUpdateMsgs()) {
+    batch.Insert(msg);
+  }
+
+  // Links
+  for (const auto &msg : this->notification_tmp_.GetLinkUpdateMsgs()) {
+    batch.Insert(msg);
+  }
+
+  // Streams
+  for (const auto &msg : this->notification_tmp_.GetStreamUpdateMsgs()) {
+    batch.Insert(msg);
+  }
+
+  return act_status;
+}
+
+ACT_STATUS ActCore::FlushPatchUpdateBatch(const qint64 &project_id) {
+  ACT_STATUS_INIT();
+
+  auto batch_it = this->patch_update_batches_.find(project_id);
+  if (batch_it == this->patch_update_batches_.end()) {
+    return act_status;
+  }
+
+  QJsonObject message;
+  const quint64 sequence = this->patch_update_sequences_.value(project_id, 0) + 1;
+  const bool has_entry = batch_it->Flush(project_id, sequence, this->patch_update_snapshots_[project_id], message);
+  this->patch_update_batches_.erase(batch_it);
+  if (!has_entry) {
+    return act_status;
+  }
+
+  this->patch_update_sequences_[project_id] = sequence;
+
+  const QString message_str = QJsonDocument(message).toJson(QJsonDocument::Compact);
+  return this->SendMessageToProjectWSListeners(project_id, message_str);
+}
+
+ACT_STATUS ActCore::FlushPatchUpdateBatches() {
+  ACT_STATUS_INIT();
+
+  for (const qint64 &project_id : this->patch_update_batches_.keys()) {
+    act_status = this->FlushPatchUpdateBatch(project_id);
+    if (!IsActStatusSuccess(act_status)) {
+      qCritical() << __func__ << "Send patch update batch failed. Project:" << project_id;
+    }
+  }
+
+  return ACT_STATUS_SUCCESS;
+}
+
+ACT_STATUS ActCore::ResyncPatchUpdate(qint64 &project_id, const qint64 &ws_listener_id) {
+  ACT_STATUS_INIT();
+
+  // Get project by id
+  ActProject project;
+  act_status = this->GetProject(project_id, project);
+  if (!IsActStatusSuccess(act_status)) {
+    qCritical() << "Get project failed with project id:" << project_id;
+
+    std::shared_ptr<ActBaseErrorMessageResponse> ws_resp =
+        ActWSResponseErrorTransfer(ActWSCommandEnum::kPatchUpdateResync, *act_status);
+    this->SendMessageToListener(ActWSTypeEnum::kSpecified, false, ws_resp, ws_listener_id);
+
+    return act_status;
+  }
+
+  // Send the pending updates first, so the snapshot matches the current sequence
+  this->FlushPatchUpdateBatch(project_id);
+
+  ActPatchUpdateBatch batch;
+  for (const auto &device : project.GetDevices()) {
+    batch.Insert(ActDevicePatchUpdateMsg(ActPatchUpdateActionEnum::kCreate, project_id, device, true));
+  }
+  for (const auto &link : project.GetLinks()) {
+    batch.Insert(ActLinkPatchUpdateMsg(ActPatchUpdateActionEnum::kCreate, project_id, link, true));
+  }
+  for (const auto &stream : project.GetStreams()) {
+    batch.Insert(ActStreamPatchUpdateMsg(ActPatchUpdateActionEnum::kCreate, project_id, stream, true));
+  }
+
+  // The snapshots of other clients are not affected by the resync
+  QMap<QString, QJsonObject> resync_snapshots;
+  QJsonObject message;
+  batch.Flush(project_id, this->patch_update_sequences_.value(project_id, 0), resync_snapshots, message);
+  message.insert("Resync", true);
+
+  const QString message_str = QJsonDocument(message).toJson(QJsonDocument::Compact);
+  return this->SendMessageToWSListener(ws_listener_id, message_str);
+}
+
+void ActCore::StartNotificationBatchThread() {
+  while (g_act_process_status == ActProcessStatus::Running) {
+    quint32 window_ms = ACT_NOTIFICATION_BATCH_CHECK;
+    {
+      QMutexLocker lock(&this->mutex_);
+      this->FlushPatchUpdateBatches();
+
+      if (this->GetSystemConfig().GetNotificationBatchWindow() > 0) {
+        window_ms = qMin<quint32>(this->GetSystemConfig().GetNotificationBatchWindow(),
+                                  ACT_NOTIFICATION_BATCH_WINDOW_MAX);
+      }
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(window_ms));
+  }
+
+  // Do not lose the last updates on shutdown
+  QMutexLocker lock(&this->mutex_);
+  this->FlushPatchUpdateBatches();
+
+  return;
+}
+
 // XXX: add into ActCore::SendMessageToListener(), for unify the entrance function
 // ACT_STATUS ActCore::SendNotificationTmpMsgs(const qint64 &project_id) {
 //   ACT_STATUS_INIT();
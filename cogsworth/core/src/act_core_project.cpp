@@ -451,6 +451,7 @@ ACT_STATUS ActCore::ImportProject(ActImportProject &imported_cfg) {
   sys_project_set.insert(imported_project);
 
   this->SetProjectSet(sys_project_set);
+  this->BumpVlanViewRevision(imported_project.GetId());
 
   // Send update msg
   ActProjectPatchUpdateMsg msg(ActPatchUpdateActionEnum::kCreate, imported_project, true);
@@ -787,6 +788,7 @@ ACT_STATUS ActCore::UpdateProject(ActProject &project, bool sync_to_websocket, b
     this->monitor_project_ = project;
 
     monitor_mutex_.unlock();
+    this->BumpVlanViewRevision(project.GetId());
     return ACT_STATUS_SUCCESS;
   }
 
@@ -820,6 +822,7 @@ ACT_STATUS ActCore::UpdateProject(ActProject &project, bool sync_to_websocket, b
   // Insert the project to core set
   project_set.insert(project);
   this->SetProjectSet(project_set);
+  this->BumpVlanViewRevision(project.GetId());
 
   // [feat:722] Auto Save
   if (this->GetSystemConfig().GetAutoSave()) {
@@ -876,6 +879,31 @@ ACT_STATUS ActCore::DeleteProject(qint64 &project_id) {
   // Destroy the project activate deploy flag
   deploy_available.remove(project_id);
 
+  // Destroy the pending patch updates & the snapshots sent to the clients
+  patch_update_batches_.remove(project_id);
+  patch_update_sequences_.remove(project_id);
+  patch_update_snapshots_.remove(project_id);
+
+  // Destroy the materialized VLAN views
+  {
+    QMutexLocker lock(&vlan_view_cache_mutex_);
+    vlan_view_cache_map_.remove(project_id);
+    operation_vlan_view_cache_map_.remove(project_id);
+    vlan_view_revision_map_.remove(project_id);
+  }
+
+  // Destroy the last deployed DeviceConfig
+  this->RemoveDeployedDeviceConfig(project_id, QList<qint64>());
+
+  // Destroy the monitor history
+  {
+    QMutexLocker lock(&time_series_mutex_);
+    time_series_store_map_.remove(project_id);
+  }
+  QDir(QDir(act::database::GetDatabaseFolder())
+           .filePath(QString("%1/%2").arg(ACT_TIME_SERIES_FOLDER).arg(project_id)))
+      .removeRecursively();
+
   if (ws_thread_handler_pools.contains(project_id)) {
     act_status = RemoveWSJob(project_id);
     if (!IsActStatusSuccess(act_status)) {
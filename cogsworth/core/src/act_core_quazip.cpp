@@ -2,16 +2,88 @@
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
+#include <QTemporaryDir>
 #include <QTextStream>
+#include <cstring>
 #include <iostream>
+#include <vector>
 
+#include "act_concurrent_runner.hpp"
 #include "act_core.hpp"
 #include "quazip.h"
 #include "quazipfile.h"
+#include "zlib.h"
+
+#define ACT_ZIP_BUFFER_SIZE (256 * 1024)  ///< The buffer(bytes) of streaming a zip entry
 
 namespace act {
 namespace core {
 
+// Copy the device in chunks, the memory stays bounded whatever the file size is
+static bool CopyInChunks(QIODevice &in, QIODevice &out) {
+  QByteArray buffer(ACT_ZIP_BUFFER_SIZE, Qt::Uninitialized);
+  while (true) {
+    const qint64 read_size = in.read(buffer.data(), buffer.size());
+    if (read_size < 0) {
+      return false;
+    }
+    if (read_size == 0) {
+      return true;
+    }
+    if (out.write(buffer.constData(), read_size) != read_size) {
+      return false;
+    }
+  }
+}
+
+// Raw deflate the file in chunks into the temporary file, which is written to the zip as is
+static bool DeflateFile(const QString &file_path, const QString &deflated_file_path, quint32 &crc, quint64 &size) {
+  QFile in_file(file_path);
+  QFile out_file(deflated_file_path);
+  if (!in_file.open(QIODevice::ReadOnly) || !out_file.open(QIODevice::WriteOnly)) {
+    return false;
+  }
+
+  z_stream stream;
+  memset(&stream, 0, sizeof(stream));
+  if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+    return false;
+  }
+
+  QByteArray in_buffer(ACT_ZIP_BUFFER_SIZE, Qt::Uninitialized);
+  QByteArray out_buffer(ACT_ZIP_BUFFER_SIZE, Qt::Uninitialized);
+  crc = crc32(0L, Z_NULL, 0);
+  size = 0;
+  bool ok = true;
+  int flush = Z_NO_FLUSH;
+  while (ok && flush != Z_FINISH) {
+    const qint64 read_size = in_file.read(in_buffer.data(), in_buffer.size());
+    if (read_size < 0) {
+      ok = false;
+      break;
+    }
+    crc = crc32(crc, reinterpret_cast<const Bytef *>(in_buffer.constData()), static_cast<uInt>(read_size));
+    size += read_size;
+    flush = (read_size == 0 || in_file.atEnd()) ? Z_FINISH : Z_NO_FLUSH;
+
+    stream.next_in = reinterpret_cast<Bytef *>(in_buffer.data());
+    stream.avail_in = static_cast<uInt>(read_size);
+    do {
+      stream.next_out = reinterpret_cast<Bytef *>(out_buffer.data());
+      stream.avail_out = static_cast<uInt>(out_buffer.size());
+      deflate(&stream, flush);
+      const qint64 deflated_size = out_buffer.size() - stream.avail_out;
+      if (out_file.write(out_buffer.constData(), deflated_size) != deflated_size) {
+        ok = false;
+        break;
+      }
+    } while (stream.avail_out == 0);
+  }
+
+  deflateEnd(&stream);
+  return ok;
+}
+
 // Recursive to get all files in the folder
 void GetAllFiles(const QString &folderPath, QStringList &fileList, const QString &basePath) {
   QDir dir(folderPath);
@@ -29,43 +101,117 @@ void GetAllFiles(const QString &folderPath, QStringList &fileList, const QString
   }
 }
 
-ACT_STATUS ActCore::CompressFolder(const QString &folderPath, const QString &zipFilePath) {
+ACT_STATUS ActCore::CompressFolder(const QString &folderPath, const QString &zipFilePath,
+                                   const qint32 &deflateThreads) {
   ACT_STATUS_INIT();
 
   // Get all files
   QStringList fileList;
   GetAllFiles(folderPath, fileList, folderPath);
 
+  // Skip the zip file itself (e.g. the previous export in the same folder)
+  const QString zipAbsoluteFilePath = QFileInfo(zipFilePath).absoluteFilePath();
+  for (qint32 i = fileList.size() - 1; i >= 0; i--) {
+    if (QFileInfo(folderPath + "/" + fileList[i]).absoluteFilePath() == zipAbsoluteFilePath) {
+      fileList.removeAt(i);
+    }
+  }
+
   QuaZip zip(zipFilePath);
+  zip.setZip64Enabled(true);
   if (!zip.open(QuaZip::mdCreate)) {
     QString error_msg = QString("Cannot create compress file: %1").arg(zipFilePath);
     return std::make_shared<ActBadRequest>(error_msg);
   }
 
   QuaZipFile outFile(&zip);
-  for (const QString &relativeFilePath : fileList) {
-    QString absoluteFilePath = folderPath + "/" + relativeFilePath;
-
-    QFile inputFile(absoluteFilePath);
-    if (!inputFile.open(QIODevice::ReadOnly)) {
-      QString error_msg = QString("Cannot read file: %1").arg(absoluteFilePath);
-      return std::make_shared<ActBadRequest>(error_msg);
+  if (deflateThreads <= 1) {
+    for (const QString &relativeFilePath : fileList) {
+      QString absoluteFilePath = folderPath + "/" + relativeFilePath;
+
+      QFile inputFile(absoluteFilePath);
+      if (!inputFile.open(QIODevice::ReadOnly)) {
+        QString error_msg = QString("Cannot read file: %1").arg(absoluteFilePath);
+        return std::make_shared<ActBadRequest>(error_msg);
+      }
+
+      // open QuaZip file
+      QuaZipNewInfo fileInfo(relativeFilePath, absoluteFilePath);
+      if (!outFile.open(QIODevice::WriteOnly, fileInfo)) {
+        QString error_msg = QString("Cannot write to zip file: %1").arg(absoluteFilePath);
+        return std::make_shared<ActBadRequest>(error_msg);
+      }
+
+      // write file data
+      const bool copied = CopyInChunks(inputFile, outFile);
+      outFile.close();
+      inputFile.close();
+
+      if (!copied || outFile.getZipError() != UNZ_OK) {
+        QString error_msg = QString("Write to zip file error: %1").arg(absoluteFilePath);
+        return std::make_shared<ActBadRequest>(error_msg);
+      }
     }
-
-    // open QuaZip file
-    QuaZipNewInfo fileInfo(relativeFilePath, absoluteFilePath);
-    if (!outFile.open(QIODevice::WriteOnly, fileInfo)) {
-      QString error_msg = QString("Cannot write to zip file: %1").arg(absoluteFilePath);
-      return std::make_shared<ActBadRequest>(error_msg);
+  } else {
+    // Deflate the entries at once into the temporary files, and append each entry as is once it completes
+    QTemporaryDir tempDir;
+    if (!tempDir.isValid()) {
+      qDebug() << __func__ << "Create the temporary folder failed";
+      return std::make_shared<ActStatusInternalError>("CreateFolderFailed");
     }
 
-    // write file data
-    outFile.write(inputFile.readAll());
-    outFile.close();
-    inputFile.close();
+    std::vector<QPair<quint32, quint64>> deflatedInfos(fileList.size());  ///< <crc, uncompressed size>
+    QList<qint64> indexList;
+    for (qint32 i = 0; i < fileList.size(); i++) {
+      indexList.append(i);
+    }
 
-    if (outFile.getZipError() != UNZ_OK) {
-      QString error_msg = QString("Write to zip file error: %1").arg(absoluteFilePath);
+    QString error_msg;
+    bool stop_flag = false;
+    ActConcurrentRunner runner(deflateThreads, 0);
+    runner.Run(
+        indexList,
+        [&](const qint64 &index) -> ACT_STATUS {
+          const QString absoluteFilePath = folderPath + "/" + fileList[index];
+          if (!DeflateFile(absoluteFilePath, tempDir.filePath(QString::number(index)), deflatedInfos[index].first,
+                           deflatedInfos[index].second)) {
+            return std::make_shared<ActBadRequest>(QString("Cannot read file: %1").arg(absoluteFilePath));
+          }
+          return ACT_STATUS_SUCCESS;
+        },
+        [&](const qint64 &index, ACT_STATUS deflate_status) {
+          const QString absoluteFilePath = folderPath + "/" + fileList[index];
+          QFile deflatedFile(tempDir.filePath(QString::number(index)));
+          if (!error_msg.isEmpty()) {
+            // Failed already, drop the entries still running at the failure
+          } else if (!IsActStatusSuccess(deflate_status)) {
+            error_msg = deflate_status->GetErrorMessage();
+          } else if (!deflatedFile.open(QIODevice::ReadOnly)) {
+            error_msg = QString("Cannot read file: %1").arg(deflatedFile.fileName());
+          } else {
+            // open QuaZip file in the raw mode, the data is deflated already
+            QuaZipNewInfo fileInfo(fileList[index], absoluteFilePath);
+            fileInfo.uncompressedSize = deflatedInfos[index].second;
+            if (!outFile.open(QIODevice::WriteOnly, fileInfo, nullptr, deflatedInfos[index].first, Z_DEFLATED,
+                              Z_DEFAULT_COMPRESSION, true)) {
+              error_msg = QString("Cannot write to zip file: %1").arg(absoluteFilePath);
+            } else {
+              const bool copied = CopyInChunks(deflatedFile, outFile);
+              outFile.close();
+              if (!copied || outFile.getZipError() != UNZ_OK) {
+                error_msg = QString("Write to zip file error: %1").arg(absoluteFilePath);
+              }
+            }
+            deflatedFile.close();
+          }
+          deflatedFile.remove();
+
+          // Stop the rest once failed
+          stop_flag = !error_msg.isEmpty();
+        },
+        &stop_flag);
+
+    if (!error_msg.isEmpty()) {
       return std::make_shared<ActBadRequest>(error_msg);
     }
   }
@@ -165,7 +311,10 @@ ACT_STATUS ActCore::UnZipFile(const QString &zip_file_path, const QString &desti
       continue;
     }
 
-    out_file.write(zip_file.readAll());
+    // Stream the entry in chunks
+    if (!CopyInChunks(zip_file, out_file)) {
+      qWarning() << "Write file failed:" << output_file_path;
+    }
     out_file.close();
     zip_file.close();
   }
@@ -194,28 +194,33 @@ ACT_STATUS ActCore::ComputeRedundantSwift(ActProject &project, ActSwift &swift)
   queue.enqueue(swift.GetBackupRootDevice());
   tier_map[swift.GetBackupRootDevice()] = 0;
 
+  const ActProjectGraph graph = project.GetGraph();
+  const ActLink no_link;
+
   // start from root & backup root device
   while (!queue.isEmpty()) {
     qint64 device_id = queue.dequeue();
     qint16 tier = tier_map[device_id];
 
-    ActDevice device;
-    project.GetDeviceById(device, device_id);
+    const ActDevice *device = graph.GetDevice(device_id);
+    if (device == nullptr) {
+      continue;
+    }
 
     // skip device over 2 tiers from root & backup root device
-    if (device.GetDeviceType() != ActDeviceTypeEnum::kEndStation &&
-        (tier > 2 || !device.GetDeviceProperty().GetFeatureGroup().GetConfiguration().GetSTPRSTP().GetSwift())) {
+    if (device->GetDeviceType() != ActDeviceTypeEnum::kEndStation &&
+        (tier > 2 || !device->GetDeviceProperty().GetFeatureGroup().GetConfiguration().GetSTPRSTP().GetSwift())) {
       continue;
     }
 
     QMap<qint16, QSet<qint64>> neighbor_map;       // collect neighbor device by tier
     QMap<qint16, QSet<qint64>> neighbor_link_map;  // collect neighbor link by tier
-    for (ActInterface &interface : device.GetInterfaces()) {
+    for (const ActInterface &interface : device->GetInterfaces()) {
       if (!interface.GetUsed()) {
         continue;
       }
-      ActLink link;
-      project.GetLinkByInterfaceId(link, device_id, interface.GetInterfaceId());
+      const ActLink *link_ptr = graph.GetLinkByInterfaceId(device_id, interface.GetInterfaceId());
+      const ActLink &link = (link_ptr != nullptr) ? *link_ptr : no_link;
 
       if (this->GetSystemStatus() == ActSystemStatusEnum::kMonitoring && !g_monitor_link_status[link.GetId()]) {
         continue;
@@ -237,7 +242,7 @@ ACT_STATUS ActCore::ComputeRedundantSwift(ActProject &project, ActSwift &swift)
       }
     }
 
-    if (tier == 0 || device.GetDeviceType() == ActDeviceTypeEnum::kEndStation ||
+    if (tier == 0 || device->GetDeviceType() == ActDeviceTypeEnum::kEndStation ||
         (neighbor_map[tier - 1].size() == 2 && neighbor_link_map[tier - 1].size() == 2 &&
          neighbor_map[tier].size() == 0)) {
       swift_map[tier].insert(device_id);
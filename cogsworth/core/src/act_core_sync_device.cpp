@@ -3,7 +3,7 @@
 #define SLEEP_MS(ms) Sleep(ms)
 #else
 #include <unistd.h>  // for sleep
-#define SLEEP_MS(ms) sleep(ms / 1000)
+#define SLEEP_MS(ms) usleep((ms) * 1000)
 #endif
 
 #include <QSet>
@@ -135,6 +135,9 @@ ACT_STATUS ActCore::StartSyncDevices(qint64 &project_id, const qint64 &ws_listen
     return act_status;
   }
 
+  // The tables are synced from the devices, the next deploy pushes all their tables again
+  this->RemoveDeployedDeviceConfig(project_id, dev_id_list);
+
   // Create a std::promise object
   std::shared_ptr<std::promise<void>> signal_sender = std::make_shared<std::promise<void>>();
 
@@ -260,6 +263,9 @@ ACT_STATUS ActCore::OpcUaStartSyncDevices(qint64 &project_id, const QList<qint64
     return act_status;
   }
 
+  // The tables are synced from the devices, the next deploy pushes all their tables again
+  this->RemoveDeployedDeviceConfig(project_id, dev_id_list);
+
   // Create a std::promise object
   std::shared_ptr<std::promise<void>> signal_sender = std::make_shared<std::promise<void>>();
 
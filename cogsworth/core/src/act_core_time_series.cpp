@@ -0,0 +1,80 @@
+#include <QDir>
+#include <QMutexLocker>
+
+#include "act_core.hpp"
+#include "act_db.hpp"
+
+namespace act {
+namespace core {
+
+std::shared_ptr<ActTimeSeriesStore> ActCore::GetTimeSeriesStore(const qint64 &project_id) {
+  QMutexLocker lock(&time_series_mutex_);
+
+  auto store_it = time_series_store_map_.find(project_id);
+  if (store_it != time_series_store_map_.end()) {
+    store_it.value()->SetKeepDays(this->GetSystemConfig().GetTimeSeriesKeepDays());
+    return store_it.value();
+  }
+
+  // <db>/time_series/<project_id>
+  const QString folder = QDir(act::database::GetDatabaseFolder())
+                             .filePath(QString("%1/%2").arg(ACT_TIME_SERIES_FOLDER).arg(project_id));
+  auto store = std::make_shared<ActTimeSeriesStore>(this->GetSystemConfig().GetTimeSeriesKeepDays());
+  ACT_STATUS act_status = store->Open(folder);
+  if (!IsActStatusSuccess(act_status)) {
+    qCritical() << __func__ << "Open the time-series store failed:" << folder;
+    return nullptr;
+  }
+
+  time_series_store_map_.insert(project_id, store);
+  return store;
+}
+
+void ActCore::AppendMonitorTimeSeries(const QString &metric, const qint64 &timestamp, const qreal &value) {
+  if (monitor_time_series_ == nullptr) {
+    return;
+  }
+  monitor_time_series_->Append(metric, timestamp, value);
+}
+
+ACT_STATUS ActCore::GetMonitorTimeSeries(const qint64 &project_id, const QString &metric, const qint64 &from,
+                                         const qint64 &to, const ActTimeSeriesResolutionEnum &resolution,
+                                         ActTimeSeries &time_series) {
+  ACT_STATUS_INIT();
+
+  QString project_name;
+  act_status = this->GetProjectName(project_id, project_name);
+  if (!IsActStatusSuccess(act_status)) {
+    qCritical() << "Get project failed with project id:" << project_id;
+    return act_status;
+  }
+
+  std::shared_ptr<ActTimeSeriesStore> store = this->GetTimeSeriesStore(project_id);
+  if (store == nullptr) {
+    return std::make_shared<ActStatusInternalError>("TimeSeries");
+  }
+
+  return store->Query(metric, from, to, resolution, time_series);
+}
+
+ACT_STATUS ActCore::GetMonitorTimeSeriesMetrics(const qint64 &project_id, ActTimeSeriesMetrics &metrics) {
+  ACT_STATUS_INIT();
+
+  QString project_name;
+  act_status = this->GetProjectName(project_id, project_name);
+  if (!IsActStatusSuccess(act_status)) {
+    qCritical() << "Get project failed with project id:" << project_id;
+    return act_status;
+  }
+
+  std::shared_ptr<ActTimeSeriesStore> store = this->GetTimeSeriesStore(project_id);
+  if (store == nullptr) {
+    return std::make_shared<ActStatusInternalError>("TimeSeries");
+  }
+
+  metrics.SetMetrics(store->GetMetrics());
+  return act_status;
+}
+
+}  // namespace core
+}  // namespace act
@@ -3,7 +3,7 @@
 #define SLEEP_MS(ms) Sleep(ms)
 #else
 #include <unistd.h>  // for sleep
-#define SLEEP_MS(ms) sleep(ms / 1000)
+#define SLEEP_MS(ms) usleep((ms) * 1000)
 #endif
 
 #include <QHash>
@@ -747,54 +747,8 @@ ACT_STATUS ActCore::CheckTopologyLoop(qint64 &project_id, ActTopologyStatus &top
   }
 
   // Check topology loop
-  if (project.GetDevices().isEmpty()) {
-    return ACT_STATUS_SUCCESS;
-  }
-  ActDevice device = *project.GetDevices().begin();
-
-  QStack<qint64> DFS_stack;
-  DFS_stack.push(device.GetId());
-
-  QSet<qint64> visited;
-  while (!DFS_stack.isEmpty()) {
-    qint64 device_id = DFS_stack.pop();
-    ActDevice device;
-    project.GetDeviceById(device, device_id);
-
-    for (ActInterface intf : device.GetInterfaces()) {
-      ActLink link;
-      act_status = project.GetLinkByInterfaceId(link, device_id, intf.GetInterfaceId());
-      if (IsActStatusNotFound(act_status)) {
-        continue;
-      }
-
-      ActDevice neighbor;
-      qint64 neighbor_id =
-          (link.GetSourceDeviceId() == device_id) ? link.GetDestinationDeviceId() : link.GetSourceDeviceId();
-      project.GetDeviceById(neighbor, neighbor_id);
-
-      if (neighbor.GetDeviceType() == ActDeviceTypeEnum::kEndStation || visited.contains(neighbor_id)) {
-        continue;
-      }
-
-      if (DFS_stack.contains(neighbor_id)) {
-        topology_status.SetLoop(true);
-        return ACT_STATUS_SUCCESS;
-      }
-
-      DFS_stack.push(neighbor_id);
-    }
-    visited.insert(device_id);
-
-    if (DFS_stack.isEmpty() && visited.count() != project.GetDevices().count()) {
-      for (ActDevice device : project.GetDevices()) {
-        if (visited.contains(device.GetId())) {
-          continue;
-        }
-        DFS_stack.push(device.GetId());
-        break;
-      }
-    }
+  if (project.GetGraph().HasLoop()) {
+    topology_status.SetLoop(true);
   }
 
   return ACT_STATUS_SUCCESS;
@@ -288,6 +288,7 @@ ACT_STATUS ActCore::ApplyOperation(qint64 project_id, ActProject &project) {
   // Insert the project to core set
   project_set.insert(project);
   this->SetProjectSet(project_set);
+  this->BumpVlanViewRevision(project.GetId());
 
   // [feat:722] Auto Save
   if (this->GetSystemConfig().GetAutoSave()) {
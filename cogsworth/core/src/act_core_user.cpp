@@ -189,9 +189,10 @@ ACT_STATUS ActCore::UpdateUser(ActUser &user) {
   // Write back the password item
   if (password_change) {
     // [feat:1248] After changing the password or deleting the account, the login user should be logged out
-    this->user_password_changed_[user.GetId()] = true;
+    this->sessions_.RemoveUser(user.GetId());
   } else {
     user.SetPassword(password);
+    this->sessions_.UpdateUserRole(user.GetId(), user.GetRole());
   }
 
   // Insert the user to core set
@@ -241,7 +242,7 @@ ACT_STATUS ActCore::DeleteUser(qint64 &id) {
   act_status = act::database::user::DeleteUserFile(id, username);
 
   // [feat:1248] After changing the password or deleting the account, the login user should be logged out
-  this->user_password_changed_[id] = true;
+  this->sessions_.RemoveUser(id);
 
   // Send update msg
   ActUserPatchUpdateMsg ws_msg(ActPatchUpdateActionEnum::kDelete, user, true);
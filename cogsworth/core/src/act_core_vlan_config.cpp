@@ -656,7 +656,11 @@ ACT_STATUS ActCore::ComputeVlanConfig(ActProject &project) {
 
   project.GetDeviceConfig().GetVlanTables().clear();
 
+  const ActLink no_link;
   for (ActIntelligentVlan intelligent_vlan : project.GetTopologySetting().GetIntelligentVlanGroup()) {
+    // The devices & links are not changed until UpdateVlanConfig()
+    const ActProjectGraph graph = project.GetGraph();
+
     QQueue<QList<qint64>> queue;
     QSet<qint64> visited;
     for (qint64 device_id : intelligent_vlan.GetEndStationList()) {
@@ -669,16 +673,18 @@ ACT_STATUS ActCore::ComputeVlanConfig(ActProject &project) {
       QList<qint64> path = queue.dequeue();
       qint64 last_id = path.last();
 
-      ActDevice device;
-      project.GetDeviceById(device, last_id);
+      const ActDevice *device = graph.GetDevice(last_id);
+      if (device == nullptr) {
+        continue;
+      }
 
       QSet<qint64> neighbor_ids;
-      for (ActInterface interface : device.GetInterfaces()) {
+      for (const ActInterface &interface : device->GetInterfaces()) {
         if (!interface.GetUsed()) {
           continue;
         }
-        ActLink link;
-        project.GetLinkByInterfaceId(link, last_id, interface.GetInterfaceId());
+        const ActLink *link_ptr = graph.GetLinkByInterfaceId(last_id, interface.GetInterfaceId());
+        const ActLink &link = (link_ptr != nullptr) ? *link_ptr : no_link;
 
         qint64 neighbor_id =
             (link.GetSourceDeviceId() == last_id) ? link.GetDestinationDeviceId() : link.GetSourceDeviceId();
@@ -700,12 +706,10 @@ ACT_STATUS ActCore::ComputeVlanConfig(ActProject &project) {
           continue;
         }
 
-        ActDevice neighbor;
-        project.GetDeviceById(neighbor, neighbor_id);
-
-        if (neighbor.GetDeviceType() != ActDeviceTypeEnum::kSwitch &&
-            neighbor.GetDeviceType() != ActDeviceTypeEnum::kBridgedEndStation &&
-            neighbor.GetDeviceType() != ActDeviceTypeEnum::kTSNSwitch) {
+        const ActDevice *neighbor = graph.GetDevice(neighbor_id);
+        if (neighbor == nullptr || (neighbor->GetDeviceType() != ActDeviceTypeEnum::kSwitch &&
+                                    neighbor->GetDeviceType() != ActDeviceTypeEnum::kBridgedEndStation &&
+                                    neighbor->GetDeviceType() != ActDeviceTypeEnum::kTSNSwitch)) {
           continue;
         }
 
@@ -720,22 +724,24 @@ ACT_STATUS ActCore::ComputeVlanConfig(ActProject &project) {
     QMap<qint64, QSet<qint64>> vlan_devices_map;
     int end_station_count = 0;
     for (qint64 device_id : vlan_devices) {
-      ActDevice device;
-      project.GetDeviceById(device, device_id);
+      const ActDevice *device = graph.GetDevice(device_id);
+      if (device == nullptr) {
+        continue;
+      }
 
-      if (device.GetDeviceType() == ActDeviceTypeEnum::kEndStation) {
+      if (device->GetDeviceType() == ActDeviceTypeEnum::kEndStation) {
         end_station_count++;
         continue;
       }
 
-      for (ActInterface interface : device.GetInterfaces()) {
+      for (const ActInterface &interface : device->GetInterfaces()) {
         if (!interface.GetUsed()) {
           continue;
         }
 
-        ActLink link;
         qint64 interface_id = interface.GetInterfaceId();
-        project.GetLinkByInterfaceId(link, device_id, interface_id);
+        const ActLink *link_ptr = graph.GetLinkByInterfaceId(device_id, interface_id);
+        const ActLink &link = (link_ptr != nullptr) ? *link_ptr : no_link;
 
         qint64 neighbor_id =
             (link.GetSourceDeviceId() == device_id) ? link.GetDestinationDeviceId() : link.GetSourceDeviceId();
@@ -1,4 +1,4 @@
-#include <QSet>
+#include <QMutexLocker>
 
 #include "act_core.hpp"
 #include "act_db.hpp"
@@ -11,6 +11,9 @@ ACT_STATUS ActCore::GetVlanViewIds(qint64 &project_id, ActVlanViewIds &vlan_view
 
   this->InitNotificationTmp();
 
+  // The revision before the project, so the project is never older than the revision
+  const qint64 revision = this->GetVlanViewRevision(project_id);
+
   // Get project by id
   ActProject project;
   act_status = this->GetProject(project_id, project, is_operation);
@@ -19,23 +22,8 @@ ACT_STATUS ActCore::GetVlanViewIds(qint64 &project_id, ActVlanViewIds &vlan_view
     return act_status;
   }
 
-  // Get vlan id
-  QSet<qint32> vlan_id_set;
-  for (auto vlan_cfg_table : project.GetDeviceConfig().GetVlanTables()) {
-    // For each vlan_entries
-    for (auto vlan_static_entry : vlan_cfg_table.GetVlanStaticEntries()) {
-      // Insert vlan_id to set
-      vlan_id_set.insert(vlan_static_entry.GetVlanId());
-    }
-  }
-
-  // Transfer QSet to QList
-  QList<qint32> vlan_id_list = vlan_id_set.values();
-
-  // Sort QList
-  std::sort(vlan_id_list.begin(), vlan_id_list.end());
-
-  vlan_view_ids.SetVlanIdList(vlan_id_list);
+  // Get vlan id (ascending)
+  vlan_view_ids.SetVlanIdList(this->UpdateVlanViewCache(project, revision, is_operation).GetVlanIds());
 
   return act_status;
 }
@@ -45,6 +33,9 @@ ACT_STATUS ActCore::GetVlanViews(qint64 &project_id, ActVlanViewTable &vlan_view
 
   this->InitNotificationTmp();
 
+  // The revision before the project, so the project is never older than the revision
+  const qint64 revision = this->GetVlanViewRevision(project_id);
+
   // Get project by id
   ActProject project;
   act_status = this->GetProject(project_id, project, is_operation);
@@ -53,81 +44,49 @@ ACT_STATUS ActCore::GetVlanViews(qint64 &project_id, ActVlanViewTable &vlan_view
     return act_status;
   }
 
-  act_status = this->GetVlanViews(project, vlan_view_table);
-  if (!IsActStatusSuccess(act_status)) {
-    qCritical() << "Get vlan views failed";
-    return act_status;
-  }
+  vlan_view_table = this->UpdateVlanViewCache(project, revision, is_operation).GetVlanViewTable();
 
   return ACT_STATUS_SUCCESS;
 }
 
-ACT_STATUS ActCore::GetVlanViews(ActProject &project, ActVlanViewTable &vlan_view_table) {
-  ACT_STATUS_INIT();
+void ActCore::BumpVlanViewRevision(const qint64 &project_id) {
+  QMutexLocker lock(&vlan_view_cache_mutex_);
+  vlan_view_revision_map_[project_id]++;
+}
+
+qint64 ActCore::GetVlanViewRevision(const qint64 &project_id) {
+  QMutexLocker lock(&vlan_view_cache_mutex_);
+  return vlan_view_revision_map_.value(project_id, 0);
+}
 
-  // Transfer vlan-config to vlan_view_table
-  QSet<ActVlanView> vlan_view_set;
-  for (auto vlan_cfg_table : project.GetDeviceConfig().GetVlanTables()) {
-    // For each vlan_entries
-    for (auto vlan_static_entry : vlan_cfg_table.GetVlanStaticEntries()) {
-      // Found vlan_view
-      ActVlanView vlan_view(vlan_static_entry.GetVlanId());
-      auto vlan_view_iter = vlan_view_set.find(vlan_view);
-      if (vlan_view_iter != vlan_view_set.end()) {  // found
-        vlan_view = *vlan_view_iter;
-      }
-
-      // Found vlan_view_device
-      ActVlanViewDevice vlan_view_device(vlan_cfg_table.GetDeviceId());
-      auto vlan_view_device_set = vlan_view.GetDevices();
-      auto vlan_view_device_iter = vlan_view_device_set.find(vlan_view_device);
-      if (vlan_view_device_iter != vlan_view_device_set.end()) {  // found
-        vlan_view_device = *vlan_view_device_iter;
-      }
-      auto port_set = vlan_view_device.GetPorts();
-      // Insert egress_ports to device's ports
-      for (auto egress_port : vlan_static_entry.GetEgressPorts()) {
-        // Find egress_port's vlan_port_type entry
-        ActVlanPortTypeEntry vlan_port_type_entry(egress_port, ActVlanPortTypeEnum::kHybrid,
-                                                  ActVlanPriorityEnum::kNonTSN);
-        auto vlan_port_type_entry_iter = vlan_cfg_table.GetVlanPortTypeEntries().find(vlan_port_type_entry);
-        if (vlan_port_type_entry_iter != vlan_cfg_table.GetVlanPortTypeEntries().end()) {  //  found
-          vlan_port_type_entry = *vlan_port_type_entry_iter;
-        }
-
-        port_set.insert(vlan_port_type_entry);
-      }
-
-      // Insert untagged_ports to device's ports
-      for (auto untag_port : vlan_static_entry.GetUntaggedPorts()) {
-        // Find untag_port's vlan_port_type entry
-        ActVlanPortTypeEntry vlan_port_type_entry(untag_port, ActVlanPortTypeEnum::kHybrid,
-                                                  ActVlanPriorityEnum::kNonTSN);
-        auto vlan_port_type_entry_iter = vlan_cfg_table.GetVlanPortTypeEntries().find(vlan_port_type_entry);
-        if (vlan_port_type_entry_iter != vlan_cfg_table.GetVlanPortTypeEntries().end()) {  //  found
-          vlan_port_type_entry = *vlan_port_type_entry_iter;
-        }
-
-        port_set.insert(vlan_port_type_entry);
-      }
-
-      // Generate vlan_view
-      vlan_view_device.SetPorts(port_set);
-      if (vlan_view_device_iter != vlan_view_device_set.end()) {  // remove exists vlan_view_device
-        vlan_view_device_set.erase(vlan_view_device_iter);
-      }
-      vlan_view_device_set.insert(vlan_view_device);
-      vlan_view.SetDevices(vlan_view_device_set);
-
-      // Insert vlan_view
-      if (vlan_view_iter != vlan_view_set.end()) {  // remove exists vlan_view
-        vlan_view_set.erase(vlan_view_iter);
-      }
-      vlan_view_set.insert(vlan_view);
-    }
+ActVlanViewCache ActCore::UpdateVlanViewCache(const ActProject &project, const qint64 &revision,
+                                              const bool &is_operation) {
+  QMutexLocker lock(&vlan_view_cache_mutex_);
+  ActVlanViewCache &vlan_view_cache =
+      (is_operation ? operation_vlan_view_cache_map_ : vlan_view_cache_map_)[project.GetId()];
+  const qint32 changed = vlan_view_cache.Update(project.GetDeviceConfig().GetVlanTables(), revision);
+  if (changed > 0) {
+    qDebug() << __func__
+             << QString("Project(%1) re-materialized the VLAN views of %2 devices")
+                    .arg(project.GetId())
+                    .arg(changed)
+                    .toStdString()
+                    .c_str();
+
+    // Rebuild the table in the cache, so the copies returned don't rebuild it again
+    vlan_view_cache.GetVlanViewTable();
   }
+  return vlan_view_cache;
+}
+
+ACT_STATUS ActCore::GetVlanViews(ActProject &project, ActVlanViewTable &vlan_view_table, bool is_operation) {
+  ACT_STATUS_INIT();
+  Q_UNUSED(is_operation);
 
-  vlan_view_table.SetVlanViews(vlan_view_set);
+  // The project may not be the stored one, so it doesn't share the project's cache
+  ActVlanViewCache vlan_view_cache;
+  vlan_view_cache.Update(project.GetDeviceConfig().GetVlanTables());
+  vlan_view_table = vlan_view_cache.GetVlanViewTable();
   // qDebug() << __func__ << "vlan_view_table:" << vlan_view_table.ToString().toStdString().c_str();
 
   return act_status;
@@ -138,6 +97,9 @@ ACT_STATUS ActCore::GetVlanView(qint64 &project_id, qint32 &vlan_id, ActVlanView
 
   this->InitNotificationTmp();
 
+  // The revision before the project, so the project is never older than the revision
+  const qint64 revision = this->GetVlanViewRevision(project_id);
+
   // Get project by id
   ActProject project;
   act_status = this->GetProject(project_id, project, is_operation);
@@ -146,31 +108,24 @@ ACT_STATUS ActCore::GetVlanView(qint64 &project_id, qint32 &vlan_id, ActVlanView
     return act_status;
   }
 
-  act_status = this->GetVlanView(project, vlan_id, vlan_view);
-  if (!IsActStatusSuccess(act_status)) {
+  if (!this->UpdateVlanViewCache(project, revision, is_operation).GetVlanView(vlan_id, vlan_view)) {  // not found
     qCritical() << "Get vlan view failed";
-    return act_status;
+    return std::make_shared<ActStatusNotFound>(QString("Vlan-view(VlanID:%1)").arg(vlan_id));
   }
 
   return ACT_STATUS_SUCCESS;
 }
 
-ACT_STATUS ActCore::GetVlanView(ActProject &project, qint32 &vlan_id, ActVlanView &vlan_view) {
+ACT_STATUS ActCore::GetVlanView(ActProject &project, qint32 &vlan_id, ActVlanView &vlan_view, bool is_operation) {
   ACT_STATUS_INIT();
+  Q_UNUSED(is_operation);
 
-  ActVlanViewTable vlan_view_table;
-  act_status = GetVlanViews(project, vlan_view_table);
-  if (!IsActStatusSuccess(act_status)) {
-    qCritical() << "GetVlanViews() failed with project id:" << project.GetId();
-    return act_status;
-  }
-
-  auto vlan_view_set = vlan_view_table.GetVlanViews();
-  auto vlan_view_iter = vlan_view_set.find(ActVlanView(vlan_id));
-  if (vlan_view_iter == vlan_view_set.end()) {  // not found
+  // The project may not be the stored one, so it doesn't share the project's cache
+  ActVlanViewCache vlan_view_cache;
+  vlan_view_cache.Update(project.GetDeviceConfig().GetVlanTables());
+  if (!vlan_view_cache.GetVlanView(vlan_id, vlan_view)) {  // not found
     return std::make_shared<ActStatusNotFound>(QString("Vlan-view(VlanID:%1)").arg(vlan_id));
   }
-  vlan_view = *vlan_view_iter;
   return act_status;
 }
 }  // namespace core
@@ -0,0 +1,221 @@
+#include <QMap>
+#include <QSet>
+#include <QStringList>
+
+#include "act_core.hpp"
+#include "act_unit_test.hpp"
+
+class ActCoreComputeTest : public ActQuickTest {
+ protected:
+  // The Swift root 1 and backup root 2 connect each other by the ports 1 and 2, every other device connects the root
+  // by its port 1 and the backup root by its port 2. The roots and the odd devices support RSTP, the roots and every
+  // fourth of them support Swift. Every third device holds the TSN entries computed before.
+  static ActProject Project(const qint64 &device_count, const bool &swift_active) {
+    ActProject project(1);
+    for (qint64 id = 1; id <= device_count; id++) {
+      ActDevice device(id);
+      ActSTPRSTPItem &stp_rstp = device.GetDeviceProperty().GetFeatureGroup().GetConfiguration().GetSTPRSTP();
+      stp_rstp.SetRSTP(id <= 2 || id % 2 == 1);
+      stp_rstp.SetSwift(id <= 2 || id % 4 == 1);
+      for (qint64 interface_id = 1; interface_id <= ((id <= 2) ? device_count : 2); interface_id++) {
+        ActInterface interface(interface_id);
+        interface.SetUsed(true);
+        device.GetInterfaces().append(interface);
+      }
+      project.GetDevices().insert(device);
+
+      if (id == 2) {
+        project.GetLinks().insert(ActLink(1, 1, 2, 1, 1));
+        project.GetLinks().insert(ActLink(2, 1, 2, 2, 2));
+      } else if (id > 2) {
+        project.GetLinks().insert(ActLink(id * 2 - 3, 1, id, id, 1));
+        project.GetLinks().insert(ActLink(id * 2 - 2, 2, id, id, 2));
+      }
+
+      ActVlanTable vlan_table(id);
+      ActVlanStaticEntry reserved_entry(1);  // VLAN 1 is reserved by the device
+      ActVlanStaticEntry user_entry(100);
+      vlan_table.GetVlanStaticEntries().insert(user_entry);
+      vlan_table.GetPortVlanEntries().insert(ActPortVlanEntry(1, 100, ActVlanPriorityEnum::kNonTSN));
+      vlan_table.GetVlanPortTypeEntries().insert(
+          ActVlanPortTypeEntry(1, ActVlanPortTypeEnum::kTrunk, ActVlanPriorityEnum::kNonTSN));
+      if (id % 3 == 0) {
+        reserved_entry.SetVlanPriority(ActVlanPriorityEnum::kTSNSystem);
+        ActVlanStaticEntry tsn_entry(200);
+        tsn_entry.SetVlanPriority(ActVlanPriorityEnum::kTSNUser);
+        vlan_table.GetVlanStaticEntries().insert(tsn_entry);
+        vlan_table.GetPortVlanEntries().insert(ActPortVlanEntry(2, 200, ActVlanPriorityEnum::kTSNUser));
+        vlan_table.GetVlanPortTypeEntries().insert(
+            ActVlanPortTypeEntry(2, ActVlanPortTypeEnum::kHybrid, ActVlanPriorityEnum::kTSNUser));
+      }
+      vlan_table.GetVlanStaticEntries().insert(reserved_entry);
+      project.GetDeviceConfig().GetVlanTables().insert(id, vlan_table);
+    }
+
+    ActSwift swift(1, 2);
+    swift.SetActive(swift_active);
+    project.GetTopologySetting().GetRedundantGroup().SetSwift(swift);
+    return project;
+  }
+
+  // The role of the device in the active Swift group of the project
+  static ActDeviceRoleEnum SwiftRole(const qint64 &device_id) {
+    if (device_id == 1) {
+      return ActDeviceRoleEnum::kSwiftRoot;
+    }
+    if (device_id == 2) {
+      return ActDeviceRoleEnum::kSwiftBackupRoot;
+    }
+    if (device_id % 4 == 1) {
+      return ActDeviceRoleEnum::kSwift;
+    }
+    return (device_id % 2 == 1) ? ActDeviceRoleEnum::kRSTP : ActDeviceRoleEnum::kUnknown;
+  }
+
+  // The devices notified by the computes since the last InitNotificationTmp()
+  static QSet<qint64> NotifiedDevices() {
+    QSet<qint64> device_ids;
+    for (auto msg : act::core::g_core.GetNotificationTmp().GetDeviceUpdateMsgs()) {
+      device_ids.insert(msg.GetData().GetId());
+    }
+    return device_ids;
+  }
+
+  // The reference: reset every VLAN table and the redundant group, as the full recompute did
+  static void FullRecompute(ActProject &project) {
+    for (qint64 device_id : project.GetDeviceConfig().GetVlanTables().keys()) {
+      ActDevice device;
+      ASSERT_TRUE(IsActStatusSuccess(project.GetDeviceById(device, device_id)));
+      ActVlanTable &vlan_table = project.GetDeviceConfig().GetVlanTables()[device_id];
+
+      QSet<ActVlanStaticEntry> vlan_static_entries;
+      for (ActVlanStaticEntry vlan_static_entry : vlan_table.GetVlanStaticEntries()) {
+        if ((vlan_static_entry.GetVlanPriority() == ActVlanPriorityEnum::kNonTSN) ||
+            device.GetDeviceProperty().GetReservedVlan().contains(vlan_static_entry.GetVlanId())) {
+          vlan_static_entries.insert(vlan_static_entry);
+        }
+      }
+      vlan_table.SetVlanStaticEntries(vlan_static_entries);
+
+      QSet<ActPortVlanEntry> port_vlan_entries;
+      for (ActPortVlanEntry port_vlan_entry : vlan_table.GetPortVlanEntries()) {
+        if (port_vlan_entry.GetVlanPriority() != ActVlanPriorityEnum::kNonTSN) {
+          port_vlan_entry.SetPVID(ACT_VLAN_INIT_PVID);
+          port_vlan_entry.SetVlanPriority(ActVlanPriorityEnum::kNonTSN);
+        }
+        port_vlan_entries.insert(port_vlan_entry);
+      }
+      vlan_table.SetPortVlanEntries(port_vlan_entries);
+
+      QSet<ActVlanPortTypeEntry> vlan_port_type_entries;
+      for (ActVlanPortTypeEntry vlan_port_type_entry : vlan_table.GetVlanPortTypeEntries()) {
+        if (vlan_port_type_entry.GetVlanPriority() != ActVlanPriorityEnum::kNonTSN) {
+          vlan_port_type_entry.SetVlanPortType(ActVlanPortTypeEnum::kAccess);
+          vlan_port_type_entry.SetVlanPriority(ActVlanPriorityEnum::kNonTSN);
+        }
+        vlan_port_type_entries.insert(vlan_port_type_entry);
+      }
+      vlan_table.SetVlanPortTypeEntries(vlan_port_type_entries);
+    }
+
+    ASSERT_TRUE(IsActStatusSuccess(act::core::g_core.ComputeRedundantSwift(project)));
+  }
+
+  // The computed state of the device, the entries in the key order (the set order depends on its history)
+  static QString Snapshot(ActProject &project, const qint64 &device_id) {
+    ActDevice device;
+    EXPECT_TRUE(IsActStatusSuccess(project.GetDeviceById(device, device_id)));
+    ActVlanTable &vlan_table = project.GetDeviceConfig().GetVlanTables()[device_id];
+
+    QMap<qint64, QString> entries;
+    for (ActVlanStaticEntry entry : vlan_table.GetVlanStaticEntries()) {
+      entries.insert(entry.GetVlanId(), entry.ToString());
+    }
+    for (ActPortVlanEntry entry : vlan_table.GetPortVlanEntries()) {
+      entries.insert(10000 + entry.GetPortId(), entry.ToString());
+    }
+    for (ActVlanPortTypeEntry entry : vlan_table.GetVlanPortTypeEntries()) {
+      entries.insert(20000 + entry.GetPortId(), entry.ToString());
+    }
+
+    QStringList snapshot(entries.values());
+    snapshot.append(QString::number(static_cast<qint32>(device.GetDeviceRole())));
+    snapshot.append(project.GetDeviceConfig().GetRstpTables().value(device_id).ToString());
+    return snapshot.join("\n");
+  }
+};
+
+TEST_F(ActCoreComputeTest, TestMatchFullRecompute) {
+  const qint64 kDeviceCount = 30;
+  ActProject project = Project(kDeviceCount, true);
+  ActProject reference = project;
+
+  act::core::g_core.InitNotificationTmp();
+  ASSERT_TRUE(IsActStatusSuccess(act::core::g_core.ComputeTopologySetting(project)));
+  FullRecompute(reference);
+
+  QSet<qint64> role_changed_devices;
+  for (qint64 id = 1; id <= kDeviceCount; id++) {
+    EXPECT_EQ(Snapshot(reference, id), Snapshot(project, id)) << "Device" << id;
+
+    ActDevice device;
+    ASSERT_TRUE(IsActStatusSuccess(project.GetDeviceById(device, id)));
+    EXPECT_EQ(SwiftRole(id), device.GetDeviceRole()) << "Device" << id;
+    if (SwiftRole(id) != ActDeviceRoleEnum::kUnknown) {
+      role_changed_devices.insert(id);
+    }
+  }
+
+  // Only the devices leaving the unknown role are notified, the links are never changed
+  EXPECT_EQ(role_changed_devices, NotifiedDevices());
+  EXPECT_TRUE(act::core::g_core.GetNotificationTmp().GetLinkUpdateMsgs().isEmpty());
+}
+
+TEST_F(ActCoreComputeTest, TestInactiveSwiftNoNotification) {
+  const qint64 kDeviceCount = 12;
+  ActProject project = Project(kDeviceCount, false);
+  ActProject reference = project;
+
+  act::core::g_core.InitNotificationTmp();
+  ASSERT_TRUE(IsActStatusSuccess(act::core::g_core.ComputeTopologySetting(project)));
+  FullRecompute(reference);
+
+  // The inactive group doesn't assign any role, so only the VLAN tables are reset
+  for (qint64 id = 1; id <= kDeviceCount; id++) {
+    EXPECT_EQ(Snapshot(reference, id), Snapshot(project, id)) << "Device" << id;
+
+    ActDevice device;
+    ASSERT_TRUE(IsActStatusSuccess(project.GetDeviceById(device, id)));
+    EXPECT_EQ(ActDeviceRoleEnum::kUnknown, device.GetDeviceRole()) << "Device" << id;
+  }
+  EXPECT_TRUE(act::core::g_core.GetNotificationTmp().GetDeviceUpdateMsgs().isEmpty());
+  EXPECT_TRUE(act::core::g_core.GetNotificationTmp().GetLinkUpdateMsgs().isEmpty());
+}
+
+TEST_F(ActCoreComputeTest, TestNoChangeNoNotification) {
+  ActProject project = Project(12, true);
+  ASSERT_TRUE(IsActStatusSuccess(act::core::g_core.ComputeTopologySetting(project)));
+
+  // Recompute after a change that doesn't touch the computed state
+  ActProject reference = project;
+  act::core::g_core.InitNotificationTmp();
+  ASSERT_TRUE(IsActStatusSuccess(act::core::g_core.ComputeTopologySetting(project)));
+  FullRecompute(reference);
+
+  for (qint64 id = 1; id <= 12; id++) {
+    EXPECT_EQ(Snapshot(reference, id), Snapshot(project, id)) << "Device" << id;
+  }
+  EXPECT_TRUE(act::core::g_core.GetNotificationTmp().GetDeviceUpdateMsgs().isEmpty());
+  EXPECT_TRUE(act::core::g_core.GetNotificationTmp().GetLinkUpdateMsgs().isEmpty());
+
+  // A new RSTP device out of the Swift group is notified alone
+  ActDevice device(13);
+  device.GetDeviceProperty().GetFeatureGroup().GetConfiguration().GetSTPRSTP().SetRSTP(true);
+  project.GetDevices().insert(device);
+  act::core::g_core.InitNotificationTmp();
+  ASSERT_TRUE(IsActStatusSuccess(act::core::g_core.ComputeTopologySetting(project)));
+  EXPECT_EQ(QSet<qint64>({13}), NotifiedDevices());
+
+  ASSERT_TRUE(IsActStatusSuccess(project.GetDeviceById(device, 13)));
+  EXPECT_EQ(ActDeviceRoleEnum::kRSTP, device.GetDeviceRole());
+}
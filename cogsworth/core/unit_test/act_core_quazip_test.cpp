@@ -0,0 +1,112 @@
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <functional>
+
+#include "act_core.hpp"
+#include "act_unit_test.hpp"
+
+#define ACT_ZIP_TEST_FILE_SIZE (16 * 1024 * 1024)   ///< The size(bytes) of each test file
+#define ACT_ZIP_TEST_MEMORY_LIMIT (8 * 1024 * 1024)  ///< The peak memory(bytes) growth allowed, under a file size
+
+class ActCoreQuazipTest : public ActQuickTest {
+ protected:
+  QTemporaryDir temp_dir;
+  QString source_path;
+  QStringList files = {"a.ini", "baseline/1/b.ini", "baseline/2/c.ini", "backup/d.ini"};
+
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir.isValid());
+    source_path = temp_dir.filePath("source");
+
+    // Write the large files in chunks, the test itself keeps the memory bounded
+    QByteArray chunk;
+    for (qint32 line = 0; chunk.size() < 1024 * 1024; line++) {
+      chunk.append(QString("Vlan%1=%2\n").arg(line).arg(line * 7919 % 4093).toUtf8());
+    }
+    chunk.truncate(1024 * 1024);
+    for (qint32 i = 0; i < files.size(); i++) {
+      const QString file_path = source_path + "/" + files[i];
+      QDir().mkpath(QFileInfo(file_path).absolutePath());
+      QFile file(file_path);
+      ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+      for (qint64 written = 0; written < ACT_ZIP_TEST_FILE_SIZE; written += chunk.size()) {
+        chunk[0] = static_cast<char>('A' + i);
+        file.write(chunk);
+      }
+    }
+  }
+
+  static QByteArray Hash(const QString &file_path) {
+    QFile file(file_path);
+    if (!file.open(QIODevice::ReadOnly)) {
+      return QByteArray();
+    }
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(&file);
+    return hash.result();
+  }
+
+  // The memory(bytes) of the /proc/self/status field (VmRSS: the resident, VmHWM: the peak resident), -1 if unknown
+  static qint64 StatusMemory(const QByteArray &field) {
+    QFile status("/proc/self/status");
+    if (!status.open(QIODevice::ReadOnly | QIODevice::Text)) {
+      return -1;
+    }
+    for (const QByteArray &line : status.readAll().split('\n')) {
+      if (line.startsWith(field + ":")) {
+        return line.mid(field.size() + 1).trimmed().split(' ').first().toLongLong() * 1024;
+      }
+    }
+    return -1;
+  }
+
+  // Reset the peak resident memory to the current one, false if the kernel doesn't support it
+  static bool ResetPeakMemory() {
+    QFile clear_refs("/proc/self/clear_refs");
+    if (!clear_refs.open(QIODevice::WriteOnly)) {
+      return false;
+    }
+    return clear_refs.write("5") == 1;
+  }
+
+  // Run the operation and check the peak resident memory it grows from the resident memory before it
+  static void CheckPeakMemory(const QString &name, const std::function<void()> &operation) {
+    const bool reset = ResetPeakMemory();
+    const qint64 resident_before = StatusMemory("VmRSS");
+    operation();
+    const qint64 peak_after = StatusMemory("VmHWM");
+    if (reset && resident_before >= 0 && peak_after >= 0) {
+      EXPECT_LT(peak_after - resident_before, ACT_ZIP_TEST_MEMORY_LIMIT) << name.toStdString();
+    }
+  }
+
+  void CheckRoundTrip(const qint32 &deflate_threads) {
+    const QString zip_file_path = source_path + "/export.zip";
+    CheckPeakMemory("Compress", [&]() {
+      ACT_STATUS act_status = act::core::g_core.CompressFolder(source_path, zip_file_path, deflate_threads);
+      ASSERT_TRUE(IsActStatusSuccess(act_status));
+    });
+
+    const QString extract_path = temp_dir.filePath(QString("extract_%1").arg(deflate_threads));
+    CheckPeakMemory("Extract", [&]() {
+      ACT_STATUS act_status = act::core::g_core.UnZipFile(zip_file_path, extract_path);
+      ASSERT_TRUE(IsActStatusSuccess(act_status));
+    });
+    for (const QString &file : files) {
+      EXPECT_EQ(Hash(source_path + "/" + file), Hash(extract_path + "/" + file)) << file.toStdString();
+    }
+
+    // The zip file itself is not zipped
+    EXPECT_FALSE(QFile::exists(extract_path + "/export.zip"));
+  }
+};
+
+TEST_F(ActCoreQuazipTest, TestStreamingZip) { CheckRoundTrip(1); }
+
+TEST_F(ActCoreQuazipTest, TestConcurrentDeflate) {
+  // Zip it twice, the previous zip in the folder is skipped
+  CheckRoundTrip(ACT_ZIP_DEFLATE_THREADS);
+  CheckRoundTrip(ACT_ZIP_DEFLATE_THREADS);
+}
@@ -43,6 +43,22 @@ TEST_F(ActCoreTest, TestToString) {
   // EXPECT_NE(0, str.length());
 }
 
+TEST_F(ActCoreTest, TestToWSPayload) {
+  // The payload is the UTF-8 bytes of the message, the non-ASCII characters must not be truncated
+  const QString message = QString::fromUtf8("{\"Path\":\"Projects/1/Devices/2\",\"Alias\":\"\u4EA4\u63DB\u6A5F\"}");
+  const QByteArray utf8 = message.toUtf8();
+
+  const oatpp::String payload = act::core::ActCore::ToWSPayload(message);
+  ASSERT_TRUE(payload != nullptr);
+  EXPECT_EQ(static_cast<size_t>(utf8.size()), payload->size());
+  EXPECT_EQ(std::string(utf8.constData(), utf8.size()), *payload);
+  EXPECT_EQ(message, QString::fromUtf8(payload->data(), static_cast<int>(payload->size())));
+
+  const oatpp::String empty_payload = act::core::ActCore::ToWSPayload(QString());
+  ASSERT_TRUE(empty_payload != nullptr);
+  EXPECT_TRUE(empty_payload->empty());
+}
+
 // int main(int argc, char **argv) {
 //   testing::InitGoogleTest(&argc, argv);
 //   return RUN_ALL_TESTS();
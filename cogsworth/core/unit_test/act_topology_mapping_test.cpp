@@ -0,0 +1,235 @@
+#include <QElapsedTimer>
+
+#include "act_topology_mapping.hpp"
+#include "act_unit_test.hpp"
+
+#define ACT_MAPPING_TEST_FAN_OUT (3)              ///< The child devices of each device in the synthetic tree
+#define ACT_MAPPING_TEST_ONLINE_ID_BASE (100000)  ///< The online id = base + permuted offline index
+
+using namespace act::topology;
+
+class ActTopologyMappingTest : public ActQuickTest {
+ protected:
+  // A tree of MOXA switches, port 1 is the uplink and ports 2~4 connect the children
+  static ActMapTopology OfflineTopology(const qint64 &device_count) {
+    ActMapTopology topology;
+    for (qint64 id = 1; id <= device_count; id++) {
+      ActDevice device(id);
+      device.SetDeviceType(ActDeviceTypeEnum::kTSNSwitch);
+      device.SetDeviceProfileId(1);
+      device.SetIpv4(ActIpv4(QString("10.%1.%2.%3").arg(id / 65536).arg((id / 256) % 256).arg(id % 256)));
+      device.GetDeviceProperty().SetModelName((id % 2 == 0) ? "TSN-G5008" : "TSN-G5004");
+      device.GetDeviceProperty().SetVendor("MOXA");
+      topology.GetDevices().append(device);
+
+      if (id > 1) {
+        const qint64 parent_id = (id - 2) / ACT_MAPPING_TEST_FAN_OUT + 1;
+        const qint64 parent_interface_id = (id - 2) % ACT_MAPPING_TEST_FAN_OUT + 2;
+        topology.GetLinks().append(ActLink(id - 1, parent_id, id, parent_interface_id, 1));
+      }
+    }
+    topology.SetSourceDeviceId(1);
+    return topology;
+  }
+
+  // The same network scanned online, the devices and links are in another order with the other ids
+  static ActMapTopology OnlineTopology(const ActMapTopology &offline_topology, QHash<qint64, qint64> &online_ids) {
+    const qint64 device_count = offline_topology.GetDevices().size();
+    QList<qint64> permutation;
+    for (qint64 i = 0; i < device_count; i++) {
+      permutation.append((i * 7919) % device_count);  // 7919 is a prime, so it is a permutation
+    }
+
+    ActMapTopology topology;
+    for (const qint64 &index : permutation) {
+      ActDevice device = offline_topology.GetDevices().at(index);
+      online_ids.insert(device.GetId(), ACT_MAPPING_TEST_ONLINE_ID_BASE + index);
+      device.SetId(ACT_MAPPING_TEST_ONLINE_ID_BASE + index);
+      topology.GetDevices().append(device);
+    }
+    for (qint32 i = offline_topology.GetLinks().size() - 1; i >= 0; i--) {
+      ActLink link = offline_topology.GetLinks().at(i);
+      link.SetSourceDeviceId(online_ids[link.GetSourceDeviceId()]);
+      link.SetDestinationDeviceId(online_ids[link.GetDestinationDeviceId()]);
+      topology.GetLinks().append(link);
+    }
+    topology.SetSourceDeviceId(online_ids[offline_topology.GetSourceDeviceId()]);
+    return topology;
+  }
+
+  // The project of the offline topology, Mapper finds its source device
+  static ActProject Project(const ActMapTopology &offline_topology) {
+    ActProject project(1);
+    for (const auto &device : offline_topology.GetDevices()) {
+      project.GetDevices().insert(device);
+    }
+    for (const auto &link : offline_topology.GetLinks()) {
+      project.GetLinks().insert(link);
+    }
+    return project;
+  }
+
+  // Unplug the last (leaf) device of the synthetic tree, its link id is device_count - 1
+  static void UnplugLastDevice(const qint64 &device_count, const QHash<qint64, qint64> &online_ids,
+                               ActMapTopology &online_topology) {
+    online_topology.GetDevices().removeAll(ActDevice(online_ids[device_count]));
+    online_topology.GetLinks().removeAll(ActLink(device_count - 1));
+  }
+
+  static ActProfiles Profiles() {
+    ActDeviceProfile device_profile(1);
+    device_profile.SetBuiltInPower(true);
+    ActProfiles profiles;
+    profiles.GetDeviceProfiles().insert(device_profile);
+    return profiles;
+  }
+};
+
+TEST_F(ActTopologyMappingTest, TestPermutedTopology) {
+  ActMapTopology offline_topology = OfflineTopology(40);
+  QHash<qint64, qint64> online_ids;
+  ActMapTopology online_topology = OnlineTopology(offline_topology, online_ids);
+
+  ActTopologyMapping mapping(Profiles());
+  ActTopologyMappingResult result;
+  ACT_STATUS act_status = mapping.MappingTopology(offline_topology, online_topology, result);
+  ASSERT_TRUE(IsActStatusSuccess(act_status));
+
+  EXPECT_TRUE(result.GetDeploy());
+  ASSERT_EQ(40, result.GetMappingReport().size());
+  for (const auto &item : result.GetMappingReport()) {
+    EXPECT_EQ(ActDeviceMapStatus::kSuccess, item.GetStatus());
+    EXPECT_EQ(online_ids[item.GetOfflineDeviceId()], item.GetOnlineDeviceId());
+  }
+}
+
+TEST_F(ActTopologyMappingTest, TestMissingDevice) {
+  ActMapTopology offline_topology = OfflineTopology(13);
+  QHash<qint64, qint64> online_ids;
+  ActMapTopology online_topology = OnlineTopology(offline_topology, online_ids);
+
+  // Unplug the leaf device 13 (the link id 12)
+  online_topology.GetDevices().removeAll(ActDevice(online_ids[13]));
+  online_topology.GetLinks().removeAll(ActLink(12));
+
+  ActTopologyMapping mapping(Profiles());
+  ActTopologyMappingResult result;
+  mapping.MappingTopology(offline_topology, online_topology, result);
+
+  EXPECT_FALSE(result.GetDeploy());
+  for (const auto &item : result.GetMappingReport()) {
+    if (item.GetOfflineDeviceId() == 13) {
+      EXPECT_EQ(ActDeviceMapStatus::kNotFound, item.GetStatus());
+    } else if (item.GetOfflineDeviceId() == 4) {
+      // The parent of the device 13 misses its port 4
+      EXPECT_EQ(ActDeviceMapStatus::kFailed, item.GetStatus());
+    } else {
+      EXPECT_EQ(ActDeviceMapStatus::kSuccess, item.GetStatus());
+    }
+  }
+}
+
+TEST_F(ActTopologyMappingTest, TestMapperMissingDevice) {
+  ActMapTopology offline_topology = OfflineTopology(13);
+  QHash<qint64, qint64> online_ids;
+  ActMapTopology online_topology = OnlineTopology(offline_topology, online_ids);
+  UnplugLastDevice(13, online_ids, online_topology);
+
+  // The other TSN-G5004 have an uplink port and the root's neighbor 4 misses its port 4, so no device matches the
+  // first hop of the online source, all of them are tried and the root fails the least
+  ActProject project = Project(offline_topology);
+  ActTopologyMapping mapping(Profiles());
+  ActTopologyMappingResult result;
+  ASSERT_TRUE(IsActStatusSuccess(mapping.MapOnlineTopology(project, online_topology, result)));
+
+  EXPECT_FALSE(result.GetDeploy());
+  ASSERT_EQ(13, result.GetMappingReport().size());
+  for (const auto &item : result.GetMappingReport()) {
+    if (item.GetOfflineDeviceId() == 13) {
+      EXPECT_EQ(ActDeviceMapStatus::kNotFound, item.GetStatus());
+    } else if (item.GetOfflineDeviceId() == 4) {
+      EXPECT_EQ(ActDeviceMapStatus::kFailed, item.GetStatus());
+    } else {
+      EXPECT_EQ(ActDeviceMapStatus::kSuccess, item.GetStatus());
+      EXPECT_EQ(online_ids[item.GetOfflineDeviceId()], item.GetOnlineDeviceId());
+    }
+  }
+}
+
+TEST_F(ActTopologyMappingTest, TestMapperUnpluggedSourceLink) {
+  // The root also connects the device 2 by the port 5, so it is still reachable when the port 2 is unplugged
+  ActMapTopology offline_topology = OfflineTopology(13);
+  offline_topology.GetLinks().append(ActLink(13, 1, 2, 5, 5));
+  QHash<qint64, qint64> online_ids;
+  ActMapTopology online_topology = OnlineTopology(offline_topology, online_ids);
+  online_topology.GetLinks().removeAll(ActLink(1));
+
+  // The online source is not configured yet, so it is not found by its IP either
+  const qint32 src_index = online_topology.GetDevices().indexOf(ActDevice(online_ids[1]));
+  ASSERT_GE(src_index, 0);
+  online_topology.GetDevices()[src_index].SetIpv4(ActIpv4("192.168.127.253"));
+
+  // The root fails the first hop at its port 2, but it is the only source deployable with the warnings
+  ActProject project = Project(offline_topology);
+  ActTopologyMapping mapping(Profiles());
+  ActTopologyMappingResult result;
+  ASSERT_TRUE(IsActStatusSuccess(mapping.MapOnlineTopology(project, online_topology, result)));
+
+  EXPECT_TRUE(result.GetDeploy());
+  ASSERT_EQ(13, result.GetMappingReport().size());
+  for (const auto &item : result.GetMappingReport()) {
+    EXPECT_EQ(online_ids[item.GetOfflineDeviceId()], item.GetOnlineDeviceId());
+    if (item.GetOfflineDeviceId() == 1 || item.GetOfflineDeviceId() == 2) {
+      EXPECT_EQ(ActDeviceMapStatus::kWarning, item.GetStatus());
+    } else {
+      EXPECT_EQ(ActDeviceMapStatus::kSuccess, item.GetStatus());
+    }
+  }
+}
+
+TEST_F(ActTopologyMappingTest, BenchmarkMapper) {
+  const qint64 kDeviceCount = 250;
+  const qint64 kScale = 4;
+  ActTopologyMapping mapping(Profiles());
+
+  // The mapping of the whole network, or of the network missing a leaf device (no source candidate maps cleanly)
+  auto run = [&](const qint64 &device_count, const bool &unplug) {
+    ActMapTopology offline_topology = OfflineTopology(device_count);
+    QHash<qint64, qint64> online_ids;
+    ActMapTopology online_topology = OnlineTopology(offline_topology, online_ids);
+    if (unplug) {
+      UnplugLastDevice(device_count, online_ids, online_topology);
+    }
+    ActProject project = Project(offline_topology);
+
+    QElapsedTimer timer;
+    timer.start();
+    ActTopologyMappingResult result;
+    mapping.MapOnlineTopology(project, online_topology, result);
+    const qint64 elapsed_ms = qMax<qint64>(timer.elapsed(), 1);
+
+    EXPECT_EQ(!unplug, result.GetDeploy());
+    EXPECT_EQ(device_count, result.GetMappingReport().size());
+    qDebug() << QString("Devices: %1, links: %2, unplugged: %3, elapsed: %4 ms")
+                    .arg(device_count)
+                    .arg(offline_topology.GetLinks().size())
+                    .arg(unplug)
+                    .arg(elapsed_ms)
+                    .toStdString()
+                    .c_str();
+    return elapsed_ms;
+  };
+
+  for (const bool unplug : {false, true}) {
+    const qint64 small_ms = run(kDeviceCount, unplug);
+    const qint64 large_ms = run(kDeviceCount * kScale, unplug);
+
+    // Linear grows 4x, trying every candidate grows 16x
+    qDebug() << QString("Unplugged: %1, %2x devices, %3x elapsed")
+                    .arg(unplug)
+                    .arg(kScale)
+                    .arg(static_cast<double>(large_ms) / small_ms, 0, 'f', 1)
+                    .toStdString()
+                    .c_str();
+  }
+}
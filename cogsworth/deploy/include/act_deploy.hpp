@@ -7,11 +7,14 @@ See the file MOXA-SOFTWARE-NOTICE for details.
 #define ACT_DEPLOY_HPP
 
 #include <QDebug>
+#include <QMutex>
 #include <QQueue>
 #include <QString>
+#include <functional>
 #include <thread>
 
 #include "act_compare.hpp"
+#include "act_deploy_diff.hpp"
 #include "act_deploy_parameter.hpp"
 #include "act_deploy_result.hpp"
 #include "act_device_profile.hpp"
@@ -105,6 +108,7 @@ class ActDeploy {
 
   ACT_JSON_FIELD(bool, deployer_stop_flag, DeployerStopFlag);
   ACT_JSON_FIELD(quint8, progress, Progress);
+  ACT_JSON_FIELD(quint32, parallelism, Parallelism);  ///< The devices deployed concurrently in a wave (>= 1)
   ACT_JSON_QT_SET(qint64, network_setting_success_devices, NetworkSettingSuccessDevices);
   ACT_JSON_OBJECT(ActProfiles, profiles, Profiles);
 
@@ -123,6 +127,40 @@ class ActDeploy {
   QMap<QString, QString> mac_host_map_;
   ActSouthbound southbound_;
 
+  QMutex mutex_;      ///< Guards the results, the failed devices and the progress written by the deploy workers
+  QMutex arp_mutex_;  ///< Serializes the localhost ARP table updates
+
+  ActDeployDiff deploy_diff_;  ///< The diff against the last deployed configuration (disabled by default)
+
+  /**
+   * @brief Check the device's table should be deployed (changed from the last deployed one)
+   *
+   * @tparam T the table type
+   * @param table_name
+   * @param baseline_tables
+   * @param tables
+   * @param device
+   * @param force deploy the table even it is unchanged
+   * @return true
+   * @return false
+   */
+  template <class T>
+  bool NeedDeployTable(const QString &table_name, const QMap<qint64, T> &baseline_tables,
+                       const QMap<qint64, T> &tables, const ActDevice &device, const bool &force) {
+    if (force || deploy_diff_.IsChanged(baseline_tables, tables, device.GetId())) {
+      return true;
+    }
+
+    qDebug() << __func__
+             << QString("Skip the unchanged %1 table. Device: %2(%3)")
+                    .arg(table_name)
+                    .arg(device.GetIpv4().GetIpAddress())
+                    .arg(device.GetId())
+                    .toStdString()
+                    .c_str();
+    return false;
+  }
+
   /**
    * @brief Triggered the deployer for the thread
    *
@@ -281,6 +319,57 @@ class ActDeploy {
    */
   ACT_STATUS UpdateProgress(quint8 progress);
 
+  /**
+   * @brief Add the progress (thread safe)
+   *
+   * @param delta
+   * @param max_progress the progress would not exceed it
+   * @return ACT_STATUS
+   */
+  ACT_STATUS AddProgress(quint8 delta, quint8 max_progress);
+
+  /**
+   * @brief Generate the deploy waves by the hop distance from the management interface devices
+   *
+   * The farthest devices are deployed first, so a device is never reconfigured while the path to a farther device
+   * still passes through it. The devices at the same distance are independent and form one wave. The device without
+   * the known distance (or no management interface at all) forms a wave by itself, in the original order.
+   *
+   * @param project
+   * @param deploy_dev_list
+   * @param waves the indexes of the deploy_dev_list of each wave
+   * @return ACT_STATUS
+   */
+  ACT_STATUS GenerateDeployWaves(const ActProject &project, const QList<ActDevice> &deploy_dev_list,
+                                 QList<QList<qint32>> &waves);
+
+  /**
+   * @brief Run the function on each not failed device, wave by wave
+   *
+   * The devices in the same wave are processed concurrently by at most parallelism_ workers, the next wave starts
+   * after the whole wave finished.
+   *
+   * @param waves
+   * @param deploy_dev_list
+   * @param func
+   * @return ACT_STATUS
+   */
+  ACT_STATUS ForEachDeployWave(const QList<QList<qint32>> &waves, QList<ActDevice> &deploy_dev_list,
+                               const std::function<void(ActDevice &)> &func);
+
+  /**
+   * @brief Deploy the configurations to the device
+   *
+   * @param dev
+   * @param deploy_control
+   * @param dev_config
+   * @param parameter_base
+   * @param dev_progress_slot
+   * @return ACT_STATUS
+   */
+  ACT_STATUS DeployDevice(ActDevice &dev, const ActDeployControl &deploy_control, ActDeviceConfig &dev_config,
+                          ActDeployParameterBase *parameter_base, const quint8 &dev_progress_slot);
+
  public:
   /**
    * @brief Construct a new Act Deploy object
@@ -289,6 +378,7 @@ class ActDeploy {
   ActDeploy(const ActProfiles &profiles, const QMap<QString, QString> &mac_host_map) {
     profiles_ = profiles;
     progress_ = 0;
+    parallelism_ = ACT_DEPLOY_PARALLELISM;
     failed_device_id_set_.clear();
     deployer_stop_flag_ = false;
     deployer_act_status_ = std::make_shared<ActStatusBase>(ActStatusType::kStop, ActSeverity::kDebug);
@@ -325,6 +415,23 @@ class ActDeploy {
    */
   ACT_STATUS IniDeployer(const ActProject &project, const QList<qint64> &dev_id_list, const bool &skip_mapping_dev);
 
+  /**
+   * @brief Dequeue the device result (thread safe, the deploy workers enqueue the results concurrently)
+   *
+   * @param result
+   * @return true if dequeued, false if the result queue is empty
+   */
+  bool DequeueResult(ActDeviceConfigureResult &result);
+
+  /**
+   * @brief Set the last deployed device configuration, the unchanged tables would not be deployed
+   *
+   * @param baseline_device_config
+   */
+  void SetBaselineDeviceConfig(const ActDeviceConfig &baseline_device_config) {
+    deploy_diff_ = ActDeployDiff(baseline_device_config);
+  }
+
   /**
    * @brief Start the deployer by new thread
    *
@@ -0,0 +1,147 @@
+/* Copyright (C) MOXA Inc. All rights reserved.
+This software is distributed under the terms of the MOXA SOFTWARE NOTICE.
+See the file MOXA-SOFTWARE-NOTICE for details.
+*/
+
+#pragma once
+
+#include "act_json.hpp"
+#include "device_configuration/act_device_config.hpp"
+
+namespace act {
+namespace deploy {
+
+class ActDeployControl;
+
+/**
+ * @brief The deploy table change enum class
+ *
+ */
+enum class ActDeployTableChangeEnum { kCreate = 0, kUpdate = 1 };
+
+/**
+ * @brief The QMap for deploy table change enum mapping
+ *
+ */
+static const QMap<QString, ActDeployTableChangeEnum> kActDeployTableChangeEnumMap = {
+    {"Create", ActDeployTableChangeEnum::kCreate}, {"Update", ActDeployTableChangeEnum::kUpdate}};
+
+/**
+ * @brief The planned change of one device's configuration table
+ *
+ */
+class ActDeployTableChange : public QSerializer {
+  Q_GADGET
+  QS_SERIALIZABLE
+
+  ACT_JSON_FIELD(qint64, device_id, DeviceId);
+  ACT_JSON_FIELD(QString, table, Table);  ///< The table name (e.g. "Vlan", "UnicastStaticForward")
+  ACT_JSON_ENUM(ActDeployTableChangeEnum, action, Action);
+
+ public:
+  ActDeployTableChange() : device_id_(-1), action_(ActDeployTableChangeEnum::kCreate) {}
+
+  ActDeployTableChange(const qint64 &device_id, const QString &table, const ActDeployTableChangeEnum &action)
+      : device_id_(device_id), table_(table), action_(action) {}
+};
+
+/**
+ * @brief The planned changes of the deploy (dry run result)
+ *
+ */
+class ActDeployPlan : public QSerializer {
+  Q_GADGET
+  QS_SERIALIZABLE
+
+  ACT_JSON_COLLECTION_OBJECTS(QList, ActDeployTableChange, changes, Changes);
+};
+
+/**
+ * @brief The diff of the device configuration tables against the last deployed state
+ *
+ * The tables are compared by the serialized content, so a set ordered differently would be treated as changed (the
+ * table is pushed again, never wrongly skipped). Without the baseline every table is treated as changed.
+ *
+ */
+class ActDeployDiff {
+ public:
+  ActDeployDiff() : enabled_(false) {}
+
+  /**
+   * @brief Construct a new Act Deploy Diff object
+   *
+   * @param baseline_device_config the last deployed (or read back) device configuration
+   */
+  explicit ActDeployDiff(const ActDeviceConfig &baseline_device_config)
+      : enabled_(true), baseline_device_config_(baseline_device_config) {}
+
+  bool IsEnabled() const { return enabled_; }
+
+  const ActDeviceConfig &GetBaselineDeviceConfig() const { return baseline_device_config_; }
+
+  /**
+   * @brief Check the device's table is different from the baseline
+   *
+   * @tparam T the table type
+   * @param baseline_tables the tables of the baseline
+   * @param tables the tables to deploy
+   * @param device_id
+   * @return true if the table should be deployed
+   */
+  template <class T>
+  bool IsChanged(const QMap<qint64, T> &baseline_tables, const QMap<qint64, T> &tables, const qint64 &device_id) const {
+    if (!enabled_) {
+      return true;
+    }
+
+    auto baseline_it = baseline_tables.constFind(device_id);
+    if (baseline_it == baseline_tables.constEnd()) {
+      return true;
+    }
+    auto table_it = tables.constFind(device_id);
+    if (table_it == tables.constEnd()) {
+      return false;
+    }
+
+    T baseline_table = baseline_it.value();
+    T table = table_it.value();
+    return baseline_table.ToString() != table.ToString();
+  }
+
+  /**
+   * @brief Generate the planned changes of the devices (dry run)
+   *
+   * @param device_config the device configuration to deploy
+   * @param dev_id_list
+   * @param deploy_control
+   * @param plan
+   */
+  void GeneratePlan(const ActDeviceConfig &device_config, const QList<qint64> &dev_id_list,
+                    const ActDeployControl &deploy_control, ActDeployPlan &plan) const;
+
+  /**
+   * @brief Update the baseline by the device's deployed tables
+   *
+   * @param baseline_device_config
+   * @param device_config the device configuration deployed
+   * @param deploy_control
+   * @param device_id
+   */
+  static void UpdateBaseline(ActDeviceConfig &baseline_device_config, const ActDeviceConfig &device_config,
+                             const ActDeployControl &deploy_control, const qint64 &device_id);
+
+  /**
+   * @brief Remove the device from the baseline (the device state is unknown)
+   *
+   * @param baseline_device_config
+   * @param device_id
+   */
+  static void RemoveBaseline(ActDeviceConfig &baseline_device_config, const qint64 &device_id);
+
+ private:
+  bool enabled_;
+  ActDeviceConfig baseline_device_config_;
+};
+
+}  // namespace deploy
+}  // namespace act
@@ -5,13 +5,17 @@
 #define SLEEP_MS(ms) Sleep(ms)
 #else
 #include <unistd.h>  // for sleep
-#define SLEEP_MS(ms) sleep(ms / 1000)
+#define SLEEP_MS(ms) usleep((ms) * 1000)
 #endif
 
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QQueue>
+#include <algorithm>
 
 #include "act_algorithm.hpp"
+#include "act_concurrent_runner.hpp"
+#include "act_readiness_probe.hpp"
 
 act::deploy::ActDeploy::~ActDeploy() {
   if ((deployer_thread_ != nullptr) && (deployer_thread_->joinable())) {
@@ -104,6 +108,148 @@ ACT_STATUS act::deploy::ActDeploy::UpdateProgress(quint8 progress) {
   return act_status;
 }
 
+bool act::deploy::ActDeploy::DequeueResult(ActDeviceConfigureResult &result) {
+  QMutexLocker lock(&mutex_);
+  if (result_queue_.isEmpty()) {
+    return false;
+  }
+  result = result_queue_.dequeue();
+  return true;
+}
+
+ACT_STATUS act::deploy::ActDeploy::AddProgress(quint8 delta, quint8 max_progress) {
+  QMutexLocker lock(&mutex_);
+  const quint32 new_progress = progress_ + delta;
+  return UpdateProgress((new_progress >= max_progress) ? max_progress : new_progress);
+}
+
+ACT_STATUS act::deploy::ActDeploy::GenerateDeployWaves(const ActProject &project,
+                                                       const QList<ActDevice> &deploy_dev_list,
+                                                       QList<QList<qint32>> &waves) {
+  ACT_STATUS_INIT();
+  waves.clear();
+
+  // Build the adjacency of the devices
+  QMap<qint64, QSet<qint64>> adjacency;
+  for (const auto &link : project.GetLinks()) {
+    adjacency[link.GetSourceDeviceId()].insert(link.GetDestinationDeviceId());
+    adjacency[link.GetDestinationDeviceId()].insert(link.GetSourceDeviceId());
+  }
+
+  // BFS the hop distance from the management interface devices
+  QMap<qint64, qint32> distance_map;  // <DeviceId, Hops>
+  QQueue<qint64> bfs_queue;
+  for (const auto &mgmt_interface : project.GetTopologySetting().GetManagementInterfaces()) {
+    if (!distance_map.contains(mgmt_interface.GetDeviceId())) {
+      distance_map.insert(mgmt_interface.GetDeviceId(), 0);
+      bfs_queue.enqueue(mgmt_interface.GetDeviceId());
+    }
+  }
+  while (!bfs_queue.isEmpty()) {
+    const qint64 device_id = bfs_queue.dequeue();
+    const qint32 next_distance = distance_map.value(device_id) + 1;
+    for (const auto &neighbor_id : adjacency.value(device_id)) {
+      if (!distance_map.contains(neighbor_id)) {
+        distance_map.insert(neighbor_id, next_distance);
+        bfs_queue.enqueue(neighbor_id);
+      }
+    }
+  }
+
+  // Sort far to near, the devices at the same distance keep the original order
+  QList<qint32> index_list;
+  for (qint32 i = 0; i < deploy_dev_list.size(); i++) {
+    index_list.append(i);
+  }
+  auto distance_of = [&](qint32 index) { return distance_map.value(deploy_dev_list.at(index).GetId(), -1); };
+  std::stable_sort(index_list.begin(), index_list.end(), [&](qint32 a, qint32 b) {
+    const qint32 distance_a = distance_of(a);
+    const qint32 distance_b = distance_of(b);
+    if ((distance_a < 0) || (distance_b < 0)) {  // unknown distance at the end
+      return (distance_a >= 0) && (distance_b < 0);
+    }
+    return distance_a > distance_b;
+  });
+
+  for (const auto &index : index_list) {
+    const qint32 distance = distance_of(index);
+    if ((distance >= 0) && !waves.isEmpty() && (distance_of(waves.last().first()) == distance)) {
+      waves.last().append(index);
+    } else {
+      waves.append(QList<qint32>({index}));
+    }
+  }
+
+  qDebug() << __func__
+           << QString("Deploy devices: %1, waves: %2")
+                  .arg(deploy_dev_list.size())
+                  .arg(waves.size())
+                  .toStdString()
+                  .c_str();
+  return act_status;
+}
+
+ACT_STATUS act::deploy::ActDeploy::ForEachDeployWave(const QList<QList<qint32>> &waves,
+                                                     QList<ActDevice> &deploy_dev_list,
+                                                     const std::function<void(ActDevice &)> &func) {
+  ACT_STATUS_INIT();
+
+  for (const auto &wave : waves) {
+    if (deployer_stop_flag_) {
+      return ACT_STATUS_STOP;
+    }
+
+    // Collect the not failed devices (the list would not be resized, so the pointers are stable)
+    QList<ActDevice *> wave_devices;
+    for (const auto &index : wave) {
+      ActDevice &dev = deploy_dev_list[index];
+      bool failed = false;
+      {
+        QMutexLocker lock(&mutex_);
+        failed = failed_device_id_set_.contains(dev.GetId());
+      }
+      if (failed) {
+        qDebug() << __func__
+                 << QString("Skip Device(%1). Because it already failed")
+                        .arg(dev.GetIpv4().GetIpAddress())
+                        .toStdString()
+                        .c_str();
+        continue;
+      }
+      wave_devices.append(&dev);
+    }
+
+    const qint32 worker_size = std::min<qint32>(std::max<quint32>(parallelism_, 1), wave_devices.size());
+    if (worker_size <= 1) {
+      for (auto dev : wave_devices) {
+        if (deployer_stop_flag_) {
+          break;
+        }
+        func(*dev);
+      }
+      continue;
+    }
+
+    QList<qint64> wave_indexes;
+    for (qint32 i = 0; i < wave_devices.size(); i++) {
+      wave_indexes.append(i);
+    }
+    ActConcurrentRunner runner(worker_size, 0);
+    runner.Run(
+        wave_indexes,
+        [&](const qint64 &index) {
+          func(*wave_devices[index]);
+          return ACT_STATUS_SUCCESS;
+        },
+        [](const qint64 &, ACT_STATUS) {}, &deployer_stop_flag_);
+  }
+
+  if (deployer_stop_flag_) {
+    return ACT_STATUS_STOP;
+  }
+  return act_status;
+}
+
 ACT_STATUS act::deploy::ActDeploy::DeployErrorHandler(QString called_func, const QString &error_reason,
                                                       const QString &error_detail, const ActDevice &device) {
   qCritical() << called_func.toStdString().c_str()
@@ -115,6 +261,7 @@ ACT_STATUS act::deploy::ActDeploy::DeployErrorHandler(QString called_func, const
                      .toStdString()
                      .c_str();
 
+  QMutexLocker lock(&mutex_);
   result_queue_.enqueue(
       ActDeviceConfigureResult(device.GetId(), progress_, ActStatusType::kFailed, error_reason, error_detail));
 
@@ -235,6 +382,7 @@ ACT_STATUS act::deploy::ActDeploy::Deployer(const ActProject &project, const QLi
 
   // Configure all MappingDeviceIpSettingTables
   auto ip_setting_tables = dev_config.GetMappingDeviceIpSettingTables();
+  QSet<QString> changed_ip_set;
   for (auto &dev : deploy_dev_list) {
     if ((skip_mapping_dev == false) && ip_setting_tables.contains(dev.GetId())) {
       act_status = DeployMappingDeviceIpSetting(dev, ip_setting_tables[dev.GetId()]);
@@ -245,6 +393,7 @@ ACT_STATUS act::deploy::ActDeploy::Deployer(const ActProject &project, const QLi
         DeployErrorHandler(__func__, "Configure the offline design IP failed", act_status->GetErrorMessage(), dev);
         continue;
       }
+      changed_ip_set.insert(dev.GetIpv4().GetIpAddress());
     } else {  // Configure Same IP device's IPv4 config (Not change IP)
       ActNetworkSettingTable network_setting_table(dev);
       act_status = DeployNetworkSetting(dev, network_setting_table, deploy_control.GetFromBroadcastSearch());
@@ -258,9 +407,21 @@ ACT_STATUS act::deploy::ActDeploy::Deployer(const ActProject &project, const QLi
     }
   }
 
-  // If any one device changes IP would sleep 2 sec
-  if (!ip_setting_tables.isEmpty()) {
-    SLEEP_MS(2000);
+  // Wait until the devices changed IP are reachable by the new IP (the ICMP check below reports the failed ones)
+  if (!changed_ip_set.isEmpty()) {
+    ActReadinessProbe probe("Deploy offline design IP", ACT_DEPLOY_IP_READY_TIMEOUT);
+    probe.Wait(
+        [this, &changed_ip_set]() {
+          for (auto it = changed_ip_set.begin(); it != changed_ip_set.end();) {
+            auto ping_status = southbound_.PingIpAddress(*it, 1);
+            it = IsActStatusSuccess(ping_status) ? changed_ip_set.erase(it) : std::next(it);
+          }
+          return changed_ip_set.isEmpty();
+        },
+        &deployer_stop_flag_);
+    if (deployer_stop_flag_) {
+      return ACT_STATUS_STOP;
+    }
   }
 
   // Check all Device alive
@@ -279,62 +440,46 @@ ACT_STATUS act::deploy::ActDeploy::Deployer(const ActProject &project, const QLi
 
   UpdateProgress(10);
 
-  // Update all devices status
-  for (auto &dev : deploy_dev_list) {
-    if (deployer_stop_flag_) {
-      return ACT_STATUS_STOP;
-    }
-    // Check device not failed
-    if (failed_device_id_set_.contains(dev.GetId())) {
-      qDebug() << __func__
-               << QString("Skip Device(%1). Because it already failed")
-                      .arg(dev.GetIpv4().GetIpAddress())
-                      .toStdString()
-                      .c_str();
-      continue;
-    }
+  // Group the devices into the waves (far to near), the devices in the same wave are configured concurrently
+  QList<QList<qint32>> deploy_waves;
+  GenerateDeployWaves(project, deploy_dev_list, deploy_waves);
 
+  // Update all devices status
+  act_status = ForEachDeployWave(deploy_waves, deploy_dev_list, [&](ActDevice &dev) {
     // Update Device Connect status
-    act_status = southbound_.FeatureAssignDeviceStatus(false, dev);
-    if (!IsActStatusSuccess(act_status)) {  // not alive
-      DeployErrorHandler(__func__, "Update device connect status failed", act_status->GetErrorMessage(), dev);
-
-      continue;
+    auto status = southbound_.FeatureAssignDeviceStatus(false, dev);
+    if (!IsActStatusSuccess(status)) {  // not alive
+      DeployErrorHandler("Deployer", "Update device connect status failed", status->GetErrorMessage(), dev);
     }
+  });
+  if (!IsActStatusSuccess(act_status)) {
+    return act_status;
   }
 
   UpdateProgress(20);
   // Clear all devices RSTP configurations
   if (deploy_control.GetSpanningTree()) {
-    for (auto &dev : deploy_dev_list) {
-      if (deployer_stop_flag_) {
-        return ACT_STATUS_STOP;
+    act_status = ForEachDeployWave(deploy_waves, deploy_dev_list, [&](ActDevice &dev) {
+      // Deploy SpanningTree init configure (the unchanged RSTP table would not be deployed again, so keep it)
+      if (!deploy_diff_.IsChanged(deploy_diff_.GetBaselineDeviceConfig().GetRstpTables(), dev_config.GetRstpTables(),
+                                  dev.GetId())) {
+        return;
       }
-
-      // Check device not failed
-      if (failed_device_id_set_.contains(dev.GetId())) {
-        qDebug() << __func__
-                 << QString("Skip Device(%1). Because it already failed")
-                        .arg(dev.GetIpv4().GetIpAddress())
-                        .toStdString()
-                        .c_str();
-        continue;
-      }
-
-      // Deploy SpanningTree init configure
       if (dev.GetDeviceProperty().GetFeatureGroup().GetConfiguration().GetSTPRSTP().GetRSTP()) {
         ActRstpTable rstp_table(dev);
         // Deploy
-        act_status = southbound_.ConfigureSpanningTree(dev, rstp_table);
+        auto status = southbound_.ConfigureSpanningTree(dev, rstp_table);
         if (deployer_stop_flag_) {
-          return ACT_STATUS_STOP;
+          return;
         }
-        if (!IsActStatusSuccess(act_status)) {
-          DeployErrorHandler(__func__, "Configure Spanning Tree init configuration failed",
-                             act_status->GetErrorMessage(), dev);
-          continue;
+        if (!IsActStatusSuccess(status)) {
+          DeployErrorHandler("Deployer", "Configure Spanning Tree init configuration failed",
+                             status->GetErrorMessage(), dev);
         }
       }
+    });
+    if (!IsActStatusSuccess(act_status)) {
+      return act_status;
     }
   }
 
@@ -345,504 +490,534 @@ ACT_STATUS act::deploy::ActDeploy::Deployer(const ActProject &project, const QLi
   if (deploy_dev_list.size() > 0) {
     dev_progress_slot = dev_progress_slot / deploy_dev_list.size();
   }
+
+  // Deploy the devices wave by wave (the dev_config is read only here, so the workers share it)
+  act_status = ForEachDeployWave(deploy_waves, deploy_dev_list, [&](ActDevice &dev) {
+    DeployDevice(dev, deploy_control, dev_config, parameter_base, dev_progress_slot);
+  });
+  if (!IsActStatusSuccess(act_status)) {
+    return act_status;
+  }
+
+  SLEEP_MS(100);
+  UpdateProgress(100);
+  act_status = ACT_STATUS_SUCCESS;
+  return act_status;
+}
+
+ACT_STATUS act::deploy::ActDeploy::DeployDevice(ActDevice &dev, const ActDeployControl &deploy_control,
+                                                ActDeviceConfig &dev_config, ActDeployParameterBase *parameter_base,
+                                                const quint8 &dev_progress_slot) {
+  ACT_STATUS_INIT();
   const quint8 dev_progress_update_times = 4;
+  const ActDeviceConfig &baseline = deploy_diff_.GetBaselineDeviceConfig();
+  quint8 tsn_switch_retry_times = 0;
 
-  for (auto &dev : deploy_dev_list) {
-    quint8 tsn_switch_retry_times = 0;
+  if (deployer_stop_flag_) {
+    return ACT_STATUS_STOP;
+  }
 
+  // Clear TSN-Switch configuration sync flag
+  if (dev.GetDeviceProperty().GetFeatureGroup().GetConfiguration().GetCheckConfigSynchronization()) {
+    // Use RESTful to clear
+    bool check_result;
+    act_status = southbound_.GetTSNSwitchConfigurationSyncStatus(dev, check_result);
     if (deployer_stop_flag_) {
       return ACT_STATUS_STOP;
     }
-    // Check device not failed
-    if (failed_device_id_set_.contains(dev.GetId())) {
-      qDebug() << __func__
-               << QString("Skip Device(%1). Because it already failed")
-                      .arg(dev.GetIpv4().GetIpAddress())
-                      .toStdString()
-                      .c_str();
-      continue;
+    if (!IsActStatusSuccess(act_status)) {
+      DeployErrorHandler(__func__, "Clear Device sync status failed", act_status->GetErrorMessage(), dev);
+      return act_status;
     }
+  }
 
-    // Clear TSN-Switch configuration sync flag
-    if (dev.GetDeviceProperty().GetFeatureGroup().GetConfiguration().GetCheckConfigSynchronization()) {
-      // Use RESTful to clear
-      bool check_result;
-      act_status = southbound_.GetTSNSwitchConfigurationSyncStatus(dev, check_result);
+start_deploy_flow:  // goto tag
+  if (deployer_stop_flag_) {
+    return ACT_STATUS_STOP;
+  }
+
+  // Skip the tables equal to the last deployed ones, the retry would push all tables again
+  const bool force_deploy = (tsn_switch_retry_times > 0);
+
+  if (tsn_switch_retry_times > 0) {
+    qDebug() << __func__
+             << QString("Retry deploy Device(%1)(%2/%3).")
+                    .arg(dev.GetIpv4().GetIpAddress())
+                    .arg(tsn_switch_retry_times)
+                    .arg(ACT_DEPLOY_TSN_SWITCH_RETRY_TIMES)
+                    .toStdString()
+                    .c_str();
+  }
+
+  // Deploy NetworkSetting
+  if (deploy_control.GetNetworkSetting()) {
+    auto network_setting_tables = dev_config.GetNetworkSettingTables();
+    if (network_setting_tables.contains(dev.GetId()) &&
+        NeedDeployTable("NetworkSetting", baseline.GetNetworkSettingTables(), network_setting_tables, dev,
+                        force_deploy)) {
+      // Deploy
+      act_status =
+          DeployNetworkSetting(dev, network_setting_tables[dev.GetId()], deploy_control.GetFromBroadcastSearch());
       if (deployer_stop_flag_) {
         return ACT_STATUS_STOP;
       }
       if (!IsActStatusSuccess(act_status)) {
-        DeployErrorHandler(__func__, "Clear Device sync status failed", act_status->GetErrorMessage(), dev);
-        continue;
+        DeployErrorHandler(__func__, "Configure Network Setting failed", act_status->GetErrorMessage(), dev);
+        return act_status;
       }
-    }
 
-  start_deploy_flow:  // goto tag
-    if (deployer_stop_flag_) {
-      return ACT_STATUS_STOP;
-    }
+      // Insert to network_setting success device set
+      {
+        QMutexLocker lock(&mutex_);
+        network_setting_success_devices_.insert(dev.GetId());
+      }
 
-    if (tsn_switch_retry_times > 0) {
+      // Update device ip_address
+      auto &ipv4 = dev.GetIpv4();
+      ipv4.SetIpAddress(network_setting_tables[dev.GetId()].GetIpAddress());
       qDebug() << __func__
-               << QString("Retry deploy Device(%1)(%2/%3).")
+               << QString("Use the new IP to continue to deploy the device(%1(%2))")
                       .arg(dev.GetIpv4().GetIpAddress())
-                      .arg(tsn_switch_retry_times)
-                      .arg(ACT_DEPLOY_TSN_SWITCH_RETRY_TIMES)
+                      .arg(dev.GetId())
                       .toStdString()
                       .c_str();
     }
+  }
 
-    // Deploy NetworkSetting
-    if (deploy_control.GetNetworkSetting()) {
-      auto network_setting_tables = dev_config.GetNetworkSettingTables();
-      if (network_setting_tables.contains(dev.GetId())) {
-        // Deploy
-        act_status =
-            DeployNetworkSetting(dev, network_setting_tables[dev.GetId()], deploy_control.GetFromBroadcastSearch());
-        if (deployer_stop_flag_) {
-          return ACT_STATUS_STOP;
-        }
-        if (!IsActStatusSuccess(act_status)) {
-          DeployErrorHandler(__func__, "Configure Network Setting failed", act_status->GetErrorMessage(), dev);
-          continue;
-        }
-
-        // Insert to network_setting success device set
-        network_setting_success_devices_.insert(dev.GetId());
-
-        // Update device ip_address
-        auto &ipv4 = dev.GetIpv4();
-        ipv4.SetIpAddress(network_setting_tables[dev.GetId()].GetIpAddress());
-        qDebug() << __func__
-                 << QString("Use the new IP to continue to deploy the device(%1(%2))")
-                        .arg(dev.GetIpv4().GetIpAddress())
-                        .arg(dev.GetId())
-                        .toStdString()
-                        .c_str();
+  // Deploy LoginPolicy
+  if (deploy_control.GetLoginPolicy()) {
+    auto login_policy_tables = dev_config.GetLoginPolicyTables();
+    if (login_policy_tables.contains(dev.GetId()) &&
+        NeedDeployTable("LoginPolicy", baseline.GetLoginPolicyTables(), login_policy_tables, dev, force_deploy)) {
+      // Deploy
+      act_status = southbound_.ConfigureLoginPolicy(dev, login_policy_tables[dev.GetId()]);
+      if (deployer_stop_flag_) {
+        return ACT_STATUS_STOP;
       }
-    }
-
-    // Deploy LoginPolicy
-    if (deploy_control.GetLoginPolicy()) {
-      auto login_policy_tables = dev_config.GetLoginPolicyTables();
-      if (login_policy_tables.contains(dev.GetId())) {
-        // Deploy
-        act_status = southbound_.ConfigureLoginPolicy(dev, login_policy_tables[dev.GetId()]);
-        if (deployer_stop_flag_) {
-          return ACT_STATUS_STOP;
-        }
-        if (!IsActStatusSuccess(act_status)) {
-          DeployErrorHandler(__func__, "Configure LoginPolicy failed", act_status->GetErrorMessage(), dev);
-          continue;
-        }
+      if (!IsActStatusSuccess(act_status)) {
+        DeployErrorHandler(__func__, "Configure LoginPolicy failed", act_status->GetErrorMessage(), dev);
+        return act_status;
       }
     }
+  }
 
-    // Deploy InformationSetting
-    if (deploy_control.GetInformationSetting()) {
-      auto info_setting_tables = dev_config.GetInformationSettingTables();
-      if (info_setting_tables.contains(dev.GetId())) {
-        // Deploy
-        act_status = southbound_.ConfigureInformationSetting(dev, info_setting_tables[dev.GetId()]);
-        if (deployer_stop_flag_) {
-          return ACT_STATUS_STOP;
-        }
-        if (!IsActStatusSuccess(act_status)) {
-          DeployErrorHandler(__func__, "Configure InformationSetting failed", act_status->GetErrorMessage(), dev);
-          continue;
-        }
+  // Deploy InformationSetting
+  if (deploy_control.GetInformationSetting()) {
+    auto info_setting_tables = dev_config.GetInformationSettingTables();
+    if (info_setting_tables.contains(dev.GetId()) &&
+        NeedDeployTable("InformationSetting", baseline.GetInformationSettingTables(), info_setting_tables, dev,
+                        force_deploy)) {
+      // Deploy
+      act_status = southbound_.ConfigureInformationSetting(dev, info_setting_tables[dev.GetId()]);
+      if (deployer_stop_flag_) {
+        return ACT_STATUS_STOP;
       }
-    }
-
-    // Deploy SnmpTrapSetting
-    if (deploy_control.GetSnmpTrapSetting()) {
-      auto snmp_trap_setting_tables = dev_config.GetSnmpTrapSettingTables();
-      if (snmp_trap_setting_tables.contains(dev.GetId())) {
-        // Deploy
-        act_status = southbound_.ConfigureSnmpTrapSetting(dev, snmp_trap_setting_tables[dev.GetId()]);
-        if (deployer_stop_flag_) {
-          return ACT_STATUS_STOP;
-        }
-        if (!IsActStatusSuccess(act_status)) {
-          DeployErrorHandler(__func__, "Configure SnmpTrapSetting failed", act_status->GetErrorMessage(), dev);
-          continue;
-        }
+      if (!IsActStatusSuccess(act_status)) {
+        DeployErrorHandler(__func__, "Configure InformationSetting failed", act_status->GetErrorMessage(), dev);
+        return act_status;
       }
     }
+  }
 
-    // Deploy SyslogSetting
-    if (deploy_control.GetSyslogSetting()) {
-      auto syslog_setting_tables = dev_config.GetSyslogSettingTables();
-      if (syslog_setting_tables.contains(dev.GetId())) {
-        // Deploy
-        act_status = southbound_.ConfigureSyslogSetting(dev, syslog_setting_tables[dev.GetId()]);
-        if (deployer_stop_flag_) {
-          return ACT_STATUS_STOP;
-        }
-        if (!IsActStatusSuccess(act_status)) {
-          DeployErrorHandler(__func__, "Configure SyslogSetting failed", act_status->GetErrorMessage(), dev);
-          continue;
-        }
+  // Deploy SnmpTrapSetting
+  if (deploy_control.GetSnmpTrapSetting()) {
+    auto snmp_trap_setting_tables = dev_config.GetSnmpTrapSettingTables();
+    if (snmp_trap_setting_tables.contains(dev.GetId()) &&
+        NeedDeployTable("SnmpTrapSetting", baseline.GetSnmpTrapSettingTables(), snmp_trap_setting_tables, dev,
+                        force_deploy)) {
+      // Deploy
+      act_status = southbound_.ConfigureSnmpTrapSetting(dev, snmp_trap_setting_tables[dev.GetId()]);
+      if (deployer_stop_flag_) {
+        return ACT_STATUS_STOP;
       }
-    }
-
-    // Deploy TimeSetting
-    if (deploy_control.GetTimeSetting()) {
-      auto time_setting_tables = dev_config.GetTimeSettingTables();
-      if (time_setting_tables.contains(dev.GetId())) {
-        // Deploy
-        act_status = southbound_.ConfigureTimeSetting(dev, time_setting_tables[dev.GetId()]);
-        if (deployer_stop_flag_) {
-          return ACT_STATUS_STOP;
-        }
-        if (!IsActStatusSuccess(act_status)) {
-          DeployErrorHandler(__func__, "Configure TimeSetting failed", act_status->GetErrorMessage(), dev);
-          continue;
-        }
+      if (!IsActStatusSuccess(act_status)) {
+        DeployErrorHandler(__func__, "Configure SnmpTrapSetting failed", act_status->GetErrorMessage(), dev);
+        return act_status;
       }
     }
+  }
 
-    // Deploy PortSetting(AdminStatus)
-    if (deploy_control.GetPortSetting()) {
-      auto port_setting_tables = dev_config.GetPortSettingTables();
-      if (port_setting_tables.contains(dev.GetId())) {
-        // Deploy
-        act_status = southbound_.ConfigurePortSetting(dev, port_setting_tables[dev.GetId()]);
-        if (deployer_stop_flag_) {
-          return ACT_STATUS_STOP;
-        }
-        if (!IsActStatusSuccess(act_status)) {
-          DeployErrorHandler(__func__, "Configure PortSetting failed", act_status->GetErrorMessage(), dev);
-          continue;
-        }
+  // Deploy SyslogSetting
+  if (deploy_control.GetSyslogSetting()) {
+    auto syslog_setting_tables = dev_config.GetSyslogSettingTables();
+    if (syslog_setting_tables.contains(dev.GetId()) &&
+        NeedDeployTable("SyslogSetting", baseline.GetSyslogSettingTables(), syslog_setting_tables, dev, force_deploy)) {
+      // Deploy
+      act_status = southbound_.ConfigureSyslogSetting(dev, syslog_setting_tables[dev.GetId()]);
+      if (deployer_stop_flag_) {
+        return ACT_STATUS_STOP;
+      }
+      if (!IsActStatusSuccess(act_status)) {
+        DeployErrorHandler(__func__, "Configure SyslogSetting failed", act_status->GetErrorMessage(), dev);
+        return act_status;
       }
     }
+  }
 
-    // Deploy LoopProtection
-    if (deploy_control.GetLoopProtection()) {
-      auto loop_protection_tables = dev_config.GetLoopProtectionTables();
-      if (loop_protection_tables.contains(dev.GetId())) {
-        // Deploy
-        act_status = southbound_.ConfigureLoopProtection(dev, loop_protection_tables[dev.GetId()]);
-        if (deployer_stop_flag_) {
-          return ACT_STATUS_STOP;
-        }
-        if (!IsActStatusSuccess(act_status)) {
-          DeployErrorHandler(__func__, "Configure LoopProtection failed", act_status->GetErrorMessage(), dev);
-          continue;
-        }
+  // Deploy TimeSetting
+  if (deploy_control.GetTimeSetting()) {
+    auto time_setting_tables = dev_config.GetTimeSettingTables();
+    if (time_setting_tables.contains(dev.GetId()) &&
+        NeedDeployTable("TimeSetting", baseline.GetTimeSettingTables(), time_setting_tables, dev, force_deploy)) {
+      // Deploy
+      act_status = southbound_.ConfigureTimeSetting(dev, time_setting_tables[dev.GetId()]);
+      if (deployer_stop_flag_) {
+        return ACT_STATUS_STOP;
+      }
+      if (!IsActStatusSuccess(act_status)) {
+        DeployErrorHandler(__func__, "Configure TimeSetting failed", act_status->GetErrorMessage(), dev);
+        return act_status;
       }
     }
+  }
 
-    // Update progress
-    quint8 new_progress = progress_ + (dev_progress_slot / dev_progress_update_times);
-    if (tsn_switch_retry_times == 0) {
-      UpdateProgress(new_progress);
+  // Deploy PortSetting(AdminStatus)
+  if (deploy_control.GetPortSetting()) {
+    auto port_setting_tables = dev_config.GetPortSettingTables();
+    if (port_setting_tables.contains(dev.GetId()) &&
+        NeedDeployTable("PortSetting", baseline.GetPortSettingTables(), port_setting_tables, dev, force_deploy)) {
+      // Deploy
+      act_status = southbound_.ConfigurePortSetting(dev, port_setting_tables[dev.GetId()]);
+      if (deployer_stop_flag_) {
+        return ACT_STATUS_STOP;
+      }
+      if (!IsActStatusSuccess(act_status)) {
+        DeployErrorHandler(__func__, "Configure PortSetting failed", act_status->GetErrorMessage(), dev);
+        return act_status;
+      }
     }
+  }
 
-    // Deploy VLAN(VlanStatic, PortVlan(PVID), VlanPortType)
-    if (deploy_control.GetVlan()) {
-      auto vlan_tables = dev_config.GetVlanTables();
-      if (vlan_tables.contains(dev.GetId())) {
-        // Deploy
-        act_status = southbound_.ConfigureVlan(dev, vlan_tables[dev.GetId()]);
-        if (deployer_stop_flag_) {
-          return ACT_STATUS_STOP;
-        }
-        if (!IsActStatusSuccess(act_status)) {
-          // Check TSN-Switch configuration sync
-          if (dev.GetDeviceProperty().GetFeatureGroup().GetConfiguration().GetCheckConfigSynchronization()) {
-            bool check_result = true;
-            CheckTSNSwitchConfigurationSynchronized(dev, dev_config, check_result);
-            if (check_result == false) {
-              tsn_switch_retry_times++;
-              if ((tsn_switch_retry_times <= ACT_DEPLOY_TSN_SWITCH_RETRY_TIMES)) {
-                goto start_deploy_flow;
-              }
-            }
-          }
-
-          DeployErrorHandler(__func__, "Configure VLAN failed", act_status->GetErrorMessage(), dev);
-          continue;
-        }
+  // Deploy LoopProtection
+  if (deploy_control.GetLoopProtection()) {
+    auto loop_protection_tables = dev_config.GetLoopProtectionTables();
+    if (loop_protection_tables.contains(dev.GetId()) &&
+        NeedDeployTable("LoopProtection", baseline.GetLoopProtectionTables(), loop_protection_tables, dev,
+                        force_deploy)) {
+      // Deploy
+      act_status = southbound_.ConfigureLoopProtection(dev, loop_protection_tables[dev.GetId()]);
+      if (deployer_stop_flag_) {
+        return ACT_STATUS_STOP;
+      }
+      if (!IsActStatusSuccess(act_status)) {
+        DeployErrorHandler(__func__, "Configure LoopProtection failed", act_status->GetErrorMessage(), dev);
+        return act_status;
       }
     }
+  }
 
-    // Update progress
-    new_progress = progress_ + (dev_progress_slot / dev_progress_update_times);
-    if (tsn_switch_retry_times == 0) {
-      UpdateProgress(new_progress);
-    }
+  // Update progress
+  if (tsn_switch_retry_times == 0) {
+    AddProgress(dev_progress_slot / dev_progress_update_times, 90);
+  }
 
-    // Deploy Port Default PCP
-    if (deploy_control.GetPortDefaultPcp()) {
-      auto port_default_pcp_tables = dev_config.GetPortDefaultPCPTables();
-      if (port_default_pcp_tables.contains(dev.GetId())) {
-        // Deploy
-        act_status = southbound_.ConfigurePortDefaultPCP(dev, port_default_pcp_tables[dev.GetId()]);
-        if (deployer_stop_flag_) {
-          return ACT_STATUS_STOP;
-        }
-        if (!IsActStatusSuccess(act_status)) {
-          DeployErrorHandler(__func__, "Configure Default PCP failed", act_status->GetErrorMessage(), dev);
-          continue;
-        }
+  // Deploy VLAN(VlanStatic, PortVlan(PVID), VlanPortType)
+  if (deploy_control.GetVlan()) {
+    auto vlan_tables = dev_config.GetVlanTables();
+    if (vlan_tables.contains(dev.GetId()) &&
+        NeedDeployTable("Vlan", baseline.GetVlanTables(), vlan_tables, dev, force_deploy)) {
+      // Deploy
+      act_status = southbound_.ConfigureVlan(dev, vlan_tables[dev.GetId()]);
+      if (deployer_stop_flag_) {
+        return ACT_STATUS_STOP;
       }
-    }
-
-    // Deploy UnicastStaticForward
-    if (deploy_control.GetUnicastStaticForward()) {
-      auto uni_static_forward_tables = dev_config.GetUnicastStaticForwardTables();
-      if (uni_static_forward_tables.contains(dev.GetId())) {
-        // Deploy
-        act_status = southbound_.ConfigureStaticForward(dev, uni_static_forward_tables[dev.GetId()], true);
-        if (deployer_stop_flag_) {
-          return ACT_STATUS_STOP;
-        }
-        if (!IsActStatusSuccess(act_status)) {
-          // Check TSN-Switch configuration sync
-          if (dev.GetDeviceProperty().GetFeatureGroup().GetConfiguration().GetCheckConfigSynchronization()) {
-            bool check_result = true;
-            CheckTSNSwitchConfigurationSynchronized(dev, dev_config, check_result);
-            if (check_result == false) {
-              tsn_switch_retry_times++;
-              if ((tsn_switch_retry_times <= ACT_DEPLOY_TSN_SWITCH_RETRY_TIMES)) {
-                goto start_deploy_flow;
-              }
+      if (!IsActStatusSuccess(act_status)) {
+        // Check TSN-Switch configuration sync
+        if (dev.GetDeviceProperty().GetFeatureGroup().GetConfiguration().GetCheckConfigSynchronization()) {
+          bool check_result = true;
+          CheckTSNSwitchConfigurationSynchronized(dev, dev_config, check_result);
+          if (check_result == false) {
+            tsn_switch_retry_times++;
+            if ((tsn_switch_retry_times <= ACT_DEPLOY_TSN_SWITCH_RETRY_TIMES)) {
+              goto start_deploy_flow;
             }
           }
-
-          DeployErrorHandler(__func__, "Configure Unicast Static Forward failed", act_status->GetErrorMessage(), dev);
-          continue;
         }
+
+        DeployErrorHandler(__func__, "Configure VLAN failed", act_status->GetErrorMessage(), dev);
+        return act_status;
       }
     }
+  }
 
-    // Deploy MulticastStaticForward
-    if (deploy_control.GetMulticastStaticForward()) {
-      auto mul_static_forward_tables = dev_config.GetMulticastStaticForwardTables();
-      if (mul_static_forward_tables.contains(dev.GetId())) {
-        // Deploy
-        act_status = southbound_.ConfigureStaticForward(dev, mul_static_forward_tables[dev.GetId()], false);
-        if (deployer_stop_flag_) {
-          return ACT_STATUS_STOP;
-        }
-        if (!IsActStatusSuccess(act_status)) {
-          // Check TSN-Switch configuration sync
-          if (dev.GetDeviceProperty().GetFeatureGroup().GetConfiguration().GetCheckConfigSynchronization()) {
-            bool check_result = true;
-            CheckTSNSwitchConfigurationSynchronized(dev, dev_config, check_result);
-            if (check_result == false) {
-              tsn_switch_retry_times++;
-              if ((tsn_switch_retry_times <= ACT_DEPLOY_TSN_SWITCH_RETRY_TIMES)) {
-                goto start_deploy_flow;
-              }
-            }
-          }
+  // Update progress
+  if (tsn_switch_retry_times == 0) {
+    AddProgress(dev_progress_slot / dev_progress_update_times, 90);
+  }
 
-          DeployErrorHandler(__func__, "Configure Multicast Static Forward failed", act_status->GetErrorMessage(), dev);
-          continue;
-        }
+  // Deploy Port Default PCP
+  if (deploy_control.GetPortDefaultPcp()) {
+    auto port_default_pcp_tables = dev_config.GetPortDefaultPCPTables();
+    if (port_default_pcp_tables.contains(dev.GetId()) &&
+        NeedDeployTable("PortDefaultPCP", baseline.GetPortDefaultPCPTables(), port_default_pcp_tables, dev,
+                        force_deploy)) {
+      // Deploy
+      act_status = southbound_.ConfigurePortDefaultPCP(dev, port_default_pcp_tables[dev.GetId()]);
+      if (deployer_stop_flag_) {
+        return ACT_STATUS_STOP;
+      }
+      if (!IsActStatusSuccess(act_status)) {
+        DeployErrorHandler(__func__, "Configure Default PCP failed", act_status->GetErrorMessage(), dev);
+        return act_status;
       }
     }
+  }
 
-    // Deploy StreamPriorityIngress
-    if (deploy_control.GetStreamPriorityIngress()) {
-      auto stad_ingress_tables = dev_config.GetStreamPriorityIngressTables();
-      if (stad_ingress_tables.contains(dev.GetId())) {
-        // Deploy
-        act_status = southbound_.ConfigureStreamPriorityIngress(dev, stad_ingress_tables[dev.GetId()]);
-        if (deployer_stop_flag_) {
-          return ACT_STATUS_STOP;
-        }
-        if (!IsActStatusSuccess(act_status)) {
-          // Check TSN-Switch configuration sync
-          if (dev.GetDeviceProperty().GetFeatureGroup().GetConfiguration().GetCheckConfigSynchronization()) {
-            bool check_result = true;
-            CheckTSNSwitchConfigurationSynchronized(dev, dev_config, check_result);
-            if (check_result == false) {
-              tsn_switch_retry_times++;
-              if ((tsn_switch_retry_times <= ACT_DEPLOY_TSN_SWITCH_RETRY_TIMES)) {
-                goto start_deploy_flow;
-              }
+  // Deploy UnicastStaticForward
+  if (deploy_control.GetUnicastStaticForward()) {
+    auto uni_static_forward_tables = dev_config.GetUnicastStaticForwardTables();
+    if (uni_static_forward_tables.contains(dev.GetId()) &&
+        NeedDeployTable("UnicastStaticForward", baseline.GetUnicastStaticForwardTables(), uni_static_forward_tables,
+                        dev, force_deploy)) {
+      // Deploy
+      act_status = southbound_.ConfigureStaticForward(dev, uni_static_forward_tables[dev.GetId()], true);
+      if (deployer_stop_flag_) {
+        return ACT_STATUS_STOP;
+      }
+      if (!IsActStatusSuccess(act_status)) {
+        // Check TSN-Switch configuration sync
+        if (dev.GetDeviceProperty().GetFeatureGroup().GetConfiguration().GetCheckConfigSynchronization()) {
+          bool check_result = true;
+          CheckTSNSwitchConfigurationSynchronized(dev, dev_config, check_result);
+          if (check_result == false) {
+            tsn_switch_retry_times++;
+            if ((tsn_switch_retry_times <= ACT_DEPLOY_TSN_SWITCH_RETRY_TIMES)) {
+              goto start_deploy_flow;
             }
           }
-
-          DeployErrorHandler(__func__, "Configure Per-Stream Priority (Ingress) failed", act_status->GetErrorMessage(),
-                             dev);
-          continue;
         }
-      }
-    }
 
-    // Deploy StreamPriorityEgress
-    if (deploy_control.GetStreamPriorityEgress()) {
-      auto stad_egress_tables = dev_config.GetStreamPriorityEgressTables();
-      if (stad_egress_tables.contains(dev.GetId())) {
-        // Deploy
-        act_status = southbound_.ConfigureStreamPriorityEgress(dev, stad_egress_tables[dev.GetId()]);
-        if (deployer_stop_flag_) {
-          return ACT_STATUS_STOP;
-        }
-        if (!IsActStatusSuccess(act_status)) {
-          DeployErrorHandler(__func__, "Configure Per-Stream Priority (Egress) failed", act_status->GetErrorMessage(),
-                             dev);
-          continue;
-        }
+        DeployErrorHandler(__func__, "Configure Unicast Static Forward failed", act_status->GetErrorMessage(), dev);
+        return act_status;
       }
     }
+  }
 
-    // Update progress
-    new_progress = progress_ + (dev_progress_slot / dev_progress_update_times);
-    if (tsn_switch_retry_times == 0) {
-      UpdateProgress(new_progress);
-    }
-
-    // Deploy Spanning Tree
-    if (deploy_control.GetSpanningTree()) {
-      auto rstp_tables = dev_config.GetRstpTables();
-      if (rstp_tables.contains(dev.GetId())) {
-        // Deploy
-        act_status = southbound_.ConfigureSpanningTree(dev, rstp_tables[dev.GetId()]);
-        if (deployer_stop_flag_) {
-          return ACT_STATUS_STOP;
-        }
-        if (!IsActStatusSuccess(act_status)) {
-          DeployErrorHandler(__func__, "Configure Spanning Tree failed", act_status->GetErrorMessage(), dev);
-          continue;
-        }
+  // Deploy MulticastStaticForward
+  if (deploy_control.GetMulticastStaticForward()) {
+    auto mul_static_forward_tables = dev_config.GetMulticastStaticForwardTables();
+    if (mul_static_forward_tables.contains(dev.GetId()) &&
+        NeedDeployTable("MulticastStaticForward", baseline.GetMulticastStaticForwardTables(), mul_static_forward_tables,
+                        dev, force_deploy)) {
+      // Deploy
+      act_status = southbound_.ConfigureStaticForward(dev, mul_static_forward_tables[dev.GetId()], false);
+      if (deployer_stop_flag_) {
+        return ACT_STATUS_STOP;
       }
-    }
-
-    // NETCONF(802.1CB, 802.1Qbv)
-    // Check TSN-Switch configuration sync
-    if (deploy_control.GetIeee802Dot1Cb()) {
-      auto ieee_802_1cb_table = dev_config.GetCbTables();
-      if (ieee_802_1cb_table.contains(dev.GetId())) {
+      if (!IsActStatusSuccess(act_status)) {
+        // Check TSN-Switch configuration sync
         if (dev.GetDeviceProperty().GetFeatureGroup().GetConfiguration().GetCheckConfigSynchronization()) {
           bool check_result = true;
-          act_status = CheckTSNSwitchConfigurationSynchronized(dev, dev_config, check_result);
-          if (deployer_stop_flag_) {
-            return ACT_STATUS_STOP;
-          }
-          if (!IsActStatusSuccess(act_status)) {
-            DeployErrorHandler(__func__, "Check Device configuration status failed", act_status->GetErrorMessage(),
-                               dev);
-            continue;
-          }
+          CheckTSNSwitchConfigurationSynchronized(dev, dev_config, check_result);
           if (check_result == false) {
             tsn_switch_retry_times++;
             if ((tsn_switch_retry_times <= ACT_DEPLOY_TSN_SWITCH_RETRY_TIMES)) {
               goto start_deploy_flow;
-            } else {  // retry 3 times failed
-              DeployErrorHandler(__func__, "Device configuration not synchronized", act_status->GetErrorMessage(), dev);
-              continue;
             }
           }
         }
-      }
-    }
 
-    act_status = ConfigureNetconf(dev, deploy_control, dev_config);
-    if (deployer_stop_flag_) {
-      return ACT_STATUS_STOP;
-    }
-    if (!IsActStatusSuccess(act_status)) {
-      // Check TSN-Switch configuration sync
-      if (dev.GetDeviceProperty().GetFeatureGroup().GetConfiguration().GetCheckConfigSynchronization()) {
-        bool check_result = true;
-        CheckTSNSwitchConfigurationSynchronized(dev, dev_config, check_result);
-        if (check_result == false) {
-          tsn_switch_retry_times++;
-          if ((tsn_switch_retry_times <= ACT_DEPLOY_TSN_SWITCH_RETRY_TIMES)) {
-            goto start_deploy_flow;
-          }
-        }
+        DeployErrorHandler(__func__, "Configure Multicast Static Forward failed", act_status->GetErrorMessage(), dev);
+        return act_status;
       }
-      DeployErrorHandler(__func__, "Configure NETCONF failed", act_status->GetErrorMessage(), dev);
-      continue;
     }
+  }
 
-    // Reboot
-    if (deploy_control.GetReboot()) {
-      act_status = Reboot(dev);
+  // Deploy StreamPriorityIngress
+  if (deploy_control.GetStreamPriorityIngress()) {
+    auto stad_ingress_tables = dev_config.GetStreamPriorityIngressTables();
+    if (stad_ingress_tables.contains(dev.GetId()) &&
+        NeedDeployTable("StreamPriorityIngress", baseline.GetStreamPriorityIngressTables(), stad_ingress_tables, dev,
+                        force_deploy)) {
+      // Deploy
+      act_status = southbound_.ConfigureStreamPriorityIngress(dev, stad_ingress_tables[dev.GetId()]);
       if (deployer_stop_flag_) {
         return ACT_STATUS_STOP;
       }
       if (!IsActStatusSuccess(act_status)) {
-        DeployErrorHandler(__func__, "Reboot failed", act_status->GetErrorMessage(), dev);
-        continue;
+        // Check TSN-Switch configuration sync
+        if (dev.GetDeviceProperty().GetFeatureGroup().GetConfiguration().GetCheckConfigSynchronization()) {
+          bool check_result = true;
+          CheckTSNSwitchConfigurationSynchronized(dev, dev_config, check_result);
+          if (check_result == false) {
+            tsn_switch_retry_times++;
+            if ((tsn_switch_retry_times <= ACT_DEPLOY_TSN_SWITCH_RETRY_TIMES)) {
+              goto start_deploy_flow;
+            }
+          }
+        }
+
+        DeployErrorHandler(__func__, "Configure Per-Stream Priority (Ingress) failed", act_status->GetErrorMessage(),
+                           dev);
+        return act_status;
       }
     }
+  }
 
-    // FactoryDefault
-    if (deploy_control.GetFactoryDefault()) {
-      act_status = FactoryDefault(dev);
+  // Deploy StreamPriorityEgress
+  if (deploy_control.GetStreamPriorityEgress()) {
+    auto stad_egress_tables = dev_config.GetStreamPriorityEgressTables();
+    if (stad_egress_tables.contains(dev.GetId()) &&
+        NeedDeployTable("StreamPriorityEgress", baseline.GetStreamPriorityEgressTables(), stad_egress_tables, dev,
+                        force_deploy)) {
+      // Deploy
+      act_status = southbound_.ConfigureStreamPriorityEgress(dev, stad_egress_tables[dev.GetId()]);
       if (deployer_stop_flag_) {
         return ACT_STATUS_STOP;
       }
       if (!IsActStatusSuccess(act_status)) {
-        DeployErrorHandler(__func__, "Factory Default failed", act_status->GetErrorMessage(), dev);
-        continue;
+        DeployErrorHandler(__func__, "Configure Per-Stream Priority (Egress) failed", act_status->GetErrorMessage(),
+                           dev);
+        return act_status;
       }
     }
+  }
 
-    // FirmwareUpgrade
-    if (deploy_control.GetFirmwareUpgrade()) {
-      // Check Parameter > FirmwareName
-      auto parameter_fw = dynamic_cast<ActDeployParameterFirmware *>(parameter_base);
-      if (parameter_fw->GetFirmwareName().isEmpty()) {
-        DeployErrorHandler(__func__, "The FirmwareName parameter is empty", act_status->GetErrorMessage(), dev);
-        continue;
-      }
+  // Update progress
+  if (tsn_switch_retry_times == 0) {
+    AddProgress(dev_progress_slot / dev_progress_update_times, 90);
+  }
 
-      act_status = FirmwareUpgrade(dev, parameter_fw->GetFirmwareName());
+  // Deploy Spanning Tree
+  if (deploy_control.GetSpanningTree()) {
+    auto rstp_tables = dev_config.GetRstpTables();
+    if (rstp_tables.contains(dev.GetId()) &&
+        NeedDeployTable("SpanningTree", baseline.GetRstpTables(), rstp_tables, dev, force_deploy)) {
+      // Deploy
+      act_status = southbound_.ConfigureSpanningTree(dev, rstp_tables[dev.GetId()]);
       if (deployer_stop_flag_) {
         return ACT_STATUS_STOP;
       }
       if (!IsActStatusSuccess(act_status)) {
-        DeployErrorHandler(__func__, "Firmware Upgrade failed", act_status->GetErrorMessage(), dev);
-        continue;
+        DeployErrorHandler(__func__, "Configure Spanning Tree failed", act_status->GetErrorMessage(), dev);
+        return act_status;
+      }
+    }
+  }
+
+  // NETCONF(802.1CB, 802.1Qbv)
+  // Check TSN-Switch configuration sync
+  if (deploy_control.GetIeee802Dot1Cb()) {
+    auto ieee_802_1cb_table = dev_config.GetCbTables();
+    if (ieee_802_1cb_table.contains(dev.GetId())) {
+      if (dev.GetDeviceProperty().GetFeatureGroup().GetConfiguration().GetCheckConfigSynchronization()) {
+        bool check_result = true;
+        act_status = CheckTSNSwitchConfigurationSynchronized(dev, dev_config, check_result);
+        if (deployer_stop_flag_) {
+          return ACT_STATUS_STOP;
+        }
+        if (!IsActStatusSuccess(act_status)) {
+          DeployErrorHandler(__func__, "Check Device configuration status failed", act_status->GetErrorMessage(),
+                             dev);
+          return act_status;
+        }
+        if (check_result == false) {
+          tsn_switch_retry_times++;
+          if ((tsn_switch_retry_times <= ACT_DEPLOY_TSN_SWITCH_RETRY_TIMES)) {
+            goto start_deploy_flow;
+          } else {  // retry 3 times failed
+            DeployErrorHandler(__func__, "Device configuration not synchronized", act_status->GetErrorMessage(), dev);
+            return act_status;
+          }
+        }
       }
     }
+  }
 
+  act_status = ConfigureNetconf(dev, deploy_control, dev_config);
+  if (deployer_stop_flag_) {
+    return ACT_STATUS_STOP;
+  }
+  if (!IsActStatusSuccess(act_status)) {
     // Check TSN-Switch configuration sync
     if (dev.GetDeviceProperty().GetFeatureGroup().GetConfiguration().GetCheckConfigSynchronization()) {
       bool check_result = true;
-      act_status = CheckTSNSwitchConfigurationSynchronized(dev, dev_config, check_result);
-      if (deployer_stop_flag_) {
-        return ACT_STATUS_STOP;
-      }
-      if (!IsActStatusSuccess(act_status)) {
-        DeployErrorHandler(__func__, "Check Device configuration status failed", act_status->GetErrorMessage(), dev);
-        continue;
-      }
+      CheckTSNSwitchConfigurationSynchronized(dev, dev_config, check_result);
       if (check_result == false) {
         tsn_switch_retry_times++;
         if ((tsn_switch_retry_times <= ACT_DEPLOY_TSN_SWITCH_RETRY_TIMES)) {
           goto start_deploy_flow;
-        } else {  // retry 3 times failed
-          DeployErrorHandler(__func__, "Device configuration not synchronized", act_status->GetErrorMessage(), dev);
-          continue;
         }
       }
     }
+    DeployErrorHandler(__func__, "Configure NETCONF failed", act_status->GetErrorMessage(), dev);
+    return act_status;
+  }
 
-    // Add success result to result_queue_
-    result_queue_.enqueue(ActDeviceConfigureResult(dev.GetId(), progress_, ActStatusType::kSuccess));
+  // Reboot
+  if (deploy_control.GetReboot()) {
+    act_status = Reboot(dev);
+    if (deployer_stop_flag_) {
+      return ACT_STATUS_STOP;
+    }
+    if (!IsActStatusSuccess(act_status)) {
+      DeployErrorHandler(__func__, "Reboot failed", act_status->GetErrorMessage(), dev);
+      return act_status;
+    }
+  }
 
-    // Update progress(30~90)
-    new_progress = progress_ + (dev_progress_slot / dev_progress_update_times);
-    if (new_progress >= 90) {
-      UpdateProgress(90);
-    } else {
-      UpdateProgress(new_progress);
+  // FactoryDefault
+  if (deploy_control.GetFactoryDefault()) {
+    act_status = FactoryDefault(dev);
+    if (deployer_stop_flag_) {
+      return ACT_STATUS_STOP;
+    }
+    if (!IsActStatusSuccess(act_status)) {
+      DeployErrorHandler(__func__, "Factory Default failed", act_status->GetErrorMessage(), dev);
+      return act_status;
     }
   }
 
-  SLEEP_MS(100);
-  UpdateProgress(100);
-  act_status = ACT_STATUS_SUCCESS;
+  // FirmwareUpgrade
+  if (deploy_control.GetFirmwareUpgrade()) {
+    // Check Parameter > FirmwareName
+    auto parameter_fw = dynamic_cast<ActDeployParameterFirmware *>(parameter_base);
+    if (parameter_fw->GetFirmwareName().isEmpty()) {
+      DeployErrorHandler(__func__, "The FirmwareName parameter is empty", act_status->GetErrorMessage(), dev);
+      return act_status;
+    }
+
+    act_status = FirmwareUpgrade(dev, parameter_fw->GetFirmwareName());
+    if (deployer_stop_flag_) {
+      return ACT_STATUS_STOP;
+    }
+    if (!IsActStatusSuccess(act_status)) {
+      DeployErrorHandler(__func__, "Firmware Upgrade failed", act_status->GetErrorMessage(), dev);
+      return act_status;
+    }
+  }
+
+  // Check TSN-Switch configuration sync
+  if (dev.GetDeviceProperty().GetFeatureGroup().GetConfiguration().GetCheckConfigSynchronization()) {
+    bool check_result = true;
+    act_status = CheckTSNSwitchConfigurationSynchronized(dev, dev_config, check_result);
+    if (deployer_stop_flag_) {
+      return ACT_STATUS_STOP;
+    }
+    if (!IsActStatusSuccess(act_status)) {
+      DeployErrorHandler(__func__, "Check Device configuration status failed", act_status->GetErrorMessage(), dev);
+      return act_status;
+    }
+    if (check_result == false) {
+      tsn_switch_retry_times++;
+      if ((tsn_switch_retry_times <= ACT_DEPLOY_TSN_SWITCH_RETRY_TIMES)) {
+        goto start_deploy_flow;
+      } else {  // retry 3 times failed
+        DeployErrorHandler(__func__, "Device configuration not synchronized", act_status->GetErrorMessage(), dev);
+        return act_status;
+      }
+    }
+  }
+
+  // Add success result to result_queue_
+  {
+    QMutexLocker lock(&mutex_);
+    result_queue_.enqueue(ActDeviceConfigureResult(dev.GetId(), progress_, ActStatusType::kSuccess));
+  }
+
+  // Update progress(30~90)
+  AddProgress(dev_progress_slot / dev_progress_update_times, 90);
+
   return act_status;
 }
 
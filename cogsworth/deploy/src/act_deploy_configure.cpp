@@ -5,7 +5,7 @@
 #define SLEEP_MS(ms) Sleep(ms)
 #else
 #include <unistd.h>  // for sleep
-#define SLEEP_MS(ms) sleep(ms / 1000)
+#define SLEEP_MS(ms) usleep((ms) * 1000)
 #endif
 
 ACT_STATUS act::deploy::ActDeploy::Reboot(const ActDevice &device) {
@@ -169,6 +169,9 @@ ACT_STATUS act::deploy::ActDeploy::DeployNetworkSetting(const ActDevice &device,
   qDebug() << __func__
            << QString("Device(%1) is under processing.").arg(device.GetIpv4().GetIpAddress()).toStdString().c_str();
 
+  // The localhost ARP table is shared by the deploy workers
+  QMutexLocker arp_lock(&arp_mutex_);
+
   // Set ArpTable
   if (from_broadcast_search) {  // has mac
     // Check Map has device's mac
@@ -227,9 +230,11 @@ ACT_STATUS act::deploy::ActDeploy::DeployNetworkSetting(const ActDevice &device,
     return ACT_STATUS_STOP;
   }
 
-  // Check icmp status
-  SLEEP_MS(1000);
-  act_status = southbound_.PingIpAddress(network_setting_table.GetIpAddress(), ACT_PING_REPEAT_TIMES);
+  // Check icmp status (wait until the new IP is reachable)
+  act_status = southbound_.WaitIpAddressReachable(network_setting_table.GetIpAddress());
+  if (IsActStatusStop(act_status)) {
+    return act_status;
+  }
   if (!IsActStatusSuccess(act_status)) {  // not alive
     qCritical() << __func__ << "Check the New NetworkSetting connect failed.";
     return act_status;
@@ -245,6 +250,9 @@ ACT_STATUS act::deploy::ActDeploy::DeployMappingDeviceIpSetting(
   qDebug() << __func__
            << QString("Device(%1) is under processing.").arg(device.GetIpv4().GetIpAddress()).toStdString().c_str();
 
+  // The localhost ARP table is shared by the deploy workers
+  QMutexLocker arp_lock(&arp_mutex_);
+
   // Generate new device for online_device(IP & MAC)
   ActDevice online_device(device);
   online_device.GetIpv4().SetIpAddress(ip_setting_table.GetOnlineIP());
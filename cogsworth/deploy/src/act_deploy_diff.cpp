@@ -0,0 +1,178 @@
+/* Copyright (C) MOXA Inc. All rights reserved.
+This software is distributed under the terms of the MOXA SOFTWARE NOTICE.
+See the file MOXA-SOFTWARE-NOTICE for details.
+*/
+
+#include "act_deploy_diff.hpp"
+
+#include "act_deploy.hpp"
+
+namespace {
+
+template <class T>
+void PlanTable(const act::deploy::ActDeployDiff &diff, const QString &table_name,
+               const QMap<qint64, T> &baseline_tables, const QMap<qint64, T> &tables, const qint64 &device_id,
+               act::deploy::ActDeployPlan &plan) {
+  if (!tables.contains(device_id) || !diff.IsChanged(baseline_tables, tables, device_id)) {
+    return;
+  }
+
+  auto action = (diff.IsEnabled() && baseline_tables.contains(device_id))
+                    ? act::deploy::ActDeployTableChangeEnum::kUpdate
+                    : act::deploy::ActDeployTableChangeEnum::kCreate;
+  plan.GetChanges().append(act::deploy::ActDeployTableChange(device_id, table_name, action));
+}
+
+template <class T>
+void UpdateTable(QMap<qint64, T> &baseline_tables, const QMap<qint64, T> &tables, const qint64 &device_id) {
+  auto table_it = tables.constFind(device_id);
+  if (table_it == tables.constEnd()) {
+    baseline_tables.remove(device_id);
+  } else {
+    baseline_tables.insert(device_id, table_it.value());
+  }
+}
+
+}  // namespace
+
+void act::deploy::ActDeployDiff::GeneratePlan(const ActDeviceConfig &device_config, const QList<qint64> &dev_id_list,
+                                              const ActDeployControl &deploy_control, ActDeployPlan &plan) const {
+  const ActDeviceConfig &baseline = baseline_device_config_;
+
+  for (const auto &id : dev_id_list) {
+    if (deploy_control.GetNetworkSetting()) {
+      PlanTable(*this, "NetworkSetting", baseline.GetNetworkSettingTables(), device_config.GetNetworkSettingTables(),
+                id, plan);
+    }
+    if (deploy_control.GetLoginPolicy()) {
+      PlanTable(*this, "LoginPolicy", baseline.GetLoginPolicyTables(), device_config.GetLoginPolicyTables(), id, plan);
+    }
+    if (deploy_control.GetInformationSetting()) {
+      PlanTable(*this, "InformationSetting", baseline.GetInformationSettingTables(),
+                device_config.GetInformationSettingTables(), id, plan);
+    }
+    if (deploy_control.GetSnmpTrapSetting()) {
+      PlanTable(*this, "SnmpTrapSetting", baseline.GetSnmpTrapSettingTables(),
+                device_config.GetSnmpTrapSettingTables(), id, plan);
+    }
+    if (deploy_control.GetSyslogSetting()) {
+      PlanTable(*this, "SyslogSetting", baseline.GetSyslogSettingTables(), device_config.GetSyslogSettingTables(), id,
+                plan);
+    }
+    if (deploy_control.GetTimeSetting()) {
+      PlanTable(*this, "TimeSetting", baseline.GetTimeSettingTables(), device_config.GetTimeSettingTables(), id, plan);
+    }
+    if (deploy_control.GetPortSetting()) {
+      PlanTable(*this, "PortSetting", baseline.GetPortSettingTables(), device_config.GetPortSettingTables(), id, plan);
+    }
+    if (deploy_control.GetLoopProtection()) {
+      PlanTable(*this, "LoopProtection", baseline.GetLoopProtectionTables(), device_config.GetLoopProtectionTables(),
+                id, plan);
+    }
+    if (deploy_control.GetVlan()) {
+      PlanTable(*this, "Vlan", baseline.GetVlanTables(), device_config.GetVlanTables(), id, plan);
+    }
+    if (deploy_control.GetPortDefaultPcp()) {
+      PlanTable(*this, "PortDefaultPCP", baseline.GetPortDefaultPCPTables(), device_config.GetPortDefaultPCPTables(),
+                id, plan);
+    }
+    if (deploy_control.GetUnicastStaticForward()) {
+      PlanTable(*this, "UnicastStaticForward", baseline.GetUnicastStaticForwardTables(),
+                device_config.GetUnicastStaticForwardTables(), id, plan);
+    }
+    if (deploy_control.GetMulticastStaticForward()) {
+      PlanTable(*this, "MulticastStaticForward", baseline.GetMulticastStaticForwardTables(),
+                device_config.GetMulticastStaticForwardTables(), id, plan);
+    }
+    if (deploy_control.GetStreamPriorityIngress()) {
+      PlanTable(*this, "StreamPriorityIngress", baseline.GetStreamPriorityIngressTables(),
+                device_config.GetStreamPriorityIngressTables(), id, plan);
+    }
+    if (deploy_control.GetStreamPriorityEgress()) {
+      PlanTable(*this, "StreamPriorityEgress", baseline.GetStreamPriorityEgressTables(),
+                device_config.GetStreamPriorityEgressTables(), id, plan);
+    }
+    if (deploy_control.GetSpanningTree()) {
+      PlanTable(*this, "SpanningTree", baseline.GetRstpTables(), device_config.GetRstpTables(), id, plan);
+    }
+  }
+}
+
+void act::deploy::ActDeployDiff::UpdateBaseline(ActDeviceConfig &baseline_device_config,
+                                                const ActDeviceConfig &device_config,
+                                                const ActDeployControl &deploy_control, const qint64 &device_id) {
+  ActDeviceConfig &baseline = baseline_device_config;
+
+  if (deploy_control.GetNetworkSetting()) {
+    UpdateTable(baseline.GetNetworkSettingTables(), device_config.GetNetworkSettingTables(), device_id);
+  }
+  if (deploy_control.GetLoginPolicy()) {
+    UpdateTable(baseline.GetLoginPolicyTables(), device_config.GetLoginPolicyTables(), device_id);
+  }
+  if (deploy_control.GetInformationSetting()) {
+    UpdateTable(baseline.GetInformationSettingTables(), device_config.GetInformationSettingTables(), device_id);
+  }
+  if (deploy_control.GetSnmpTrapSetting()) {
+    UpdateTable(baseline.GetSnmpTrapSettingTables(), device_config.GetSnmpTrapSettingTables(), device_id);
+  }
+  if (deploy_control.GetSyslogSetting()) {
+    UpdateTable(baseline.GetSyslogSettingTables(), device_config.GetSyslogSettingTables(), device_id);
+  }
+  if (deploy_control.GetTimeSetting()) {
+    UpdateTable(baseline.GetTimeSettingTables(), device_config.GetTimeSettingTables(), device_id);
+  }
+  if (deploy_control.GetPortSetting()) {
+    UpdateTable(baseline.GetPortSettingTables(), device_config.GetPortSettingTables(), device_id);
+  }
+  if (deploy_control.GetLoopProtection()) {
+    UpdateTable(baseline.GetLoopProtectionTables(), device_config.GetLoopProtectionTables(), device_id);
+  }
+  if (deploy_control.GetVlan()) {
+    UpdateTable(baseline.GetVlanTables(), device_config.GetVlanTables(), device_id);
+  }
+  if (deploy_control.GetPortDefaultPcp()) {
+    UpdateTable(baseline.GetPortDefaultPCPTables(), device_config.GetPortDefaultPCPTables(), device_id);
+  }
+  if (deploy_control.GetUnicastStaticForward()) {
+    UpdateTable(baseline.GetUnicastStaticForwardTables(), device_config.GetUnicastStaticForwardTables(), device_id);
+  }
+  if (deploy_control.GetMulticastStaticForward()) {
+    UpdateTable(baseline.GetMulticastStaticForwardTables(), device_config.GetMulticastStaticForwardTables(),
+                device_id);
+  }
+  if (deploy_control.GetStreamPriorityIngress()) {
+    UpdateTable(baseline.GetStreamPriorityIngressTables(), device_config.GetStreamPriorityIngressTables(), device_id);
+  }
+  if (deploy_control.GetStreamPriorityEgress()) {
+    UpdateTable(baseline.GetStreamPriorityEgressTables(), device_config.GetStreamPriorityEgressTables(), device_id);
+  }
+  if (deploy_control.GetSpanningTree()) {
+    UpdateTable(baseline.GetRstpTables(), device_config.GetRstpTables(), device_id);
+  }
+}
+
+void act::deploy::ActDeployDiff::RemoveBaseline(ActDeviceConfig &baseline_device_config, const qint64 &device_id) {
+  ActDeviceConfig &baseline = baseline_device_config;
+
+  baseline.GetMappingDeviceIpSettingTables().remove(device_id);
+  baseline.GetNetworkSettingTables().remove(device_id);
+  baseline.GetUserAccountTables().remove(device_id);
+  baseline.GetTimeSyncTables().remove(device_id);
+  baseline.GetLoginPolicyTables().remove(device_id);
+  baseline.GetLoopProtectionTables().remove(device_id);
+  baseline.GetSnmpTrapSettingTables().remove(device_id);
+  baseline.GetSyslogSettingTables().remove(device_id);
+  baseline.GetTimeSettingTables().remove(device_id);
+  baseline.GetInformationSettingTables().remove(device_id);
+  baseline.GetManagementInterfaceTables().remove(device_id);
+  baseline.GetPortSettingTables().remove(device_id);
+  baseline.GetVlanTables().remove(device_id);
+  baseline.GetUnicastStaticForwardTables().remove(device_id);
+  baseline.GetMulticastStaticForwardTables().remove(device_id);
+  baseline.GetPortDefaultPCPTables().remove(device_id);
+  baseline.GetStreamPriorityIngressTables().remove(device_id);
+  baseline.GetStreamPriorityEgressTables().remove(device_id);
+  baseline.GetGCLTables().remove(device_id);
+  baseline.GetCbTables().remove(device_id);
+  baseline.GetRstpTables().remove(device_id);
+}
@@ -0,0 +1,89 @@
+#include "act_deploy_diff.hpp"
+
+#include "act_deploy.hpp"
+#include "act_unit_test.hpp"
+
+namespace act {
+namespace deploy {
+
+class ActDeployDiffTest : public ActQuickTest {
+ protected:
+  ActDeviceConfig device_config;
+  ActDeployControl deploy_ctrl;
+  QList<qint64> dev_id_list = {1, 2};
+
+  void SetUp() override {
+    deploy_ctrl.SetLoginPolicy(true);
+    deploy_ctrl.SetVlan(true);
+
+    for (auto dev_id : dev_id_list) {
+      ActVlanTable vlan_table(dev_id);
+      vlan_table.SetManagementVlan(1);
+      device_config.GetVlanTables().insert(dev_id, vlan_table);
+
+      ActLoginPolicyTable login_policy_table(dev_id);
+      login_policy_table.SetLoginMessage("Welcome");
+      device_config.GetLoginPolicyTables().insert(dev_id, login_policy_table);
+    }
+  }
+};
+
+TEST_F(ActDeployDiffTest, TestNoBaseline) {
+  ActDeployDiff deploy_diff;
+  ActDeployPlan plan;
+  deploy_diff.GeneratePlan(device_config, dev_id_list, deploy_ctrl, plan);
+
+  // Every table is created
+  EXPECT_EQ(4, plan.GetChanges().size());
+  for (auto &change : plan.GetChanges()) {
+    EXPECT_EQ(ActDeployTableChangeEnum::kCreate, change.GetAction());
+  }
+}
+
+TEST_F(ActDeployDiffTest, TestOnlyChangedTable) {
+  ActDeviceConfig baseline;
+  for (auto dev_id : dev_id_list) {
+    ActDeployDiff::UpdateBaseline(baseline, device_config, deploy_ctrl, dev_id);
+  }
+
+  // Nothing changed
+  ActDeployPlan plan;
+  ActDeployDiff(baseline).GeneratePlan(device_config, dev_id_list, deploy_ctrl, plan);
+  EXPECT_TRUE(plan.GetChanges().isEmpty());
+
+  // Change the VLAN of the device 2
+  device_config.GetVlanTables()[2].SetManagementVlan(100);
+  ActDeployDiff(baseline).GeneratePlan(device_config, dev_id_list, deploy_ctrl, plan);
+  ASSERT_EQ(1, plan.GetChanges().size());
+  EXPECT_EQ(2, plan.GetChanges().first().GetDeviceId());
+  EXPECT_EQ("Vlan", plan.GetChanges().first().GetTable());
+  EXPECT_EQ(ActDeployTableChangeEnum::kUpdate, plan.GetChanges().first().GetAction());
+
+  // The disabled table is not planned
+  ActDeployControl login_policy_ctrl;
+  login_policy_ctrl.SetLoginPolicy(true);
+  plan.GetChanges().clear();
+  ActDeployDiff(baseline).GeneratePlan(device_config, dev_id_list, login_policy_ctrl, plan);
+  EXPECT_TRUE(plan.GetChanges().isEmpty());
+}
+
+TEST_F(ActDeployDiffTest, TestRemoveBaseline) {
+  ActDeviceConfig baseline;
+  for (auto dev_id : dev_id_list) {
+    ActDeployDiff::UpdateBaseline(baseline, device_config, deploy_ctrl, dev_id);
+  }
+
+  // The failed device would be deployed fully next time
+  ActDeployDiff::RemoveBaseline(baseline, 1);
+
+  ActDeployPlan plan;
+  ActDeployDiff(baseline).GeneratePlan(device_config, dev_id_list, deploy_ctrl, plan);
+  ASSERT_EQ(2, plan.GetChanges().size());
+  for (auto &change : plan.GetChanges()) {
+    EXPECT_EQ(1, change.GetDeviceId());
+    EXPECT_EQ(ActDeployTableChangeEnum::kCreate, change.GetAction());
+  }
+}
+
+}  // namespace deploy
+}  // namespace act
@@ -11,18 +11,26 @@ See the file MOXA-SOFTWARE-NOTICE for details.
 #define SLEEP_MS(ms) Sleep(ms)
 #else
 #include <unistd.h>  // for sleep
-#define SLEEP_MS(ms) sleep(ms / 1000)
+#define SLEEP_MS(ms) usleep((ms) * 1000)
 #endif
 
+#define ACT_DEVICE_CONFIG_RESULT_DRAIN_TIMEOUT (1000)  ///< The timeout(ms) of waiting the results to be fetched
+#define ACT_DEVICE_CONFIG_IMPORT_EXPORT_WIDTH (8)       ///< The devices exported/imported at once
+#define ACT_DEVICE_CONFIG_IMPORT_EXPORT_TIMEOUT (180000)  ///< The timeout(ms) of exporting/importing a device
+
 #include <QQueue>
 #include <QString>
+#include <functional>
 #include <thread>
 
 #include "act_broadcast_search.hpp"
+#include "act_concurrent_runner.hpp"
 #include "act_core.hpp"
 #include "act_device.hpp"
 #include "act_device_config_type.hpp"
 #include "act_device_ip_config.hpp"
+#include "act_firmware_rollout.hpp"
+#include "act_job_engine.hpp"
 #include "act_json.hpp"
 #include "act_southbound.hpp"
 #include "act_status.hpp"
@@ -38,21 +46,33 @@ class ActCommandLineOutput : public QSerializer {
 class ActDeviceConfiguration {
   Q_GADGET
 
-  // for thread
-  std::unique_ptr<std::thread> device_config_thread_;  ///< DeviceConfiguration thread item
-  ACT_JSON_FIELD(bool, stop_flag, StopFlag);           ///< StopFlag item
-  ACT_JSON_FIELD(quint8, progress, Progress);          ///< Progress item
-  ACT_STATUS device_config_act_status_;                ///< DeviceConfiguration thread status
+  // for job
+  qint64 device_config_job_id_;                                  ///< DeviceConfiguration job id of the job engine
+  std::shared_ptr<ActJobProgress> device_config_job_progress_;  ///< DeviceConfiguration job progress
+  ACT_JSON_FIELD(bool, stop_flag, StopFlag);                     ///< StopFlag item
+  ACT_JSON_FIELD(quint8, progress, Progress);                    ///< Progress item
+  ACT_STATUS device_config_act_status_;                          ///< DeviceConfiguration job status
 
   // ACT_JSON_COLLECTION_OBJECTS(QQueue, qint64, result_queue, ResultQueue);
   ACT_JSON_QT_DICT(QMap, QString, QString, mac_host_map, MacHostMap);  ///< DeviceHostMap item <mac, host_ip>
   ACT_JSON_OBJECT(ActProfiles, profiles, Profiles);                    ///< Profiles item
+  ACT_JSON_OBJECT(ActFirmwareRolloutSetting, firmware_rollout_setting, FirmwareRolloutSetting);  ///< Rollout item
 
   ActSouthbound southbound_;
 
   QMutex mutex_;
 
  private:
+  /**
+   * @brief Start the DeviceConfiguration job on the job engine
+   *
+   * @param project
+   * @param job_type the job type of the job list (e.g. "Reboot")
+   * @param trigger the Trigger*ForThread call of the job, it updates the device_config_act_status_
+   * @return ACT_STATUS
+   */
+  ACT_STATUS StartJob(const ActProject &project, const QString &job_type, const std::function<void()> &trigger);
+
   /**
    * @brief DeviceConfiguration Error handler object
    *
@@ -84,9 +104,11 @@ class ActDeviceConfiguration {
    *
    * @param project
    * @param dev_id_list
+   * @param dev_distance_map <device id, distance from the host> if the distance is detected (optional)
    * @return ACT_STATUS
    */
-  ACT_STATUS SortDeviceIdList(const ActProject &project, QList<qint64> &dev_id_list);
+  ACT_STATUS SortDeviceIdList(const ActProject &project, QList<qint64> &dev_id_list,
+                              QMap<qint64, qint64> *dev_distance_map = nullptr);
 
   /**
    * @brief Check the Project's MonitorEndpoint object
@@ -204,6 +226,12 @@ class ActDeviceConfiguration {
    */
   ACT_STATUS UpdateProgress(quint8 progress);
 
+  /**
+   * @brief Wait until the results are fetched before reporting 100% (replaces the fixed sleep)
+   *
+   */
+  void WaitResultQueueDrained();
+
  public:
   QQueue<ActDeviceConfigureResult> result_queue_;
   QQueue<ActDeviceEventLogResult> event_log_result_queue_;
@@ -217,7 +245,7 @@ class ActDeviceConfiguration {
         progress_(0),
         stop_flag_(false),
         device_config_act_status_(std::make_shared<ActStatusBase>(ActStatusType::kStop, ActSeverity::kDebug)),
-        device_config_thread_(nullptr) {
+        device_config_job_id_(-1) {
     act::core::g_core.GetMacHostMap(mac_host_map_);
 
     southbound_.SetProfiles(profiles);
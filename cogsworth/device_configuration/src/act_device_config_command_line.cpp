@@ -14,46 +14,9 @@ static QString GetCommandLineOutputPath() {
 
 ACT_STATUS ActDeviceConfiguration::StartCommandLine(const ActProject &project, const QList<qint64> &dev_id_list,
                                                     const QString &command) {
-  // Checking has the thread is running
-  if (IsActStatusRunning(device_config_act_status_)) {
-    qCritical() << __func__ << "Currently has the thread running.";
-    return std::make_shared<ActStatusInternalError>("DeviceConfiguration");
-  }
-
-  // init ActDeviceConfiguration status
-  progress_ = 0;
-  stop_flag_ = false;
-  device_config_act_status_ = std::make_shared<ActStatusBase>(ActStatusType::kStop, ActSeverity::kDebug);
-
-  // New std::thread to start CommandLine
-  try {
-    // Check previous thread already join, because smart pointer reassign would remove the previous thread
-    if ((device_config_thread_ != nullptr) && (device_config_thread_->joinable())) {
-      device_config_thread_->join();
-    }
-    device_config_act_status_->SetStatus(ActStatusType::kRunning);
-    device_config_thread_ =
-        std::make_unique<std::thread>(&ActDeviceConfiguration::TriggerCommandLineForThread, this, std::cref(project),
-                                      std::cref(dev_id_list), std::cref(command));
-
-#ifdef _WIN32
-    // Set the thread name
-    std::wstring thread_name = L"TriggerCommandLineForThread";
-    HRESULT hr = SetThreadDescription(device_config_thread_->native_handle(), thread_name.c_str());
-    if (FAILED(hr)) {
-      // Handle error
-    }
-#endif
-
-    qDebug() << "Start CommandLine thread.";
-
-  } catch (std::exception &e) {
-    qCritical() << __func__ << "New std::thread(CommandLine) failed. Error:" << e.what();
-    device_config_act_status_->SetStatus(ActStatusType::kFailed);
-    return std::make_shared<ActStatusInternalError>("DeviceConfiguration");
-  }
-
-  return std::make_shared<ActProgressStatus>(ActStatusBase(*device_config_act_status_), progress_);
+  return StartJob(project, "CommandLine", [this, &project, &dev_id_list, &command]() {
+    TriggerCommandLineForThread(project, dev_id_list, command);
+  });
 }
 
 void ActDeviceConfiguration::TriggerCommandLineForThread(const ActProject &project, const QList<qint64> &dev_id_list,
@@ -61,7 +24,7 @@ void ActDeviceConfiguration::TriggerCommandLineForThread(const ActProject &proje
   // Waiting for main thread return running flag to WS
   std::this_thread::yield();
 
-  // Triggered the CommandLine and wait for the return, and update device_config_thread_.
+  // Triggered the CommandLine and wait for the return, and update device_config_act_status_.
   try {
     device_config_act_status_ = CommandLine(project, dev_id_list, command);
 
@@ -6,52 +6,15 @@
 #define SLEEP_MS(ms) Sleep(ms)
 #else
 #include <unistd.h>  // for sleep
-#define SLEEP_MS(ms) sleep(ms / 1000)
+#define SLEEP_MS(ms) usleep((ms) * 1000)
 #endif
 
 ACT_STATUS ActDeviceConfiguration::StartCommission(const ActProject &project, const QList<qint64> &dev_id_list,
                                                    const ActDeviceConfigTypeEnum &config_type,
                                                    ActDeviceConfig &sync_dev_config) {
-  // Checking has the thread is running
-  if (IsActStatusRunning(device_config_act_status_)) {
-    qCritical() << __func__ << "Currently has the thread running.";
-    return std::make_shared<ActStatusInternalError>("DeviceConfiguration");
-  }
-
-  // init ActDeviceConfiguration status
-  progress_ = 0;
-  stop_flag_ = false;
-  device_config_act_status_ = std::make_shared<ActStatusBase>(ActStatusType::kStop, ActSeverity::kDebug);
-
-  // New std::thread to start Commission
-  try {
-    // Check previous thread already join, because smart pointer reassign would remove the previous thread
-    if ((device_config_thread_ != nullptr) && (device_config_thread_->joinable())) {
-      device_config_thread_->join();
-    }
-    device_config_act_status_->SetStatus(ActStatusType::kRunning);
-    device_config_thread_ =
-        std::make_unique<std::thread>(&ActDeviceConfiguration::TriggerCommissionForThread, this, std::cref(project),
-                                      std::cref(dev_id_list), std::cref(config_type), std::ref(sync_dev_config));
-
-#ifdef _WIN32
-    // Set the thread name
-    std::wstring thread_name = L"TriggerCommissionForThread";
-    HRESULT hr = SetThreadDescription(device_config_thread_->native_handle(), thread_name.c_str());
-    if (FAILED(hr)) {
-      // Handle error
-    }
-#endif
-
-    qDebug() << "Start Commission thread.";
-
-  } catch (std::exception &e) {
-    qCritical() << __func__ << "New std::thread(Commission) failed. Error:" << e.what();
-    device_config_act_status_->SetStatus(ActStatusType::kFailed);
-    return std::make_shared<ActStatusInternalError>("DeviceConfiguration");
-  }
-
-  return std::make_shared<ActProgressStatus>(ActStatusBase(*device_config_act_status_), progress_);
+  return StartJob(project, "Commission", [this, &project, &dev_id_list, &config_type, &sync_dev_config]() {
+    TriggerCommissionForThread(project, dev_id_list, config_type, sync_dev_config);
+  });
 }
 
 void ActDeviceConfiguration::TriggerCommissionForThread(const ActProject &project, const QList<qint64> &dev_id_list,
@@ -60,7 +23,7 @@ void ActDeviceConfiguration::TriggerCommissionForThread(const ActProject &projec
   // Waiting for main thread return running flag to WS
   std::this_thread::yield();
 
-  // Triggered the Commission and wait for the return, and update device_config_thread_.
+  // Triggered the Commission and wait for the return, and update device_config_act_status_.
   try {
     device_config_act_status_ = Commission(project, dev_id_list, config_type, sync_dev_config);
   } catch (std::exception &e) {
@@ -381,8 +344,7 @@ ACT_STATUS ActDeviceConfiguration::Commission(const ActProject &project, const Q
           auto set_vlan_status = southbound_.ConfigureVlan(dev, dev_config.GetVlanTables()[dev.GetId()]);
 
           // Check ICMP status
-          SLEEP_MS(1000);
-          auto ping_status = southbound_.PingIpAddress(dev.GetIpv4().GetIpAddress(), ACT_PING_REPEAT_TIMES);
+          auto ping_status = southbound_.WaitIpAddressReachable(dev.GetIpv4().GetIpAddress());
           if (!IsActStatusSuccess(ping_status)) {
             qWarning() << QString("Device(%1) not alive").arg(dev.GetIpv4().GetIpAddress()).toStdString().c_str();
 
@@ -453,8 +415,7 @@ ACT_STATUS ActDeviceConfiguration::Commission(const ActProject &project, const Q
           auto set_status = southbound_.ConfigurePortSetting(dev, dev_config.GetPortSettingTables()[dev.GetId()]);
 
           // Check ICMP status
-          SLEEP_MS(1000);
-          auto ping_status = southbound_.PingIpAddress(dev.GetIpv4().GetIpAddress(), ACT_PING_REPEAT_TIMES);
+          auto ping_status = southbound_.WaitIpAddressReachable(dev.GetIpv4().GetIpAddress());
           if (IsActStatusSuccess(ping_status)) {
             qWarning() << QString("Device(%1) not alive").arg(dev.GetIpv4().GetIpAddress()).toStdString().c_str();
             if (!IsActStatusSuccess(set_status)) {
@@ -491,8 +452,7 @@ ACT_STATUS ActDeviceConfiguration::Commission(const ActProject &project, const Q
           auto set_status = southbound_.ConfigureSpanningTree(dev, dev_config.GetRstpTables()[dev.GetId()]);
 
           // Check ICMP status
-          SLEEP_MS(1000);
-          auto ping_status = southbound_.PingIpAddress(dev.GetIpv4().GetIpAddress(), ACT_PING_REPEAT_TIMES);
+          auto ping_status = southbound_.WaitIpAddressReachable(dev.GetIpv4().GetIpAddress());
           if (IsActStatusSuccess(ping_status)) {
             qWarning() << QString("Device(%1) not alive").arg(dev.GetIpv4().GetIpAddress()).toStdString().c_str();
             if (!IsActStatusSuccess(set_status)) {
@@ -569,7 +529,7 @@ ACT_STATUS ActDeviceConfiguration::Commission(const ActProject &project, const Q
     }
   }
 
-  SLEEP_MS(1000);
+  WaitResultQueueDrained();
   UpdateProgress(100);
   act_status = ACT_STATUS_SUCCESS;
   return act_status;
@@ -1,52 +1,16 @@
 #include "act_device_configuration.hpp"
 
 ACT_STATUS ActDeviceConfiguration::StartGetEventLog(const ActProject &project, const QList<qint64> &dev_id_list) {
-  // Checking has the thread is running
-  if (IsActStatusRunning(device_config_act_status_)) {
-    qCritical() << __func__ << "Currently has the thread running.";
-    return std::make_shared<ActStatusInternalError>("DeviceConfiguration");
-  }
-
-  // init ActDeviceConfiguration status
-  progress_ = 0;
-  stop_flag_ = false;
-  device_config_act_status_ = std::make_shared<ActStatusBase>(ActStatusType::kStop, ActSeverity::kDebug);
-
-  // New std::thread to start EventLog
-  try {
-    // Check previous thread already join, because smart pointer reassign would remove the previous thread
-    if ((device_config_thread_ != nullptr) && (device_config_thread_->joinable())) {
-      device_config_thread_->join();
-    }
-    device_config_act_status_->SetStatus(ActStatusType::kRunning);
-    device_config_thread_ = std::make_unique<std::thread>(&ActDeviceConfiguration::TriggerGetEventLogForThread, this,
-                                                          std::cref(project), std::cref(dev_id_list));
-
-#ifdef _WIN32
-    // Set the thread name
-    std::wstring thread_name = L"TriggerGetEventLogForThread";
-    HRESULT hr = SetThreadDescription(device_config_thread_->native_handle(), thread_name.c_str());
-    if (FAILED(hr)) {
-      // Handle error
-    }
-#endif
-
-    qDebug() << "Start EventLog thread.";
-
-  } catch (std::exception &e) {
-    qCritical() << __func__ << "New std::thread(GetEventLog) failed. Error:" << e.what();
-    device_config_act_status_->SetStatus(ActStatusType::kFailed);
-    return std::make_shared<ActStatusInternalError>("DeviceConfiguration");
-  }
-
-  return std::make_shared<ActProgressStatus>(ActStatusBase(*device_config_act_status_), progress_);
+  return StartJob(project, "GetEventLog", [this, &project, &dev_id_list]() {
+    TriggerGetEventLogForThread(project, dev_id_list);
+  });
 }
 
 void ActDeviceConfiguration::TriggerGetEventLogForThread(const ActProject &project, const QList<qint64> &dev_id_list) {
   // Waiting for main thread return running flag to WS
   std::this_thread::yield();
 
-  // Triggered the EventLog and wait for the return, and update device_config_thread_.
+  // Triggered the EventLog and wait for the return, and update device_config_act_status_.
   try {
     device_config_act_status_ = GetEventLog(project, dev_id_list);
   } catch (std::exception &e) {
@@ -149,7 +113,7 @@ ACT_STATUS ActDeviceConfiguration::GetEventLog(const ActProject &project, const
     }
   }
 
-  SLEEP_MS(1000);
+  WaitResultQueueDrained();
   UpdateProgress(100);
   act_status = ACT_STATUS_SUCCESS;
   return act_status;
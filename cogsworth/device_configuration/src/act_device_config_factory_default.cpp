@@ -1,45 +1,9 @@
 #include "act_device_configuration.hpp"
 
 ACT_STATUS ActDeviceConfiguration::StartFactoryDefault(const ActProject &project, const QList<qint64> &dev_id_list) {
-  // Checking has the thread is running
-  if (IsActStatusRunning(device_config_act_status_)) {
-    qCritical() << __func__ << "Currently has the thread running.";
-    return std::make_shared<ActStatusInternalError>("DeviceConfiguration");
-  }
-
-  // init ActDeviceConfiguration status
-  progress_ = 0;
-  stop_flag_ = false;
-  device_config_act_status_ = std::make_shared<ActStatusBase>(ActStatusType::kStop, ActSeverity::kDebug);
-
-  // New std::thread to start FactoryDefault
-  try {
-    // Check previous thread already join, because smart pointer reassign would remove the previous thread
-    if ((device_config_thread_ != nullptr) && (device_config_thread_->joinable())) {
-      device_config_thread_->join();
-    }
-    device_config_act_status_->SetStatus(ActStatusType::kRunning);
-    device_config_thread_ = std::make_unique<std::thread>(&ActDeviceConfiguration::TriggerFactoryDefaultForThread, this,
-                                                          std::cref(project), std::cref(dev_id_list));
-
-#ifdef _WIN32
-    // Set the thread name
-    std::wstring thread_name = L"TriggerFactoryDefaultForThread";
-    HRESULT hr = SetThreadDescription(device_config_thread_->native_handle(), thread_name.c_str());
-    if (FAILED(hr)) {
-      // Handle error
-    }
-#endif
-
-    qDebug() << "Start FactoryDefault thread.";
-
-  } catch (std::exception &e) {
-    qCritical() << __func__ << "New std::thread(FactoryDefault) failed. Error:" << e.what();
-    device_config_act_status_->SetStatus(ActStatusType::kFailed);
-    return std::make_shared<ActStatusInternalError>("DeviceConfiguration");
-  }
-
-  return std::make_shared<ActProgressStatus>(ActStatusBase(*device_config_act_status_), progress_);
+  return StartJob(project, "FactoryDefault", [this, &project, &dev_id_list]() {
+    TriggerFactoryDefaultForThread(project, dev_id_list);
+  });
 }
 
 void ActDeviceConfiguration::TriggerFactoryDefaultForThread(const ActProject &project,
@@ -47,7 +11,7 @@ void ActDeviceConfiguration::TriggerFactoryDefaultForThread(const ActProject &pr
   // Waiting for main thread return running flag to WS
   std::this_thread::yield();
 
-  // Triggered the FactoryDefault and wait for the return, and update device_config_thread_.
+  // Triggered the FactoryDefault and wait for the return, and update device_config_act_status_.
   try {
     device_config_act_status_ = FactoryDefault(project, dev_id_list);
 
@@ -148,7 +112,7 @@ ACT_STATUS ActDeviceConfiguration::FactoryDefault(const ActProject &project, con
     }
   }
 
-  SLEEP_MS(1000);
+  WaitResultQueueDrained();
   UpdateProgress(100);
   act_status = ACT_STATUS_SUCCESS;
   return act_status;
@@ -1,47 +1,14 @@
+#include <QDateTime>
+#include <QFileInfo>
+
 #include "act_device_configuration.hpp"
+#include "act_readiness_probe.hpp"
 
 ACT_STATUS ActDeviceConfiguration::StartFirmwareUpgrade(const ActProject &project, const QList<qint64> &dev_id_list,
                                                         const QString &file_path) {
-  // Checking has the thread is running
-  if (IsActStatusRunning(device_config_act_status_)) {
-    qCritical() << __func__ << "Currently has the thread running.";
-    return std::make_shared<ActStatusInternalError>("DeviceConfiguration");
-  }
-
-  // init ActDeviceConfiguration status
-  progress_ = 0;
-  stop_flag_ = false;
-  device_config_act_status_ = std::make_shared<ActStatusBase>(ActStatusType::kStop, ActSeverity::kDebug);
-
-  // New std::thread to start FirmwareUpgrade
-  try {
-    // Check previous thread already join, because smart pointer reassign would remove the previous thread
-    if ((device_config_thread_ != nullptr) && (device_config_thread_->joinable())) {
-      device_config_thread_->join();
-    }
-    device_config_act_status_->SetStatus(ActStatusType::kRunning);
-    device_config_thread_ =
-        std::make_unique<std::thread>(&ActDeviceConfiguration::TriggerFirmwareUpgradeForThread, this,
-                                      std::cref(project), std::cref(dev_id_list), std::cref(file_path));
-
-#ifdef _WIN32
-    // Set the thread name
-    std::wstring thread_name = L"TriggerFirmwareUpgradeForThread";
-    HRESULT hr = SetThreadDescription(device_config_thread_->native_handle(), thread_name.c_str());
-    if (FAILED(hr)) {
-      // Handle error
-    }
-#endif
-
-    qDebug() << "Start FirmwareUpgrade thread.";
-
-  } catch (std::exception &e) {
-    qCritical() << __func__ << "New std::thread(FirmwareUpgrade) failed. Error:" << e.what();
-    device_config_act_status_->SetStatus(ActStatusType::kFailed);
-    return std::make_shared<ActStatusInternalError>("DeviceConfiguration");
-  }
-
-  return std::make_shared<ActProgressStatus>(ActStatusBase(*device_config_act_status_), progress_);
+  return StartJob(project, "FirmwareUpgrade", [this, &project, &dev_id_list, &file_path]() {
+    TriggerFirmwareUpgradeForThread(project, dev_id_list, file_path);
+  });
 }
 
 void ActDeviceConfiguration::TriggerFirmwareUpgradeForThread(const ActProject &project,
@@ -50,7 +17,7 @@ void ActDeviceConfiguration::TriggerFirmwareUpgradeForThread(const ActProject &p
   // Waiting for main thread return running flag to WS
   std::this_thread::yield();
 
-  // Triggered the FirmwareUpgrade and wait for the return, and update device_config_thread_.
+  // Triggered the FirmwareUpgrade and wait for the return, and update device_config_act_status_.
   try {
     device_config_act_status_ = FirmwareUpgrade(project, dev_id_list, file_path);
 
@@ -64,9 +31,10 @@ ACT_STATUS ActDeviceConfiguration::FirmwareUpgrade(const ActProject &project, co
                                                    const QString &file_path) {
   ACT_STATUS_INIT();
 
-  // Create device list
+  // Create device list, sorted from far to near (the leaves first)
   QList<qint64> sorted_dev_id_list = dev_id_list;
-  SortDeviceIdList(project, sorted_dev_id_list);
+  QMap<qint64, qint64> dev_distance_map;
+  SortDeviceIdList(project, sorted_dev_id_list, &dev_distance_map);
 
   QList<ActDevice> dev_list;
   for (auto &dev_id : sorted_dev_id_list) {
@@ -87,12 +55,13 @@ ACT_STATUS ActDeviceConfiguration::FirmwareUpgrade(const ActProject &project, co
 
   UpdateProgress(10);
 
+  // Prepare the devices, the failed ones are reported at once
+  QMap<qint64, ActDevice> dev_map;
+  QMap<qint64, ActFeatureSubItem> feature_sub_item_map;
+  QMap<qint64, ActFeatureSubItem> firmware_version_sub_item_map;
+  QMap<qint64, QString> old_firmware_version_map;  ///< To confirm the upgraded device runs the new firmware
+  QList<qint64> rollout_dev_id_list;
   for (auto dev : dev_list) {
-    if (stop_flag_) {  // stop flag
-      return ACT_STATUS_STOP;
-    }
-    act_status = ACT_STATUS_SUCCESS;
-
     // Check ICMP status
     if (!dev.GetDeviceStatus().GetICMPStatus()) {
       DeviceConfigurationErrorHandler(__func__, "ICMP status is false(not alive)", dev);
@@ -102,28 +71,6 @@ ACT_STATUS ActDeviceConfiguration::FirmwareUpgrade(const ActProject &project, co
     // Update connect status to true for southbound
     dev.GetDeviceStatus().SetAllConnectStatus(true);
 
-    // Try to get FirmwareVersion to find firmware_feature_profile
-    // ActFeatureSubItem fw_feature_sub_item;
-    // act_status = GetDeviceFeatureSubItem(dev, profiles_.GetFirmwareFeatureProfiles(), profiles_.GetDeviceProfiles(),
-    //                                      ActFeatureEnum::kAutoScan, "Identify", "FirmwareVersion",
-    //                                      fw_feature_sub_item);
-    // if (IsActStatusSuccess(act_status)) {
-    //   QString firmware_version;
-    //   act_status = southbound_.ActionGetFirmwareVersion(dev, fw_feature_sub_item, firmware_version);
-    //   if (!IsActStatusSuccess(act_status)) {
-    //     DeviceConfigurationErrorHandler(__func__, "Get device Firmware version failed", dev);
-    //     continue;
-    //   }
-    //   // Try to find firmware_feature_profile
-    //   ActFirmwareFeatureProfile fw_feat_profile;
-    //   auto find_status = ActFirmwareFeatureProfile::GetFirmwareFeatureProfile(profiles_.GetFirmwareFeatureProfiles(),
-    //                                                                           dev.GetDeviceProperty().GetModelName(),
-    //                                                                           firmware_version, fw_feat_profile);
-    //   if (IsActStatusSuccess(find_status)) {
-    //     dev.SetFirmwareFeatureProfileId(fw_feat_profile.GetId());
-    //   }
-    // }
-
     // Get Sub-item
     ActFeatureSubItem feature_sub_item;
     act_status = GetDeviceFeatureSubItem(dev, profiles_.GetFirmwareFeatureProfiles(), profiles_.GetDeviceProfiles(),
@@ -133,28 +80,107 @@ ACT_STATUS ActDeviceConfiguration::FirmwareUpgrade(const ActProject &project, co
       continue;
     }
 
-    // FirmwareUpgrade device
-    act_status = southbound_.ActionFirmwareUpgrade(dev, feature_sub_item, file_path);
-
-    if (!IsActStatusSuccess(act_status)) {
-      DeviceConfigurationErrorHandler(__func__, act_status->GetErrorMessage(), dev);
-      continue;
+    // The firmware version before the upgrade (if the device supports it)
+    ActFeatureSubItem firmware_version_sub_item;
+    QString firmware_version;
+    if (IsActStatusSuccess(GetDeviceFeatureSubItem(dev, profiles_.GetFirmwareFeatureProfiles(),
+                                                   profiles_.GetDeviceProfiles(), ActFeatureEnum::kAutoScan,
+                                                   "Identify", "FirmwareVersion", firmware_version_sub_item)) &&
+        IsActStatusSuccess(southbound_.ActionGetFirmwareVersion(dev, firmware_version_sub_item, firmware_version))) {
+      firmware_version_sub_item_map.insert(dev.GetId(), firmware_version_sub_item);
+      old_firmware_version_map.insert(dev.GetId(), firmware_version);
     }
 
-    // Add success result to result_queue_
-    result_queue_.enqueue(ActDeviceConfigureResult(dev.GetId(), ActStatusType::kSuccess));
+    dev_map.insert(dev.GetId(), dev);
+    feature_sub_item_map.insert(dev.GetId(), feature_sub_item);
+    rollout_dev_id_list.append(dev.GetId());
+  }
 
-    // Update progress(10~90/100)
-    quint8 new_progress = progress_ + (80 / dev_list.size());
-    if (new_progress >= 90) {
-      UpdateProgress(90);
-    } else {
-      UpdateProgress(new_progress);
-    }
+  // Upgrade in waves
+  const QList<QList<qint64>> waves = ActFirmwareRollout::PlanWaves(rollout_dev_id_list, dev_distance_map,
+                                                                   firmware_rollout_setting_.GetWaveWidth());
+  qDebug() << __func__
+           << QString("Upgrade %1 devices in %2 waves")
+                  .arg(rollout_dev_id_list.size())
+                  .arg(waves.size())
+                  .toStdString()
+                  .c_str();
+
+  qint32 done_count = 0;
+  ActFirmwareRollout rollout(firmware_rollout_setting_);
+  act_status = rollout.Run(
+      waves, QFileInfo(file_path).size(),
+      [this, &dev_map, &feature_sub_item_map, &file_path](const qint64 &dev_id) {
+        // FirmwareUpgrade device
+        return southbound_.ActionFirmwareUpgrade(dev_map[dev_id], feature_sub_item_map[dev_id], file_path);
+      },
+      [this, &dev_map, &firmware_version_sub_item_map, &old_firmware_version_map](
+          const QList<qint64> &upgraded_dev_id_list) {
+        // The upgraded devices reboot, the one still answering the ping right after the upload hasn't rebooted yet.
+        // So a device is alive again once it answers after it went down (or after the reboot delay if it never was
+        // seen down), and it runs the new firmware (or it did reboot into the same one) if its version is readable.
+        QList<ActDevice> upgraded_dev_list;
+        for (auto &dev_id : upgraded_dev_id_list) {
+          upgraded_dev_list.append(dev_map[dev_id]);
+        }
+        const qint64 upgraded_time = QDateTime::currentMSecsSinceEpoch();
+        const qint64 reboot_delay = static_cast<qint64>(firmware_rollout_setting_.GetRebootDelay()) * 1000;
+        QSet<qint64> rebooted_dev_ids;
+        QSet<qint64> alive_dev_ids;
+        ActReadinessProbe probe("FirmwareUpgrade wave", firmware_rollout_setting_.GetHealthTimeout() * 1000);
+        probe.Wait(
+            [&]() {
+              southbound_.UpdateDevicesIcmpStatus(upgraded_dev_list);
+              const bool delay_passed = QDateTime::currentMSecsSinceEpoch() - upgraded_time >= reboot_delay;
+              for (auto &dev : upgraded_dev_list) {
+                if (alive_dev_ids.contains(dev.GetId())) {
+                  continue;
+                }
+                if (!dev.GetDeviceStatus().GetICMPStatus()) {
+                  rebooted_dev_ids.insert(dev.GetId());
+                  continue;
+                }
+
+                const bool rebooted = rebooted_dev_ids.contains(dev.GetId());
+                auto old_version_it = old_firmware_version_map.constFind(dev.GetId());
+                if (old_version_it == old_firmware_version_map.constEnd()) {
+                  if (rebooted || delay_passed) {
+                    alive_dev_ids.insert(dev.GetId());
+                  }
+                  continue;
+                }
+
+                QString firmware_version;
+                if (IsActStatusSuccess(southbound_.ActionGetFirmwareVersion(
+                        dev, firmware_version_sub_item_map[dev.GetId()], firmware_version)) &&
+                    ((firmware_version != old_version_it.value()) || rebooted)) {
+                  alive_dev_ids.insert(dev.GetId());
+                }
+              }
+              return alive_dev_ids.size() == upgraded_dev_list.size();
+            },
+            &stop_flag_);
+        return alive_dev_ids;
+      },
+      [this, &dev_map, &done_count, &rollout_dev_id_list](const qint64 &dev_id, ACT_STATUS result_status) {
+        if (IsActStatusSuccess(result_status)) {
+          // Add success result to result_queue_
+          result_queue_.enqueue(ActDeviceConfigureResult(dev_id, ActStatusType::kSuccess));
+        } else {
+          DeviceConfigurationErrorHandler("FirmwareUpgrade", result_status->GetErrorMessage(), dev_map[dev_id]);
+        }
+
+        // Update progress(10~90/100)
+        done_count++;
+        UpdateProgress(10 + (80 * done_count / rollout_dev_id_list.size()));
+      },
+      &stop_flag_);
+  if (!IsActStatusSuccess(act_status)) {
+    return act_status;
   }
 
-  SLEEP_MS(1000);
+  WaitResultQueueDrained();
   UpdateProgress(100);
   act_status = ACT_STATUS_SUCCESS;
   return act_status;
-}
\ No newline at end of file
+}
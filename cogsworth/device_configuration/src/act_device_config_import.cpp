@@ -2,37 +2,9 @@
 
 ACT_STATUS ActDeviceConfiguration::StartImportConfig(const ActProject &project, const QList<qint64> &dev_id_list,
                                                      const QString &file_path) {
-  // Checking has the thread is running
-  if (IsActStatusRunning(device_config_act_status_)) {
-    qCritical() << __func__ << "Currently has the thread running.";
-    return std::make_shared<ActStatusInternalError>("DeviceConfiguration");
-  }
-
-  // init ActDeviceConfiguration status
-  progress_ = 0;
-  stop_flag_ = false;
-  device_config_act_status_ = std::make_shared<ActStatusBase>(ActStatusType::kStop, ActSeverity::kDebug);
-
-  // New std::thread to start ImportConfig
-  try {
-    // Check previous thread already join, because smart pointer reassign would remove the previous thread
-    if ((device_config_thread_ != nullptr) && (device_config_thread_->joinable())) {
-      device_config_thread_->join();
-    }
-    device_config_act_status_->SetStatus(ActStatusType::kRunning);
-    device_config_thread_ =
-        std::make_unique<std::thread>(&ActDeviceConfiguration::TriggerImportConfigForThread, this, std::cref(project),
-                                      std::cref(dev_id_list), std::cref(file_path));
-
-    qDebug() << "Start ImportConfig thread.";
-
-  } catch (std::exception &e) {
-    qCritical() << __func__ << "New std::thread(ImportConfig) failed. Error:" << e.what();
-    device_config_act_status_->SetStatus(ActStatusType::kFailed);
-    return std::make_shared<ActStatusInternalError>("DeviceConfiguration");
-  }
-
-  return std::make_shared<ActProgressStatus>(ActStatusBase(*device_config_act_status_), progress_);
+  return StartJob(project, "ImportConfig", [this, &project, &dev_id_list, &file_path]() {
+    TriggerImportConfigForThread(project, dev_id_list, file_path);
+  });
 }
 
 void ActDeviceConfiguration::TriggerImportConfigForThread(const ActProject &project, const QList<qint64> &dev_id_list,
@@ -40,7 +12,7 @@ void ActDeviceConfiguration::TriggerImportConfigForThread(const ActProject &proj
   // Waiting for main thread return running flag to WS
   std::this_thread::yield();
 
-  // Triggered the ImportConfig and wait for the return, and update device_config_thread_.
+  // Triggered the ImportConfig and wait for the return, and update device_config_act_status_.
   try {
     device_config_act_status_ = ImportConfig(project, dev_id_list, file_path);
   } catch (std::exception &e) {
@@ -55,7 +27,8 @@ ACT_STATUS ActDeviceConfiguration::ImportConfig(const ActProject &project, const
 
   // Create device list
   QList<qint64> sorted_dev_id_list = dev_id_list;
-  SortDeviceIdList(project, sorted_dev_id_list);
+  QMap<qint64, qint64> dev_distance_map;
+  SortDeviceIdList(project, sorted_dev_id_list, &dev_distance_map);
 
   QList<ActDevice> dev_list;
   for (auto &dev_id : sorted_dev_id_list) {
@@ -76,11 +49,14 @@ ACT_STATUS ActDeviceConfiguration::ImportConfig(const ActProject &project, const
 
   UpdateProgress(10);
 
+  // Prepare the devices, the failed ones are reported at once
+  QMap<qint64, ActDevice> dev_map;
+  QMap<qint64, ActFeatureSubItem> feature_sub_item_map;
+  QList<qint64> run_dev_id_list;
   for (auto dev : dev_list) {
     if (stop_flag_) {  // stop flag
       return ACT_STATUS_STOP;
     }
-    act_status = ACT_STATUS_SUCCESS;
 
     // Check ICMP status
     if (!dev.GetDeviceStatus().GetICMPStatus()) {
@@ -123,26 +99,45 @@ ACT_STATUS ActDeviceConfiguration::ImportConfig(const ActProject &project, const
       continue;
     }
 
-    // Import device config
-    act_status = southbound_.ActionImportConfig(dev, feature_sub_item, file_path);
-    if (!IsActStatusSuccess(act_status)) {
-      DeviceConfigurationErrorHandler(__func__, act_status->GetErrorMessage(), dev);
-      continue;
-    }
-
-    // Add success result to result_queue_
-    result_queue_.enqueue(ActDeviceConfigureResult(dev.GetId(), ActStatusType::kSuccess));
+    dev_map.insert(dev.GetId(), dev);
+    feature_sub_item_map.insert(dev.GetId(), feature_sub_item);
+    run_dev_id_list.append(dev.GetId());
+  }
 
-    // Update progress(10~90/100)
-    quint8 new_progress = progress_ + (80 / dev_list.size());
-    if (new_progress >= 90) {
-      UpdateProgress(90);
-    } else {
-      UpdateProgress(new_progress);
+  // An imported config may reboot the device or change its IP, so the devices are imported far to near in the waves
+  // of the same distance. The devices of a wave are imported concurrently, a failed or hung device does not stop the
+  // others
+  const QList<QList<qint64>> waves =
+      ActFirmwareRollout::PlanWaves(run_dev_id_list, dev_distance_map, ACT_DEVICE_CONFIG_IMPORT_EXPORT_WIDTH);
+  qint32 done_count = 0;
+  ActConcurrentRunner runner(ACT_DEVICE_CONFIG_IMPORT_EXPORT_WIDTH, ACT_DEVICE_CONFIG_IMPORT_EXPORT_TIMEOUT);
+  for (const auto &wave : waves) {
+    act_status = runner.Run(
+        wave,
+        [this, &dev_map, &feature_sub_item_map, &file_path](const qint64 &dev_id) {
+          // Import device config
+          return southbound_.ActionImportConfig(dev_map.value(dev_id), feature_sub_item_map.value(dev_id),
+                                                 file_path);
+        },
+        [this, &dev_map, &done_count, &run_dev_id_list](const qint64 &dev_id, ACT_STATUS result_status) {
+          if (IsActStatusSuccess(result_status)) {
+            // Add success result to result_queue_
+            result_queue_.enqueue(ActDeviceConfigureResult(dev_id, ActStatusType::kSuccess));
+          } else {
+            DeviceConfigurationErrorHandler("ImportConfig", result_status->GetErrorMessage(), dev_map[dev_id]);
+          }
+
+          // Update progress(10~90/100)
+          done_count++;
+          UpdateProgress(10 + (80 * done_count / run_dev_id_list.size()));
+        },
+        &stop_flag_);
+    if (!IsActStatusSuccess(act_status)) {
+      return act_status;
     }
   }
 
-  SLEEP_MS(1000);
+  WaitResultQueueDrained();
   UpdateProgress(100);
   act_status = ACT_STATUS_SUCCESS;
   return act_status;
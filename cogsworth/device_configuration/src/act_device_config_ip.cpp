@@ -4,46 +4,9 @@
 ACT_STATUS ActDeviceConfiguration::StartSetNetworkSetting(const ActProject &act_project,
                                                           QList<ActDeviceIpConfiguration> dev_ip_config_list,
                                                           bool from_broadcast_search) {
-  // Checking has the thread is running
-  if (IsActStatusRunning(device_config_act_status_)) {
-    qCritical() << __func__ << "Currently has the thread running.";
-    return std::make_shared<ActStatusInternalError>("DeviceConfiguration");
-  }
-
-  // init ActDeviceConfiguration status
-  progress_ = 0;
-  stop_flag_ = false;
-  device_config_act_status_ = std::make_shared<ActStatusBase>(ActStatusType::kStop, ActSeverity::kDebug);
-
-  // New std::thread to start SetNetworkSetting
-  try {
-    // Check previous thread already join, because smart pointer reassign would remove the previous thread
-    if ((device_config_thread_ != nullptr) && (device_config_thread_->joinable())) {
-      device_config_thread_->join();
-    }
-    device_config_act_status_->SetStatus(ActStatusType::kRunning);
-    device_config_thread_ =
-        std::make_unique<std::thread>(&ActDeviceConfiguration::TriggerSetNetworkSettingForThread, this,
-                                      std::cref(act_project), dev_ip_config_list, from_broadcast_search);
-
-#ifdef _WIN32
-    // Set the thread name
-    std::wstring thread_name = L"TriggerSetNetworkSettingForThread";
-    HRESULT hr = SetThreadDescription(device_config_thread_->native_handle(), thread_name.c_str());
-    if (FAILED(hr)) {
-      // Handle error
-    }
-#endif
-
-    qDebug() << "Start SetNetworkSetting thread.";
-
-  } catch (std::exception &e) {
-    qCritical() << __func__ << "New std::thread(SetNetworkSetting) failed. Error:" << e.what();
-    device_config_act_status_->SetStatus(ActStatusType::kFailed);
-    return std::make_shared<ActStatusInternalError>("DeviceConfiguration");
-  }
-
-  return std::make_shared<ActProgressStatus>(ActStatusBase(*device_config_act_status_), progress_);
+  return StartJob(act_project, "SetNetworkSetting", [this, &act_project, dev_ip_config_list, from_broadcast_search]() {
+    TriggerSetNetworkSettingForThread(act_project, dev_ip_config_list, from_broadcast_search);
+  });
 }
 
 void ActDeviceConfiguration::TriggerSetNetworkSettingForThread(const ActProject &act_project,
@@ -52,7 +15,7 @@ void ActDeviceConfiguration::TriggerSetNetworkSettingForThread(const ActProject
   // Waiting for main thread return running flag to WS
   std::this_thread::yield();
 
-  // Triggered the SetNetworkSetting and wait for the return, and update device_config_thread_.
+  // Triggered the SetNetworkSetting and wait for the return, and update device_config_act_status_.
   try {
     device_config_act_status_ = SetNetworkSetting(act_project, dev_ip_config_list, from_broadcast_search);
 
@@ -247,7 +210,7 @@ ACT_STATUS ActDeviceConfiguration::SetNetworkSetting(const ActProject &act_proje
     }
   }
 
-  SLEEP_MS(1000);
+  WaitResultQueueDrained();
   UpdateProgress(100);
   act_status = ACT_STATUS_SUCCESS;
   return act_status;
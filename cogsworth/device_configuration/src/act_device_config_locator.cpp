@@ -2,37 +2,9 @@
 
 ACT_STATUS ActDeviceConfiguration::StartLocator(const ActProject &project, const QList<qint64> &dev_id_list,
                                                 const quint16 &duration) {
-  // Checking has the thread is running
-  if (IsActStatusRunning(device_config_act_status_)) {
-    qCritical() << __func__ << "Currently has the thread running.";
-    return std::make_shared<ActStatusInternalError>("DeviceConfiguration");
-  }
-
-  // init ActDeviceConfiguration status
-  progress_ = 0;
-  stop_flag_ = false;
-  device_config_act_status_ = std::make_shared<ActStatusBase>(ActStatusType::kStop, ActSeverity::kDebug);
-
-  // New std::thread to start Locator
-  try {
-    // Check previous thread already join, because smart pointer reassign would remove the previous thread
-    if ((device_config_thread_ != nullptr) && (device_config_thread_->joinable())) {
-      device_config_thread_->join();
-    }
-    device_config_act_status_->SetStatus(ActStatusType::kRunning);
-    device_config_thread_ =
-        std::make_unique<std::thread>(&ActDeviceConfiguration::TriggerLocatorForThread, this, std::cref(project),
-                                      std::cref(dev_id_list), std::cref(duration));
-
-    qDebug() << "Start Locator thread.";
-
-  } catch (std::exception &e) {
-    qCritical() << __func__ << "New std::thread(Locator) failed. Error:" << e.what();
-    device_config_act_status_->SetStatus(ActStatusType::kFailed);
-    return std::make_shared<ActStatusInternalError>("DeviceConfiguration");
-  }
-
-  return std::make_shared<ActProgressStatus>(ActStatusBase(*device_config_act_status_), progress_);
+  return StartJob(project, "Locator", [this, &project, &dev_id_list, &duration]() {
+    TriggerLocatorForThread(project, dev_id_list, duration);
+  });
 }
 
 void ActDeviceConfiguration::TriggerLocatorForThread(const ActProject &project, const QList<qint64> &dev_id_list,
@@ -40,7 +12,7 @@ void ActDeviceConfiguration::TriggerLocatorForThread(const ActProject &project,
   // Waiting for main thread return running flag to WS
   std::this_thread::yield();
 
-  // Triggered the Locator and wait for the return, and update device_config_thread_.
+  // Triggered the Locator and wait for the return, and update device_config_act_status_.
   try {
     device_config_act_status_ = Locator(project, dev_id_list, duration);
   } catch (std::exception &e) {
@@ -142,7 +114,7 @@ ACT_STATUS ActDeviceConfiguration::Locator(const ActProject &project, const QLis
     }
   }
 
-  SLEEP_MS(1000);
+  WaitResultQueueDrained();
   UpdateProgress(100);
   act_status = ACT_STATUS_SUCCESS;
   return act_status;
@@ -2,10 +2,56 @@
 
 #include <QDebug>
 
+#include "act_readiness_probe.hpp"
+
 ActDeviceConfiguration::~ActDeviceConfiguration() {
-  if ((device_config_thread_ != nullptr) && (device_config_thread_->joinable())) {
-    device_config_thread_->join();
+  if (device_config_job_id_ != -1) {
+    g_act_job_engine.Wait(device_config_job_id_);
+  }
+}
+
+ACT_STATUS ActDeviceConfiguration::StartJob(const ActProject &project, const QString &job_type,
+                                            const std::function<void()> &trigger) {
+  // Checking has the job is running
+  if (IsActStatusRunning(device_config_act_status_)) {
+    qCritical() << __func__ << "Currently has the job running.";
+    return std::make_shared<ActStatusInternalError>("DeviceConfiguration");
   }
+
+  // Check previous job already ended, it refers to this object
+  if (device_config_job_id_ != -1) {
+    g_act_job_engine.Wait(device_config_job_id_);
+  }
+
+  // init ActDeviceConfiguration status
+  progress_ = 0;
+  stop_flag_ = false;
+  southbound_.SetStopFlag(false);
+  device_config_job_progress_ = nullptr;
+  device_config_act_status_ = std::make_shared<ActStatusBase>(ActStatusType::kRunning, ActSeverity::kDebug);
+
+  // The cancellation of the job list stops the southbound as Stop() does
+  auto cancel_token = std::make_shared<ActJobCancelToken>();
+  cancel_token->OnCancel([this]() {
+    southbound_.SetStopFlag(true);
+    stop_flag_ = true;
+  });
+
+  device_config_job_id_ = g_act_job_engine.Submit(
+      project.GetId(), job_type,
+      [this, trigger](ActJobContext &context) -> ACT_STATUS {
+        device_config_job_progress_ = context.progress;
+        trigger();
+        return device_config_act_status_;
+      },
+      cancel_token,
+      [this]() {
+        // Cancelled before it started (e.g. from the job list), the trigger never sets the status
+        device_config_act_status_ = ACT_STATUS_STOP;
+      });
+  qDebug() << "Start" << job_type.toStdString().c_str() << "job:" << device_config_job_id_;
+
+  return std::make_shared<ActProgressStatus>(ActStatusBase(*device_config_act_status_), progress_);
 }
 
 ACT_STATUS ActDeviceConfiguration::GetStatus() {
@@ -24,25 +70,28 @@ ACT_STATUS ActDeviceConfiguration::GetStatus() {
 ACT_STATUS ActDeviceConfiguration::UpdateProgress(quint8 progress) {
   ACT_STATUS_INIT();
   progress_ = progress;
+  if (device_config_job_progress_ != nullptr) {
+    device_config_job_progress_->SetPercent(progress);
+  }
   qDebug() << __func__ << QString("Progress: %1%.").arg(GetProgress()).toStdString().c_str();
   return act_status;
 }
 
+void ActDeviceConfiguration::WaitResultQueueDrained() {
+  ActReadinessProbe probe("DeviceConfiguration results", ACT_DEVICE_CONFIG_RESULT_DRAIN_TIMEOUT);
+  probe.Wait([this]() { return result_queue_.isEmpty() && event_log_result_queue_.isEmpty(); }, &stop_flag_);
+}
+
 ACT_STATUS ActDeviceConfiguration::Stop() {
   // Checking has the thread is running
   if (IsActStatusRunning(device_config_act_status_)) {
-    qDebug() << "Stop DeviceConfiguration's running thread.";
+    qDebug() << "Stop DeviceConfiguration's running job.";
 
-    southbound_.SetStopFlag(true);
-
-    // Send the stop signal and wait for the thread to finish.
-    stop_flag_ = true;
-
-    if ((device_config_thread_ != nullptr) && (device_config_thread_->joinable())) {
-      device_config_thread_->join();  // wait thread finished
-    }
+    // Send the stop signal (the southbound and stop flag) and wait for the job to finish.
+    g_act_job_engine.Cancel(device_config_job_id_);
+    g_act_job_engine.Wait(device_config_job_id_);
   } else {
-    qDebug() << __func__ << "The DeviceConfiguration's thread not running.";
+    qDebug() << __func__ << "The DeviceConfiguration's job not running.";
   }
 
   return std::make_shared<ActProgressStatus>(ActStatusBase(*device_config_act_status_), progress_);
@@ -134,7 +183,8 @@ ACT_STATUS ActDeviceConfiguration::CheckProjectMonitorEndpoint(const ActProject
   return act_status;
 }
 
-ACT_STATUS ActDeviceConfiguration::SortDeviceIdList(const ActProject &project, QList<qint64> &dev_id_list) {
+ACT_STATUS ActDeviceConfiguration::SortDeviceIdList(const ActProject &project, QList<qint64> &dev_id_list,
+                                                    QMap<qint64, qint64> *dev_distance_map) {
   ACT_STATUS_INIT();
 
   ACT_STATUS compute_status = std::make_shared<ActStatusBase>();
@@ -185,6 +235,9 @@ ACT_STATUS ActDeviceConfiguration::SortDeviceIdList(const ActProject &project, Q
   for (auto dist_entry : distance_entry_list) {
     if (select_dev_id_list.contains(dist_entry.GetId())) {
       new_dev_id_list.append(dist_entry.GetId());
+      if ((dev_distance_map != nullptr) && IsActStatusSuccess(compute_status)) {
+        dev_distance_map->insert(dist_entry.GetId(), dist_entry.GetDistance());
+      }
     }
   }
   dev_id_list = new_dev_id_list;
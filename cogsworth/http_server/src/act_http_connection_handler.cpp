@@ -0,0 +1,288 @@
+/* Copyright (C) MOXA Inc. All rights reserved.
+This software is distributed under the terms of the MOXA SOFTWARE NOTICE.
+See the file MOXA-SOFTWARE-NOTICE for details.
+*/
+
+#include "act_http_connection_handler.hpp"
+
+#include <QDebug>
+#include <chrono>
+#include <cstring>
+
+#include "act_system.hpp"
+
+namespace {
+
+v_int64 SteadyMs() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+/**
+ * @brief The connection stream which tells whether the connection is idle (waiting for the next request)
+ *
+ * The connection is idle while it is reading and nothing is read since the last response is written. The worker
+ * handling a request (or streaming a response) is never idle.
+ */
+class ActHttpIdleStream : public oatpp::data::stream::IOStream {
+ public:
+  typedef oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream> ConnectionHandle;
+
+  explicit ActHttpIdleStream(const ConnectionHandle &connection)
+      : m_connection(connection), m_reading(false), m_readSinceWrite(false), m_lastActivity(SteadyMs()) {}
+
+  oatpp::v_io_size read(void *buffer, v_buff_size count, oatpp::async::Action &action) override {
+    m_reading = true;
+    auto result = m_connection.object->read(buffer, count, action);
+    if (result > 0) {
+      m_readSinceWrite = true;
+      m_lastActivity = SteadyMs();
+    }
+    m_reading = false;
+    return result;
+  }
+
+  oatpp::v_io_size write(const void *data, v_buff_size count, oatpp::async::Action &action) override {
+    auto result = m_connection.object->write(data, count, action);
+    if (result > 0) {
+      m_readSinceWrite = false;
+      m_lastActivity = SteadyMs();
+    }
+    return result;
+  }
+
+  void setInputStreamIOMode(oatpp::data::stream::IOMode ioMode) override {
+    m_connection.object->setInputStreamIOMode(ioMode);
+  }
+
+  oatpp::data::stream::IOMode getInputStreamIOMode() override { return m_connection.object->getInputStreamIOMode(); }
+
+  oatpp::data::stream::Context &getInputStreamContext() override {
+    return m_connection.object->getInputStreamContext();
+  }
+
+  void setOutputStreamIOMode(oatpp::data::stream::IOMode ioMode) override {
+    m_connection.object->setOutputStreamIOMode(ioMode);
+  }
+
+  oatpp::data::stream::IOMode getOutputStreamIOMode() override { return m_connection.object->getOutputStreamIOMode(); }
+
+  oatpp::data::stream::Context &getOutputStreamContext() override {
+    return m_connection.object->getOutputStreamContext();
+  }
+
+  /**
+   * @brief Get the time(ms) the connection has been idle
+   *
+   * @param now (steady ms)
+   * @return v_int64 -1 if not idle
+   */
+  v_int64 getIdleTime(v_int64 now) const {
+    if (!m_reading || m_readSinceWrite) {
+      return -1;
+    }
+    return now - m_lastActivity;
+  }
+
+  /**
+   * @brief Restart the idle time (e.g. the queued connection is taken by a worker)
+   *
+   */
+  void touch() { m_lastActivity = SteadyMs(); }
+
+  void invalidate() { m_connection.invalidator->invalidate(m_connection.object); }
+
+ private:
+  ConnectionHandle m_connection;
+  std::atomic<bool> m_reading;
+  std::atomic<bool> m_readSinceWrite;
+  std::atomic<v_int64> m_lastActivity;
+};
+
+/**
+ * @brief Invalidate the wrapped connection of the idle stream
+ *
+ */
+class ActHttpIdleStreamInvalidator : public oatpp::provider::Invalidator<oatpp::data::stream::IOStream> {
+ public:
+  void invalidate(const std::shared_ptr<oatpp::data::stream::IOStream> &connection) override {
+    std::static_pointer_cast<ActHttpIdleStream>(connection)->invalidate();
+  }
+};
+
+}  // namespace
+
+ActHttpConnectionHandler::ActHttpConnectionHandler(const std::shared_ptr<oatpp::web::server::HttpRouter> &router,
+                                                   v_int32 worker_size, v_int32 pending_size,
+                                                   v_int64 keep_alive_timeout)
+    : m_components(std::make_shared<oatpp::web::server::HttpProcessor::Components>(router)),
+      m_pendingSize(pending_size),
+      m_keepAliveTimeout(keep_alive_timeout),
+      m_stopped(false),
+      m_activeCount(0),
+      m_idleClosedCount(0) {
+  for (v_int32 i = 0; i < worker_size; i++) {
+    m_workers.emplace_back(&ActHttpConnectionHandler::workerLoop, this);
+  }
+  m_idleCloser = std::thread(&ActHttpConnectionHandler::idleLoop, this);
+}
+
+ActHttpConnectionHandler::~ActHttpConnectionHandler() {
+  stop();
+
+  for (auto &worker : m_workers) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+  if (m_idleCloser.joinable()) {
+    m_idleCloser.join();
+  }
+}
+
+std::shared_ptr<ActHttpConnectionHandler> ActHttpConnectionHandler::createShared(
+    const std::shared_ptr<oatpp::web::server::HttpRouter> &router, v_int32 worker_size, v_int32 pending_size,
+    v_int64 keep_alive_timeout) {
+  return std::make_shared<ActHttpConnectionHandler>(router, worker_size, pending_size, keep_alive_timeout);
+}
+
+void ActHttpConnectionHandler::handleConnection(const ConnectionHandle &connection,
+                                                const std::shared_ptr<const ParameterMap> &params) {
+  // no effect on the program's behavior
+  static_cast<void>(params);
+
+  // Serve the connection through the idle stream, so the idle keep-alive connection can be found & closed
+  ConnectionHandle idle_connection(std::make_shared<ActHttpIdleStream>(connection),
+                                   std::make_shared<ActHttpIdleStreamInvalidator>());
+
+  bool accepted = false;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_stopped && (static_cast<v_int32>(m_pending.size()) < m_pendingSize)) {
+      m_pending.push_back(idle_connection);
+      accepted = true;
+    }
+  }
+
+  if (!accepted) {
+    rejectConnection(connection);
+    return;
+  }
+
+  m_condition.notify_one();
+}
+
+void ActHttpConnectionHandler::stop() {
+  std::deque<ConnectionHandle> pending;
+  std::vector<ConnectionHandle> active;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_stopped) {
+      return;
+    }
+    m_stopped = true;
+
+    pending.swap(m_pending);
+    for (auto &item : m_active) {
+      active.push_back(item.second);
+    }
+  }
+  m_condition.notify_all();
+
+  // Close the connections, the blocked workers would return from the I/O
+  for (auto &connection : pending) {
+    connection.invalidator->invalidate(connection.object);
+  }
+  for (auto &connection : active) {
+    connection.invalidator->invalidate(connection.object);
+  }
+}
+
+void ActHttpConnectionHandler::onTaskStart(const ConnectionHandle &connection) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_active.insert({connection.object.get(), connection});
+  m_activeCount++;
+  std::static_pointer_cast<ActHttpIdleStream>(connection.object)->touch();
+
+  if (m_stopped) {
+    connection.invalidator->invalidate(connection.object);
+  }
+}
+
+void ActHttpConnectionHandler::onTaskEnd(const ConnectionHandle &connection) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_active.erase(connection.object.get());
+  m_activeCount--;
+}
+
+v_int64 ActHttpConnectionHandler::getPendingCount() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return static_cast<v_int64>(m_pending.size());
+}
+
+void ActHttpConnectionHandler::workerLoop() {
+  while (true) {
+    ConnectionHandle connection;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_condition.wait(lock, [this] { return m_stopped || !m_pending.empty(); });
+      if (m_stopped) {
+        return;
+      }
+
+      connection = m_pending.front();
+      m_pending.pop_front();
+    }
+
+    try {
+      oatpp::web::server::HttpProcessor::Task task(m_components, connection, this);
+      task.run();
+    } catch (std::exception &e) {
+      qCritical() << __func__ << "HTTP connection task failed:" << e.what();
+    }
+  }
+}
+
+void ActHttpConnectionHandler::idleLoop() {
+  while (true) {
+    std::vector<std::shared_ptr<ActHttpIdleStream>> idle_connections;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_condition.wait_for(lock, std::chrono::milliseconds(ACT_HTTP_KEEP_ALIVE_CHECK), [this] { return m_stopped; });
+      if (m_stopped) {
+        return;
+      }
+
+      // The queued connections are waiting for the workers held by the idle ones
+      const v_int64 timeout = m_pending.empty() ? m_keepAliveTimeout : qMin<v_int64>(m_keepAliveTimeout,
+                                                                                      ACT_HTTP_KEEP_ALIVE_GRACE);
+      const v_int64 now = SteadyMs();
+      for (auto &item : m_active) {
+        auto stream = std::static_pointer_cast<ActHttpIdleStream>(item.second.object);
+        if (stream->getIdleTime(now) >= timeout) {
+          idle_connections.push_back(stream);
+        }
+      }
+    }
+
+    // The blocked worker returns from the read and ends the task
+    for (auto &stream : idle_connections) {
+      stream->invalidate();
+      m_idleClosedCount++;
+    }
+  }
+}
+
+void ActHttpConnectionHandler::rejectConnection(const ConnectionHandle &connection) {
+  static const char *kServiceUnavailable =
+      "HTTP/1.1 503 Service Unavailable\r\n"
+      "Connection: close\r\n"
+      "Retry-After: 1\r\n"
+      "Content-Length: 0\r\n"
+      "\r\n";
+
+  qWarning() << __func__ << "HTTP pending connections exceed the limit:" << m_pendingSize;
+
+  connection.object->writeExactSizeDataSimple(kServiceUnavailable, std::strlen(kServiceUnavailable));
+  connection.invalidator->invalidate(connection.object);
+}
@@ -0,0 +1,119 @@
+/* Copyright (C) MOXA Inc. All rights reserved.
+This software is distributed under the terms of the MOXA SOFTWARE NOTICE.
+See the file MOXA-SOFTWARE-NOTICE for details.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "oatpp/network/ConnectionHandler.hpp"
+#include "oatpp/web/server/HttpProcessor.hpp"
+#include "oatpp/web/server/HttpRouter.hpp"
+
+/**
+ * @brief The HTTP connection handler which serves the connections on a bounded worker pool
+ *
+ * The oatpp HttpConnectionHandler spawns one detached thread per connection, so a burst of slow requests (blocked on
+ * the core lock) keeps creating threads until the process is exhausted. This handler queues the accepted connections
+ * and serves them on a fixed number of workers. When the pending queue is full, the new connection is answered with
+ * "503 Service Unavailable" immediately instead of waiting forever.
+ *
+ * A keep-alive connection holds its worker between the requests, so the connection idle (waiting for the next
+ * request) over the keep-alive timeout is closed, and right away after a short grace while other connections are
+ * queued. The clients reopen the closed keep-alive connections as usual.
+ */
+class ActHttpConnectionHandler : public oatpp::network::ConnectionHandler,
+                                 public oatpp::web::server::HttpProcessor::TaskProcessingListener {
+ public:
+  typedef oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream> ConnectionHandle;
+
+  /**
+   * @brief Construct a new Act Http Connection Handler object
+   *
+   * @param router
+   * @param worker_size the number of the worker threads
+   * @param pending_size the maximum number of the queued connections
+   * @param keep_alive_timeout the time(ms) an idle keep-alive connection holds its worker
+   */
+  ActHttpConnectionHandler(const std::shared_ptr<oatpp::web::server::HttpRouter> &router, v_int32 worker_size,
+                           v_int32 pending_size, v_int64 keep_alive_timeout);
+
+  ~ActHttpConnectionHandler() override;
+
+  static std::shared_ptr<ActHttpConnectionHandler> createShared(
+      const std::shared_ptr<oatpp::web::server::HttpRouter> &router, v_int32 worker_size, v_int32 pending_size,
+      v_int64 keep_alive_timeout);
+
+  /**
+   * @brief Queue the connection to the worker pool
+   *
+   * @param connection
+   * @param params
+   */
+  void handleConnection(const ConnectionHandle &connection,
+                        const std::shared_ptr<const ParameterMap> &params) override;
+
+  /**
+   * @brief Stop the workers and close all connections
+   *
+   */
+  void stop() override;
+
+  void onTaskStart(const ConnectionHandle &connection) override;
+
+  void onTaskEnd(const ConnectionHandle &connection) override;
+
+  /**
+   * @brief Get the number of the connections served by the workers
+   *
+   * @return v_int64
+   */
+  v_int64 getActiveCount() const { return m_activeCount.load(); }
+
+  /**
+   * @brief Get the number of the queued connections
+   *
+   * @return v_int64
+   */
+  v_int64 getPendingCount();
+
+  /**
+   * @brief Get the number of the idle keep-alive connections closed
+   *
+   * @return v_int64
+   */
+  v_int64 getIdleClosedCount() const { return m_idleClosedCount.load(); }
+
+ private:
+  void workerLoop();
+
+  /**
+   * @brief Close the idle keep-alive connections periodically
+   *
+   */
+  void idleLoop();
+
+  void rejectConnection(const ConnectionHandle &connection);
+
+  std::shared_ptr<oatpp::web::server::HttpProcessor::Components> m_components;
+  v_int32 m_pendingSize;
+  v_int64 m_keepAliveTimeout;
+
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  std::deque<ConnectionHandle> m_pending;
+  std::unordered_map<oatpp::data::stream::IOStream *, ConnectionHandle> m_active;
+  bool m_stopped;
+
+  std::atomic<v_int64> m_activeCount;
+  std::atomic<v_int64> m_idleClosedCount;
+  std::vector<std::thread> m_workers;
+  std::thread m_idleCloser;
+};
@@ -5,12 +5,14 @@ See the file MOXA-SOFTWARE-NOTICE for details.
 
 #pragma once
 
+#include "act_http_connection_handler.hpp"
+#include "act_system.hpp"
 #include "http_utils.h"
 #include "oatpp-websocket/ConnectionHandler.hpp"
+#include "oatpp/core/async/Executor.hpp"
 #include "oatpp/core/macro/component.hpp"
 #include "oatpp/network/tcp/server/ConnectionProvider.hpp"
 #include "oatpp/parser/json/mapping/ObjectMapper.hpp"
-#include "oatpp/web/server/HttpConnectionHandler.hpp"
 #include "oatpp/web/server/HttpRouter.hpp"
 #include "swagger_component.hpp"
 #include "websocket/act_ws_listener.hpp"
@@ -42,12 +44,22 @@ class AppComponent {
   ([] { return oatpp::web::server::HttpRouter::createShared(); }());
 
   /**
-   *  Create http ConnectionHandler
+   *  Create http ConnectionHandler which serves the connections on a bounded worker pool
    */
   OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::network::ConnectionHandler>, httpConnectionHandler)
   ("https" /* qualifier */, [] {
     OATPP_COMPONENT(std::shared_ptr<oatpp::web::server::HttpRouter>, router);  // get Router component
-    return oatpp::web::server::HttpConnectionHandler::createShared(router);
+    return ActHttpConnectionHandler::createShared(router, ACT_HTTP_WORKER_THREAD_SIZE,
+                                                  ACT_HTTP_PENDING_CONNECTION_SIZE, ACT_HTTP_KEEP_ALIVE_TIMEOUT);
+  }());
+
+  /**
+   *  Create the async Executor shared by the websocket connections
+   */
+  OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::async::Executor>, executor)
+  ([] {
+    return std::make_shared<oatpp::async::Executor>(ACT_HTTP_ASYNC_WORKER_THREAD_SIZE /* data-processing workers */,
+                                                    1 /* I/O workers */, 1 /* timer workers */);
   }());
 
   /**
@@ -61,10 +73,9 @@ class AppComponent {
    */
   OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::network::ConnectionHandler>, websocketConnectionHandler)
   ("websocket", [] {
-    // OATPP_COMPONENT(std::shared_ptr<oatpp::async::Executor>, executor);
-    // auto connectionHandler = oatpp::websocket::AsyncConnectionHandler::createShared(executor);
-    auto connectionHandler = oatpp::websocket::AsyncConnectionHandler::createShared();
-    connectionHandler->setSocketInstanceListener(std::make_shared<WSInstanceListener>());
+    OATPP_COMPONENT(std::shared_ptr<oatpp::async::Executor>, executor);
+    auto connectionHandler = oatpp::websocket::AsyncConnectionHandler::createShared(executor);
+    connectionHandler->setSocketInstanceListener(std::make_shared<WSInstanceListener>(executor));
     return connectionHandler;
   }());
 
@@ -108,6 +108,96 @@ class ActDeployController : public oatpp::web::server::api::ApiController {
     // qDebug() << "Response: Success(200)";
     return createResponse(Status::CODE_200, deploy_device_list.ToString().toStdString());
   }
+
+  ENDPOINT_INFO(GetDeployPlan) {
+    info->summary = "Get the planned changes of the deploy (dry run)";
+    info->addSecurityRequirement("my-realm");
+    info->addTag("Deploy");
+    info->description =
+        "This RESTful API only permit for [Admin, Supervisor, User]. Only the tables different from the last deployed "
+        "ones are listed, no device is touched";
+    info->addResponse<Object<ActDeployPlanDto>>(Status::CODE_200, "application/json");
+    info->addResponse<Object<ActBadRequestDto>>(Status::CODE_400, "application/json")
+        .addExample("Bad Request", ActStatusDto::createShared(StatusDtoEnum::kFailed, SeverityDtoEnum::kCritical));
+    info->addResponse<Object<ActStatusDto>>(Status::CODE_401, "application/json")
+        .addExample("Unauthorized", ActStatusDto::createShared(StatusDtoEnum::kFailed, SeverityDtoEnum::kCritical));
+    info->addResponse<Object<ActStatusDto>>(Status::CODE_403, "application/json")
+        .addExample("Forbidden", ActStatusDto::createShared(StatusDtoEnum::kFailed, SeverityDtoEnum::kCritical));
+    info->addResponse<Object<ActStatusDto>>(Status::CODE_404, "application/json")
+        .addExample("Not Found", ActStatusDto::createShared(StatusDtoEnum::kNotFound, SeverityDtoEnum::kCritical));
+
+    info->queryParams.add<String>("deviceIds").description =
+        "The comma separated device identifiers to deploy. Default: all deployable devices.";
+    info->queryParams["deviceIds"].required = false;
+    info->queryParams.add<String>("action").description =
+        "The deploy action: 'All', 'Reboot', 'FactoryDefault', 'FirmwareUpgrade', 'NetworkSetting' or 'VLAN'. "
+        "Default: 'All'.";
+    info->queryParams["action"].required = false;
+
+    info->pathParams["projectId"].description = "The identifier of the project";
+  }
+
+  ENDPOINT("GET", QString("%1/project/{projectId}/deploy-plan").arg(ACT_API_PATH_PREFIX).toStdString(),
+           GetDeployPlan, PATH(UInt64, projectId), REQUEST(std::shared_ptr<IncomingRequest>, request),
+           AUTHORIZATION(std::shared_ptr<BearerAuthorizationObject>, authorizationBearer, m_authHandler)) {
+    if (authorizationBearer->role == ActRoleEnum::kUnauthorized) {
+      ActUnauthorized unauthorized;
+      qDebug() << "Response:" << GetStringFromEnum<ActStatusType>(unauthorized.GetStatus(), kActStatusTypeMap)
+               << unauthorized.ToString(unauthorized.key_order_).toStdString().c_str();
+      return createResponse(TransferActStatusToOatppStatus(unauthorized.GetStatus()),
+                            unauthorized.ToString(unauthorized.key_order_).toStdString());
+    }
+
+    auto routes = request->getStartingLine().path.std_str();
+    qDebug() << "GET URL:" << routes.c_str();
+    qDebug() << "projectId:" << *projectId;
+
+    // Parse the query parameters
+    QList<qint64> dev_id_list;
+    oatpp::String device_ids_q = request->getQueryParameter("deviceIds", "");
+    for (const QString &device_id_str :
+         QString(device_ids_q ? device_ids_q->c_str() : "").split(",", Qt::SkipEmptyParts)) {
+      bool ok = false;
+      const qint64 device_id = device_id_str.trimmed().toLongLong(&ok);
+      if (!ok) {
+        ActBadRequest bad_request(QString("Invalid device id: %1").arg(device_id_str));
+        qDebug() << "Response:" << GetStringFromEnum<ActStatusType>(bad_request.GetStatus(), kActStatusTypeMap)
+                 << bad_request.ToString(bad_request.key_order_).toStdString().c_str();
+        return createResponse(TransferActStatusToOatppStatus(bad_request.GetStatus()),
+                              bad_request.ToString(bad_request.key_order_).toStdString());
+      }
+      dev_id_list.append(device_id);
+    }
+
+    oatpp::String action_q = request->getQueryParameter("action", "All");
+    const QString action_str(action_q ? action_q->c_str() : "All");
+    if (!kActDeployActionEnumMap.contains(action_str)) {
+      ActBadRequest bad_request(QString("Invalid deploy action: %1").arg(action_str));
+      qDebug() << "Response:" << GetStringFromEnum<ActStatusType>(bad_request.GetStatus(), kActStatusTypeMap)
+               << bad_request.ToString(bad_request.key_order_).toStdString().c_str();
+      return createResponse(TransferActStatusToOatppStatus(bad_request.GetStatus()),
+                            bad_request.ToString(bad_request.key_order_).toStdString());
+    }
+
+    // Handle request
+    ACT_STATUS_INIT();
+    std::lock_guard<oatpp::concurrency::SpinLock> lock(m_lock);
+
+    QMutexLocker core_lock(&act::core::g_core.mutex_);
+
+    act::deploy::ActDeployPlan deploy_plan;
+    qint64 project_id = *projectId;
+    act_status =
+        act::core::g_core.GetDeployPlan(project_id, dev_id_list, kActDeployActionEnumMap[action_str], deploy_plan);
+    if (!IsActStatusSuccess(act_status)) {
+      qDebug() << "Response:" << act_status->ToString(act_status->key_order_).toStdString().c_str();
+      return createResponse(TransferActStatusToOatppStatus(act_status->GetStatus()),
+                            act_status->ToString(act_status->key_order_).toStdString());
+    }
+
+    // qDebug() << "Response: Success(200)";
+    return createResponse(Status::CODE_200, deploy_plan.ToString().toStdString());
+  }
 };
 
 #include OATPP_CODEGEN_END(ApiController)  //<-- End Codegen
@@ -481,6 +481,125 @@ class ActMonitorController : public oatpp::web::server::api::ApiController {
     // qDebug() << "Response: Success(200)";
     return createResponse(Status::CODE_200, traffic_status.ToString().toStdString());
   }
+
+  ENDPOINT_INFO(GetTimeSeriesMetrics) {
+    info->summary = "Get the monitored metrics which have the history";
+    info->addSecurityRequirement("my-realm");
+    info->addTag("Monitor - UI");
+    info->description = "This RESTful API only permit for [Admin, Supervisor, User]";
+    info->addResponse<Object<ActTimeSeriesMetricsDto>>(Status::CODE_200, "application/json");
+    info->addResponse<Object<ActBadRequestDto>>(Status::CODE_400, "application/json")
+        .addExample("Bad Request", ActStatusDto::createShared(StatusDtoEnum::kFailed, SeverityDtoEnum::kCritical));
+    info->addResponse<Object<ActStatusDto>>(Status::CODE_401, "application/json")
+        .addExample("Unauthorized", ActStatusDto::createShared(StatusDtoEnum::kFailed, SeverityDtoEnum::kCritical));
+    info->addResponse<Object<ActStatusDto>>(Status::CODE_403, "application/json")
+        .addExample("Forbidden", ActStatusDto::createShared(StatusDtoEnum::kFailed, SeverityDtoEnum::kCritical));
+    info->addResponse<Object<ActStatusDto>>(Status::CODE_404, "application/json")
+        .addExample("Not Found", ActStatusDto::createShared(StatusDtoEnum::kNotFound, SeverityDtoEnum::kCritical));
+
+    info->pathParams["projectId"].description = "The identifier of the project";
+  }
+  ENDPOINT("GET", QString("%1/project/{projectId}/monitor/time-series/metrics").arg(ACT_API_PATH_PREFIX).toStdString(),
+           GetTimeSeriesMetrics, PATH(UInt64, projectId), REQUEST(std::shared_ptr<IncomingRequest>, request),
+           AUTHORIZATION(std::shared_ptr<BearerAuthorizationObject>, authorizationBearer, m_authHandler)) {
+    if (authorizationBearer->role == ActRoleEnum::kUnauthorized) {
+      ActUnauthorized unauthorized;
+      qDebug() << "Response:" << GetStringFromEnum<ActStatusType>(unauthorized.GetStatus(), kActStatusTypeMap)
+               << unauthorized.ToString(unauthorized.key_order_).toStdString().c_str();
+      return createResponse(TransferActStatusToOatppStatus(unauthorized.GetStatus()),
+                            unauthorized.ToString(unauthorized.key_order_).toStdString());
+    }
+
+    auto routes = request->getStartingLine().path.std_str();
+    qDebug() << "GET URL:" << routes.c_str();
+
+    // Handle request
+    ACT_STATUS_INIT();
+    std::lock_guard<oatpp::concurrency::SpinLock> lock(m_lock);
+
+    ActTimeSeriesMetrics metrics;
+    qint64 project_id = *projectId;
+
+    QMutexLocker core_lock(&act::core::g_core.mutex_);
+
+    act_status = act::core::g_core.GetMonitorTimeSeriesMetrics(project_id, metrics);
+    if (!IsActStatusSuccess(act_status)) {
+      qDebug() << "Response:" << act_status->ToString(act_status->key_order_).toStdString().c_str();
+      return createResponse(TransferActStatusToOatppStatus(act_status->GetStatus()),
+                            act_status->ToString(act_status->key_order_).toStdString());
+    }
+
+    return createResponse(Status::CODE_200, metrics.ToString().toStdString());
+  }
+
+  ENDPOINT_INFO(GetTimeSeries) {
+    info->summary = "Get the history of the monitored metric";
+    info->addSecurityRequirement("my-realm");
+    info->addTag("Monitor - UI");
+    info->description = "This RESTful API only permit for [Admin, Supervisor, User]";
+    info->addResponse<Object<ActTimeSeriesDto>>(Status::CODE_200, "application/json");
+    info->addResponse<Object<ActBadRequestDto>>(Status::CODE_400, "application/json")
+        .addExample("Bad Request", ActStatusDto::createShared(StatusDtoEnum::kFailed, SeverityDtoEnum::kCritical));
+    info->addResponse<Object<ActStatusDto>>(Status::CODE_401, "application/json")
+        .addExample("Unauthorized", ActStatusDto::createShared(StatusDtoEnum::kFailed, SeverityDtoEnum::kCritical));
+    info->addResponse<Object<ActStatusDto>>(Status::CODE_403, "application/json")
+        .addExample("Forbidden", ActStatusDto::createShared(StatusDtoEnum::kFailed, SeverityDtoEnum::kCritical));
+    info->addResponse<Object<ActStatusDto>>(Status::CODE_404, "application/json")
+        .addExample("Not Found", ActStatusDto::createShared(StatusDtoEnum::kNotFound, SeverityDtoEnum::kCritical));
+
+    info->pathParams["projectId"].description = "The identifier of the project";
+    info->queryParams["metric"].description =
+        std::string("The metric, e.g. \"device/{deviceId}/port/{portId}/utilization\", ") +
+        std::string("\"device/{deviceId}/cpu-usage\", \"link/{linkId}/source-utilization\", ") +
+        std::string("\"link/{linkId}/status\".");
+    info->queryParams["from"].description = "The start of the range (ms since epoch).";
+    info->queryParams["to"].description = "The end of the range (ms since epoch).";
+    info->queryParams["resolution"].description =
+        "\"Raw\", \"Minute\", \"Hour\" or \"Auto\" (the finest one which covers the range).";
+  }
+  ENDPOINT("GET", QString("%1/project/{projectId}/monitor/time-series").arg(ACT_API_PATH_PREFIX).toStdString(),
+           GetTimeSeries, PATH(UInt64, projectId), QUERY(String, metric), QUERY(Int64, from), QUERY(Int64, to),
+           QUERY(String, resolution), REQUEST(std::shared_ptr<IncomingRequest>, request),
+           AUTHORIZATION(std::shared_ptr<BearerAuthorizationObject>, authorizationBearer, m_authHandler)) {
+    if (authorizationBearer->role == ActRoleEnum::kUnauthorized) {
+      ActUnauthorized unauthorized;
+      qDebug() << "Response:" << GetStringFromEnum<ActStatusType>(unauthorized.GetStatus(), kActStatusTypeMap)
+               << unauthorized.ToString(unauthorized.key_order_).toStdString().c_str();
+      return createResponse(TransferActStatusToOatppStatus(unauthorized.GetStatus()),
+                            unauthorized.ToString(unauthorized.key_order_).toStdString());
+    }
+
+    auto routes = request->getStartingLine().path.std_str();
+    qDebug() << "GET URL:" << routes.c_str();
+
+    // Handle request
+    ACT_STATUS_INIT();
+    std::lock_guard<oatpp::concurrency::SpinLock> lock(m_lock);
+
+    const QString resolution_str = QString::fromStdString(*resolution);
+    if (!kActTimeSeriesResolutionEnumMap.contains(resolution_str)) {
+      ActBadRequest bad_request(QString("The resolution(%1) is invalid").arg(resolution_str));
+      qDebug() << "Response:" << bad_request.ToString(bad_request.key_order_).toStdString().c_str();
+      return createResponse(TransferActStatusToOatppStatus(bad_request.GetStatus()),
+                            bad_request.ToString(bad_request.key_order_).toStdString());
+    }
+
+    ActTimeSeries time_series;
+    qint64 project_id = *projectId;
+
+    QMutexLocker core_lock(&act::core::g_core.mutex_);
+
+    act_status = act::core::g_core.GetMonitorTimeSeries(project_id, QString::fromStdString(*metric), *from, *to,
+                                                         kActTimeSeriesResolutionEnumMap.value(resolution_str),
+                                                         time_series);
+    if (!IsActStatusSuccess(act_status)) {
+      qDebug() << "Response:" << act_status->ToString(act_status->key_order_).toStdString().c_str();
+      return createResponse(TransferActStatusToOatppStatus(act_status->GetStatus()),
+                            act_status->ToString(act_status->key_order_).toStdString());
+    }
+
+    return createResponse(Status::CODE_200, time_series.ToString().toStdString());
+  }
 };
 
 #include OATPP_CODEGEN_END(ApiController)  //<-- End Codegen
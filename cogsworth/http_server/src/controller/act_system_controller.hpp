@@ -290,6 +290,84 @@ class ActSystemController : public oatpp::web::server::api::ApiController {
     return createResponse(Status::CODE_200, system.ToString(system.key_order_).toStdString().c_str());
   }
 
+  ENDPOINT_INFO(GetJobs) {
+    info->summary = "Get the background jobs of all the projects";
+    info->addSecurityRequirement("my-realm");
+    info->addTag("System");
+    info->description = "This RESTful API only permit for [Admin, Supervisor, User]";
+    info->addResponse<Object<ActJobListDto>>(Status::CODE_200, "application/json");
+    info->addResponse<Object<ActStatusDto>>(Status::CODE_401, "application/json")
+        .addExample("Unauthorized", ActStatusDto::createShared(StatusDtoEnum::kFailed, SeverityDtoEnum::kCritical));
+  }
+  ENDPOINT("GET", QString("%1/system/jobs").arg(ACT_API_PATH_PREFIX).toStdString(), GetJobs,
+           REQUEST(std::shared_ptr<IncomingRequest>, request),
+           AUTHORIZATION(std::shared_ptr<BearerAuthorizationObject>, authorizationBearer, m_authHandler)) {
+    if (authorizationBearer->role == ActRoleEnum::kUnauthorized) {
+      ActUnauthorized unauthorized;
+      qDebug() << "Response:" << GetStringFromEnum<ActStatusType>(unauthorized.GetStatus(), kActStatusTypeMap)
+               << unauthorized.ToString(unauthorized.key_order_).toStdString().c_str();
+      return createResponse(TransferActStatusToOatppStatus(unauthorized.GetStatus()),
+                            unauthorized.ToString(unauthorized.key_order_).toStdString());
+    }
+
+    auto routes = request->getStartingLine().path.std_str();
+    qDebug() << "GET URL:" << routes.c_str();
+
+    // The job engine has its own lock
+    ActJobList job_list;
+    g_act_job_engine.GetJobs(-1, job_list);
+
+    return createResponse(Status::CODE_200, job_list.ToString().toStdString());
+  }
+
+  ENDPOINT_INFO(CancelJob) {
+    info->summary = "Cancel the background job";
+    info->addSecurityRequirement("my-realm");
+    info->addTag("System");
+    info->description = "This RESTful API only permit for [Admin, Supervisor]";
+    info->addResponse<Object<ActStatusDto>>(Status::CODE_204, "application/json");
+    info->addResponse<Object<ActStatusDto>>(Status::CODE_401, "application/json")
+        .addExample("Unauthorized", ActStatusDto::createShared(StatusDtoEnum::kFailed, SeverityDtoEnum::kCritical));
+    info->addResponse<Object<ActStatusDto>>(Status::CODE_403, "application/json")
+        .addExample("Forbidden", ActStatusDto::createShared(StatusDtoEnum::kFailed, SeverityDtoEnum::kCritical));
+    info->addResponse<Object<ActStatusDto>>(Status::CODE_404, "application/json")
+        .addExample("Not Found", ActStatusDto::createShared(StatusDtoEnum::kNotFound, SeverityDtoEnum::kCritical));
+  }
+  ENDPOINT("DELETE", QString("%1/system/job/{jobId}").arg(ACT_API_PATH_PREFIX).toStdString(), CancelJob,
+           PATH(UInt64, jobId), REQUEST(std::shared_ptr<IncomingRequest>, request),
+           AUTHORIZATION(std::shared_ptr<BearerAuthorizationObject>, authorizationBearer, m_authHandler)) {
+    if (authorizationBearer->role == ActRoleEnum::kUnauthorized) {
+      ActUnauthorized unauthorized;
+      qDebug() << "Response:" << GetStringFromEnum<ActStatusType>(unauthorized.GetStatus(), kActStatusTypeMap)
+               << unauthorized.ToString(unauthorized.key_order_).toStdString().c_str();
+      return createResponse(TransferActStatusToOatppStatus(unauthorized.GetStatus()),
+                            unauthorized.ToString(unauthorized.key_order_).toStdString());
+    }
+
+    auto routes = request->getStartingLine().path.std_str();
+    qDebug() << "DELETE URL:" << routes.c_str();
+
+    ACT_STATUS_INIT();
+
+    if (authorizationBearer->role == ActRoleEnum::kUser) {
+      qDebug() << "Response:" << GetStringFromEnum<ActStatusType>(ActStatusType::kForbidden, kActStatusTypeMap);
+      act_status->SetActStatus(ActStatusType::kForbidden, ActSeverity::kCritical);
+      return createResponse(Status::CODE_403, act_status->ToString(act_status->key_order_).toStdString());
+    }
+
+    // The running job stops at its next check of the stop flag
+    act_status = g_act_job_engine.Cancel(*jobId);
+    if (!IsActStatusSuccess(act_status)) {
+      qDebug() << "Response:" << act_status->ToString(act_status->key_order_).toStdString().c_str();
+      return createResponse(TransferActStatusToOatppStatus(act_status->GetStatus()),
+                            act_status->ToString(act_status->key_order_).toStdString());
+    }
+
+    act_status->SetStatus(ActStatusType::kNoContent);
+    return createResponse(TransferActStatusToOatppStatus(act_status->GetStatus()),
+                          act_status->ToString(act_status->key_order_).toStdString());
+  }
+
   ENDPOINT_INFO(OpenBrowser) {
     info->summary = "Open the system browser";
     info->addTag("System");
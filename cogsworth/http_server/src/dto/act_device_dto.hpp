@@ -423,6 +423,24 @@ class ActDeployDeviceListDto : public oatpp::DTO {
   DTO_FIELD(List<Object<ActDeployDeviceDto>>, device_list, "DeviceList");
 };
 
+class ActDeployTableChangeDto : public oatpp::DTO {
+  DTO_INIT(ActDeployTableChangeDto, DTO)
+
+  DTO_FIELD(Int64, device_id, "DeviceId");
+  DTO_FIELD(String, table, "Table");
+  DTO_FIELD(String, action, "Action");  // Create/Update
+};
+
+/**
+ *  Data Transfer Object. Object containing fields only.
+ *  Used in API for serialization/deserialization and validation
+ */
+class ActDeployPlanDto : public oatpp::DTO {
+  DTO_INIT(ActDeployPlanDto, DTO)
+
+  DTO_FIELD(List<Object<ActDeployTableChangeDto>>, changes, "Changes");
+};
+
 class ActDeviceOfflineConfigFileMapDto : public oatpp::DTO {
   DTO_INIT(ActDeviceOfflineConfigFileMapDto, DTO)
 
@@ -13,6 +13,9 @@ See the file MOXA-SOFTWARE-NOTICE for details.
 
 ENUM(ActLinkStatusTypeDtoEnum, v_int32, VALUE(kUp, 1, "Up"), VALUE(kDown, 2, "Down"))
 
+ENUM(ActTimeSeriesResolutionDtoEnum, v_int32, VALUE(kAuto, 0, "Auto"), VALUE(kRaw, 1, "Raw"),
+     VALUE(kMinute, 2, "Minute"), VALUE(kHour, 3, "Hour"))
+
 class ActMonitorDeviceBasicInfoDto : public oatpp::DTO {
   DTO_INIT(ActMonitorDeviceBasicInfoDto, DTO)
 
@@ -94,4 +97,42 @@ class ActMonitorDeviceTrafficStatusDto : public oatpp::DTO {
   DTO_FIELD(Fields<Object<ActDeviceMonitorTrafficEntryDto>>, traffic_map, "TrafficMap");
 };
 
+/**
+ *  Data Transfer Object. Object containing fields only.
+ *  Used in API for serialization/deserialization and validation
+ */
+class ActTimeSeriesPointDto : public oatpp::DTO {
+  DTO_INIT(ActTimeSeriesPointDto, DTO)
+
+  DTO_FIELD(Int64, timestamp, "Timestamp");
+  DTO_FIELD(Float64, value, "Value");
+  DTO_FIELD(Float64, min, "Min");
+  DTO_FIELD(Float64, max, "Max");
+  DTO_FIELD(Int64, count, "Count");
+};
+
+/**
+ *  Data Transfer Object. Object containing fields only.
+ *  Used in API for serialization/deserialization and validation
+ */
+class ActTimeSeriesDto : public oatpp::DTO {
+  DTO_INIT(ActTimeSeriesDto, DTO)
+
+  DTO_FIELD(String, metric, "Metric");
+  DTO_FIELD(Enum<ActTimeSeriesResolutionDtoEnum>, resolution, "Resolution");
+  DTO_FIELD(Int64, from, "From");
+  DTO_FIELD(Int64, to, "To");
+  DTO_FIELD(List<Object<ActTimeSeriesPointDto>>, points, "Points");
+};
+
+/**
+ *  Data Transfer Object. Object containing fields only.
+ *  Used in API for serialization/deserialization and validation
+ */
+class ActTimeSeriesMetricsDto : public oatpp::DTO {
+  DTO_INIT(ActTimeSeriesMetricsDto, DTO)
+
+  DTO_FIELD(List<String>, metrics, "Metrics");
+};
+
 #include OATPP_CODEGEN_END(DTO)
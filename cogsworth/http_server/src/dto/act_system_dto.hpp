@@ -51,6 +51,37 @@ class ActSystemDto : public oatpp::DTO {
   DTO_FIELD(String, IntelligentLocalEndpoint) = ACT_DEFAULT_INTELLIGENT_LOCAL_ENDPOINT;
 };
 
+ENUM(ActJobStateDtoEnum, v_int32, VALUE(kQueued, 1, "Queued"), VALUE(kRunning, 2, "Running"),
+     VALUE(kFinished, 3, "Finished"), VALUE(kFailed, 4, "Failed"), VALUE(kCancelled, 5, "Cancelled"))
+
+/**
+ *  Data Transfer Object. Object containing fields only.
+ *  Used in API for serialization/deserialization and validation
+ */
+class ActJobInfoDto : public oatpp::DTO {
+  DTO_INIT(ActJobInfoDto, DTO)
+
+  DTO_FIELD(Int64, id, "Id");
+  DTO_FIELD(Int64, project_id, "ProjectId");
+  DTO_FIELD(String, type, "Type");
+  DTO_FIELD(Enum<ActJobStateDtoEnum>, state, "State");
+  DTO_FIELD(UInt8, progress, "Progress");
+  DTO_FIELD(Int64, created_time, "CreatedTime");
+  DTO_FIELD(Int64, started_time, "StartedTime");
+  DTO_FIELD(Int64, finished_time, "FinishedTime");
+  DTO_FIELD(String, error_message, "ErrorMessage");
+};
+
+/**
+ *  Data Transfer Object. Object containing fields only.
+ *  Used in API for serialization/deserialization and validation
+ */
+class ActJobListDto : public oatpp::DTO {
+  DTO_INIT(ActJobListDto, DTO)
+
+  DTO_FIELD(List<Object<ActJobInfoDto>>, jobs, "Jobs");
+};
+
 #include OATPP_CODEGEN_END(DTO)
 
 #endif /* ACT_SYSTEM_DTO_HPP */
@@ -5,7 +5,7 @@
 #define SLEEP_MS(ms) Sleep(ms)
 #else
 #include <unistd.h>  // for sleep
-#define SLEEP_MS(ms) sleep(ms / 1000)
+#define SLEEP_MS(ms) usleep((ms) * 1000)
 #endif
 
 #include <QDateTime>
@@ -558,8 +558,11 @@ oatpp::async::CoroutineStarter WSListener::readMessage(const std::shared_ptr<Asy
 
         QList<qint64> dev_id_list = config_dev_id_list_fw_cmd.GetId();
         QString firmware_name = config_dev_id_list_fw_cmd.GetFirmwareName();
-        act_status =
-            act::core::g_core.StartConfigFirmwareUpgrade(project_id, ws_listener_id, dev_id_list, firmware_name);
+        ActFirmwareRolloutSetting rollout_setting;
+        rollout_setting.SetWaveWidth(config_dev_id_list_fw_cmd.GetWaveWidth());
+        rollout_setting.SetBandwidthLimit(config_dev_id_list_fw_cmd.GetBandwidthLimit());
+        act_status = act::core::g_core.StartConfigFirmwareUpgrade(project_id, ws_listener_id, dev_id_list,
+                                                                  firmware_name, rollout_setting);
         if (!IsActStatusSuccess(act_status)) {
           qCritical() << "Start ConfigFirmwareUpgrade failed";
         }
@@ -623,6 +626,12 @@ oatpp::async::CoroutineStarter WSListener::readMessage(const std::shared_ptr<Asy
           qCritical() << "Get project data version failed";
         }
       } break;
+      case ActWSCommandEnum::kPatchUpdateResync: {
+        act_status = act::core::g_core.ResyncPatchUpdate(project_id, ws_listener_id);
+        if (!IsActStatusSuccess(act_status)) {
+          qCritical() << "Resync patch update failed";
+        }
+      } break;
       case ActWSCommandEnum::kStartMonitor: {
         ActStartMonitorWSCommand start_monitor_cmd;
         try {
@@ -801,7 +810,7 @@ void WSListener::sendMessage(const oatpp::String &message) {
       return oatpp::async::synchronize(m_lock, m_websocket->sendOneFrameTextAsync(m_message)).next(finish());
     }
   };
-  m_asyncExecutor.execute<SendMessageCoroutine>(&m_writeLock, m_socket, message);
+  m_asyncExecutor->execute<SendMessageCoroutine>(&m_writeLock, m_socket, message);
 }
 
 void WSListener::getId(qint64 &id) { id = m_id; }
@@ -827,7 +836,7 @@ void WSInstanceListener::onAfterCreate_NonBlocking(const std::shared_ptr<AsyncWe
   SOCKETS++;
   QDateTime current_date_time = QDateTime::currentDateTime();
   qint64 milliseconds_since_epoch = current_date_time.toMSecsSinceEpoch();
-  auto ws_listener = std::make_shared<WSListener>(socket, milliseconds_since_epoch, project_id);
+  auto ws_listener = std::make_shared<WSListener>(socket, milliseconds_since_epoch, project_id, m_executor);
 
   act_status = act::core::g_core.AddWSListener(ws_listener);
 
@@ -30,12 +30,16 @@ class WSListener : public oatpp::websocket::AsyncWebSocket::Listener {
   qint64 m_id;
   qint64 m_project_id;
 
-  oatpp::async::Executor m_asyncExecutor;
+  /**
+   * The executor shared by all listeners, which runs the send coroutines.
+   */
+  std::shared_ptr<oatpp::async::Executor> m_asyncExecutor;
 
  public:
   // WSListener() {}
-  WSListener(const std::shared_ptr<AsyncWebSocket> &socket, const qint64 &id, const qint64 &project_id)
-      : m_socket(socket), m_id(id), m_project_id(project_id) {}
+  WSListener(const std::shared_ptr<AsyncWebSocket> &socket, const qint64 &id, const qint64 &project_id,
+             const std::shared_ptr<oatpp::async::Executor> &executor)
+      : m_socket(socket), m_id(id), m_project_id(project_id), m_asyncExecutor(executor) {}
 
   /**
    * Called on "ping" frame.
@@ -84,12 +88,17 @@ class WSListener : public oatpp::websocket::AsyncWebSocket::Listener {
  * Listener on new WebSocket connections.
  */
 class WSInstanceListener : public oatpp::websocket::AsyncConnectionHandler::SocketInstanceListener {
+ private:
+  std::shared_ptr<oatpp::async::Executor> m_executor;
+
  public:
   /**
    * Counter for connected clients.
    */
   static std::atomic<v_int32> SOCKETS;
 
+  explicit WSInstanceListener(const std::shared_ptr<oatpp::async::Executor> &executor) : m_executor(executor) {}
+
   /**
    *  Called when socket is created
    */
@@ -0,0 +1,129 @@
+#include "ActHttpLoadTest.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "app/MyApiTestClient.hpp"
+#include "app/TestComponent.hpp"
+#include "controller/act_controller.hpp"
+#include "oatpp-test/web/ClientServerTestRunner.hpp"
+#include "oatpp/web/client/HttpRequestExecutor.hpp"
+
+namespace {
+
+constexpr v_int32 kConcurrentClients = 300;
+constexpr v_int32 kRequestsPerClient = 10;
+constexpr v_int32 kIdleKeepAliveClients = 48;  ///< more than the workers of the test server
+
+v_int64 Percentile(std::vector<v_int64> &latencies, v_int32 percent) {
+  if (latencies.empty()) {
+    return 0;
+  }
+  std::sort(latencies.begin(), latencies.end());
+  size_t index = (latencies.size() * percent) / 100;
+  return latencies[std::min(index, latencies.size() - 1)];
+}
+
+}  // namespace
+
+void ActHttpLoadTest::onRun() {
+  /* Register test components */
+  TestComponent component;
+
+  /* Create client-server test runner */
+  oatpp::test::web::ClientServerTestRunner runner;
+
+  /* Add ActController endpoints to the router of the test server */
+  runner.addController(std::make_shared<ActController>());
+
+  /* Run test */
+  runner.run(
+      [this, &runner] {
+        OATPP_COMPONENT(std::shared_ptr<oatpp::network::ClientConnectionProvider>, clientConnectionProvider);
+        OATPP_COMPONENT(std::shared_ptr<oatpp::data::mapping::ObjectMapper>, objectMapper);
+        OATPP_COMPONENT(std::shared_ptr<oatpp::network::ConnectionHandler>, serverConnectionHandler);
+        auto handler = std::static_pointer_cast<ActHttpConnectionHandler>(serverConnectionHandler);
+
+        // The keep-alive clients which send one request and keep the connection open without the next request
+        static const char *kKeepAliveRequest =
+            "GET / HTTP/1.1\r\n"
+            "Host: localhost\r\n"
+            "Connection: keep-alive\r\n"
+            "\r\n";
+        std::vector<oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>> idle_connections;
+        for (v_int32 i = 0; i < kIdleKeepAliveClients; i++) {
+          auto connection = clientConnectionProvider->get();
+          connection.object->writeExactSizeDataSimple(kKeepAliveRequest, std::strlen(kKeepAliveRequest));
+          idle_connections.push_back(connection);
+        }
+        // Only the workers' worth of them are served until the idle ones are closed
+        for (auto &connection : idle_connections) {
+          char buffer[256];
+          OATPP_ASSERT(connection.object->readSimple(buffer, sizeof(buffer)) > 0);
+        }
+
+        std::atomic<v_int32> failed(0);
+        std::vector<std::vector<v_int64>> client_latencies(kConcurrentClients);
+        std::vector<std::thread> clients;
+
+        auto start = std::chrono::steady_clock::now();
+        for (v_int32 i = 0; i < kConcurrentClients; i++) {
+          clients.emplace_back([&, i] {
+            auto requestExecutor = oatpp::web::client::HttpRequestExecutor::createShared(clientConnectionProvider);
+            auto client = MyApiTestClient::createShared(requestExecutor, objectMapper);
+
+            for (v_int32 j = 0; j < kRequestsPerClient; j++) {
+              auto request_start = std::chrono::steady_clock::now();
+              try {
+                auto response = client->getRoot();
+                if (response->getStatusCode() != 200) {
+                  failed++;
+                }
+                response->readBodyToString();
+              } catch (std::exception &e) {
+                failed++;
+              }
+              client_latencies[i].push_back(std::chrono::duration_cast<std::chrono::microseconds>(
+                                                std::chrono::steady_clock::now() - request_start)
+                                                .count());
+            }
+          });
+        }
+
+        for (auto &client : clients) {
+          client.join();
+        }
+        auto elapsed_ms =
+            std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+        std::vector<v_int64> latencies;
+        for (auto &client_latency : client_latencies) {
+          latencies.insert(latencies.end(), client_latency.begin(), client_latency.end());
+        }
+
+        v_int64 p50 = Percentile(latencies, 50);
+        v_int64 p99 = Percentile(latencies, 99);
+        OATPP_LOGI("ActHttpLoadTest", "clients=%d, requests=%d, failed=%d, elapsed=%lld ms, p50=%lld us, p99=%lld us",
+                   kConcurrentClients, static_cast<v_int32>(latencies.size()), failed.load(),
+                   static_cast<long long>(elapsed_ms), static_cast<long long>(p50), static_cast<long long>(p99));
+
+        OATPP_LOGI("ActHttpLoadTest", "idle keep-alive clients=%d, closed=%lld", kIdleKeepAliveClients,
+                   static_cast<long long>(handler->getIdleClosedCount()));
+
+        OATPP_ASSERT(failed.load() == 0);
+        OATPP_ASSERT(latencies.size() == static_cast<size_t>(kConcurrentClients * kRequestsPerClient));
+        // The idle keep-alive connections are closed to serve the load instead of starving it
+        OATPP_ASSERT(handler->getIdleClosedCount() > 0);
+
+        for (auto &connection : idle_connections) {
+          connection.invalidator->invalidate(connection.object);
+        }
+      },
+      std::chrono::minutes(10) /* test timeout */);
+
+  /* wait all server threads finished */
+  std::this_thread::sleep_for(std::chrono::seconds(1));
+}
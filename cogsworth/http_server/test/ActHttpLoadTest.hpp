@@ -0,0 +1,12 @@
+#ifndef ActHttpLoadTest_hpp
+#define ActHttpLoadTest_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+class ActHttpLoadTest : public oatpp::test::UnitTest {
+ public:
+  ActHttpLoadTest() : UnitTest("TEST[ActHttpLoadTest]") {}
+  void onRun() override;
+};
+
+#endif  // ActHttpLoadTest_hpp
@@ -1,12 +1,12 @@
 #ifndef TestComponent_htpp
 #define TestComponent_htpp
 
+#include "act_http_connection_handler.hpp"
 #include "oatpp/core/macro/component.hpp"
 #include "oatpp/network/virtual_/Interface.hpp"
 #include "oatpp/network/virtual_/client/ConnectionProvider.hpp"
 #include "oatpp/network/virtual_/server/ConnectionProvider.hpp"
 #include "oatpp/parser/json/mapping/ObjectMapper.hpp"
-#include "oatpp/web/server/HttpConnectionHandler.hpp"
 
 /**
  * Test Components config
@@ -47,7 +47,8 @@ class TestComponent {
    */
   OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::network::ConnectionHandler>, serverConnectionHandler)([] {
     OATPP_COMPONENT(std::shared_ptr<oatpp::web::server::HttpRouter>, router);  // get Router component
-    return oatpp::web::server::HttpConnectionHandler::createShared(router);
+    return ActHttpConnectionHandler::createShared(router, 16 /* worker threads */, 1024 /* pending connections */,
+                                                  1000 /* keep-alive timeout(ms) */);
   }());
 
   /**
@@ -2,8 +2,12 @@
 #include <iostream>
 
 #include "ActControllerTest.hpp"
+#include "ActHttpLoadTest.hpp"
 
-void runTests() { OATPP_RUN_TEST(ActControllerTest); }
+void runTests() {
+  OATPP_RUN_TEST(ActControllerTest);
+  OATPP_RUN_TEST(ActHttpLoadTest);
+}
 
 int main() {
   oatpp::base::Environment::init();
@@ -9,9 +9,12 @@ See the file MOXA-SOFTWARE-NOTICE for details.
 #include <QString>
 #include <QtMqtt/QMqttClient>
 #include <QtMqtt/QMqttMessage>
+#include <memory>
 
 #include "act_json.hpp"
 
+#define ACT_MQTT_RECONNECT_INTERVAL (5000)  ///< The interval(ms) to reconnect to the broker
+
 enum class ActMqttEventTopicEnum {
   kReceiveSNMPTrapEvent = 3010001,
   kPortLinkDown = 3010002,
@@ -33,6 +36,8 @@ class ActMqttMessage : public QSerializer {
   ACT_JSON_FIELD(QString, timestamp, timestamp);
 };
 
+class ActMqttEventQueue;
+
 class ActMqttClient : public QObject {
   Q_OBJECT
 
@@ -50,6 +55,13 @@ class ActMqttClient : public QObject {
   void disconnectFromBroker();
   void subscribeToTopic(ActMqttEventTopicEnum topic);
 
+  /**
+   * @brief Push the received events to the queue instead of emitting messageReceived()
+   *
+   * @param event_queue
+   */
+  void setEventQueue(std::shared_ptr<ActMqttEventQueue> event_queue);
+
  signals:
   void messageReceived(const QString &topic, const ActMqttMessage &message);
   void connectionStatusChanged(bool connected);
@@ -62,6 +74,7 @@ class ActMqttClient : public QObject {
   QMqttClient *client;
   QString host;
   quint16 port;
+  std::shared_ptr<ActMqttEventQueue> event_queue;
 };
 
 // kene+
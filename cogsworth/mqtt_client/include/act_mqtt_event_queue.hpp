@@ -0,0 +1,132 @@
+/* Copyright (C) MOXA Inc. All rights reserved.
+This software is distributed under the terms of the MOXA SOFTWARE NOTICE.
+See the file MOXA-SOFTWARE-NOTICE for details.
+*/
+
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QMutex>
+#include <QString>
+
+#include "act_json.hpp"
+#include "act_mqtt_client.hpp"
+
+#define ACT_MQTT_EVENT_QUEUE_CAPACITY (10000)  ///< The maximum pending events, the later ones are dropped
+#define ACT_MQTT_EVENT_DEBOUNCE (200)          ///< The quiet time(ms) before a link event is delivered
+#define ACT_MQTT_EVENT_MAX_DEBOUNCE (2000)     ///< The maximum delay(ms) of a link event under the continuous flaps
+#define ACT_MQTT_EVENT_BATCH_SIZE (500)        ///< The maximum events applied to the project at once
+
+/**
+ * @brief The counters of the MQTT event queue
+ *
+ */
+class ActMqttEventQueueMetrics : public QSerializer {
+  Q_GADGET
+  QS_SERIALIZABLE
+
+  ACT_JSON_FIELD(qint64, received, Received);
+  ACT_JSON_FIELD(qint64, delivered, Delivered);
+  ACT_JSON_FIELD(qint64, dropped, Dropped);        ///< Dropped for the full queue
+  ACT_JSON_FIELD(qint64, coalesced, Coalesced);    ///< Replaced by the later event of the same port before delivered
+  ACT_JSON_FIELD(qint64, duplicated, Duplicated);  ///< The same link state as the one delivered just before
+  ACT_JSON_FIELD(qint64, pending, Pending);
+  ACT_JSON_FIELD(qint64, max_lag, MaxLag);  ///< The maximum time(ms) from received to delivered
+  ACT_JSON_FIELD(qint64, last_lag, LastLag);
+
+ public:
+  ActMqttEventQueueMetrics() {
+    this->received_ = 0;
+    this->delivered_ = 0;
+    this->dropped_ = 0;
+    this->coalesced_ = 0;
+    this->duplicated_ = 0;
+    this->pending_ = 0;
+    this->max_lag_ = 0;
+    this->last_lag_ = 0;
+  }
+};
+
+/**
+ * @brief The bounded queue between the MQTT client and the monitor
+ *
+ * The client only pushes the parsed events, and the monitor takes them in batches. The port link up/down events are
+ * debounced per port (<source IP>/<port>): the later event replaces the pending one of the same port, and it is
+ * delivered after the port keeps quiet for the debounce time (or the max debounce time since its first event). The
+ * link event with the same state as the one delivered within the max debounce time before is dropped as a duplicate;
+ * a later one is delivered, the monitor may have polled the other state in between. The other events are delivered
+ * in order without any delay.
+ *
+ * All the methods are thread-safe.
+ *
+ */
+class ActMqttEventQueue {
+ public:
+  /**
+   * @brief Construct a new Act Mqtt Event Queue object
+   *
+   * @param capacity the maximum pending events
+   * @param debounce the quiet time(ms) of the link event
+   * @param max_debounce the maximum delay(ms) of the link event
+   */
+  ActMqttEventQueue(const qint32 &capacity = ACT_MQTT_EVENT_QUEUE_CAPACITY,
+                    const qint64 &debounce = ACT_MQTT_EVENT_DEBOUNCE,
+                    const qint64 &max_debounce = ACT_MQTT_EVENT_MAX_DEBOUNCE);
+
+  /**
+   * @brief Push the received event
+   *
+   * @param message
+   * @param now (ms since epoch)
+   * @return true if queued or coalesced, false if dropped
+   */
+  bool Push(const ActMqttMessage &message, const qint64 &now);
+
+  /**
+   * @brief Take the events ready to deliver in the received order
+   *
+   * @param now (ms since epoch)
+   * @param max_count
+   * @return QList<ActMqttMessage>
+   */
+  QList<ActMqttMessage> Take(const qint64 &now, const qint32 &max_count = ACT_MQTT_EVENT_BATCH_SIZE);
+
+  ActMqttEventQueueMetrics GetMetrics();
+
+ private:
+  struct PendingEvent {
+    ActMqttMessage message;
+    QString link_key;  ///< Empty if not a link event
+    qint64 first_received;
+    qint64 last_received;
+  };
+
+  struct DeliveredLink {
+    qint64 code;  ///< The code of the last delivered event
+    qint64 delivered;
+  };
+
+  QMutex mutex_;
+  qint32 capacity_;
+  qint64 debounce_;
+  qint64 max_debounce_;
+  quint64 next_sequence_;
+  QMap<quint64, PendingEvent> pending_;     ///< <sequence, event> in the received order
+  QHash<QString, quint64> pending_links_;   ///< <link key, sequence>
+  QHash<QString, DeliveredLink> delivered_links_;  ///< <link key, the last delivered event>
+  ActMqttEventQueueMetrics metrics_;
+
+  static QString LinkKey(const ActMqttMessage &message);
+
+  /**
+   * @brief Whether the link event repeats the state delivered within the max debounce time
+   *
+   * @param link_key
+   * @param code
+   * @param received (ms since epoch)
+   * @return true if duplicated
+   */
+  bool IsDuplicated(const QString &link_key, const qint64 &code, const qint64 &received);
+};
@@ -3,11 +3,15 @@
 #define SLEEP_MS(ms) Sleep(ms)
 #else
 #include <unistd.h>  // for sleep
-#define SLEEP_MS(ms) sleep(ms / 1000)
+#define SLEEP_MS(ms) usleep((ms) * 1000)
 #endif
 
 #include "act_mqtt_client.hpp"
 
+#include <QDateTime>
+
+#include "act_mqtt_event_queue.hpp"
+
 const QString ActMqttClient::AF_BROKER_IP = "127.0.0.1";
 const quint16 ActMqttClient::AF_BROKER_PORT = 59001;
 const QString ActMqttClient::AF_TOPIC_PREFIX = "events/log/";
@@ -55,12 +59,24 @@ void ActMqttClient::subscribeToTopic(const ActMqttEventTopicEnum topic) {
   qDebug() << "Successfully subscribed to topic:" << fullTopic;
 }
 
+void ActMqttClient::setEventQueue(std::shared_ptr<ActMqttEventQueue> event_queue) {
+  this->event_queue = event_queue;
+}
+
 void ActMqttClient::onMessageReceived(const QByteArray &message, const QMqttTopicName &topic) {
   // QByteArray -> QString -> object
   QString message_str = QString::fromUtf8(message);
   ActMqttMessage mqtt_message;
   mqtt_message.FromString(message_str);
 
+  // The monitor takes the events from the queue in batches
+  if (event_queue != nullptr) {
+    if (!event_queue->Push(mqtt_message, QDateTime::currentMSecsSinceEpoch())) {
+      qWarning() << "Drop the message from topic:" << topic.name() << "(the event queue is full)";
+    }
+    return;
+  }
+
   qDebug() << "Received message from topic:" << topic.name() << "with content:" << message_str.toStdString().c_str();
 
   // execute user defined message handler function
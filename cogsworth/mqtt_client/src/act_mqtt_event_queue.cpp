@@ -0,0 +1,106 @@
+#include "act_mqtt_event_queue.hpp"
+
+#include <QMutexLocker>
+
+ActMqttEventQueue::ActMqttEventQueue(const qint32 &capacity, const qint64 &debounce, const qint64 &max_debounce)
+    : capacity_(qMax(capacity, 1)),
+      debounce_(qMax<qint64>(debounce, 0)),
+      max_debounce_(qMax(max_debounce, debounce)),
+      next_sequence_(0) {}
+
+QString ActMqttEventQueue::LinkKey(const ActMqttMessage &message) {
+  const ActMqttEventTopicEnum topic = static_cast<ActMqttEventTopicEnum>(message.Getcode());
+  if ((topic != ActMqttEventTopicEnum::kPortLinkDown && topic != ActMqttEventTopicEnum::kPortLinkUp) ||
+      message.Getvariables().isEmpty()) {
+    return QString();
+  }
+  return QString("%1/%2").arg(message.GetsourceIp()).arg(message.Getvariables().first());
+}
+
+bool ActMqttEventQueue::IsDuplicated(const QString &link_key, const qint64 &code, const qint64 &received) {
+  auto delivered_it = delivered_links_.find(link_key);
+  if (delivered_it == delivered_links_.end()) {
+    return false;
+  }
+  if (received - delivered_it->delivered >= max_debounce_) {
+    delivered_links_.erase(delivered_it);  // outdated, the monitor may have polled the other state
+    return false;
+  }
+  return delivered_it->code == code;
+}
+
+bool ActMqttEventQueue::Push(const ActMqttMessage &message, const qint64 &now) {
+  QMutexLocker lock(&mutex_);
+  metrics_.SetReceived(metrics_.GetReceived() + 1);
+
+  const QString link_key = LinkKey(message);
+  if (!link_key.isEmpty()) {
+    // The later event of the same port replaces the pending one
+    auto pending_it = pending_links_.find(link_key);
+    if (pending_it != pending_links_.end()) {
+      PendingEvent &event = pending_[pending_it.value()];
+      event.message = message;
+      event.last_received = now;
+      metrics_.SetCoalesced(metrics_.GetCoalesced() + 1);
+      return true;
+    }
+
+    if (IsDuplicated(link_key, message.Getcode(), now)) {
+      metrics_.SetDuplicated(metrics_.GetDuplicated() + 1);
+      return true;
+    }
+  }
+
+  if (pending_.size() >= capacity_) {
+    metrics_.SetDropped(metrics_.GetDropped() + 1);
+    return false;
+  }
+
+  const quint64 sequence = next_sequence_++;
+  pending_.insert(sequence, PendingEvent{message, link_key, now, now});
+  if (!link_key.isEmpty()) {
+    pending_links_.insert(link_key, sequence);
+  }
+  return true;
+}
+
+QList<ActMqttMessage> ActMqttEventQueue::Take(const qint64 &now, const qint32 &max_count) {
+  QMutexLocker lock(&mutex_);
+
+  QList<ActMqttMessage> messages;
+  for (auto it = pending_.begin(); it != pending_.end() && messages.size() < max_count;) {
+    const PendingEvent &event = it.value();
+    if (!event.link_key.isEmpty()) {
+      // Wait for the port to be quiet
+      if (now - event.last_received < debounce_ && now - event.first_received < max_debounce_) {
+        ++it;
+        continue;
+      }
+
+      pending_links_.remove(event.link_key);
+      if (IsDuplicated(event.link_key, event.message.Getcode(), event.last_received)) {
+        // Flapped back to the state delivered just before
+        metrics_.SetDuplicated(metrics_.GetDuplicated() + 1);
+        it = pending_.erase(it);
+        continue;
+      }
+      delivered_links_.insert(event.link_key, DeliveredLink{event.message.Getcode(), now});
+    }
+
+    const qint64 lag = now - event.first_received;
+    metrics_.SetLastLag(lag);
+    metrics_.SetMaxLag(qMax(metrics_.GetMaxLag(), lag));
+    messages.append(event.message);
+    it = pending_.erase(it);
+  }
+
+  metrics_.SetDelivered(metrics_.GetDelivered() + messages.size());
+  return messages;
+}
+
+ActMqttEventQueueMetrics ActMqttEventQueue::GetMetrics() {
+  QMutexLocker lock(&mutex_);
+  ActMqttEventQueueMetrics metrics = metrics_;
+  metrics.SetPending(pending_.size());
+  return metrics;
+}
@@ -0,0 +1,333 @@
+#include "act_mqtt_event_queue.hpp"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QtMqtt/QMqttClient>
+#include <functional>
+
+#include "act_unit_test.hpp"
+
+/**
+ * @brief The MQTT 3.1.1 broker stand-in of the test (CONNECT, SUBSCRIBE, PUBLISH, PINGREQ with QoS 0 forwarding)
+ *
+ */
+class ActMqttBrokerStandIn : public QObject {
+ public:
+  bool Listen() {
+    QObject::connect(&server_, &QTcpServer::newConnection, [this]() {
+      while (server_.hasPendingConnections()) {
+        QTcpSocket *socket = server_.nextPendingConnection();
+        QObject::connect(socket, &QTcpSocket::readyRead, [this, socket]() { OnReadyRead(socket); });
+        QObject::connect(socket, &QTcpSocket::disconnected, [this, socket]() {
+          buffers_.remove(socket);
+          subscriptions_.remove(socket);
+          socket->deleteLater();
+        });
+      }
+    });
+    return server_.listen(QHostAddress::LocalHost, 0);
+  }
+
+  quint16 Port() const { return server_.serverPort(); }
+
+ private:
+  QTcpServer server_;
+  QHash<QTcpSocket *, QByteArray> buffers_;
+  QHash<QTcpSocket *, QSet<QString>> subscriptions_;
+
+  static QByteArray Packet(const quint8 &header, const QByteArray &body) {
+    QByteArray packet(1, static_cast<char>(header));
+    qint32 length = body.size();
+    do {
+      quint8 byte = length % 128;
+      length /= 128;
+      packet.append(static_cast<char>(length > 0 ? (byte | 0x80) : byte));
+    } while (length > 0);
+    return packet + body;
+  }
+
+  static QByteArray String(const QByteArray &value) {
+    QByteArray data(2, 0);
+    data[0] = static_cast<char>(value.size() >> 8);
+    data[1] = static_cast<char>(value.size() & 0xFF);
+    return data + value;
+  }
+
+  static quint16 Uint16(const QByteArray &data, const qint32 &offset) {
+    return (static_cast<quint8>(data[offset]) << 8) | static_cast<quint8>(data[offset + 1]);
+  }
+
+  void OnReadyRead(QTcpSocket *socket) {
+    QByteArray &buffer = buffers_[socket];
+    buffer.append(socket->readAll());
+
+    while (buffer.size() >= 2) {
+      // The remaining length
+      qint32 length = 0;
+      qint32 multiplier = 1;
+      qint32 offset = 1;
+      bool complete = false;
+      while (offset < buffer.size() && offset <= 4) {
+        const quint8 byte = static_cast<quint8>(buffer[offset++]);
+        length += (byte & 0x7F) * multiplier;
+        multiplier *= 128;
+        if ((byte & 0x80) == 0) {
+          complete = true;
+          break;
+        }
+      }
+      if (!complete || buffer.size() < offset + length) {
+        return;
+      }
+
+      const quint8 header = static_cast<quint8>(buffer[0]);
+      const QByteArray body = buffer.mid(offset, length);
+      buffer.remove(0, offset + length);
+      Handle(socket, header, body);
+    }
+  }
+
+  void Handle(QTcpSocket *socket, const quint8 &header, const QByteArray &body) {
+    switch (header >> 4) {
+      case 1:  // CONNECT
+        socket->write(Packet(0x20, QByteArray("\x00\x00", 2)));
+        break;
+      case 8: {  // SUBSCRIBE
+        QByteArray granted = body.left(2);
+        for (qint32 offset = 2; offset + 2 <= body.size();) {
+          const quint16 topic_length = Uint16(body, offset);
+          subscriptions_[socket].insert(QString::fromUtf8(body.mid(offset + 2, topic_length)));
+          offset += 2 + topic_length + 1;
+          granted.append('\x00');
+        }
+        socket->write(Packet(0x90, granted));
+      } break;
+      case 3: {  // PUBLISH
+        const quint16 topic_length = Uint16(body, 0);
+        const QByteArray topic = body.mid(2, topic_length);
+        const qint32 qos = (header >> 1) & 0x03;
+        const qint32 payload_offset = 2 + topic_length + (qos > 0 ? 2 : 0);
+        if (qos == 1) {
+          socket->write(Packet(0x40, body.mid(2 + topic_length, 2)));
+        }
+        const QByteArray forward = Packet(0x30, String(topic) + body.mid(payload_offset));
+        for (auto it = subscriptions_.begin(); it != subscriptions_.end(); ++it) {
+          if (it.value().contains(QString::fromUtf8(topic))) {
+            it.key()->write(forward);
+          }
+        }
+      } break;
+      case 12:  // PINGREQ
+        socket->write(Packet(0xD0, QByteArray()));
+        break;
+      case 14:  // DISCONNECT, the client closes the connection
+        break;
+      default:
+        break;
+    }
+  }
+};
+
+class ActMqttEventQueueTest : public ActQuickTest {
+ protected:
+  const qint64 base = 1700000000000;  // ms since epoch
+
+  static void SetUpTestSuite() {
+    if (QCoreApplication::instance() == nullptr) {
+      static int argc = 1;
+      static char name[] = "act_mqtt_event_queue_test";
+      static char *argv[] = {name, nullptr};
+      new QCoreApplication(argc, argv);
+    }
+  }
+
+  static ActMqttMessage LinkEvent(const QString &ip, const qint64 &port, const bool &up, const qint64 &id = 0) {
+    ActMqttMessage message;
+    message.Setid(id);
+    const ActMqttEventTopicEnum topic = up ? ActMqttEventTopicEnum::kPortLinkUp : ActMqttEventTopicEnum::kPortLinkDown;
+    message.Setcode(static_cast<qint64>(topic));
+    message.SetsourceIp(ip);
+    message.Setvariables({QString::number(port)});
+    return message;
+  }
+
+  static ActMqttMessage LoginFailEvent(const qint64 &id) {
+    ActMqttMessage message;
+    message.Setid(id);
+    message.Setcode(static_cast<qint64>(ActMqttEventTopicEnum::kLoginFail));
+    message.SetsourceIp("192.168.127.1");
+    return message;
+  }
+
+  static bool WaitFor(const std::function<bool()> &predicate, const qint32 &timeout) {
+    const qint64 deadline = QDateTime::currentMSecsSinceEpoch() + timeout;
+    while (!predicate()) {
+      if (QDateTime::currentMSecsSinceEpoch() > deadline) {
+        return false;
+      }
+      QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+    }
+    return true;
+  }
+};
+
+TEST_F(ActMqttEventQueueTest, TestCoalesceLinkFlaps) {
+  ActMqttEventQueue queue(100, 200, 2000);
+  for (qint32 i = 0; i < 100; i++) {
+    ASSERT_TRUE(queue.Push(LinkEvent("192.168.127.1", 1, i % 2 == 1), base + i));
+  }
+  queue.Push(LinkEvent("192.168.127.2", 1, false), base + 50);
+
+  // Still flapping
+  EXPECT_TRUE(queue.Take(base + 150).isEmpty());
+
+  // The last state of each port after the debounce time
+  const QList<ActMqttMessage> messages = queue.Take(base + 99 + 200);
+  ASSERT_EQ(2, messages.size());
+  EXPECT_EQ("192.168.127.1", messages.at(0).GetsourceIp());
+  EXPECT_EQ(static_cast<qint64>(ActMqttEventTopicEnum::kPortLinkUp), messages.at(0).Getcode());
+  EXPECT_EQ("192.168.127.2", messages.at(1).GetsourceIp());
+
+  ActMqttEventQueueMetrics metrics = queue.GetMetrics();
+  EXPECT_EQ(101, metrics.GetReceived());
+  EXPECT_EQ(99, metrics.GetCoalesced());
+  EXPECT_EQ(2, metrics.GetDelivered());
+  EXPECT_EQ(0, metrics.GetPending());
+  EXPECT_EQ(299, metrics.GetMaxLag());
+}
+
+TEST_F(ActMqttEventQueueTest, TestDuplicateLinkState) {
+  ActMqttEventQueue queue(100, 200, 2000);
+  queue.Push(LinkEvent("192.168.127.1", 1, true), base);
+  ASSERT_EQ(1, queue.Take(base + 200).size());
+
+  // The same state again
+  queue.Push(LinkEvent("192.168.127.1", 1, true), base + 300);
+  EXPECT_EQ(0, queue.GetMetrics().GetPending());
+
+  // Down and back up before delivered
+  queue.Push(LinkEvent("192.168.127.1", 1, false), base + 400);
+  queue.Push(LinkEvent("192.168.127.1", 1, true), base + 410);
+  EXPECT_TRUE(queue.Take(base + 1000).isEmpty());
+  EXPECT_EQ(2, queue.GetMetrics().GetDuplicated());
+
+  // Another port is independent
+  queue.Push(LinkEvent("192.168.127.1", 2, true), base + 1000);
+  EXPECT_EQ(1, queue.Take(base + 1200).size());
+}
+
+TEST_F(ActMqttEventQueueTest, TestLinkUpAfterPolledLinkDown) {
+  ActMqttEventQueue queue(100, 200, 2000);
+  queue.Push(LinkEvent("192.168.127.1", 1, true), base);
+  ASSERT_EQ(1, queue.Take(base + 200).size());
+
+  // The link down is only polled by the monitor, the later link up must still be applied
+  queue.Push(LinkEvent("192.168.127.1", 1, true), base + 200 + 2000);
+  const QList<ActMqttMessage> messages = queue.Take(base + 200 + 2000 + 200);
+  ASSERT_EQ(1, messages.size());
+  EXPECT_EQ(static_cast<qint64>(ActMqttEventTopicEnum::kPortLinkUp), messages.first().Getcode());
+  EXPECT_EQ(0, queue.GetMetrics().GetDuplicated());
+
+  // The flap back to the state delivered long before is applied as well
+  queue.Push(LinkEvent("192.168.127.1", 1, false), base + 5000);
+  queue.Push(LinkEvent("192.168.127.1", 1, true), base + 5000 + 10);
+  EXPECT_TRUE(queue.Take(base + 5000 + 100).isEmpty());
+  EXPECT_EQ(1, queue.Take(base + 5000 + 10 + 200).size());
+}
+
+TEST_F(ActMqttEventQueueTest, TestMaxDebounce) {
+  ActMqttEventQueue queue(100, 200, 2000);
+
+  // Keep flapping every 100ms, the event is still delivered after the max debounce time
+  QList<ActMqttMessage> messages;
+  qint64 now = base;
+  for (; now < base + 3000 && messages.isEmpty(); now += 100) {
+    queue.Push(LinkEvent("192.168.127.1", 1, (now / 100) % 2 == 0), now);
+    messages = queue.Take(now);
+  }
+  ASSERT_EQ(1, messages.size());
+  EXPECT_EQ(base + 2000 + 100, now);
+}
+
+TEST_F(ActMqttEventQueueTest, TestCapacityAndOrder) {
+  ActMqttEventQueue queue(3, 200, 2000);
+  EXPECT_TRUE(queue.Push(LoginFailEvent(1), base));
+  EXPECT_TRUE(queue.Push(LinkEvent("192.168.127.1", 1, false, 2), base));
+  EXPECT_TRUE(queue.Push(LoginFailEvent(3), base));
+  EXPECT_FALSE(queue.Push(LoginFailEvent(4), base));
+  EXPECT_EQ(1, queue.GetMetrics().GetDropped());
+
+  // The other events are not delayed by the pending link event
+  QList<ActMqttMessage> messages = queue.Take(base);
+  ASSERT_EQ(2, messages.size());
+  EXPECT_EQ(1, messages.at(0).Getid());
+  EXPECT_EQ(3, messages.at(1).Getid());
+
+  // The batch size
+  for (qint64 id = 5; id < 7; id++) {
+    queue.Push(LoginFailEvent(id), base);
+  }
+  EXPECT_EQ(2, queue.Take(base + 200, 2).size());
+  EXPECT_EQ(1, queue.Take(base + 200, 2).size());
+}
+
+TEST_F(ActMqttEventQueueTest, TestBurstThroughBroker) {
+  ActMqttBrokerStandIn broker;
+  ASSERT_TRUE(broker.Listen());
+  qputenv("MAF_IPC_ADDR", "127.0.0.1");
+  qputenv("MAF_IPC_PORT", QByteArray::number(broker.Port()));
+
+  auto queue = std::make_shared<ActMqttEventQueue>();
+  ActMqttClient mqtt_client;
+  mqtt_client.setEventQueue(queue);
+  bool subscribed = false;
+  QObject::connect(&mqtt_client, &ActMqttClient::connectionStatusChanged, [&mqtt_client, &subscribed](bool connected) {
+    if (connected) {
+      mqtt_client.subscribeToTopic(ActMqttEventTopicEnum::kPortLinkDown);
+      mqtt_client.subscribeToTopic(ActMqttEventTopicEnum::kPortLinkUp);
+      subscribed = true;
+    }
+  });
+  mqtt_client.connectToBroker();
+  ASSERT_TRUE(WaitFor([&subscribed]() { return subscribed; }, 5000));
+
+  QMqttClient publisher;
+  publisher.setHostname("127.0.0.1");
+  publisher.setPort(broker.Port());
+  publisher.connectToHost();
+  ASSERT_TRUE(WaitFor([&publisher]() { return publisher.state() == QMqttClient::Connected; }, 5000));
+  WaitFor([]() { return false; }, 200);  // let the subscriptions settle
+
+  // A link flap storm on a ring: 10 devices x 2 ports, 100 flaps each, ends with link up
+  const qint32 kFlaps = 100;
+  for (qint32 flap = 0; flap < kFlaps; flap++) {
+    for (qint32 device = 1; device <= 10; device++) {
+      for (qint64 port = 1; port <= 2; port++) {
+        ActMqttMessage message = LinkEvent(QString("192.168.127.%1").arg(device), port, flap % 2 == 1);
+        const QString topic = ActMqttClient::AF_TOPIC_PREFIX + QString::number(message.Getcode());
+        publisher.publish(QMqttTopicName(topic), message.ToString().toUtf8(), 0);
+      }
+    }
+  }
+
+  const qint64 start = QDateTime::currentMSecsSinceEpoch();
+  ASSERT_TRUE(WaitFor([&queue]() { return queue->GetMetrics().GetReceived() == 10 * 2 * kFlaps; }, 10000));
+  qDebug() << "Received" << 10 * 2 * kFlaps << "events in" << QDateTime::currentMSecsSinceEpoch() - start << "ms";
+
+  // One event per port with the last state
+  const QList<ActMqttMessage> messages = queue->Take(QDateTime::currentMSecsSinceEpoch() + ACT_MQTT_EVENT_MAX_DEBOUNCE);
+  EXPECT_EQ(10 * 2, messages.size());
+  for (const ActMqttMessage &message : messages) {
+    EXPECT_EQ(static_cast<qint64>(ActMqttEventTopicEnum::kPortLinkUp), message.Getcode());
+  }
+
+  ActMqttEventQueueMetrics metrics = queue->GetMetrics();
+  qDebug() << "Metrics:" << metrics.ToString().toStdString().c_str();
+  EXPECT_EQ(0, metrics.GetDropped());
+  EXPECT_EQ(10 * 2 * (kFlaps - 1), metrics.GetCoalesced());
+
+  publisher.disconnectFromHost();
+  mqtt_client.disconnectFromBroker();
+}
@@ -12,9 +12,11 @@ See the file MOXA-SOFTWARE-NOTICE for details.
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QList>
+#include <QMap>
 #include <QProcess>
 #include <QString>
 
+#include "act_concurrent_runner.hpp"
 #include "act_device.hpp"
 #include "act_maf_client_handler.hpp"
 #include "act_project.hpp"
@@ -26,12 +28,14 @@ See the file MOXA-SOFTWARE-NOTICE for details.
 namespace act {
 namespace offline_config {
 
-const QString INPUT_JSON_FILE = "./tmp/offline_config/offline_config_input.json";
 const int EXECUTE_AF_TIMEOUT = 5000;  // (ms) 5 second
+const int GENERATE_CONFIG_WIDTH = 8;  // the devices generated at once (JSON conversion & MAF request)
 
 /**
  * @brief Generate device config by ActDeviceConfig, the generated config file will in tmp/device_config
  *
+ * The device's JSON is built in memory and posted to the MAF directly, so the devices can be generated concurrently.
+ *
  * @param project
  * @param device_id
  * @param result_file_id
@@ -40,11 +44,18 @@ const int EXECUTE_AF_TIMEOUT = 5000;  // (ms) 5 second
 ACT_STATUS GenerateOfflineConfig(const ActProject &project, const qint64 &device_id, QString &result_file_id);
 
 /**
- * @brief Remove the json file (for offline config tool used) to initialize
+ * @brief Generate the devices' configs of the project, GENERATE_CONFIG_WIDTH devices at once
  *
- * @return ACT_STATUS
+ * No more device is started after a failure.
+ *
+ * @param project
+ * @param dev_id_list
+ * @param result_file_id_map <DeviceId, FileId>
+ * @return ACT_STATUS the failure of the first failed device in the dev_id_list order
  */
-ACT_STATUS RemoveJsonFile();
+ACT_STATUS GenerateOfflineConfigs(const ActProject &project, const QList<qint64> &dev_id_list,
+                                  QMap<qint64, QString> &result_file_id_map);
+
 /**
  * @brief Generate the json file (for offline config tool used) by ActDeviceConfig in the project
  *
@@ -171,14 +182,6 @@ inline QJsonObject CreateSingleValueElement(const QString &element_name, const Q
  * @return QJsonObject
  */
 QJsonObject CreateFeature(const QString &feature_name, QList<QJsonObject> &element_data_list);
-/**
- * @brief Save the json file (for offline config tool used)
- *
- * @param doc
- * @return ACT_STATUS
- */
-ACT_STATUS SaveJsonToFile(const QJsonDocument &doc);
-
 /**
  * @brief Generate API request for gen offline config MAF API
  *
@@ -217,12 +220,6 @@ ACT_STATUS SaveOfflineConfigToTmpFolder(const QList<qint64> &dev_id_list);
  */
 ACT_STATUS ClearMafFileDb();
 
-static QString GetInputJsonFilePath() {
-  // INPUT_JSON_FILE
-  QString tempPath = qEnvironmentVariable("CHAMBERLAIN_COGSWORTH_TMP_FOLDER", "tmp");
-  return tempPath + QDir::separator() + "offline_config" + QDir::separator() + "offline_config_input.json";
-}
-
 // features
 
 static const QMap<ActSnmpTrapModeEnum, QString> kSnmpTrapModeConfigStringEnum = {
@@ -1,17 +1,14 @@
 #include "act_offline_config.hpp"
 
+#include <QMutex>
+#include <QMutexLocker>
+
 #include "act_maf_client_handler.hpp"
 
 ACT_STATUS act::offline_config::GenerateOfflineConfig(const ActProject &project, const qint64 &device_id,
                                                       QString &result_file_id) {
   ACT_STATUS_INIT();
 
-  act_status = RemoveJsonFile();
-  if (!IsActStatusSuccess(act_status)) {
-    qCritical() << __func__ << "RemoveJsonFile() failed.";
-    return act_status;
-  }
-
   QJsonArray feature_list;
   act_status = ConvertToJson(project, device_id, feature_list);
   if (!IsActStatusSuccess(act_status)) {
@@ -40,23 +37,50 @@ ACT_STATUS act::offline_config::GenerateOfflineConfig(const ActProject &project,
   return act_status;
 }
 
-ACT_STATUS act::offline_config::RemoveJsonFile() {
+ACT_STATUS act::offline_config::GenerateOfflineConfigs(const ActProject &project, const QList<qint64> &dev_id_list,
+                                                       QMap<qint64, QString> &result_file_id_map) {
   ACT_STATUS_INIT();
-
-  QString filename = GetInputJsonFilePath();
-  QFile file(filename);
-
-  if (!QFile::exists(filename)) {
-    //  not find the file, skip
-    return act_status;
+  result_file_id_map.clear();
+
+  QMutex mutex;
+  QMap<qint64, QString> file_id_map;
+  QMap<qint64, ACT_STATUS> dev_status_map;
+  bool stop_flag = false;
+
+  ActConcurrentRunner runner(GENERATE_CONFIG_WIDTH, 0);
+  runner.Run(
+      dev_id_list,
+      [&project, &mutex, &file_id_map](const qint64 &dev_id) {
+        QString file_id;
+        ACT_STATUS dev_status = GenerateOfflineConfig(project, dev_id, file_id);
+        if (IsActStatusSuccess(dev_status)) {
+          QMutexLocker lock(&mutex);
+          file_id_map.insert(dev_id, file_id);
+        }
+        return dev_status;
+      },
+      [&dev_status_map, &stop_flag](const qint64 &dev_id, ACT_STATUS dev_status) {
+        dev_status_map.insert(dev_id, dev_status);
+        if (!IsActStatusSuccess(dev_status)) {
+          stop_flag = true;
+        }
+      },
+      &stop_flag);
+
+  // The devices are started in order, so the not started ones are after the failed one
+  for (auto dev_id : dev_id_list) {
+    act_status = dev_status_map.value(dev_id, ACT_STATUS_SUCCESS);
+    if (!IsActStatusSuccess(act_status)) {
+      ActDevice dev;
+      project.GetDeviceById(dev, dev_id);
+      qCritical() << __func__
+                  << QString("GenerateOfflineConfig() failed. Device(%1).").arg(dev.GetIpv4().GetIpAddress());
+      return act_status;
+    }
   }
 
-  if (file.remove()) {  // remove file successfully
-    return act_status;
-  } else {
-    return std::make_shared<ActStatusInternalError>("Remove offline_config_input.json fail. reason: " +
-                                                    file.errorString());
-  }
+  result_file_id_map = file_id_map;
+  return ACT_STATUS_SUCCESS;
 }
 
 ACT_STATUS act::offline_config::ConvertToJson(const ActProject &project, const qint64 &device_id,
@@ -280,12 +304,6 @@ ACT_STATUS act::offline_config::ConvertToJson(const ActProject &project, const q
     }
   }
 
-  act_status = SaveJsonToFile(QJsonDocument(root_array));
-  if (!IsActStatusSuccess(act_status)) {
-    qCritical() << __func__ << "SaveJsonToFile() failed.";
-    return std::make_shared<ActStatusInternalError>("Convert To Json");
-  }
-
   feature_list = root_array;
 
   return act_status;
@@ -387,21 +405,6 @@ QJsonObject act::offline_config::CreateFeature(const QString &feature_name, QLis
   return feature_object;
 }
 
-ACT_STATUS act::offline_config::SaveJsonToFile(const QJsonDocument &doc) {
-  ACT_STATUS_INIT();
-
-  QFile file(GetInputJsonFilePath());
-
-  if (file.open(QIODevice::WriteOnly)) {
-    file.write(doc.toJson(QJsonDocument::Indented));
-    file.close();
-    return act_status;
-  } else {
-    qDebug() << "Failed to open file for writing";
-    return std::make_shared<ActStatusInternalError>("generate offline config");
-  }
-}
-
 ACT_STATUS act::offline_config::GenerateApiRequest(const ActDevice &device, MafGenOfflineConfigRequest &api_request,
                                                    QJsonObject &secret_setting) {
   ACT_STATUS_INIT();
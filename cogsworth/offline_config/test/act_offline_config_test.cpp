@@ -1,8 +1,90 @@
 #include "act_offline_config.hpp"
 
+#include <QAtomicInt>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <future>
+#include <thread>
+
+/**
+ * @brief The local stub of the MAF offline configuration endpoint, replies the fileId "file-<deviceID>"
+ *
+ */
+class ActMafStub {
+ public:
+  ~ActMafStub() { Stop(); }
+
+  quint16 Start() {
+    std::promise<quint16> port_promise;
+    auto port_future = port_promise.get_future();
+    thread_ = std::thread([this, &port_promise]() {
+      QTcpServer server;  // created in the stub thread, serves with the blocking calls
+      server.listen(QHostAddress::LocalHost, 0);
+      port_promise.set_value(server.serverPort());
+      while (!stop_flag_.loadAcquire()) {
+        if (server.waitForNewConnection(100)) {
+          Serve(server.nextPendingConnection());
+        }
+      }
+    });
+    return port_future.get();
+  }
+
+  void Stop() {
+    stop_flag_.storeRelease(1);
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+  qint32 GetRequests() { return requests_.loadAcquire(); }
+
+ private:
+  std::thread thread_;
+  QAtomicInt stop_flag_ = 0;
+  QAtomicInt requests_ = 0;
+
+  void Serve(QTcpSocket *socket) {
+    // Read the header and the body (Content-Length)
+    QByteArray request;
+    qint64 header_end = -1;
+    qint64 content_length = 0;
+    while (socket->waitForReadyRead(1000)) {
+      request.append(socket->readAll());
+      if (header_end < 0 && (header_end = request.indexOf("\r\n\r\n")) >= 0) {
+        for (auto line : request.left(header_end).split('\n')) {
+          if (line.toLower().startsWith("content-length:")) {
+            content_length = line.mid(15).trimmed().toLongLong();
+          }
+        }
+      }
+      if (header_end >= 0 && request.size() >= header_end + 4 + content_length) {
+        break;
+      }
+    }
+
+    QJsonObject body = QJsonDocument::fromJson(request.mid(header_end + 4)).object();
+    QString device_id = body["properties"].toObject()["deviceID"].toString();
+    requests_.fetchAndAddOrdered(1);
+
+    QByteArray reply =
+        QString("{\"data\":{\"code\":0,\"result\":\"success\",\"fileId\":\"file-%1\"}}").arg(device_id).toUtf8();
+    socket->write("HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nConnection: close\r\nContent-Length: " +
+                  QByteArray::number(reply.size()) + "\r\n\r\n" + reply);
+    socket->waitForBytesWritten(1000);
+    socket->disconnectFromHost();
+    delete socket;
+  }
+};
+
 int main(void) {
   ACT_STATUS_INIT();
 
+  // Use the local MAF stub
+  ActMafStub maf_stub;
+  qputenv("MAF_API_ADDR", "127.0.0.1");
+  qputenv("MAF_API_PORT", QByteArray::number(maf_stub.Start()));
+
   const qint64 DEVICE_ID = 100;
 
   ActProject project;
@@ -114,6 +196,45 @@ int main(void) {
 
   QString file_name;
   act_status = act::offline_config::GenerateOfflineConfig(project_ref, DEVICE_ID, file_name);
+  if (!IsActStatusSuccess(act_status) || (file_name != QString("file-%1").arg(DEVICE_ID))) {
+    qCritical() << "GenerateOfflineConfig() failed:" << act_status->GetErrorMessage() << file_name;
+    return 1;
+  }
+
+  // Generate the copies of the device at once, one request per device
+  const qint64 DEVICE_COUNT = 50;
+  QList<qint64> dev_id_list;
+  for (qint64 dev_id = DEVICE_ID + 1; dev_id <= DEVICE_ID + DEVICE_COUNT; dev_id++) {
+    ActDevice copy_device(device);
+    copy_device.SetId(dev_id);
+    copy_device.SetIpv4(ActIpv4(QString("192.168.128.%1").arg(dev_id - DEVICE_ID)));
+    project.GetDevices().insert(copy_device);
+    project.GetDeviceConfig().GetNetworkSettingTables()[dev_id] = ActNetworkSettingTable(dev_id);
+    dev_id_list.append(dev_id);
+  }
+
+  const qint32 requests = maf_stub.GetRequests();
+  QMap<qint64, QString> file_id_map;
+  act_status = act::offline_config::GenerateOfflineConfigs(project, dev_id_list, file_id_map);
+  if (!IsActStatusSuccess(act_status) || (file_id_map.size() != DEVICE_COUNT) ||
+      (maf_stub.GetRequests() - requests != DEVICE_COUNT)) {
+    qCritical() << "GenerateOfflineConfigs() failed:" << act_status->GetErrorMessage() << file_id_map.size();
+    return 1;
+  }
+  for (auto dev_id : dev_id_list) {
+    if (file_id_map.value(dev_id) != QString("file-%1").arg(dev_id)) {
+      qCritical() << "GenerateOfflineConfigs() file id mismatch. Device:" << dev_id << file_id_map.value(dev_id);
+      return 1;
+    }
+  }
+
+  // A failed device (the MAF is gone) fails the batch
+  maf_stub.Stop();
+  act_status = act::offline_config::GenerateOfflineConfigs(project, dev_id_list, file_id_map);
+  if (IsActStatusSuccess(act_status) || !file_id_map.isEmpty()) {
+    qCritical() << "GenerateOfflineConfigs() should fail without the MAF";
+    return 1;
+  }
 
   return 0;
 }
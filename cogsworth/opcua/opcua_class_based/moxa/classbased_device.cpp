@@ -94,6 +94,54 @@ UaStatus updateDeviceNode(const ActProject& project, const ActDevice& device, Op
   return ret;
 }
 
+UaStatus updateProjectDeviceNode(const ActProject& project, const ActDevice& device, OpcUa_UInt32& errorCode,
+                                 UaString& errorMessage) {
+  UaStatus ret;
+
+  // The device node is recreated if its device profile is changed
+  UaNodeId deviceNodeId = pMoxaNodeManager->getDeviceNodeId(project.GetId(), device.GetId());
+  MoxaClassBased::DeviceType* pDeviceType = (MoxaClassBased::DeviceType*)pMoxaNodeManager->getNode(deviceNodeId);
+  UaString device_profile_name = UaString(device.GetDeviceProperty().GetModelName().toStdString().c_str());
+  if (pDeviceType != NULL && pDeviceType->getDeviceProfileName() != device_profile_name) {
+    ret = removeDeviceNode(project, device.GetId(), errorCode, errorMessage);
+    if (ret.isNotGood() || errorCode != M_UA_NO_ERROR) {
+      return ret;
+    }
+  }
+
+  if (device.GetDeviceType() == ActDeviceTypeEnum::kSwitch ||
+      device.GetDeviceType() == ActDeviceTypeEnum::kTSNSwitch) {
+    ret = updateBridgeNode(project, device, errorCode, errorMessage);
+  } else if (device.GetDeviceType() == ActDeviceTypeEnum::kEndStation) {
+    ret = updateEndStationNode(project, device, errorCode, errorMessage);
+  }
+
+  return ret;
+}
+
+UaStatus removeDeviceNode(const ActProject& project, const qint64& device_id, OpcUa_UInt32& errorCode,
+                          UaString& errorMessage) {
+  UaStatus ret;
+
+  UaNodeId deviceNodeId = pMoxaNodeManager->getDeviceNodeId(project.GetId(), device_id);
+  UaNode* pNode = pMoxaNodeManager->getNode(deviceNodeId);
+  if (!pNode) {
+    // Node already deleted, treat as success
+    return ret;
+  }
+
+  UaString browseName = pNode->browseName().toString();
+  ret = pMoxaNodeManager->deleteUaNode(pNode, OpcUa_True, OpcUa_True, OpcUa_True);
+  if (ret.isNotGood()) {
+    errorCode = M_UA_INTERNAL_ERROR;
+    errorMessage = UaString("Invalid: Remove device %1 failed").arg(browseName);
+    qDebug() << errorMessage.toUtf8();
+    return ret;
+  }
+
+  return ret;
+}
+
 UaStatus removeDeviceMethod(const UaNodeId& deviceNodeId, OpcUa_UInt32& errorCode, UaString& errorMessage) {
   UaStatus ret;
   ACT_STATUS_INIT();
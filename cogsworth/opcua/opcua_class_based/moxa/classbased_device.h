@@ -9,6 +9,12 @@ UaStatus updateDeviceNodes(const ActProject& project, OpcUa_UInt32& errorCode, U
 UaStatus updateDeviceNode(const ActProject& project, const ActDevice& device, OpcUa_UInt32& errorCode,
                           UaString& errorMessage);
 
+UaStatus updateProjectDeviceNode(const ActProject& project, const ActDevice& device, OpcUa_UInt32& errorCode,
+                                 UaString& errorMessage);
+
+UaStatus removeDeviceNode(const ActProject& project, const qint64& device_id, OpcUa_UInt32& errorCode,
+                          UaString& errorMessage);
+
 UaStatus removeDeviceMethod(const UaNodeId& deviceNodeId, OpcUa_UInt32& errorCode, UaString& errorMessage);
 
 }  // namespace ClassBased
@@ -11,149 +11,182 @@ UaStatus updateLinkNodes(const ActProject& project, OpcUa_UInt32& errorCode, UaS
   MoxaClassBased::LinkFolderType* pLinkFolderType = pProjectType->getLinks();
 
   for (ActLink link : project.GetLinks()) {
-    qint64 link_id = link.GetId();
-    qint64 src_dev_id = link.GetSourceDeviceId();
-    qint64 dst_dev_id = link.GetDestinationDeviceId();
-    qint64 src_inf_id = link.GetSourceInterfaceId();
-    qint64 dst_inf_id = link.GetDestinationInterfaceId();
-
-    ActDevice src_dev;
-    project.GetDeviceById(src_dev, src_dev_id);
-    UaString src_dev_ip(src_dev.GetIpv4().GetIpAddress().toStdString().c_str());
-    UaString src_inf_name;
-    for (ActInterface intf : src_dev.GetInterfaces()) {
-      if (intf.GetInterfaceId() == src_inf_id) {
-        src_inf_name = intf.GetInterfaceName().toStdString().c_str();
-      }
+    ret = updateLinkNode(project, link, errorCode, errorMessage);
+    if (ret.isNotGood() || errorCode != M_UA_NO_ERROR) {
+      return ret;
     }
+  }
 
-    ActDevice dst_dev;
-    project.GetDeviceById(dst_dev, dst_dev_id);
-    UaString dst_dev_ip(dst_dev.GetIpv4().GetIpAddress().toStdString().c_str());
-    UaString dst_inf_name;
-    for (ActInterface intf : dst_dev.GetInterfaces()) {
-      if (intf.GetInterfaceId() == dst_inf_id) {
-        dst_inf_name = intf.GetInterfaceName().toStdString().c_str();
-      }
+  UaReferenceDescriptions references;
+  pMoxaNodeManager->getNodeReference(pLinkFolderType->nodeId(), OpcUa_False, references);
+  for (OpcUa_UInt32 idx = 0; idx < references.length(); idx++) {
+    if (references[idx].TypeDefinition.NodeId.Identifier.Numeric != MoxaClassBasedId_LinkType) {
+      continue;
     }
-
-    // browseName
-    UaString SourceCommLinkTo = UaString("%1_%2").arg(src_dev_ip).arg(src_inf_name);
-    UaString DestinationCommLinkTo = UaString("%1_%2").arg(dst_dev_ip).arg(dst_inf_name);
-    UaString browseName = UaString("%1_%2").arg(SourceCommLinkTo).arg(DestinationCommLinkTo);
-
-    UaNodeId linkNodeId = pMoxaNodeManager->getLinkNodeId(project.GetId(), link_id);
-    MoxaClassBased::LinkType* pLinkType = (MoxaClassBased::LinkType*)pMoxaNodeManager->getNode(linkNodeId);
-    if (pLinkType == NULL) {
-      // NodeId for the node to create
-
-      // If succeeded, create the new node to the OPC UA nodemanager
-      pLinkType = new MoxaClassBased::LinkType(linkNodeId, browseName, pMoxaNodeManager->getNameSpaceIndex(),
-                                               pMoxaNodeManager->getNodeManagerConfig());
-      if (!pLinkType) {
-        errorCode = M_UA_INTERNAL_ERROR;
-        errorMessage = UaString("Invalid: Allocate memory failed");
-        qDebug() << errorMessage.toUtf8();
+    UaNodeId linkNodeId(references[idx].NodeId.NodeId);
+    qint64 link_id = pMoxaNodeManager->getLinkId(linkNodeId);
+    ActLink link;
+    act_status = project.GetLinkById(link, link_id);
+    if (!IsActStatusSuccess(act_status)) {
+      ret = removeLinkNode(project, link_id, errorCode, errorMessage);
+      if (ret.isNotGood() || errorCode != M_UA_NO_ERROR) {
         return ret;
       }
+    }
+  }
 
-      ret = pMoxaNodeManager->addNodeAndReference(pLinkFolderType->nodeId(), pLinkType->getUaReferenceLists(),
-                                                  OpcUaId_HasComponent);
-      if (ret.isNotGood()) {
-        errorCode = M_UA_INTERNAL_ERROR;
-        errorMessage = UaString("Invalid: Add node reference failed");
-        qDebug() << errorMessage.toUtf8();
-        return ret;
-      }
-    } else {
-      if (pLinkType->browseName().toString() == browseName) {
-        continue;
-      }
+  return ret;
+}
 
-      pLinkType->setBrowseName(UaQualifiedName(browseName, pMoxaNodeManager->getNameSpaceIndex()));
-      pLinkType->setDisplayName(UaLocalizedText(UaString(), browseName));
+UaStatus updateLinkNode(const ActProject& project, const ActLink& link, OpcUa_UInt32& errorCode,
+                        UaString& errorMessage) {
+  UaStatus ret;
 
-      UaReferenceDescriptions references;
-      pMoxaNodeManager->getNodeReference(pLinkType->nodeId(), OpcUa_False, references);
-      OpcUa_UInt32 idx = 0;
-      for (idx = 0; idx < references.length(); idx++) {
-        if (references[idx].TypeDefinition.NodeId.Identifier.Numeric != MoxaClassBasedId_EthernetInterfaceType &&
-            references[idx].TypeDefinition.NodeId.Identifier.Numeric != MoxaClassBasedId_EthernetInterfaceType) {
-          continue;
-        }
+  UaNodeId projectNodeId = pMoxaNodeManager->getProjectNodeId(project.GetId());
+  MoxaClassBased::ProjectType* pProjectType = (MoxaClassBased::ProjectType*)pMoxaNodeManager->getNode(projectNodeId);
+  MoxaClassBased::LinkFolderType* pLinkFolderType = pProjectType->getLinks();
 
-        UaNodeId interfaceNodeId(references[idx].NodeId.NodeId);
-        ret = pMoxaNodeManager->deleteUaReference(
-            pLinkType->nodeId(), interfaceNodeId,
-            UaNodeId(OpcUaClassBnmId_CommLinkTo, pOpcUaClassBnm->getNameSpaceIndex()));
-        if (ret.isNotGood()) {
-          errorCode = M_UA_INTERNAL_ERROR;
-          errorMessage = UaString("Invalid: Delete interface link failed");
-          qDebug() << errorMessage.toUtf8();
-          return ret;
-        }
-      }
+  qint64 link_id = link.GetId();
+  qint64 src_dev_id = link.GetSourceDeviceId();
+  qint64 dst_dev_id = link.GetDestinationDeviceId();
+  qint64 src_inf_id = link.GetSourceInterfaceId();
+  qint64 dst_inf_id = link.GetDestinationInterfaceId();
+
+  ActDevice src_dev;
+  project.GetDeviceById(src_dev, src_dev_id);
+  UaString src_dev_ip(src_dev.GetIpv4().GetIpAddress().toStdString().c_str());
+  UaString src_inf_name;
+  for (ActInterface intf : src_dev.GetInterfaces()) {
+    if (intf.GetInterfaceId() == src_inf_id) {
+      src_inf_name = intf.GetInterfaceName().toStdString().c_str();
     }
+  }
 
-    pLinkType->setSpeed(OpcUa_UInt64(link.GetSpeed()));
-    switch (link.GetCableType()) {
-      case ActCableTypeEnum::kCopper:
-        pLinkType->setCableType(MoxaClassBased::LinkCableType::LinkCableType_Copper);
-        break;
-      case ActCableTypeEnum::kFiber:
-        pLinkType->setCableType(MoxaClassBased::LinkCableType::LinkCableType_Fiber);
-        break;
+  ActDevice dst_dev;
+  project.GetDeviceById(dst_dev, dst_dev_id);
+  UaString dst_dev_ip(dst_dev.GetIpv4().GetIpAddress().toStdString().c_str());
+  UaString dst_inf_name;
+  for (ActInterface intf : dst_dev.GetInterfaces()) {
+    if (intf.GetInterfaceId() == dst_inf_id) {
+      dst_inf_name = intf.GetInterfaceName().toStdString().c_str();
     }
-    pLinkType->setCableLength(OpcUa_UInt16(link.GetCableLength()));
-    pLinkType->setPropagationDelay(OpcUa_UInt32(link.GetPropagationDelay()));
+  }
 
-    // Find source and destination interface
-    UaNodeId sourceNodeId = pMoxaNodeManager->getInterfaceNodeId(project.GetId(), src_dev_id, src_inf_id);
-    UaNodeId destinationNodeId = pMoxaNodeManager->getInterfaceNodeId(project.GetId(), dst_dev_id, dst_inf_id);
+  // browseName
+  UaString SourceCommLinkTo = UaString("%1_%2").arg(src_dev_ip).arg(src_inf_name);
+  UaString DestinationCommLinkTo = UaString("%1_%2").arg(dst_dev_ip).arg(dst_inf_name);
+  UaString browseName = UaString("%1_%2").arg(SourceCommLinkTo).arg(DestinationCommLinkTo);
 
-    // Add source interface link
-    ret = pMoxaNodeManager->addUaReference(pLinkType->nodeId(), sourceNodeId,
-                                           UaNodeId(OpcUaClassBnmId_CommLinkTo, pOpcUaClassBnm->getNameSpaceIndex()));
-    if (ret.isNotGood()) {
+  UaNodeId linkNodeId = pMoxaNodeManager->getLinkNodeId(project.GetId(), link_id);
+  MoxaClassBased::LinkType* pLinkType = (MoxaClassBased::LinkType*)pMoxaNodeManager->getNode(linkNodeId);
+  if (pLinkType == NULL) {
+    // NodeId for the node to create
+
+    // If succeeded, create the new node to the OPC UA nodemanager
+    pLinkType = new MoxaClassBased::LinkType(linkNodeId, browseName, pMoxaNodeManager->getNameSpaceIndex(),
+                                             pMoxaNodeManager->getNodeManagerConfig());
+    if (!pLinkType) {
       errorCode = M_UA_INTERNAL_ERROR;
-      errorMessage = UaString("Invalid: Add source interface link failed");
+      errorMessage = UaString("Invalid: Allocate memory failed");
       qDebug() << errorMessage.toUtf8();
       return ret;
     }
 
-    // Add destination interface link
-    ret = pMoxaNodeManager->addUaReference(pLinkType->nodeId(), destinationNodeId,
-                                           UaNodeId(OpcUaClassBnmId_CommLinkTo, pOpcUaClassBnm->getNameSpaceIndex()));
+    ret = pMoxaNodeManager->addNodeAndReference(pLinkFolderType->nodeId(), pLinkType->getUaReferenceLists(),
+                                                OpcUaId_HasComponent);
     if (ret.isNotGood()) {
       errorCode = M_UA_INTERNAL_ERROR;
-      errorMessage = UaString("Invalid: Add destination interface link failed");
+      errorMessage = UaString("Invalid: Add node reference failed");
       qDebug() << errorMessage.toUtf8();
       return ret;
     }
-  }
-
-  UaReferenceDescriptions references;
-  pMoxaNodeManager->getNodeReference(pLinkFolderType->nodeId(), OpcUa_False, references);
-  for (OpcUa_UInt32 idx = 0; idx < references.length(); idx++) {
-    if (references[idx].TypeDefinition.NodeId.Identifier.Numeric != MoxaClassBasedId_LinkType) {
-      continue;
+  } else {
+    if (pLinkType->browseName().toString() != browseName) {
+      pLinkType->setBrowseName(UaQualifiedName(browseName, pMoxaNodeManager->getNameSpaceIndex()));
+      pLinkType->setDisplayName(UaLocalizedText(UaString(), browseName));
     }
-    UaNodeId linkNodeId(references[idx].NodeId.NodeId);
-    qint64 link_id = pMoxaNodeManager->getLinkId(linkNodeId);
-    ActLink link;
-    act_status = project.GetLinkById(link, link_id);
-    if (!IsActStatusSuccess(act_status)) {
-      MoxaClassBased::LinkType* pLinkType = (MoxaClassBased::LinkType*)pMoxaNodeManager->getNode(linkNodeId);
-      ret = pMoxaNodeManager->deleteUaNode(pLinkType, OpcUa_True, OpcUa_True, OpcUa_True);
+
+    // Relink the interfaces, the interface nodes may be recreated with the device
+    UaReferenceDescriptions references;
+    pMoxaNodeManager->getNodeReference(pLinkType->nodeId(), OpcUa_False, references);
+    OpcUa_UInt32 idx = 0;
+    for (idx = 0; idx < references.length(); idx++) {
+      if (references[idx].TypeDefinition.NodeId.Identifier.Numeric != MoxaClassBasedId_EthernetInterfaceType &&
+          references[idx].TypeDefinition.NodeId.Identifier.Numeric != MoxaClassBasedId_EthernetInterfaceType) {
+        continue;
+      }
+
+      UaNodeId interfaceNodeId(references[idx].NodeId.NodeId);
+      ret = pMoxaNodeManager->deleteUaReference(
+          pLinkType->nodeId(), interfaceNodeId,
+          UaNodeId(OpcUaClassBnmId_CommLinkTo, pOpcUaClassBnm->getNameSpaceIndex()));
       if (ret.isNotGood()) {
         errorCode = M_UA_INTERNAL_ERROR;
-        errorMessage = UaString("Invalid: Remove node %1 failed").arg(linkNodeId.toFullString());
+        errorMessage = UaString("Invalid: Delete interface link failed");
         qDebug() << errorMessage.toUtf8();
         return ret;
       }
     }
   }
 
+  pLinkType->setSpeed(OpcUa_UInt64(link.GetSpeed()));
+  switch (link.GetCableType()) {
+    case ActCableTypeEnum::kCopper:
+      pLinkType->setCableType(MoxaClassBased::LinkCableType::LinkCableType_Copper);
+      break;
+    case ActCableTypeEnum::kFiber:
+      pLinkType->setCableType(MoxaClassBased::LinkCableType::LinkCableType_Fiber);
+      break;
+  }
+  pLinkType->setCableLength(OpcUa_UInt16(link.GetCableLength()));
+  pLinkType->setPropagationDelay(OpcUa_UInt32(link.GetPropagationDelay()));
+
+  // Find source and destination interface
+  UaNodeId sourceNodeId = pMoxaNodeManager->getInterfaceNodeId(project.GetId(), src_dev_id, src_inf_id);
+  UaNodeId destinationNodeId = pMoxaNodeManager->getInterfaceNodeId(project.GetId(), dst_dev_id, dst_inf_id);
+
+  // Add source interface link
+  ret = pMoxaNodeManager->addUaReference(pLinkType->nodeId(), sourceNodeId,
+                                         UaNodeId(OpcUaClassBnmId_CommLinkTo, pOpcUaClassBnm->getNameSpaceIndex()));
+  if (ret.isNotGood()) {
+    errorCode = M_UA_INTERNAL_ERROR;
+    errorMessage = UaString("Invalid: Add source interface link failed");
+    qDebug() << errorMessage.toUtf8();
+    return ret;
+  }
+
+  // Add destination interface link
+  ret = pMoxaNodeManager->addUaReference(pLinkType->nodeId(), destinationNodeId,
+                                         UaNodeId(OpcUaClassBnmId_CommLinkTo, pOpcUaClassBnm->getNameSpaceIndex()));
+  if (ret.isNotGood()) {
+    errorCode = M_UA_INTERNAL_ERROR;
+    errorMessage = UaString("Invalid: Add destination interface link failed");
+    qDebug() << errorMessage.toUtf8();
+    return ret;
+  }
+
+  return ret;
+}
+
+UaStatus removeLinkNode(const ActProject& project, const qint64& link_id, OpcUa_UInt32& errorCode,
+                        UaString& errorMessage) {
+  UaStatus ret;
+
+  UaNodeId linkNodeId = pMoxaNodeManager->getLinkNodeId(project.GetId(), link_id);
+  UaNode* pNode = pMoxaNodeManager->getNode(linkNodeId);
+  if (!pNode) {
+    // Node already deleted, treat as success
+    return ret;
+  }
+
+  ret = pMoxaNodeManager->deleteUaNode(pNode, OpcUa_True, OpcUa_True, OpcUa_True);
+  if (ret.isNotGood()) {
+    errorCode = M_UA_INTERNAL_ERROR;
+    errorMessage = UaString("Invalid: Remove node %1 failed").arg(linkNodeId.toFullString());
+    qDebug() << errorMessage.toUtf8();
+    return ret;
+  }
+
   return ret;
 }
 
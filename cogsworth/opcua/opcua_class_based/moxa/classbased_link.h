@@ -7,6 +7,12 @@ namespace ClassBased {
 
 UaStatus updateLinkNodes(const ActProject& project, OpcUa_UInt32& errorCode, UaString& errorMessage);
 
+UaStatus updateLinkNode(const ActProject& project, const ActLink& link, OpcUa_UInt32& errorCode,
+                        UaString& errorMessage);
+
+UaStatus removeLinkNode(const ActProject& project, const qint64& link_id, OpcUa_UInt32& errorCode,
+                        UaString& errorMessage);
+
 UaStatus addLinkMethod(const UaNodeId& folderNodeId, const MoxaClassBased::LinkDataType& configuration,
                        UaNodeId& linkNodeId, OpcUa_UInt32& errorCode, UaString& errorMessage);
 
@@ -72,6 +72,143 @@ UaStatus updateProjectNode(const ActProject &project, OpcUa_UInt32 &errorCode, U
   return ret;
 }
 
+UaStatus applyProjectChanges(const ActProject& project, const ActProjectChangeSet& changes, OpcUa_UInt32& errorCode,
+                             UaString& errorMessage) {
+  UaStatus ret;
+
+  if (project.GetProjectMode() != ActProjectModeEnum::kDesign) {
+    return ret;
+  }
+
+  UaNodeId projectNodeId(pMoxaNodeManager->getProjectNodeId(project.GetId()));
+  MoxaClassBased::ProjectType* pProjectType = (MoxaClassBased::ProjectType*)pMoxaNodeManager->getNode(projectNodeId);
+  if (changes.created || pProjectType == NULL) {
+    return updateProjectNode(project, errorCode, errorMessage);
+  }
+
+  if (changes.setting_changed) {
+    UaString projectName(project.GetProjectName().toStdString().c_str());
+    pProjectType->setBrowseName(UaQualifiedName(projectName, pMoxaNodeManager->getNameSpaceIndex()));
+    pProjectType->setDisplayName(UaLocalizedText(UaString(), projectName));
+
+    ret = updateProjectSettingNode(project, errorCode, errorMessage);
+    if (ret.isNotGood() || errorCode != M_UA_NO_ERROR) {
+      return ret;
+    }
+  }
+
+  // The links are removed before their devices, and added after them
+  for (const qint64& link_id : changes.removed_links) {
+    ret = removeLinkNode(project, link_id, errorCode, errorMessage);
+    if (ret.isNotGood() || errorCode != M_UA_NO_ERROR) {
+      return ret;
+    }
+  }
+
+  for (const qint64& device_id : changes.removed_devices) {
+    ret = removeDeviceNode(project, device_id, errorCode, errorMessage);
+    if (ret.isNotGood() || errorCode != M_UA_NO_ERROR) {
+      return ret;
+    }
+  }
+
+  for (const qint64& device_id : changes.added_devices + changes.updated_devices) {
+    ActDevice device;
+    ACT_STATUS act_status = project.GetDeviceById(device, device_id);
+    if (!IsActStatusSuccess(act_status)) {
+      continue;
+    }
+    ret = updateProjectDeviceNode(project, device, errorCode, errorMessage);
+    if (ret.isNotGood() || errorCode != M_UA_NO_ERROR) {
+      return ret;
+    }
+  }
+
+  for (const qint64& link_id : changes.added_links + changes.updated_links) {
+    ActLink link;
+    ACT_STATUS act_status = project.GetLinkById(link, link_id);
+    if (!IsActStatusSuccess(act_status)) {
+      continue;
+    }
+    ret = updateLinkNode(project, link, errorCode, errorMessage);
+    if (ret.isNotGood() || errorCode != M_UA_NO_ERROR) {
+      return ret;
+    }
+  }
+
+  if (changes.traffic_design_changed) {
+    ret = updateTrafficDesignNodes(project, errorCode, errorMessage);
+    if (ret.isNotGood() || errorCode != M_UA_NO_ERROR) {
+      return ret;
+    }
+  }
+
+  return ret;
+}
+
+UaStatus checkProjectNodes(const ActProject& project, OpcUa_UInt32& errorCode, UaString& errorMessage) {
+  UaStatus ret;
+
+  if (project.GetProjectMode() != ActProjectModeEnum::kDesign) {
+    return ret;
+  }
+
+  UaNodeId projectNodeId(pMoxaNodeManager->getProjectNodeId(project.GetId()));
+  MoxaClassBased::ProjectType* pProjectType = (MoxaClassBased::ProjectType*)pMoxaNodeManager->getNode(projectNodeId);
+  if (pProjectType == NULL) {
+    errorCode = M_UA_INTERNAL_ERROR;
+    errorMessage = UaString("Invalid: Project %1 is not found").arg(projectNodeId.toFullString());
+    return ret;
+  }
+
+  // The device nodes
+  QSet<qint64> device_ids;
+  UaReferenceDescriptions references;
+  pMoxaNodeManager->getNodeReference(pProjectType->getDevices()->nodeId(), OpcUa_False, references);
+  for (OpcUa_UInt32 idx = 0; idx < references.length(); idx++) {
+    if (references[idx].TypeDefinition.NodeId.Identifier.Numeric == MoxaClassBasedId_BridgeType ||
+        references[idx].TypeDefinition.NodeId.Identifier.Numeric == MoxaClassBasedId_EndStationType) {
+      device_ids.insert(pMoxaNodeManager->getDeviceId(references[idx].NodeId.NodeId));
+    }
+  }
+
+  QSet<qint64> expected_device_ids;
+  for (const ActDevice& device : project.GetDevices()) {
+    if (device.GetDeviceType() == ActDeviceTypeEnum::kSwitch ||
+        device.GetDeviceType() == ActDeviceTypeEnum::kTSNSwitch ||
+        device.GetDeviceType() == ActDeviceTypeEnum::kEndStation) {
+      expected_device_ids.insert(device.GetId());
+    }
+  }
+  if (device_ids != expected_device_ids) {
+    errorCode = M_UA_INTERNAL_ERROR;
+    errorMessage = UaString("Invalid: The device nodes of project %1 mismatch").arg(projectNodeId.toFullString());
+    return ret;
+  }
+
+  // The link nodes
+  QSet<qint64> link_ids;
+  UaReferenceDescriptions linkReferences;
+  pMoxaNodeManager->getNodeReference(pProjectType->getLinks()->nodeId(), OpcUa_False, linkReferences);
+  for (OpcUa_UInt32 idx = 0; idx < linkReferences.length(); idx++) {
+    if (linkReferences[idx].TypeDefinition.NodeId.Identifier.Numeric == MoxaClassBasedId_LinkType) {
+      link_ids.insert(pMoxaNodeManager->getLinkId(linkReferences[idx].NodeId.NodeId));
+    }
+  }
+
+  QSet<qint64> expected_link_ids;
+  for (const ActLink& link : project.GetLinks()) {
+    expected_link_ids.insert(link.GetId());
+  }
+  if (link_ids != expected_link_ids) {
+    errorCode = M_UA_INTERNAL_ERROR;
+    errorMessage = UaString("Invalid: The link nodes of project %1 mismatch").arg(projectNodeId.toFullString());
+    return ret;
+  }
+
+  return ret;
+}
+
 UaStatus removeProjectNode(const ActProject& project, OpcUa_UInt32& errorCode, UaString& errorMessage) {
   UaStatus ret;
 
@@ -1,12 +1,18 @@
 #ifndef __CLASSBASED_PROJECT_H__
 #define __CLASSBASED_PROJECT_H__
 
+#include "act_project_change_tracker.hpp"
 #include "classbased_nodemanagermoxans.h"
 namespace ClassBased {
 UaStatus createProjectNode(const ActProject& project, OpcUa_UInt32& errorCode, UaString& errorMessage);
 
 UaStatus updateProjectNode(const ActProject& actProject, OpcUa_UInt32& errorCode, UaString& errorMessage);
 
+UaStatus applyProjectChanges(const ActProject& project, const ActProjectChangeSet& changes, OpcUa_UInt32& errorCode,
+                             UaString& errorMessage);
+
+UaStatus checkProjectNodes(const ActProject& project, OpcUa_UInt32& errorCode, UaString& errorMessage);
+
 UaStatus removeProjectNode(const ActProject& project, OpcUa_UInt32& errorCode, UaString& errorMessage);
 
 UaStatus addProjectMethod(const UaString& projectName, UaNodeId& projectNodeId, OpcUa_UInt32& errorCode,
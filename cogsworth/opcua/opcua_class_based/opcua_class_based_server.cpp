@@ -1,5 +1,8 @@
 #include "opcua_class_based_server.h"
 
+#include <QMutex>
+
+#include "act_project_change_tracker.hpp"
 #include "classbased_bridge.h"
 #include "classbased_device.h"
 #include "classbased_deviceprofile.h"
@@ -9,14 +12,42 @@
 
 namespace MoxaOpcUaClassBased {
 
+// The projects in the address space, to only update the nodes of the changed parts
+static ActProjectChangeTracker projectChangeTracker;
+static QMutex projectChangeTrackerMutex;
+
 ACT_STATUS updateOpcUaProject(const ActProject &project) {
   UaStatus ret;
   ACT_STATUS_INIT();
 
+  if (project.GetProjectMode() != ActProjectModeEnum::kDesign) {
+    return act_status;
+  }
+
+  QMutexLocker lock(&projectChangeTrackerMutex);
+
   OpcUa_UInt32 errorCode = M_UA_NO_ERROR;
   UaString errorMessage;
-  ret = ClassBased::updateProjectNode(project, errorCode, errorMessage);
+  ActProjectChangeSet changes = projectChangeTracker.Update(project);
+  if (changes.IsEmpty()) {
+    return act_status;
+  }
+
+  ret = ClassBased::applyProjectChanges(project, changes, errorCode, errorMessage);
+  if (ret.isGood() && errorCode == M_UA_NO_ERROR && !changes.created) {
+    // The address space may be changed by the others (e.g. the OPC UA methods), rebuild it if out of sync
+    ret = ClassBased::checkProjectNodes(project, errorCode, errorMessage);
+    if (ret.isNotGood() || errorCode != M_UA_NO_ERROR) {
+      qWarning() << errorMessage.toUtf8() << ", rebuild the project nodes";
+      errorCode = M_UA_NO_ERROR;
+      errorMessage = UaString();
+      ret = ClassBased::updateProjectNode(project, errorCode, errorMessage);
+    }
+  }
+
   if (ret.isNotGood() || errorCode != M_UA_NO_ERROR) {
+    // Rebuild all the nodes at the next update
+    projectChangeTracker.Remove(project.GetId());
     return std::make_shared<ActBadRequest>(QString(errorMessage.toUtf8()));
   }
   return act_status;
@@ -26,6 +57,10 @@ ACT_STATUS removeOpcUaProject(const ActProject &project) {
   UaStatus ret;
   ACT_STATUS_INIT();
 
+  projectChangeTrackerMutex.lock();
+  projectChangeTracker.Remove(project.GetId());
+  projectChangeTrackerMutex.unlock();
+
   OpcUa_UInt32 errorCode = M_UA_NO_ERROR;
   UaString errorMessage;
   ret = ClassBased::removeProjectNode(project, errorCode, errorMessage);
@@ -0,0 +1,118 @@
+/* Copyright (C) MOXA Inc. All rights reserved.
+This software is distributed under the terms of the MOXA SOFTWARE NOTICE.
+See the file MOXA-SOFTWARE-NOTICE for details.
+*/
+
+#pragma once
+
+#include <QEventLoop>
+#include <QList>
+#include <QMutex>
+#include <QRandomGenerator>
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include "act_simulator_config.hpp"
+#include "act_simulator_restful.hpp"
+#include "act_simulator_snmp.hpp"
+#include "act_status.hpp"
+
+namespace act {
+namespace simulator {
+
+/**
+ * @brief The statistics of the simulator (for the benchmark)
+ *
+ */
+class ActSimulatorStatistics : public QSerializer {
+  Q_GADGET
+  QS_SERIALIZABLE
+
+  ACT_JSON_FIELD(quint64, snmp_requests, SnmpRequests);
+  ACT_JSON_FIELD(quint64, restful_requests, RestfulRequests);
+  ACT_JSON_FIELD(quint64, dropped_requests, DroppedRequests);
+
+ public:
+  ActSimulatorStatistics() : snmp_requests_(0), restful_requests_(0), dropped_requests_(0) {}
+};
+
+/**
+ * @brief The device fleet simulator
+ *
+ * Each simulated device listens on its own loopback IP (127.0.0.0/8 is routed to the loopback on Linux, so no
+ * interface setup is needed and the kernel answers the ICMP). The SNMP agents and the RESTful servers of all devices
+ * run on one event loop thread, the latency is injected by delaying the reply and the failure by dropping the request
+ * (SNMP timeout) or replying 503 (RESTful).
+ *
+ * The ActDevice of the project should use the configured SnmpPort/RestfulPort, the communities & account, and the
+ * HTTP protocol of the RESTful configuration.
+ *
+ */
+class ActDeviceSimulator {
+ public:
+  explicit ActDeviceSimulator(const ActSimulatorConfig &config);
+  ~ActDeviceSimulator();
+
+  ActDeviceSimulator(const ActDeviceSimulator &) = delete;
+  ActDeviceSimulator &operator=(const ActDeviceSimulator &) = delete;
+
+  /**
+   * @brief Start the simulator thread and bind the devices' sockets
+   *
+   * @return ACT_STATUS
+   */
+  ACT_STATUS Start();
+
+  /**
+   * @brief Stop the simulator thread
+   *
+   */
+  void Stop();
+
+  /**
+   * @brief Get the simulated devices (the generated fleet)
+   *
+   * @return const QList<ActSimulatedDevice>&
+   */
+  const QList<ActSimulatedDevice> &GetDevices() const { return devices_; }
+
+  /**
+   * @brief Get the statistics
+   *
+   * @return ActSimulatorStatistics
+   */
+  ActSimulatorStatistics GetStatistics() const;
+
+ private:
+  ActSimulatorConfig config_;
+  QList<ActSimulatedDevice> devices_;
+
+  std::unique_ptr<std::thread> thread_;
+  QEventLoop *event_loop_;  ///< Owned by the simulator thread
+  QMutex event_loop_mutex_;
+
+  std::atomic<quint64> snmp_requests_;
+  std::atomic<quint64> restful_requests_;
+  std::atomic<quint64> dropped_requests_;
+
+  /**
+   * @brief The simulator thread, binds the sockets & runs the event loop
+   *
+   * @param bind_status the result of the binding
+   * @param ready set after the binding
+   */
+  void Run(ACT_STATUS &bind_status, std::atomic<bool> &ready);
+
+  /**
+   * @brief Whether to drop the request by the failure rate
+   *
+   * @param device
+   * @param random
+   * @return true if drop
+   */
+  bool InjectFailure(const ActSimulatedDevice &device, QRandomGenerator &random);
+};
+
+}  // namespace simulator
+}  // namespace act
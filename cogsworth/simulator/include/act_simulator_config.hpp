@@ -0,0 +1,169 @@
+/* Copyright (C) MOXA Inc. All rights reserved.
+This software is distributed under the terms of the MOXA SOFTWARE NOTICE.
+See the file MOXA-SOFTWARE-NOTICE for details.
+*/
+
+#pragma once
+
+#include "act_json.hpp"
+#include "act_status.hpp"
+
+#define ACT_SIMULATOR_BASE_IP "127.0.1.1"    ///< The IP of the first simulated device (loopback)
+#define ACT_SIMULATOR_SNMP_PORT (1161)       ///< The SNMP port (161 needs the root privilege)
+#define ACT_SIMULATOR_RESTFUL_PORT (8080)    ///< The RESTful(HTTP) port
+#define ACT_SIMULATOR_PORT_COUNT (8)         ///< The port count of the simulated device
+#define ACT_SIMULATOR_MAC_PREFIX "00:90:E8"  ///< The MOXA OUI
+#define ACT_SIMULATOR_MODEL_NAME "TSN-G5008-2GTXSFP"
+#define ACT_SIMULATOR_SYS_OBJECT_ID "1.3.6.1.4.1.8691.600.1.4.2"
+#define ACT_SIMULATOR_FIRMWARE_VERSION "v2.2.2"
+
+namespace act {
+namespace simulator {
+
+/**
+ * @brief The topology of the generated fleet
+ *
+ */
+enum class ActSimulatorTopologyEnum { kLine = 1, kRing = 2, kTree = 3 };
+
+/**
+ * @brief The QMap for simulator topology enum mapping
+ *
+ */
+static const QMap<QString, ActSimulatorTopologyEnum> kActSimulatorTopologyEnumMap = {
+    {"Line", ActSimulatorTopologyEnum::kLine},
+    {"Ring", ActSimulatorTopologyEnum::kRing},
+    {"Tree", ActSimulatorTopologyEnum::kTree}};
+
+/**
+ * @brief The LLDP neighbor of the simulated device's port
+ *
+ */
+class ActSimulatedNeighbor : public QSerializer {
+  Q_GADGET
+  QS_SERIALIZABLE
+
+  ACT_JSON_FIELD(quint16, local_port, LocalPort);
+  ACT_JSON_FIELD(qint64, remote_device_id, RemoteDeviceId);
+  ACT_JSON_FIELD(quint16, remote_port, RemotePort);
+
+ public:
+  ActSimulatedNeighbor() : local_port_(0), remote_device_id_(-1), remote_port_(0) {}
+
+  ActSimulatedNeighbor(const quint16 &local_port, const qint64 &remote_device_id, const quint16 &remote_port)
+      : local_port_(local_port), remote_device_id_(remote_device_id), remote_port_(remote_port) {}
+};
+
+/**
+ * @brief The extra SNMP object of the simulated device (e.g. the private MIB in the feature profile)
+ *
+ */
+class ActSimulatedOid : public QSerializer {
+  Q_GADGET
+  QS_SERIALIZABLE
+
+  ACT_JSON_FIELD(QString, oid, Oid);
+  ACT_JSON_FIELD(QString, type, Type);  ///< "Integer", "OctetString", "ObjectId", "IpAddress", "Counter32",
+                                        ///< "Gauge32", "TimeTicks", "Counter64"
+  ACT_JSON_FIELD(QString, value, Value);
+
+ public:
+  ActSimulatedOid() : type_("OctetString") {}
+
+  ActSimulatedOid(const QString &oid, const QString &type, const QString &value)
+      : oid_(oid), type_(type), value_(value) {}
+};
+
+/**
+ * @brief The simulated device
+ *
+ */
+class ActSimulatedDevice : public QSerializer {
+  Q_GADGET
+  QS_SERIALIZABLE
+
+  ACT_JSON_FIELD(qint64, id, Id);
+  ACT_JSON_FIELD(QString, ip_address, IpAddress);
+  ACT_JSON_FIELD(QString, mac_address, MacAddress);
+  ACT_JSON_FIELD(QString, model_name, ModelName);
+  ACT_JSON_FIELD(QString, sys_object_id, SysObjectId);
+  ACT_JSON_FIELD(QString, device_name, DeviceName);
+  ACT_JSON_FIELD(QString, serial_number, SerialNumber);
+  ACT_JSON_FIELD(QString, firmware_version, FirmwareVersion);
+  ACT_JSON_FIELD(quint16, port_count, PortCount);
+  ACT_JSON_FIELD(quint32, latency, Latency);         ///< The response delay(ms)
+  ACT_JSON_FIELD(quint8, failure_rate, FailureRate);  ///< The percentage of the dropped requests
+  ACT_JSON_FIELD(bool, offline, Offline);             ///< The device does not answer SNMP & RESTful
+  ACT_JSON_COLLECTION_OBJECTS(QList, ActSimulatedNeighbor, neighbors, Neighbors);
+  ACT_JSON_COLLECTION_OBJECTS(QList, ActSimulatedOid, extra_oids, ExtraOids);
+  ACT_JSON_QT_DICT(QMap, QString, QString, restful_resources, RestfulResources);  ///< <path, JSON body>
+
+ public:
+  ActSimulatedDevice()
+      : id_(-1),
+        model_name_(ACT_SIMULATOR_MODEL_NAME),
+        sys_object_id_(ACT_SIMULATOR_SYS_OBJECT_ID),
+        firmware_version_(ACT_SIMULATOR_FIRMWARE_VERSION),
+        port_count_(ACT_SIMULATOR_PORT_COUNT),
+        latency_(0),
+        failure_rate_(0),
+        offline_(false) {}
+};
+
+/**
+ * @brief The simulator configuration
+ *
+ * Without the Devices the fleet is generated by DeviceCount & Topology, the Latency & FailureRate are the default of
+ * the generated devices.
+ *
+ */
+class ActSimulatorConfig : public QSerializer {
+  Q_GADGET
+  QS_SERIALIZABLE
+
+  ACT_JSON_FIELD(quint32, device_count, DeviceCount);
+  ACT_JSON_ENUM(ActSimulatorTopologyEnum, topology, Topology);
+  ACT_JSON_FIELD(QString, base_ip, BaseIp);
+  ACT_JSON_FIELD(quint16, port_count, PortCount);
+  ACT_JSON_FIELD(quint16, snmp_port, SnmpPort);
+  ACT_JSON_FIELD(quint16, restful_port, RestfulPort);
+  ACT_JSON_FIELD(QString, read_community, ReadCommunity);
+  ACT_JSON_FIELD(QString, write_community, WriteCommunity);
+  ACT_JSON_FIELD(QString, username, Username);
+  ACT_JSON_FIELD(QString, password, Password);
+  ACT_JSON_FIELD(quint32, latency, Latency);
+  ACT_JSON_FIELD(quint8, failure_rate, FailureRate);
+  ACT_JSON_FIELD(quint32, seed, Seed);  ///< The seed of the failure injection
+  ACT_JSON_COLLECTION_OBJECTS(QList, ActSimulatedDevice, devices, Devices);
+
+ public:
+  ActSimulatorConfig()
+      : device_count_(0),
+        topology_(ActSimulatorTopologyEnum::kLine),
+        base_ip_(ACT_SIMULATOR_BASE_IP),
+        port_count_(ACT_SIMULATOR_PORT_COUNT),
+        snmp_port_(ACT_SIMULATOR_SNMP_PORT),
+        restful_port_(ACT_SIMULATOR_RESTFUL_PORT),
+        read_community_("public"),
+        write_community_("private"),
+        username_("admin"),
+        password_("moxa"),
+        latency_(0),
+        failure_rate_(0),
+        seed_(1) {}
+};
+
+/**
+ * @brief Generate the fleet (the devices and the LLDP neighbors) by the configuration
+ *
+ * The configured devices are kept and their neighbors are completed in both directions. Without the configured
+ * devices DeviceCount devices are generated on the consecutive IPs from BaseIp and wired by the Topology.
+ *
+ * @param config
+ * @param devices
+ * @return ACT_STATUS
+ */
+ACT_STATUS GenerateSimulatedFleet(const ActSimulatorConfig &config, QList<ActSimulatedDevice> &devices);
+
+}  // namespace simulator
+}  // namespace act
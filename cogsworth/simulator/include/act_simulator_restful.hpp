@@ -0,0 +1,112 @@
+/* Copyright (C) MOXA Inc. All rights reserved.
+This software is distributed under the terms of the MOXA SOFTWARE NOTICE.
+See the file MOXA-SOFTWARE-NOTICE for details.
+*/
+
+#pragma once
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QMap>
+#include <QSet>
+#include <QString>
+
+#include "act_simulator_config.hpp"
+
+namespace act {
+namespace simulator {
+
+/**
+ * @brief The HTTP request received by the simulator
+ *
+ */
+struct ActHttpRequest {
+  QString method;
+  QString path;  ///< The target without the leading '/' and the query (e.g. "api/v1/auth/login")
+  QMap<QString, QString> query;    ///< <name, decoded value>
+  QMap<QString, QString> headers;  ///< <lower case name, value>
+  QByteArray body;
+};
+
+/**
+ * @brief Parse one HTTP/1.1 request from the connection buffer
+ *
+ * @param buffer
+ * @param request
+ * @return qint32 the consumed bytes, 0 if the request is incomplete, -1 if malformed
+ */
+qint32 ParseHttpRequest(const QByteArray &buffer, ActHttpRequest &request);
+
+/**
+ * @brief Build the HTTP/1.1 response (JSON body, keep-alive)
+ *
+ * @param status_code
+ * @param body
+ * @return QByteArray
+ */
+QByteArray BuildHttpResponse(const quint16 &status_code, const QByteArray &body);
+
+/**
+ * @brief The RESTful API of the simulated device (the API of the ActMoxaIEIClient)
+ *
+ * The resources are the JSON bodies keyed by the path, generated from the device for every GET of the client (the
+ * per-port tables follow the PortCount, the ports with a neighbor are linked up). The login returns the access token
+ * which is required by the other requests (401 without it, the client would login again). GET/PATCH "<path>/<key>"
+ * of an object resource reads/writes its member, PATCH "<path>?save" merges the body into the resource. The VLAN
+ * agent commands (add/delete VLANs, port PVID & type) update the stdvlan & mxvlan resources, so the deployed tables
+ * are read back; the other commands (POST) are accepted without effect.
+ *
+ */
+class ActRestfulDeviceSimulator {
+ public:
+  /**
+   * @brief Construct a new Act Restful Device Simulator object
+   *
+   * @param device
+   * @param username
+   * @param password
+   */
+  ActRestfulDeviceSimulator(const ActSimulatedDevice &device, const QString &username, const QString &password);
+
+  /**
+   * @brief Handle the request
+   *
+   * @param request
+   * @param response_body
+   * @return quint16 the HTTP status code
+   */
+  quint16 HandleRequest(const ActHttpRequest &request, QByteArray &response_body);
+
+ private:
+  QMap<QString, QByteArray> resources_;
+  QSet<QString> tokens_;
+  QString username_;
+  QString password_;
+  QString token_prefix_;
+  quint64 token_sequence_;
+  QElapsedTimer uptime_;
+
+  bool IsAuthorized(const ActHttpRequest &request) const;
+
+  void BuildResources(const ActSimulatedDevice &device);
+
+  /**
+   * @brief Read the resource, or the member of the parent object resource
+   *
+   * @param path
+   * @param body
+   * @return true if found
+   */
+  bool ReadResource(const QString &path, QByteArray &body) const;
+
+  /**
+   * @brief Handle the VLAN agent commands & the VLAN table patch
+   *
+   * @param request
+   * @return quint16 the HTTP status code, 0 if not a VLAN command
+   */
+  quint16 HandleVlanCommand(const ActHttpRequest &request);
+};
+
+}  // namespace simulator
+}  // namespace act
@@ -0,0 +1,237 @@
+/* Copyright (C) MOXA Inc. All rights reserved.
+This software is distributed under the terms of the MOXA SOFTWARE NOTICE.
+See the file MOXA-SOFTWARE-NOTICE for details.
+*/
+
+#pragma once
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QList>
+#include <QMap>
+#include <QString>
+#include <QVector>
+
+#include "act_simulator_config.hpp"
+
+namespace act {
+namespace simulator {
+
+/**
+ * @brief The SNMP object identifier, the QVector comparison is the lexicographic order of the MIB
+ *
+ */
+using ActSnmpOid = QVector<quint32>;
+
+/**
+ * @brief The BER type of the SNMP value
+ *
+ */
+enum class ActSnmpTypeEnum : quint8 {
+  kInteger = 0x02,
+  kOctetString = 0x04,
+  kNull = 0x05,
+  kObjectId = 0x06,
+  kIpAddress = 0x40,
+  kCounter32 = 0x41,
+  kGauge32 = 0x42,
+  kTimeTicks = 0x43,
+  kCounter64 = 0x46,
+  kNoSuchObject = 0x80,
+  kNoSuchInstance = 0x81,
+  kEndOfMibView = 0x82
+};
+
+/**
+ * @brief The QMap for the SNMP type enum mapping (the Type of the ActSimulatedOid)
+ *
+ */
+static const QMap<QString, ActSnmpTypeEnum> kActSnmpTypeEnumMap = {
+    {"Integer", ActSnmpTypeEnum::kInteger},     {"OctetString", ActSnmpTypeEnum::kOctetString},
+    {"ObjectId", ActSnmpTypeEnum::kObjectId},   {"IpAddress", ActSnmpTypeEnum::kIpAddress},
+    {"Counter32", ActSnmpTypeEnum::kCounter32}, {"Gauge32", ActSnmpTypeEnum::kGauge32},
+    {"TimeTicks", ActSnmpTypeEnum::kTimeTicks}, {"Counter64", ActSnmpTypeEnum::kCounter64}};
+
+/**
+ * @brief The SNMP PDU type enum class
+ *
+ */
+enum class ActSnmpPduTypeEnum : quint8 {
+  kGetRequest = 0xA0,
+  kGetNextRequest = 0xA1,
+  kGetResponse = 0xA2,
+  kSetRequest = 0xA3,
+  kGetBulkRequest = 0xA5
+};
+
+/**
+ * @brief The SNMP version enum class (the value on the wire)
+ *
+ */
+enum class ActSnmpWireVersionEnum { kV1 = 0, kV2c = 1 };
+
+/**
+ * @brief The SNMP error status enum class
+ *
+ */
+enum class ActSnmpErrorStatusEnum { kNoError = 0, kTooBig = 1, kNoSuchName = 2, kBadValue = 3, kNotWritable = 17 };
+
+/**
+ * @brief The SNMP value (the BER type and the encoded content)
+ *
+ */
+struct ActSnmpValue {
+  ActSnmpTypeEnum type = ActSnmpTypeEnum::kNull;
+  QByteArray content;
+
+  static ActSnmpValue Integer(const qint64 &value);
+  static ActSnmpValue Unsigned(const ActSnmpTypeEnum &type, const quint64 &value);
+  static ActSnmpValue OctetString(const QByteArray &value);
+  static ActSnmpValue ObjectId(const ActSnmpOid &value);
+  static ActSnmpValue IpAddress(const QString &value);
+  static ActSnmpValue Exception(const ActSnmpTypeEnum &type);
+
+  /**
+   * @brief Generate the value by the type name & the text (the ActSimulatedOid)
+   *
+   * @param type_name
+   * @param text
+   * @param value
+   * @return true if success
+   */
+  static bool FromText(const QString &type_name, const QString &text, ActSnmpValue &value);
+
+  qint64 ToInteger() const;
+};
+
+/**
+ * @brief The SNMP variable binding
+ *
+ */
+struct ActSnmpVarBind {
+  ActSnmpOid oid;
+  ActSnmpValue value;
+};
+
+/**
+ * @brief The SNMP v1/v2c message
+ *
+ * For the GetBulkRequest the error_status is the non-repeaters and the error_index is the max-repetitions.
+ *
+ */
+struct ActSnmpMessage {
+  qint64 version = 0;
+  QByteArray community;
+  ActSnmpPduTypeEnum pdu_type = ActSnmpPduTypeEnum::kGetRequest;
+  qint64 request_id = 0;
+  qint64 error_status = 0;
+  qint64 error_index = 0;
+  QList<ActSnmpVarBind> var_binds;
+};
+
+/**
+ * @brief Parse the dotted OID string (e.g. "1.3.6.1.2.1.1.1.0", the leading dot is allowed)
+ *
+ * @param text
+ * @param oid
+ * @return true if success
+ */
+bool ParseSnmpOid(const QString &text, ActSnmpOid &oid);
+
+/**
+ * @brief Convert the OID to the dotted string
+ *
+ * @param oid
+ * @return QString
+ */
+QString SnmpOidToString(const ActSnmpOid &oid);
+
+/**
+ * @brief Decode the SNMP message from the datagram
+ *
+ * @param datagram
+ * @param message
+ * @return true if success, false if the datagram is malformed or not v1/v2c
+ */
+bool DecodeSnmpMessage(const QByteArray &datagram, ActSnmpMessage &message);
+
+/**
+ * @brief Encode the SNMP message to the datagram
+ *
+ * @param message
+ * @return QByteArray
+ */
+QByteArray EncodeSnmpMessage(const ActSnmpMessage &message);
+
+/**
+ * @brief The SNMP agent of the simulated device
+ *
+ * The MIB is generated from the device and the fleet: system, interfaces(ifTable/ifXTable), ipAddrTable, bridge
+ * address, Q-BRIDGE (dot1qBase, the FDB of the neighbors, VLAN 1 and the PVIDs) and LLDP (local & remote tables),
+ * plus the device's ExtraOids. The sysUpTime is answered by the agent's lifetime.
+ *
+ * The Set only writes the existing objects, except the rows of the Q-BRIDGE creatable tables (VLAN static, static
+ * unicast & multicast), which are created by the Set and destroyed by their RowStatus destroy(6) or Status invalid(2).
+ *
+ */
+class ActSnmpAgentSimulator {
+ public:
+  /**
+   * @brief Construct a new Act Snmp Agent Simulator object
+   *
+   * @param device
+   * @param fleet all simulated devices <id, device> (for the LLDP remote tables)
+   * @param read_community
+   * @param write_community
+   */
+  ActSnmpAgentSimulator(const ActSimulatedDevice &device, const QMap<qint64, ActSimulatedDevice> &fleet,
+                        const QString &read_community, const QString &write_community);
+
+  /**
+   * @brief Handle the request datagram
+   *
+   * @param request
+   * @param response
+   * @return true if should be replied, false if dropped (malformed or wrong community)
+   */
+  bool HandleRequest(const QByteArray &request, QByteArray &response);
+
+  /**
+   * @brief Get the objects of the MIB
+   *
+   * @return const QMap<ActSnmpOid, ActSnmpValue>&
+   */
+  const QMap<ActSnmpOid, ActSnmpValue> &GetObjects() const { return objects_; }
+
+ private:
+  QMap<ActSnmpOid, ActSnmpValue> objects_;
+  QByteArray read_community_;
+  QByteArray write_community_;
+  QElapsedTimer uptime_;
+
+  void BuildMib(const ActSimulatedDevice &device, const QMap<qint64, ActSimulatedDevice> &fleet);
+
+  void Insert(const QString &oid, const ActSnmpValue &value);
+
+  /**
+   * @brief Whether the object is a column of the creatable Q-BRIDGE rows
+   *
+   * @param oid
+   * @return true if creatable
+   */
+  static bool IsCreatable(const ActSnmpOid &oid);
+
+  /**
+   * @brief Write the object, handle the RowStatus/Status of the creatable rows
+   *
+   * @param var_bind
+   */
+  void Set(const ActSnmpVarBind &var_bind);
+
+  ActSnmpValue Get(const ActSnmpOid &oid) const;
+
+  bool GetNext(const ActSnmpOid &oid, ActSnmpVarBind &var_bind) const;
+};
+
+}  // namespace simulator
+}  // namespace act
@@ -0,0 +1,104 @@
+/* Copyright (C) MOXA Inc. All rights reserved.
+This software is distributed under the terms of the MOXA SOFTWARE NOTICE.
+See the file MOXA-SOFTWARE-NOTICE for details.
+*/
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+
+#include "act_device_simulator.hpp"
+
+/**
+ * @brief The device fleet simulator for the load & integration testing
+ *
+ * e.g. act_device_simulator --count 500 --topology Ring --latency 20 --failure-rate 1 --export fleet.json
+ *
+ */
+int main(int argc, char *argv[]) {
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setApplicationName("act_device_simulator");
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription("Simulate a fleet of devices (SNMP agent & RESTful API) on the loopback IPs");
+  parser.addHelpOption();
+  parser.addOptions({
+      {"config", "The simulator configuration (JSON).", "file"},
+      {"count", "The generated device count.", "count"},
+      {"topology", "The generated topology (Line, Ring, Tree).", "topology"},
+      {"base-ip", "The IP of the first device.", "ip"},
+      {"snmp-port", "The SNMP port.", "port"},
+      {"restful-port", "The RESTful(HTTP) port.", "port"},
+      {"latency", "The response delay(ms).", "ms"},
+      {"failure-rate", "The percentage of the dropped requests.", "percent"},
+      {"seed", "The seed of the failure injection.", "seed"},
+      {"export", "Export the generated devices (JSON).", "file"},
+  });
+  parser.process(app);
+
+  act::simulator::ActSimulatorConfig config;
+  if (parser.isSet("config")) {
+    QFile file(parser.value("config"));
+    if (!file.open(QIODevice::ReadOnly)) {
+      qCritical() << "Open" << file.fileName() << "failed:" << file.errorString();
+      return 1;
+    }
+    config.FromString(QString::fromUtf8(file.readAll()));
+  }
+  if (parser.isSet("count")) {
+    config.SetDeviceCount(parser.value("count").toUInt());
+  }
+  if (parser.isSet("topology")) {
+    if (!act::simulator::kActSimulatorTopologyEnumMap.contains(parser.value("topology"))) {
+      qCritical() << "Unknown topology:" << parser.value("topology");
+      return 1;
+    }
+    config.SetTopology(act::simulator::kActSimulatorTopologyEnumMap.value(parser.value("topology")));
+  }
+  if (parser.isSet("base-ip")) {
+    config.SetBaseIp(parser.value("base-ip"));
+  }
+  if (parser.isSet("snmp-port")) {
+    config.SetSnmpPort(static_cast<quint16>(parser.value("snmp-port").toUInt()));
+  }
+  if (parser.isSet("restful-port")) {
+    config.SetRestfulPort(static_cast<quint16>(parser.value("restful-port").toUInt()));
+  }
+  if (parser.isSet("latency")) {
+    config.SetLatency(parser.value("latency").toUInt());
+  }
+  if (parser.isSet("failure-rate")) {
+    config.SetFailureRate(static_cast<quint8>(qMin(parser.value("failure-rate").toUInt(), 100U)));
+  }
+  if (parser.isSet("seed")) {
+    config.SetSeed(parser.value("seed").toUInt());
+  }
+
+  act::simulator::ActDeviceSimulator simulator(config);
+  if (parser.isSet("export")) {
+    QJsonArray devices;
+    for (const auto &device : simulator.GetDevices()) {
+      devices.append(QJsonDocument::fromJson(device.ToString().toUtf8()).object());
+    }
+    QFile file(parser.value("export"));
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+      qCritical() << "Open" << file.fileName() << "failed:" << file.errorString();
+      return 1;
+    }
+    file.write(QJsonDocument(devices).toJson());
+  }
+
+  ACT_STATUS act_status = simulator.Start();
+  if (!IsActStatusSuccess(act_status)) {
+    qCritical() << "Start the simulator failed:" << act_status->GetErrorMessage();
+    return 1;
+  }
+
+  const int result = app.exec();
+  simulator.Stop();
+  qInfo() << "Statistics:" << simulator.GetStatistics().ToString().toStdString().c_str();
+  return result;
+}
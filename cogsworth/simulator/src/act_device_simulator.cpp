@@ -0,0 +1,204 @@
+/* Copyright (C) MOXA Inc. All rights reserved.
+This software is distributed under the terms of the MOXA SOFTWARE NOTICE.
+See the file MOXA-SOFTWARE-NOTICE for details.
+*/
+
+#include "act_device_simulator.hpp"
+
+#include <QDebug>
+#include <QHostAddress>
+#include <QNetworkDatagram>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QUdpSocket>
+#include <chrono>
+
+act::simulator::ActDeviceSimulator::ActDeviceSimulator(const ActSimulatorConfig &config)
+    : config_(config), event_loop_(nullptr), snmp_requests_(0), restful_requests_(0), dropped_requests_(0) {
+  auto act_status = GenerateSimulatedFleet(config_, devices_);
+  if (!IsActStatusSuccess(act_status)) {
+    qCritical() << __func__ << "GenerateSimulatedFleet() failed:" << act_status->GetErrorMessage();
+  }
+}
+
+act::simulator::ActDeviceSimulator::~ActDeviceSimulator() { Stop(); }
+
+act::simulator::ActSimulatorStatistics act::simulator::ActDeviceSimulator::GetStatistics() const {
+  ActSimulatorStatistics statistics;
+  statistics.SetSnmpRequests(snmp_requests_.load());
+  statistics.SetRestfulRequests(restful_requests_.load());
+  statistics.SetDroppedRequests(dropped_requests_.load());
+  return statistics;
+}
+
+ACT_STATUS act::simulator::ActDeviceSimulator::Start() {
+  ACT_STATUS_INIT();
+
+  if (thread_ != nullptr) {
+    qCritical() << __func__ << "Currently has the thread running.";
+    return std::make_shared<ActStatusInternalError>("Simulator");
+  }
+  if (devices_.isEmpty()) {
+    return std::make_shared<ActBadRequest>("No simulated device");
+  }
+
+  ACT_STATUS bind_status = ACT_STATUS_SUCCESS;
+  std::atomic<bool> ready(false);
+  thread_ = std::make_unique<std::thread>(&ActDeviceSimulator::Run, this, std::ref(bind_status), std::ref(ready));
+  while (!ready.load()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  if (!IsActStatusSuccess(bind_status)) {
+    Stop();
+    return bind_status;
+  }
+
+  qInfo() << __func__
+          << QString("Simulate %1 devices from %2 (SNMP port: %3, RESTful port: %4)")
+                 .arg(devices_.size())
+                 .arg(devices_.first().GetIpAddress())
+                 .arg(config_.GetSnmpPort())
+                 .arg(config_.GetRestfulPort())
+                 .toStdString()
+                 .c_str();
+  return act_status;
+}
+
+void act::simulator::ActDeviceSimulator::Stop() {
+  {
+    QMutexLocker lock(&event_loop_mutex_);
+    if (event_loop_ != nullptr) {
+      QMetaObject::invokeMethod(event_loop_, "quit", Qt::QueuedConnection);
+    }
+  }
+
+  if ((thread_ != nullptr) && thread_->joinable()) {
+    thread_->join();
+  }
+  thread_.reset();
+}
+
+bool act::simulator::ActDeviceSimulator::InjectFailure(const ActSimulatedDevice &device, QRandomGenerator &random) {
+  if ((device.GetFailureRate() == 0) || (random.bounded(100U) >= device.GetFailureRate())) {
+    return false;
+  }
+
+  dropped_requests_++;
+  return true;
+}
+
+void act::simulator::ActDeviceSimulator::Run(ACT_STATUS &bind_status, std::atomic<bool> &ready) {
+  QEventLoop event_loop;
+  QObject root;  // The parent of the sockets, destroyed after the event loop
+  QRandomGenerator random(config_.GetSeed());
+
+  auto bind_failed = [&bind_status](const QString &protocol, const QString &ip, const quint16 &port,
+                                    const QString &error) {
+    bind_status = std::make_shared<ActStatusBase>(ActStatusType::kFailed, ActSeverity::kCritical);
+    const QString message = QString("Simulator %1 bind %2:%3 failed: %4").arg(protocol).arg(ip).arg(port).arg(error);
+    bind_status->SetErrorMessage(message);
+  };
+
+  QMap<qint64, ActSimulatedDevice> fleet;
+  for (const auto &device : devices_) {
+    fleet.insert(device.GetId(), device);
+  }
+
+  for (const auto &device : devices_) {
+    if (device.GetOffline()) {
+      continue;
+    }
+    const QHostAddress address(device.GetIpAddress());
+
+    // SNMP agent
+    auto snmp_agent = std::make_shared<ActSnmpAgentSimulator>(device, fleet, config_.GetReadCommunity(),
+                                                              config_.GetWriteCommunity());
+    auto udp_socket = new QUdpSocket(&root);
+    if (!udp_socket->bind(address, config_.GetSnmpPort())) {
+      bind_failed("SNMP", device.GetIpAddress(), config_.GetSnmpPort(), udp_socket->errorString());
+      break;
+    }
+
+    auto handle_datagrams = [this, udp_socket, snmp_agent, device, &random]() {
+      while (udp_socket->hasPendingDatagrams()) {
+        const QNetworkDatagram datagram = udp_socket->receiveDatagram();
+        snmp_requests_++;
+        if (InjectFailure(device, random)) {
+          continue;  // no response, the client would time out
+        }
+
+        QByteArray response;
+        if (!snmp_agent->HandleRequest(datagram.data(), response)) {
+          continue;
+        }
+        const QHostAddress sender = datagram.senderAddress();
+        const quint16 sender_port = static_cast<quint16>(datagram.senderPort());
+        QTimer::singleShot(static_cast<int>(device.GetLatency()), udp_socket,
+                           [udp_socket, response, sender, sender_port]() {
+                             udp_socket->writeDatagram(response, sender, sender_port);
+                           });
+      }
+    };
+    QObject::connect(udp_socket, &QUdpSocket::readyRead, udp_socket, handle_datagrams);
+
+    // RESTful server
+    auto restful_device =
+        std::make_shared<ActRestfulDeviceSimulator>(device, config_.GetUsername(), config_.GetPassword());
+    auto tcp_server = new QTcpServer(&root);
+    if (!tcp_server->listen(address, config_.GetRestfulPort())) {
+      bind_failed("RESTful", device.GetIpAddress(), config_.GetRestfulPort(), tcp_server->errorString());
+      break;
+    }
+
+    auto handle_connections = [this, tcp_server, restful_device, device, &random]() {
+      while (QTcpSocket *socket = tcp_server->nextPendingConnection()) {
+        auto buffer = std::make_shared<QByteArray>();
+        auto handle_requests = [this, socket, buffer, restful_device, device, &random]() {
+          buffer->append(socket->readAll());
+          while (true) {
+            ActHttpRequest request;
+            const qint32 consumed = ParseHttpRequest(*buffer, request);
+            if (consumed < 0) {
+              socket->abort();
+              return;
+            }
+            if (consumed == 0) {
+              return;  // wait for the rest of the request
+            }
+            buffer->remove(0, consumed);
+            restful_requests_++;
+
+            QByteArray body;
+            const quint16 status_code =
+                InjectFailure(device, random) ? 503 : restful_device->HandleRequest(request, body);
+            const QByteArray response = BuildHttpResponse(status_code, body);
+            QTimer::singleShot(static_cast<int>(device.GetLatency()), socket,
+                               [socket, response]() { socket->write(response); });
+          }
+        };
+        QObject::connect(socket, &QTcpSocket::readyRead, socket, handle_requests);
+        QObject::connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+      }
+    };
+    QObject::connect(tcp_server, &QTcpServer::newConnection, tcp_server, handle_connections);
+  }
+
+  if (!IsActStatusSuccess(bind_status)) {
+    qCritical() << __func__ << bind_status->GetErrorMessage().toStdString().c_str();
+    ready.store(true);
+    return;
+  }
+
+  {
+    QMutexLocker lock(&event_loop_mutex_);
+    event_loop_ = &event_loop;
+  }
+  ready.store(true);
+
+  event_loop.exec();
+
+  QMutexLocker lock(&event_loop_mutex_);
+  event_loop_ = nullptr;
+}
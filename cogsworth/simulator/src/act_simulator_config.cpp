@@ -0,0 +1,136 @@
+/* Copyright (C) MOXA Inc. All rights reserved.
+This software is distributed under the terms of the MOXA SOFTWARE NOTICE.
+See the file MOXA-SOFTWARE-NOTICE for details.
+*/
+
+#include "act_simulator_config.hpp"
+
+#include <QHostAddress>
+
+namespace {
+
+using act::simulator::ActSimulatedDevice;
+using act::simulator::ActSimulatedNeighbor;
+
+/**
+ * @brief Connect the ports of two devices (both directions)
+ *
+ */
+void Connect(ActSimulatedDevice &device, const quint16 &port, ActSimulatedDevice &remote_device,
+             const quint16 &remote_port) {
+  device.GetNeighbors().append(ActSimulatedNeighbor(port, remote_device.GetId(), remote_port));
+  remote_device.GetNeighbors().append(ActSimulatedNeighbor(remote_port, device.GetId(), port));
+}
+
+bool HasNeighbor(const ActSimulatedDevice &device, const quint16 &local_port) {
+  for (const auto &neighbor : device.GetNeighbors()) {
+    if (neighbor.GetLocalPort() == local_port) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+ACT_STATUS act::simulator::GenerateSimulatedFleet(const ActSimulatorConfig &config,
+                                                  QList<ActSimulatedDevice> &devices) {
+  ACT_STATUS_INIT();
+
+  devices.clear();
+
+  // The configured devices, complete the neighbors in both directions
+  if (!config.GetDevices().isEmpty()) {
+    devices = config.GetDevices();
+
+    QMap<qint64, qint32> index_of_id;
+    for (qint32 i = 0; i < devices.size(); i++) {
+      if (QHostAddress(devices[i].GetIpAddress()).protocol() != QAbstractSocket::IPv4Protocol) {
+        const QString message = QString("Invalid simulated device IP: %1").arg(devices[i].GetIpAddress());
+        return std::make_shared<ActBadRequest>(message);
+      }
+      index_of_id.insert(devices[i].GetId(), i);
+    }
+
+    for (qint32 i = 0; i < devices.size(); i++) {
+      const QList<ActSimulatedNeighbor> neighbors = devices[i].GetNeighbors();
+      for (const auto &neighbor : neighbors) {
+        if (!index_of_id.contains(neighbor.GetRemoteDeviceId())) {
+          const QString message = QString("Simulated device %1 has an unknown neighbor %2")
+                                      .arg(devices[i].GetId())
+                                      .arg(neighbor.GetRemoteDeviceId());
+          return std::make_shared<ActBadRequest>(message);
+        }
+
+        auto &remote_device = devices[index_of_id[neighbor.GetRemoteDeviceId()]];
+        if (!HasNeighbor(remote_device, neighbor.GetRemotePort())) {
+          remote_device.GetNeighbors().append(
+              ActSimulatedNeighbor(neighbor.GetRemotePort(), devices[i].GetId(), neighbor.GetLocalPort()));
+        }
+      }
+    }
+    return act_status;
+  }
+
+  // Generate the devices on the consecutive IPs
+  if (config.GetDeviceCount() == 0) {
+    return std::make_shared<ActBadRequest>("The simulated device count should be greater than 0");
+  }
+  if (config.GetPortCount() < 2) {
+    return std::make_shared<ActBadRequest>("The simulated device should have at least 2 ports");
+  }
+  const QHostAddress base_ip(config.GetBaseIp());
+  if (base_ip.protocol() != QAbstractSocket::IPv4Protocol) {
+    return std::make_shared<ActBadRequest>(QString("Invalid simulator base IP: %1").arg(config.GetBaseIp()));
+  }
+  const quint32 base_ip_num = base_ip.toIPv4Address();
+  const quint64 last_ip_num = static_cast<quint64>(base_ip_num) + config.GetDeviceCount() - 1;
+  if ((last_ip_num >> 24) != (base_ip_num >> 24)) {
+    return std::make_shared<ActBadRequest>("The simulated device count exceeds the IP range");
+  }
+
+  for (quint32 i = 0; i < config.GetDeviceCount(); i++) {
+    const qint64 id = static_cast<qint64>(i) + 1;
+    ActSimulatedDevice device;
+    device.SetId(id);
+    device.SetIpAddress(QHostAddress(base_ip_num + i).toString());
+    device.SetMacAddress(QString("%1:%2:%3:%4")
+                             .arg(ACT_SIMULATOR_MAC_PREFIX)
+                             .arg((id >> 16) & 0xFF, 2, 16, QLatin1Char('0'))
+                             .arg((id >> 8) & 0xFF, 2, 16, QLatin1Char('0'))
+                             .arg(id & 0xFF, 2, 16, QLatin1Char('0'))
+                             .toUpper());
+    device.SetDeviceName(QString("Device-%1").arg(id, 3, 10, QLatin1Char('0')));
+    device.SetSerialNumber(QString("SIM%1").arg(id, 8, 10, QLatin1Char('0')));
+    device.SetPortCount(config.GetPortCount());
+    device.SetLatency(config.GetLatency());
+    device.SetFailureRate(config.GetFailureRate());
+    devices.append(device);
+  }
+
+  // Wire the devices by the topology
+  switch (config.GetTopology()) {
+    case ActSimulatorTopologyEnum::kLine:
+    case ActSimulatorTopologyEnum::kRing:
+      // Port 2 of the device connects to port 1 of the next device
+      for (qint32 i = 0; i + 1 < devices.size(); i++) {
+        Connect(devices[i], 2, devices[i + 1], 1);
+      }
+      if ((config.GetTopology() == ActSimulatorTopologyEnum::kRing) && (devices.size() > 2)) {
+        Connect(devices.last(), 2, devices.first(), 1);
+      }
+      break;
+    case ActSimulatorTopologyEnum::kTree: {
+      // Port 1 is the uplink, the other ports connect to the children
+      const qint32 fanout = config.GetPortCount() - 1;
+      for (qint32 i = 1; i < devices.size(); i++) {
+        const qint32 parent = (i - 1) / fanout;
+        const quint16 parent_port = static_cast<quint16>(2 + (i - 1) % fanout);
+        Connect(devices[parent], parent_port, devices[i], 1);
+      }
+      break;
+    }
+  }
+
+  return act_status;
+}
@@ -0,0 +1,627 @@
+/* Copyright (C) MOXA Inc. All rights reserved.
+This software is distributed under the terms of the MOXA SOFTWARE NOTICE.
+See the file MOXA-SOFTWARE-NOTICE for details.
+*/
+
+#include "act_simulator_restful.hpp"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSet>
+#include <QUrl>
+#include <functional>
+
+#define ACT_SIMULATOR_HTTP_MAX_REQUEST (4 * 1024 * 1024)  ///< The maximum size(bytes) of the request
+
+namespace {
+
+const QByteArray kHeaderEnd("\r\n\r\n");
+
+QByteArray JsonString(const QString &value) {
+  // QJsonDocument only serializes the object/array, wrap and strip
+  QJsonObject object;
+  object.insert("v", value);
+  QByteArray json = QJsonDocument(object).toJson(QJsonDocument::Compact);
+  return json.mid(5, json.size() - 6);  // {"v":"..."} -> "..."
+}
+
+QByteArray Json(const QJsonObject &object) { return QJsonDocument(object).toJson(QJsonDocument::Compact); }
+
+/**
+ * @brief Generate the per-port table (index 0 is the port 1)
+ *
+ */
+QJsonArray PortTable(const quint16 &port_count, const std::function<QJsonObject(const quint16 &port)> &entry) {
+  QJsonArray table;
+  for (quint16 port = 1; port <= port_count; port++) {
+    table.append(entry(port));
+  }
+  return table;
+}
+
+QJsonArray PortBitmap(const quint16 &port_count, const bool &member) {
+  QJsonArray bitmap;
+  for (quint16 port = 1; port <= port_count; port++) {
+    bitmap.append(member);
+  }
+  return bitmap;
+}
+
+QJsonObject PtpPortDS(const quint16 &) {
+  return QJsonObject{{"enable", true},          {"announceInterval", 0},   {"announceReceiptTimeout", 3},
+                     {"syncInterval", 0},       {"syncReceiptTimeout", 3}, {"delayReqInterval", 0},
+                     {"pdelayReqInterval", 0},  {"neighborPropDelayThresh", 800}};
+}
+
+QJsonObject PtpSetting(const quint16 &port_count) {
+  return QJsonObject{{"clockType", 1},       {"delayMechanism", 2},      {"transportType", 1},
+                     {"priority1", 246},     {"priority2", 248},         {"domainNumber", 0},
+                     {"twoStepFlag", true},  {"accuracyAlert", 1000},    {"maximumStepsRemoved", 255},
+                     {"clockClass", 248},    {"clockAccuracy", 254},     {"grandmasterId", 255},
+                     {"portDS", PortTable(port_count, PtpPortDS)}};
+}
+
+QByteArray ReasonPhrase(const quint16 &status_code) {
+  switch (status_code) {
+    case 200:
+      return "OK";
+    case 400:
+      return "Bad Request";
+    case 401:
+      return "Unauthorized";
+    case 404:
+      return "Not Found";
+    case 503:
+      return "Service Unavailable";
+    default:
+      return "Unknown";
+  }
+}
+
+}  // namespace
+
+qint32 act::simulator::ParseHttpRequest(const QByteArray &buffer, ActHttpRequest &request) {
+  const qint32 header_end = buffer.indexOf(kHeaderEnd);
+  if (header_end < 0) {
+    return (buffer.size() > ACT_SIMULATOR_HTTP_MAX_REQUEST) ? -1 : 0;
+  }
+
+  const QList<QByteArray> lines = buffer.left(header_end).split('\n');
+  const QList<QByteArray> request_line = lines.first().trimmed().split(' ');
+  if (request_line.size() < 2) {
+    return -1;
+  }
+
+  request.method = QString::fromLatin1(request_line.at(0));
+  QString target = QString::fromUtf8(request_line.at(1));
+  request.query.clear();
+  const qint32 query_index = target.indexOf('?');
+  if (query_index >= 0) {
+    // The southbound may repeat the '?' (e.g. "vlanTable?save&ifindices=1")
+    for (const auto &item : target.mid(query_index + 1).replace('?', '&').split('&', Qt::SkipEmptyParts)) {
+      const qint32 equal = item.indexOf('=');
+      request.query.insert(QUrl::fromPercentEncoding(item.left(equal).toUtf8()),
+                           (equal < 0) ? QString() : QUrl::fromPercentEncoding(item.mid(equal + 1).toUtf8()));
+    }
+    target.truncate(query_index);
+  }
+  while (target.startsWith('/')) {
+    target.remove(0, 1);
+  }
+  request.path = target;
+
+  request.headers.clear();
+  for (qint32 i = 1; i < lines.size(); i++) {
+    const qint32 colon = lines.at(i).indexOf(':');
+    if (colon <= 0) {
+      continue;
+    }
+    request.headers.insert(QString::fromLatin1(lines.at(i).left(colon)).trimmed().toLower(),
+                           QString::fromUtf8(lines.at(i).mid(colon + 1)).trimmed());
+  }
+
+  bool ok = true;
+  const qint32 content_length = request.headers.value("content-length", "0").toInt(&ok);
+  if (!ok || (content_length < 0) || (content_length > ACT_SIMULATOR_HTTP_MAX_REQUEST)) {
+    return -1;
+  }
+
+  const qint32 body_begin = header_end + kHeaderEnd.size();
+  if (buffer.size() < body_begin + content_length) {
+    return 0;
+  }
+  request.body = buffer.mid(body_begin, content_length);
+  return body_begin + content_length;
+}
+
+QByteArray act::simulator::BuildHttpResponse(const quint16 &status_code, const QByteArray &body) {
+  QByteArray response;
+  response.append("HTTP/1.1 ").append(QByteArray::number(status_code)).append(' ').append(ReasonPhrase(status_code));
+  response.append("\r\nContent-Type: application/json\r\nConnection: keep-alive\r\nContent-Length: ");
+  response.append(QByteArray::number(body.size())).append(kHeaderEnd);
+  response.append(body);
+  return response;
+}
+
+act::simulator::ActRestfulDeviceSimulator::ActRestfulDeviceSimulator(const ActSimulatedDevice &device,
+                                                                     const QString &username, const QString &password)
+    : username_(username),
+      password_(password),
+      token_prefix_(QString("sim-%1-").arg(device.GetId())),
+      token_sequence_(0) {
+  uptime_.start();
+  BuildResources(device);
+
+  // The configured resources override the default
+  for (auto it = device.GetRestfulResources().constBegin(); it != device.GetRestfulResources().constEnd(); it++) {
+    resources_.insert(it.key(), it.value().toUtf8());
+  }
+}
+
+void act::simulator::ActRestfulDeviceSimulator::BuildResources(const ActSimulatedDevice &device) {
+  const quint16 port_count = device.GetPortCount();
+  QSet<quint16> linked_ports;
+  for (const auto &neighbor : device.GetNeighbors()) {
+    linked_ports.insert(neighbor.GetLocalPort());
+  }
+  const QJsonObject system_setting{{"deviceName", device.GetDeviceName()},
+                                   {"deviceLocation", ""},
+                                   {"deviceDescription", ""},
+                                   {"contactInformation", ""}};
+  QJsonObject system_status(system_setting);
+  system_status.insert("serialNumber", device.GetSerialNumber());
+  system_status.insert("productRevision", device.GetFirmwareVersion());
+  const QString clock_identity = QString(device.GetMacAddress()).remove(':').insert(6, "FFFE");
+
+  // The strings are the JSON strings ("abc"), the members of the object resources are read by their own paths as well
+  // (e.g. "api/v1/status/systemInformation/serialNumber")
+  resources_.insert("static/modelName", JsonString(device.GetModelName()));
+  resources_.insert("static/loginMessage", JsonString(""));
+  resources_.insert("api/v1/status/managementIp/ipv4", Json({{"netmask", "255.255.255.0"}, {"gateway", ""}}));
+  resources_.insert("api/v1/setting/data/temstid/temstidTable", "[]");
+  resources_.insert("api/v1/status/SyncInvalid", R"({"vlan":false,"streamid":false,"frer":false,"qbv":false})");
+
+  // System
+  resources_.insert("api/v1/status/systemInformation", Json(system_status));
+  resources_.insert("api/v1/setting/data/systemInformation", Json(system_setting));
+  resources_.insert(
+      "api/v1/status/systemInformation/modules",
+      Json({{"ethernet", QJsonArray{QJsonObject{{"moduleName", device.GetModelName()},
+                                                {"serialNumber", device.GetSerialNumber()},
+                                                {"productRevision", device.GetFirmwareVersion()},
+                                                {"status", "OK"},
+                                                {"moduleId", 1}}}},
+            {"power", QJsonArray{QJsonObject{{"moduleName", "PWR-1"}, {"status", "OK"}},
+                                 QJsonObject{{"moduleName", "PWR-2"}, {"status", "OK"}}}}}));
+  resources_.insert("api/v1/status/systemUtilization", Json({{"cpuUtilization", 5.0},
+                                                             {"memorySize", 536870912},
+                                                             {"memoryUtilization", 30.0},
+                                                             {"powerConsumption", 10}}));
+  resources_.insert("api/v1/status/time",
+                    Json({{"year", 2024}, {"month", 1}, {"date", 1}, {"hour", 0}, {"minute", 0}}));
+  resources_.insert("api/v1/status/logEntry", Json({{"totalnum", 0}, {"totalDebugNum", 0}, {"entries", QJsonArray()}}));
+
+  // Management
+  resources_.insert("api/v1/setting/data/managementIp/ipv4", Json({{"networkSettingMode", "Manual"},
+                                                                   {"ipAddress", device.GetIpAddress()},
+                                                                   {"netmask", "255.255.255.0"},
+                                                                   {"gateway", ""},
+                                                                   {"dnsServer", QJsonArray()}}));
+  resources_.insert("api/v1/status/l3RouterId/ipv4",
+                    Json({{"ipAddress", device.GetIpAddress()}, {"netmask", "255.255.255.0"}}));
+  resources_.insert("api/v1/setting/data/networkDns/ipv4", Json({{"dnsServer", QJsonArray()}}));
+  resources_.insert("api/v1/setting/data/uiServiceManagement",
+                    Json({{"encryptedMoxaService", QJsonObject{{"enable", true}}},
+                          {"httpService", QJsonObject{{"enable", true}, {"port", 80}}},
+                          {"httpsService", QJsonObject{{"enable", true}, {"port", 443}}},
+                          {"snmpService", QJsonObject{{"mode", 1}, {"port", 161}, {"transportLayerProtocol", 1}}},
+                          {"sshService", QJsonObject{{"enable", true}, {"port", 22}}},
+                          {"telnetService", QJsonObject{{"enable", true}, {"port", 23}}},
+                          {"httpMaxLoginSessions", 5},
+                          {"terminalMaxLoginSessions", 1}}));
+  resources_.insert("api/v1/setting/data/userAccount",
+                    Json({{username_, QJsonObject{{"active", true},
+                                                  {"userName", username_},
+                                                  {"password", ""},
+                                                  {"role", "admin"},
+                                                  {"email", ""}}}}));
+  resources_.insert("api/v1/setting/data/loginPolicy", Json({{"webLoginMessage", ""},
+                                                             {"loginFailureMessage", ""},
+                                                             {"enableFailureLockout", false},
+                                                             {"retryFailureThreshold", 5},
+                                                             {"failureLockoutTime", 5},
+                                                             {"autoLogout", 5}}));
+  resources_.insert("api/v1/setting/data/snmpTrap", Json({{"host", QJsonArray()}}));
+  resources_.insert("api/v1/setting/data/syslogServer",
+                    Json({{"loggingEnable", false}, {"syslogFwdTable", QJsonArray()}}));
+  resources_.insert("api/v1/setting/data/time",
+                    Json({{"clockSource", "local"},
+                          {"timeZone", "UTC"},
+                          {"daylightSaving", QJsonObject{{"enable", false}}},
+                          {"ntp", QJsonObject{{"authenticationKey", QJsonArray()}, {"ntpClient", QJsonArray()}}},
+                          {"sntp", QJsonObject{{"sntpClient", QJsonArray()}}}}));
+  resources_.insert("api/v1/setting/data/mxlp", Json({{"loopProtectEnable", false}, {"detectInterval", 10}}));
+
+  // Ports
+  resources_.insert("api/v1/setting/data/ifmib",
+                    Json({{"portTable", PortTable(port_count, [](const quint16 &) {
+                             return QJsonObject{{"enable", true}};
+                           })}}));
+  resources_.insert("api/v1/status/portInfo",
+                    Json({{"portTable", PortTable(port_count, [&device](const quint16 &port) {
+                             return QJsonObject{{"name", QString::number(port)},
+                                                {"type", "1000TX,RJ45"},
+                                                {"speed", "1G"},
+                                                {"moduleSlot", 1},
+                                                {"modulePort", port},
+                                                {"exist", true},
+                                                {"sfpInserted", false},
+                                                {"physicalMacAddr", device.GetMacAddress()},
+                                                {"function", QJsonArray()},
+                                                {"medium", QJsonArray{"copper"}}};
+                           })}}));
+  resources_.insert("api/v1/status/portStatus",
+                    Json({{"portTable", PortTable(port_count, [&linked_ports](const quint16 &port) {
+                             const bool link_up = linked_ports.contains(port);
+                             return QJsonObject{{"mediaType", "1000TX,RJ45"},
+                                                {"portState", 1},
+                                                {"linkStatus", link_up ? 1 : 2},
+                                                {"operDuplex", link_up ? "full" : ""},
+                                                {"operSpeed", link_up ? "1G" : ""},
+                                                {"mdiOrMdixCap", "auto"}};
+                           })}}));
+  resources_.insert("api/v1/status/trafficStatistics",
+                    Json({{"portTable", PortTable(port_count, [](const quint16 &) {
+                             QJsonObject entry;
+                             for (const auto &counter : {"txTotalOctets", "txTotalPackets", "txUnicastPackets",
+                                                         "txMulticastPackets", "txBroadcastPackets", "rxTotalOctets",
+                                                         "rxTotalPackets", "rxUnicastPackets", "rxMulticastPackets",
+                                                         "rxBroadcastPackets", "crcAlignErrorPackets", "dropPackets",
+                                                         "undersizePackets", "oversizePackets"}) {
+                               entry.insert(counter, 0);
+                             }
+                             entry.insert("trafficUtilization",
+                                          QJsonObject{{"timestamp", QJsonArray()}, {"data", QJsonArray()}});
+                             return entry;
+                           })}}));
+  resources_.insert("api/v1/status/fiberCheckStatus/monitor", Json({{"portTable", QJsonArray()}}));
+
+  // Time sync
+  const QJsonObject ptp_status{
+      {"stepsRemoved", 0},
+      {"offsetFromMaster", "0"},
+      {"ptpClockTime",
+       QJsonObject{{"year", 2024}, {"month", 1}, {"day", 1}, {"hour", 0}, {"minute", 0}, {"second", 0}}},
+      {"syncLocked", false},
+      {"clockIdentity", clock_identity},
+      {"slavePort", ""},
+      {"meanPathDelay", "0"},
+      {"parentDS", QJsonObject{{"parentClockIdentity", clock_identity},
+                               {"parentPortNumber", 0},
+                               {"cumulativeRateRatio", 0.0},
+                               {"grandmasterIdentity", clock_identity},
+                               {"grandmasterClockClass", 248},
+                               {"grandmasterClockAccuracy", 254},
+                               {"grandmasterPriority1", 246},
+                               {"grandmasterPriority2", 248}}},
+      {"portDS", PortTable(port_count, [&clock_identity](const quint16 &port) {
+         return QJsonObject{{"neighborPropDelay", 0},
+                            {"portState", 6},  // master
+                            {"portRole", 6},
+                            {"asCapable", false},
+                            {"neighborRateRatio", 1.0},
+                            {"portIdentity", QString("%1-%2").arg(clock_identity).arg(port)}};
+       })}};
+  resources_.insert("api/v1/status/1588DefaultInfo", Json(ptp_status));
+  resources_.insert("api/v1/status/dot1asInfo", Json(ptp_status));
+  resources_.insert("api/v1/setting/data/mxptp",
+                    Json({{"enable", false}, {"portTable", PortTable(port_count, [](const quint16 &) {
+                                                return QJsonObject{{"profile", 0}};
+                                              })}}));
+  resources_.insert("api/v1/setting/data/stdot1as", Json(PtpSetting(port_count)));
+  resources_.insert("api/v1/setting/data/mx1588Default", Json(PtpSetting(port_count)));
+  resources_.insert("api/v1/setting/data/mx1588Iec61850", Json(PtpSetting(port_count)));
+  resources_.insert("api/v1/setting/data/mx1588C37238", Json(PtpSetting(port_count)));
+
+  // Redundancy
+  resources_.insert("api/v1/setting/data/mxL2Redundancy", Json({{"stprstp", true},
+                                                                {"turboringv2", false},
+                                                                {"turbochain", false},
+                                                                {"dualhoming", false},
+                                                                {"mstp", false},
+                                                                {"iec62439_2", false}}));
+  resources_.insert("api/v1/setting/data/std1w1ap",
+                    Json({{"spanningTreeVersion", 2},
+                          {"priority", 32768},
+                          {"maxAge", 20},
+                          {"helloTime", 2},
+                          {"forwardDelay", 15},
+                          {"rstpTxHoldCount", 6},
+                          {"portTable", PortTable(port_count, [](const quint16 &) {
+                             return QJsonObject{
+                                 {"forceEdge", false}, {"pathCost", 0}, {"portPriority", 128}, {"rstpEnable", true}};
+                           })}}));
+  resources_.insert("api/v1/setting/data/std1d1ap",
+                    Json({{"portTable", PortTable(port_count, [](const quint16 &) {
+                             return QJsonObject{{"bridgeLinkType", 1}};
+                           })}}));
+  resources_.insert("api/v1/setting/data/mxrstp",
+                    Json({{"rstpErrorRecoveryTime", 300},
+                          {"rstpConfigSwift", false},
+                          {"rstpConfigRevert", false},
+                          {"portTable", PortTable(port_count, [](const quint16 &) {
+                             return QJsonObject{{"autoEdge", true},
+                                                {"bpduGuard", false},
+                                                {"rootGuard", false},
+                                                {"loopGuard", false},
+                                                {"bpduFilter", false}};
+                           })}}));
+  resources_.insert("api/v1/status/rstpStatus",
+                    Json({{"designatedRoot", QString("32768/%1").arg(device.GetMacAddress())},
+                          {"forwardDelay", 15},
+                          {"helloTime", 2},
+                          {"maxAge", 20},
+                          {"rootCost", 0},
+                          {"portTable", PortTable(port_count, [&linked_ports](const quint16 &port) {
+                             const bool link_up = linked_ports.contains(port);
+                             return QJsonObject{{"bpduInconsistency", false},
+                                                {"designatedCost", 0},
+                                                {"edgePort", !link_up},
+                                                {"loopInconsistency", false},
+                                                {"operBridgeLinkType", true},
+                                                {"pathCost", 20000},
+                                                {"portState", link_up ? 4 : 1},  // forwarding / disabled
+                                                {"rootInconsistency", false},
+                                                {"rstpPortRole", link_up ? 3 : 0}};
+                           })}}));
+
+  // TSN, QoS & VLAN
+  resources_.insert("api/v1/setting/data/streamadapter",
+                    Json({{"portTable", PortTable(port_count, [](const quint16 &) {
+                             return QJsonObject{{"egressuntag", false}, {"ruleindex", QJsonArray()}};
+                           })}}));
+  resources_.insert("api/v1/setting/data/mxqos",
+                    Json({{"defaultPriorityTable", PortTable(port_count, [](const quint16 &) {
+                             return QJsonObject{{"defaultPriorityValue", 0}};
+                           })}}));
+  resources_.insert("api/v1/setting/data/stdvlan",
+                    Json({{"vlanTable",
+                           QJsonArray{QJsonObject{{"vid", 1},
+                                                  {"vlanName", "VLAN0001"},
+                                                  {"valid", true},
+                                                  {"egressPortsPbmp", PortBitmap(port_count, true)},
+                                                  {"forbiddenEgressPortsPbmp", PortBitmap(port_count, false)},
+                                                  {"untaggedPortsPbmp", PortBitmap(port_count, true)}}}},
+                          {"portTable", PortTable(port_count, [](const quint16 &) {
+                             return QJsonObject{{"pvid", 1},
+                                                {"acceptableFrameTypes", 1},
+                                                {"ingressFiltering", true},
+                                                {"portGvrpEnable", false},
+                                                {"restrictedVlanRegistration", false}};
+                           })}}));
+  resources_.insert("api/v1/setting/data/mxvlan",
+                    Json({{"mgmtVlan", "1"}, {"portTable", PortTable(port_count, [](const quint16 &) {
+                                               return QJsonObject{{"vlanPortType", 1},  // Access
+                                                                  {"filteringUtilityCriteria", 0}};
+                                             })}}));
+}
+
+bool act::simulator::ActRestfulDeviceSimulator::ReadResource(const QString &path, QByteArray &body) const {
+  auto it = resources_.constFind(path);
+  if (it != resources_.constEnd()) {
+    body = it.value();
+    return true;
+  }
+
+  // The member of the parent object (e.g. "api/v1/setting/data/std1w1ap/portTable")
+  const qint32 slash = path.lastIndexOf('/');
+  if (slash <= 0) {
+    return false;
+  }
+  QByteArray parent;
+  if (!ReadResource(path.left(slash), parent)) {
+    return false;
+  }
+  const QJsonObject object = QJsonDocument::fromJson(parent).object();
+  const QString key = path.mid(slash + 1);
+  if (!object.contains(key)) {
+    return false;
+  }
+
+  const QJsonValue value = object.value(key);
+  if (value.isObject()) {
+    body = QJsonDocument(value.toObject()).toJson(QJsonDocument::Compact);
+  } else if (value.isArray()) {
+    body = QJsonDocument(value.toArray()).toJson(QJsonDocument::Compact);
+  } else {
+    // The scalar is answered as the JSON string, the same as the other scalar resources
+    body = JsonString(value.isString() ? value.toString() : value.toVariant().toString());
+  }
+  return true;
+}
+
+quint16 act::simulator::ActRestfulDeviceSimulator::HandleVlanCommand(const ActHttpRequest &request) {
+  static const QString kStdVlan("api/v1/setting/data/stdvlan");
+  static const QString kMxVlan("api/v1/setting/data/mxvlan");
+
+  const bool add_vlans = (request.method == "POST") && (request.path == "api/v1/setting/agent/vlan/vlanIds");
+  const bool delete_vlans = (request.method == "DELETE") && (request.path == "api/v1/setting/agent/vlan/vlanIds");
+  const bool patch_vlans = (request.method == "PATCH") && (request.path == kStdVlan + "/vlanTable");
+  const bool port_configs = (request.method == "POST") && (request.path == "api/v1/setting/agent/vlan/portConfigs");
+  if (!add_vlans && !delete_vlans && !patch_vlans && !port_configs) {
+    return 0;
+  }
+
+  QJsonObject std_vlan = QJsonDocument::fromJson(resources_.value(kStdVlan)).object();
+  QJsonArray vlan_table = std_vlan.value("vlanTable").toArray();
+  auto find_vlan = [&vlan_table](const qint32 &vid) {
+    for (qint32 i = 0; i < vlan_table.size(); i++) {
+      if (vlan_table.at(i).toObject().value("vid").toInt() == vid) {
+        return i;
+      }
+    }
+    return -1;
+  };
+
+  if (delete_vlans) {
+    for (const auto &vid : request.query.value("vids").split(',', Qt::SkipEmptyParts)) {
+      const qint32 index = find_vlan(vid.toInt());
+      if (index >= 0) {
+        vlan_table.removeAt(index);
+      }
+    }
+  } else if (add_vlans || patch_vlans) {
+    // The entries are keyed by the vid, the patch replaces the existing entry
+    const QJsonDocument body = QJsonDocument::fromJson(request.body);
+    if (!body.isArray()) {
+      return 400;
+    }
+    for (const auto &value : body.array()) {
+      const qint32 index = find_vlan(value.toObject().value("vid").toInt());
+      if (index < 0) {
+        vlan_table.append(value);
+      } else if (patch_vlans) {
+        vlan_table.replace(index, value);
+      }
+    }
+  } else {
+    // The port config (PVID or VLAN port type) of the port indexes
+    const QJsonObject config = QJsonDocument::fromJson(request.body).object();
+    QJsonObject mx_vlan = QJsonDocument::fromJson(resources_.value(kMxVlan)).object();
+    QJsonArray std_port_table = std_vlan.value("portTable").toArray();
+    QJsonArray mx_port_table = mx_vlan.value("portTable").toArray();
+    for (const auto &index_text : request.query.value("ifindices").split(',', Qt::SkipEmptyParts)) {
+      const qint32 index = index_text.toInt();
+      if ((index < 0) || (index >= std_port_table.size()) || (index >= mx_port_table.size())) {
+        return 400;
+      }
+      if (config.contains("pvid")) {
+        QJsonObject entry = std_port_table.at(index).toObject();
+        entry.insert("pvid", config.value("pvid"));
+        std_port_table.replace(index, entry);
+      }
+      if (config.contains("vlanPortType")) {
+        QJsonObject entry = mx_port_table.at(index).toObject();
+        entry.insert("vlanPortType", config.value("vlanPortType"));
+        mx_port_table.replace(index, entry);
+      }
+    }
+    std_vlan.insert("portTable", std_port_table);
+    mx_vlan.insert("portTable", mx_port_table);
+    resources_.insert(kMxVlan, Json(mx_vlan));
+  }
+
+  std_vlan.insert("vlanTable", vlan_table);
+  resources_.insert(kStdVlan, Json(std_vlan));
+  return 200;
+}
+
+bool act::simulator::ActRestfulDeviceSimulator::IsAuthorized(const ActHttpRequest &request) const {
+  QString token = request.headers.value("authorization");
+  if (token.startsWith("Bearer ")) {
+    token.remove(0, 7);
+  }
+  return tokens_.contains(token);
+}
+
+quint16 act::simulator::ActRestfulDeviceSimulator::HandleRequest(const ActHttpRequest &request,
+                                                                  QByteArray &response_body) {
+  response_body.clear();
+
+  // Without the token
+  if (request.path.startsWith("static/")) {
+    if (request.method != "GET" || !resources_.contains(request.path)) {
+      return 404;
+    }
+    response_body = resources_[request.path];
+    return 200;
+  }
+  if ((request.method == "POST") && (request.path == "api/v1/auth/login")) {
+    const QJsonObject login = QJsonDocument::fromJson(request.body).object();
+    if ((login.value("username").toString() != username_) || (login.value("password").toString() != password_)) {
+      return 401;
+    }
+
+    const QString token = token_prefix_ + QString::number(++token_sequence_);
+    tokens_.insert(token);
+    QJsonObject login_response;
+    login_response.insert("access_token", token);
+    login_response.insert("result", "success");
+    response_body = QJsonDocument(login_response).toJson(QJsonDocument::Compact);
+    return 200;
+  }
+
+  // With the token
+  if (!IsAuthorized(request)) {
+    return 401;
+  }
+
+  const quint16 vlan_status = HandleVlanCommand(request);
+  if (vlan_status != 0) {
+    response_body = "{}";
+    return vlan_status;
+  }
+
+  if (request.method == "GET") {
+    if (request.path == "api/v1/status/systemInformation/uptime") {
+      response_body = JsonString(QString::number(uptime_.elapsed() / 1000));
+      return 200;
+    }
+    return ReadResource(request.path, response_body) ? 200 : 404;
+  }
+
+  if (request.method == "PATCH") {
+    // The member of the parent object (e.g. "api/v1/setting/data/systemInformation/deviceName")
+    const qint32 slash = request.path.lastIndexOf('/');
+    const QString parent_path = request.path.left(slash);
+    if (!resources_.contains(request.path) && (slash > 0) && resources_.contains(parent_path)) {
+      const QJsonDocument member = QJsonDocument::fromJson("{\"v\":" + request.body + "}");
+      QJsonDocument parent = QJsonDocument::fromJson(resources_.value(parent_path));
+      if (member.isNull() || !parent.isObject()) {
+        return 400;
+      }
+      QJsonObject parent_object = parent.object();
+      parent_object.insert(request.path.mid(slash + 1), member.object().value("v"));
+      resources_.insert(parent_path, Json(parent_object));
+      response_body = "{}";
+      return 200;
+    }
+
+    const QJsonDocument patch = QJsonDocument::fromJson(request.body);
+    if (patch.isNull()) {
+      return 400;
+    }
+
+    QJsonDocument resource = QJsonDocument::fromJson(resources_.value(request.path));
+    if (patch.isObject() && resource.isObject()) {
+      QJsonObject merged = resource.object();
+      const QJsonObject patch_object = patch.object();
+      for (auto it = patch_object.constBegin(); it != patch_object.constEnd(); it++) {
+        merged.insert(it.key(), it.value());
+      }
+      resource.setObject(merged);
+    } else {
+      resource = patch;
+    }
+    resources_.insert(request.path, resource.toJson(QJsonDocument::Compact));
+    response_body = "{}";
+    return 200;
+  }
+
+  if (request.method == "POST") {
+    if (request.path == "api/v1/auth/logout") {
+      QString token = request.headers.value("authorization");
+      tokens_.remove(token.startsWith("Bearer ") ? token.mid(7) : token);
+    }
+    response_body = "{}";
+    return 200;
+  }
+
+  if (request.method == "DELETE") {
+    response_body = "{}";
+    return 200;
+  }
+
+  return 404;
+}
@@ -0,0 +1,738 @@
+/* Copyright (C) MOXA Inc. All rights reserved.
+This software is distributed under the terms of the MOXA SOFTWARE NOTICE.
+See the file MOXA-SOFTWARE-NOTICE for details.
+*/
+
+#include "act_simulator_snmp.hpp"
+
+#include <QDebug>
+#include <QHostAddress>
+#include <QPair>
+#include <QStringList>
+#include <algorithm>
+
+#define ACT_SIMULATOR_SNMP_MAX_DATAGRAM (65000)  ///< The maximum size of the response datagram
+#define ACT_SIMULATOR_SNMP_MAX_VAR_BINDS (2000)  ///< The maximum var binds of the GetBulk response
+
+namespace {
+
+using act::simulator::ActSnmpMessage;
+using act::simulator::ActSnmpOid;
+using act::simulator::ActSnmpTypeEnum;
+using act::simulator::ActSnmpValue;
+using act::simulator::ActSnmpVarBind;
+
+const quint8 kBerSequence = 0x30;
+
+QByteArray EncodeLength(const qint32 &length) {
+  QByteArray result;
+  if (length < 0x80) {
+    result.append(static_cast<char>(length));
+    return result;
+  }
+
+  QByteArray bytes;
+  for (qint32 remain = length; remain > 0; remain >>= 8) {
+    bytes.prepend(static_cast<char>(remain & 0xFF));
+  }
+  result.append(static_cast<char>(0x80 | bytes.size()));
+  result.append(bytes);
+  return result;
+}
+
+QByteArray EncodeTlv(const quint8 &tag, const QByteArray &content) {
+  QByteArray result;
+  result.append(static_cast<char>(tag));
+  result.append(EncodeLength(content.size()));
+  result.append(content);
+  return result;
+}
+
+QByteArray EncodeOidContent(const ActSnmpOid &oid) {
+  QByteArray result;
+  if (oid.size() < 2) {
+    result.append(static_cast<char>(0));
+    return result;
+  }
+
+  const ActSnmpOid sub_ids = oid.mid(1);
+  for (qint32 i = 0; i < sub_ids.size(); i++) {
+    quint64 sub_id = (i == 0) ? (static_cast<quint64>(oid.at(0)) * 40 + sub_ids.at(0)) : sub_ids.at(i);
+    QByteArray bytes;
+    bytes.prepend(static_cast<char>(sub_id & 0x7F));
+    for (sub_id >>= 7; sub_id > 0; sub_id >>= 7) {
+      bytes.prepend(static_cast<char>(0x80 | (sub_id & 0x7F)));
+    }
+    result.append(bytes);
+  }
+  return result;
+}
+
+bool DecodeOidContent(const QByteArray &content, ActSnmpOid &oid) {
+  oid.clear();
+  quint64 sub_id = 0;
+  for (qint32 i = 0; i < content.size(); i++) {
+    const quint8 byte = static_cast<quint8>(content.at(i));
+    sub_id = (sub_id << 7) | (byte & 0x7F);
+    if (sub_id > 0xFFFFFFFFULL) {
+      return false;
+    }
+    if (byte & 0x80) {
+      continue;
+    }
+
+    if (oid.isEmpty()) {
+      const quint32 first = (sub_id < 80) ? static_cast<quint32>(sub_id / 40) : 2;
+      oid.append(first);
+      oid.append(static_cast<quint32>(sub_id - first * 40));
+    } else {
+      oid.append(static_cast<quint32>(sub_id));
+    }
+    sub_id = 0;
+  }
+  return !oid.isEmpty();
+}
+
+/**
+ * @brief The BER reader of the TLVs
+ *
+ */
+class BerReader {
+ public:
+  explicit BerReader(const QByteArray &data) : data_(data), pos_(0) {}
+
+  bool AtEnd() const { return pos_ >= data_.size(); }
+
+  bool Read(quint8 &tag, QByteArray &content) {
+    if (pos_ + 2 > data_.size()) {
+      return false;
+    }
+    tag = static_cast<quint8>(data_.at(pos_++));
+
+    qint32 length = static_cast<quint8>(data_.at(pos_++));
+    if (length & 0x80) {
+      const qint32 length_bytes = length & 0x7F;
+      if ((length_bytes == 0) || (length_bytes > 3) || (pos_ + length_bytes > data_.size())) {
+        return false;
+      }
+      length = 0;
+      for (qint32 i = 0; i < length_bytes; i++) {
+        length = (length << 8) | static_cast<quint8>(data_.at(pos_++));
+      }
+    }
+    if (pos_ + length > data_.size()) {
+      return false;
+    }
+
+    content = data_.mid(pos_, length);
+    pos_ += length;
+    return true;
+  }
+
+  bool ReadExpected(const quint8 &expected_tag, QByteArray &content) {
+    quint8 tag = 0;
+    return Read(tag, content) && (tag == expected_tag);
+  }
+
+  bool ReadInteger(qint64 &value) {
+    QByteArray content;
+    if (!ReadExpected(static_cast<quint8>(ActSnmpTypeEnum::kInteger), content) || content.isEmpty() ||
+        content.size() > 8) {
+      return false;
+    }
+    ActSnmpValue snmp_value;
+    snmp_value.type = ActSnmpTypeEnum::kInteger;
+    snmp_value.content = content;
+    value = snmp_value.ToInteger();
+    return true;
+  }
+
+ private:
+  QByteArray data_;
+  qint32 pos_;
+};
+
+QByteArray ParseMacAddress(const QString &mac) {
+  QString hex = mac;
+  hex.remove(':').remove('-');
+  return QByteArray::fromHex(hex.toLatin1());
+}
+
+}  // namespace
+
+ActSnmpValue act::simulator::ActSnmpValue::Integer(const qint64 &value) {
+  ActSnmpValue result;
+  result.type = ActSnmpTypeEnum::kInteger;
+
+  // The minimal two's complement
+  qint32 size = 8;
+  while (size > 1) {
+    const qint64 upper = value >> ((size - 1) * 8 - 1);
+    if ((upper != 0) && (upper != -1)) {
+      break;
+    }
+    size--;
+  }
+  for (qint32 i = size - 1; i >= 0; i--) {
+    result.content.append(static_cast<char>((value >> (i * 8)) & 0xFF));
+  }
+  return result;
+}
+
+ActSnmpValue act::simulator::ActSnmpValue::Unsigned(const ActSnmpTypeEnum &type, const quint64 &value) {
+  ActSnmpValue result;
+  result.type = type;
+  for (quint64 remain = value; remain > 0; remain >>= 8) {
+    result.content.prepend(static_cast<char>(remain & 0xFF));
+  }
+  if (result.content.isEmpty() || (static_cast<quint8>(result.content.at(0)) & 0x80)) {
+    result.content.prepend(static_cast<char>(0));
+  }
+  return result;
+}
+
+ActSnmpValue act::simulator::ActSnmpValue::OctetString(const QByteArray &value) {
+  ActSnmpValue result;
+  result.type = ActSnmpTypeEnum::kOctetString;
+  result.content = value;
+  return result;
+}
+
+ActSnmpValue act::simulator::ActSnmpValue::ObjectId(const ActSnmpOid &value) {
+  ActSnmpValue result;
+  result.type = ActSnmpTypeEnum::kObjectId;
+  result.content = EncodeOidContent(value);
+  return result;
+}
+
+ActSnmpValue act::simulator::ActSnmpValue::IpAddress(const QString &value) {
+  ActSnmpValue result;
+  result.type = ActSnmpTypeEnum::kIpAddress;
+  const quint32 address = QHostAddress(value).toIPv4Address();
+  for (qint32 i = 3; i >= 0; i--) {
+    result.content.append(static_cast<char>((address >> (i * 8)) & 0xFF));
+  }
+  return result;
+}
+
+ActSnmpValue act::simulator::ActSnmpValue::Exception(const ActSnmpTypeEnum &type) {
+  ActSnmpValue result;
+  result.type = type;
+  return result;
+}
+
+bool act::simulator::ActSnmpValue::FromText(const QString &type_name, const QString &text, ActSnmpValue &value) {
+  if (!kActSnmpTypeEnumMap.contains(type_name)) {
+    return false;
+  }
+
+  bool ok = true;
+  const ActSnmpTypeEnum type = kActSnmpTypeEnumMap[type_name];
+  switch (type) {
+    case ActSnmpTypeEnum::kInteger:
+      value = Integer(text.toLongLong(&ok));
+      break;
+    case ActSnmpTypeEnum::kObjectId: {
+      ActSnmpOid oid;
+      ok = ParseSnmpOid(text, oid);
+      value = ObjectId(oid);
+    } break;
+    case ActSnmpTypeEnum::kIpAddress:
+      ok = !QHostAddress(text).isNull();
+      value = IpAddress(text);
+      break;
+    case ActSnmpTypeEnum::kCounter32:
+    case ActSnmpTypeEnum::kGauge32:
+    case ActSnmpTypeEnum::kTimeTicks:
+    case ActSnmpTypeEnum::kCounter64:
+      value = Unsigned(type, text.toULongLong(&ok));
+      break;
+    default:
+      value = OctetString(text.toUtf8());
+      break;
+  }
+  return ok;
+}
+
+qint64 act::simulator::ActSnmpValue::ToInteger() const {
+  if (content.isEmpty()) {
+    return 0;
+  }
+
+  // Sign extension for the INTEGER
+  qint64 result = ((type == ActSnmpTypeEnum::kInteger) && (static_cast<quint8>(content.at(0)) & 0x80)) ? -1 : 0;
+  for (auto byte : content) {
+    result = static_cast<qint64>((static_cast<quint64>(result) << 8) | static_cast<quint8>(byte));
+  }
+  return result;
+}
+
+bool act::simulator::ParseSnmpOid(const QString &text, ActSnmpOid &oid) {
+  oid.clear();
+  QString trimmed = text.trimmed();
+  if (trimmed.startsWith('.')) {
+    trimmed.remove(0, 1);
+  }
+
+  for (const auto &part : trimmed.split('.')) {
+    bool ok = false;
+    const quint32 sub_id = part.toUInt(&ok);
+    if (!ok) {
+      oid.clear();
+      return false;
+    }
+    oid.append(sub_id);
+  }
+  return oid.size() >= 2;
+}
+
+QString act::simulator::SnmpOidToString(const ActSnmpOid &oid) {
+  QStringList parts;
+  for (auto sub_id : oid) {
+    parts.append(QString::number(sub_id));
+  }
+  return parts.join('.');
+}
+
+bool act::simulator::DecodeSnmpMessage(const QByteArray &datagram, ActSnmpMessage &message) {
+  BerReader message_reader(datagram);
+  QByteArray message_content;
+  if (!message_reader.ReadExpected(kBerSequence, message_content)) {
+    return false;
+  }
+
+  BerReader reader(message_content);
+  if (!reader.ReadInteger(message.version) ||
+      !reader.ReadExpected(static_cast<quint8>(ActSnmpTypeEnum::kOctetString), message.community)) {
+    return false;
+  }
+  if ((message.version != static_cast<qint64>(ActSnmpWireVersionEnum::kV1)) &&
+      (message.version != static_cast<qint64>(ActSnmpWireVersionEnum::kV2c))) {
+    return false;
+  }
+
+  quint8 pdu_tag = 0;
+  QByteArray pdu_content;
+  if (!reader.Read(pdu_tag, pdu_content)) {
+    return false;
+  }
+  switch (static_cast<ActSnmpPduTypeEnum>(pdu_tag)) {
+    case ActSnmpPduTypeEnum::kGetRequest:
+    case ActSnmpPduTypeEnum::kGetNextRequest:
+    case ActSnmpPduTypeEnum::kGetResponse:
+    case ActSnmpPduTypeEnum::kSetRequest:
+    case ActSnmpPduTypeEnum::kGetBulkRequest:
+      message.pdu_type = static_cast<ActSnmpPduTypeEnum>(pdu_tag);
+      break;
+    default:
+      return false;
+  }
+
+  BerReader pdu_reader(pdu_content);
+  QByteArray var_binds_content;
+  if (!pdu_reader.ReadInteger(message.request_id) || !pdu_reader.ReadInteger(message.error_status) ||
+      !pdu_reader.ReadInteger(message.error_index) || !pdu_reader.ReadExpected(kBerSequence, var_binds_content)) {
+    return false;
+  }
+
+  message.var_binds.clear();
+  BerReader var_binds_reader(var_binds_content);
+  while (!var_binds_reader.AtEnd()) {
+    QByteArray var_bind_content;
+    if (!var_binds_reader.ReadExpected(kBerSequence, var_bind_content)) {
+      return false;
+    }
+
+    BerReader var_bind_reader(var_bind_content);
+    QByteArray oid_content;
+    quint8 value_tag = 0;
+    ActSnmpVarBind var_bind;
+    if (!var_bind_reader.ReadExpected(static_cast<quint8>(ActSnmpTypeEnum::kObjectId), oid_content) ||
+        !DecodeOidContent(oid_content, var_bind.oid) || !var_bind_reader.Read(value_tag, var_bind.value.content)) {
+      return false;
+    }
+    var_bind.value.type = static_cast<ActSnmpTypeEnum>(value_tag);
+    message.var_binds.append(var_bind);
+  }
+  return true;
+}
+
+QByteArray act::simulator::EncodeSnmpMessage(const ActSnmpMessage &message) {
+  QByteArray var_binds_content;
+  for (const auto &var_bind : message.var_binds) {
+    QByteArray var_bind_content;
+    var_bind_content.append(EncodeTlv(static_cast<quint8>(ActSnmpTypeEnum::kObjectId), EncodeOidContent(var_bind.oid)));
+    var_bind_content.append(EncodeTlv(static_cast<quint8>(var_bind.value.type), var_bind.value.content));
+    var_binds_content.append(EncodeTlv(kBerSequence, var_bind_content));
+  }
+
+  QByteArray pdu_content;
+  pdu_content.append(EncodeTlv(static_cast<quint8>(ActSnmpTypeEnum::kInteger),
+                               ActSnmpValue::Integer(message.request_id).content));
+  pdu_content.append(EncodeTlv(static_cast<quint8>(ActSnmpTypeEnum::kInteger),
+                               ActSnmpValue::Integer(message.error_status).content));
+  pdu_content.append(EncodeTlv(static_cast<quint8>(ActSnmpTypeEnum::kInteger),
+                               ActSnmpValue::Integer(message.error_index).content));
+  pdu_content.append(EncodeTlv(kBerSequence, var_binds_content));
+
+  QByteArray message_content;
+  message_content.append(
+      EncodeTlv(static_cast<quint8>(ActSnmpTypeEnum::kInteger), ActSnmpValue::Integer(message.version).content));
+  message_content.append(EncodeTlv(static_cast<quint8>(ActSnmpTypeEnum::kOctetString), message.community));
+  message_content.append(EncodeTlv(static_cast<quint8>(message.pdu_type), pdu_content));
+
+  return EncodeTlv(kBerSequence, message_content);
+}
+
+act::simulator::ActSnmpAgentSimulator::ActSnmpAgentSimulator(const ActSimulatedDevice &device,
+                                                             const QMap<qint64, ActSimulatedDevice> &fleet,
+                                                             const QString &read_community,
+                                                             const QString &write_community)
+    : read_community_(read_community.toUtf8()), write_community_(write_community.toUtf8()) {
+  uptime_.start();
+  BuildMib(device, fleet);
+}
+
+void act::simulator::ActSnmpAgentSimulator::Insert(const QString &oid, const ActSnmpValue &value) {
+  ActSnmpOid key;
+  if (!ParseSnmpOid(oid, key)) {
+    qWarning() << __func__ << QString("Invalid OID(%1)").arg(oid).toStdString().c_str();
+    return;
+  }
+  objects_.insert(key, value);
+}
+
+void act::simulator::ActSnmpAgentSimulator::BuildMib(const ActSimulatedDevice &device,
+                                                     const QMap<qint64, ActSimulatedDevice> &fleet) {
+  const QByteArray mac = ParseMacAddress(device.GetMacAddress());
+  ActSnmpOid sys_object_id;
+  ParseSnmpOid(device.GetSysObjectId(), sys_object_id);
+
+  // system
+  Insert("1.3.6.1.2.1.1.1.0", ActSnmpValue::OctetString(device.GetModelName().toUtf8()));
+  Insert("1.3.6.1.2.1.1.2.0", ActSnmpValue::ObjectId(sys_object_id));
+  Insert("1.3.6.1.2.1.1.3.0", ActSnmpValue::Unsigned(ActSnmpTypeEnum::kTimeTicks, 0));
+  Insert("1.3.6.1.2.1.1.4.0", ActSnmpValue::OctetString(QByteArray()));
+  Insert("1.3.6.1.2.1.1.5.0", ActSnmpValue::OctetString(device.GetDeviceName().toUtf8()));
+  Insert("1.3.6.1.2.1.1.6.0", ActSnmpValue::OctetString(QByteArray()));
+
+  // Port -> neighbor
+  QMap<quint16, ActSimulatedNeighbor> neighbor_map;
+  for (const auto &neighbor : device.GetNeighbors()) {
+    neighbor_map.insert(neighbor.GetLocalPort(), neighbor);
+  }
+
+  // interfaces (ifTable & ifXTable)
+  Insert("1.3.6.1.2.1.2.1.0", ActSnmpValue::Integer(device.GetPortCount()));
+  for (quint16 port = 1; port <= device.GetPortCount(); port++) {
+    const QString index = QString::number(port);
+    const bool link_up = neighbor_map.contains(port);
+    Insert("1.3.6.1.2.1.2.2.1.1." + index, ActSnmpValue::Integer(port));
+    Insert("1.3.6.1.2.1.2.2.1.2." + index, ActSnmpValue::OctetString(QString("Port %1").arg(port).toUtf8()));
+    Insert("1.3.6.1.2.1.2.2.1.3." + index, ActSnmpValue::Integer(6));  // ethernetCsmacd
+    Insert("1.3.6.1.2.1.2.2.1.4." + index, ActSnmpValue::Integer(1500));
+    Insert("1.3.6.1.2.1.2.2.1.5." + index, ActSnmpValue::Unsigned(ActSnmpTypeEnum::kGauge32, 1000000000));
+    Insert("1.3.6.1.2.1.2.2.1.6." + index, ActSnmpValue::OctetString(mac));
+    Insert("1.3.6.1.2.1.2.2.1.7." + index, ActSnmpValue::Integer(1));
+    Insert("1.3.6.1.2.1.2.2.1.8." + index, ActSnmpValue::Integer(link_up ? 1 : 2));
+    Insert("1.3.6.1.2.1.2.2.1.10." + index, ActSnmpValue::Unsigned(ActSnmpTypeEnum::kCounter32, 0));
+    Insert("1.3.6.1.2.1.2.2.1.16." + index, ActSnmpValue::Unsigned(ActSnmpTypeEnum::kCounter32, 0));
+    Insert("1.3.6.1.2.1.31.1.1.1.1." + index, ActSnmpValue::OctetString(index.toUtf8()));
+    Insert("1.3.6.1.2.1.31.1.1.1.6." + index, ActSnmpValue::Unsigned(ActSnmpTypeEnum::kCounter64, 0));
+    Insert("1.3.6.1.2.1.31.1.1.1.10." + index, ActSnmpValue::Unsigned(ActSnmpTypeEnum::kCounter64, 0));
+    Insert("1.3.6.1.2.1.31.1.1.1.15." + index, ActSnmpValue::Unsigned(ActSnmpTypeEnum::kGauge32, 1000));
+  }
+
+  // ipAddrTable
+  const QString &ip_index = device.GetIpAddress();
+  Insert("1.3.6.1.2.1.4.20.1.1." + ip_index, ActSnmpValue::IpAddress(device.GetIpAddress()));
+  Insert("1.3.6.1.2.1.4.20.1.2." + ip_index, ActSnmpValue::Integer(1));
+  Insert("1.3.6.1.2.1.4.20.1.3." + ip_index, ActSnmpValue::IpAddress("255.255.255.0"));
+
+  // dot1dBase
+  Insert("1.3.6.1.2.1.17.1.1.0", ActSnmpValue::OctetString(mac));
+  Insert("1.3.6.1.2.1.17.1.2.0", ActSnmpValue::Integer(device.GetPortCount()));
+
+  // Q-BRIDGE dot1qBase
+  Insert("1.3.6.1.2.1.17.7.1.1.1.0", ActSnmpValue::Integer(1));  // dot1qVlanVersionNumber
+  Insert("1.3.6.1.2.1.17.7.1.1.2.0", ActSnmpValue::Integer(4094));
+  Insert("1.3.6.1.2.1.17.7.1.1.3.0", ActSnmpValue::Unsigned(ActSnmpTypeEnum::kGauge32, 256));
+  Insert("1.3.6.1.2.1.17.7.1.1.4.0", ActSnmpValue::Unsigned(ActSnmpTypeEnum::kGauge32, 1));
+
+  // Q-BRIDGE dot1qTpFdbPort (index: FdbId.MAC), the neighbors are learned in the VLAN 1
+  for (const auto &neighbor : neighbor_map) {
+    auto remote_it = fleet.constFind(neighbor.GetRemoteDeviceId());
+    if (remote_it == fleet.constEnd()) {
+      continue;
+    }
+    QStringList mac_index;
+    for (const char &byte : ParseMacAddress(remote_it.value().GetMacAddress())) {
+      mac_index.append(QString::number(static_cast<quint8>(byte)));
+    }
+    Insert("1.3.6.1.2.1.17.7.1.2.2.1.2.1." + mac_index.join('.'), ActSnmpValue::Integer(neighbor.GetLocalPort()));
+  }
+
+  // Q-BRIDGE dot1qVlanStaticTable (the PortList: the MSB of the first octet is the port 1), all ports in the VLAN 1
+  QByteArray all_ports((device.GetPortCount() + 7) / 8, '\0');
+  for (quint16 port = 1; port <= device.GetPortCount(); port++) {
+    all_ports[(port - 1) / 8] = static_cast<char>(all_ports.at((port - 1) / 8) | (0x80 >> ((port - 1) % 8)));
+  }
+  Insert("1.3.6.1.2.1.17.7.1.4.3.1.1.1", ActSnmpValue::OctetString("VLAN0001"));
+  Insert("1.3.6.1.2.1.17.7.1.4.3.1.2.1", ActSnmpValue::OctetString(all_ports));
+  Insert("1.3.6.1.2.1.17.7.1.4.3.1.3.1", ActSnmpValue::OctetString(QByteArray(all_ports.size(), '\0')));
+  Insert("1.3.6.1.2.1.17.7.1.4.3.1.4.1", ActSnmpValue::OctetString(all_ports));
+  Insert("1.3.6.1.2.1.17.7.1.4.3.1.5.1", ActSnmpValue::Integer(1));  // active
+
+  // Q-BRIDGE dot1qPvid (the southbound writes it as the INTEGER)
+  for (quint16 port = 1; port <= device.GetPortCount(); port++) {
+    Insert("1.3.6.1.2.1.17.7.1.4.5.1.1." + QString::number(port), ActSnmpValue::Integer(1));
+  }
+
+  // LLDP local system & ports
+  Insert("1.0.8802.1.1.2.1.3.1.0", ActSnmpValue::Integer(4));  // macAddress
+  Insert("1.0.8802.1.1.2.1.3.2.0", ActSnmpValue::OctetString(mac));
+  Insert("1.0.8802.1.1.2.1.3.3.0", ActSnmpValue::OctetString(device.GetDeviceName().toUtf8()));
+  Insert("1.0.8802.1.1.2.1.3.4.0", ActSnmpValue::OctetString(device.GetModelName().toUtf8()));
+  for (quint16 port = 1; port <= device.GetPortCount(); port++) {
+    const QString index = QString::number(port);
+    Insert("1.0.8802.1.1.2.1.3.7.1.2." + index, ActSnmpValue::Integer(7));  // local
+    Insert("1.0.8802.1.1.2.1.3.7.1.3." + index, ActSnmpValue::OctetString(index.toUtf8()));
+    Insert("1.0.8802.1.1.2.1.3.7.1.4." + index, ActSnmpValue::OctetString(QString("Port %1").arg(port).toUtf8()));
+  }
+
+  // LLDP remote table (index: TimeMark.LocalPort.RemIndex)
+  for (const auto &neighbor : neighbor_map) {
+    auto remote_it = fleet.constFind(neighbor.GetRemoteDeviceId());
+    if (remote_it == fleet.constEnd()) {
+      continue;
+    }
+    const ActSimulatedDevice &remote = remote_it.value();
+    const QString index = QString("0.%1.1").arg(neighbor.GetLocalPort());
+    const QString remote_port = QString::number(neighbor.GetRemotePort());
+    Insert("1.0.8802.1.1.2.1.4.1.1.4." + index, ActSnmpValue::Integer(4));  // macAddress
+    Insert("1.0.8802.1.1.2.1.4.1.1.5." + index, ActSnmpValue::OctetString(ParseMacAddress(remote.GetMacAddress())));
+    Insert("1.0.8802.1.1.2.1.4.1.1.6." + index, ActSnmpValue::Integer(7));  // local
+    Insert("1.0.8802.1.1.2.1.4.1.1.7." + index, ActSnmpValue::OctetString(remote_port.toUtf8()));
+    Insert("1.0.8802.1.1.2.1.4.1.1.8." + index,
+           ActSnmpValue::OctetString(QString("Port %1").arg(remote_port).toUtf8()));
+    Insert("1.0.8802.1.1.2.1.4.1.1.9." + index, ActSnmpValue::OctetString(remote.GetDeviceName().toUtf8()));
+
+    // lldpRemManAddrTable (index: ... .AddrSubtype(ipV4).AddrLen.Addr)
+    const QString man_index = QString("%1.1.4.%2").arg(index).arg(remote.GetIpAddress());
+    Insert("1.0.8802.1.1.2.1.4.2.1.3." + man_index, ActSnmpValue::Integer(2));  // ifIndex
+    Insert("1.0.8802.1.1.2.1.4.2.1.4." + man_index, ActSnmpValue::Integer(neighbor.GetRemotePort()));
+  }
+
+  // Extra objects (override the generated)
+  for (const auto &extra_oid : device.GetExtraOids()) {
+    ActSnmpValue value;
+    if (!ActSnmpValue::FromText(extra_oid.GetType(), extra_oid.GetValue(), value)) {
+      qWarning() << __func__
+                 << QString("Invalid extra OID(%1) %2: %3")
+                        .arg(extra_oid.GetOid())
+                        .arg(extra_oid.GetType())
+                        .arg(extra_oid.GetValue())
+                        .toStdString()
+                        .c_str();
+      continue;
+    }
+    Insert(extra_oid.GetOid(), value);
+  }
+}
+
+bool act::simulator::ActSnmpAgentSimulator::IsCreatable(const ActSnmpOid &oid) {
+  // The entries of dot1qStaticUnicastTable, dot1qStaticMulticastTable & dot1qVlanStaticTable
+  static const QList<ActSnmpOid> kCreatableEntries = {{1, 3, 6, 1, 2, 1, 17, 7, 1, 3, 1, 1},
+                                                      {1, 3, 6, 1, 2, 1, 17, 7, 1, 3, 2, 1},
+                                                      {1, 3, 6, 1, 2, 1, 17, 7, 1, 4, 3, 1}};
+  for (const auto &entry : kCreatableEntries) {
+    // The column & the index follow the entry
+    if ((oid.size() > entry.size() + 1) && std::equal(entry.begin(), entry.end(), oid.begin())) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void act::simulator::ActSnmpAgentSimulator::Set(const ActSnmpVarBind &var_bind) {
+  // <the status column, the destroy value>
+  static const QList<QPair<ActSnmpOid, qint64>> kRowStatusColumns = {
+      {{1, 3, 6, 1, 2, 1, 17, 7, 1, 3, 1, 1, 4}, 2},   // dot1qStaticUnicastStatus invalid(2)
+      {{1, 3, 6, 1, 2, 1, 17, 7, 1, 3, 2, 1, 5}, 2},   // dot1qStaticMulticastStatus invalid(2)
+      {{1, 3, 6, 1, 2, 1, 17, 7, 1, 4, 3, 1, 5}, 6}};  // dot1qVlanStaticRowStatus destroy(6)
+
+  for (const auto &status_column : kRowStatusColumns) {
+    const ActSnmpOid &column = status_column.first;
+    if ((var_bind.oid.size() <= column.size()) || !std::equal(column.begin(), column.end(), var_bind.oid.begin())) {
+      continue;
+    }
+
+    const qint64 status = var_bind.value.ToInteger();
+    if (status == status_column.second) {
+      // Remove all columns of the row
+      const ActSnmpOid entry = column.mid(0, column.size() - 1);
+      const ActSnmpOid index = var_bind.oid.mid(column.size());
+      for (auto it = objects_.begin(); it != objects_.end();) {
+        const ActSnmpOid &oid = it.key();
+        const bool same_row = (oid.size() == entry.size() + 1 + index.size()) &&
+                              std::equal(entry.begin(), entry.end(), oid.begin()) &&
+                              std::equal(index.begin(), index.end(), oid.begin() + entry.size() + 1);
+        if (same_row) {
+          it = objects_.erase(it);
+        } else {
+          it++;
+        }
+      }
+      return;
+    }
+
+    // The RowStatus createAndGo(4) & createAndWait(5) activate the row
+    const bool row_status = (status_column.second == 6);
+    objects_.insert(var_bind.oid,
+                    (row_status && ((status == 4) || (status == 5))) ? ActSnmpValue::Integer(1) : var_bind.value);
+    return;
+  }
+
+  objects_.insert(var_bind.oid, var_bind.value);
+}
+
+ActSnmpValue act::simulator::ActSnmpAgentSimulator::Get(const ActSnmpOid &oid) const {
+  static const ActSnmpOid kSysUpTime = {1, 3, 6, 1, 2, 1, 1, 3, 0};
+  if (oid == kSysUpTime) {
+    return ActSnmpValue::Unsigned(ActSnmpTypeEnum::kTimeTicks, static_cast<quint64>(uptime_.elapsed() / 10));
+  }
+
+  auto it = objects_.constFind(oid);
+  if (it == objects_.constEnd()) {
+    return ActSnmpValue::Exception(ActSnmpTypeEnum::kNoSuchObject);
+  }
+  return it.value();
+}
+
+bool act::simulator::ActSnmpAgentSimulator::GetNext(const ActSnmpOid &oid, ActSnmpVarBind &var_bind) const {
+  auto it = objects_.upperBound(oid);
+  if (it == objects_.constEnd()) {
+    var_bind.oid = oid;
+    var_bind.value = ActSnmpValue::Exception(ActSnmpTypeEnum::kEndOfMibView);
+    return false;
+  }
+
+  var_bind.oid = it.key();
+  var_bind.value = Get(it.key());
+  return true;
+}
+
+bool act::simulator::ActSnmpAgentSimulator::HandleRequest(const QByteArray &request, QByteArray &response) {
+  ActSnmpMessage message;
+  if (!DecodeSnmpMessage(request, message)) {
+    return false;
+  }
+
+  const bool is_v1 = (message.version == static_cast<qint64>(ActSnmpWireVersionEnum::kV1));
+  const bool is_set = (message.pdu_type == ActSnmpPduTypeEnum::kSetRequest);
+  if (is_set ? (message.community != write_community_)
+             : ((message.community != read_community_) && (message.community != write_community_))) {
+    return false;  // The agent does not reply the wrong community
+  }
+  if ((message.pdu_type == ActSnmpPduTypeEnum::kGetResponse) ||
+      (is_v1 && (message.pdu_type == ActSnmpPduTypeEnum::kGetBulkRequest))) {
+    return false;
+  }
+
+  ActSnmpMessage reply;
+  reply.version = message.version;
+  reply.community = message.community;
+  reply.pdu_type = ActSnmpPduTypeEnum::kGetResponse;
+  reply.request_id = message.request_id;
+
+  // v1 reports the first missing object by the error status
+  auto set_v1_error = [&reply, &message](const ActSnmpErrorStatusEnum &error, const qint32 &index) {
+    reply.error_status = static_cast<qint64>(error);
+    reply.error_index = index + 1;
+    reply.var_binds = message.var_binds;
+  };
+
+  switch (message.pdu_type) {
+    case ActSnmpPduTypeEnum::kGetRequest:
+      for (qint32 i = 0; i < message.var_binds.size(); i++) {
+        ActSnmpVarBind var_bind{message.var_binds.at(i).oid, Get(message.var_binds.at(i).oid)};
+        if (is_v1 && (var_bind.value.type == ActSnmpTypeEnum::kNoSuchObject)) {
+          set_v1_error(ActSnmpErrorStatusEnum::kNoSuchName, i);
+          break;
+        }
+        reply.var_binds.append(var_bind);
+      }
+      break;
+    case ActSnmpPduTypeEnum::kGetNextRequest:
+      for (qint32 i = 0; i < message.var_binds.size(); i++) {
+        ActSnmpVarBind var_bind;
+        if (!GetNext(message.var_binds.at(i).oid, var_bind) && is_v1) {
+          set_v1_error(ActSnmpErrorStatusEnum::kNoSuchName, i);
+          break;
+        }
+        reply.var_binds.append(var_bind);
+      }
+      break;
+    case ActSnmpPduTypeEnum::kGetBulkRequest: {
+      const qint32 non_repeaters =
+          static_cast<qint32>(qBound<qint64>(0, message.error_status, message.var_binds.size()));
+      const qint64 max_repetitions = qBound<qint64>(0, message.error_index, ACT_SIMULATOR_SNMP_MAX_VAR_BINDS);
+      for (qint32 i = 0; i < non_repeaters; i++) {
+        ActSnmpVarBind var_bind;
+        GetNext(message.var_binds.at(i).oid, var_bind);
+        reply.var_binds.append(var_bind);
+      }
+
+      QList<ActSnmpOid> cursors;
+      for (qint32 i = non_repeaters; i < message.var_binds.size(); i++) {
+        cursors.append(message.var_binds.at(i).oid);
+      }
+      for (qint64 repetition = 0; (repetition < max_repetitions) && !cursors.isEmpty(); repetition++) {
+        bool any_found = false;
+        for (auto &cursor : cursors) {
+          ActSnmpVarBind var_bind;
+          any_found |= GetNext(cursor, var_bind);
+          cursor = var_bind.oid;
+          reply.var_binds.append(var_bind);
+        }
+        if (!any_found || (reply.var_binds.size() >= ACT_SIMULATOR_SNMP_MAX_VAR_BINDS)) {
+          break;
+        }
+      }
+    } break;
+    case ActSnmpPduTypeEnum::kSetRequest: {
+      for (qint32 i = 0; i < message.var_binds.size(); i++) {
+        const auto &var_bind = message.var_binds.at(i);
+        auto it = objects_.constFind(var_bind.oid);
+        if (it == objects_.constEnd()) {
+          if (IsCreatable(var_bind.oid)) {
+            continue;
+          }
+          set_v1_error(is_v1 ? ActSnmpErrorStatusEnum::kNoSuchName : ActSnmpErrorStatusEnum::kNotWritable, i);
+          break;
+        }
+        if (it.value().type != var_bind.value.type) {
+          set_v1_error(ActSnmpErrorStatusEnum::kBadValue, i);
+          break;
+        }
+      }
+      if (reply.error_status == static_cast<qint64>(ActSnmpErrorStatusEnum::kNoError)) {
+        for (const auto &var_bind : message.var_binds) {
+          Set(var_bind);
+        }
+        reply.var_binds = message.var_binds;
+      }
+    } break;
+    default:
+      return false;
+  }
+
+  response = EncodeSnmpMessage(reply);
+
+  // The GetBulk response may contain fewer var binds to fit the datagram
+  while ((response.size() > ACT_SIMULATOR_SNMP_MAX_DATAGRAM) && (reply.var_binds.size() > 1)) {
+    reply.var_binds.erase(reply.var_binds.begin() + reply.var_binds.size() / 2, reply.var_binds.end());
+    response = EncodeSnmpMessage(reply);
+  }
+  return true;
+}
@@ -0,0 +1,205 @@
+#include "act_device_simulator.hpp"
+#include "act_restful_client_handler.h"
+#include "act_snmp_handler.h"
+#include "act_unit_test.hpp"
+
+namespace act {
+namespace simulator {
+
+/**
+ * @brief Drive the southbound (scan, monitor & deploy) against the simulated fleet
+ *
+ */
+class ActSimulatorSouthboundTest : public ActQuickTest {
+ protected:
+  ActSimulatorConfig config;
+  std::unique_ptr<ActDeviceSimulator> simulator;
+  ActRestfulClientHandler restful_handler;
+  ActSnmpHandler snmp_handler;
+
+  void SetUp() override {
+    config.SetDeviceCount(4);
+    config.SetTopology(ActSimulatorTopologyEnum::kRing);
+    config.SetSnmpPort(21161);
+    config.SetRestfulPort(28080);
+    simulator = std::make_unique<ActDeviceSimulator>(config);
+    ASSERT_TRUE(IsActStatusSuccess(simulator->Start()));
+    ASSERT_TRUE(IsActStatusSuccess(snmp_handler.InitSnmpResource()));
+  }
+
+  void TearDown() override {
+    snmp_handler.ClearSnmpResource();
+    simulator->Stop();
+  }
+
+  ActDevice Device(const qint32 &index) {
+    const ActSimulatedDevice &simulated_device = simulator->GetDevices().at(index);
+    ActDevice device(simulated_device.GetIpAddress(), simulated_device.GetModelName());
+    device.SetId(simulated_device.GetId());
+
+    ActSnmpConfiguration snmp_configuration;
+    snmp_configuration.SetVersion(ActSnmpVersionEnum::kV2c);
+    snmp_configuration.SetPort(config.GetSnmpPort());
+    snmp_configuration.SetReadCommunity(config.GetReadCommunity());
+    snmp_configuration.SetWriteCommunity(config.GetWriteCommunity());
+    device.SetSnmpConfiguration(snmp_configuration);
+
+    ActRestfulConfiguration restful_configuration;
+    restful_configuration.SetProtocol(ActRestfulProtocolEnum::kHTTP);
+    restful_configuration.SetPort(config.GetRestfulPort());
+    restful_configuration.SetUsername(config.GetUsername());
+    restful_configuration.SetPassword(config.GetPassword());
+    device.SetRestfulConfiguration(restful_configuration);
+    return device;
+  }
+
+  // The handlers only look up the action key, the SNMP takes its path
+  static ActFeatureMethodProtocol Protocol(const QMap<QString, QString> &actions) {
+    ActFeatureMethodProtocol protocol;
+    for (auto it = actions.constBegin(); it != actions.constEnd(); it++) {
+      ActMethodAction action;
+      action.SetPath(it.value());
+      protocol.GetActions().insert(it.key(), action);
+    }
+    return protocol;
+  }
+};
+
+TEST_F(ActSimulatorSouthboundTest, TestScan) {
+  const ActDevice device = Device(1);
+  const ActSimulatedDevice &simulated_device = simulator->GetDevices().at(1);
+  const ActFeatureMethodProtocol restful = Protocol({{"Scan", ""}});
+
+  QString serial_number;
+  ASSERT_TRUE(IsActStatusSuccess(restful_handler.GetSerialNumber(device, "Scan", restful, serial_number)));
+  EXPECT_EQ(simulated_device.GetSerialNumber(), serial_number);
+
+  QString product_revision;
+  ASSERT_TRUE(IsActStatusSuccess(restful_handler.GetProductRevision(device, "Scan", restful, product_revision)));
+  EXPECT_EQ(simulated_device.GetFirmwareVersion(), product_revision);
+
+  ActDeviceModularInfo modular_info;
+  ASSERT_TRUE(IsActStatusSuccess(restful_handler.GetModularInfo(device, "Scan", restful, modular_info)));
+  ASSERT_EQ(1, modular_info.GetEthernet().size());
+  EXPECT_TRUE(modular_info.GetEthernet()[1].GetExist());
+  EXPECT_EQ(2, modular_info.GetPower().size());
+
+  // The LLDP neighbors (the ring device's neighbors are on port 1 & port 2)
+  QMap<qint64, QString> port_mac_map;
+  ASSERT_TRUE(IsActStatusSuccess(snmp_handler.GetLldpRemPortMacMap(
+      device, "LldpRemChassisId", Protocol({{"LldpRemChassisId", "1.0.8802.1.1.2.1.4.1.1.5"}}), port_mac_map)));
+  EXPECT_EQ("00-90-E8-00-00-01", port_mac_map.value(1));
+  EXPECT_EQ("00-90-E8-00-00-03", port_mac_map.value(2));
+}
+
+TEST_F(ActSimulatorSouthboundTest, TestMonitor) {
+  const ActDevice device = Device(1);
+  const ActFeatureMethodProtocol restful = Protocol({{"Monitor", ""}});
+
+  QMap<qint64, ActMonitorPortStatusEntry> port_status_map;
+  ASSERT_TRUE(IsActStatusSuccess(restful_handler.GetPortStatus(device, "Monitor", restful, port_status_map)));
+  ASSERT_EQ(static_cast<qint32>(config.GetPortCount()), port_status_map.size());
+  EXPECT_EQ(ActLinkStatusTypeEnum::kUp, port_status_map[1].GetLinkStatus());
+  EXPECT_EQ(ActLinkStatusTypeEnum::kUp, port_status_map[2].GetLinkStatus());
+  EXPECT_EQ(ActLinkStatusTypeEnum::kDown, port_status_map[3].GetLinkStatus());
+
+  QMap<qint64, ActMonitorTrafficStatisticsEntry> traffic_statistics_map;
+  ASSERT_TRUE(
+      IsActStatusSuccess(restful_handler.GetTrafficStatistics(device, "Monitor", restful, traffic_statistics_map)));
+  EXPECT_EQ(static_cast<qint32>(config.GetPortCount()), traffic_statistics_map.size());
+
+  ActMonitorSystemUtilization system_utilization;
+  ASSERT_TRUE(
+      IsActStatusSuccess(restful_handler.GetSystemUtilization(device, "Monitor", restful, system_utilization)));
+  EXPECT_GT(system_utilization.GetCPUUsage(), 0);
+
+  ActMonitorTimeSyncStatus time_sync_status;
+  ASSERT_TRUE(IsActStatusSuccess(restful_handler.Get1588DefaultInfo(device, "Monitor", restful, time_sync_status)));
+  EXPECT_FALSE(time_sync_status.GetGrandmasterIdentity().isEmpty());
+  EXPECT_EQ(static_cast<qint32>(config.GetPortCount()), time_sync_status.GetPortState().size());
+
+  // The FDB learns the neighbors
+  QMap<qint64, QSet<QString>> port_macs_map;
+  ASSERT_TRUE(IsActStatusSuccess(snmp_handler.GetPortMacsMap(
+      device, "Dot1qTpFdbPort", Protocol({{"Dot1qTpFdbPort", "1.3.6.1.2.1.17.7.1.2.2.1.2"}}), port_macs_map)));
+  EXPECT_EQ(QSet<QString>({"00-90-E8-00-00-01"}), port_macs_map.value(1));
+  EXPECT_EQ(QSet<QString>({"00-90-E8-00-00-03"}), port_macs_map.value(2));
+}
+
+TEST_F(ActSimulatorSouthboundTest, TestRestfulDeployVlan) {
+  const ActDevice device = Device(0);
+  const ActFeatureMethodProtocol restful = Protocol({{"VLAN", ""}});
+
+  ASSERT_TRUE(IsActStatusSuccess(restful_handler.AddStdVlanMember(device, "VLAN", restful, {100, 200})));
+
+  ActPortVlanTable port_vlan_table(device.GetId());
+  port_vlan_table.GetPortVlanEntries().insert(ActPortVlanEntry(3, 100, ActVlanPriorityEnum::kNonTSN));
+  ASSERT_TRUE(IsActStatusSuccess(restful_handler.SetStdVlanPVID(device, "VLAN", restful, port_vlan_table)));
+
+  ActVlanPortTypeTable vlan_port_type_table(device.GetId());
+  vlan_port_type_table.GetVlanPortTypeEntries().insert(
+      ActVlanPortTypeEntry(3, ActVlanPortTypeEnum::kTrunk, ActVlanPriorityEnum::kNonTSN));
+  ASSERT_TRUE(IsActStatusSuccess(restful_handler.SetVlanPortType(device, "VLAN", restful, vlan_port_type_table)));
+
+  // Read back
+  ActVlanStaticTable vlan_static_table;
+  ASSERT_TRUE(IsActStatusSuccess(restful_handler.GetStdVlanTable(device, "VLAN", restful, vlan_static_table)));
+  QSet<qint32> vids;
+  for (const auto &entry : vlan_static_table.GetVlanStaticEntries()) {
+    vids.insert(entry.GetVlanId());
+  }
+  EXPECT_EQ(QSet<qint32>({1, 100, 200}), vids);
+
+  ActPortVlanTable result_port_vlan_table;
+  ASSERT_TRUE(IsActStatusSuccess(restful_handler.GetStdVlanPVID(device, "VLAN", restful, result_port_vlan_table)));
+  for (const auto &entry : result_port_vlan_table.GetPortVlanEntries()) {
+    EXPECT_EQ((entry.GetPortId() == 3) ? 100 : 1, entry.GetPVID()) << "Port" << entry.GetPortId();
+  }
+
+  ActVlanPortTypeTable result_vlan_port_type_table;
+  ASSERT_TRUE(
+      IsActStatusSuccess(restful_handler.GetVlanPortType(device, "VLAN", restful, result_vlan_port_type_table)));
+  for (const auto &entry : result_vlan_port_type_table.GetVlanPortTypeEntries()) {
+    EXPECT_EQ((entry.GetPortId() == 3) ? ActVlanPortTypeEnum::kTrunk : ActVlanPortTypeEnum::kAccess,
+              entry.GetVlanPortType())
+        << "Port" << entry.GetPortId();
+  }
+
+  // Delete
+  ASSERT_TRUE(IsActStatusSuccess(restful_handler.DeleteStdVlanMember(device, "VLAN", restful, {200})));
+  ASSERT_TRUE(IsActStatusSuccess(restful_handler.GetStdVlanTable(device, "VLAN", restful, vlan_static_table)));
+  EXPECT_EQ(2, vlan_static_table.GetVlanStaticEntries().size());
+}
+
+TEST_F(ActSimulatorSouthboundTest, TestSnmpDeployVlan) {
+  const ActDevice device = Device(0);
+  const ActFeatureMethodProtocol snmp = Protocol({{"Dot1qVlanStaticName", "1.3.6.1.2.1.17.7.1.4.3.1.1"},
+                                                  {"Dot1qVlanStaticEgressPorts", "1.3.6.1.2.1.17.7.1.4.3.1.2"},
+                                                  {"Dot1qVlanStaticUntaggedPorts", "1.3.6.1.2.1.17.7.1.4.3.1.4"},
+                                                  {"Dot1qVlanStaticRowStatus", "1.3.6.1.2.1.17.7.1.4.3.1.5"}});
+
+  ActVlanStaticEntry vlan_static_entry(100);
+  vlan_static_entry.SetName("v100");
+  vlan_static_entry.SetRowStatus(1);  // active
+  vlan_static_entry.SetEgressPorts({1, 2});
+  ASSERT_TRUE(IsActStatusSuccess(snmp_handler.SetDot1qVlanStatic(device, snmp, {vlan_static_entry})));
+
+  QSet<ActVlanStaticEntry> vlan_static_entries;
+  ASSERT_TRUE(IsActStatusSuccess(snmp_handler.GetDot1qVlanStatic(device, snmp, vlan_static_entries)));
+  ASSERT_EQ(2, vlan_static_entries.size());
+  auto it = vlan_static_entries.find(ActVlanStaticEntry(100));
+  ASSERT_NE(vlan_static_entries.end(), it);
+  EXPECT_EQ("v100", it->GetName());
+  EXPECT_EQ(1, it->GetRowStatus());
+  EXPECT_EQ(QSet<qint64>({1, 2}), it->GetEgressPorts());
+
+  // Destroy
+  vlan_static_entry.SetRowStatus(6);
+  ASSERT_TRUE(IsActStatusSuccess(snmp_handler.SetDot1qVlanStatic(device, snmp, {vlan_static_entry})));
+  ASSERT_TRUE(IsActStatusSuccess(snmp_handler.GetDot1qVlanStatic(device, snmp, vlan_static_entries)));
+  ASSERT_EQ(1, vlan_static_entries.size());
+  EXPECT_EQ(1, vlan_static_entries.begin()->GetVlanId());
+}
+
+}  // namespace simulator
+}  // namespace act
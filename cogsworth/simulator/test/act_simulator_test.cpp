@@ -0,0 +1,363 @@
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include "act_simulator_config.hpp"
+#include "act_simulator_restful.hpp"
+#include "act_simulator_snmp.hpp"
+#include "act_unit_test.hpp"
+
+namespace act {
+namespace simulator {
+
+class ActSimulatorTest : public ActQuickTest {
+ protected:
+  ActSimulatorConfig config;
+  QList<ActSimulatedDevice> devices;
+  QMap<qint64, ActSimulatedDevice> fleet;
+
+  void SetUp() override {
+    config.SetDeviceCount(4);
+    config.SetTopology(ActSimulatorTopologyEnum::kRing);
+    ACT_STATUS act_status = GenerateSimulatedFleet(config, devices);
+    ASSERT_TRUE(IsActStatusSuccess(act_status));
+    for (const auto &device : devices) {
+      fleet.insert(device.GetId(), device);
+    }
+  }
+
+  ActSnmpMessage Request(const ActSnmpPduTypeEnum &pdu_type, const QStringList &oids,
+                         const ActSnmpWireVersionEnum &version = ActSnmpWireVersionEnum::kV2c) {
+    ActSnmpMessage message;
+    message.version = static_cast<qint64>(version);
+    message.community = "public";
+    message.pdu_type = pdu_type;
+    message.request_id = 1234;
+    for (const auto &oid : oids) {
+      ActSnmpVarBind var_bind;
+      ParseSnmpOid(oid, var_bind.oid);
+      var_bind.value = ActSnmpValue::Exception(ActSnmpTypeEnum::kNull);
+      message.var_binds.append(var_bind);
+    }
+    return message;
+  }
+
+  bool Send(ActSnmpAgentSimulator &agent, const ActSnmpMessage &request, ActSnmpMessage &response) {
+    QByteArray datagram;
+    if (!agent.HandleRequest(EncodeSnmpMessage(request), datagram)) {
+      return false;
+    }
+    return DecodeSnmpMessage(datagram, response);
+  }
+};
+
+TEST_F(ActSimulatorTest, TestRingFleet) {
+  ASSERT_EQ(4, devices.size());
+  EXPECT_EQ("127.0.1.1", devices.first().GetIpAddress());
+  EXPECT_EQ("127.0.1.4", devices.last().GetIpAddress());
+  EXPECT_EQ("00:90:E8:00:00:04", devices.last().GetMacAddress());
+
+  // Each device of the ring has two neighbors, and the links are symmetric
+  for (const auto &device : devices) {
+    EXPECT_EQ(2, device.GetNeighbors().size());
+    for (const auto &neighbor : device.GetNeighbors()) {
+      bool found = false;
+      for (const auto &remote_neighbor : fleet[neighbor.GetRemoteDeviceId()].GetNeighbors()) {
+        found |= (remote_neighbor.GetRemoteDeviceId() == device.GetId()) &&
+                 (remote_neighbor.GetLocalPort() == neighbor.GetRemotePort()) &&
+                 (remote_neighbor.GetRemotePort() == neighbor.GetLocalPort());
+      }
+      EXPECT_TRUE(found);
+    }
+  }
+}
+
+TEST_F(ActSimulatorTest, TestTreeFleet) {
+  config.SetDeviceCount(15);
+  config.SetPortCount(3);
+  config.SetTopology(ActSimulatorTopologyEnum::kTree);
+  ACT_STATUS act_status = GenerateSimulatedFleet(config, devices);
+  ASSERT_TRUE(IsActStatusSuccess(act_status));
+
+  // The binary tree: the root has 2 children, the leaves have the uplink only
+  EXPECT_EQ(2, devices.first().GetNeighbors().size());
+  EXPECT_EQ(3, devices[1].GetNeighbors().size());
+  EXPECT_EQ(1, devices.last().GetNeighbors().size());
+  EXPECT_EQ(1, devices.last().GetNeighbors().first().GetLocalPort());
+}
+
+TEST_F(ActSimulatorTest, TestConfiguredFleet) {
+  ActSimulatedDevice device_a;
+  device_a.SetId(10);
+  device_a.SetIpAddress("127.0.2.1");
+  device_a.GetNeighbors().append(ActSimulatedNeighbor(3, 20, 5));
+  ActSimulatedDevice device_b;
+  device_b.SetId(20);
+  device_b.SetIpAddress("127.0.2.2");
+  config.SetDevices({device_a, device_b});
+
+  ACT_STATUS act_status = GenerateSimulatedFleet(config, devices);
+  ASSERT_TRUE(IsActStatusSuccess(act_status));
+  ASSERT_EQ(1, devices.last().GetNeighbors().size());
+  EXPECT_EQ(5, devices.last().GetNeighbors().first().GetLocalPort());
+  EXPECT_EQ(10, devices.last().GetNeighbors().first().GetRemoteDeviceId());
+
+  device_a.GetNeighbors().append(ActSimulatedNeighbor(4, 30, 1));
+  config.SetDevices({device_a, device_b});
+  act_status = GenerateSimulatedFleet(config, devices);
+  EXPECT_TRUE(IsActStatusFailed(act_status));
+}
+
+TEST_F(ActSimulatorTest, TestInvalidConfig) {
+  config.SetDeviceCount(0);
+  ACT_STATUS act_status = GenerateSimulatedFleet(config, devices);
+  EXPECT_TRUE(IsActStatusFailed(act_status));
+
+  config.SetDeviceCount(10);
+  config.SetBaseIp("fleet");
+  act_status = GenerateSimulatedFleet(config, devices);
+  EXPECT_TRUE(IsActStatusFailed(act_status));
+}
+
+TEST_F(ActSimulatorTest, TestSnmpMessageRoundTrip) {
+  ActSnmpMessage message = Request(ActSnmpPduTypeEnum::kGetResponse, {"1.3.6.1.2.1.1.3.0", "1.3.6.1.2.1.1.2.0"});
+  message.var_binds[0].value = ActSnmpValue::Unsigned(ActSnmpTypeEnum::kTimeTicks, 4294967295U);
+  message.var_binds[1].value = ActSnmpValue::Integer(-129);
+
+  ActSnmpMessage decoded;
+  ASSERT_TRUE(DecodeSnmpMessage(EncodeSnmpMessage(message), decoded));
+  EXPECT_EQ(message.request_id, decoded.request_id);
+  EXPECT_EQ(message.community, decoded.community);
+  ASSERT_EQ(2, decoded.var_binds.size());
+  EXPECT_EQ("1.3.6.1.2.1.1.3.0", SnmpOidToString(decoded.var_binds[0].oid));
+  EXPECT_EQ(4294967295LL, decoded.var_binds[0].value.ToInteger());
+  EXPECT_EQ(-129, decoded.var_binds[1].value.ToInteger());
+
+  EXPECT_FALSE(DecodeSnmpMessage(QByteArray("\x30\x05\x02\x01", 4), decoded));
+}
+
+TEST_F(ActSimulatorTest, TestSnmpGet) {
+  ActSnmpAgentSimulator agent(devices.first(), fleet, config.GetReadCommunity(), config.GetWriteCommunity());
+
+  ActSnmpMessage response;
+  ASSERT_TRUE(Send(agent, Request(ActSnmpPduTypeEnum::kGetRequest, {"1.3.6.1.2.1.1.5.0", "1.3.6.1.2.1.1.99.0"}),
+                   response));
+  EXPECT_EQ(1234, response.request_id);
+  ASSERT_EQ(2, response.var_binds.size());
+  EXPECT_EQ("Device-001", QString::fromUtf8(response.var_binds[0].value.content));
+  EXPECT_EQ(ActSnmpTypeEnum::kNoSuchObject, response.var_binds[1].value.type);
+
+  // v1 reports the missing object by noSuchName
+  ASSERT_TRUE(Send(agent,
+                   Request(ActSnmpPduTypeEnum::kGetRequest, {"1.3.6.1.2.1.1.5.0", "1.3.6.1.2.1.1.99.0"},
+                           ActSnmpWireVersionEnum::kV1),
+                   response));
+  EXPECT_EQ(static_cast<qint64>(ActSnmpErrorStatusEnum::kNoSuchName), response.error_status);
+  EXPECT_EQ(2, response.error_index);
+}
+
+TEST_F(ActSimulatorTest, TestSnmpWrongCommunity) {
+  ActSnmpAgentSimulator agent(devices.first(), fleet, config.GetReadCommunity(), config.GetWriteCommunity());
+
+  ActSnmpMessage request = Request(ActSnmpPduTypeEnum::kGetRequest, {"1.3.6.1.2.1.1.5.0"});
+  request.community = "wrong";
+  ActSnmpMessage response;
+  EXPECT_FALSE(Send(agent, request, response));
+
+  // Set needs the write community
+  request = Request(ActSnmpPduTypeEnum::kSetRequest, {"1.3.6.1.2.1.1.5.0"});
+  request.var_binds[0].value = ActSnmpValue::OctetString("Renamed");
+  EXPECT_FALSE(Send(agent, request, response));
+}
+
+TEST_F(ActSimulatorTest, TestSnmpWalkLldpRemoteTable) {
+  ActSnmpAgentSimulator agent(devices[1], fleet, config.GetReadCommunity(), config.GetWriteCommunity());
+
+  // Walk lldpRemSysName (the ring device's neighbors are on port 1 & port 2)
+  const QString column("1.0.8802.1.1.2.1.4.1.1.9");
+  ActSnmpOid column_oid;
+  ParseSnmpOid(column, column_oid);
+  QStringList names;
+  QString oid = column;
+  while (true) {
+    ActSnmpMessage response;
+    ASSERT_TRUE(Send(agent, Request(ActSnmpPduTypeEnum::kGetNextRequest, {oid}), response));
+    const ActSnmpVarBind &var_bind = response.var_binds.first();
+    if (var_bind.oid.mid(0, column_oid.size()) != column_oid) {
+      break;
+    }
+    names.append(QString::fromUtf8(var_bind.value.content));
+    oid = SnmpOidToString(var_bind.oid);
+  }
+  EXPECT_EQ(QStringList({"Device-001", "Device-003"}), names);
+
+  // The end of the MIB
+  ActSnmpMessage response;
+  ASSERT_TRUE(Send(agent, Request(ActSnmpPduTypeEnum::kGetNextRequest, {"2"}), response));
+  EXPECT_EQ(ActSnmpTypeEnum::kEndOfMibView, response.var_binds.first().value.type);
+}
+
+TEST_F(ActSimulatorTest, TestSnmpGetBulk) {
+  ActSnmpAgentSimulator agent(devices.first(), fleet, config.GetReadCommunity(), config.GetWriteCommunity());
+
+  ActSnmpMessage request = Request(ActSnmpPduTypeEnum::kGetBulkRequest, {"1.3.6.1.2.1.1.1.0", "1.3.6.1.2.1.2.2.1.2"});
+  request.error_status = 1;  // non-repeaters
+  request.error_index = 3;   // max-repetitions
+  ActSnmpMessage response;
+  ASSERT_TRUE(Send(agent, request, response));
+  ASSERT_EQ(4, response.var_binds.size());
+  EXPECT_EQ("1.3.6.1.2.1.1.2.0", SnmpOidToString(response.var_binds[0].oid));
+  EXPECT_EQ("1.3.6.1.2.1.2.2.1.2.1", SnmpOidToString(response.var_binds[1].oid));
+  EXPECT_EQ("1.3.6.1.2.1.2.2.1.2.3", SnmpOidToString(response.var_binds[3].oid));
+}
+
+TEST_F(ActSimulatorTest, TestSnmpQBridge) {
+  ActSnmpAgentSimulator agent(devices[1], fleet, config.GetReadCommunity(), config.GetWriteCommunity());
+
+  // The FDB learns the neighbors (FdbId 1, the MAC of Device-001 on the port 1)
+  ActSnmpMessage response;
+  ASSERT_TRUE(Send(agent, Request(ActSnmpPduTypeEnum::kGetRequest, {"1.3.6.1.2.1.17.7.1.2.2.1.2.1.0.144.232.0.0.1"}),
+                   response));
+  EXPECT_EQ(1, response.var_binds.first().value.ToInteger());
+
+  // Create the VLAN 100 (createAndWait then active in one PDU, as the southbound does)
+  ActSnmpMessage request = Request(ActSnmpPduTypeEnum::kSetRequest,
+                                   {"1.3.6.1.2.1.17.7.1.4.3.1.5.100", "1.3.6.1.2.1.17.7.1.4.3.1.5.100",
+                                    "1.3.6.1.2.1.17.7.1.4.3.1.1.100", "1.3.6.1.2.1.17.7.1.4.3.1.2.100"});
+  request.community = "private";
+  request.var_binds[0].value = ActSnmpValue::Integer(5);
+  request.var_binds[1].value = ActSnmpValue::Integer(1);
+  request.var_binds[2].value = ActSnmpValue::OctetString("v100");
+  request.var_binds[3].value = ActSnmpValue::OctetString(QByteArray(1, static_cast<char>(0xC0)));
+  ASSERT_TRUE(Send(agent, request, response));
+  EXPECT_EQ(static_cast<qint64>(ActSnmpErrorStatusEnum::kNoError), response.error_status);
+  ASSERT_TRUE(Send(agent, Request(ActSnmpPduTypeEnum::kGetRequest, {"1.3.6.1.2.1.17.7.1.4.3.1.5.100"}), response));
+  EXPECT_EQ(1, response.var_binds.first().value.ToInteger());
+
+  // The other missing objects are still not writable
+  request = Request(ActSnmpPduTypeEnum::kSetRequest, {"1.3.6.1.2.1.1.99.0"});
+  request.community = "private";
+  request.var_binds[0].value = ActSnmpValue::Integer(1);
+  ASSERT_TRUE(Send(agent, request, response));
+  EXPECT_EQ(static_cast<qint64>(ActSnmpErrorStatusEnum::kNotWritable), response.error_status);
+
+  // Destroy removes the whole row
+  request = Request(ActSnmpPduTypeEnum::kSetRequest, {"1.3.6.1.2.1.17.7.1.4.3.1.5.100"});
+  request.community = "private";
+  request.var_binds[0].value = ActSnmpValue::Integer(6);
+  ASSERT_TRUE(Send(agent, request, response));
+  ASSERT_TRUE(Send(agent, Request(ActSnmpPduTypeEnum::kGetNextRequest, {"1.3.6.1.2.1.17.7.1.4.3.1.1.1"}), response));
+  EXPECT_EQ("1.3.6.1.2.1.17.7.1.4.3.1.2.1", SnmpOidToString(response.var_binds.first().oid));
+}
+
+TEST_F(ActSimulatorTest, TestRestfulLogin) {
+  ActRestfulDeviceSimulator restful_device(devices.first(), config.GetUsername(), config.GetPassword());
+
+  ActHttpRequest request;
+  request.method = "GET";
+  request.path = "api/v1/setting/data/systemInformation/deviceName";
+  QByteArray body;
+  EXPECT_EQ(401, restful_device.HandleRequest(request, body));
+
+  ActHttpRequest login;
+  const QByteArray raw("POST /api/v1/auth/login HTTP/1.1\r\nContent-Length: 39\r\n\r\n"
+                       R"({"username":"admin","password":"moxa"})"
+                       "GET /static/modelName HTTP/1.1\r\n");
+  const qint32 consumed = ParseHttpRequest(raw, login);
+  ASSERT_GT(consumed, 0);
+  EXPECT_EQ(0, ParseHttpRequest(raw.mid(consumed), login));  // incomplete
+  ASSERT_EQ(200, restful_device.HandleRequest(login, body));
+  const QString token = QJsonDocument::fromJson(body).object().value("access_token").toString();
+  ASSERT_FALSE(token.isEmpty());
+
+  request.headers.insert("authorization", "Bearer " + token);
+  ASSERT_EQ(200, restful_device.HandleRequest(request, body));
+  EXPECT_EQ(QByteArray("\"Device-001\""), body);
+}
+
+TEST_F(ActSimulatorTest, TestRestfulPatch) {
+  ActRestfulDeviceSimulator restful_device(devices.first(), config.GetUsername(), config.GetPassword());
+
+  ActHttpRequest login;
+  login.method = "POST";
+  login.path = "api/v1/auth/login";
+  login.body = R"({"username":"admin","password":"moxa"})";
+  QByteArray body;
+  ASSERT_EQ(200, restful_device.HandleRequest(login, body));
+  const QString token = QJsonDocument::fromJson(body).object().value("access_token").toString();
+
+  ActHttpRequest request;
+  request.method = "PATCH";
+  request.path = "api/v1/status/SyncInvalid";
+  request.headers.insert("authorization", "Bearer " + token);
+  request.body = R"({"vlan":true})";
+  ASSERT_EQ(200, restful_device.HandleRequest(request, body));
+
+  request.method = "GET";
+  ASSERT_EQ(200, restful_device.HandleRequest(request, body));
+  const QJsonObject sync_invalid = QJsonDocument::fromJson(body).object();
+  EXPECT_TRUE(sync_invalid.value("vlan").toBool());
+  EXPECT_FALSE(sync_invalid.value("frer").toBool());
+
+  // The member of the object resource
+  request.method = "PATCH";
+  request.path = "api/v1/setting/data/systemInformation/deviceName";
+  request.body = R"("Renamed")";
+  ASSERT_EQ(200, restful_device.HandleRequest(request, body));
+  request.method = "GET";
+  request.path = "api/v1/setting/data/systemInformation";
+  ASSERT_EQ(200, restful_device.HandleRequest(request, body));
+  EXPECT_EQ("Renamed", QJsonDocument::fromJson(body).object().value("deviceName").toString());
+}
+
+TEST_F(ActSimulatorTest, TestRestfulVlanCommands) {
+  ActRestfulDeviceSimulator restful_device(devices.first(), config.GetUsername(), config.GetPassword());
+
+  ActHttpRequest login;
+  login.method = "POST";
+  login.path = "api/v1/auth/login";
+  login.body = R"({"username":"admin","password":"moxa"})";
+  QByteArray body;
+  ASSERT_EQ(200, restful_device.HandleRequest(login, body));
+  const QString token = QJsonDocument::fromJson(body).object().value("access_token").toString();
+
+  ActHttpRequest request;
+  request.headers.insert("authorization", "Bearer " + token);
+  request.method = "POST";
+  ASSERT_GT(ParseHttpRequest("POST /api/v1/setting/agent/vlan/portConfigs?ifindices=0,2&save=true HTTP/1.1\r\n"
+                             "Content-Length: 10\r\n\r\n"
+                             R"({"pvid":5})",
+                             request),
+            0);
+  EXPECT_EQ("0,2", request.query.value("ifindices"));
+  request.headers.insert("authorization", "Bearer " + token);
+  ASSERT_EQ(200, restful_device.HandleRequest(request, body));
+
+  request.method = "POST";
+  request.path = "api/v1/setting/agent/vlan/vlanIds";
+  request.body = R"([{"vid":5,"vlanName":"v5"}])";
+  ASSERT_EQ(200, restful_device.HandleRequest(request, body));
+
+  request.method = "GET";
+  request.path = "api/v1/setting/data/stdvlan";
+  ASSERT_EQ(200, restful_device.HandleRequest(request, body));
+  const QJsonObject std_vlan = QJsonDocument::fromJson(body).object();
+  EXPECT_EQ(2, std_vlan.value("vlanTable").toArray().size());
+  const QJsonArray port_table = std_vlan.value("portTable").toArray();
+  ASSERT_EQ(static_cast<qint32>(config.GetPortCount()), port_table.size());
+  EXPECT_EQ(5, port_table.at(0).toObject().value("pvid").toInt());
+  EXPECT_EQ(1, port_table.at(1).toObject().value("pvid").toInt());
+  EXPECT_EQ(5, port_table.at(2).toObject().value("pvid").toInt());
+
+  request.method = "DELETE";
+  request.path = "api/v1/setting/agent/vlan/vlanIds";
+  request.query = {{"vids", "5"}};
+  ASSERT_EQ(200, restful_device.HandleRequest(request, body));
+  request.method = "GET";
+  request.path = "api/v1/setting/data/stdvlan/vlanTable";
+  ASSERT_EQ(200, restful_device.HandleRequest(request, body));
+  EXPECT_EQ(1, QJsonDocument::fromJson(body).array().size());
+}
+
+}  // namespace simulator
+}  // namespace act
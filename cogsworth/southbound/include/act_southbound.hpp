@@ -26,11 +26,14 @@ See the file MOXA-SOFTWARE-NOTICE for details.
 #include "deploy_entry/act_vlan_static_entry.hpp"
 #include "topology/act_auto_scan_result.hpp"
 
-#define ACT_VENDOR_ID_MOXA (8691)    ///< The vendor_id of the moxa
-#define ACT_VENDOR_MOXA "MOXA"       ///< The vendor of the moxa
-#define ACT_PING_TIMEOUT (1000)      ///< The timeout(ms, 1 second) of the ping
-#define ACT_PING_TIMEOUT_SECOND (1)  ///< The timeout of the ping for linux second
-#define ACT_PING_REPEAT_TIMES (3)    ///< The repeat times of the ping
+#define ACT_VENDOR_ID_MOXA (8691)                  ///< The vendor_id of the moxa
+#define ACT_VENDOR_MOXA "MOXA"                     ///< The vendor of the moxa
+#define ACT_PING_TIMEOUT (1000)                    ///< The timeout(ms, 1 second) of the ping
+#define ACT_PING_TIMEOUT_SECOND (1)                ///< The timeout of the ping for linux second
+#define ACT_PING_REPEAT_TIMES (3)                  ///< The repeat times of the ping
+#define ACT_PING_READY_TIMEOUT (10000)             ///< The timeout(ms) of waiting the IP reachable after changed
+#define ACT_NETCONF_VLAN_SYNC_TIMEOUT (3000)       ///< The timeout(ms) of waiting the switch sync to NETCONF VLAN DB
+#define ACT_NETCONF_VLAN_SYNC_INITIAL_DELAY (300)  ///< The delay(ms) before the first sync status check
 #define ACT_ARP_ENTRY_DYNAMIC "3"
 #define ACT_ARP_ENTRY_STATIC "4"
 #define ACT_AUTOSCAN_ASSIGN_INTERFACE_NAME "Port"  ///< The Interface Name by auto_scan assign
@@ -56,6 +59,7 @@ class ActSouthbound {
   ACT_JSON_OBJECT(ActProfiles, profiles, Profiles);  ///< Profiles item
 
  private:
+  QMutex probe_cache_mutex_;  ///< The probe caches are shared by the concurrent probes
   QSet<QString> probe_success_oid_cache_;
   QSet<QString> probe_yang_cache_;
 
@@ -461,6 +465,66 @@ class ActSouthbound {
    */
   ACT_STATUS PingIpAddress(const QString &ip, const quint8 &times);
 
+  /**
+   * @brief Wait until the IpAddress is reachable (replaces the fixed sleep before the ping)
+   *
+   * @param ip
+   * @param timeout the deadline(ms)
+   * @return ACT_STATUS
+   */
+  ACT_STATUS WaitIpAddressReachable(const QString &ip, const quint32 &timeout = ACT_PING_READY_TIMEOUT);
+
+  /**
+   * @brief Wait until the written port PVIDs are read back from the device (e.g. the NETCONF VLAN DB is updated)
+   *
+   * @param device
+   * @param feat_sub_item
+   * @param port_vlan_table the written table
+   * @param timeout the deadline(ms)
+   * @return ACT_STATUS
+   */
+  ACT_STATUS WaitPortPVIDApplied(const ActDevice &device, const ActFeatureSubItem &feat_sub_item,
+                                 const ActPortVlanTable &port_vlan_table,
+                                 const quint32 &timeout = ACT_NETCONF_VLAN_SYNC_TIMEOUT);
+
+  /**
+   * @brief Wait until the deleted StaticForward entries are gone from the device's tables
+   *
+   * The sub item without any deleted entry is skipped.
+   *
+   * @param device
+   * @param uni_sub_item
+   * @param uni_remove_table the deleted unicast entries
+   * @param mul_sub_item
+   * @param mul_remove_table the deleted multicast entries
+   * @param timeout the deadline(ms)
+   * @return ACT_STATUS
+   */
+  ACT_STATUS WaitStaticForwardDeleted(const ActDevice &device, const ActFeatureSubItem &uni_sub_item,
+                                      const ActStaticForwardTable &uni_remove_table,
+                                      const ActFeatureSubItem &mul_sub_item,
+                                      const ActStaticForwardTable &mul_remove_table,
+                                      const quint32 &timeout = ACT_NETCONF_VLAN_SYNC_TIMEOUT);
+
+  /**
+   * @brief Wait until the written VLANs and VLAN port types are read back from the device
+   *
+   * The added VLANs must exist and the deleted VLANs must be gone. The empty sub item is skipped.
+   *
+   * @param device
+   * @param vlan_sub_item
+   * @param edit_vlan_table the written VLANs
+   * @param vlan_port_type_sub_item
+   * @param vlan_port_type_table the written table
+   * @param timeout the deadline(ms)
+   * @return ACT_STATUS
+   */
+  ACT_STATUS WaitVLANApplied(const ActDevice &device, const ActFeatureSubItem &vlan_sub_item,
+                             const ActEditVlanStaticTable &edit_vlan_table,
+                             const ActFeatureSubItem &vlan_port_type_sub_item,
+                             const ActVlanPortTypeTable &vlan_port_type_table,
+                             const quint32 &timeout = ACT_NETCONF_VLAN_SYNC_TIMEOUT);
+
   // /**
   //  * @brief Set the Device SysName object
   //  *
@@ -928,12 +992,14 @@ class ActSouthbound {
    * @param profiles
    * @param result_device_profile
    * @param result_firmware_feature_profile
+   * @param result_firmware
    * @return ACT_STATUS
    */
   ACT_STATUS FeatureIdentifyDeviceAndGetProfilesByProbe(const bool &use_feature_profile, ActDevice &device,
                                                         const ActProfiles &profiles,
                                                         ActDeviceProfile &result_device_profile,
-                                                        ActFirmwareFeatureProfile &result_firmware_feature_profile);
+                                                        ActFirmwareFeatureProfile &result_firmware_feature_profile,
+                                                        QString &result_firmware);
 
   /**
    * @brief Get TSN-Switch Configuration sync status
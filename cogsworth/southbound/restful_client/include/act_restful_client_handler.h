@@ -15,6 +15,9 @@ See the file MOXA-SOFTWARE-NOTICE for details.
 #ifndef ACT_RESTFUL_CLIENT_HANDLER_H
 #define ACT_RESTFUL_CLIENT_HANDLER_H
 #define ACT_SERVICE_UNAVAILABLE_SLEEP_TIME (2000)
+#define ACT_RESTFUL_LOGIN_RETRY_INTERVAL (200)   ///< The interval(ms) to retry the login answered UNAUTHORIZED(401)
+#define ACT_RESTFUL_LOGIN_RETRY_TIMEOUT (400)    ///< The time(ms) to retry the login answered UNAUTHORIZED(401)
+#define ACT_RESTFUL_ACCOUNT_SYNC_TIMEOUT (3000)  ///< The timeout(ms) of waiting the patched account to log in
 
 // #define ACT_RESTFUL_CLIENT_HTTP_PORT 80  /// < The restful client
 
@@ -5,13 +5,14 @@
 #include <QTime>
 
 #include "act_core.hpp"
+#include "act_readiness_probe.hpp"
 
 #ifdef _WIN32
 #include <windows.h>
 #define SLEEP_MS(ms) Sleep(ms)
 #else
 #include <unistd.h>  // for sleep
-#define SLEEP_MS(ms) sleep(ms / 1000)
+#define SLEEP_MS(ms) usleep((ms) * 1000)
 #endif
 
 // #include "oatpp-curl/RequestExecutor.hpp"
@@ -42,9 +43,16 @@ ACT_STATUS ActRestfulClientHandler::LoginAndUpdateCoreToken(ActMoxaIEIClientAgen
   ActClientLoginRequest login_request(device.GetAccount().GetUsername(), device.GetAccount().GetPassword());
   act_status = client_agent.Login(login_request);
   if (IsActStatusUnauthorized(act_status)) {
-    SLEEP_MS(500);  // wait 0.5 second
     qWarning() << __func__ << "Login response as UNAUTHORIZED(401) would try again";
-    act_status = client_agent.Login(login_request);
+
+    // Retry until the login is not UNAUTHORIZED, only a few times to not lock the account out
+    ActReadinessProbe probe(QString("Device(%1) login").arg(device.GetIpv4().GetIpAddress()),
+                            ACT_RESTFUL_LOGIN_RETRY_TIMEOUT, ACT_RESTFUL_LOGIN_RETRY_INTERVAL);
+    probe.SetInitialDelay(ACT_RESTFUL_LOGIN_RETRY_INTERVAL);
+    probe.Wait([&client_agent, &login_request, &act_status]() {
+      act_status = client_agent.Login(login_request);
+      return !IsActStatusUnauthorized(act_status);
+    });
   }
 
   if (!IsActStatusSuccess(act_status)) {
@@ -1585,16 +1593,14 @@ ACT_STATUS ActRestfulClientHandler::SetUserAccount(const ActDevice &device, cons
     break;
   }
 
-  // Use the New Admin Account login
-  auto retry_times = 3;
-  while (retry_times > 0) {
-    retry_times = retry_times - 1;
-    SLEEP_MS(1000);  // wait dut update db
+  // Use the New Admin Account login, until the dut updates its account db
+  ActReadinessProbe probe(QString("Device(%1) account sync").arg(device.GetIpv4().GetIpAddress()),
+                          ACT_RESTFUL_ACCOUNT_SYNC_TIMEOUT, ACT_RESTFUL_LOGIN_RETRY_INTERVAL * 3);
+  probe.SetInitialDelay(ACT_RESTFUL_LOGIN_RETRY_INTERVAL);
+  probe.Wait([this, &client_agent, &tmp_new_device, &act_status]() {
     act_status = LoginAndUpdateCoreToken(client_agent, tmp_new_device);
-    if (IsActStatusSuccess(act_status)) {
-      break;
-    }
-  }
+    return IsActStatusSuccess(act_status);
+  });
 
   // Delete not using UserAccount
   for (auto dut_account_key : dut_old_accounts) {
@@ -8,6 +8,7 @@
 
 // #include "act_core.hpp"
 #include "act_new_moxa_command_handler.h"
+#include "act_readiness_probe.hpp"
 #include "act_restful_client_handler.h"
 #include "act_snmp_handler.h"
 #include "act_system.hpp"
@@ -36,7 +37,7 @@
 #define SLEEP_MS(ms) Sleep(ms)
 #else
 #include <unistd.h>  // for sleep
-#define SLEEP_MS(ms) sleep(ms / 1000)
+#define SLEEP_MS(ms) usleep((ms) * 1000)
 #endif
 
 ACT_STATUS ActSouthbound::InitSnmpResource() {
@@ -57,6 +58,7 @@ ACT_STATUS ActSouthbound::ClearSnmpResource() {
 
 ACT_STATUS ActSouthbound::InitProbeCache() {
   ACT_STATUS_INIT();
+  QMutexLocker lock(&probe_cache_mutex_);
   // SNMP
   probe_success_oid_cache_.clear();
 
@@ -111,6 +113,172 @@ ACT_STATUS ActSouthbound::PingIpAddress(const QString &ip, const quint8 &times)
   return std::make_shared<ActStatusSouthboundFailed>(QString("PING %1 device failed").arg(ip));
 }
 
+ACT_STATUS ActSouthbound::WaitIpAddressReachable(const QString &ip, const quint32 &timeout) {
+  ACT_STATUS_INIT();
+
+  // Each ping waits ACT_PING_TIMEOUT itself, so the probe starts with a short interval
+  ActReadinessProbe probe(QString("PING %1").arg(ip), timeout);
+  act_status = probe.Wait(
+      [this, &ip]() {
+        auto ping_status = PingIpAddress(ip, 1);
+        return IsActStatusSuccess(ping_status);
+      },
+      &stop_flag_);
+  if (IsActStatusStop(act_status)) {
+    return act_status;
+  }
+  if (!IsActStatusSuccess(act_status)) {
+    return std::make_shared<ActStatusSouthboundFailed>(QString("PING %1 device failed").arg(ip));
+  }
+
+  return act_status;
+}
+
+ACT_STATUS ActSouthbound::WaitPortPVIDApplied(const ActDevice &device, const ActFeatureSubItem &feat_sub_item,
+                                              const ActPortVlanTable &port_vlan_table, const quint32 &timeout) {
+  ACT_STATUS_INIT();
+
+  QMap<qint64, quint16> written_pvids;  // <PortId, PVID>
+  for (auto entry : port_vlan_table.GetPortVlanEntries()) {
+    written_pvids.insert(entry.GetPortId(), entry.GetPVID());
+  }
+
+  ActReadinessProbe probe(QString("Device(%1) port PVID").arg(device.GetIpv4().GetIpAddress()), timeout);
+  probe.SetInitialDelay(ACT_NETCONF_VLAN_SYNC_INITIAL_DELAY);
+  act_status = probe.Wait(
+      [this, &device, &feat_sub_item, &written_pvids]() {
+        ActPortVlanTable read_table(device.GetId());
+        if (!IsActStatusSuccess(ActionGetPortPVID(device, feat_sub_item, read_table))) {
+          return false;
+        }
+
+        QMap<qint64, quint16> read_pvids;
+        for (auto entry : read_table.GetPortVlanEntries()) {
+          read_pvids.insert(entry.GetPortId(), entry.GetPVID());
+        }
+        for (auto it = written_pvids.cbegin(); it != written_pvids.cend(); it++) {
+          if (!read_pvids.contains(it.key()) || read_pvids[it.key()] != it.value()) {
+            return false;
+          }
+        }
+        return true;
+      },
+      &stop_flag_);
+
+  return act_status;
+}
+
+ACT_STATUS ActSouthbound::WaitStaticForwardDeleted(const ActDevice &device, const ActFeatureSubItem &uni_sub_item,
+                                                   const ActStaticForwardTable &uni_remove_table,
+                                                   const ActFeatureSubItem &mul_sub_item,
+                                                   const ActStaticForwardTable &mul_remove_table,
+                                                   const quint32 &timeout) {
+  ACT_STATUS_INIT();
+
+  const bool check_unicast =
+      !uni_sub_item.GetMethods().isEmpty() && !uni_remove_table.GetStaticForwardEntries().isEmpty();
+  const bool check_multicast =
+      !mul_sub_item.GetMethods().isEmpty() && !mul_remove_table.GetStaticForwardEntries().isEmpty();
+  if (!check_unicast && !check_multicast) {
+    return act_status;
+  }
+
+  // The entries are compared by the VLAN & MAC, so any deleted entry read back is not synced yet
+  auto deleted = [](const ActStaticForwardTable &read_table, const ActStaticForwardTable &remove_table) {
+    for (auto entry : remove_table.GetStaticForwardEntries()) {
+      if (read_table.GetStaticForwardEntries().contains(entry)) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  ActReadinessProbe probe(QString("Device(%1) StaticForward").arg(device.GetIpv4().GetIpAddress()), timeout);
+  probe.SetInitialDelay(ACT_NETCONF_VLAN_SYNC_INITIAL_DELAY);
+  act_status = probe.Wait(
+      [&]() {
+        if (check_unicast) {
+          ActStaticForwardTable read_table(device.GetId());
+          if (!IsActStatusSuccess(ActionGetStaticUnicast(device, uni_sub_item, read_table)) ||
+              !deleted(read_table, uni_remove_table)) {
+            return false;
+          }
+        }
+
+        if (check_multicast) {
+          ActStaticForwardTable read_table(device.GetId());
+          if (!IsActStatusSuccess(ActionGetStaticMulticast(device, mul_sub_item, read_table)) ||
+              !deleted(read_table, mul_remove_table)) {
+            return false;
+          }
+        }
+        return true;
+      },
+      &stop_flag_);
+
+  return act_status;
+}
+
+ACT_STATUS ActSouthbound::WaitVLANApplied(const ActDevice &device, const ActFeatureSubItem &vlan_sub_item,
+                                          const ActEditVlanStaticTable &edit_vlan_table,
+                                          const ActFeatureSubItem &vlan_port_type_sub_item,
+                                          const ActVlanPortTypeTable &vlan_port_type_table, const quint32 &timeout) {
+  ACT_STATUS_INIT();
+
+  QMap<qint64, ActVlanPortTypeEnum> written_port_types;  // <PortId, VlanPortType>
+  for (auto entry : vlan_port_type_table.GetVlanPortTypeEntries()) {
+    written_port_types.insert(entry.GetPortId(), entry.GetVlanPortType());
+  }
+
+  ActReadinessProbe probe(QString("Device(%1) VLAN").arg(device.GetIpv4().GetIpAddress()), timeout);
+  probe.SetInitialDelay(ACT_NETCONF_VLAN_SYNC_INITIAL_DELAY);
+  act_status = probe.Wait(
+      [&]() {
+        if (!vlan_sub_item.GetMethods().isEmpty()) {
+          ActVlanStaticTable read_vlan_table(device.GetId());
+          if (!IsActStatusSuccess(ActionGetVLAN(device, vlan_sub_item, read_vlan_table))) {
+            return false;
+          }
+
+          QSet<qint32> read_vlans;
+          for (auto entry : read_vlan_table.GetVlanStaticEntries()) {
+            read_vlans.insert(entry.GetVlanId());
+          }
+          for (auto vlan_id : edit_vlan_table.GetAddVlanId()) {
+            if (!read_vlans.contains(vlan_id)) {
+              return false;
+            }
+          }
+          for (auto vlan_id : edit_vlan_table.GetDeleteVlanId()) {
+            if (read_vlans.contains(vlan_id)) {
+              return false;
+            }
+          }
+        }
+
+        if (!vlan_port_type_sub_item.GetMethods().isEmpty()) {
+          ActVlanPortTypeTable read_port_type_table(device.GetId());
+          if (!IsActStatusSuccess(ActionGetVLANPortType(device, vlan_port_type_sub_item, read_port_type_table))) {
+            return false;
+          }
+
+          QMap<qint64, ActVlanPortTypeEnum> read_port_types;
+          for (auto entry : read_port_type_table.GetVlanPortTypeEntries()) {
+            read_port_types.insert(entry.GetPortId(), entry.GetVlanPortType());
+          }
+          for (auto it = written_port_types.cbegin(); it != written_port_types.cend(); it++) {
+            if (!read_port_types.contains(it.key()) || read_port_types[it.key()] != it.value()) {
+              return false;
+            }
+          }
+        }
+        return true;
+      },
+      &stop_flag_);
+
+  return act_status;
+}
+
 ACT_STATUS ActSouthbound::ClearArpCache() {
   ACT_STATUS_INIT();
 
@@ -9,6 +9,7 @@
 
 ACT_STATUS ActSouthbound::InsertMethodToCache(const ActFeatureMethod &feat_method) {
   ACT_STATUS_INIT();
+  QMutexLocker lock(&probe_cache_mutex_);
 
   // SNMP
   auto snmp_str = kActConnectProtocolTypeEnumMap.key(ActConnectProtocolTypeEnum::kSNMP);
@@ -26,6 +27,8 @@ ACT_STATUS ActSouthbound::InsertMethodToCache(const ActFeatureMethod &feat_metho
 }
 
 bool ActSouthbound::CheckMethodHasCache(const ActFeatureMethod &feat_method) {
+  QMutexLocker lock(&probe_cache_mutex_);
+
   // Return empty protocols
   if (feat_method.GetProtocols().isEmpty()) {
     return false;
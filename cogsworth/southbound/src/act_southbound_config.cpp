@@ -7,7 +7,7 @@
 #define SLEEP_MS(ms) Sleep(ms)
 #else
 #include <unistd.h>  // for sleep
-#define SLEEP_MS(ms) sleep(ms / 1000)
+#define SLEEP_MS(ms) usleep((ms) * 1000)
 #endif
 
 ACT_STATUS ActSouthbound::ConfigureNetworkSetting(const ActDevice &device,
@@ -43,9 +43,11 @@ ACT_STATUS ActSouthbound::ConfigureNetworkSetting(const ActDevice &device,
     return ACT_STATUS_STOP;
   }
 
-  // Check icmp status
-  SLEEP_MS(1000);
-  act_status = PingIpAddress(network_setting_table.GetIpAddress(), ACT_PING_REPEAT_TIMES);
+  // Check icmp status (wait until the new IP is reachable)
+  act_status = WaitIpAddressReachable(network_setting_table.GetIpAddress());
+  if (IsActStatusStop(act_status)) {
+    return act_status;
+  }
   if (!IsActStatusSuccess(act_status)) {  // not alive
     qCritical() << __func__ << "Check the New NetworkSetting connect failed.";
     return act_status;
@@ -220,6 +222,16 @@ ACT_STATUS ActSouthbound::ConfigureVlan(const ActDevice &device, const ActVlanTa
     qDebug() << __func__ << "Delete StaticForward(Multicast) entry duration:" << end - start << "ms";
   }
 
+  // [bugfix:2860] Deploy - 802.1CB(FRER) - It should clear old stream id before configure new stream id
+  if (method_protocol == ActConnectProtocolTypeEnum::kNETCONF) {
+    // wait switch sync the deleted StaticForward entries (continue after the timeout, the same as the fixed wait)
+    WaitStaticForwardDeleted(device, static_fwd_uni_sub_item, uni_remove_static_forward_table, static_fwd_mul_sub_item,
+                             mul_remove_static_forward_table);
+    if (stop_flag_) {
+      return ACT_STATUS_STOP;
+    }
+  }
+
   // Set all Port PVID as ACT_VLAN_INIT_PVID(1)
   // Generate the port_vlan_entry_set(PVID = 1)
   if (!port_pvid_sub_item.GetMethods().isEmpty()) {
@@ -245,18 +257,18 @@ ACT_STATUS ActSouthbound::ConfigureVlan(const ActDevice &device, const ActVlanTa
       return ACT_STATUS_STOP;
     }
 
+    if (method_protocol == ActConnectProtocolTypeEnum::kNETCONF) {
+      // wait switch sync the PVIDs to NETCONF VLAN DB (continue after the timeout, the same as the fixed wait)
+      WaitPortPVIDApplied(device, port_pvid_sub_item, default_port_vlan_table);
+      if (stop_flag_) {
+        return ACT_STATUS_STOP;
+      }
+    }
+
     end = QDateTime::currentMSecsSinceEpoch();
     qDebug() << __func__ << "Set all ports PVID as ACT_VLAN_INIT_PVID(1) duration:" << end - start << "ms";
   }
 
-  // [bugfix:2860] Deploy - 802.1CB(FRER) - It should clear old stream id before configure new stream id
-  if (method_protocol == ActConnectProtocolTypeEnum::kNETCONF) {
-    SLEEP_MS(3000);  // wait switch sync to NETCONF VLAN DB
-    if (stop_flag_) {
-      return ACT_STATUS_STOP;
-    }
-  }
-
   // Get Add & Remove VlanStaticTable
   ActEditVlanStaticTable edit_vlan_table;
   if (!vlan_sub_item.GetMethods().isEmpty()) {
@@ -305,9 +317,9 @@ ACT_STATUS ActSouthbound::ConfigureVlan(const ActDevice &device, const ActVlanTa
   }
 
   // Set Vlan Port Type
+  ActVlanPortTypeTable vlan_port_type_table(device.GetId(), vlan_config_table.GetVlanPortTypeEntries());
   if (!vlan_port_type_sub_item.GetMethods().isEmpty()) {
     start = QDateTime::currentMSecsSinceEpoch();
-    ActVlanPortTypeTable vlan_port_type_table(device.GetId(), vlan_config_table.GetVlanPortTypeEntries());
     act_status = GenerateTargetConfigVLANPortTypeTable(device, vlan_port_type_table);
     if (!IsActStatusSuccess(act_status)) {
       qCritical() << __func__ << "GenerateTargetConfigVLANPortTypeTable() failed.";
@@ -337,7 +349,8 @@ ACT_STATUS ActSouthbound::ConfigureVlan(const ActDevice &device, const ActVlanTa
   }
 
   if (method_protocol == ActConnectProtocolTypeEnum::kNETCONF) {
-    SLEEP_MS(3000);  // wait switch sync to NETCONF VLAN DB
+    // wait switch sync the VLANs to NETCONF VLAN DB (continue after the timeout, the same as the fixed wait)
+    WaitVLANApplied(device, vlan_sub_item, edit_vlan_table, vlan_port_type_sub_item, vlan_port_type_table);
     if (stop_flag_) {
       return ACT_STATUS_STOP;
     }
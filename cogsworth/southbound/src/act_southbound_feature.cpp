@@ -563,8 +563,10 @@ ACT_STATUS ActSouthbound::FeatureIdentifyDeviceAndGetProfiles(
 
 ACT_STATUS ActSouthbound::FeatureIdentifyDeviceAndGetProfilesByProbe(
     const bool &use_feature_profile, ActDevice &device, const ActProfiles &profiles,
-    ActDeviceProfile &result_device_profile, ActFirmwareFeatureProfile &result_firmware_feature_profile) {
+    ActDeviceProfile &result_device_profile, ActFirmwareFeatureProfile &result_firmware_feature_profile,
+    QString &result_firmware) {
   ACT_STATUS_INIT();
+  result_firmware = "";
 
   ActIdentifyDeviceInfo identify_device_info;
 
@@ -599,6 +601,7 @@ ACT_STATUS ActSouthbound::FeatureIdentifyDeviceAndGetProfilesByProbe(
 
   auto model_name = identify_device_info.GetModelName();
   auto firmware_version = identify_device_info.GetFirmwareVersion();
+  result_firmware = firmware_version;
   // Find DeviceProfile at profiles->DeviceProfiles
   // First use the ModelName to find
   // -  If found DeviceProfile would return
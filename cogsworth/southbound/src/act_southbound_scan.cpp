@@ -8,7 +8,7 @@
 #define SLEEP_MS(ms) Sleep(ms)
 #else
 #include <unistd.h>  // for sleep
-#define SLEEP_MS(ms) sleep(ms / 1000)
+#define SLEEP_MS(ms) usleep((ms) * 1000)
 #endif
 
 ACT_STATUS ActSouthbound::UpdateDeviceConnectByScanFeature(ActDevice &device) {
@@ -9,7 +9,10 @@ See the file MOXA-SOFTWARE-NOTICE for details.
 #include <QMutex>
 #include <QQueue>
 #include <QString>
+#include <functional>
+#include <memory>
 #include <thread>
+#include <vector>
 
 #include "act_arp_table.hpp"
 #include "act_auto_scan_result.hpp"
@@ -18,6 +21,9 @@ See the file MOXA-SOFTWARE-NOTICE for details.
 #include "act_scan_ip_range.hpp"
 #include "act_southbound.hpp"
 #include "act_status.hpp"
+
+#define ACT_AUTO_SCAN_PARALLELISM (16)  ///< The maximum number of the devices processed concurrently by AutoScan
+
 namespace act {
 namespace topology {
 
@@ -72,6 +78,8 @@ class ActAutoScan {
   QMap<QString, QString> ip_mac_table_;
   QSet<ActDeviceProfile> new_device_profiles_;
 
+  std::vector<std::unique_ptr<ActSouthbound>> worker_southbounds_;  ///< The southbound of each pipeline worker
+
  private:
   /**
    * @brief Triggered ScanTopology for thread
@@ -95,25 +103,60 @@ class ActAutoScan {
                           ActAutoScanResult &auto_scan_result);
 
   /**
-   * @brief Identify Devices
+   * @brief Identify, probe and assign the configuration of the devices
+   *
+   * Each device goes through the stages on its own, so a device is probed as soon as it is identified. At most
+   * ACT_AUTO_SCAN_PARALLELISM devices are processed concurrently, and the results are merged in the device ID order.
+   *
+   * @param auto_probe_license
+   * @return ACT_STATUS
+   */
+  ACT_STATUS ProcessDevicesPipeline(const bool &auto_probe_license);
+
+  /**
+   * @brief Identify, probe and assign the configuration of one device
    *
+   * @param southbound the southbound of the worker
+   * @param auto_probe_license
+   * @param result
    * @return ACT_STATUS
    */
-  ACT_STATUS IdentifyDevices();
+  ACT_STATUS ProcessDevice(ActSouthbound &southbound, const bool &auto_probe_license, DevicePipelineResult &result);
 
   /**
-   * @brief Probe Devices
+   * @brief Probe the device by AutoProbe
    *
+   * @param result
    * @return ACT_STATUS
    */
-  ACT_STATUS ProbeDevices();
+  ACT_STATUS ProbeDevice(DevicePipelineResult &result);
 
   /**
-   * @brief Assign Devices Configuration
+   * @brief Register the probed device profile and set the DeviceProfileId of the device
    *
+   * @param result
+   * @param new_dev_profile_id
    * @return ACT_STATUS
    */
-  ACT_STATUS AssignDevicesConfiguration();
+  ACT_STATUS RegisterProbeDeviceProfile(DevicePipelineResult &result, qint64 &new_dev_profile_id);
+
+  /**
+   * @brief Assign Device Configuration
+   *
+   * @param southbound
+   * @param device
+   * @param device_config
+   * @return ACT_STATUS
+   */
+  ACT_STATUS AssignDeviceConfiguration(ActSouthbound &southbound, ActDevice &device, ActDeviceConfig &device_config);
+
+  /**
+   * @brief Merge the device configuration tables
+   *
+   * @param device_config
+   * @param result_device_config
+   */
+  static void MergeDeviceConfig(const ActDeviceConfig &device_config, ActDeviceConfig &result_device_config);
 
   // /**
   //  * @brief Update device connect status by AutoScan FeatureCapability
@@ -134,10 +177,11 @@ class ActAutoScan {
   /**
    * @brief Assign device informations
    *
+   * @param southbound
    * @param device
    * @return ACT_STATUS
    */
-  ACT_STATUS AssignDeviceInformations(ActDevice &device);
+  ACT_STATUS AssignDeviceInformations(ActSouthbound &southbound, ActDevice &device);
 
   /**
    * @brief Update interfaces of the unknown interface devices
@@ -168,6 +212,33 @@ class ActAutoScan {
  public:
   QQueue<ActDeviceProfile> probe_device_profiles_queue_;
 
+  /**
+   * @brief The result of one device processed by the device pipeline
+   *
+   */
+  struct DevicePipelineResult {
+    bool identified = false;
+    bool probed = false;
+    ActDevice device;
+    ActDeviceProfile probe_dev_profile;
+    ActDeviceConfig device_config;
+  };
+
+  /**
+   * @brief Run the process of each device on the workers, and merge the results in the device ID order
+   *
+   * The merged result doesn't depend on the parallelism or the completion order.
+   *
+   * @param parallelism the maximum number of the devices processed concurrently
+   * @param process the stages of one device, run with the southbound of the worker
+   * @param devices the devices to process, replaced by the identified ones
+   * @param result_device_config
+   * @return ACT_STATUS
+   */
+  ACT_STATUS RunDevicesPipeline(const quint32 &parallelism,
+                                const std::function<ACT_STATUS(ActSouthbound &, DevicePipelineResult &)> &process,
+                                QSet<ActDevice> &devices, ActDeviceConfig &result_device_config);
+
   /**
    * @brief Construct a new Act Auto Scan object
    *
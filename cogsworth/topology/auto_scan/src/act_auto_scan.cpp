@@ -6,12 +6,14 @@
 #define SLEEP_MS(ms) Sleep(ms)
 #else
 #include <unistd.h>  // for sleep
-#define SLEEP_MS(ms) sleep(ms / 1000)
+#define SLEEP_MS(ms) usleep((ms) * 1000)
 #endif
 
 #include <QDebug>
 #include <QHostAddress>
 #include <QNetworkInterface>
+#include <algorithm>
+#include <atomic>
 #include <sstream>
 
 #include "act_auto_probe.hpp"
@@ -51,6 +53,12 @@ ACT_STATUS act::topology::ActAutoScan::Stop() {
     qDebug() << "Stop ScanTopology thread.";
 
     southbound_.SetStopFlag(true);
+    {
+      QMutexLocker lock(&mutex_);
+      for (auto &worker_southbound : worker_southbounds_) {
+        worker_southbound->SetStopFlag(true);
+      }
+    }
 
     // Send the stop signal to the ScanTopology and wait for the thread to finish.
     stop_flag_ = true;
@@ -163,43 +171,19 @@ ACT_STATUS act::topology::ActAutoScan::ScanTopology(QList<ActScanIpRangeEntry> &
   }
   UpdateProgress(30);
 
-  qDebug() << "IdentifyDevices";
+  qDebug() << "ProcessDevicesPipeline";
   // [feat:2396] Refactor - AutoScan performance enhance
   // Identify Devices (DeviceProfileId, FirmwareFeatureProfileId, FirmwareVersion, DeviceType, DeviceName)
-  act_status = IdentifyDevices();
-  if (stop_flag_) {
-    return ACT_STATUS_STOP;
-  }
-  if (!IsActStatusSuccess(act_status)) {
-    qCritical() << __func__ << "IdentifyDevices() failed.";
-    return act_status;
-  }
-
   // [feat:2604] Auto Scan - Get the unknown device need to execute the auto probe
   // [bugfix: 2657] AutoScan contact AutoProbe needs to add the license control
-  // Probe Devices
-  if (auto_probe_license) {
-    act_status = ProbeDevices();
-    if (stop_flag_) {
-      return ACT_STATUS_STOP;
-    }
-    if (!IsActStatusSuccess(act_status)) {
-      qCritical() << __func__ << "ProbeDevices() failed.";
-      return act_status;
-    }
-  }
-
-  UpdateProgress(50);
-
-  qDebug() << "AssignDevicesConfiguration";
   // Assign Device Configuration (MACAddress, lldp_chassis_id) & (Interfaces's InterfaceName) & (Disable
   // SnmpEnableService)
-  act_status = AssignDevicesConfiguration();
+  act_status = ProcessDevicesPipeline(auto_probe_license);
   if (stop_flag_) {
     return ACT_STATUS_STOP;
   }
   if (!IsActStatusSuccess(act_status)) {
-    qCritical() << __func__ << "AssignDevicesConfiguration() failed.";
+    qCritical() << __func__ << "ProcessDevicesPipeline() failed.";
     return act_status;
   }
 
@@ -258,154 +242,248 @@ ACT_STATUS act::topology::ActAutoScan::ScanTopology(QList<ActScanIpRangeEntry> &
   return act_status;
 }
 
-ACT_STATUS act::topology::ActAutoScan::IdentifyDevices() {
+ACT_STATUS act::topology::ActAutoScan::ProcessDevicesPipeline(const bool &auto_probe_license) {
+  return RunDevicesPipeline(
+      ACT_AUTO_SCAN_PARALLELISM,
+      [this, &auto_probe_license](ActSouthbound &southbound, DevicePipelineResult &result) {
+        return ProcessDevice(southbound, auto_probe_license, result);
+      },
+      alive_devices_, alive_device_config_);
+}
+
+ACT_STATUS act::topology::ActAutoScan::RunDevicesPipeline(
+    const quint32 &parallelism, const std::function<ACT_STATUS(ActSouthbound &, DevicePipelineResult &)> &process,
+    QSet<ActDevice> &devices_set, ActDeviceConfig &result_device_config) {
   ACT_STATUS_INIT();
-  QSet<ActDevice> new_device_set;
 
-  for (auto device : alive_devices_) {
-    if (stop_flag_) {
-      return ACT_STATUS_STOP;
+  // Sort by the device ID, the result would not depend on the completion order
+  QList<ActDevice> devices = devices_set.values();
+  std::sort(devices.begin(), devices.end(),
+            [](const ActDevice &lhs, const ActDevice &rhs) { return lhs.GetId() < rhs.GetId(); });
+
+  QVector<DevicePipelineResult> results(devices.size());
+  for (qint32 i = 0; i < devices.size(); i++) {
+    results[i].device = devices.at(i);
+  }
+
+  const quint32 worker_count =
+      qMax<quint32>(1, qMin<quint32>(parallelism, static_cast<quint32>(qMax<qint32>(devices.size(), 1))));
+  {
+    QMutexLocker lock(&mutex_);
+    worker_southbounds_.clear();
+    for (quint32 i = 0; i < worker_count; i++) {
+      auto southbound = std::make_unique<ActSouthbound>();
+      southbound->SetProfiles(southbound_.GetProfiles());
+      southbound->SetStopFlag(stop_flag_);
+      worker_southbounds_.push_back(std::move(southbound));
+    }
+  }
+
+  // Each worker takes the next device and runs the whole device pipeline
+  std::atomic<qint32> next_index(0);
+  std::atomic<qint32> done_count(0);
+  auto worker = [&](ActSouthbound *southbound) {
+    while (!stop_flag_) {
+      const qint32 index = next_index.fetch_add(1);
+      if (index >= results.size()) {
+        break;
+      }
+
+      process(*southbound, results[index]);
+
+      // Progress 30% ~ 70%
+      const qint32 done = done_count.fetch_add(1) + 1;
+      QMutexLocker lock(&mutex_);
+      const quint8 progress = static_cast<quint8>(30 + (40 * done) / results.size());
+      if (progress > progress_) {
+        UpdateProgress(progress);
+      }
     }
+  };
+
+  std::vector<std::thread> threads;
+  for (quint32 i = 0; i < worker_count; i++) {
+    threads.emplace_back(worker, worker_southbounds_.at(i).get());
+  }
+  for (auto &thread : threads) {
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
+
+  {
+    QMutexLocker lock(&mutex_);
+    worker_southbounds_.clear();
+  }
+  if (stop_flag_) {
+    return ACT_STATUS_STOP;
+  }
 
-    auto identify_status = southbound_.IdentifyDevice(device);
-    if (!IsActStatusSuccess(identify_status)) {
+  // Merge the results in the device ID order
+  QSet<ActDevice> new_device_set;
+  qint64 new_dev_profile_id = 10000;
+  for (auto &result : results) {
+    if (!result.identified) {
       continue;
     }
 
-    // Insert
-    new_device_set.insert(device);
+    if (result.probed) {
+      RegisterProbeDeviceProfile(result, new_dev_profile_id);
+    }
+
+    MergeDeviceConfig(result.device_config, result_device_config);
+    new_device_set.insert(result.device);
   }
-  alive_devices_ = new_device_set;
+  devices_set = new_device_set;
 
-  return ACT_STATUS_SUCCESS;
+  return act_status;
 }
 
-ACT_STATUS act::topology::ActAutoScan::ProbeDevices() {
+ACT_STATUS act::topology::ActAutoScan::ProcessDevice(ActSouthbound &southbound, const bool &auto_probe_license,
+                                                     DevicePipelineResult &result) {
   ACT_STATUS_INIT();
-  QSet<ActDevice> new_device_set;
-  qint64 new_dev_profile_id = 10000;
 
-  for (auto device : alive_devices_) {
+  // Identify Device
+  act_status = southbound.IdentifyDevice(result.device);
+  if (!IsActStatusSuccess(act_status)) {
+    return act_status;
+  }
+  result.identified = true;
+  if (stop_flag_) {
+    return ACT_STATUS_STOP;
+  }
+
+  // Probe Device
+  if (auto_probe_license) {
+    ProbeDevice(result);
     if (stop_flag_) {
       return ACT_STATUS_STOP;
     }
+  }
 
-    ActAutoProbeWarning probe_warning_result;
-    ActDeviceProfile probe_dev_profile;
+  // Assign Device Configuration
+  return AssignDeviceConfiguration(southbound, result.device, result.device_config);
+}
 
-    // Skip not AutoProbe device
-    if (!device.auto_probe_) {
-      new_device_set.insert(device);
-      continue;
-    }
+ACT_STATUS act::topology::ActAutoScan::ProbeDevice(DevicePipelineResult &result) {
+  ACT_STATUS_INIT();
+  ActDevice &device = result.device;
 
-    // Only probe Unknown Device & Moxa Device
-    if (device.GetDeviceType() != ActDeviceTypeEnum::kUnknown && device.GetDeviceType() != ActDeviceTypeEnum::kMoxa) {
-      new_device_set.insert(device);
-      continue;
-    }
+  // Skip not AutoProbe device
+  if (!device.auto_probe_) {
+    return act_status;
+  }
 
-    act::auto_probe::ActAutoProbe prober(profiles_);
-    auto act_status_probe = prober.AutoProbe(device, probe_warning_result, probe_dev_profile);
-    // Check Success
-    if (!IsActStatusSuccess(act_status_probe)) {
-      qDebug() << __func__
-               << QString("AutoProbe Device(%1) failed. ProbeFeature Warning Report: %2")
-                      .arg(device.GetIpv4().GetIpAddress())
-                      .arg(probe_warning_result.ToString())
-                      .toStdString()
-                      .c_str();
-
-      new_device_set.insert(device);
-      continue;
-    }
+  // Only probe Unknown Device & Moxa Device
+  if (device.GetDeviceType() != ActDeviceTypeEnum::kUnknown && device.GetDeviceType() != ActDeviceTypeEnum::kMoxa) {
+    return act_status;
+  }
 
-    // Check ModelName is empty (Uncertified-Device)
-    if (probe_dev_profile.GetModelName().isEmpty()) {
-      new_device_set.insert(device);
-      continue;
-    }
+  ActAutoProbeWarning probe_warning_result;
+  ActDeviceProfile probe_dev_profile;
+  act::auto_probe::ActAutoProbe prober(profiles_);
+  act_status = prober.AutoProbe(device, probe_warning_result, probe_dev_profile);
+  // Check Success
+  if (!IsActStatusSuccess(act_status)) {
+    qDebug() << __func__
+             << QString("AutoProbe Device(%1) failed. ProbeFeature Warning Report: %2")
+                    .arg(device.GetIpv4().GetIpAddress())
+                    .arg(probe_warning_result.ToString())
+                    .toStdString()
+                    .c_str();
+    return act_status;
+  }
 
-    if (profiles_.GetDeviceProfiles().contains(probe_dev_profile)) {  // duplicated
-      // Check the probe_dev_profile duplicated with newly generated new_device_profiles
-      if (new_device_profiles_.contains(probe_dev_profile)) {
-        // Set Device DeviceProfileId
-        device.SetDeviceProfileId(probe_dev_profile.GetId());
-      }
+  // Check ModelName is empty (Uncertified-Device)
+  if (probe_dev_profile.GetModelName().isEmpty()) {
+    return act_status;
+  }
 
-      new_device_set.insert(device);
-      continue;
-    }
+  result.probed = true;
+  result.probe_dev_profile = probe_dev_profile;
+  return act_status;
+}
 
-    // Assign temporarily DeviceProfile ID
-    // Get Unique ID
-    while (true) {
-      ActDeviceProfile target_dev_profile;
-      if (!IsActStatusSuccess(ActGetItemById<ActDeviceProfile>(profiles_.GetDeviceProfiles(), new_dev_profile_id,
-                                                               target_dev_profile))) {
-        break;
-      }
-      new_dev_profile_id += 1;
+ACT_STATUS act::topology::ActAutoScan::RegisterProbeDeviceProfile(DevicePipelineResult &result,
+                                                                  qint64 &new_dev_profile_id) {
+  ACT_STATUS_INIT();
+  ActDeviceProfile &probe_dev_profile = result.probe_dev_profile;
+
+  if (profiles_.GetDeviceProfiles().contains(probe_dev_profile)) {  // duplicated
+    // Check the probe_dev_profile duplicated with newly generated new_device_profiles
+    auto new_dev_profile_it = new_device_profiles_.find(probe_dev_profile);
+    if (new_dev_profile_it != new_device_profiles_.end()) {
+      // Set Device DeviceProfileId
+      result.device.SetDeviceProfileId(new_dev_profile_it->GetId());
     }
-    probe_dev_profile.SetId(new_dev_profile_id);
-    profiles_.GetDeviceProfiles().insert(probe_dev_profile);
-    new_device_profiles_.insert(probe_dev_profile);
-    probe_device_profiles_queue_.enqueue(probe_dev_profile);
+    return act_status;
+  }
 
-    // Set Device DeviceProfileId
-    device.SetDeviceProfileId(probe_dev_profile.GetId());
-    new_device_set.insert(device);
+  // Assign temporarily DeviceProfile ID
+  // Get Unique ID
+  while (true) {
+    ActDeviceProfile target_dev_profile;
+    if (!IsActStatusSuccess(
+            ActGetItemById<ActDeviceProfile>(profiles_.GetDeviceProfiles(), new_dev_profile_id, target_dev_profile))) {
+      break;
+    }
+    new_dev_profile_id += 1;
   }
-  alive_devices_ = new_device_set;
+  probe_dev_profile.SetId(new_dev_profile_id);
+  profiles_.GetDeviceProfiles().insert(probe_dev_profile);
+  new_device_profiles_.insert(probe_dev_profile);
+  probe_device_profiles_queue_.enqueue(probe_dev_profile);
 
+  // Set Device DeviceProfileId
+  result.device.SetDeviceProfileId(probe_dev_profile.GetId());
   return act_status;
 }
 
-ACT_STATUS act::topology::ActAutoScan::AssignDeviceInformations(ActDevice &device) {
+ACT_STATUS act::topology::ActAutoScan::AssignDeviceInformations(ActSouthbound &southbound, ActDevice &device) {
   // Device Name, Serial Number,  Modular Info
   ACT_STATUS_INIT();
 
-  southbound_.AssignDeviceIPv4(device);
+  southbound.AssignDeviceIPv4(device);
   if (stop_flag_) {
     return ACT_STATUS_STOP;
   }
 
-  southbound_.AssignDeviceName(device);
+  southbound.AssignDeviceName(device);
   if (stop_flag_) {
     return ACT_STATUS_STOP;
   }
 
-  southbound_.AssignDeviceSerialNumber(device);
+  southbound.AssignDeviceSerialNumber(device);
   if (stop_flag_) {
     return ACT_STATUS_STOP;
   }
 
-  southbound_.AssignDeviceSystemUptime(device);
+  southbound.AssignDeviceSystemUptime(device);
   if (stop_flag_) {
     return ACT_STATUS_STOP;
   }
 
-  southbound_.AssignDeviceProductRevision(device);
+  southbound.AssignDeviceProductRevision(device);
   if (stop_flag_) {
     return ACT_STATUS_STOP;
   }
 
-  southbound_.AssignDeviceRedundantProtocol(device);
+  southbound.AssignDeviceRedundantProtocol(device);
   if (stop_flag_) {
     return ACT_STATUS_STOP;
   }
 
-  southbound_.AssignDeviceLocation(device);
+  southbound.AssignDeviceLocation(device);
   if (stop_flag_) {
     return ACT_STATUS_STOP;
   }
 
-  southbound_.AssignDeviceModularConfiguration(device);
+  southbound.AssignDeviceModularConfiguration(device);
   if (stop_flag_) {
     return ACT_STATUS_STOP;
   }
 
-  southbound_.AssignInterfacesAndBuiltinPowerByModular(device);
+  southbound.AssignInterfacesAndBuiltinPowerByModular(device);
   if (stop_flag_) {
     return ACT_STATUS_STOP;
   }
@@ -426,90 +504,110 @@ ACT_STATUS act::topology::ActAutoScan::AssignDeviceInformations(ActDevice &devic
 
   // // Assign SFP to Module info
   // if (!port_fiber_map.isEmpty()) {
-  //   southbound_.AssignSFPtoModule(device, port_fiber_map, port_info_map);
+  //   southbound.AssignSFPtoModule(device, port_fiber_map, port_info_map);
   // }
 
   return ACT_STATUS_SUCCESS;
 }
 
-ACT_STATUS act::topology::ActAutoScan::AssignDevicesConfiguration() {
+ACT_STATUS act::topology::ActAutoScan::AssignDeviceConfiguration(ActSouthbound &southbound, ActDevice &device,
+                                                                 ActDeviceConfig &device_config) {
   ACT_STATUS_INIT();
-  QSet<ActDevice> new_device_set;
-
-  for (auto device : alive_devices_) {
-    if (stop_flag_) {
-      return ACT_STATUS_STOP;
-    }
-
-    qDebug() << __func__ << "Device:" << device.GetIpv4().GetIpAddress();
-    // Update Device Connect by AutoScan feature
-    southbound_.UpdateDeviceConnectByScanFeature(device);
-    if (stop_flag_) {
-      return ACT_STATUS_STOP;
-    }
 
-    // Assign Device DeviceConfigs
-    southbound_.AssignDeviceConfigs(device, alive_device_config_);
-    if (stop_flag_) {
-      return ACT_STATUS_STOP;
-    }
-
-    qDebug() << "Assign Device LLDP data";
-    // Assign Device LLDP data
-    southbound_.AssignDeviceLldpData(device);
-    if (stop_flag_) {
-      return ACT_STATUS_STOP;
-    }
+  qDebug() << __func__ << "Device:" << device.GetIpv4().GetIpAddress();
+  // Update Device Connect by AutoScan feature
+  southbound.UpdateDeviceConnectByScanFeature(device);
+  if (stop_flag_) {
+    return ACT_STATUS_STOP;
+  }
 
-    qDebug() << "Assign Device MAC table";
-    // Assign Device MAC table
-    southbound_.AssignDeviceMacTable(device);
-    if (stop_flag_) {
-      return ACT_STATUS_STOP;
-    }
+  // Assign Device DeviceConfigs
+  southbound.AssignDeviceConfigs(device, device_config);
+  if (stop_flag_) {
+    return ACT_STATUS_STOP;
+  }
 
-    // Set MAC address & MAC int
-    QString mac_addr = this->ip_mac_table_[device.GetIpv4().GetIpAddress()];  //  by ACT's ip_mac_table
-    qint64 mac_int = 0;
-    MacAddressToQInt64(mac_addr, mac_int);
-    // If MAC is "00-00-00-00-00-00" would try to replace by chassis_id
-    if (mac_int == 0) {
-      // Try to replace the MAC by lldp loc_chassis_id
-      QString new_mac_addr = "";
-      auto transfer_status = TransferChassisIdToMacFormat(device.lldp_data_.GetLocChassisId(), new_mac_addr);
-      if (IsActStatusSuccess(transfer_status)) {
-        // Update mac_addr & mac_int
-        mac_addr = new_mac_addr;
-        MacAddressToQInt64(new_mac_addr, mac_int);
-      }
-    }
-    device.SetMacAddress(mac_addr);
-    device.mac_address_int = mac_int;
+  qDebug() << "Assign Device LLDP data";
+  // Assign Device LLDP data
+  southbound.AssignDeviceLldpData(device);
+  if (stop_flag_) {
+    return ACT_STATUS_STOP;
+  }
 
-    qDebug() << "Assign Device Informations";
-    // Assign Device Informations(Device Name, Serial Number,  Modular Info)
-    AssignDeviceInformations(device);
-    if (stop_flag_) {
-      return ACT_STATUS_STOP;
-    }
+  qDebug() << "Assign Device MAC table";
+  // Assign Device MAC table
+  southbound.AssignDeviceMacTable(device);
+  if (stop_flag_) {
+    return ACT_STATUS_STOP;
+  }
 
-    qDebug() << "Assign Interfaces";
-    // Assign Interfaces
-    southbound_.AssignDeviceInterfacesInfo(device);
-    if (stop_flag_) {
-      return ACT_STATUS_STOP;
+  // Set MAC address & MAC int
+  QString mac_addr = this->ip_mac_table_.value(device.GetIpv4().GetIpAddress());  //  by ACT's ip_mac_table
+  qint64 mac_int = 0;
+  MacAddressToQInt64(mac_addr, mac_int);
+  // If MAC is "00-00-00-00-00-00" would try to replace by chassis_id
+  if (mac_int == 0) {
+    // Try to replace the MAC by lldp loc_chassis_id
+    QString new_mac_addr = "";
+    auto transfer_status = TransferChassisIdToMacFormat(device.lldp_data_.GetLocChassisId(), new_mac_addr);
+    if (IsActStatusSuccess(transfer_status)) {
+      // Update mac_addr & mac_int
+      mac_addr = new_mac_addr;
+      MacAddressToQInt64(new_mac_addr, mac_int);
     }
+  }
+  device.SetMacAddress(mac_addr);
+  device.mac_address_int = mac_int;
 
-    // Insert
-    new_device_set.insert(device);
+  qDebug() << "Assign Device Informations";
+  // Assign Device Informations(Device Name, Serial Number,  Modular Info)
+  AssignDeviceInformations(southbound, device);
+  if (stop_flag_) {
+    return ACT_STATUS_STOP;
   }
-  alive_devices_ = new_device_set;
 
-  // qDebug() << "AutoScan device_config:" << alive_device_config_.ToString().toStdString().c_str();
+  qDebug() << "Assign Interfaces";
+  // Assign Interfaces
+  southbound.AssignDeviceInterfacesInfo(device);
+  if (stop_flag_) {
+    return ACT_STATUS_STOP;
+  }
 
   return act_status;
 }
 
+void act::topology::ActAutoScan::MergeDeviceConfig(const ActDeviceConfig &device_config,
+                                                   ActDeviceConfig &result_device_config) {
+  auto merge_tables = [](const auto &tables, auto &result_tables) {
+    for (auto it = tables.cbegin(); it != tables.cend(); it++) {
+      result_tables.insert(it.key(), it.value());
+    }
+  };
+
+  merge_tables(device_config.GetMappingDeviceIpSettingTables(), result_device_config.GetMappingDeviceIpSettingTables());
+  merge_tables(device_config.GetNetworkSettingTables(), result_device_config.GetNetworkSettingTables());
+  merge_tables(device_config.GetUserAccountTables(), result_device_config.GetUserAccountTables());
+  merge_tables(device_config.GetTimeSyncTables(), result_device_config.GetTimeSyncTables());
+  merge_tables(device_config.GetLoginPolicyTables(), result_device_config.GetLoginPolicyTables());
+  merge_tables(device_config.GetLoopProtectionTables(), result_device_config.GetLoopProtectionTables());
+  merge_tables(device_config.GetSnmpTrapSettingTables(), result_device_config.GetSnmpTrapSettingTables());
+  merge_tables(device_config.GetSyslogSettingTables(), result_device_config.GetSyslogSettingTables());
+  merge_tables(device_config.GetTimeSettingTables(), result_device_config.GetTimeSettingTables());
+  merge_tables(device_config.GetInformationSettingTables(), result_device_config.GetInformationSettingTables());
+  merge_tables(device_config.GetManagementInterfaceTables(), result_device_config.GetManagementInterfaceTables());
+  merge_tables(device_config.GetPortSettingTables(), result_device_config.GetPortSettingTables());
+  merge_tables(device_config.GetVlanTables(), result_device_config.GetVlanTables());
+  merge_tables(device_config.GetUnicastStaticForwardTables(), result_device_config.GetUnicastStaticForwardTables());
+  merge_tables(device_config.GetMulticastStaticForwardTables(),
+               result_device_config.GetMulticastStaticForwardTables());
+  merge_tables(device_config.GetPortDefaultPCPTables(), result_device_config.GetPortDefaultPCPTables());
+  merge_tables(device_config.GetStreamPriorityIngressTables(), result_device_config.GetStreamPriorityIngressTables());
+  merge_tables(device_config.GetStreamPriorityEgressTables(), result_device_config.GetStreamPriorityEgressTables());
+  merge_tables(device_config.GetGCLTables(), result_device_config.GetGCLTables());
+  merge_tables(device_config.GetCbTables(), result_device_config.GetCbTables());
+  merge_tables(device_config.GetRstpTables(), result_device_config.GetRstpTables());
+}
+
 // ACT_STATUS act::topology::ActAutoScan::UpdateDeviceConnectByAutoScanFeature(ActDevice &device) {
 //   ACT_STATUS_INIT();
 
@@ -654,11 +752,30 @@ ACT_STATUS act::topology::ActAutoScan::ScanLinks(QSet<ActDevice> &alive_devices,
   ACT_STATUS_INIT();
   result_alive_links.clear();
 
-  for (auto device : alive_devices) {
+  // Scan in the device ID order, the link ID would be deterministic
+  QList<ActDevice> devices = alive_devices.values();
+  std::sort(devices.begin(), devices.end(),
+            [](const ActDevice &lhs, const ActDevice &rhs) { return lhs.GetId() < rhs.GetId(); });
+
+  qint32 scanned_count = 0;
+  for (const auto &sorted_device : devices) {
     if (stop_flag_) {
       return ACT_STATUS_STOP;
     }
 
+    // Progress 70% ~ 90%
+    const quint8 progress = static_cast<quint8>(70 + (20 * scanned_count++) / devices.size());
+    if (progress > progress_) {
+      UpdateProgress(progress);
+    }
+
+    // The device may be updated by the previous device's scan result
+    auto device_it = alive_devices.find(sorted_device);
+    if (device_it == alive_devices.end()) {
+      continue;
+    }
+    ActDevice device = *device_it;
+
     ActScanLinksResult scan_link_result;
     auto create_status = southbound_.CreateDeviceLink(ip_mac_table_, device, alive_devices, scan_link_result);
     if (!IsActStatusSuccess(create_status)) {
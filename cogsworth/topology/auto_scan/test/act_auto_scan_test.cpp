@@ -5,7 +5,7 @@
 #define SLEEP_MS(ms) Sleep(ms)
 #else
 #include <unistd.h>  // for sleep
-#define SLEEP_MS(ms) sleep(ms / 1000)
+#define SLEEP_MS(ms) usleep((ms) * 1000)
 #endif
 
 #include <QTime>
@@ -84,6 +84,53 @@ TEST_F(ActAutoScanTest, AutoScanIntegrationThread) {
   EXPECT_EQ(act_status->GetStatus(), ActStatusType::kFinished) << "ScanTopology failed";
 }
 
+TEST_F(ActAutoScanTest, TestPipelineDeterministic) {
+  const qint64 kDeviceCount = 40;
+
+  // The fake device stages: every fifth device is not identified, every third one is probed as one of two models
+  auto process = [](ActSouthbound &southbound, ActAutoScan::DevicePipelineResult &result) {
+    static_cast<void>(southbound);
+    const qint64 id = result.device.GetId();
+    SLEEP_MS((kDeviceCount - id) % 4);  // complete out of the device ID order
+    if (id % 5 == 0) {
+      return ACT_STATUS_SUCCESS;
+    }
+    result.identified = true;
+    result.device.SetDeviceName(QString("Device-%1").arg(id));
+    if (id % 3 == 0) {
+      result.probed = true;
+      result.probe_dev_profile.SetModelName((id % 2 == 0) ? "Probe-A" : "Probe-B");
+    }
+    result.device_config.GetVlanTables().insert(id, ActVlanTable(id));
+    return ACT_STATUS_SUCCESS;
+  };
+
+  auto run = [&](const quint32 &parallelism) {
+    QSet<ActDevice> devices;
+    for (qint64 id = 1; id <= kDeviceCount; id++) {
+      devices.insert(ActDevice(id));
+    }
+    ActDeviceConfig device_config;
+    ActAutoScan auto_scan((ActProfiles()));
+    EXPECT_TRUE(IsActStatusSuccess(auto_scan.RunDevicesPipeline(parallelism, process, devices, device_config)));
+
+    QMap<qint64, QString> result;
+    for (auto device : devices) {
+      result.insert(device.GetId(), device.ToString());
+    }
+    result.insert(0, device_config.ToString());
+    return result;
+  };
+
+  const QMap<qint64, QString> reference = run(1);
+  EXPECT_EQ(kDeviceCount - kDeviceCount / 5 + 1, reference.size());
+  for (quint32 parallelism : {2, 8, ACT_AUTO_SCAN_PARALLELISM}) {
+    for (qint32 i = 0; i < 3; i++) {
+      EXPECT_EQ(reference, run(parallelism)) << "Parallelism" << parallelism;
+    }
+  }
+}
+
 // TEST_F(ActAutoScanTest, AutoScanIntegrationThreadStop) {
 //   QSet<ActScanIpRangeEntry> scan_ip_range_entry_list;
 
@@ -10,13 +10,15 @@ See the file MOXA-SOFTWARE-NOTICE for details.
 #include <QString>
 #include <thread>
 
+#include "act_concurrent_runner.hpp"
 #include "act_device.hpp"
 #include "act_json.hpp"
 #include "act_link.hpp"
 #include "act_project.hpp"
 #include "act_southbound.hpp"
 #include "act_status.hpp"
-#define ACT_INTERFACE_STATUS_UP (1)  ///< The interface status is up
+#define ACT_INTERFACE_STATUS_UP (1)   ///< The interface status is up
+#define ACT_COMPARE_QUERY_WIDTH (16)  ///< The devices queried at once
 
 namespace act {
 namespace topology {
@@ -61,6 +63,7 @@ class ActCompare {
   ACT_JSON_FIELD(bool, stop_flag, StopFlag);              ///< StopFlag item
   ACT_JSON_FIELD(quint8, progress, Progress);             ///< Progress item
   ACT_STATUS compare_topology_act_status_;                ///< Compare thread status
+  ACT_JSON_FIELD(quint32, query_width, QueryWidth);       ///< The devices queried at once (>= 1)
 
   // member
   ACT_JSON_OBJECT(ActProject, project, Project);
@@ -75,6 +78,23 @@ class ActCompare {
 
   ActSouthbound southbound_;
 
+  /**
+   * @brief The southbound results of the compared device, queried once for all the check passes
+   *
+   */
+  struct DeviceQuery {
+    ActDevice device;  ///< The device updated by the southbound (connect status & LLDP data)
+    ACT_STATUS alive_status = ACT_STATUS_SUCCESS;
+    ACT_STATUS connect_status = ACT_STATUS_SUCCESS;
+    ACT_STATUS lldp_status = ACT_STATUS_SUCCESS;
+    ACT_STATUS model_name_sub_item_status = ACT_STATUS_SUCCESS;
+    ACT_STATUS model_name_status = ACT_STATUS_SUCCESS;
+    QString model_name;
+    ACT_STATUS port_speed_status = ACT_STATUS_SUCCESS;
+    QMap<qint64, qint64> interface_speed_map;  ///< <InterfaceId, Speed>
+  };
+  QMap<qint64, DeviceQuery> device_queries_;  ///< <DeviceId, DeviceQuery>
+
  private:
   /**
    * @brief Triggered CompareTopology for thread
@@ -126,6 +146,22 @@ class ActCompare {
    */
   ACT_STATUS CheckDeviceConfig();
 
+  /**
+   * @brief Run the query on the compared devices at once (bounded by query_width_)
+   *
+   * @param query called in the worker threads, only touches its own DeviceQuery
+   * @return ACT_STATUS success, or stop if stopped
+   */
+  ACT_STATUS RunDeviceQueries(const std::function<void(DeviceQuery &device_query)> &query);
+
+  /**
+   * @brief Query the connected devices for the checks below, each device is contacted in one session
+   *
+   * @param compare_control
+   * @return ACT_STATUS
+   */
+  ACT_STATUS QueryDevices(const ActCompareControl &compare_control);
+
   /**
    * @brief Check Alive
    *
@@ -136,6 +172,8 @@ class ActCompare {
   /**
    * @brief Update devices ConnectStatus & Enable SNMP service
    *
+   * The devices are connected at once, the first failed device in the device order is reported.
+   *
    * @return ACT_STATUS
    */
   ACT_STATUS UpdateDevicesConnectStatusAndEnableSnmp();
@@ -225,7 +263,8 @@ class ActCompare {
       : progress_(0),
         stop_flag_(false),
         compare_topology_act_status_(std::make_shared<ActStatusBase>(ActStatusType::kStop, ActSeverity::kDebug)),
-        compare_topology_thread_(nullptr) {}
+        compare_topology_thread_(nullptr),
+        query_width_(ACT_COMPARE_QUERY_WIDTH) {}
 
   /**
    * @brief Construct a new Act Compare object
@@ -236,7 +275,8 @@ class ActCompare {
         progress_(0),
         stop_flag_(false),
         compare_topology_act_status_(std::make_shared<ActStatusBase>(ActStatusType::kStop, ActSeverity::kDebug)),
-        compare_topology_thread_(nullptr) {
+        compare_topology_thread_(nullptr),
+        query_width_(ACT_COMPARE_QUERY_WIDTH) {
     southbound_.SetProfiles(profiles);
   }
 
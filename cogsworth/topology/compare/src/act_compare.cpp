@@ -6,10 +6,11 @@
 #define SLEEP_MS(ms) Sleep(ms)
 #else
 #include <unistd.h>  // for sleep
-#define SLEEP_MS(ms) sleep(ms / 1000)
+#define SLEEP_MS(ms) usleep((ms) * 1000)
 #endif
 
 #include <QDebug>
+#include <QHash>
 act::topology::ActCompare::~ActCompare() {
   if ((compare_topology_thread_ != nullptr) && (compare_topology_thread_->joinable())) {
     compare_topology_thread_->join();
@@ -179,6 +180,13 @@ ACT_STATUS act::topology::ActCompare::CompareTopology(const ActProject &project,
     return act_status;
   }
 
+  // Query the connected devices at once for the passes below
+  act_status = QueryDevices(compare_control);
+  if (!IsActStatusSuccess(act_status)) {
+    qCritical() << __func__ << "QueryDevices() failed.";
+    return act_status;
+  }
+
   UpdateProgress(30);
 
   // Check Topology consistent (TSN Switch's Link)
@@ -218,6 +226,7 @@ ACT_STATUS act::topology::ActCompare::CompareTopology(const ActProject &project,
 
 ACT_STATUS act::topology::ActCompare::GenerateCompareDevicesAndLinks(const QList<qint64> &dev_id_list) {
   ACT_STATUS_INIT();
+  device_queries_.clear();
 
   for (auto dev_id : dev_id_list) {
     if (stop_flag_) {
@@ -237,6 +246,7 @@ ACT_STATUS act::topology::ActCompare::GenerateCompareDevicesAndLinks(const QList
     }
 
     compare_devices_[dev_id] = dev;
+    device_queries_[dev_id].device = dev;
   }
 
   for (auto link : project_.GetLinks()) {
@@ -321,18 +331,85 @@ ACT_STATUS act::topology::ActCompare::CheckDeviceConfig() {
   return act_status;
 }
 
+ACT_STATUS act::topology::ActCompare::RunDeviceQueries(const std::function<void(DeviceQuery &device_query)> &query) {
+  // Look up the queries before the run, the workers only touch their own query
+  QHash<qint64, DeviceQuery *> query_map;
+  for (auto it = device_queries_.begin(); it != device_queries_.end(); it++) {
+    query_map.insert(it.key(), &it.value());
+  }
+
+  ActConcurrentRunner runner(static_cast<qint32>(query_width_), 0);
+  return runner.Run(
+      device_queries_.keys(),
+      [&query_map, &query](const qint64 &id) {
+        query(*query_map.value(id));
+        return ACT_STATUS_SUCCESS;
+      },
+      [](const qint64 &, ACT_STATUS) {}, &stop_flag_);
+}
+
+ACT_STATUS act::topology::ActCompare::QueryDevices(const ActCompareControl &compare_control) {
+  return RunDeviceQueries([this, &compare_control](DeviceQuery &device_query) {
+    ActDevice &dev = device_query.device;
+
+    // Only the devices passed the alive & connect check
+    if (!IsActStatusSuccess(device_query.alive_status) || !IsActStatusSuccess(device_query.connect_status)) {
+      return;
+    }
+
+    // One session per device: LLDP, model name and port speed. The query after a failed one is skipped, as the
+    // compare stops at the failed check.
+    if (compare_control.GetTopologyConsistent()) {
+      device_query.lldp_status = southbound_.AssignDeviceLldpData(dev);
+      if (!IsActStatusSuccess(device_query.lldp_status)) {
+        return;
+      }
+    }
+
+    if (compare_control.GetModelName()) {
+      ActFeatureSubItem feature_sub_item;
+      device_query.model_name_sub_item_status =
+          GetDeviceFeatureSubItem(dev, profiles_.GetFirmwareFeatureProfiles(), profiles_.GetDeviceProfiles(),
+                                  ActFeatureEnum::kAutoScan, "Identify", "ModelName", feature_sub_item);
+      if (IsActStatusSuccess(device_query.model_name_sub_item_status)) {
+        device_query.model_name_status =
+            southbound_.ActionGetModelName(dev, feature_sub_item, device_query.model_name);
+        if (!IsActStatusSuccess(device_query.model_name_status)) {
+          return;
+        }
+      }
+    }
+
+    if (compare_control.GetSpeed()) {
+      ActFeatureSubItem port_speed_sub_item;
+      device_query.port_speed_status =
+          GetDeviceFeatureSubItem(dev, profiles_.GetFirmwareFeatureProfiles(), profiles_.GetDeviceProfiles(),
+                                  ActFeatureEnum::kAutoScan, "DeviceInformation", "PortSpeed", port_speed_sub_item);
+      if (IsActStatusSuccess(device_query.port_speed_status)) {
+        device_query.port_speed_status =
+            southbound_.ActionGetPortSpeed(dev, port_speed_sub_item, device_query.interface_speed_map);
+      }
+    }
+  });
+}
+
 ACT_STATUS act::topology::ActCompare::CheckAlive() {
   ACT_STATUS_INIT();
 
+  // Ping the devices at once
+  act_status = RunDeviceQueries([this](DeviceQuery &device_query) {
+    device_query.alive_status =
+        southbound_.PingIpAddress(device_query.device.GetIpv4().GetIpAddress(), ACT_PING_REPEAT_TIMES);
+  });
+  if (!IsActStatusSuccess(act_status)) {
+    return act_status;
+  }
+
   // Check device is alive
   bool fail_flag = false;
   QSet<QString> fail_devs;
   for (auto dev : compare_devices_) {
-    if (stop_flag_) {
-      return ACT_STATUS_STOP;
-    }
-
-    act_status = southbound_.PingIpAddress(dev.GetIpv4().GetIpAddress(), ACT_PING_REPEAT_TIMES);
+    act_status = device_queries_[dev.GetId()].alive_status;
     if (!IsActStatusSuccess(act_status)) {
       fail_flag = true;
       fail_devs.insert(QString("%1").arg(dev.GetIpv4().GetIpAddress()));
@@ -354,20 +431,24 @@ ACT_STATUS act::topology::ActCompare::CheckAlive() {
 ACT_STATUS act::topology::ActCompare::UpdateDevicesConnectStatusAndEnableSnmp() {
   ACT_STATUS_INIT();
 
-  // QList<ActDevice> new_cmp_devices;
-  for (auto dev : compare_devices_) {
-    if (stop_flag_) {
-      return ACT_STATUS_STOP;
-    }
+  // Update the connect status at once
+  act_status = RunDeviceQueries([this](DeviceQuery &device_query) {
+    device_query.connect_status = southbound_.FeatureAssignDeviceStatus(false, device_query.device);
+  });
+  if (!IsActStatusSuccess(act_status)) {
+    return act_status;
+  }
 
-    // Start update connect status by southbound
-    act_status = southbound_.FeatureAssignDeviceStatus(false, dev);
+  // Check in the device order, the first failed device is reported
+  for (auto dev : compare_devices_) {
+    const DeviceQuery &device_query = device_queries_[dev.GetId()];
+    act_status = device_query.connect_status;
     if (!IsActStatusSuccess(act_status)) {
       DeviceErrorLogHandler(__func__, "FeatureAssignDeviceStatus() Failed", dev);
       return act_status;
     }
 
-    compare_devices_[dev.GetId()] = dev;
+    compare_devices_[dev.GetId()] = device_query.device;
   }
 
   return act_status;
@@ -445,8 +526,8 @@ ACT_STATUS act::topology::ActCompare::CheckTopologyConsistent() {
     MacAddressToQInt64(dev.GetMacAddress(), mac_int);
     dev.mac_address_int = mac_int;
 
-    // Assign Lldp Data & Interfaces
-    act_status = southbound_.AssignDeviceLldpData(dev);
+    // Lldp Data & Interfaces are assigned by QueryDevices()
+    act_status = device_queries_[dev.GetId()].lldp_status;
     if (!IsActStatusSuccess(act_status)) {
       qCritical() << __func__ << "AssignDeviceLldpData() failed.";
       return act_status;
@@ -646,20 +727,16 @@ ACT_STATUS act::topology::ActCompare::CheckModelName() {
   bool fail_flag = false;
   QSet<QString> fail_devs;
   for (auto dev : compare_devices_) {
-    if (stop_flag_) {
-      return ACT_STATUS_STOP;
-    }
-
-    ActFeatureSubItem feature_sub_item;
-    act_status = GetDeviceFeatureSubItem(dev, profiles_.GetFirmwareFeatureProfiles(), profiles_.GetDeviceProfiles(),
-                                         ActFeatureEnum::kAutoScan, "Identify", "ModelName", feature_sub_item);
+    // The model name is got by QueryDevices()
+    const DeviceQuery &device_query = device_queries_[dev.GetId()];
+    act_status = device_query.model_name_sub_item_status;
     if (!IsActStatusSuccess(act_status)) {
       qCritical() << __func__ << "GetFeatureProfileFeatureSubItem() failed";
       continue;
     }
 
-    QString model_name;
-    act_status = southbound_.ActionGetModelName(dev, feature_sub_item, model_name);
+    const QString &model_name = device_query.model_name;
+    act_status = device_query.model_name_status;
     if (!IsActStatusSuccess(act_status)) {
       fail_flag = true;
       fail_devs.insert(QString("%1").arg(dev.GetIpv4().GetIpAddress()));
@@ -700,29 +777,15 @@ ACT_STATUS act::topology::ActCompare::CheckLinkSpeed() {
   using InterfaceSpeedMap = QMap<qint64, qint64>;  // <InterfaceId, Speed>
   QMap<qint64, InterfaceSpeedMap> dev_speed_map;   // <DeviceId, InterfaceSpeedMap>
 
-  // Get Speed
+  // Get Speed (queried by QueryDevices())
   for (auto dev : compare_devices_) {
-    if (stop_flag_) {
-      return ACT_STATUS_STOP;
-    }
-
-    // - Get Sub-Item (DeviceInformation  > PortSpeed)
-    ActFeatureSubItem port_speed_sub_item;
-    act_status =
-        GetDeviceFeatureSubItem(dev, profiles_.GetFirmwareFeatureProfiles(), profiles_.GetDeviceProfiles(),
-                                ActFeatureEnum::kAutoScan, "DeviceInformation", "PortSpeed", port_speed_sub_item);
-    if (!IsActStatusSuccess(act_status)) {
-      return act_status;
-    }
-
-    // Get port speed
-    InterfaceSpeedMap interface_speed_map;
-    act_status = southbound_.ActionGetPortSpeed(dev, port_speed_sub_item, interface_speed_map);
+    const DeviceQuery &device_query = device_queries_[dev.GetId()];
+    act_status = device_query.port_speed_status;
     if (!IsActStatusSuccess(act_status)) {
       qCritical() << __func__ << "ActionGetPortSpeed() failed.";
       return act_status;
     }
-    dev_speed_map.insert(dev.GetId(), interface_speed_map);
+    dev_speed_map.insert(dev.GetId(), device_query.interface_speed_map);
   }
 
   // Check Speed. South Speed should be faster.
@@ -5,9 +5,10 @@
 #define SLEEP_MS(ms) Sleep(ms)
 #else
 #include <unistd.h>  // for sleep
-#define SLEEP_MS(ms) sleep(ms / 1000)
+#define SLEEP_MS(ms) usleep((ms) * 1000)
 #endif
 
+#include "act_device_simulator.hpp"
 #include "act_grpc_server_process.hpp"
 #include "act_project.hpp"
 #include "act_status.hpp"
@@ -100,4 +101,143 @@ TEST_F(ActCompareTest, CompareIntegrationThread) {
 //   EXPECT_EQ(act_status->GetStatus(), ActStatusType::kSuccess) << "Close GRPC server failed";
 // }
 
+/**
+ * @brief Compare the project against the simulated fleet, the devices are queried at once or one by one
+ *
+ */
+class ActCompareSimulatorTest : public ActQuickTest {
+ protected:
+  simulator::ActSimulatorConfig config;
+  std::unique_ptr<simulator::ActDeviceSimulator> simulator;
+  ActSouthbound southbound;
+  ActProject project;
+  QList<qint64> dev_id_list;
+  act::topology::ActCompareControl compare_ctrl;
+
+  void SetUp() override {
+    config.SetDeviceCount(8);
+    config.SetTopology(simulator::ActSimulatorTopologyEnum::kRing);
+    config.SetSnmpPort(21161);
+    config.SetRestfulPort(28080);
+    simulator = std::make_unique<simulator::ActDeviceSimulator>(config);
+    ASSERT_TRUE(IsActStatusSuccess(simulator->Start()));
+    ASSERT_TRUE(IsActStatusSuccess(southbound.InitSnmpResource()));
+
+    for (qint32 index = 0; index < simulator->GetDevices().size(); index++) {
+      AddDevice(Device(index));
+    }
+
+    // The SNMP checks only (connect & model name)
+    compare_ctrl.SetDeviceConfig(false);
+    compare_ctrl.SetVlanHybridCapableConsistent(false);
+    compare_ctrl.SetTopologyConsistent(false);
+    compare_ctrl.SetYangRevision(false);
+    compare_ctrl.SetInterfaceStatus(false);
+    compare_ctrl.SetSpeed(false);
+    compare_ctrl.SetPropagationDelay(false);
+  }
+
+  void TearDown() override {
+    southbound.ClearSnmpResource();
+    simulator->Stop();
+  }
+
+  ActDevice Device(const QString &ip_address, const QString &model_name) {
+    ActDevice device(ip_address, model_name);
+    device.SetDeviceType(ActDeviceTypeEnum::kTSNSwitch);
+    device.SetDeviceProfileId(1);
+    device.SetEnableSnmpSetting(false);
+
+    ActSnmpConfiguration snmp_configuration;
+    snmp_configuration.SetVersion(ActSnmpVersionEnum::kV2c);
+    snmp_configuration.SetPort(config.GetSnmpPort());
+    snmp_configuration.SetReadCommunity(config.GetReadCommunity());
+    snmp_configuration.SetWriteCommunity(config.GetWriteCommunity());
+    device.SetSnmpConfiguration(snmp_configuration);
+
+    ActRestfulConfiguration restful_configuration;
+    restful_configuration.SetProtocol(ActRestfulProtocolEnum::kHTTP);
+    restful_configuration.SetPort(config.GetRestfulPort());
+    restful_configuration.SetUsername(config.GetUsername());
+    restful_configuration.SetPassword(config.GetPassword());
+    device.SetRestfulConfiguration(restful_configuration);
+    return device;
+  }
+
+  ActDevice Device(const qint32 &index) {
+    const simulator::ActSimulatedDevice &simulated_device = simulator->GetDevices().at(index);
+    ActDevice device = Device(simulated_device.GetIpAddress(), simulated_device.GetModelName());
+    device.SetId(simulated_device.GetId());
+    return device;
+  }
+
+  void AddDevice(const ActDevice &device) {
+    project.GetDevices().insert(device);
+    dev_id_list.append(device.GetId());
+  }
+
+  // The SNMP sub item of the device profile
+  static ActFeatureSubItem SnmpSubItem(const QString &method_key, const QMap<QString, QString> &actions) {
+    ActFeatureMethodProtocol protocol;
+    for (auto it = actions.constBegin(); it != actions.constEnd(); it++) {
+      ActMethodAction action;
+      action.SetPath(it.value());
+      protocol.GetActions().insert(it.key(), action);
+    }
+    ActFeatureMethod method;
+    method.GetProtocols().insert(kActConnectProtocolTypeEnumMap.key(ActConnectProtocolTypeEnum::kSNMP), protocol);
+    ActFeatureSubItem sub_item;
+    sub_item.GetMethods().insert(method_key, method);
+    return sub_item;
+  }
+
+  static ActProfiles Profiles() {
+    ActFeatureProfile base(ActFeatureEnum::kBase);
+    base.GetItems()["CheckConnection"].GetSubItems().insert(
+        "SNMP", SnmpSubItem("Method1", {{"SysObjectID", "1.3.6.1.2.1.1.2"}, {"SysDescr", "1.3.6.1.2.1.1.1"}}));
+    ActFeatureProfile auto_scan(ActFeatureEnum::kAutoScan);
+    auto_scan.GetItems()["Identify"].GetSubItems().insert("ModelName",
+                                                          SnmpSubItem("Method2", {{"SysDescr", "1.3.6.1.2.1.1.1"}}));
+
+    ActDeviceProfile device_profile(1);
+    device_profile.GetFeatureCapability().insert(base);
+    device_profile.GetFeatureCapability().insert(auto_scan);
+    ActProfiles profiles;
+    profiles.GetDeviceProfiles().insert(device_profile);
+    return profiles;
+  }
+
+  ACT_STATUS Compare(const quint32 &query_width) {
+    act::topology::ActCompare compare(Profiles());
+    compare.SetQueryWidth(query_width);
+    return compare.CompareTopology(project, dev_id_list, compare_ctrl);
+  }
+};
+
+TEST_F(ActCompareSimulatorTest, TestCompareSameAsSerial) {
+  ACT_STATUS act_status = Compare(ACT_COMPARE_QUERY_WIDTH);
+  EXPECT_TRUE(IsActStatusSuccess(act_status)) << act_status->ToString().toStdString();
+  EXPECT_EQ(Compare(1)->ToString(), act_status->ToString());
+}
+
+TEST_F(ActCompareSimulatorTest, TestMismatchSameAsSerial) {
+  // A mismatched model name & an unreachable device (no simulated device on the IP)
+  const QString mismatch_ip = simulator->GetDevices().at(2).GetIpAddress();
+  ActDevice mismatch_device = Device(2);
+  mismatch_device.GetDeviceProperty().SetModelName("TSN-G5004");
+  project.GetDevices().remove(mismatch_device);
+  project.GetDevices().insert(mismatch_device);
+  const QString unreachable_ip = "127.0.1.250";
+  AddDevice(Device(unreachable_ip, ACT_SIMULATOR_MODEL_NAME));
+
+  ACT_STATUS act_status = Compare(ACT_COMPARE_QUERY_WIDTH);
+  ASSERT_EQ(ActStatusType::kCompareFailed, act_status->GetStatus()) << act_status->ToString().toStdString();
+  auto compare_failed = std::dynamic_pointer_cast<ActStatusCompareFailed>(act_status);
+  ASSERT_NE(nullptr, compare_failed);
+  EXPECT_EQ(QSet<QString>({mismatch_ip, unreachable_ip}), compare_failed->GetParameter().GetTopologyItems());
+
+  // The same mismatch report as the serial run
+  EXPECT_EQ(Compare(1)->ToString(), act_status->ToString());
+}
+
 }  // namespace act
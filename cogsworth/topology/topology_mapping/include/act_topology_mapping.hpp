@@ -6,6 +6,7 @@ See the file MOXA-SOFTWARE-NOTICE for details.
 #ifndef ACT_TOPOLOGY_MAPPING_HPP
 #define ACT_TOPOLOGY_MAPPING_HPP
 
+#include <QHash>
 #include <QString>
 #include <thread>
 
@@ -123,6 +124,56 @@ class ActSourceDeviceCandidate : public QSerializer {
   }
 };
 
+/**
+ * @brief The index of the map topology for the topology mapping
+ *
+ * Built once in O(devices + links), so each device or link lookup of the mapping is O(1) instead of a linear search of
+ * the devices or the zero-hash link set. The device's links keep the first of the links sharing an id or an interface,
+ * the same as the QSet<ActLink> it replaces.
+ *
+ */
+class ActMapTopologyIndex {
+ public:
+  /**
+   * @brief Construct a new Act Map Topology Index object
+   *
+   * @param map_topology
+   */
+  ActMapTopologyIndex(const ActMapTopology &map_topology);
+
+  /**
+   * @brief Get the device
+   *
+   * @param device_id
+   * @return const ActDevice* nullptr if not found
+   */
+  const ActDevice *GetDevice(const qint64 &device_id) const;
+
+  /**
+   * @brief Get the links of the device (in the order of the topology's links)
+   *
+   * @param device_id
+   * @return const QList<ActLink>&
+   */
+  const QList<ActLink> &GetDeviceLinks(const qint64 &device_id) const;
+
+  /**
+   * @brief Get the device's interfaces of all the links on the device (in the order of the topology's links)
+   *
+   * @param device_id
+   * @return const QList<qint64>&
+   */
+  const QList<qint64> &GetLinkInterfaces(const qint64 &device_id) const;
+
+ private:
+  QList<ActDevice> devices_;
+  QHash<qint64, qint32> device_indexes_;          ///< <device id, index of devices_>
+  QHash<qint64, QList<ActLink>> device_links_;    ///< <device id, links>
+  QHash<qint64, QList<qint64>> link_interfaces_;  ///< <device id, interface ids>
+  QList<ActLink> empty_links_;
+  QList<qint64> empty_interfaces_;
+};
+
 class ActTopologyMapping {
   Q_GADGET
 
@@ -213,38 +264,71 @@ class ActTopologyMapping {
   /**
    * @brief Find offline source device candidates
    *
+   * The candidate should match the online source device's model name and link interfaces. The candidates matched the
+   * first hop are in front of the others, so a failed mapping tries the devices most likely to be the source first.
+   *
    * @param offline_topology
+   * @param offline_index
    * @param online_topology
+   * @param online_index
    * @param result_source_device_candidates
+   * @param result_first_hop_matched_num the number of the leading candidates matched the first hop
    * @return ACT_STATUS
    */
   ACT_STATUS FindOfflineSourceDeviceCandidates(const ActMapTopology &offline_topology,
+                                               const ActMapTopologyIndex &offline_index,
                                                const ActMapTopology &online_topology,
-                                               QList<qint64> &result_source_device_candidates);
+                                               const ActMapTopologyIndex &online_index,
+                                               QList<qint64> &result_source_device_candidates,
+                                               qint32 &result_first_hop_matched_num);
+
+  /**
+   * @brief Check the first hop of the offline source device candidate against the online source device
+   *
+   * The first hop is what MappingTopology checks from the source device: each leave interface is found online, the
+   * neighbor on it has the same model name and the online neighbor has all the leave interfaces of the offline one.
+   *
+   * @param offline_device_id
+   * @param offline_index
+   * @param online_device_id
+   * @param online_index
+   * @param offline_mapping_device_id_set
+   * @return true if the candidate could be mapped without the failed or warning items at its first hop
+   */
+  bool MatchSourceSignature(const qint64 &offline_device_id, const ActMapTopologyIndex &offline_index,
+                            const qint64 &online_device_id, const ActMapTopologyIndex &online_index,
+                            const QSet<qint64> &offline_mapping_device_id_set);
 
   /**
    * @brief Trigger the Mapping topology by multiple offline source devices
    *
    * @param offline_topology
+   * @param offline_index
    * @param online_topology
+   * @param online_index
+   * @param built_in_power_map
    * @param offline_source_devices
+   * @param first_hop_matched_num the leading offline_source_devices matched the first hop, the rest are only tried if
+   * none of them could deploy
    * @param mapping_result
    * @return ACT_STATUS
    */
   ACT_STATUS MappingTopologyByOfflineSources(const ActMapTopology &offline_topology,
+                                             const ActMapTopologyIndex &offline_index,
                                              const ActMapTopology &online_topology,
+                                             const ActMapTopologyIndex &online_index,
+                                             const QHash<qint64, bool> &built_in_power_map,
                                              const QList<qint64> &offline_source_devices,
+                                             const qint32 &first_hop_matched_num,
                                              ActTopologyMappingResult &mapping_result);
 
   /**
-   * @brief Generate the DeviceLinksMap<DeviceID, QSet<LinkID>> by ActMapTopology
+   * @brief Generate the BuiltInPowerMap<DeviceProfileID, BuiltInPower> by the device profiles
    *
-   * @param map_topology
-   * @param result_device_links_map
+   * @param result_built_in_power_map
    * @return ACT_STATUS
    */
-  ACT_STATUS GenerateDeviceLinksMap(const ActMapTopology &map_topology,
-                                    QMap<qint64, QSet<ActLink>> &result_device_links_map);
+  ACT_STATUS GenerateBuiltInPowerMap(QHash<qint64, bool> &result_built_in_power_map);
 
   /**
    * @brief Generate the LeaveInterfaceOppositeDeviceMap<LeaveInterfaceID, OppositeDeviceID> by Device's link
@@ -257,7 +341,7 @@ class ActTopologyMapping {
    * @return ACT_STATUS
    */
   ACT_STATUS GenerateLeaveInterfaceOppositeDeviceMap(const bool &check_moxa_vendor, const qint64 device_id,
-                                                     const QSet<ActLink> &device_links,
+                                                     const QList<ActLink> &device_links,
                                                      const QSet<qint64> moxa_vendor_devices_id,
                                                      QMap<qint64, qint64> &result_map);
 
@@ -315,15 +399,19 @@ class ActTopologyMapping {
   ACT_STATUS UpdateManufactureReadyDevices(ActProject &project, const ActTopologyMappingResult &mapping_result);
 
   /**
-   * @brief Mapping Offline & Online topology
+   * @brief Mapping Offline & Online topology by the indexes
    *
    * @param offline_topology
+   * @param offline_index
    * @param online_topology
+   * @param online_index
+   * @param built_in_power_map
    * @param result
    * @return ACT_STATUS
    */
-  ACT_STATUS MappingTopology(const ActMapTopology &offline_topology, const ActMapTopology &online_topology,
-                             ActTopologyMappingResult &result);
+  ACT_STATUS MappingTopology(const ActMapTopology &offline_topology, const ActMapTopologyIndex &offline_index,
+                             const ActMapTopology &online_topology, const ActMapTopologyIndex &online_index,
+                             const QHash<qint64, bool> &built_in_power_map, ActTopologyMappingResult &result);
 
   /**
    * @brief Sort MapTopology's devices
@@ -398,6 +486,28 @@ class ActTopologyMapping {
    */
   ACT_STATUS Mapper(ActProject &project, ActTopologyMappingResult &mapping_result);
 
+  /**
+   * @brief Map the project onto the scanned online topology (the mapping part of the Mapper)
+   *
+   * @param project
+   * @param online_topology
+   * @param mapping_result
+   * @return ACT_STATUS
+   */
+  ACT_STATUS MapOnlineTopology(ActProject &project, const ActMapTopology &online_topology,
+                               ActTopologyMappingResult &mapping_result);
+
+  /**
+   * @brief Mapping Offline & Online topology
+   *
+   * @param offline_topology
+   * @param online_topology
+   * @param result
+   * @return ACT_STATUS
+   */
+  ACT_STATUS MappingTopology(const ActMapTopology &offline_topology, const ActMapTopology &online_topology,
+                             ActTopologyMappingResult &result);
+
   /**
    * @brief Start the ScanMapper by new thread
    *
@@ -5,7 +5,7 @@
 #define SLEEP_MS(ms) Sleep(ms)
 #else
 #include <unistd.h>  // for sleep
-#define SLEEP_MS(ms) sleep(ms / 1000)
+#define SLEEP_MS(ms) usleep((ms) * 1000)
 #endif
 
 #include <QDebug>
@@ -16,6 +16,56 @@
 
 using namespace act::topology;
 
+ActMapTopologyIndex::ActMapTopologyIndex(const ActMapTopology &map_topology) : devices_(map_topology.GetDevices()) {
+  // The first device wins, the same as QList::indexOf
+  device_indexes_.reserve(devices_.size());
+  for (qint32 index = 0; index < devices_.size(); index++) {
+    if (!device_indexes_.contains(devices_.at(index).GetId())) {
+      device_indexes_.insert(devices_.at(index).GetId(), index);
+    }
+  }
+
+  // A link equals the previous one of the device sharing its id or any of its (device, interface) ends
+  QHash<qint64, QSet<qint64>> device_link_ids;
+  QHash<qint64, QSet<QPair<qint64, qint64>>> device_link_ends;
+  for (const ActLink &link : map_topology.GetLinks()) {
+    const auto source = qMakePair(link.GetSourceDeviceId(), link.GetSourceInterfaceId());
+    const auto destination = qMakePair(link.GetDestinationDeviceId(), link.GetDestinationInterfaceId());
+    for (const qint64 &device_id : {link.GetDestinationDeviceId(), link.GetSourceDeviceId()}) {
+      QSet<qint64> &link_ids = device_link_ids[device_id];
+      QSet<QPair<qint64, qint64>> &link_ends = device_link_ends[device_id];
+      if (link_ids.contains(link.GetId()) || link_ends.contains(source) || link_ends.contains(destination)) {
+        continue;
+      }
+      link_ids.insert(link.GetId());
+      link_ends.insert(source);
+      link_ends.insert(destination);
+      device_links_[device_id].append(link);
+    }
+
+    // Every link counts, the destination first
+    link_interfaces_[link.GetDestinationDeviceId()].append(link.GetDestinationInterfaceId());
+    if (link.GetSourceDeviceId() != link.GetDestinationDeviceId()) {
+      link_interfaces_[link.GetSourceDeviceId()].append(link.GetSourceInterfaceId());
+    }
+  }
+}
+
+const ActDevice *ActMapTopologyIndex::GetDevice(const qint64 &device_id) const {
+  auto index_it = device_indexes_.constFind(device_id);
+  return (index_it == device_indexes_.constEnd()) ? nullptr : &devices_.at(index_it.value());
+}
+
+const QList<ActLink> &ActMapTopologyIndex::GetDeviceLinks(const qint64 &device_id) const {
+  auto links_it = device_links_.constFind(device_id);
+  return (links_it == device_links_.constEnd()) ? empty_links_ : links_it.value();
+}
+
+const QList<qint64> &ActMapTopologyIndex::GetLinkInterfaces(const qint64 &device_id) const {
+  auto interfaces_it = link_interfaces_.constFind(device_id);
+  return (interfaces_it == link_interfaces_.constEnd()) ? empty_interfaces_ : interfaces_it.value();
+}
+
 ActTopologyMapping::~ActTopologyMapping() {
   if ((topology_mapping_thread_ != nullptr) && (topology_mapping_thread_->joinable())) {
     topology_mapping_thread_->join();
@@ -162,21 +212,42 @@ ACT_STATUS ActTopologyMapping::Mapper(ActProject &project, ActTopologyMappingRes
   }
 
   // Topology mapping
+  MapOnlineTopology(project, online_topology, mapping_result);
+
+  UpdateProgress(100);
+  return ACT_STATUS_SUCCESS;
+}
+
+ACT_STATUS ActTopologyMapping::MapOnlineTopology(ActProject &project, const ActMapTopology &online_topology,
+                                                 ActTopologyMappingResult &mapping_result) {
+  ACT_STATUS_INIT();
+
   ActMapTopology offline_topology(project.GetDevices().values(), project.GetLinks().values());
 
+  // Index the topologies once for all the candidates
+  ActMapTopologyIndex offline_index(offline_topology);
+  ActMapTopologyIndex online_index(online_topology);
+  QHash<qint64, bool> built_in_power_map;
+  GenerateBuiltInPowerMap(built_in_power_map);
+
   // Find candidates for the offline source device.
   QList<qint64> source_device_candidates;
-  act_status = FindOfflineSourceDeviceCandidates(offline_topology, online_topology, source_device_candidates);
+  qint32 first_hop_matched_num = 0;
+  act_status = FindOfflineSourceDeviceCandidates(offline_topology, offline_index, online_topology, online_index,
+                                                 source_device_candidates, first_hop_matched_num);
   if (!IsActStatusSuccess(act_status)) {
     qInfo() << __func__ << "FindOfflineSourceDeviceCandidates() failed.";
   }
   qDebug() << "source_device_candidates size:" << source_device_candidates.size();
 
   if (source_device_candidates.size() == 0) {  // for generate the mapping_result report
-    MappingTopology(offline_topology, online_topology, mapping_result);
+    MappingTopology(offline_topology, offline_index, online_topology, online_index, built_in_power_map,
+                    mapping_result);
   } else {
     // Use the candidates to Mapping topology
-    MappingTopologyByOfflineSources(offline_topology, online_topology, source_device_candidates, mapping_result);
+    MappingTopologyByOfflineSources(offline_topology, offline_index, online_topology, online_index,
+                                    built_in_power_map, source_device_candidates, first_hop_matched_num,
+                                    mapping_result);
   }
 
   // Can's Deploy print log.
@@ -194,7 +265,6 @@ ACT_STATUS ActTopologyMapping::Mapper(ActProject &project, ActTopologyMappingRes
     project.online_topology_ = ActOnlineTopology(online_topology, mapping_result);
   }
 
-  UpdateProgress(100);
   return ACT_STATUS_SUCCESS;
 }
 
@@ -208,6 +278,11 @@ ACT_STATUS ActTopologyMapping::UpdateProjectDevicesConfiguration(ActProject &pro
     return act_status;
   }
 
+  QHash<qint64, qint32> online_device_indexes;  // <device id, index of online_devices>
+  for (qint32 index = online_devices.size() - 1; index >= 0; index--) {
+    online_device_indexes.insert(online_devices.at(index).GetId(), index);
+  }
+
   auto new_devices = project.GetDevices();
   for (auto device_result : mapping_result.GetMappingReport()) {
     // Check device mapping status is Success or Warning
@@ -237,7 +312,10 @@ ACT_STATUS ActTopologyMapping::UpdateProjectDevicesConfiguration(ActProject &pro
       offline_device.mac_address_int = mac_int;
 
       // Connect config (SNMP, RESTful, NETCONF)
-      auto online_device_index = online_devices.indexOf(ActDevice(device_result.GetOnlineDeviceId()));
+      auto online_device_index = online_device_indexes.value(device_result.GetOnlineDeviceId(), -1);
+      if (online_device_index == -1) {
+        continue;
+      }
       auto online_device = online_devices.at(online_device_index);
       offline_device.SetAccount(online_device.GetAccount());
       offline_device.SetNetconfConfiguration(online_device.GetNetconfConfiguration());
@@ -303,26 +381,13 @@ ACT_STATUS ActTopologyMapping::UpdateIpSettingMapByMappingResult(ActProject &pro
   return act_status;
 }
 
-ACT_STATUS ActTopologyMapping::GenerateDeviceLinksMap(const ActMapTopology &map_topology,
-                                                      QMap<qint64, QSet<ActLink>> &result_device_links_map) {
+ACT_STATUS ActTopologyMapping::GenerateBuiltInPowerMap(QHash<qint64, bool> &result_built_in_power_map) {
   ACT_STATUS_INIT();
 
-  result_device_links_map.clear();
+  result_built_in_power_map.clear();
 
-  for (auto link : map_topology.GetLinks()) {
-    // Insert Destination Device ID
-    if (!result_device_links_map.contains(link.GetDestinationDeviceId())) {
-      result_device_links_map[link.GetDestinationDeviceId()] = {link};
-    } else {
-      result_device_links_map[link.GetDestinationDeviceId()].insert(link);
-    }
-
-    // Destination Source ID
-    if (!result_device_links_map.contains(link.GetSourceDeviceId())) {
-      result_device_links_map[link.GetSourceDeviceId()] = {link};
-    } else {
-      result_device_links_map[link.GetSourceDeviceId()].insert(link);
-    }
+  for (auto device_profile : profiles_.GetDeviceProfiles()) {
+    result_built_in_power_map.insert(device_profile.GetId(), device_profile.GetBuiltInPower());
   }
 
   return act_status;
@@ -330,7 +395,7 @@ ACT_STATUS ActTopologyMapping::GenerateDeviceLinksMap(const ActMapTopology &map_
 
 ACT_STATUS ActTopologyMapping::GenerateLeaveInterfaceOppositeDeviceMap(const bool &check_moxa_vendor,
                                                                        const qint64 device_id,
-                                                                       const QSet<ActLink> &device_links,
+                                                                       const QList<ActLink> &device_links,
                                                                        const QSet<qint64> moxa_vendor_devices_id,
                                                                        QMap<qint64, qint64> &result_map) {
   ACT_STATUS_INIT();
@@ -528,6 +593,19 @@ ACT_STATUS ActTopologyMapping::CheckDevice(const ActDevice &offline_device, cons
 ACT_STATUS ActTopologyMapping::MappingTopology(const ActMapTopology &offline_topology,
                                                const ActMapTopology &online_topology,
                                                ActTopologyMappingResult &result) {
+  QHash<qint64, bool> built_in_power_map;
+  GenerateBuiltInPowerMap(built_in_power_map);
+
+  return MappingTopology(offline_topology, ActMapTopologyIndex(offline_topology), online_topology,
+                         ActMapTopologyIndex(online_topology), built_in_power_map, result);
+}
+
+ACT_STATUS ActTopologyMapping::MappingTopology(const ActMapTopology &offline_topology,
+                                               const ActMapTopologyIndex &offline_index,
+                                               const ActMapTopology &online_topology,
+                                               const ActMapTopologyIndex &online_index,
+                                               const QHash<qint64, bool> &built_in_power_map,
+                                               ActTopologyMappingResult &result) {
   ACT_STATUS_INIT();
   result = ActTopologyMappingResult();
 
@@ -539,23 +617,22 @@ ACT_STATUS ActTopologyMapping::MappingTopology(const ActMapTopology &offline_top
   QSet<qint64> offline_device_check_failed_id_set;
 
   // Prepare data
-  QMap<qint64, QSet<ActLink>> offline_device_links_map;  // QMap<DeviceID, QSet<LinkID>>
-  QMap<qint64, QSet<ActLink>> online_device_links_map;   // QMap<DeviceID, QSet<LinkID>>
-  GenerateDeviceLinksMap(offline_topology, offline_device_links_map);
-  GenerateDeviceLinksMap(online_topology, online_device_links_map);
   QSet<qint64> offline_mapping_device_id_set;
   GenerateOfflineMappingDeviceSet(offline_topology, offline_mapping_device_id_set);
 
   QQueue<qint64> offline_device_id_queue;
+  QSet<qint64> queued_offline_device_id_set;  // the devices in offline_device_id_queue
   qint64 online_device_id = online_topology.GetSourceDeviceId();
 
   // Check Source Device is MOXA device
   if (offline_mapping_device_id_set.contains(offline_topology.GetSourceDeviceId())) {
     offline_device_id_queue.enqueue(offline_topology.GetSourceDeviceId());
+    queued_offline_device_id_set.insert(offline_topology.GetSourceDeviceId());
   }
 
   while (!offline_device_id_queue.isEmpty() && (!online_topology.GetDevices().isEmpty())) {
     auto offline_device_id = offline_device_id_queue.dequeue();
+    queued_offline_device_id_set.remove(offline_device_id);
 
     if (offline_device_id != offline_topology.GetSourceDeviceId()) {  // not first
       // Get online_device_id
@@ -587,29 +664,26 @@ ACT_STATUS ActTopologyMapping::MappingTopology(const ActMapTopology &offline_top
     //                 .c_str();
 
     // Find Offline Device
-    auto device_index = offline_topology.GetDevices().indexOf(ActDevice(offline_device_id));
-    if (device_index == -1) {
+    const ActDevice *offline_device_ptr = offline_index.GetDevice(offline_device_id);
+    if (offline_device_ptr == nullptr) {
       qCritical() << __func__ << "Offline device not found. DeviceID:" << offline_device_id;
       return std::make_shared<ActStatusNotFound>(QString("Device(%1) in offline topology").arg(offline_device_id));
     }
-    auto offline_device = offline_topology.GetDevices().at(device_index);
+    const ActDevice &offline_device = *offline_device_ptr;
 
     // Check Online device
     // Find Online Device
-    device_index = online_topology.GetDevices().indexOf(ActDevice(online_device_id));
-    if (device_index == -1) {
+    const ActDevice *online_device_ptr = online_index.GetDevice(online_device_id);
+    if (online_device_ptr == nullptr) {
       qCritical() << __func__ << "Online device not found. DeviceID:" << online_device_id;
       return std::make_shared<ActStatusNotFound>(QString("Device(%1) in online topology").arg(online_device_id));
     }
-    auto online_device = online_topology.GetDevices().at(device_index);
+    const ActDevice &online_device = *online_device_ptr;
     found_online_device_id_set.insert(online_device_id);
     online_mapped_device_id_set.insert(online_device_id);
 
     // Get Profile
-    ActDeviceProfile online_device_profile;
-    act_status = ActGetItemById<ActDeviceProfile>(profiles_.GetDeviceProfiles(), online_device.GetDeviceProfileId(),
-                                                  online_device_profile);
-    if (!IsActStatusSuccess(act_status)) {
+    if (!built_in_power_map.contains(online_device.GetDeviceProfileId())) {
       qCritical() << __func__
                   << QString("The device profile not found. DeviceProfile:%1")
                          .arg(online_device.GetDeviceProfileId())
@@ -617,7 +691,7 @@ ACT_STATUS ActTopologyMapping::MappingTopology(const ActMapTopology &offline_top
                          .c_str();
       return std::make_shared<ActStatusInternalError>("TopologyMapping");
     }
-    bool &built_in_power = online_device_profile.GetBuiltInPower();
+    const bool built_in_power = built_in_power_map.value(online_device.GetDeviceProfileId());
 
     // Avoid duplicated check
     if (!offline_devices_result.contains(offline_device_id)) {
@@ -626,33 +700,35 @@ ACT_STATUS ActTopologyMapping::MappingTopology(const ActMapTopology &offline_top
     }
 
     // Enqueue neighbor device by link
-    for (auto neighbor_link : offline_device_links_map[offline_device_id]) {
+    for (const auto &neighbor_link : offline_index.GetDeviceLinks(offline_device_id)) {
       // Enqueue device(only uncheck device && not in the queue && is moxa device)
       auto next_device_id = neighbor_link.GetDestinationDeviceId();
       if ((!offline_devices_result.contains(next_device_id)) &&
-          (!offline_device_id_queue.contains(next_device_id))) {  // destination
+          (!queued_offline_device_id_set.contains(next_device_id))) {  // destination
         if (offline_mapping_device_id_set.contains(next_device_id)) {
           offline_device_id_queue.enqueue(next_device_id);
+          queued_offline_device_id_set.insert(next_device_id);
         }
       }
 
       next_device_id = neighbor_link.GetSourceDeviceId();
       if ((!offline_devices_result.contains(next_device_id)) &&
-          (!offline_device_id_queue.contains(next_device_id))) {  // source
+          (!queued_offline_device_id_set.contains(next_device_id))) {  // source
         if (offline_mapping_device_id_set.contains(next_device_id)) {
           offline_device_id_queue.enqueue(next_device_id);
+          queued_offline_device_id_set.insert(next_device_id);
         }
       }
     }
 
     // Get offline leave_if_id
     QMap<qint64, qint64> offline_leave_if_and_opposite_dev_map;  // <leave_if_id, opposite_id>
-    GenerateLeaveInterfaceOppositeDeviceMap(true, offline_device_id, offline_device_links_map[offline_device_id],
+    GenerateLeaveInterfaceOppositeDeviceMap(true, offline_device_id, offline_index.GetDeviceLinks(offline_device_id),
                                             offline_mapping_device_id_set, offline_leave_if_and_opposite_dev_map);
 
     // Get online leave_if_id
     QMap<qint64, qint64> online_leave_if_and_opposite_dev_map;  // <leave_if_id, opposite_id>
-    GenerateLeaveInterfaceOppositeDeviceMap(false, online_device_id, online_device_links_map[online_device_id],
+    GenerateLeaveInterfaceOppositeDeviceMap(false, online_device_id, online_index.GetDeviceLinks(online_device_id),
                                             offline_mapping_device_id_set, online_leave_if_and_opposite_dev_map);
 
     QMap<qint64, QString> offline_device_interfaces_name_map;
@@ -694,23 +770,21 @@ ACT_STATUS ActTopologyMapping::MappingTopology(const ActMapTopology &offline_top
           continue;
         }
 
-        auto device_index = offline_topology.GetDevices().indexOf(ActDevice(offline_opposite_device_id));
-        if (device_index == -1) {
+        const ActDevice *offline_opposite_device = offline_index.GetDevice(offline_opposite_device_id);
+        if (offline_opposite_device == nullptr) {
           qCritical() << __func__ << "Offline device not found. Device:" << offline_opposite_device_id;
           return std::make_shared<ActStatusNotFound>(
               QString("Offline device(%1) in OfflineTopology").arg(offline_opposite_device_id));
         }
-        auto offline_opposite_device = offline_topology.GetDevices().at(device_index);
 
         // Find online_opposite_device
         auto online_opposite_device_id = online_leave_if_and_opposite_dev_map[leave_if_id];
-        device_index = online_topology.GetDevices().indexOf(ActDevice(online_opposite_device_id));
-        if (device_index == -1) {
+        const ActDevice *online_opposite_device = online_index.GetDevice(online_opposite_device_id);
+        if (online_opposite_device == nullptr) {
           qCritical() << __func__ << "Online device not found. DeviceID:" << online_opposite_device_id;
           return std::make_shared<ActStatusNotFound>(
               QString("Online Device(%1) in OnlineTopology").arg(online_opposite_device_id));
         }
-        auto online_opposite_device = online_topology.GetDevices().at(device_index);
         found_online_device_id_set.insert(online_opposite_device_id);
 
         // [bugfix:2885] Topology mapping - mapping result show 1 online IP twice
@@ -719,19 +793,16 @@ ACT_STATUS ActTopologyMapping::MappingTopology(const ActMapTopology &offline_top
         }
 
         // Device Check
-        ActDeviceProfile online_opposite_device_profile;
-        act_status = ActGetItemById<ActDeviceProfile>(
-            profiles_.GetDeviceProfiles(), online_opposite_device.GetDeviceProfileId(), online_opposite_device_profile);
-        if (!IsActStatusSuccess(act_status)) {
+        if (!built_in_power_map.contains(online_opposite_device->GetDeviceProfileId())) {
           qCritical() << __func__
                       << QString("The device profile not found. DeviceProfile:%1")
-                             .arg(online_opposite_device.GetDeviceProfileId())
+                             .arg(online_opposite_device->GetDeviceProfileId())
                              .toStdString()
                              .c_str();
           return std::make_shared<ActStatusInternalError>("TopologyMapping");
         }
-        bool &built_in_power = online_opposite_device_profile.GetBuiltInPower();
-        auto act_check_status = CheckDevice(offline_opposite_device, online_opposite_device, built_in_power,
+        const bool opposite_built_in_power = built_in_power_map.value(online_opposite_device->GetDeviceProfileId());
+        auto act_check_status = CheckDevice(*offline_opposite_device, *online_opposite_device, opposite_built_in_power,
                                             offline_devices_result, offline_device_check_failed_id_set);
         if (!IsActStatusSuccess(act_check_status)) {
           continue;
@@ -747,7 +818,7 @@ ACT_STATUS ActTopologyMapping::MappingTopology(const ActMapTopology &offline_top
       // Get not found port device
       if (offline_not_found_port_device_id_set.contains(offline_device_id)) {
         // Find offline link
-        for (auto device_link : offline_device_links_map[offline_device_id]) {
+        for (const auto &device_link : offline_index.GetDeviceLinks(offline_device_id)) {
           // Get opposite device id
           auto opposite_offline_device_id = device_link.GetSourceDeviceId() == offline_device_id
                                                 ? device_link.GetDestinationDeviceId()
@@ -912,22 +983,34 @@ ACT_STATUS ActTopologyMapping::ScanPhysicalTopology(const ActProject &project,
 }
 
 ACT_STATUS ActTopologyMapping::MappingTopologyByOfflineSources(const ActMapTopology &offline_topology,
+                                                               const ActMapTopologyIndex &offline_index,
                                                                const ActMapTopology &online_topology,
+                                                               const ActMapTopologyIndex &online_index,
+                                                               const QHash<qint64, bool> &built_in_power_map,
                                                                const QList<qint64> &offline_source_devices,
+                                                               const qint32 &first_hop_matched_num,
                                                                ActTopologyMappingResult &mapping_result) {
   ACT_STATUS_INIT();
 
   // For each candidates to MappingTopology try to get best result;
   QList<ActTopologyMappingResultCandidate> mapping_result_candidates;
-  for (auto ofl_src_dev_id : offline_source_devices) {
+  bool has_deploy_candidate = false;
+  for (qint32 index = 0; index < offline_source_devices.size(); index++) {
+    // The candidates failed the first hop are only tried if no matched one could deploy
+    if ((index == first_hop_matched_num) && has_deploy_candidate) {
+      break;
+    }
+
+    const qint64 ofl_src_dev_id = offline_source_devices.at(index);
     ActTopologyMappingResult topology_mapping_result;
 
     // Create candidate offline_topology with ofl_src_dev_id
     ActMapTopology candidate_offline_topology(offline_topology);
     candidate_offline_topology.SetSourceDeviceId(ofl_src_dev_id);
 
-    // Start mapping algorithm
-    MappingTopology(candidate_offline_topology, online_topology, topology_mapping_result);
+    // Start mapping algorithm, the indexes do not depend on the source device
+    MappingTopology(candidate_offline_topology, offline_index, online_topology, online_index, built_in_power_map,
+                    topology_mapping_result);
     ActTopologyMappingResultCandidate candidate(topology_mapping_result, candidate_offline_topology);
     if (topology_mapping_result.GetDeploy() && (candidate.GetWarningItemNum() == 0) &&
         (candidate.GetFailedItemNum() == 0)) {
@@ -940,6 +1023,7 @@ ACT_STATUS ActTopologyMapping::MappingTopologyByOfflineSources(const ActMapTopol
       //                 .c_str();
       return ACT_STATUS_SUCCESS;
     } else {
+      has_deploy_candidate = has_deploy_candidate || topology_mapping_result.GetDeploy();
       mapping_result_candidates.append(candidate);
       // qDebug() << __func__
       //          << QString("mapping_result_candidates: candidate src(%1): %2")
@@ -1007,36 +1091,33 @@ ACT_STATUS ActTopologyMapping::MappingTopologyByOfflineSources(const ActMapTopol
 }
 
 ACT_STATUS ActTopologyMapping::FindOfflineSourceDeviceCandidates(const ActMapTopology &offline_topology,
+                                                                 const ActMapTopologyIndex &offline_index,
                                                                  const ActMapTopology &online_topology,
-                                                                 QList<qint64> &result_source_device_candidates) {
+                                                                 const ActMapTopologyIndex &online_index,
+                                                                 QList<qint64> &result_source_device_candidates,
+                                                                 qint32 &result_first_hop_matched_num) {
   ACT_STATUS_INIT();
 
   result_source_device_candidates.clear();
+  result_first_hop_matched_num = 0;
 
   QList<ActSourceDeviceCandidate> dev_candidates;
+  QList<ActSourceDeviceCandidate> unmatched_dev_candidates;  // failed the first hop
 
   // Get online source device
   auto onl_src_dev_id = online_topology.GetSourceDeviceId();
-  auto onl_src_dev_idx = online_topology.GetDevices().indexOf(ActDevice(onl_src_dev_id));
-  if (onl_src_dev_idx == -1) {
+  const ActDevice *onl_src_dev_ptr = online_index.GetDevice(onl_src_dev_id);
+  if (onl_src_dev_ptr == nullptr) {
     qCritical() << __func__ << "Online source device not found. Device:" << onl_src_dev_id;
     return std::make_shared<ActStatusNotFound>(QString("Online device(%1) in OnlineTopology").arg(onl_src_dev_id));
   }
-  auto onl_src_dev = online_topology.GetDevices().at(onl_src_dev_idx);
+  const ActDevice &onl_src_dev = *onl_src_dev_ptr;
 
   // Get online links Interface that connect to onl_source_device
-  QList<qint64> onl_src_up_link_ifs;  // QList<IntefaceID>
-  for (auto onl_link : online_topology.GetLinks()) {
-    if (onl_src_dev_id == onl_link.GetDestinationDeviceId()) {
-      onl_src_up_link_ifs.append(onl_link.GetDestinationInterfaceId());
-      continue;
-    }
+  const QList<qint64> &onl_src_up_link_ifs = online_index.GetLinkInterfaces(onl_src_dev_id);  // QList<IntefaceID>
 
-    if (onl_src_dev_id == onl_link.GetSourceDeviceId()) {
-      onl_src_up_link_ifs.append(onl_link.GetSourceInterfaceId());
-      continue;
-    }
-  }
+  QSet<qint64> offline_mapping_device_id_set;
+  GenerateOfflineMappingDeviceSet(offline_topology, offline_mapping_device_id_set);
 
   QList<ActDevice> ofl_same_model_devs;
   // Get offline source device candidates
@@ -1058,18 +1139,7 @@ ACT_STATUS ActTopologyMapping::FindOfflineSourceDeviceCandidates(const ActMapTop
     ofl_same_model_devs.append(ofl_dev);
 
     // Get links Interface that connect to this device
-    QList<qint64> ofl_dev_up_link_ifs;  // QList<IntefaceID>
-    for (auto ofl_link : offline_topology.GetLinks()) {
-      if (ofl_dev.GetId() == ofl_link.GetDestinationDeviceId()) {
-        ofl_dev_up_link_ifs.append(ofl_link.GetDestinationInterfaceId());
-        continue;
-      }
-
-      if (ofl_dev.GetId() == ofl_link.GetSourceDeviceId()) {
-        ofl_dev_up_link_ifs.append(ofl_link.GetSourceInterfaceId());
-        continue;
-      }
-    }
+    const QList<qint64> &ofl_dev_up_link_ifs = offline_index.GetLinkInterfaces(ofl_dev.GetId());  // QList<IntefaceID>
 
     // - Check number of link
     // offline device link >= online device link (avoid loop, need to disconnect a link)
@@ -1121,13 +1191,20 @@ ACT_STATUS ActTopologyMapping::FindOfflineSourceDeviceCandidates(const ActMapTop
     }
 
     // Append to result
+    // - Check the first hop, the candidate failed at its first hop would never be mapped without failed or warning
+    // items (but may be deployable with the warnings, e.g. a cable next to the source is unplugged)
     quint32 ip_num;
     ofl_dev.GetIpv4().GetIpAddressNumber(ip_num);
-    dev_candidates.append(ActSourceDeviceCandidate(ofl_dev.GetId(), ip_num, ofl_dev_up_link_ifs));
+    if (MatchSourceSignature(ofl_dev.GetId(), offline_index, onl_src_dev_id, online_index,
+                             offline_mapping_device_id_set)) {
+      dev_candidates.append(ActSourceDeviceCandidate(ofl_dev.GetId(), ip_num, ofl_dev_up_link_ifs));
+    } else {
+      unmatched_dev_candidates.append(ActSourceDeviceCandidate(ofl_dev.GetId(), ip_num, ofl_dev_up_link_ifs));
+    }
   }
 
   // If offline source device candidates is empty, would try to find same IP & ModelName as candidate
-  if (dev_candidates.isEmpty()) {
+  if (dev_candidates.isEmpty() && unmatched_dev_candidates.isEmpty()) {
     for (auto ofl_same_model_dev : ofl_same_model_devs) {
       if (ofl_same_model_dev.GetIpv4().GetIpAddress() == onl_src_dev.GetIpv4().GetIpAddress()) {
         // Append to result
@@ -1142,24 +1219,28 @@ ACT_STATUS ActTopologyMapping::FindOfflineSourceDeviceCandidates(const ActMapTop
   // 1. Same IP with online_source_device (TBD)
   // 2. Number of interface  (from large to small)
   // 3. IP address (from small to large)
+  // The candidates failed the first hop are after the matched ones
   quint32 onl_src_dev_ip_num;
   onl_src_dev.GetIpv4().GetIpAddressNumber(onl_src_dev_ip_num);
-  std::sort(dev_candidates.begin(), dev_candidates.end(),
-            [onl_src_dev_ip_num](const ActSourceDeviceCandidate &x, const ActSourceDeviceCandidate &y) {
-              // 1. Same IP with online_source_device(move to front)
-              if (x.GetIpNumber() == onl_src_dev_ip_num && y.GetIpNumber() != onl_src_dev_ip_num) {
-                return true;  // a << b
-              }
-              if (x.GetIpNumber() != onl_src_dev_ip_num && y.GetIpNumber() == onl_src_dev_ip_num) {
-                return false;  // b << a
-              }
-
-              // 2. Number of interface  (from large to small)
-              // 3. IP address (from small to large)
-              return y.GetUpLinkInterfacesId().size() < x.GetUpLinkInterfacesId().size() ||
-                     (x.GetUpLinkInterfacesId().size() == y.GetUpLinkInterfacesId().size() &&
-                      x.GetIpNumber() < y.GetIpNumber());
-            });
+  auto compare = [onl_src_dev_ip_num](const ActSourceDeviceCandidate &x, const ActSourceDeviceCandidate &y) {
+    // 1. Same IP with online_source_device(move to front)
+    if (x.GetIpNumber() == onl_src_dev_ip_num && y.GetIpNumber() != onl_src_dev_ip_num) {
+      return true;  // a << b
+    }
+    if (x.GetIpNumber() != onl_src_dev_ip_num && y.GetIpNumber() == onl_src_dev_ip_num) {
+      return false;  // b << a
+    }
+
+    // 2. Number of interface  (from large to small)
+    // 3. IP address (from small to large)
+    return y.GetUpLinkInterfacesId().size() < x.GetUpLinkInterfacesId().size() ||
+           (x.GetUpLinkInterfacesId().size() == y.GetUpLinkInterfacesId().size() &&
+            x.GetIpNumber() < y.GetIpNumber());
+  };
+  std::sort(dev_candidates.begin(), dev_candidates.end(), compare);
+  std::sort(unmatched_dev_candidates.begin(), unmatched_dev_candidates.end(), compare);
+  result_first_hop_matched_num = dev_candidates.size();
+  dev_candidates.append(unmatched_dev_candidates);
 
   // Append to result
   for (auto dev_candidate : dev_candidates) {
@@ -1177,6 +1258,61 @@ ACT_STATUS ActTopologyMapping::FindOfflineSourceDeviceCandidates(const ActMapTop
   return act_status;
 }
 
+bool ActTopologyMapping::MatchSourceSignature(const qint64 &offline_device_id, const ActMapTopologyIndex &offline_index,
+                                              const qint64 &online_device_id, const ActMapTopologyIndex &online_index,
+                                              const QSet<qint64> &offline_mapping_device_id_set) {
+  // The same leave interfaces as MappingTopology checks from the source device
+  QMap<qint64, qint64> offline_leave_if_and_opposite_dev_map;  // <leave_if_id, opposite_id>
+  GenerateLeaveInterfaceOppositeDeviceMap(true, offline_device_id, offline_index.GetDeviceLinks(offline_device_id),
+                                          offline_mapping_device_id_set, offline_leave_if_and_opposite_dev_map);
+  QMap<qint64, qint64> online_leave_if_and_opposite_dev_map;  // <leave_if_id, opposite_id>
+  GenerateLeaveInterfaceOppositeDeviceMap(false, online_device_id, online_index.GetDeviceLinks(online_device_id),
+                                          offline_mapping_device_id_set, online_leave_if_and_opposite_dev_map);
+
+  QSet<qint64> checked_offline_device_id_set;
+  for (auto it = offline_leave_if_and_opposite_dev_map.constBegin();
+       it != offline_leave_if_and_opposite_dev_map.constEnd(); it++) {
+    // Port not found
+    if (!online_leave_if_and_opposite_dev_map.contains(it.key())) {
+      return false;
+    }
+
+    const qint64 offline_opposite_device_id = it.value();
+    const qint64 online_opposite_device_id = online_leave_if_and_opposite_dev_map.value(it.key());
+    if (checked_offline_device_id_set.contains(offline_opposite_device_id) ||
+        (online_opposite_device_id == online_device_id)) {
+      continue;
+    }
+    checked_offline_device_id_set.insert(offline_opposite_device_id);
+
+    // Check the neighbor's model name
+    const ActDevice *offline_opposite_device = offline_index.GetDevice(offline_opposite_device_id);
+    const ActDevice *online_opposite_device = online_index.GetDevice(online_opposite_device_id);
+    if ((offline_opposite_device == nullptr) || (online_opposite_device == nullptr) ||
+        (offline_opposite_device->GetDeviceProperty().GetModelName() !=
+         online_opposite_device->GetDeviceProperty().GetModelName())) {
+      return false;
+    }
+
+    // Check the neighbor's leave interfaces (the ports it would not find at the next hop)
+    QMap<qint64, qint64> offline_opposite_leave_if_map;
+    GenerateLeaveInterfaceOppositeDeviceMap(true, offline_opposite_device_id,
+                                            offline_index.GetDeviceLinks(offline_opposite_device_id),
+                                            offline_mapping_device_id_set, offline_opposite_leave_if_map);
+    const QList<qint64> &online_opposite_link_ifs = online_index.GetLinkInterfaces(online_opposite_device_id);
+    if (offline_opposite_leave_if_map.size() > online_opposite_link_ifs.size()) {
+      return false;
+    }
+    for (auto leave_if_id : offline_opposite_leave_if_map.keys()) {
+      if (!online_opposite_link_ifs.contains(leave_if_id)) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
 ACT_STATUS ActTopologyMapping::CreateDeviceLink(const ActDevice &device, const QList<ActDevice> &alive_device_list,
                                                 QList<ActLink> &result_link_list) {
   ACT_STATUS_INIT();